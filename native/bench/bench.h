@@ -0,0 +1,65 @@
+#ifndef NATIVE_BENCH_H
+#define NATIVE_BENCH_H
+
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// ===== Hilfsfunktionen für die Host-Benchmarks =====
+
+struct Stats {
+    std::vector<double> samples;
+
+    void add(double value) { samples.push_back(value); }
+
+    double percentile(double p) {
+        if (samples.empty()) return 0.0;
+        std::sort(samples.begin(), samples.end());
+        size_t index = (size_t)(p / 100.0 * (samples.size() - 1) + 0.5);
+        return samples[index];
+    }
+
+    double mean() const {
+        if (samples.empty()) return 0.0;
+        double sum = 0.0;
+        for (double v : samples) sum += v;
+        return sum / samples.size();
+    }
+
+    void print(const char* name) {
+        printf("  %-22s n=%-7zu mean=%9.2f  p50=%9.2f  p99=%9.2f  max=%9.2f\n",
+               name, samples.size(), mean(), percentile(50), percentile(99), percentile(100));
+    }
+};
+
+inline double elapsedMicros(std::chrono::steady_clock::time_point start) {
+    auto delta = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(delta).count();
+}
+
+// Anzahl operator new/malloc-Aufrufe seit Programmstart (bench_main.cpp)
+uint64_t heapAllocationCount();
+
+// Einzelne Benchmarks; Rückgabe false wenn eine Prüfung fehlschlägt
+bool runCodecBenchmark(unsigned long samples);
+bool runStreamBenchmark();
+bool runVibrationBenchmark();
+bool runPowerBenchmark();
+bool runFilterBenchmark();
+bool runSasBenchmark();
+bool runReconnectBenchmark();
+bool runTlsBenchmark();
+bool runWifiBenchmark();
+bool runRoamingBenchmark();
+bool runTimeBenchmark();
+bool runLogBenchmark();
+bool runMetricsBenchmark();
+bool runQos1Benchmark();
+bool runSamplingBenchmark();
+bool runBme280Benchmark();
+bool runI2cBenchmark();
+bool runRegistryBenchmark();
+bool runOfflineBenchmark();
+
+#endif
@@ -0,0 +1,215 @@
+// ===== Benchmark: BME280 Burst-Read und Ganzzahl-Kompensation =====
+// Prüft die Festkomma-Kompensation gegen das Rechenbeispiel aus dem
+// Datenblatt, gegen aufgezeichnete Frames und gegen die Gleitkomma-
+// Referenz (Datenblatt 8.1) über den ganzen Messbereich, das Zerlegen der
+// Kalibrierdaten (auch negative H4/H5) und den Weg über den Bus: ein
+// Burst-Read statt der Einzelzugriffe der Bibliothek.
+
+#include "bench.h"
+#include "bme280_direct.h"
+#include "sensors.h"
+#include "sim_bme280.h"
+#include "sim_signal.h"
+
+namespace {
+
+// Aufgezeichnete Frames 0xF7..0xFE mit den Ergebnissen der Bosch-Referenz
+struct RecordedFrame {
+    uint8_t bytes[BME280Direct::FRAME_SIZE];
+    int32_t temperature;    // 0,01 °C
+    uint32_t pressure;      // Pa · 256
+    uint32_t humidity;      // %RH · 1024
+};
+
+const RecordedFrame RECORDED[] = {
+    { { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x75, 0x30 }, 2508, 25767233, 56317 },   // Datenblatt-Beispiel
+    { { 0x55, 0x73, 0x00, 0x75, 0x30, 0x00, 0x84, 0xD0 }, 1257, 28100888, 77913 },
+    { { 0x75, 0x30, 0x00, 0x88, 0xB8, 0x00, 0x65, 0x90 }, 3763, 23343943, 33243 },
+    { { 0x49, 0x3E, 0x00, 0x68, 0xFB, 0x00, 0x94, 0x70 }, -317, 29533248, 97576 },
+};
+
+// Temperaturmessung abgeschaltet (0x80000)
+const uint8_t SKIPPED_FRAME[BME280Direct::FRAME_SIZE] = { 0x65, 0x5A, 0xC0, 0x80, 0x00, 0x00, 0x75, 0x30 };
+// Nur Feuchte abgeschaltet (0x8000)
+const uint8_t NO_HUMIDITY_FRAME[BME280Direct::FRAME_SIZE] = { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x80, 0x00 };
+
+bool calibrationMatches(const BME280Calibration& calib, const SimBme280::Coefficients& c) {
+    return calib.T1 == c.T1 && calib.T2 == c.T2 && calib.T3 == c.T3 &&
+           calib.P1 == c.P1 && calib.P2 == c.P2 && calib.P3 == c.P3 && calib.P4 == c.P4 &&
+           calib.P5 == c.P5 && calib.P6 == c.P6 && calib.P7 == c.P7 && calib.P8 == c.P8 &&
+           calib.P9 == c.P9 && calib.H1 == c.H1 && calib.H2 == c.H2 && calib.H3 == c.H3 &&
+           calib.H4 == c.H4 && calib.H5 == c.H5 && calib.H6 == c.H6;
+}
+
+// Busdauer bei 400 kHz: 9 Takte je Byte (inkl. ACK) plus Start/Stop je Transaktion
+double busMicros(uint64_t bytes, uint64_t transactions) {
+    return (bytes * 9.0 + transactions * 2.0) / 0.4;
+}
+
+}  // namespace
+
+bool runBme280Benchmark() {
+    printf("=== Benchmark: BME280 Burst-Read ===\n");
+    bool ok = true;
+    const uint8_t address = BME280_I2C_ADDR;
+    const SimBme280::Coefficients& c = SimBme280::COEFFICIENTS;
+
+    // Eigener Bus, die Zähler des Hauptprogramms bleiben unberührt
+    TwoWire bus;
+    bus.attachDevice(address);
+    SimBme280 sim(bus, address);
+    I2CEngine engine(bus);
+
+    // ===== Kalibrierdaten =====
+    BME280Direct direct;
+    bool begun = direct.begin(engine, address);
+    uint8_t tp[BME280Direct::CALIB_TP_SIZE];
+    uint8_t h[BME280Direct::CALIB_H_SIZE];
+    for (size_t i = 0; i < sizeof(tp); i++) tp[i] = bus.getRegister(address, BME280Direct::REG_CALIB_TP + i);
+    for (size_t i = 0; i < sizeof(h); i++) h[i] = bus.getRegister(address, BME280Direct::REG_CALIB_H + i);
+    // H4/H5 negativ: 0xE4 = 0xFF, 0xE5 = 0x3F, 0xE6 = 0xFE → H4 = -1, H5 = -29
+    uint8_t negative[BME280Direct::CALIB_H_SIZE];
+    memcpy(negative, h, sizeof(negative));
+    negative[3] = 0xFF;
+    negative[4] = 0x3F;
+    negative[5] = 0xFE;
+    BME280Calibration negativeCalib;
+    BME280Direct::parseCalibration(tp, negative, negativeCalib);
+    bool calibOk = begun && calibrationMatches(direct.getCalibration(), c) &&
+                   negativeCalib.H4 == -1 && negativeCalib.H5 == -29;
+    printf("  Kalibrierdaten: 33 Bytes in 2 Burst-Reads, H4 %d H5 %d, negativ %d/%d -> %s\n",
+           direct.getCalibration().H4, direct.getCalibration().H5, negativeCalib.H4, negativeCalib.H5,
+           calibOk ? "OK" : "FEHLER");
+    ok = ok && calibOk;
+
+    // ===== Rechenbeispiel und aufgezeichnete Frames =====
+    const BME280Calibration& calib = direct.getCalibration();
+    int32_t tFine;
+    int32_t exampleT = BME280Direct::compensateTemperature(519888, calib, tFine);
+    uint32_t exampleP = BME280Direct::compensatePressure(415148, tFine, calib);
+    bool exampleOk = exampleT == 2508 && tFine == 128422 && fabs(exampleP / 256.0 - 100653.27) < 1.0;
+    printf("  Datenblatt: T %.2f °C (t_fine %ld), p %.2f Pa -> %s\n", exampleT / 100.0, (long)tFine,
+           exampleP / 256.0, exampleOk ? "OK" : "FEHLER");
+    ok = ok && exampleOk;
+
+    size_t recordedMatches = 0;
+    for (const RecordedFrame& frame : RECORDED) {
+        sim.setRecordedFrame(frame.bytes);
+        BME280Reading reading;
+        bool humidityValid = false;
+        if (direct.read(reading, humidityValid) && humidityValid && reading.temperature == frame.temperature &&
+            reading.pressure == frame.pressure && reading.humidity == frame.humidity) {
+            recordedMatches++;
+        }
+    }
+    BME280Reading reading;
+    bool humidityValid = true;
+    sim.setRecordedFrame(SKIPPED_FRAME);
+    bool skippedRejected = !direct.read(reading, humidityValid);
+    sim.setRecordedFrame(NO_HUMIDITY_FRAME);
+    bool humidityOff = direct.read(reading, humidityValid) && !humidityValid && reading.temperature == 2508;
+    sim.setRecordedFrame(nullptr);
+    bool recordedOk = recordedMatches == sizeof(RECORDED) / sizeof(RECORDED[0]) && skippedRejected && humidityOff;
+    printf("  Aufgezeichnete Frames: %zu/%zu bitgenau, T abgeschaltet verworfen, Feuchte abgeschaltet "
+           "erkannt -> %s\n",
+           recordedMatches, sizeof(RECORDED) / sizeof(RECORDED[0]), recordedOk ? "OK" : "FEHLER");
+    ok = ok && recordedOk;
+
+    // ===== Messbereich gegen die Gleitkomma-Referenz =====
+    // -40..85 °C, 300..1100 hPa, 0..100 %RH
+    double maxT = 0.0, maxP = 0.0, maxH = 0.0;
+    double intNs = 0.0, doubleNs = 0.0;
+    uint32_t points = 0;
+    volatile double sink = 0.0;
+    for (int32_t adcT = 330000; adcT <= 650000; adcT += 8000) {
+        double tFineRef;
+        double refT = SimBme280::temperature(adcT, c, tFineRef);
+        if (refT < -40.0 || refT > 85.0) {
+            continue;
+        }
+        for (int32_t adcP = 200000; adcP <= 600000; adcP += 10000) {
+            double refP = SimBme280::pressure(adcP, tFineRef, c);
+            if (refP < 30000.0 || refP > 110000.0) {
+                continue;
+            }
+            for (int32_t adcH = 15000; adcH <= 45000; adcH += 1500) {
+                double refH = SimBme280::humidity(adcH, tFineRef, c);
+
+                auto start = std::chrono::steady_clock::now();
+                int32_t fine;
+                int32_t t = BME280Direct::compensateTemperature(adcT, calib, fine);
+                uint32_t p = BME280Direct::compensatePressure(adcP, fine, calib);
+                uint32_t hum = BME280Direct::compensateHumidity(adcH, fine, calib);
+                intNs += elapsedMicros(start) * 1000.0;
+
+                start = std::chrono::steady_clock::now();
+                double fineRef;
+                sink = sink + SimBme280::temperature(adcT, c, fineRef) + SimBme280::pressure(adcP, fineRef, c) +
+                       SimBme280::humidity(adcH, fineRef, c);
+                doubleNs += elapsedMicros(start) * 1000.0;
+
+                maxT = std::max(maxT, fabs(t / 100.0 - refT));
+                maxP = std::max(maxP, fabs(p / 256.0 - refP));
+                maxH = std::max(maxH, fabs(hum / 1024.0 - refH));
+                points++;
+            }
+        }
+    }
+    bool rangeOk = points > 1000 && maxT <= 0.01 && maxP <= 1.0 && maxH <= 0.05;
+    printf("  Messbereich (%lu Punkte): max. Abweichung T %.4f °C, p %.3f Pa, H %.4f %% -> %s\n",
+           (unsigned long)points, maxT, maxP, maxH, rangeOk ? "OK" : "FEHLER");
+    printf("  Kompensation je Messwert (Host): Ganzzahl %.0f ns, double %.0f ns "
+           "(ESP32 ohne double-FPU: Software-Gleitkomma)\n",
+           intNs / points, doubleNs / points);
+    ok = ok && rangeOk;
+
+    // ===== Buszugriffe je Messwert =====
+    const int reads = 100;
+    Adafruit_BME280 library;
+    library.begin(address, &bus);
+    uint64_t transactions = bus.getTransactionCount(address);
+    uint64_t bytes = bus.getByteCount(address);
+    for (int i = 0; i < reads; i++) {
+        sink = sink + library.readTemperature() + library.readHumidity() + library.readPressure();
+    }
+    double libraryTransactions = (double)(bus.getTransactionCount(address) - transactions) / reads;
+    double libraryBytes = (double)(bus.getByteCount(address) - bytes) / reads;
+
+    transactions = bus.getTransactionCount(address);
+    bytes = bus.getByteCount(address);
+    for (int i = 0; i < reads; i++) {
+        direct.read(reading, humidityValid);
+    }
+    double directTransactions = (double)(bus.getTransactionCount(address) - transactions) / reads;
+    double directBytes = (double)(bus.getByteCount(address) - bytes) / reads;
+    bool busOk = directTransactions == 2.0 && directTransactions < libraryTransactions && directBytes < libraryBytes;
+    printf("  Bus je Messwert: Bibliothek %.0f Transaktionen / %.0f Bytes (%.0f us bei 400 kHz), "
+           "Burst %.0f / %.0f (%.0f us) -> %s\n",
+           libraryTransactions, libraryBytes, busMicros((uint64_t)libraryBytes, (uint64_t)libraryTransactions),
+           directTransactions, directBytes, busMicros((uint64_t)directBytes, (uint64_t)directTransactions),
+           busOk ? "OK" : "FEHLER");
+    ok = ok && busOk;
+
+    // ===== Ende-zu-Ende über Sensors (globaler Bus mit Registermodell) =====
+    Sensors sensors;
+    sensors.begin();
+    double errT = 0.0, errP = 0.0, errH = 0.0;
+    bool readsOk = true;
+    for (int i = 0; i < reads; i++) {
+        SensorData data = {};
+        readsOk = readsOk && sensors.readBME280(data);
+        errT = std::max(errT, (double)fabs(data.temperature - SimSignal::bme280Temperature()));
+        errP = std::max(errP, (double)fabs(data.pressure * 100.0f - SimSignal::bme280Pressure()));
+        errH = std::max(errH, (double)fabs(data.humidity - SimSignal::bme280Humidity()));
+        delay(1000);
+    }
+    // Rauschen des Modells plus Auflösung der Rohwerte
+    bool endToEndOk = readsOk && errT <= 0.07 && errP <= 4.0 && errH <= 0.3;
+    printf("  Sensors::readBME280: max. Abweichung T %.3f °C, p %.2f Pa, H %.3f %% -> %s\n", errT, errP, errH,
+           endToEndOk ? "OK" : "FEHLER");
+    ok = ok && endToEndOk;
+
+    printf("  Speicher: %zu Bytes (BME280Direct)\n\n", sizeof(BME280Direct));
+    (void)sink;
+    return ok;
+}
@@ -0,0 +1,253 @@
+// ===== Benchmark: Telemetrie-Kodierung JSON vs. binär =====
+// Vergleicht Nachrichtengröße und Kodierzeit für Einzelwerte und Batches
+// mit fester Größe (JSON-Array bzw. Binär mit Anzahl im Header), prüft das
+// Array-Format samt Überlauf und dass decodeBinary() die Werte innerhalb
+// der Festkomma-Auflösung zurückliefert.
+
+#include "bench.h"
+#include "sensors.h"
+#include "telemetry_batch.h"
+#include "telemetry_codec.h"
+
+namespace {
+
+// Größte Abweichung aller Felder, normiert auf die halbe Auflösung (<= 1.0 = OK)
+double maxNormalizedError(const SensorData& a, const SensorData& b) {
+    struct { float x, y, half; } fields[] = {
+        { a.temperature, b.temperature, 0.005f },
+        { a.humidity, b.humidity, 0.005f },
+        { a.pressure, b.pressure, 0.05f },
+        { a.accelX, b.accelX, 0.0005f },
+        { a.accelY, b.accelY, 0.0005f },
+        { a.accelZ, b.accelZ, 0.0005f },
+        { a.gyroX, b.gyroX, 0.05f },
+        { a.gyroY, b.gyroY, 0.05f },
+        { a.gyroZ, b.gyroZ, 0.05f },
+    };
+    double worst = 0.0;
+    for (const auto& f : fields) {
+        worst = std::max(worst, fabs((double)f.x - f.y) / f.half);
+    }
+    return worst;
+}
+
+// Liest den Zahlenwert hinter "key": aus einem JSON-Objekt (null -> NAN)
+float jsonField(const char* json, const char* key) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char* p = strstr(json, pattern);
+    if (!p) return INFINITY;
+    p += strlen(pattern);
+    return strncmp(p, "null", 4) == 0 ? NAN : strtof(p, nullptr);
+}
+
+// Größte Abweichung der JSON-Werte, normiert auf die halbe letzte Stelle
+double maxJsonError(const SensorData& data, const char* json) {
+    struct { const char* key; float value; float half; } fields[] = {
+        { "temperature", data.temperature, 0.005f },
+        { "humidity", data.humidity, 0.005f },
+        { "pressure", data.pressure, 0.005f },
+        { "accelX", data.accelX, 0.00005f },
+        { "accelY", data.accelY, 0.00005f },
+        { "accelZ", data.accelZ, 0.00005f },
+        { "gyroX", data.gyroX, 0.005f },
+        { "gyroY", data.gyroY, 0.005f },
+        { "gyroZ", data.gyroZ, 0.005f },
+    };
+    double worst = 0.0;
+    for (const auto& f : fields) {
+        // Toleranz für float-Rundung bei großen Beträgen (Luftdruck)
+        double tolerance = f.half + fabs(f.value) * 1e-7;
+        worst = std::max(worst, fabs((double)jsonField(json, f.key) - f.value) / tolerance);
+    }
+    return worst;
+}
+
+// Feste Batchgröße, unabhängig von TELEMETRY_BATCH_SIZE (Standard 1)
+const size_t BATCH_SIZE = 10;
+
+// PUBLISH mit QoS 1: Fixed Header, Topic mit Längenfeld, Packet Identifier
+size_t publishOverhead(const char* topic, size_t payloadLength) {
+    size_t remaining = 2 + strlen(topic) + 2 + payloadLength;
+    size_t lengthBytes = remaining < 128 ? 1 : remaining < 16384 ? 2 : 3;
+    return 1 + lengthBytes + 2 + strlen(topic) + 2;
+}
+
+// Mittlere Bytes je Messwert inkl. Kopf bei gleich großen Nachrichten
+double wireBytesPerSample(const char* topic, size_t payloadBytes, size_t messages, size_t samplesPerMessage) {
+    if (messages == 0) return 0.0;
+    size_t perMessage = payloadBytes / messages;
+    return (double)(payloadBytes + messages * publishOverhead(topic, perMessage)) / (messages * samplesPerMessage);
+}
+
+// Prüft [{...},{...},...] mit genau count Objekten auf oberster Ebene
+bool isJsonArray(const char* json, size_t length, size_t count) {
+    if (length < 2 || json[0] != '[' || json[length - 1] != ']' || json[length] != '\0' ||
+        strlen(json) != length) {
+        return false;
+    }
+    size_t objects = 0;
+    int depth = 0;
+    bool expectObject = true;
+    for (size_t i = 1; i + 1 < length; i++) {
+        char c = json[i];
+        if (c == '"') {
+            // Zeichenketten überspringen (keine Escapes in der Telemetrie)
+            const char* end = strchr(json + i + 1, '"');
+            if (!end) return false;
+            i = end - json;
+        } else if (c == '{') {
+            if (depth == 0 && !expectObject) return false;
+            if (depth == 0) objects++;
+            depth++;
+            expectObject = false;
+        } else if (c == '}') {
+            if (--depth < 0) return false;
+        } else if (c == ',' && depth == 0) {
+            if (expectObject) return false;
+            expectObject = true;
+        } else if (depth == 0) {
+            return false;
+        }
+    }
+    return depth == 0 && !expectObject && objects == count;
+}
+
+}  // namespace
+
+bool runCodecBenchmark(unsigned long count) {
+    Sensors sensors;
+    sensors.begin();
+
+    std::vector<SensorData> samples(count);
+    for (auto& sample : samples) {
+        delay(SENSOR_READ_INTERVAL_MS);
+        sensors.readAll(sample);
+    }
+    const unsigned long epoch = 1767225600UL;
+
+    // ----- Einzelwerte -----
+    char json[TelemetryCodec::JSON_SAMPLE_SIZE];
+    uint8_t binary[TelemetryCodec::BINARY_HEADER_SIZE + TelemetryCodec::BINARY_SAMPLE_SIZE];
+    size_t jsonBytes = 0;
+    size_t binaryBytes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& sample : samples) {
+        jsonBytes += TelemetryCodec::encodeJson(sample, epoch, json, sizeof(json));
+    }
+    double jsonMicros = elapsedMicros(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& sample : samples) {
+        binaryBytes += TelemetryCodec::encodeBinary(sample, epoch, binary, sizeof(binary));
+    }
+    double binaryMicros = elapsedMicros(start);
+
+    // ----- Batches mit fester Größe (unabhängig von TELEMETRY_BATCH_SIZE) -----
+    const size_t batchSize = BATCH_SIZE;
+    std::vector<TelemetrySample> batch(batchSize);
+    std::vector<uint8_t> buffer(batchSize * TelemetryCodec::JSON_SAMPLE_SIZE);
+    size_t batches = 0;
+    size_t jsonBatchBytes = 0;
+    size_t binaryBatchBytes = 0;
+    double jsonBatchMicros = 0.0;
+    double binaryBatchMicros = 0.0;
+    bool arrayOk = true;
+
+    for (size_t i = 0; i + batchSize <= samples.size(); i += batchSize) {
+        size_t singleBytes = 0;
+        for (size_t j = 0; j < batchSize; j++) {
+            batch[j] = { samples[i + j], epoch + j * (SENSOR_READ_INTERVAL_MS / 1000) };
+            singleBytes += TelemetryCodec::encodeJson(batch[j].data, batch[j].epoch, json, sizeof(json));
+        }
+
+        start = std::chrono::steady_clock::now();
+        size_t jsonLength = TelemetryCodec::encodeJsonBatch(batch.data(), batchSize, (char*)buffer.data(),
+                                                            buffer.size());
+        jsonBatchMicros += elapsedMicros(start);
+        jsonBatchBytes += jsonLength;
+        arrayOk = arrayOk && isJsonArray((const char*)buffer.data(), jsonLength, batchSize) &&
+                  jsonLength == singleBytes + batchSize + 1;
+
+        start = std::chrono::steady_clock::now();
+        binaryBatchBytes += TelemetryCodec::encodeBinaryBatch(batch.data(), batchSize, buffer.data(),
+                                                              buffer.size());
+        binaryBatchMicros += elapsedMicros(start);
+        batches++;
+    }
+
+    // Puffer genau passend bzw. ein Byte zu klein (Platz für ']' und '\0')
+    bool overflowOk = batches > 0;
+    if (overflowOk) {
+        char* text = (char*)buffer.data();
+        size_t exact = TelemetryCodec::encodeJsonBatch(batch.data(), batchSize, text, buffer.size());
+        size_t binaryExact = TelemetryCodec::BINARY_HEADER_SIZE + batchSize * TelemetryCodec::BINARY_SAMPLE_SIZE;
+        overflowOk = TelemetryCodec::encodeJsonBatch(batch.data(), batchSize, text, exact + 1) == exact &&
+                     TelemetryCodec::encodeJsonBatch(batch.data(), batchSize, text, exact) == 0 &&
+                     TelemetryCodec::encodeBinaryBatch(batch.data(), batchSize, buffer.data(), binaryExact - 1) == 0;
+    }
+
+    // Bytes je Messwert auf der Leitung: Batching spart den MQTT-Kopf je Nachricht
+    double jsonSingleWire = wireBytesPerSample(MQTT_TELEMETRY_TOPIC, jsonBytes, count, 1);
+    double binarySingleWire = wireBytesPerSample(MQTT_TELEMETRY_BINARY_TOPIC, binaryBytes, count, 1);
+    double jsonBatchWire = wireBytesPerSample(MQTT_TELEMETRY_TOPIC, jsonBatchBytes, batches, batchSize);
+    double binaryBatchWire = wireBytesPerSample(MQTT_TELEMETRY_BINARY_TOPIC, binaryBatchBytes, batches, batchSize);
+    bool savingOk = batches > 0 && jsonBatchWire < jsonSingleWire && binaryBatchWire < binarySingleWire;
+
+    // ----- Rundreise binär -> SensorData -----
+    double worstError = 0.0;
+    for (const auto& sample : samples) {
+        size_t length = TelemetryCodec::encodeBinary(sample, epoch, binary, sizeof(binary));
+        TelemetrySample decoded;
+        if (TelemetryCodec::decodeBinary(binary, length, &decoded, 1) != 1 || decoded.epoch != epoch) {
+            worstError = INFINITY;
+            break;
+        }
+        worstError = std::max(worstError, maxNormalizedError(sample, decoded.data));
+    }
+
+    // ----- JSON-Werte gegen Originalwerte, inkl. Sonderfälle -----
+    double worstJsonError = 0.0;
+    for (const auto& sample : samples) {
+        if (TelemetryCodec::encodeJson(sample, epoch, json, sizeof(json)) == 0) {
+            worstJsonError = INFINITY;
+            break;
+        }
+        worstJsonError = std::max(worstJsonError, maxJsonError(sample, json));
+    }
+    SensorData edge = samples.front();
+    edge.temperature = -0.004f;   // Rundet auf 0 -> kein "-0"
+    edge.humidity = NAN;
+    edge.pressure = 1e9f;         // Unplausibel -> null
+    edge.accelX = -1.99996f;      // Übertrag in die Vorkommastelle
+    size_t edgeLength = TelemetryCodec::encodeJson(edge, epoch, json, sizeof(json));
+    bool edgeOk = edgeLength > 0 &&
+                  strstr(json, "\"temperature\":0,") && strstr(json, "\"humidity\":null,") &&
+                  strstr(json, "\"pressure\":null,") && strstr(json, "\"accelX\":-2,");
+
+    bool ok = worstError <= 1.0 + 1e-3 && worstJsonError <= 1.0 + 1e-3 && edgeOk &&
+              arrayOk && overflowOk && savingOk;
+
+    printf("=== Benchmark: Telemetrie-Kodierung ===\n");
+    printf("  %-18s %12s %12s %14s\n", "", "Bytes/Nachr.", "ns/Nachr.", "Bytes/Messwert*");
+    printf("  %-18s %12.1f %12.0f %14.1f\n", "JSON einzeln",
+           (double)jsonBytes / count, jsonMicros * 1000.0 / count, jsonSingleWire);
+    printf("  %-18s %12.1f %12.0f %14.1f\n", "Binär einzeln",
+           (double)binaryBytes / count, binaryMicros * 1000.0 / count, binarySingleWire);
+    if (batches > 0) {
+        printf("  %-18s %12.1f %12.0f %14.1f   (%u Messwerte/Batch)\n", "JSON Batch",
+               (double)jsonBatchBytes / batches, jsonBatchMicros * 1000.0 / batches, jsonBatchWire,
+               (unsigned)batchSize);
+        printf("  %-18s %12.1f %12.0f %14.1f\n", "Binär Batch",
+               (double)binaryBatchBytes / batches, binaryBatchMicros * 1000.0 / batches, binaryBatchWire);
+    }
+    printf("  * inkl. MQTT-Kopf und Topic je Nachricht; mit Batch weniger -> %s\n", savingOk ? "OK" : "FEHLER");
+    printf("  JSON-Array:        Klammern und Trennzeichen %s, Puffer zu klein -> 0 %s\n",
+           arrayOk ? "OK" : "FEHLER", overflowOk ? "OK" : "FEHLER");
+    printf("  Rundreise binär:   max. Fehler %.2f x halbe Auflösung -> %s\n",
+           worstError, worstError <= 1.0 + 1e-3 ? "OK" : "FEHLER");
+    printf("  Werte in JSON:     max. Fehler %.2f x halbe letzte Stelle, Sonderfälle %s\n\n",
+           worstJsonError, edgeOk ? "OK" : "FEHLER");
+    return ok;
+}
@@ -0,0 +1,109 @@
+// ===== Benchmark: Report-by-Exception =====
+// Speist einen Tag Wetterdaten im 5-s-Takt (langsamer Tagesgang plus
+// Sensorrauschen) durch den Totband-Filter und zählt die gesendeten
+// Nachrichten. Prüft außerdem Totband, Heartbeat, Gültigkeitswechsel und
+// die Konfiguration per C2D-JSON.
+
+#include "bench.h"
+#include "telemetry_filter.h"
+
+namespace {
+
+SensorData weatherSample(unsigned long ms) {
+    double hours = ms / 3600000.0;
+    SensorData data;
+    data.timestamp = ms;
+    data.temperature = (float)(18.0 + 6.0 * sin(2 * M_PI * hours / 24.0)) + 0.02f * ((ms / 5000) % 3);
+    data.humidity = (float)(55.0 - 15.0 * sin(2 * M_PI * hours / 24.0));
+    data.pressure = (float)(1013.0 + 2.0 * sin(2 * M_PI * hours / 48.0));
+    data.accelX = 0.0f;
+    data.accelY = 0.0f;
+    data.accelZ = 1.0f + 0.005f * ((ms / 5000) % 2);
+    data.gyroX = data.gyroY = data.gyroZ = 0.3f;
+    data.bme280Valid = true;
+    data.mpu9250Valid = true;
+    return data;
+}
+
+}  // namespace
+
+bool runFilterBenchmark() {
+    printf("=== Benchmark: Report-by-Exception ===\n");
+
+    // ===== Volumen über 24 h =====
+    TelemetryFilter filter;
+    const unsigned long dayMs = 24UL * 3600UL * 1000UL;
+    uint32_t samples = 0;
+    uint32_t published = 0;
+    unsigned long longestGapMs = 0;
+    unsigned long lastPublishMs = 0;
+    for (unsigned long ms = 0; ms < dayMs; ms += SENSOR_READ_INTERVAL_MS) {
+        samples++;
+        if (filter.shouldPublish(weatherSample(ms))) {
+            published++;
+            longestGapMs = std::max(longestGapMs, ms - lastPublishMs);
+            lastPublishMs = ms;
+        }
+    }
+    bool volumeOk = filter.getSuppressedCount() == samples - published &&
+                    longestGapMs <= TELEMETRY_FILTER_HEARTBEAT_S * 1000UL;
+    printf("  24 h Wetterdaten:      %lu von %lu Messwerten gesendet (%.1f %%), max. Lücke %lu s -> %s\n",
+           (unsigned long)published, (unsigned long)samples, 100.0 * published / samples,
+           longestGapMs / 1000, volumeOk ? "OK" : "FEHLER");
+    printf("  Auslöser:             ");
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        if (filter.getTriggerCount((TelemetryChannel)c) > 0) {
+            printf(" %s %lu", TelemetryFilter::CHANNEL_NAMES[c],
+                   (unsigned long)filter.getTriggerCount((TelemetryChannel)c));
+        }
+    }
+    printf(", Rest Heartbeat\n");
+
+    // ===== Einzelfälle =====
+    TelemetryFilter check;
+    SensorData base = weatherSample(0);
+    bool first = check.shouldPublish(base);
+    SensorData step = base;
+    step.timestamp = 5000;
+    step.temperature += TELEMETRY_DEADBAND_TEMPERATURE * 0.5f;
+    bool belowDeadband = !check.shouldPublish(step);
+    step.timestamp = 10000;
+    step.temperature = base.temperature + TELEMETRY_DEADBAND_TEMPERATURE * 1.5f;
+    bool aboveDeadband = check.shouldPublish(step);
+    step.timestamp = 15000;
+    step.mpu9250Valid = false;
+    bool validityChange = check.shouldPublish(step);
+    step.timestamp = 15000 + TELEMETRY_FILTER_HEARTBEAT_S * 1000UL - 5000;
+    bool beforeHeartbeat = !check.shouldPublish(step);
+    step.timestamp = 15000 + TELEMETRY_FILTER_HEARTBEAT_S * 1000UL;
+    bool heartbeat = check.shouldPublish(step);
+    bool casesOk = first && belowDeadband && aboveDeadband && validityChange && beforeHeartbeat && heartbeat;
+    printf("  Totband/Heartbeat/Gültigkeit:  %s\n", casesOk ? "OK" : "FEHLER");
+
+    // ===== Konfiguration per C2D =====
+    const char* command = "{\"filter\":{\"pressure\":{\"pct\":0.05,\"heartbeat\":60},"
+                          "\"humidity\":{\"abs\":-1}}}";
+    StaticJsonDocument<512> doc;
+    bool parsed = !deserializeJson(doc, (const uint8_t*)command, strlen(command));
+    bool accepted = TelemetryFilter::commandHandler(doc.as<JsonVariantConst>(), &check);
+    const ChannelFilterConfig& pressure = check.getChannel(CHANNEL_PRESSURE);
+    const ChannelFilterConfig& humidity = check.getChannel(CHANNEL_HUMIDITY);
+    bool configOk = parsed && accepted && pressure.percent && fabsf(pressure.deadband - 0.05f) < 1e-6f &&
+                    pressure.heartbeatMs == 60000 && !humidity.percent &&
+                    humidity.deadband == TELEMETRY_DEADBAND_HUMIDITY;
+
+    // 0,05 % von 1013 hPa = 0,51 hPa
+    SensorData pressureStep = base;
+    pressureStep.timestamp = 20000;
+    check.shouldPublish(pressureStep);
+    pressureStep.timestamp = 25000;
+    pressureStep.pressure += 0.4f;
+    bool pctBelow = !check.shouldPublish(pressureStep);
+    pressureStep.timestamp = 30000;
+    pressureStep.pressure += 0.2f;
+    bool pctAbove = check.shouldPublish(pressureStep);
+    configOk = configOk && pctBelow && pctAbove;
+    printf("  C2D-Konfiguration (pct, heartbeat, ungültiger Wert): %s\n\n", configOk ? "OK" : "FEHLER");
+
+    return volumeOk && casesOk && configOk;
+}
@@ -0,0 +1,178 @@
+// ===== Benchmark: I2C-Engine =====
+// Eigener Bus mit BME280- und MPU9250-Modell, der simulierte Zeit kostet
+// (400 kHz). Geprüft werden Reihenfolge und Ergebnis der Rückrufe bei
+// abwechselnden Auftraggebern, die Zeiten je Transaktion gegen die
+// Bitdauer, volle Warteschlange, transfer(), die Bus-Recovery bei
+// festgehaltener SDA-Leitung und der Scan als Kette im Hintergrund.
+
+#include "bench.h"
+#include "i2c_engine.h"
+#include "sensors.h"
+#include "sim_bme280.h"
+#include "sim_mpu9250.h"
+#include "telemetry_codec.h"
+
+namespace {
+
+const uint8_t REG_BME_DATA = 0xF7;
+const uint8_t REG_MPU_ACCEL = 0x3B;   // Accel, Temperatur, Gyro: 14 Bytes
+const uint32_t CLOCK_HZ = 400000;
+
+struct Completion {
+    uint8_t address;
+    I2CStatus status;
+    uint32_t waitMicros;
+    uint32_t busMicros;
+};
+
+std::vector<Completion> completions;
+
+void record(const I2CTransaction& transaction, void* context) {
+    (void)context;
+    completions.push_back({ transaction.address, transaction.status, transaction.waitMicros,
+                            transaction.busMicros });
+}
+
+// Registeradresse schreiben, mit Repeated Start lesen: 9 Takte je Byte,
+// Start und Stop je Teil ein Takt (wie das Bus-Modell)
+double expectedBusMicros(size_t readLength) {
+    return ((2 * 9 + 2) + ((1 + readLength) * 9 + 2)) * 1e6 / CLOCK_HZ;
+}
+
+}  // namespace
+
+bool runI2cBenchmark() {
+    printf("=== Benchmark: I2C-Engine ===\n");
+    bool ok = true;
+
+    TwoWire bus;
+    bus.attachDevice(BME280_I2C_ADDR);
+    bus.attachDevice(Mpu9250Driver::ADDRESSES[0]);
+    SimBme280 bme(bus, BME280_I2C_ADDR);
+    SimMpu9250 mpu(bus, Mpu9250Driver::ADDRESSES[0]);
+    bus.setBusTiming(true);
+    I2CEngine engine(bus);
+    engine.begin(I2C_SDA, I2C_SCL, CLOCK_HZ);
+
+    // ===== Zwei Auftraggeber abwechselnd, Ausführung später =====
+    const size_t rounds = I2C_QUEUE_SIZE / 2;
+    uint8_t bmeFrames[rounds][8];
+    uint8_t mpuFrames[rounds][14];
+    completions.clear();
+    double submitNs = 0.0;
+    for (size_t i = 0; i < rounds; i++) {
+        auto start = std::chrono::steady_clock::now();
+        engine.submit(I2CTransaction::read(BME280_I2C_ADDR, REG_BME_DATA, bmeFrames[i], 8, record));
+        engine.submit(I2CTransaction::read(Mpu9250Driver::ADDRESSES[0], REG_MPU_ACCEL, mpuFrames[i], 14, record));
+        submitNs += elapsedMicros(start) * 1000.0;
+        delayMicroseconds(50);   // Auftraggeber arbeitet weiter
+    }
+    size_t executed = engine.process();
+    bool orderOk = executed == 2 * rounds && completions.size() == 2 * rounds;
+    double maxBusError = 0.0;
+    uint32_t firstWait = 0, lastWait = 0;
+    for (size_t i = 0; orderOk && i < completions.size(); i++) {
+        const Completion& c = completions[i];
+        bool isBme = i % 2 == 0;
+        orderOk = c.status == I2C_OK && c.address == (isBme ? BME280_I2C_ADDR : Mpu9250Driver::ADDRESSES[0]);
+        maxBusError = std::max(maxBusError, fabs(c.busMicros - expectedBusMicros(isBme ? 8 : 14)));
+        if (i == 0) firstWait = c.waitMicros;
+        lastWait = c.waitMicros;
+    }
+    // Daten wie bei einem direkten Lesezugriff (Frame des Modells ist fest)
+    uint8_t recorded[8] = { 0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x75, 0x30 };
+    bme.setRecordedFrame(recorded);
+    uint8_t frame[8] = {};
+    bool transferOk = engine.readRegisters(BME280_I2C_ADDR, REG_BME_DATA, frame, sizeof(frame)) &&
+                      memcmp(frame, recorded, sizeof(frame)) == 0;
+    bme.setRecordedFrame(nullptr);
+    bool queueOk = orderOk && maxBusError <= 1.0 && lastWait > firstWait && transferOk;
+    printf("  %zu Transaktionen (BME280 8 B / MPU9250 14 B abwechselnd): Reihenfolge und Status %s, "
+           "Busdauer %.0f/%.0f us (Abweichung max. %.1f us), Wartezeit %lu..%lu us\n",
+           executed, orderOk ? "OK" : "falsch", expectedBusMicros(8), expectedBusMicros(14), maxBusError,
+           (unsigned long)firstWait, (unsigned long)lastWait);
+    printf("  Auftraggeber: %.0f ns je submit() (Host) statt %.0f us Warten auf den Bus; "
+           "transfer() liefert dieselben Daten -> %s\n",
+           submitNs / (2 * rounds), (expectedBusMicros(8) + expectedBusMicros(14)) / 2, queueOk ? "OK" : "FEHLER");
+    ok = ok && queueOk;
+
+    // ===== Volle Warteschlange =====
+    uint8_t scratch[8];
+    size_t accepted = 0;
+    for (size_t i = 0; i < I2C_QUEUE_SIZE + 4; i++) {
+        if (engine.submit(I2CTransaction::read(BME280_I2C_ADDR, REG_BME_DATA, scratch, 8))) {
+            accepted++;
+        }
+    }
+    // transfer() ohne Task arbeitet zuerst alles Wartende ab
+    I2CTransaction after = I2CTransaction::read(Mpu9250Driver::ADDRESSES[0], REG_MPU_ACCEL, mpuFrames[0], 14);
+    I2CStatus afterStatus = engine.transfer(after);
+    bool fullOk = accepted == I2C_QUEUE_SIZE && engine.getDroppedCount() == 4 && afterStatus == I2C_OK &&
+                  engine.process() == 0;
+    printf("  Warteschlange %u Plätze: %zu angenommen, %lu verworfen, transfer() danach %s -> %s\n",
+           (unsigned)I2C_QUEUE_SIZE, accepted, (unsigned long)engine.getDroppedCount(),
+           afterStatus == I2C_OK ? "OK" : "Fehler", fullOk ? "OK" : "FEHLER");
+    ok = ok && fullOk;
+
+    // ===== Latenz je Transaktion (Übergabe bis Rückruf) =====
+    const LatencyHistogram& latency = engine.getLatencyStats();
+    const LatencyHistogram& busTime = engine.getBusStats();
+    bool statsOk = latency.getTotal() == engine.getCompletedCount() && latency.getTotal() > 0 &&
+                   latency.getMax() >= busTime.getMax() && engine.getErrorCount() == 0;
+    printf("  Latenz: n=%lu, p50 %lu us, p99 %lu us, max %lu us; davon Bus p50 %lu us -> %s\n",
+           (unsigned long)latency.getTotal(), (unsigned long)latency.percentile(50),
+           (unsigned long)latency.percentile(99), (unsigned long)latency.getMax(),
+           (unsigned long)busTime.percentile(50), statsOk ? "OK" : "FEHLER");
+    ok = ok && statsOk;
+    engine.resetStats();
+
+    // ===== Bus-Recovery =====
+    // Slave hält SDA für 5 Takte: Transaktion kommt nach der Recovery durch
+    bus.holdSda(5);
+    I2CTransaction stuck = I2CTransaction::read(BME280_I2C_ADDR, REG_BME_DATA, frame, 8);
+    engine.transfer(stuck);
+    bool recovered = stuck.status == I2C_OK && stuck.attempts == 2 && !bus.isSdaHeld() &&
+                     engine.getRecoveryCount() == 1 && engine.getLatencyStats().getTotal() == 1;
+    // Länger als 9 Takte: Recovery scheitert, der Fehler kommt beim Auftraggeber an
+    bus.holdSda(20);
+    I2CTransaction dead = I2CTransaction::read(BME280_I2C_ADDR, REG_BME_DATA, frame, 8);
+    engine.transfer(dead);
+    bool reported = dead.status == I2C_TIMEOUT && engine.getFailedRecoveryCount() == 1 &&
+                    engine.getErrorCount() == 1;
+    bus.holdSda(0);
+    bool afterwards = engine.readRegisters(BME280_I2C_ADDR, REG_BME_DATA, frame, 8);
+    bool recoveryOk = recovered && reported && afterwards;
+    printf("  Recovery: SDA 5 Takte festgehalten -> nach %u Versuchen %s (%lu us); 20 Takte -> Status %u, "
+           "%lu gescheitert; danach wieder OK -> %s\n",
+           stuck.attempts, stuck.status == I2C_OK ? "gelesen" : "Fehler", (unsigned long)stuck.busMicros,
+           dead.status, (unsigned long)engine.getFailedRecoveryCount(), recoveryOk ? "OK" : "FEHLER");
+    ok = ok && recoveryOk;
+
+    // ===== Scan im Hintergrund (globaler Bus) =====
+    uint32_t before = i2cBus.getCompletedCount();
+    Sensors sensors;
+    sensors.begin();
+    while (i2cBus.process() > 0) {
+    }
+    uint32_t probes = i2cBus.getCompletedCount() - before;
+    bool scanOk = sensors.isScanComplete() && sensors.getScanDeviceCount() == 2 && probes >= 126;
+    printf("  Scan: %u Geräte, %lu Transaktionen über die Engine, ein Platz in der Warteschlange -> %s\n",
+           sensors.getScanDeviceCount(), (unsigned long)probes, scanOk ? "OK" : "FEHLER");
+    ok = ok && scanOk;
+
+    // ===== Device Twin: Bericht mit I2C-Feldern passt in den Puffer =====
+    MetricsReport worst;
+    memset(&worst, 0xFF, sizeof(worst));
+    worst.rssi = -100;
+    char json[TelemetryCodec::METRICS_JSON_SIZE];
+    size_t length = TelemetryCodec::encodeMetricsJson(worst, json, sizeof(json));
+    bool twinOk = length > 0 && strstr(json, "\"i2cUs\":{\"n\":") != nullptr &&
+                  strstr(json, "\"i2c\":{\"errors\":") != nullptr;
+    printf("  Metrik-Bericht mit Höchstwerten: %zu von %u Bytes -> %s\n", length,
+           (unsigned)TelemetryCodec::METRICS_JSON_SIZE, twinOk ? "OK" : "FEHLER");
+    ok = ok && twinOk;
+
+    printf("  Speicher: %zu Bytes (I2CEngine, davon %zu Warteschlange)\n\n", sizeof(I2CEngine),
+           (size_t)I2C_QUEUE_SIZE * sizeof(I2CTransaction));
+    return ok;
+}
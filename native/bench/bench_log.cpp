@@ -0,0 +1,296 @@
+// ===== Benchmark: Logger mit Ringpuffer =====
+// Prüft, dass das verzögerte Formatieren dasselbe liefert wie snprintf,
+// misst die Kosten eines LOG-Aufrufs für den aufrufenden Task gegenüber
+// der bisherigen synchronen Ausgabe, die Drosselung der UART-Ausgabe, das
+// Zählen verworfener Meldungen, die Warteschlange mit mehreren
+// gleichzeitigen Produzenten (echte Threads) sowie das binäre Format: der
+// Decoder muss exakt den Text liefern und das Dashboard deutlich kleiner sein.
+
+#include <thread>
+#include "bench.h"
+#include "config.h"
+#include "logger.h"
+#include "log_decoder.h"
+#include "sensors.h"
+
+void printSample(const SensorData& data, unsigned long epoch, long jitterMs, bool publish);
+
+namespace {
+
+template <typename... Args>
+bool sameAsPrintf(const char* format, Args... args) {
+    char expected[128];
+    char actual[128];
+    snprintf(expected, sizeof(expected), format, args...);
+    LogRecord record;
+    record.format = format;
+    record.argCount = 0;
+    record.stringBytes = 0;
+    int dummy[] = { 0, (record.add(args), 0)... };
+    (void)dummy;
+    record.formatMessage(actual, sizeof(actual));
+    if (strcmp(expected, actual) != 0) {
+        printf("    \"%s\": erwartet \"%s\", erhalten \"%s\"\n", format, expected, actual);
+        return false;
+    }
+    return true;
+}
+
+// Bisheriger Weg: formatieren und synchron auf den UART
+template <typename... Args>
+void logSynchronous(const char* tag, const char* format, Args... args) {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), format, args...);
+    Serial.printf("%s[%s] [%10lu] [%s] %s\033[0m\n", "\033[1;32m", "INFO ", millis(), tag, buffer);
+}
+
+// Dieselben Aufrufe für Text und binär; millis() steht dabei still
+void logRoundTripCases(const char* text) {
+    int local = 0;
+    LOG_E("Bench", "Fehler %d bei %s", -42, text);
+    LOG_W("Bench", "%llu µs, %lld, %x, %08X, %o", 1767225615520999ULL, -5LL, 255U, 48879U, 8U);
+    LOG_I("Bench", "%6.2f °C %7.2f hPa %.3f %g", 21.5f, 1013.25, -0.0004, 0.1);
+    LOG_D("Bench", "%c%c %5.1f%% %-10s|%10s|", 'O', 'K', 99.5, "links", "rechts");
+    LOG_D("Bench", "%p %u %i", (const void*)&local, (uint8_t)200, (int16_t)-3);
+    LOG_I("Bench", "%s|%s", "eine sehr lange Zeichenkette, die abgeschnitten wird", "Rest");
+    LOG_I("Bench", "%d %d %d %d %d %d %d %d", 1, -2, 300, -40000, 5000000, -6, 7, 2147483647);
+    LOG_PRINT_I("║ Takt: %+6ld ms Jitter | Queue: %2u ║", -12L, 3U);
+    LOG_PRINT_I("100%% ohne Argumente");
+}
+
+// printSample() mehrmals, Bytes auf Serial und der Mitschnitt
+uint64_t runDashboard(bool binary, std::string& captured) {
+    Logger::setBinaryOutput(binary);
+    Serial.setCapture(&captured);
+    uint64_t before = Logger::getBytesWritten();
+    SensorData data{};
+    data.temperature = 21.47f;
+    data.humidity = 45.2f;
+    data.pressure = 1013.25f;
+    data.accelX = 0.012f;
+    data.accelY = -0.003f;
+    data.accelZ = 0.998f;
+    data.gyroX = 0.15f;
+    data.gyroY = -0.42f;
+    data.gyroZ = 0.07f;
+    data.bme280Valid = true;
+    data.mpu9250Valid = true;
+    for (int i = 0; i < 10; i++) {
+        data.timestamp = millis();
+        data.temperature += 0.01f;
+        printSample(data, 1767225600UL + i * 5, i % 3 - 1, true);
+        Logger::flush(10000);
+    }
+    Serial.setCapture(nullptr);
+    return Logger::getBytesWritten() - before;
+}
+
+struct Token {
+    uint16_t producer;
+    uint32_t sequence;
+};
+
+}  // namespace
+
+bool runLogBenchmark() {
+    printf("=== Benchmark: Logger mit Ringpuffer ===\n");
+    bool ok = true;
+    LogLevel previousLevel = Logger::getLevel();
+    Logger::flush(10000);
+    Logger::setLevel(LOG_VERBOSE);
+
+    // ===== Verzögertes Formatieren =====
+    const char* text = "Verbunden";
+    char stackBuffer[16];
+    snprintf(stackBuffer, sizeof(stackBuffer), "12:34:56.789");
+    bool formatOk = sameAsPrintf("║ Zeit: %-15s | Uptime: %10lu ms ║", stackBuffer, 123456UL) &&
+                    sameAsPrintf("%+6ld ms | %2u, %4lu verw.", -12L, 3U, 4000000000UL) &&
+                    sameAsPrintf("%6.2f °C %7.2f hPa %.3f", 21.456f, 1013.25, -0.0004) &&
+                    sameAsPrintf("%llu µs %lld %x %08X %o", 1767225615520999ULL, -5LL, 255U, 48879U, 8U) &&
+                    sameAsPrintf("%c%c %5.1f%% %s", 'O', 'K', 99.5, text) &&
+                    sameAsPrintf("100%% ohne Argumente") &&
+                    sameAsPrintf("%-10s|%10s|", "links", "rechts") &&
+                    sameAsPrintf("%d %i %u", (int16_t)-3, (int8_t)7, (uint8_t)200);
+    printf("  Formatieren beim Ausgeben wie snprintf -> %s\n", formatOk ? "OK" : "FEHLER");
+    ok = ok && formatOk;
+
+    // Kopierte Zeichenketten: Puffer darf danach überschrieben werden
+    uint64_t bytesBefore = Serial.getBytesWritten();
+    LOG_I("Bench", "Uhrzeit %s", stackBuffer);
+    strcpy(stackBuffer, "überschrieben");
+    bool deferred = Serial.getBytesWritten() == bytesBefore && Logger::getPendingCount() == 1;
+    Logger::process();
+    bool copiedOk = deferred && Logger::getPendingCount() == 0 &&
+                    Serial.getBytesWritten() > bytesBefore;
+    printf("  Aufruf schreibt nichts, Zeichenketten kopiert -> %s\n", copiedOk ? "OK" : "FEHLER");
+    ok = ok && copiedOk;
+
+    // ===== Kosten für den aufrufenden Task =====
+    // Je Runde zwei Meldungen wie im Messwert-Dashboard; der Log-Task
+    // (hier process()) läuft außerhalb der Messung
+    Stats queued;
+    Stats synchronous;
+    uint64_t allocationsInCalls = 0;
+    for (int round = 0; round < 2000; round++) {
+        uint64_t allocations = heapAllocationCount();
+        auto start = std::chrono::steady_clock::now();
+        LOG_I("Sensor", "T=%.2f °C, p=%.2f hPa, n=%lu", 21.5f + round * 0.01f, 1013.25f, (unsigned long)round);
+        LOG_PRINT_I("║ Takt: %+6ld ms Jitter | Queue: %2u ║", (long)round % 7, (unsigned)round % 32);
+        double ns = elapsedMicros(start) * 1000.0 / 2;
+        allocationsInCalls += heapAllocationCount() - allocations;
+        queued.add(ns);
+        Logger::flush(10000);
+
+        start = std::chrono::steady_clock::now();
+        logSynchronous("Sensor", "T=%.2f °C, p=%.2f hPa, n=%lu", 21.5f + round * 0.01f, 1013.25f, (unsigned long)round);
+        logSynchronous("Sensor", "║ Takt: %+6ld ms Jitter | Queue: %2u ║", (long)round % 7, (unsigned)round % 32);
+        synchronous.add(elapsedMicros(start) * 1000.0 / 2);
+    }
+    printf("  Host-CPU je Meldung für den Aufrufer [ns]:\n");
+    queued.print("Ringpuffer");
+    synchronous.print("snprintf + Serial");
+    // Auf dem ESP32 kommen beim synchronen Weg ~8,7 µs je Byte UART dazu
+    printf("  Dashboard (~2 KB) am UART: synchron %.0f ms blockiert, Ringpuffer 0 ms\n",
+           2048 * 10.0 / 115200.0 * 1000.0);
+    bool callOk = allocationsInCalls == 0;
+    printf("  Heap-Allokationen in LOG-Aufrufen: %llu -> %s\n",
+           (unsigned long long)allocationsInCalls, callOk ? "OK" : "FEHLER");
+    ok = ok && callOk;
+
+    // ===== Drosselung: höchstens LOG_SERIAL_BYTES_PER_S =====
+    Logger::flush(10000);
+    delay(1000);                           // Budget voll auffüllen
+    uint32_t dropsBefore = Logger::getDroppedCount();
+    for (int i = 0; i < LOG_QUEUE_SIZE + 16; i++) {
+        LOG_PRINT_I("%-100d", i);          // 101 Bytes je Zeile
+    }
+    uint32_t dropped = Logger::getDroppedCount() - dropsBefore;
+    bytesBefore = Serial.getBytesWritten();
+    unsigned long start = millis();
+    unsigned long drainedMs = 0;
+    uint64_t firstSecond = 0;
+    while (millis() - start < 5000) {
+        bool pending = Logger::process();
+        if (millis() - start <= 1000) {
+            firstSecond = Serial.getBytesWritten() - bytesBefore;
+        }
+        if (!pending && drainedMs == 0) {
+            drainedMs = millis() - start;
+        }
+        delay(LOG_DRAIN_INTERVAL_MS);
+    }
+    uint64_t limit = LOG_SERIAL_BYTES_PER_S + LOG_SERIAL_BYTES_PER_S / 4;   // + Anfangsbudget
+    bool rateOk = firstSecond <= limit && drainedMs > 0;
+    printf("  %d Zeilen à 101 Bytes: %llu Bytes in der 1. Sekunde (Grenze %llu), leer nach %lu ms -> %s\n",
+           LOG_QUEUE_SIZE + 16, (unsigned long long)firstSecond, (unsigned long long)limit,
+           drainedMs, rateOk ? "OK" : "FEHLER");
+    ok = ok && rateOk;
+    bool dropOk = dropped == 16;
+    printf("  Puffer voll: %lu Meldungen verworfen und gemeldet -> %s\n", (unsigned long)dropped,
+           dropOk ? "OK" : "FEHLER");
+    ok = ok && dropOk;
+
+    // ===== Level zur Laufzeit =====
+    Logger::setLevel(LOG_WARN);
+    LOG_I("Bench", "unterdrückt");
+    LOG_W("Bench", "sichtbar");
+    bool levelOk = Logger::getPendingCount() == 1;
+    Logger::flush(10000);
+    printf("  Laufzeit-Level WARN filtert INFO -> %s\n", levelOk ? "OK" : "FEHLER");
+    ok = ok && levelOk;
+
+    // ===== Binäres Format =====
+    Logger::setLevel(LOG_VERBOSE);
+    LogDecoder decoder;
+    size_t sites = decoder.addDirectory("src") + decoder.addDirectory("native/bench");
+    bool dictionaryOk = decoder.getDictionarySize() > 0 && decoder.getCollisionCount() == 0;
+    printf("  Wörterbuch: %zu Aufrufstellen, %zu Token, %lu Kollision(en) -> %s\n", sites,
+           decoder.getDictionarySize(), (unsigned long)decoder.getCollisionCount(),
+           dictionaryOk ? "OK" : "FEHLER (aus dem Projektverzeichnis starten)");
+    ok = ok && dictionaryOk;
+
+    // Gleiche Aufrufe zur gleichen Zeit: dekodiert == Text
+    Logger::flush(10000);
+    delay(1000);                           // Budget für alle Zeilen am Stück
+    std::string textOutput;
+    std::string binaryOutput;
+    std::string decoded;
+    Logger::setBinaryOutput(false);
+    Serial.setCapture(&textOutput);
+    logRoundTripCases(stackBuffer);
+    Logger::process();
+    Logger::setBinaryOutput(true);
+    Serial.setCapture(&binaryOutput);
+    logRoundTripCases(stackBuffer);
+    Logger::process();
+    Serial.setCapture(nullptr);
+    decoder.feed(binaryOutput, decoded);
+    // Mit LOG_BINARY gibt es keinen Text zum Vergleich
+    bool textOk = LOG_BINARY ? decoded.find("Fehler -42 bei ") != std::string::npos
+                             : decoded == textOutput;
+    bool roundTripOk = textOk && decoder.getFrameCount() == 9 && decoder.getUnknownCount() == 0 &&
+                       decoder.getErrorCount() == 0;
+    printf("  9 Meldungen binär (%zu statt %zu Bytes), dekodiert identisch mit Text -> %s\n",
+           binaryOutput.size(), textOutput.size(), roundTripOk ? "OK" : "FEHLER");
+    ok = ok && roundTripOk;
+
+    // Dashboard wie im Betrieb, je 10 Messwerte
+    std::string dashboardText;
+    std::string dashboardBinary;
+    std::string dashboardDecoded;
+    uint64_t textBytes = runDashboard(false, dashboardText);
+    uint64_t binaryBytes = runDashboard(true, dashboardBinary);
+    uint32_t unknownBefore = decoder.getUnknownCount();
+    uint32_t errorsBefore = decoder.getErrorCount();
+    decoder.feed(dashboardBinary, dashboardDecoded);
+    double ratio = binaryBytes ? (double)textBytes / binaryBytes : 0.0;
+    // Mit LOG_BINARY sind beide Durchläufe binär
+    bool dashboardOk = (LOG_BINARY || ratio >= 4.0) && decoder.getUnknownCount() == unknownBefore &&
+                       decoder.getErrorCount() == errorsBefore &&
+                       dashboardDecoded.find("BME280 - Umwelt-Sensor") != std::string::npos;
+    printf("  Dashboard, 10 Messwerte: Text %llu Bytes, binär %llu Bytes (%.1fx kleiner) -> %s\n",
+           (unsigned long long)textBytes, (unsigned long long)binaryBytes, ratio,
+           dashboardOk ? "OK" : "FEHLER");
+    ok = ok && dashboardOk;
+    Logger::setBinaryOutput(false);
+
+    // ===== Mehrere Produzenten gleichzeitig =====
+    // Vier Threads schreiben (bei voller Warteschlange neuer Versuch), einer
+    // liest: jeder Eintrag genau einmal, Reihenfolge je Produzent erhalten
+    static MpscQueue<Token, 64> tokens;
+    const int PRODUCERS = 4;
+    const uint32_t PER_PRODUCER = 100000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([p]() {
+            for (uint32_t i = 0; i < PER_PRODUCER; i++) {
+                Token token = { (uint16_t)p, i };
+                while (!tokens.push(token)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    uint32_t received = 0;
+    bool orderOk = true;
+    int64_t lastSequence[PRODUCERS] = { -1, -1, -1, -1 };
+    Token token;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!tokens.pop(token)) {
+            continue;
+        }
+        received++;
+        if ((int64_t)token.sequence != lastSequence[token.producer] + 1) orderOk = false;
+        lastSequence[token.producer] = token.sequence;
+    }
+    for (std::thread& t : producers) t.join();
+    bool mpscOk = orderOk && !tokens.pop(token);
+    printf("  %d Produzenten, %lu Einträge (Warteschlange %lu mal voll): %s -> %s\n",
+           PRODUCERS, (unsigned long)received, (unsigned long)tokens.getDroppedCount(),
+           orderOk ? "vollständig, Reihenfolge erhalten" : "VERLOREN/DOPPELT", mpscOk ? "OK" : "FEHLER");
+    ok = ok && mpscOk;
+
+    Logger::setLevel(previousLevel);
+    printf("\n");
+    return ok;
+}
@@ -0,0 +1,153 @@
+// ===== Host-Benchmark für den Hauptzyklus =====
+// Treibt setup()/loop() aus src/main.cpp mit simulierter Uhr und misst die
+// echte CPU-Zeit pro loop()-Aufruf auf dem Host. Messzyklen (Sensor lesen,
+// ggf. serialisieren + publish) werden getrennt von Leerlauf-Zyklen ausgewertet.
+// Die Buslast zählt alle I2C-Transaktionen (inkl. FIFO-Streaming).
+//
+// Danach folgen die Einzel-Benchmarks (z.B. Kodierung JSON vs. binär).
+//
+// Aufruf:  pio run -e native && .pio/build/native/program [Messzyklen] [--verbose]
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <mbedtls/ssl.h>
+#include "bench.h"
+#include "config.h"
+#include "sensors.h"
+#include "sim_bme280.h"
+#include "sim_mpu9250.h"
+#include <new>
+
+// ===== Heap-Allokationen zählen =====
+// Ersetzt den globalen operator new; malloc() direkt wird nicht erfasst,
+// src/ und die Mocks allokieren aber ausschließlich über new (String, std::).
+static uint64_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+uint64_t heapAllocationCount() {
+    return allocationCount;
+}
+
+// Telemetrie geht mit QoS 1 an PubSubClient vorbei (mqtt_qos1.h)
+static uint64_t publishCount() {
+    return PubSubClient::getPublishCount() + NativeTlsServer::getQos1Received();
+}
+
+static uint64_t payloadBytes() {
+    return PubSubClient::getPayloadBytes() + NativeTlsServer::getQos1PayloadBytes();
+}
+
+int main(int argc, char** argv) {
+    unsigned long targetCycles = 1000;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            targetCycles = strtoul(argv[i], nullptr, 10);
+        }
+    }
+
+    // Simulierte Hardware: BME280 auf 0x76, MPU9250 auf 0x68
+    Wire.attachDevice(BME280_I2C_ADDR);
+    Wire.attachDevice(Mpu9250Driver::ADDRESSES[0]);
+    SimMpu9250 mpuFifo(Wire, Mpu9250Driver::ADDRESSES[0]);
+    SimBme280 bmeRegisters(Wire, BME280_I2C_ADDR);
+    // Ein Access Point mit den Zugangsdaten aus config.h
+    WiFi.addAccessPoint(WIFI_SSID, WIFI_PASSWORD, 6, -58);
+
+    Serial.setMuted(!verbose);
+    setup();
+
+    Stats sampleCycles;      // µs CPU pro Messzyklus (ohne publish)
+    Stats publishCycles;     // µs CPU pro Messzyklus mit Veröffentlichung
+    Stats idleCycles;        // µs CPU pro Leerlauf-Zyklus
+    Stats serialPerCycle;    // Bytes auf Serial pro Messzyklus
+    Stats i2cPerCycle;       // I2C-Transaktionen pro Messzyklus
+    Stats heapPerCycle;      // Heap-Allokationen pro Messzyklus
+
+    uint64_t publishesBefore = publishCount();
+    uint64_t payloadBefore = payloadBytes();
+    unsigned long cycles = 0;
+    unsigned long simStartMs = millis();
+
+    while (cycles < targetCycles) {
+        uint64_t published = publishCount();
+        uint64_t serialBytes = Serial.getBytesWritten();
+        uint64_t i2cTransactions = Wire.getTransactionCount();
+        uint64_t bmeTransactions = Wire.getTransactionCount(BME280_I2C_ADDR);
+        uint64_t allocations = heapAllocationCount();
+
+        auto start = std::chrono::steady_clock::now();
+        loop();
+        double us = elapsedMicros(start);
+        uint64_t cycleAllocations = heapAllocationCount() - allocations;
+
+        // Messzyklus = BME280 wurde gelesen (MPU-FIFO-Streaming läuft in jedem Durchlauf)
+        if (Wire.getTransactionCount(BME280_I2C_ADDR) != bmeTransactions) {
+            if (publishCount() != published) {
+                publishCycles.add(us);
+            } else {
+                sampleCycles.add(us);
+            }
+            serialPerCycle.add((double)(Serial.getBytesWritten() - serialBytes));
+            i2cPerCycle.add((double)(Wire.getTransactionCount() - i2cTransactions));
+            heapPerCycle.add((double)cycleAllocations);
+            cycles++;
+        } else {
+            idleCycles.add(us);
+        }
+    }
+
+    uint64_t publishes = publishCount() - publishesBefore;
+    uint64_t payload = payloadBytes() - payloadBefore;
+    double serialMean = serialPerCycle.mean();
+
+    printf("\n=== Benchmark: sample -> serialize -> publish ===\n");
+    printf("  Simulierte Zeit:       %lu s\n", (millis() - simStartMs) / 1000);
+    printf("  Veröffentlichungen:    %llu (%.1f Bytes Payload/Nachricht)\n",
+           (unsigned long long)publishes, publishes ? (double)payload / publishes : 0.0);
+    printf("  Serial pro Zyklus:     %.0f Bytes (~%.1f ms UART @115200)\n",
+           serialMean, serialMean * 10.0 / 115200.0 * 1000.0);
+    printf("  I2C pro Zyklus:        %.1f Transaktionen\n", i2cPerCycle.mean());
+    printf("  Heap pro Zyklus:       %.1f Allokationen (max. %.0f)\n",
+           heapPerCycle.mean(), heapPerCycle.percentile(100));
+    printf("\n  CPU-Zeit auf dem Host [µs]:\n");
+    sampleCycles.print("Messzyklus");
+    publishCycles.print("Messzyklus + publish");
+    idleCycles.print("Leerlauf-Zyklus");
+    printf("\n");
+
+    bool ok = runCodecBenchmark(targetCycles);
+    ok = runStreamBenchmark() && ok;
+    ok = runVibrationBenchmark() && ok;
+    ok = runPowerBenchmark() && ok;
+    ok = runFilterBenchmark() && ok;
+    ok = runSasBenchmark() && ok;
+    ok = runReconnectBenchmark() && ok;
+    ok = runTlsBenchmark() && ok;
+    ok = runWifiBenchmark() && ok;
+    ok = runRoamingBenchmark() && ok;
+    ok = runTimeBenchmark() && ok;
+    ok = runLogBenchmark() && ok;
+    ok = runMetricsBenchmark() && ok;
+    ok = runQos1Benchmark() && ok;
+    ok = runSamplingBenchmark() && ok;
+    ok = runBme280Benchmark() && ok;
+    ok = runI2cBenchmark() && ok;
+    ok = runRegistryBenchmark() && ok;
+    ok = runOfflineBenchmark() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// ===== Benchmark: Laufzeit-Kennzahlen =====
+// Genauigkeit des HDR-Histogramms gegen exakte Perzentile einer breiten
+// Verteilung und Kosten je add(); danach Ende-zu-Ende über loop(): Berichte
+// im Device Twin (reported properties) im eingestellten Abstand, Inhalt,
+// Bestätigung durch den Hub und ein simuliertes Heap-Leck, das im nächsten
+// Bericht sichtbar sein muss.
+
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <string>
+#include "bench.h"
+#include "config.h"
+#include "metrics.h"
+#include "mqtt.h"
+#include "telemetry_codec.h"
+
+extern MQTTClient mqttClient;
+
+namespace {
+
+struct TwinReport {
+    std::string topic;
+    std::string payload;
+};
+
+std::vector<TwinReport> reports;
+
+// Zahl direkt hinter key (z.B. "\"free\":"), -1 wenn nicht vorhanden
+long long jsonNumber(const std::string& json, const char* key) {
+    size_t pos = json.find(key);
+    if (pos == std::string::npos) return -1;
+    return strtoll(json.c_str() + pos + strlen(key), nullptr, 10);
+}
+
+unsigned long requestId(const std::string& topic) {
+    size_t pos = topic.find("$rid=");
+    return pos == std::string::npos ? 0 : strtoul(topic.c_str() + pos + 5, nullptr, 10);
+}
+
+// loop() bis ein weiterer Bericht eingegangen ist oder timeoutMs vergangen sind
+bool waitForReport(unsigned long timeoutMs) {
+    size_t before = reports.size();
+    unsigned long start = millis();
+    while (reports.size() == before && millis() - start < timeoutMs) {
+        loop();
+    }
+    return reports.size() > before;
+}
+
+bool checkAccuracy() {
+    // Log-gleichverteilt über 10 µs .. 1 s plus einige Ausreißer: deckt
+    // viele Zweierpotenzen ab wie Zyklusdauern mit gelegentlichem TLS
+    std::vector<uint32_t> values;
+    uint32_t state = 12345;
+    for (int i = 0; i < 100000; i++) {
+        state = state * 1664525u + 1013904223u;
+        double exponent = 1.0 + 5.0 * (state >> 8) / 16777216.0;
+        values.push_back((uint32_t)pow(10.0, exponent));
+    }
+    values.push_back(4000000);
+
+    LatencyHistogram histogram;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t v : values) histogram.add(v);
+    double nsPerAdd = elapsedMicros(start) * 1000.0 / values.size();
+
+    std::vector<uint32_t> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    bool ok = histogram.getMax() == sorted.back() && histogram.getMin() == sorted.front() &&
+              histogram.getTotal() == sorted.size();
+    double worst = 0.0;
+    const uint8_t percentiles[] = { 50, 90, 99 };
+    for (uint8_t p : percentiles) {
+        // Gleiche Definition wie HdrHistogram::percentile(): kleinster Wert,
+        // unter dem mindestens p % liegen
+        size_t rank = (sorted.size() * p + 99) / 100;
+        double exact = sorted[rank - 1];
+        double error = fabs(histogram.percentile(p) - exact) / exact;
+        if (error > worst) worst = error;
+    }
+    ok = ok && worst <= 0.125;
+    printf("  HDR-Histogramm: %zu Bytes, %u Buckets, max. Fehler p50/p90/p99 %.1f %%, "
+           "%.1f ns/add (Host) -> %s\n", sizeof(histogram), (unsigned)LatencyHistogram::bucketCount(),
+           worst * 100.0, nsPerAdd, ok ? "OK" : "FEHLER");
+    return ok;
+}
+
+}  // namespace
+
+bool runMetricsBenchmark() {
+    printf("=== Benchmark: Laufzeit-Kennzahlen ===\n");
+    bool ok = checkAccuracy();
+
+#if LOW_POWER_MODE
+    // Im Stromsparbetrieb läuft kein Netzwerk-Zyklus, also kein Bericht
+    printf("  Ende-zu-Ende: im Stromsparbetrieb nicht aktiv\n\n");
+    return ok;
+#endif
+
+    reports.clear();
+    PubSubClient::setPublishObserver([](const char* topic, const uint8_t* payload, unsigned int length) {
+        if (strncmp(topic, "$iothub/twin/PATCH/properties/reported/", 39) == 0) {
+            reports.push_back({ topic, std::string((const char*)payload, length) });
+        }
+    });
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+
+    // Ersten Bericht abwarten (Intervall lief schon während der anderen
+    // Benchmarks), danach zwei volle Intervalle
+    uint32_t acceptedBefore = mqttClient.getTwinAcceptedCount();
+    bool first = waitForReport(METRICS_REPORT_INTERVAL_MS + 60000);
+    bool second = first && waitForReport(METRICS_REPORT_INTERVAL_MS + 60000);
+
+    // Heap-Leck zwischen zwei Berichten; reicht LEAK_BYTES über den bisherigen
+    // Tiefststand (z.B. TLS-Handshake) hinaus, sonst bleibt minFree unverändert
+    const int32_t LEAK_BYTES = 8000;
+    const int32_t headroom = (int32_t)(ESP.getFreeHeap() - ESP.getMinFreeHeap());
+    ESP.simulateHeapUse(headroom + LEAK_BYTES);
+    bool third = second && waitForReport(METRICS_REPORT_INTERVAL_MS + 60000);
+    ESP.simulateHeapUse(-(headroom + LEAK_BYTES));
+    // Bestätigung (204) kommt mit dem nächsten loop()
+    for (int i = 0; i < 10; i++) loop();
+
+    if (!third) {
+        printf("  Nur %zu Bericht(e) erhalten -> FEHLER\n\n", reports.size());
+        PubSubClient::setPublishObserver(nullptr);
+        WiFi.disconnect();
+        return false;
+    }
+
+    const std::string& b = reports[reports.size() - 2].payload;
+    const std::string& c = reports[reports.size() - 1].payload;
+
+    unsigned long firstRid = requestId(reports[reports.size() - 3].topic);
+    unsigned long lastRid = requestId(reports[reports.size() - 1].topic);
+    bool ridOk = firstRid > 0 && lastRid == firstRid + 2;
+    long long interval = jsonNumber(b, "\"intervalS\":");
+    long long uptimeDelta = jsonNumber(c, "\"uptimeS\":") - jsonNumber(b, "\"uptimeS\":");
+    bool periodOk = interval >= METRICS_REPORT_INTERVAL_MS / 1000 && interval <= METRICS_REPORT_INTERVAL_MS / 1000 + 1 &&
+                    uptimeDelta >= interval && uptimeDelta <= interval + 1;
+    printf("  Berichte: rid %lu..%lu, Abstand %lld s, %zu Bytes (max. %u) -> %s\n",
+           firstRid, lastRid, interval, b.size(), (unsigned)TelemetryCodec::METRICS_JSON_SIZE,
+           ridOk && periodOk && b.size() <= TelemetryCodec::METRICS_JSON_SIZE ? "OK" : "FEHLER");
+    ok = ok && ridOk && periodOk && b.size() <= TelemetryCodec::METRICS_JSON_SIZE;
+
+    // Ein Zyklus je 10 ms simulierter Zeit, BME280 im Takt der adaptiven
+    // Abtastung (ruhige Simulation: Grundtakt); der I2C-Mock kostet keine
+    // simulierte Zeit, die Dauern sind hier also ~0
+    long long loops = jsonNumber(b, "\"loopUs\":{\"n\":");
+    long long bmeReads = jsonNumber(b, "\"bmeReadUs\":{\"n\":");
+    long long bmeP50 = bmeReads >= 0 ? jsonNumber(b.substr(b.find("\"bmeReadUs\"")), "\"p50\":") : -1;
+#if ADAPTIVE_SAMPLING_ENABLED
+    long long expectedReads = METRICS_REPORT_INTERVAL_MS / BME_INTERVAL_MAX_MS;
+#else
+    long long expectedReads = METRICS_REPORT_INTERVAL_MS / SENSOR_READ_INTERVAL_MS;
+#endif
+    bool contentOk = b.compare(0, 22, "{\"metrics\":{\"uptimeS\":") == 0 && loops > 1000 &&
+                     bmeReads >= expectedReads - 1 && bmeReads <= expectedReads + 1 && bmeP50 >= 0 &&
+                     jsonNumber(b, "\"heap\":{\"free\":") > 0 && b.find("\"mpuReadUs\"") != std::string::npos &&
+                     b.find("\"tls\":{\"full\":") != std::string::npos &&
+                     jsonNumber(b, "\"serializeUs\":{\"n\":") > 0 && jsonNumber(b, "\"publishUs\":{\"n\":") > 0;
+    printf("  Inhalt: %lld Zyklen, %lld BME280-Messungen (p50 %lld µs), Senden und Kodieren erfasst -> %s\n",
+           loops, bmeReads, bmeP50, contentOk ? "OK" : "FEHLER");
+    ok = ok && contentOk;
+
+    // Das Leck muss sich in freiem Heap und Tiefststand zeigen
+    long long freeDrop = jsonNumber(b, "\"heap\":{\"free\":") - jsonNumber(c, "\"heap\":{\"free\":");
+    long long minFreeDrop = jsonNumber(b, "\"minFree\":") - jsonNumber(c, "\"minFree\":");
+    bool leakOk = freeDrop == headroom + LEAK_BYTES && minFreeDrop == LEAK_BYTES &&
+                  jsonNumber(c, "\"minFree\":") == jsonNumber(c, "\"heap\":{\"free\":");
+    printf("  Heap-Leck %ld Bytes (+%ld bis zum Tiefststand): freier Heap -%lld, Tiefststand -%lld -> %s\n",
+           (long)LEAK_BYTES, (long)headroom, freeDrop, minFreeDrop, leakOk ? "OK" : "FEHLER");
+    ok = ok && leakOk;
+
+    uint32_t accepted = mqttClient.getTwinAcceptedCount() - acceptedBefore;
+    bool ackOk = accepted >= 3 && mqttClient.getTwinRejectedCount() == 0;
+    printf("  Bestätigt vom Hub (204): %lu von %zu -> %s\n", (unsigned long)accepted, reports.size(),
+           ackOk ? "OK" : "FEHLER");
+    ok = ok && ackOk;
+
+    // Kosten eines Berichts ohne Senden: Zusammenfassen und Kodieren
+    Metrics scratch;
+    scratch.begin(millis());
+    for (uint32_t i = 0; i < 30000; i++) scratch.recordLoop(50 + i % 2000);
+    MetricsReport report = {};
+    char buffer[TelemetryCodec::METRICS_JSON_SIZE];
+    auto start = std::chrono::steady_clock::now();
+    scratch.collect(report, millis());
+    size_t length = TelemetryCodec::encodeMetricsJson(report, buffer, sizeof(buffer));
+    double us = elapsedMicros(start);
+    printf("  Bericht zusammenfassen + kodieren: %.1f µs (Host), %zu Bytes\n", us, length);
+
+    PubSubClient::setPublishObserver(nullptr);
+    WiFi.disconnect();
+    printf("\n");
+    return ok;
+}
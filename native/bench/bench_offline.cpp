@@ -0,0 +1,180 @@
+// ===== Benchmark: Offline-Speicher (LittleFS-Ringpuffer) =====
+// Läuft gegen die Dateisystem-Attrappe in einem eigenen Verzeichnis, damit
+// der Speicher des Hauptzyklus unberührt bleibt. Prüft Schreiben über das
+// Ringende hinaus samt Zählung der überschriebenen Datensätze, die
+// Wiederherstellung der Zeiger nach einem Neustart (mit und ohne
+// telemetry.rd), das Überspringen beschädigter Datensätze und dass
+// bestätigte Positionen einen Neustart überstehen.
+
+#include <LittleFS.h>
+#include "bench.h"
+#include "offline_store.h"
+
+namespace {
+
+const char* FS_ROOT = "/tmp/esp32_fs_offline";
+const char* DATA_FILE = "/telemetry.bin";     // wie in offline_store.cpp
+const char* POINTER_FILE = "/telemetry.rd";
+const uint32_t CAPACITY = OFFLINE_STORE_CAPACITY;
+const unsigned long BASE_EPOCH = 1700000000UL;   // Datensatz i hat BASE_EPOCH + i
+
+TelemetryBatch batch;
+
+// Datensätze first .. first+count-1 einzeln ablegen (ein Batch je Messwert)
+bool pushRange(OfflineStore& store, uint32_t first, uint32_t count) {
+    SensorData data = {};
+    data.temperature = 21.5f;
+    data.humidity = 48.0f;
+    data.pressure = 1012.3f;
+    data.bme280Valid = true;
+    bool ok = true;
+    for (uint32_t i = first; i < first + count && ok; i++) {
+        batch.clear();
+        batch.add(data, BASE_EPOCH + i);
+        ok = store.push(batch);
+    }
+    batch.clear();
+    return ok;
+}
+
+// Nummer des ältesten ausstehenden Datensatzes (ohne Bestätigung), sonst -1
+long nextRecord(OfflineStore& store) {
+    return store.loadPending(batch) > 0 ? (long)(batch.at(0).epoch - BASE_EPOCH) : -1;
+}
+
+// Ein Byte des Messwerts im Datensatz mit dieser Sequenznummer verfälschen
+void corrupt(uint32_t sequence) {
+    File file = LittleFS.open(DATA_FILE, "r+");
+    size_t offset = (sequence % CAPACITY) * sizeof(StoredRecord) + sizeof(uint32_t);
+    uint8_t value = 0;
+    file.seek(offset, SeekSet);
+    file.read(&value, 1);
+    value ^= 0x5A;
+    file.seek(offset, SeekSet);
+    file.write(&value, 1);
+    file.close();
+}
+
+}  // namespace
+
+bool runOfflineBenchmark() {
+    printf("=== Benchmark: Offline-Speicher ===\n");
+    bool ok = true;
+
+    const char* previousRoot = getenv("NATIVE_FS_ROOT");
+    std::string restoreRoot = previousRoot ? previousRoot : "";
+    setenv("NATIVE_FS_ROOT", FS_ROOT, 1);
+    LittleFS.begin(true);
+    LittleFS.format();
+
+    // ===== Erster Start: Datei mit fester Größe, nichts ausstehend =====
+    OfflineStore store;
+    bool started = store.begin();
+    File file = LittleFS.open(DATA_FILE, "r");
+    size_t fileSize = file ? file.size() : 0;
+    file.close();
+    bool freshOk = started && store.pending() == 0 && fileSize == CAPACITY * sizeof(StoredRecord);
+    printf("  Erster Start: %zu Bytes Datei, %lu ausstehend -> %s\n", fileSize,
+           (unsigned long)store.pending(), freshOk ? "OK" : "FEHLER");
+    ok = ok && freshOk;
+
+    // ===== Über das Ringende hinaus schreiben =====
+    const uint32_t overflow = 100;
+    auto start = std::chrono::steady_clock::now();
+    bool pushed = pushRange(store, 0, CAPACITY + overflow);
+    double usPerPush = elapsedMicros(start) / (CAPACITY + overflow);
+    long oldest = nextRecord(store);
+    bool wrapOk = pushed && store.pending() == CAPACITY && store.getDroppedCount() == overflow &&
+                  oldest == (long)overflow;
+    printf("  %lu Datensätze in %lu Plätze: %lu ausstehend, %lu überschrieben, ältester #%ld, "
+           "%.1f µs je push (Host) -> %s\n",
+           (unsigned long)(CAPACITY + overflow), (unsigned long)CAPACITY, (unsigned long)store.pending(),
+           store.getDroppedCount(), oldest, usPerPush, wrapOk ? "OK" : "FEHLER");
+    ok = ok && wrapOk;
+
+    // ===== Bestätigen, Neustart mit telemetry.rd =====
+    // Der Lesezeiger wird nur alle 32 Datensätze gespeichert; was danach
+    // bestätigt wurde, kommt nach dem Neustart noch einmal (Duplikate)
+    const uint32_t toAcknowledge = 40;
+    uint32_t before = store.pending();
+    uint32_t acknowledged = 0;
+    uint32_t persisted = 0;
+    while (acknowledged < toAcknowledge) {
+        store.loadPending(batch);
+        store.acknowledge();
+        acknowledged = before - store.pending();
+        if (acknowledged - persisted >= 32) {
+            persisted = acknowledged;
+        }
+    }
+    OfflineStore rebooted;
+    rebooted.begin();
+    long resumedAt = nextRecord(rebooted);
+    bool pointerOk = persisted > 0 && rebooted.pending() == CAPACITY - persisted &&
+                     resumedAt == (long)(overflow + persisted);
+    printf("  Neustart mit telemetry.rd: %lu bestätigt, weiter ab #%ld (%lu doppelt) -> %s\n",
+           (unsigned long)acknowledged, resumedAt, (unsigned long)(acknowledged - persisted),
+           pointerOk ? "OK" : "FEHLER");
+    ok = ok && pointerOk;
+
+    // ===== Neustart ohne telemetry.rd: ab dem ältesten gültigen Datensatz =====
+    LittleFS.remove(POINTER_FILE);
+    OfflineStore noPointer;
+    noPointer.begin();
+    long fromOldest = nextRecord(noPointer);
+    bool noPointerOk = noPointer.pending() == CAPACITY && fromOldest == (long)overflow;
+    printf("  Neustart ohne telemetry.rd: %lu ausstehend, weiter ab #%ld -> %s\n",
+           (unsigned long)noPointer.pending(), fromOldest, noPointerOk ? "OK" : "FEHLER");
+    ok = ok && noPointerOk;
+
+    // ===== Beschädigter Datensatz wird übersprungen, zählt aber als bestätigt =====
+    corrupt(overflow + 1);
+    std::vector<long> loaded;
+    uint32_t pendingBefore = noPointer.pending();
+    while (loaded.size() < 2 && noPointer.loadPending(batch) > 0) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            loaded.push_back((long)(batch.at(i).epoch - BASE_EPOCH));
+        }
+        noPointer.acknowledge();
+    }
+    uint32_t spanned = pendingBefore - noPointer.pending();
+    bool skipOk = loaded.size() >= 2 && loaded[0] == (long)overflow && loaded[1] == (long)overflow + 2 &&
+                  spanned == loaded.size() + 1;
+    printf("  Prüfsumme falsch bei #%lu: geladen #%ld, #%ld, %lu Plätze bestätigt -> %s\n",
+           (unsigned long)(overflow + 1), loaded.size() > 0 ? loaded[0] : -1L,
+           loaded.size() > 1 ? loaded[1] : -1L, (unsigned long)spanned, skipOk ? "OK" : "FEHLER");
+    ok = ok && skipOk;
+
+    // ===== Neustart mit beschädigtem neuesten Datensatz =====
+    // Halb geschriebener Datensatz beim Reset: Schreibzeiger endet davor
+    uint32_t newest = CAPACITY + overflow - 1;
+    corrupt(newest);
+    OfflineStore torn;
+    torn.begin();
+    bool tornOk = torn.pending() == newest - overflow && nextRecord(torn) == (long)overflow;
+    printf("  Neustart mit defektem neuesten Datensatz: %lu ausstehend -> %s\n",
+           (unsigned long)torn.pending(), tornOk ? "OK" : "FEHLER");
+    ok = ok && tornOk;
+
+    // ===== Alles bestätigt: bleibt nach dem Neustart leer =====
+    while (torn.pending() > 0 && torn.loadPending(batch) > 0) {
+        torn.acknowledge();
+    }
+    OfflineStore drained;
+    drained.begin();
+    bool drainedOk = torn.pending() == 0 && drained.pending() == 0 && nextRecord(drained) < 0;
+    printf("  Alles bestätigt, Neustart: %lu ausstehend -> %s\n",
+           (unsigned long)drained.pending(), drainedOk ? "OK" : "FEHLER");
+    ok = ok && drainedOk;
+
+    LittleFS.format();
+    if (previousRoot) {
+        setenv("NATIVE_FS_ROOT", restoreRoot.c_str(), 1);
+    } else {
+        unsetenv("NATIVE_FS_ROOT");
+    }
+    LittleFS.begin(true);
+
+    printf("  Speicher: %zu Bytes RAM, %zu Bytes je Datensatz\n\n", sizeof(OfflineStore), sizeof(StoredRecord));
+    return ok;
+}
@@ -0,0 +1,103 @@
+// ===== Benchmark: Stromsparbetrieb =====
+// Prüft die Messdauer des BME280 im Forced Mode je Oversampling-Stufe
+// (Datenblatt 9.1, in der Attrappe nachgebildet), den Schlafbefehl an den
+// MPU9250 an beiden möglichen Adressen und die Energiebilanz des
+// PowerManager über einen Zyklus mit bekannten Phasendauern. Rechnet daraus
+// die Batterielaufzeit für die Konfiguration aus config.h hoch.
+
+#include "bench.h"
+#include "power_manager.h"
+#include "sensors.h"
+
+namespace {
+
+struct Tier {
+    uint32_t intervalMs;
+    double expectedMs;   // 1 + 2·T + (2·P + 0,5) + (2·H + 0,5)
+    const char* name;
+};
+
+const Tier TIERS[] = {
+    { 60000, 8.0,  "T1 P1 H1 " },
+    { 30000, 14.0, "T1 P4 H1 " },
+    {  5000, 40.0, "T2 P16 H1" },
+};
+
+double energyMj(double ms, double currentMa) {
+    return POWER_SUPPLY_VOLTAGE * currentMa * ms / 1000.0;
+}
+
+}  // namespace
+
+bool runPowerBenchmark() {
+    printf("=== Benchmark: Stromsparbetrieb ===\n");
+    bool ok = true;
+
+    // ===== Forced Mode: Messdauer je Oversampling-Stufe =====
+    Sensors lowPowerSensors;
+    for (const Tier& tier : TIERS) {
+        lowPowerSensors.beginLowPower(tier.intervalMs);
+        SensorData data;
+        uint64_t start = NativeClock::nowMicros();
+        bool valid = lowPowerSensors.readForced(data);
+        double measuredMs = (NativeClock::nowMicros() - start) / 1000.0;
+        bool tierOk = valid && fabs(measuredMs - tier.expectedMs) < 0.01 && !data.mpu9250Valid;
+        printf("  Intervall %5lu ms: %s %5.1f ms Messdauer (soll %4.1f), %6.3f mJ CPU -> %s\n",
+               (unsigned long)tier.intervalMs, tier.name, measuredMs, tier.expectedMs,
+               energyMj(measuredMs, POWER_CPU_CURRENT_MA), tierOk ? "OK" : "FEHLER");
+        ok = ok && tierOk;
+    }
+
+    // ===== MPU9250 schlafen legen, auch an der zweiten Adresse (AD0 high) =====
+    const uint8_t REG_PWR_MGMT_1 = 0x6B;
+    const uint8_t alternate = Mpu9250Driver::ADDRESSES[1];
+    Wire.attachDevice(alternate);
+    Wire.setRegister(alternate, REG_PWR_MGMT_1, 0x01);
+    lowPowerSensors.beginLowPower(TIERS[0].intervalMs);
+    bool sleepOk = (Wire.getRegister(alternate, REG_PWR_MGMT_1) & 0x40) != 0;
+    Wire.detachDevice(alternate);
+    printf("  MPU9250 an 0x%02X im Schlafmodus (PWR_MGMT_1 SLEEP) -> %s\n", alternate, sleepOk ? "OK" : "FEHLER");
+    ok = ok && sleepOk;
+
+    // ===== Energiebilanz über einen Zyklus mit bekannten Phasen =====
+    // 100 ms CPU, 1000 ms Funk, 50 ms CPU, dann Schlaf bis 60 s
+    const unsigned long syncEpoch = 1700000000UL;
+    PowerManager power;
+    power.begin();
+    power.syncEpoch(syncEpoch);
+    delay(100);
+    power.setPhase(POWER_RADIO);
+    delay(1000);
+    power.setPhase(POWER_CPU);
+    delay(50);
+    power.sleepUntilNext(60000);
+
+    double sleepMs = 60000.0 - (POWER_BOOT_OVERHEAD_MS + 1150.0);
+    double expected = energyMj(POWER_BOOT_OVERHEAD_MS + 150.0, POWER_CPU_CURRENT_MA)
+                    + energyMj(1000.0, POWER_RADIO_CURRENT_MA)
+                    + energyMj(sleepMs, POWER_SLEEP_CURRENT_MA);
+    double measured = power.getLastCycleEnergyMj();
+    bool energyOk = fabs(measured - expected) / expected < 1e-3;
+    printf("  Energie pro Zyklus:    %.2f mJ (soll %.2f) -> %s\n",
+           measured, expected, energyOk ? "OK" : "FEHLER");
+
+    // Uhr nach dem Aufwachen: Synchronisation + 60 s Zyklus + Bootzeit
+    power.begin();
+    unsigned long epoch = power.getEpochTime();
+    bool clockOk = epoch == syncEpoch + 60;
+    printf("  Uhr nach Deep Sleep:   +%lu s (soll +60) -> %s\n",
+           epoch - syncEpoch, clockOk ? "OK" : "FEHLER");
+
+    // ===== Hochrechnung für die eingestellte Konfiguration =====
+    // Wachzeit ohne Uplink: Boot + Messdauer; Uplink: geschätzt 3 s Funk
+    double intervalMs = LOW_POWER_INTERVAL_S * 1000.0;
+    double sampleMj = energyMj(POWER_BOOT_OVERHEAD_MS + 10.0, POWER_CPU_CURRENT_MA)
+                    + energyMj(intervalMs, POWER_SLEEP_CURRENT_MA);
+    double uplinkMj = energyMj(3000.0, POWER_RADIO_CURRENT_MA) / LOW_POWER_SAMPLES_PER_UPLINK;
+    double averageMa = (sampleMj + uplinkMj) / POWER_SUPPLY_VOLTAGE / (intervalMs / 1000.0);
+    printf("  Hochrechnung (%u s, %u/Uplink): %.2f mJ/Messwert, %.3f mA -> %.0f Tage mit 2000 mAh\n\n",
+           (unsigned)LOW_POWER_INTERVAL_S, (unsigned)LOW_POWER_SAMPLES_PER_UPLINK,
+           sampleMj + uplinkMj, averageMa, 2000.0 / averageMa / 24.0);
+
+    return ok && energyOk && clockOk;
+}
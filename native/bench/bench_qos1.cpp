@@ -0,0 +1,214 @@
+// ===== Benchmark: QoS 1 mit Sendefenster =====
+// MqttQos1Publisher gegen den simulierten Broker der mbedTLS-Attrappe
+// (PUBACK nach einer Round-Trip): Durchsatz Stop-and-Wait gegen volles
+// Fenster, Latenz bis PUBACK, Wiederholung mit DUP bei verlorenen
+// Bestätigungen (Pakete unterschiedlicher Länge, Ringpuffer läuft über)
+// und nach einem Verbindungsabbruch. Zum Schluss über loop(): jede
+// Telemetrie-Nachricht wird bestätigt.
+
+#include <WiFi.h>
+#include "bench.h"
+#include "config.h"
+#include "mqtt.h"
+#include "mqtt_qos1.h"
+#include "tls_client.h"
+
+extern MQTTClient mqttClient;
+
+namespace {
+
+const char* TEST_CA =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBbenchbenchbench\n"
+    "-----END CERTIFICATE-----\n";
+const char* HOST = "bench-hub.azure-devices.net";
+const char* TOPIC = MQTT_TELEMETRY_TOPIC;
+
+// Paketpuffer der Testinstanzen (in MQTTClient ein Member)
+uint8_t packetBuffer[MQTT_INFLIGHT_BUFFER_SIZE];
+
+// Wie PubSubClient::loop(): eingehende Bytes lesen
+void drain(MqttQos1Publisher& publisher) {
+    uint8_t buffer[16];
+    while (publisher.available() > 0 && publisher.read(buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+// Bestätigte Kennungen (AckCallback)
+struct AckLog {
+    uint32_t tags[8];
+    size_t count;
+};
+
+void logAck(uint32_t tag, void* context) {
+    AckLog* log = static_cast<AckLog*>(context);
+    if (log->count < 8) {
+        log->tags[log->count] = tag;
+    }
+    log->count++;
+}
+
+struct RunResult {
+    double seconds;           // Simulierte Zeit bis alle bestätigt sind
+    bool complete;
+};
+
+// count Nachrichten senden, sobald das Fenster Platz hat; Takt 1 ms
+RunResult run(MqttQos1Publisher& publisher, uint32_t count, size_t minLength, size_t maxLength) {
+    static uint8_t payload[1024];
+    memset(payload, 'x', sizeof(payload));
+    uint64_t start = NativeClock::nowMicros();
+    uint32_t sent = 0;
+    while ((sent < count || !publisher.idle()) && NativeClock::nowMicros() - start < 600ULL * 1000000ULL) {
+        size_t length = minLength + (sent * 131) % (maxLength - minLength + 1);
+        if (sent < count && publisher.publish(TOPIC, payload, length) == MqttQos1Publisher::QOS1_SENT) {
+            sent++;
+            continue;
+        }
+        delay(1);
+        drain(publisher);
+        publisher.poll(millis());
+    }
+    RunResult r;
+    r.seconds = (NativeClock::nowMicros() - start) / 1e6;
+    r.complete = sent == count && publisher.idle();
+    return r;
+}
+
+}  // namespace
+
+bool runQos1Benchmark() {
+    printf("=== Benchmark: QoS 1 mit Sendefenster ===\n");
+    bool ok = true;
+    const uint32_t MESSAGES = 200;
+
+    NativeTlsServer::setRoundTripMs(40);
+    NativeTlsServer::setPubackLossEvery(0);
+
+    // ===== Stop-and-Wait gegen volles Fenster =====
+    double rate[2];
+    uint32_t p50[2];
+    for (int i = 0; i < 2; i++) {
+        TlsClient tls;
+        tls.setCACert(TEST_CA);
+        MqttQos1Publisher publisher(tls, packetBuffer, sizeof(packetBuffer));
+        publisher.setWindow(i == 0 ? 1 : MQTT_INFLIGHT_WINDOW);
+        publisher.connect(HOST, 8883);
+        RunResult r = run(publisher, MESSAGES, 250, 250);
+        rate[i] = MESSAGES / r.seconds;
+        p50[i] = publisher.getAckStats().percentile(50);
+        bool runOk = r.complete && publisher.getAckedCount() == MESSAGES && publisher.getRetransmitCount() == 0;
+        printf("  Fenster %2d: %u Nachrichten in %.1f s (%.0f/s), PUBACK p50 %lu µs, max. %u unbestätigt -> %s\n",
+               i == 0 ? 1 : MQTT_INFLIGHT_WINDOW, (unsigned)MESSAGES, r.seconds, rate[i], (unsigned long)p50[i],
+               (unsigned)publisher.getMaxInFlight(), runOk ? "OK" : "FEHLER");
+        ok = ok && runOk;
+        tls.stop();
+    }
+    bool speedupOk = rate[1] >= 4.0 * rate[0] && p50[1] < 2 * 40000;
+    printf("  Durchsatz %.1fx gegenüber Stop-and-Wait, Latenz bleibt bei einer Round-Trip -> %s\n",
+           rate[1] / rate[0], speedupOk ? "OK" : "FEHLER");
+    ok = ok && speedupOk;
+
+    // ===== Verlorene Bestätigungen, unterschiedliche Paketlängen =====
+    {
+        TlsClient tls;
+        tls.setCACert(TEST_CA);
+        MqttQos1Publisher publisher(tls, packetBuffer, sizeof(packetBuffer));
+        publisher.connect(HOST, 8883);
+        NativeTlsServer::setPubackLossEvery(7);
+        uint32_t duplicatesBefore = NativeTlsServer::getQos1Duplicates();
+        RunResult r = run(publisher, MESSAGES, 40, 900);
+        NativeTlsServer::setPubackLossEvery(0);
+        uint32_t duplicates = NativeTlsServer::getQos1Duplicates() - duplicatesBefore;
+        bool lossOk = r.complete && publisher.getAckedCount() == MESSAGES && publisher.getRetransmitCount() > 0 &&
+                      duplicates == publisher.getRetransmitCount();
+        printf("  Jede 7. Bestätigung verloren: alle %u bestätigt, %lu Wiederholungen (DUP), "
+               "PUBACK p99 %lu ms -> %s\n", (unsigned)publisher.getAckedCount(),
+               (unsigned long)publisher.getRetransmitCount(),
+               (unsigned long)publisher.getAckStats().percentile(99) / 1000, lossOk ? "OK" : "FEHLER");
+        ok = ok && lossOk;
+        tls.stop();
+    }
+
+    // ===== Verbindungsabbruch mit unbestätigten Nachrichten =====
+    {
+        TlsClient tls;
+        tls.setCACert(TEST_CA);
+        MqttQos1Publisher publisher(tls, packetBuffer, sizeof(packetBuffer));
+        publisher.connect(HOST, 8883);
+        AckLog acks = {};
+        publisher.setAckCallback(logAck, &acks);
+        uint8_t payload[100] = { 0 };
+        for (int i = 0; i < 5; i++) {
+            publisher.publish(TOPIC, payload, sizeof(payload), i == 2 ? 42 : MqttQos1Publisher::NO_TAG);
+        }
+        publisher.stop();   // Vor den PUBACKs
+        bool rejected = publisher.publish(TOPIC, payload, sizeof(payload)) == MqttQos1Publisher::QOS1_NOT_CONNECTED;
+        delay(1000);
+        publisher.connect(HOST, 8883);
+        uint32_t duplicatesBefore = NativeTlsServer::getQos1Duplicates();
+        publisher.poll(millis());   // Nach CONNACK: alles sofort wiederholen
+        uint32_t resent = NativeTlsServer::getQos1Duplicates() - duplicatesBefore;
+        size_t acksBeforeReconnect = acks.count;
+        RunResult r = run(publisher, 0, 1, 1);
+        bool reconnectOk = rejected && resent == 5 && r.complete && publisher.getAckedCount() == 5 &&
+                           acksBeforeReconnect == 0 && acks.count == 1 && acks.tags[0] == 42;
+        printf("  Abbruch mit 5 unbestätigten: nach Reconnect %lu wiederholt, alle bestätigt, "
+               "Rückmeldung erst mit dem PUBACK (%u vor, %u nach) -> %s\n", (unsigned long)resent,
+               (unsigned)acksBeforeReconnect, (unsigned)acks.count, reconnectOk ? "OK" : "FEHLER");
+        ok = ok && reconnectOk;
+        tls.stop();
+    }
+
+    // ===== Paket größer als der Puffer: Fehler, nicht "Fenster voll" =====
+    {
+        TlsClient tls;
+        tls.setCACert(TEST_CA);
+        MqttQos1Publisher publisher(tls, packetBuffer, sizeof(packetBuffer));
+        publisher.connect(HOST, 8883);
+        static uint8_t payload[MQTT_INFLIGHT_BUFFER_SIZE];
+        memset(payload, 'x', sizeof(payload));
+        MqttQos1Publisher::PublishResult tooLarge = publisher.publish(TOPIC, payload, sizeof(payload));
+        MqttQos1Publisher::PublishResult fits = publisher.publish(TOPIC, payload, sizeof(payload) - 200);
+        RunResult r = run(publisher, 0, 1, 1);
+        bool sizeOk = tooLarge == MqttQos1Publisher::QOS1_TOO_LARGE && publisher.getTooLargeCount() == 1 &&
+                      publisher.getWindowFullCount() == 0 && fits == MqttQos1Publisher::QOS1_SENT && r.complete;
+        printf("  Paket %u Bytes bei %u Bytes Puffer: abgelehnt als zu groß (nicht Fenster voll), "
+               "%u Bytes gesendet -> %s\n", (unsigned)sizeof(payload), (unsigned)publisher.getBufferSize(),
+               (unsigned)(sizeof(payload) - 200), sizeOk ? "OK" : "FEHLER");
+        ok = ok && sizeOk;
+        tls.stop();
+    }
+
+    // Der Puffer von MQTTClient fasst das größte Paket (Batch mit allen
+    // Zusatzkanälen bzw. Bericht), auch wenn MQTT_INFLIGHT_BUFFER_SIZE kleiner ist
+    size_t largest = TelemetryBatch::CAPACITY * TelemetryCodec::JSON_SAMPLE_SIZE;
+    bool bufferOk = mqttClient.getQos1Stats().getBufferSize() >= largest + sizeof(MQTT_VIBRATION_TOPIC) + 8;
+    printf("  Speicher: %zu Bytes (Fenster %d), Paketpuffer MQTTClient %u Bytes "
+           "(Batch bis %u Bytes) -> %s\n", sizeof(MqttQos1Publisher), MQTT_INFLIGHT_WINDOW,
+           (unsigned)mqttClient.getQos1Stats().getBufferSize(), (unsigned)largest, bufferOk ? "OK" : "FEHLER");
+    ok = ok && bufferOk;
+
+#if !LOW_POWER_MODE
+    // ===== Über loop(): Telemetrie wird bestätigt =====
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    const MqttQos1Publisher& qos1 = mqttClient.getQos1Stats();
+    uint32_t publishedBefore = qos1.getPublishedCount();
+    uint32_t ackedBefore = qos1.getAckedCount();
+    unsigned long start = millis();
+    // Der Telemetrie-Filter sendet mindestens je Heartbeat
+    while (millis() - start < 2UL * TELEMETRY_FILTER_HEARTBEAT_S * 1000UL) loop();
+    for (int i = 0; i < 10; i++) loop();
+    uint32_t published = qos1.getPublishedCount() - publishedBefore;
+    uint32_t acked = qos1.getAckedCount() - ackedBefore;
+    bool loopOk = published >= 2 && acked == published && qos1.getInFlightCount() == 0;
+    printf("  loop(), %d s: %lu Nachrichten mit QoS 1, %lu bestätigt -> %s\n",
+           2 * TELEMETRY_FILTER_HEARTBEAT_S, (unsigned long)published,
+           (unsigned long)acked, loopOk ? "OK" : "FEHLER");
+    ok = ok && loopOk;
+    WiFi.disconnect();
+#endif
+
+    printf("\n");
+    return ok;
+}
@@ -0,0 +1,157 @@
+// ===== Benchmark: Reconnect mit Backoff =====
+// Prüft die Backoff-Folge (Verdopplung bis zum Maximum), die Streuung des
+// Zufallsanteils über viele Geräte (kein Gleichtakt nach einem Hub-Ausfall)
+// und den sofortigen ersten Versuch. Danach simuliert es WLAN-Ausfälle über
+// die WiFi-Attrappe und misst, wie schnell der WifiManager ohne blockierende
+// Wartezeiten wieder verbindet.
+
+#include <WiFi.h>
+#include "bench.h"
+#include "config.h"
+#include "reconnect_scheduler.h"
+#include "wifi_setup.h"
+
+namespace {
+
+const unsigned long POLL_MS = 100;  // Aufrufabstand von handleReconnect()
+
+struct OutageResult {
+    unsigned long recoveryMs;   // Vom Wiederkehren des Links bis verbunden
+    uint32_t attempts;
+    double longestCallMs;       // Längste simulierte Dauer eines Aufrufs
+};
+
+// Link für outageMs abschalten und handleReconnect() im festen Takt aufrufen
+OutageResult simulateOutage(WifiManager& wifi, unsigned long outageMs) {
+    OutageResult result = { 0, 0, 0.0 };
+    uint32_t attemptsBefore = wifi.getReconnectStats().getAttemptCount();
+
+    WiFi.setLinkAvailable(false);
+    unsigned long start = millis();
+    unsigned long linkBackMs = 0;
+    bool linkBack = false;
+
+    while (millis() - start < outageMs + 10UL * 60UL * 1000UL) {
+        if (!linkBack && millis() - start >= outageMs) {
+            WiFi.setLinkAvailable(true);
+            linkBack = true;
+            linkBackMs = millis();
+        }
+        uint64_t callStart = NativeClock::nowMicros();
+        wifi.handleReconnect();
+        double callMs = (NativeClock::nowMicros() - callStart) / 1000.0;
+        if (callMs > result.longestCallMs) result.longestCallMs = callMs;
+
+        if (linkBack && wifi.getLinkState() == WIFI_LINK_UP) {
+            result.recoveryMs = millis() - linkBackMs;
+            break;
+        }
+        delay(POLL_MS);
+    }
+
+    result.attempts = wifi.getReconnectStats().getAttemptCount() - attemptsBefore;
+    return result;
+}
+
+}  // namespace
+
+bool runReconnectBenchmark() {
+    printf("=== Benchmark: Reconnect mit Backoff ===\n");
+    bool ok = true;
+
+    // ===== Backoff-Folge ohne Zufallsanteil =====
+    ReconnectScheduler scheduler(RECONNECT_BASE_DELAY_MS, WIFI_RECONNECT_MAX_DELAY_MS);
+    bool sequenceOk = scheduler.backoffCeilingMs(0) == 0;
+    uint32_t expected = RECONNECT_BASE_DELAY_MS;
+    printf("  Obergrenzen [s]:");
+    for (uint32_t n = 1; n <= 8; n++) {
+        uint32_t ceiling = scheduler.backoffCeilingMs(n);
+        printf(" %.0f", ceiling / 1000.0);
+        sequenceOk = sequenceOk && ceiling == expected;
+        expected = expected * 2 > WIFI_RECONNECT_MAX_DELAY_MS ? WIFI_RECONNECT_MAX_DELAY_MS : expected * 2;
+    }
+    sequenceOk = sequenceOk && scheduler.backoffCeilingMs(1000) == WIFI_RECONNECT_MAX_DELAY_MS;
+    printf(" ... -> %s\n", sequenceOk ? "OK" : "FEHLER");
+    ok = ok && sequenceOk;
+
+    // ===== Sofortiger erster Versuch, Backoff danach =====
+    const unsigned long t0 = 5000;
+    scheduler.markDisconnected(t0);
+    bool firstOk = scheduler.isDue(t0) && scheduler.getOutageCount() == 1;
+    scheduler.markAttempt();
+    scheduler.markFailure(t0);
+    uint32_t d = scheduler.getLastDelayMs();
+    firstOk = firstOk && !scheduler.isDue(t0 + d - 1) && scheduler.isDue(t0 + d) &&
+              d >= RECONNECT_BASE_DELAY_MS / 2 && d <= RECONNECT_BASE_DELAY_MS;
+    scheduler.markDisconnected(t0 + 1);  // Wiederholte Meldung startet keinen neuen Ausfall
+    firstOk = firstOk && scheduler.getOutageCount() == 1 && scheduler.getConsecutiveFailures() == 1;
+    scheduler.markConnected(t0 + 3000);
+    firstOk = firstOk && !scheduler.inOutage() && scheduler.getLongestOutageMs() == 3000;
+    printf("  Erster Versuch sofort, zweiter nach %lu ms -> %s\n",
+           (unsigned long)d, firstOk ? "OK" : "FEHLER");
+    ok = ok && firstOk;
+
+    // ===== Streuung über 1000 Geräte (Hub-Ausfall) =====
+    // Alle verlieren gleichzeitig die Verbindung und scheitern 5x
+    const int devices = 1000;
+    const uint32_t failures = 5;
+    Stats retryTimes;
+    int bucket[64] = { 0 };
+    for (int i = 0; i < devices; i++) {
+        ReconnectScheduler device(RECONNECT_BASE_DELAY_MS, MQTT_RECONNECT_MAX_DELAY_MS);
+        unsigned long now = 0;
+        device.markDisconnected(now);
+        for (uint32_t f = 0; f < failures; f++) {
+            device.markFailure(now);
+            now = device.getNextAttemptMs();
+        }
+        retryTimes.add(now / 1000.0);
+        bucket[(now / 1000) % 64]++;
+    }
+    int busiestSecond = 0;
+    for (int b : bucket) busiestSecond = b > busiestSecond ? b : busiestSecond;
+    double spread = retryTimes.percentile(100) - retryTimes.percentile(0);
+    double ceilingSum = 0;
+    for (uint32_t f = 1; f <= failures; f++) {
+        ReconnectScheduler probe(RECONNECT_BASE_DELAY_MS, MQTT_RECONNECT_MAX_DELAY_MS);
+        ceilingSum += probe.backoffCeilingMs(f) / 1000.0;
+    }
+    bool jitterOk = retryTimes.percentile(0) >= ceilingSum / 2 - 0.001 &&
+                    retryTimes.percentile(100) <= ceilingSum + 0.001 &&
+                    spread > ceilingSum / 4 && busiestSecond < devices / 10;
+    printf("  %d Geräte, %u. Versuch: %.1f..%.1f s (max. %d in einer Sekunde) -> %s\n",
+           devices, (unsigned)failures + 1, retryTimes.percentile(0), retryTimes.percentile(100),
+           busiestSecond, jitterOk ? "OK" : "FEHLER");
+    ok = ok && jitterOk;
+
+    // ===== WLAN-Ausfälle mit dem WifiManager =====
+    // Eigene Instanz; der globale WiFi-Zustand wird am Ende wiederhergestellt
+    WifiManager wifi;
+    bool connected = wifi.begin();
+    struct { unsigned long outageMs; unsigned long maxRecoveryMs; } cases[] = {
+        { 2000, 2UL * RECONNECT_BASE_DELAY_MS + 2 * POLL_MS },    // Kurzer Aussetzer
+        { 10UL * 60UL * 1000UL, WIFI_RECONNECT_MAX_DELAY_MS + 2 * POLL_MS },  // Backoff begrenzt
+    };
+    for (auto& c : cases) {
+        OutageResult r = simulateOutage(wifi, c.outageMs);
+        bool caseOk = connected && wifi.getLinkState() == WIFI_LINK_UP &&
+                      r.recoveryMs <= c.maxRecoveryMs && r.longestCallMs < 1.0;
+        printf("  WLAN-Ausfall %6lu ms: wieder verbunden nach %5lu ms, %2u Versuche, "
+               "längster Aufruf %.1f ms -> %s\n",
+               c.outageMs, r.recoveryMs, (unsigned)r.attempts, r.longestCallMs, caseOk ? "OK" : "FEHLER");
+        ok = ok && caseOk;
+    }
+    const ReconnectScheduler& stats = wifi.getReconnectStats();
+    bool statsOk = stats.getOutageCount() == 2 && !stats.inOutage() &&
+                   stats.getLongestOutageMs() >= 10UL * 60UL * 1000UL;
+    printf("  Zähler: %lu Ausfälle, %lu Versuche, %lu Fehlschläge, längster %lu s -> %s\n",
+           (unsigned long)stats.getOutageCount(), (unsigned long)stats.getAttemptCount(),
+           (unsigned long)stats.getFailureCount(), stats.getLongestOutageMs() / 1000,
+           statsOk ? "OK" : "FEHLER");
+    ok = ok && statsOk;
+
+    WiFi.setLinkAvailable(true);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    printf("\n");
+    return ok;
+}
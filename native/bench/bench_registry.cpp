@@ -0,0 +1,296 @@
+// ===== Benchmark: Sensortreiber-Registry =====
+// Globaler Bus mit BME280 und MPU9250 aus bench_main.cpp, dazu für diesen
+// Test ein SHT4x (0x44) und ein unbekanntes Gerät (EEPROM, 0x50). Geprüft
+// werden die Kanal-Tabelle gegen die festen Felder, die Treibersuche aus
+// dem Scan, die Zusatzkanäle im JSON (das Format der festen Kanäle bleibt
+// Byte für Byte gleich), CRC-Fehler, die Messzeit des SHT4x und die
+// Kosten des Aufrufs über die Typliste gegen direkte Aufrufe. Ein zweiter
+// Bus mit einem MPU9250 auf 0x69 prüft, dass der Treiber die gefundene
+// Adresse nutzt und nur über die I2C-Engine liest.
+
+#include "bench.h"
+#include "sensors.h"
+#include "sim_mpu9250.h"
+#include "sim_sht4x.h"
+#include "telemetry_codec.h"
+#include "telemetry_filter.h"
+
+namespace {
+
+const uint8_t SHT4X_ADDR = 0x44;
+const uint8_t EEPROM_ADDR = 0x50;
+
+// ===== Zwei Treiber ohne Bus, nur in diesem Test =====
+// Neue Treiber brauchen nur die Klasse und einen Eintrag in der Typliste
+struct FakeCo2Driver {
+    static const char NAME[];
+    static const uint8_t ADDRESSES[];
+    static const size_t ADDRESS_COUNT = 1;
+    static const uint8_t GROUP = SENSOR_GROUP_ENVIRONMENT;
+    static const uint8_t CHANNEL_COUNT = 2;
+    static const SensorChannelInfo CHANNELS[];
+
+    uint32_t reads = 0;
+
+    bool probe(I2CEngine&, uint8_t) { return true; }
+    bool begin(I2CEngine&, uint8_t) { return true; }
+    bool read(float* values) {
+        reads++;
+        values[0] = 400.0f + (float)(reads % 7);
+        values[1] = 20.0f + 0.01f * (float)(reads % 100);
+        return true;
+    }
+};
+
+struct TiltDriver {
+    static const char NAME[];
+    static const uint8_t ADDRESSES[];
+    static const size_t ADDRESS_COUNT = 1;
+    static const uint8_t GROUP = SENSOR_GROUP_MOTION;
+    static const uint8_t CHANNEL_COUNT = 1;
+    static const SensorChannelInfo CHANNELS[];
+
+    float angle = 0.0f;
+
+    bool probe(I2CEngine&, uint8_t) { return true; }
+    bool begin(I2CEngine&, uint8_t) { return true; }
+    bool read(float* values) {
+        angle += 0.25f;
+        values[0] = angle;
+        return true;
+    }
+};
+
+const char FakeCo2Driver::NAME[] = "CO2";
+const uint8_t FakeCo2Driver::ADDRESSES[] = { 0x10 };
+const SensorChannelInfo FakeCo2Driver::CHANNELS[] = {
+    { "co2", QUANTITY_CO2, "ppm", 0, nullptr },
+    { "co2Temperature", QUANTITY_TEMPERATURE, "°C", 2, nullptr }
+};
+const char TiltDriver::NAME[] = "Tilt";
+const uint8_t TiltDriver::ADDRESSES[] = { 0x11 };
+const SensorChannelInfo TiltDriver::CHANNELS[] = {
+    { "tilt", QUANTITY_ANGULAR_RATE, "°", 2, nullptr }
+};
+
+typedef SensorRegistry<FakeCo2Driver, TiltDriver> TestRegistry;
+
+struct ValueSink {
+    float* values;
+    void operator()(const SensorRecord& record) const { values[record.channel] = record.value; }
+};
+
+struct SumSink {
+    double* sum;
+    void operator()(const SensorRecord& record) const { *sum += record.value; }
+};
+
+double jsonValue(const char* json, const char* key) {
+    std::string pattern = std::string("\"") + key + "\":";
+    const char* p = strstr(json, pattern.c_str());
+    return p ? atof(p + pattern.size()) : NAN;
+}
+
+}  // namespace
+
+bool runRegistryBenchmark() {
+    printf("=== Benchmark: Sensortreiber-Registry ===\n");
+    bool ok = true;
+
+    // ===== Kanal-Tabelle: feste Kanäle wie TelemetryChannel =====
+    bool tableOk = SensorDriverRegistry::CHANNEL_COUNT == CHANNEL_COUNT + Sht4xDriver::CHANNEL_COUNT;
+    for (uint8_t c = 0; tableOk && c < CHANNEL_COUNT; c++) {
+        const SensorChannelInfo& info = SensorDriverRegistry::channel(c);
+        tableOk = strcmp(info.name, TelemetryFilter::CHANNEL_NAMES[c]) == 0 &&
+                  info.field == TelemetryFilter::CHANNEL_FIELDS[c];
+    }
+    for (uint8_t c = CHANNEL_COUNT; tableOk && c < SensorDriverRegistry::CHANNEL_COUNT; c++) {
+        const SensorChannelInfo& info = SensorDriverRegistry::channel(c);
+        tableOk = info.field == nullptr && strlen(info.name) <= SensorChannelInfo::SENSOR_NAME_MAX;
+    }
+    tableOk = tableOk && SensorDriverRegistry::firstChannel<Sht4xDriver>() == CHANNEL_COUNT;
+    printf("  Kanäle: %u (%u feste wie TelemetryChannel, SHT4x ab %u), Eintrag %zu Bytes -> %s\n",
+           SensorDriverRegistry::CHANNEL_COUNT, (unsigned)CHANNEL_COUNT,
+           SensorDriverRegistry::firstChannel<Sht4xDriver>(), sizeof(SensorRecord), tableOk ? "OK" : "FEHLER");
+    ok = ok && tableOk;
+
+    // ===== Treibersuche aus dem Scan =====
+    Wire.attachDevice(SHT4X_ADDR);
+    Wire.attachDevice(EEPROM_ADDR);
+    SimSht4x sht(Wire, SHT4X_ADDR);
+    Sensors sensors;
+    bool begun = sensors.begin();
+    const SensorDriverRegistry& registry = sensors.getRegistry();
+    bool discoverOk = begun && sensors.isScanComplete() && sensors.getScanDeviceCount() == 4 &&
+                      registry.getAddress<Bme280Driver>() == BME280_I2C_ADDR &&
+                      registry.getAddress<Mpu9250Driver>() == Mpu9250Driver::ADDRESSES[0] &&
+                      registry.getAddress<Sht4xDriver>() == SHT4X_ADDR &&
+                      SensorDriverRegistry::driverName(EEPROM_ADDR) == nullptr &&
+                      strcmp(SensorDriverRegistry::driverName(0x45), Sht4xDriver::NAME) == 0;
+    printf("  Scan: %u Geräte -> BME280 0x%02X, MPU9250 0x%02X, SHT4x 0x%02X, 0x%02X ohne Treiber -> %s\n",
+           sensors.getScanDeviceCount(), registry.getAddress<Bme280Driver>(),
+           registry.getAddress<Mpu9250Driver>(), registry.getAddress<Sht4xDriver>(), EEPROM_ADDR,
+           discoverOk ? "OK" : "FEHLER");
+    ok = ok && discoverOk;
+
+    // ===== Zusatzkanäle im Messwert und im JSON =====
+    const unsigned long epoch = 1767225600UL;
+    SensorData data;
+    delay(1000);
+    bool readOk = sensors.readAll(data);
+    char json[TelemetryCodec::JSON_SAMPLE_SIZE];
+    size_t length = TelemetryCodec::encodeJson(data, epoch, json, sizeof(json));
+    const SensorRecord* shtT = data.findExtra(SensorDriverRegistry::firstChannel<Sht4xDriver>());
+    double errT = shtT ? fabs(shtT->value - sht.getLastTemperature()) : 1e9;
+    double errH = fabs(jsonValue(json, "shtHumidity") - sht.getLastHumidity());
+    bool extraOk = readOk && data.bme280Valid && data.mpu9250Valid && data.extraCount == 2 &&
+                   shtT && shtT->type == QUANTITY_TEMPERATURE && errT < 1e-4 && errH <= 0.005 + 1e-4 &&
+                   length > 0 && strstr(json, ",\"gyroZ\":") < strstr(json, ",\"shtTemperature\":");
+    printf("  Messwert mit SHT4x: %u Zusatzkanäle, JSON %zu Bytes, Abweichung T %.4f °C, H %.3f %% -> %s\n",
+           data.extraCount, length, errT, errH, extraOk ? "OK" : "FEHLER");
+    printf("    %s\n", json);
+    ok = ok && extraOk;
+
+    // ===== Feste Kanäle: Format wie vorher =====
+    SensorData plain = data;
+    plain.extraCount = 0;
+    plain.epochMicros = 0;
+    plain.temperature = 21.5f;
+    plain.humidity = 45.25f;
+    plain.pressure = 1013.25f;
+    plain.accelX = 0.0125f;
+    plain.accelY = -0.5f;
+    plain.accelZ = 0.9875f;
+    plain.gyroX = 1.5f;
+    plain.gyroY = -0.25f;
+    plain.gyroZ = 0.75f;
+    TelemetryCodec::encodeJson(plain, epoch, json, sizeof(json));
+    // Ausgabe des Codecs mit fest kodierten Schlüsseln für dieselben Werte
+    bool formatOk = strcmp(json, "{\"timestamp\":1767225600,\"temperature\":21.5,\"humidity\":45.25,"
+                                 "\"pressure\":1013.25,\"accelX\":0.0125,\"accelY\":-0.5,"
+                                 "\"accelZ\":0.9875,\"gyroX\":1.5,\"gyroY\":-0.25,\"gyroZ\":0.75}") == 0;
+    printf("  Ohne Zusatzkanäle: %s -> %s\n", json, formatOk ? "OK" : "FEHLER");
+    ok = ok && formatOk;
+
+    // ===== CRC-Fehler: Wert null, übrige Sensoren gültig =====
+    sht.setCorruptCrc(true);
+    delay(1000);
+    bool partial = sensors.readAll(data) && data.bme280Valid && data.mpu9250Valid;
+    bool rejected = !registry.lastReadOk<Sht4xDriver>();
+    TelemetryCodec::encodeJson(data, epoch, json, sizeof(json));
+    sht.setCorruptCrc(false);
+    delay(1000);
+    sensors.readAll(data);
+    bool crcOk = partial && rejected && strstr(json, "\"shtTemperature\":null") != nullptr &&
+                 registry.lastReadOk<Sht4xDriver>() && !isnan(data.findExtra(CHANNEL_COUNT)->value);
+    printf("  CRC-Fehler im SHT4x-Frame: \"shtTemperature\":null, BME280/MPU9250 gültig, danach wieder Werte -> %s\n",
+           crcOk ? "OK" : "FEHLER");
+    ok = ok && crcOk;
+
+    // ===== Messzeit: Start mit dem vorigen Auslesen =====
+    SensorData env;
+    sensors.readSelected(env, true, false);
+    uint32_t immediate = registry.getReadMicros<Sht4xDriver>();
+    delay(SENSOR_READ_INTERVAL_MS);
+    sensors.readSelected(env, true, false);
+    uint32_t later = registry.getReadMicros<Sht4xDriver>();
+    bool timingOk = immediate >= Sht4xDriver::MEASURE_MICROS && later < 1000 && env.mpu9250Fresh == false;
+    printf("  SHT4x direkt nacheinander %lu us (Messzeit %lu us), im Messtakt %lu us -> %s\n",
+           (unsigned long)immediate, (unsigned long)Sht4xDriver::MEASURE_MICROS, (unsigned long)later,
+           timingOk ? "OK" : "FEHLER");
+    ok = ok && timingOk;
+
+    Wire.attachModel(SHT4X_ADDR, nullptr);
+    Wire.detachDevice(SHT4X_ADDR);
+    Wire.detachDevice(EEPROM_ADDR);
+
+    // ===== Zusatzkanäle: höchstens SENSOR_EXTRA_RECORDS je Messwert =====
+    SensorData full;
+    for (uint8_t c = 0; c < SENSOR_EXTRA_RECORDS + 2; c++) {
+        SensorRecord record = { (uint8_t)(100 + c), QUANTITY_CO2, (float)c, 0 };
+        full.storeExtra(record);
+    }
+    SensorRecord update = { 100, QUANTITY_CO2, 42.0f, 0 };
+    full.storeExtra(update);
+    bool capacityOk = full.extraCount == SENSOR_EXTRA_RECORDS && full.findExtra(100)->value == 42.0f &&
+                      full.findExtra(100 + SENSOR_EXTRA_RECORDS) == nullptr;
+    printf("  %u Kanäle für %u Plätze: %u übernommen, Aktualisierung am selben Platz -> %s\n",
+           SENSOR_EXTRA_RECORDS + 2, (unsigned)SENSOR_EXTRA_RECORDS, full.extraCount,
+           capacityOk ? "OK" : "FEHLER");
+    ok = ok && capacityOk;
+
+    // ===== Aufruf über die Typliste gegen direkte Aufrufe =====
+    TestRegistry testRegistry;
+    I2CAddressSet found;
+    found.clear();
+    found.add(FakeCo2Driver::ADDRESSES[0]);
+    found.add(TiltDriver::ADDRESSES[0]);
+    Serial.setMuted(true);
+    size_t testDrivers = testRegistry.discover(i2cBus, found);
+    Serial.setMuted(false);
+
+    const int rounds = 2000000;
+    double registrySum = 0.0;
+    SumSink sink = { &registrySum };
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        testRegistry.read(SENSOR_GROUP_ENVIRONMENT | SENSOR_GROUP_MOTION, sink);
+    }
+    double registryNs = elapsedMicros(start) * 1000.0 / rounds;
+
+    FakeCo2Driver co2;
+    TiltDriver tilt;
+    double directSum = 0.0;
+    SumSink directSink = { &directSum };
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        float values[3];
+        co2.read(values);
+        tilt.read(values + 2);
+        uint32_t timestamp = millis();
+        for (int v = 0; v < 3; v++) {
+            SensorRecord record = { (uint8_t)v, QUANTITY_CO2, values[v], timestamp };
+            directSink(record);
+        }
+    }
+    double directNs = elapsedMicros(start) * 1000.0 / rounds;
+    bool dispatchOk = testDrivers == 2 && TestRegistry::CHANNEL_COUNT == 3 &&
+                      TestRegistry::channel(2).name == TiltDriver::CHANNELS[0].name &&
+                      fabs(registrySum - directSum) < 1e-6 * directSum;
+    printf("  Zwei Testtreiber ohne Bus: %.1f ns je read() über die Registry, %.1f ns direkt "
+           "(ohne vtable, Zeitmessung je Treiber inklusive) -> %s\n",
+           registryNs, directNs, dispatchOk ? "OK" : "FEHLER");
+    ok = ok && dispatchOk;
+
+    // ===== MPU9250 mit AD0 high, ein Burst über die Engine =====
+    {
+        TwoWire bus;
+        bus.attachDevice(0x69);
+        SimMpu9250 mpu(bus, 0x69);
+        I2CEngine engine(bus);
+        engine.begin(I2C_SDA, I2C_SCL, 400000);
+        I2CAddressSet found;
+        found.clear();
+        found.add(0x69);
+        SensorRegistry<Mpu9250Driver> imu;
+        size_t drivers = imu.discover(engine, found);
+
+        float values[Mpu9250Driver::CHANNEL_COUNT] = {};
+        uint32_t completedBefore = engine.getCompletedCount();
+        uint64_t busBefore = bus.getTransactionCount(0x69);   // Zeiger schreiben + lesen = 2
+        size_t readOk69 = imu.read(SENSOR_GROUP_MOTION, ValueSink{ values });
+        uint32_t transactions = engine.getCompletedCount() - completedBefore;
+        uint64_t busTransactions = bus.getTransactionCount(0x69) - busBefore;
+        bool imuOk = drivers == 1 && imu.getAddress<Mpu9250Driver>() == 0x69 && readOk69 == 1 &&
+                     transactions == 1 && busTransactions == 2 && fabsf(values[2] - 1.0f) < 0.3f &&
+                     fabsf(values[0]) < 0.1f && fabsf(values[3]) < 3.0f;
+        printf("  MPU9250 auf 0x%02X: %lu Transaktion über die Engine je Messung (Registerzeiger + 14 Bytes), "
+               "accelZ %.3f g -> %s\n", imu.getAddress<Mpu9250Driver>(), (unsigned long)transactions, values[2],
+               imuOk ? "OK" : "FEHLER");
+        ok = ok && imuOk;
+    }
+
+    printf("  Speicher: SensorData %zu Bytes (%d Zusatzkanäle), Registry %zu Bytes\n\n", sizeof(SensorData),
+           SENSOR_EXTRA_RECORDS, sizeof(SensorDriverRegistry));
+    return ok;
+}
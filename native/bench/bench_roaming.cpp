@@ -0,0 +1,151 @@
+// ===== Benchmark: Mehrere APs und Roaming =====
+// Simuliert ein Lager mit drei Access Points desselben Netzes, einem
+// fremden Netz und dem Netz aus config.h. Prüft die Auswahl beim Start
+// (stärkster bekannter AP statt des ersten gefundenen wie bei
+// WIFI_FAST_SCAN), den Wechsel bei schwachem Signal ohne blockierende
+// Aufrufe, das Bleiben ohne besseren AP, den Reconnect über die
+// gespeicherten Kandidaten ohne neuen Scan und die Pflege der
+// Zugangsdaten per C2D (im NVS).
+
+#include <WiFi.h>
+#include <Preferences.h>
+#include "bench.h"
+#include "config.h"
+#include "wifi_setup.h"
+
+namespace {
+
+const unsigned long POLL_MS = 100;   // Aufrufabstand von handleReconnect()
+
+struct DriveResult {
+    bool reached;
+    unsigned long elapsedMs;
+    unsigned long offlineMs;      // Zeit ohne Verbindung
+    double longestCallMs;
+};
+
+// handleReconnect() im festen Takt, bis AP "target" verbunden ist (oder Zeitablauf)
+DriveResult drive(WifiManager& wifi, int target, unsigned long maxMs) {
+    DriveResult r = { false, 0, 0, 0.0 };
+    unsigned long start = millis();
+    while (millis() - start < maxMs) {
+        uint64_t callStart = NativeClock::nowMicros();
+        wifi.handleReconnect();
+        double callMs = (NativeClock::nowMicros() - callStart) / 1000.0;
+        if (callMs > r.longestCallMs) r.longestCallMs = callMs;
+        if (wifi.getLinkState() != WIFI_LINK_UP) {
+            r.offlineMs += POLL_MS;
+        } else if (target >= 0 && WiFi.getConnectedAp() == target) {
+            r.reached = true;
+            break;
+        }
+        delay(POLL_MS);
+    }
+    r.elapsedMs = millis() - start;
+    return r;
+}
+
+bool sendCommand(WifiManager& wifi, const char* json) {
+    StaticJsonDocument<256> doc;
+    if (deserializeJson(doc, (const uint8_t*)json, strlen(json))) {
+        return false;
+    }
+    return WifiManager::commandHandler(doc.as<JsonVariantConst>(), &wifi);
+}
+
+}  // namespace
+
+bool runRoamingBenchmark() {
+    printf("=== Benchmark: Mehrere APs und Roaming ===\n");
+    bool ok = true;
+
+    // ===== Lager: drei APs "Lager", ein fremdes Netz, das Netz aus config.h =====
+    WiFi.clearAccessPoints();
+    Preferences::eraseAll();
+    WifiManager::clearConnectionCache();
+    const int apNear = WiFi.addAccessPoint("Lager", "lager-pw", 1, -70);   // Kanal 1: ESP-Standard nimmt diesen
+    const int apHall = WiFi.addAccessPoint("Lager", "lager-pw", 6, -50);
+    const int apDock = WiFi.addAccessPoint("Lager", "lager-pw", 11, -60);
+    WiFi.addAccessPoint("Nachbar", "geheim", 3, -35);
+    WiFi.addAccessPoint(WIFI_SSID, WIFI_PASSWORD, 9, -80);
+    {
+        WifiCredentials provisioned;
+        provisioned.begin();                    // Leer -> config.h
+        provisioned.add("Lager", "lager-pw");
+    }
+
+    // Zum Vergleich: WiFi.begin() ohne BSSID (WIFI_FAST_SCAN) nimmt den ersten AP
+    WiFi.begin("Lager", "lager-pw");
+    while (WiFi.status() != WL_CONNECTED && WiFi.status() != WL_NO_SSID_AVAIL) delay(10);
+    int defaultAp = WiFi.getConnectedAp();
+    WiFi.disconnect();
+
+    WifiManager wifi;
+    bool connected = wifi.begin();
+    bool startOk = connected && WiFi.getConnectedAp() == apHall && defaultAp == apNear;
+    printf("  Start: AP %d (%d dBm) statt AP %d wie WiFi.begin() -> %s\n",
+           WiFi.getConnectedAp(), WiFi.RSSI(), defaultAp, startOk ? "OK" : "FEHLER");
+    ok = ok && startOk;
+
+    // ===== Gerät fährt zur Rampe: Halle schwach, Dock stark =====
+    WiFi.setApRssi(apHall, -82);
+    WiFi.setApRssi(apDock, -55);
+    DriveResult roam = drive(wifi, apDock, 60000);
+    bool roamOk = roam.reached && wifi.getRoamCount() == 1 &&
+                  roam.elapsedMs <= WIFI_ROAM_CHECK_INTERVAL_MS + WIFI_SCAN_MS_PER_CHANNEL * 13 + 2000 &&
+                  roam.longestCallMs < 1.0;
+    printf("  Signal -82 dBm: Wechsel zu AP %d nach %lu ms, %lu ms ohne Verbindung, "
+           "längster Aufruf %.1f ms -> %s\n", WiFi.getConnectedAp(), roam.elapsedMs, roam.offlineMs,
+           roam.longestCallMs, roamOk ? "OK" : "FEHLER");
+    ok = ok && roamOk;
+
+    // ===== Überall schwach: kein Wechsel, Scans durch Cooldown begrenzt =====
+    WiFi.setApRssi(apDock, -80);
+    WiFi.setApRssi(apNear, -78);
+    WiFi.setApRssi(apHall, -85);
+    uint32_t scansBefore = wifi.getRoamScanCount();
+    DriveResult stay = drive(wifi, -1, 3UL * WIFI_ROAM_COOLDOWN_MS);
+    uint32_t scans = wifi.getRoamScanCount() - scansBefore;
+    bool stayOk = WiFi.getConnectedAp() == apDock && wifi.getRoamCount() == 1 && stay.offlineMs == 0 &&
+                  scans >= 2 && scans <= 3;
+    printf("  Alle APs schwach: bleibt bei AP %d, %lu Scans in %lu s -> %s\n",
+           WiFi.getConnectedAp(), (unsigned long)scans, stay.elapsedMs / 1000, stayOk ? "OK" : "FEHLER");
+    ok = ok && stayOk;
+
+    // ===== AP fällt aus: Reconnect über die Kandidaten, ohne neuen Scan =====
+    uint32_t totalScans = wifi.getScanCount();
+    WiFi.setApAvailable(apDock, false);
+    DriveResult failover = drive(wifi, apNear, 30000);
+    bool failoverOk = failover.reached && wifi.getScanCount() == totalScans &&
+                      failover.offlineMs <= 2000;
+    printf("  AP %d ausgefallen: AP %d nach %lu ms, ohne Scan -> %s\n", apDock,
+           WiFi.getConnectedAp(), failover.offlineMs, failoverOk ? "OK" : "FEHLER");
+    ok = ok && failoverOk;
+    WiFi.setApAvailable(apDock, true);
+
+    // ===== Zugangsdaten per C2D =====
+    bool added = sendCommand(wifi, "{\"wifi\":{\"add\":{\"ssid\":\"Buero\",\"password\":\"pw\"}}}");
+    bool removedUnknown = sendCommand(wifi, "{\"wifi\":{\"remove\":\"Unbekannt\"}}");
+    bool ignored = !sendCommand(wifi, "{\"filter\":{\"enabled\":true}}");
+    WifiCredentials reloaded;
+    reloaded.begin();
+    bool credentialsOk = added && removedUnknown && ignored && wifi.getCredentials().size() == 3 &&
+                         reloaded.size() == 3 && reloaded.find("Buero") == 2 &&
+                         strcmp(reloaded.get(1).password, "lager-pw") == 0;
+    sendCommand(wifi, "{\"wifi\":{\"remove\":\"Buero\"}}");
+    reloaded.begin();
+    credentialsOk = credentialsOk && reloaded.size() == 2 && reloaded.find("Buero") < 0;
+    printf("  C2D add/remove, im NVS gespeichert (%u Netze) -> %s\n", (unsigned)reloaded.size(),
+           credentialsOk ? "OK" : "FEHLER");
+    ok = ok && credentialsOk;
+    wifi.printConnectStats();   // Nur mit --verbose sichtbar
+    wifi.disconnect();
+
+    // Ausgangszustand für die übrigen Benchmarks
+    WiFi.clearAccessPoints();
+    WiFi.addAccessPoint(WIFI_SSID, WIFI_PASSWORD, 6, -58);
+    Preferences::eraseAll();
+    WifiManager::clearConnectionCache();
+    printf("\n");
+    return ok;
+}
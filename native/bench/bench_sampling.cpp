@@ -0,0 +1,219 @@
+// ===== Benchmark: Adaptive Abtastung =====
+// Ein simulierter Tag mit eigenem Takt je Sensor: ruhiges Wetter mit
+// Tagesgang, eine Böenfront um 14 Uhr (Luftdruck, Temperatur und Feuchte
+// springen innerhalb von 10 Minuten) und eine Maschine, die ab 8 Uhr eine
+// halbe Stunde läuft (Schwingung am MPU9250). Geprüft werden Ruhe ohne
+// Fehlauslösung, Reaktionszeit, Auflösung während der Ereignisse, Rückkehr
+// zum Grundtakt, die Grenzen nach einer Änderung wie per C2D, eine Station
+// ohne MPU9250 und die Zahl der Sensorzugriffe gegenüber dem festen Takt.
+
+#include <limits.h>
+#include "bench.h"
+#include "sample_scheduler.h"
+
+namespace {
+
+const unsigned long STEP_MS = 100;
+const unsigned long HOUR_MS = 3600000UL;
+const unsigned long DAY_MS = 24 * HOUR_MS;
+const unsigned long MACHINE_START_MS = 8 * HOUR_MS;
+const unsigned long MACHINE_MS = 30 * 60000UL;
+const unsigned long FRONT_START_MS = 14 * HOUR_MS;
+const unsigned long FRONT_MS = 10 * 60000UL;
+
+uint32_t noiseState = 1;
+
+float noise(float amplitude) {
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return amplitude * ((float)(noiseState >> 8) / 8388608.0f - 1.0f);
+}
+
+void readBme(SensorData& data, unsigned long ms) {
+    double hours = ms / 3600000.0;
+    double front = ms < FRONT_START_MS ? 0.0 : std::min(1.0, (ms - FRONT_START_MS) / (double)FRONT_MS);
+    data.temperature = (float)(18.0 + 6.0 * sin(2 * M_PI * hours / 24.0) - 5.0 * front) + noise(0.05f);
+    data.humidity = (float)(55.0 - 15.0 * sin(2 * M_PI * hours / 24.0) + 20.0 * front) + noise(0.3f);
+    data.pressure = (float)(1013.0 + 2.0 * sin(2 * M_PI * hours / 48.0) + 3.0 * front) + noise(0.02f);
+    data.bme280Valid = true;
+}
+
+void readMpu(SensorData& data, unsigned long ms) {
+    bool running = ms >= MACHINE_START_MS && ms < MACHINE_START_MS + MACHINE_MS;
+    float vibration = running ? 0.1f * (float)sin(2 * M_PI * 23.71 * ms / 1000.0) : 0.0f;
+    data.accelX = vibration + noise(0.01f);
+    data.accelY = noise(0.01f);
+    data.accelZ = 1.0f + vibration + noise(0.01f);
+    data.gyroX = noise(0.5f);
+    data.gyroY = noise(0.5f);
+    data.gyroZ = noise(0.5f);
+    data.mpu9250Valid = true;
+}
+
+struct GroupResult {
+    uint32_t reads;
+    uint32_t eventReads;           // Während des Ereignisses
+    uint32_t quietActivations;     // Vor dem ersten Ereignis
+    unsigned long detectMs;        // Ereignisbeginn bis schneller Takt
+    unsigned long minGapMs;
+    unsigned long maxGapMs;
+    uint32_t quietIntervalMs;      // Takt am Ende des Tages
+    bool activeAtEnd;
+};
+
+struct DayResult {
+    GroupResult group[SAMPLE_GROUP_COUNT];
+    double nsPerObserve;
+};
+
+DayResult simulateDay(SampleScheduler& scheduler) {
+    const unsigned long eventStart[SAMPLE_GROUP_COUNT] = { FRONT_START_MS, MACHINE_START_MS };
+    const unsigned long eventEnd[SAMPLE_GROUP_COUNT] = { FRONT_START_MS + FRONT_MS, MACHINE_START_MS + MACHINE_MS };
+    DayResult result = {};
+    unsigned long lastRead[SAMPLE_GROUP_COUNT] = { 0, 0 };
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        result.group[g].minGapMs = ULONG_MAX;
+    }
+
+    SensorData data = {};
+    double observeUs = 0.0;
+    uint32_t observeCalls = 0;
+    for (unsigned long ms = 0; ms < DAY_MS; ms += STEP_MS) {
+        unsigned long scheduledMs;
+        uint8_t groups = scheduler.due(ms, scheduledMs);
+        if (groups == 0) {
+            continue;
+        }
+        if (groups & (1 << SAMPLE_GROUP_BME)) readBme(data, ms);
+        if (groups & (1 << SAMPLE_GROUP_MPU)) readMpu(data, ms);
+        data.timestamp = ms;
+
+        auto start = std::chrono::steady_clock::now();
+        scheduler.observe(data, groups, ms);
+        observeUs += elapsedMicros(start);
+        observeCalls++;
+
+        for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+            if (!(groups & (1 << g))) {
+                continue;
+            }
+            GroupResult& r = result.group[g];
+            if (r.reads > 0) {
+                r.minGapMs = std::min(r.minGapMs, ms - lastRead[g]);
+                r.maxGapMs = std::max(r.maxGapMs, ms - lastRead[g]);
+            }
+            lastRead[g] = ms;
+            r.reads++;
+            if (ms < eventStart[g]) {
+                r.quietActivations = scheduler.getActivationCount((SampleGroup)g);
+            } else if (ms < eventEnd[g]) {
+                r.eventReads++;
+                if (r.detectMs == 0 && scheduler.isActive((SampleGroup)g)) {
+                    r.detectMs = ms - eventStart[g];
+                }
+            }
+        }
+    }
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        result.group[g].quietIntervalMs = scheduler.getIntervalMs((SampleGroup)g);
+        result.group[g].activeAtEnd = scheduler.isActive((SampleGroup)g);
+    }
+    result.nsPerObserve = observeUs * 1000.0 / observeCalls;
+    return result;
+}
+
+}  // namespace
+
+bool runSamplingBenchmark() {
+    printf("=== Benchmark: Adaptive Abtastung ===\n");
+    bool ok = true;
+    const char* names[SAMPLE_GROUP_COUNT] = { "BME280", "MPU9250" };
+    const char* events[SAMPLE_GROUP_COUNT] = { "Böenfront 10 min", "Maschine 30 min" };
+    const unsigned long eventMs[SAMPLE_GROUP_COUNT] = { FRONT_MS, MACHINE_MS };
+    const uint32_t fixedReads = DAY_MS / SENSOR_READ_INTERVAL_MS;
+
+    // ===== Voreinstellungen aus config.h =====
+    SampleScheduler scheduler;
+    SamplingConfig defaults = scheduler.getRequestedConfig();
+    defaults.enabled = true;
+    scheduler.requestConfig(defaults);   // Auch bei ADAPTIVE_SAMPLING_ENABLED 0 messen
+    DayResult day = simulateDay(scheduler);
+    uint32_t totalReads = 0;
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        const GroupResult& r = day.group[g];
+        const GroupScheduleConfig& limits = defaults.groups[g];
+        uint32_t fixedEventReads = eventMs[g] / SENSOR_READ_INTERVAL_MS;
+        bool groupOk = r.quietActivations == 0 && r.detectMs > 0 &&
+                       r.detectMs <= limits.maxIntervalMs + 3 * (unsigned long)(limits.tauS * 1000.0f) &&
+                       r.eventReads >= 2 * fixedEventReads &&
+                       r.minGapMs >= limits.minIntervalMs && r.maxGapMs <= limits.maxIntervalMs + STEP_MS &&
+                       r.quietIntervalMs == limits.maxIntervalMs && !r.activeAtEnd;
+        printf("  %-8s %5lu Messungen/Tag (fest %lu), %s: erkannt nach %lu s, %lu statt %lu Messungen, "
+               "Abstand %.1f..%.1f s, danach wieder %lu s -> %s\n",
+               names[g], (unsigned long)r.reads, (unsigned long)fixedReads, events[g], r.detectMs / 1000,
+               (unsigned long)r.eventReads, (unsigned long)fixedEventReads, r.minGapMs / 1000.0,
+               r.maxGapMs / 1000.0, (unsigned long)(r.quietIntervalMs / 1000), groupOk ? "OK" : "FEHLER");
+        ok = ok && groupOk;
+        totalReads += r.reads;
+    }
+    bool volumeOk = totalReads * 3 <= 2 * fixedReads;
+    printf("  Sensorzugriffe: %lu statt %lu (%.1fx weniger), %.0f ns je observe() (Host) -> %s\n",
+           (unsigned long)totalReads, (unsigned long)(2 * fixedReads), 2.0 * fixedReads / totalReads,
+           day.nsPerObserve, volumeOk ? "OK" : "FEHLER");
+    ok = ok && volumeOk;
+
+    // ===== Geänderte Grenzen (wie per C2D) =====
+    SampleScheduler bounded;
+    SamplingConfig limits = bounded.getRequestedConfig();
+    limits.enabled = true;
+    limits.groups[SAMPLE_GROUP_BME] = { 5000, 300000, 60000, 60.0f };
+    limits.groups[SAMPLE_GROUP_MPU] = { 2000, 60000, 30000, 10.0f };
+    SamplingConfig invalid = limits;
+    invalid.groups[SAMPLE_GROUP_MPU].minIntervalMs = 120000;   // min > max
+    bool rejected = !bounded.requestConfig(invalid);
+    bool accepted = bounded.requestConfig(limits);
+    DayResult boundedDay = simulateDay(bounded);
+    bool boundsOk = rejected && accepted;
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        const GroupResult& r = boundedDay.group[g];
+        boundsOk = boundsOk && r.minGapMs >= limits.groups[g].minIntervalMs &&
+                   r.maxGapMs <= limits.groups[g].maxIntervalMs + STEP_MS && r.detectMs > 0;
+    }
+    printf("  Grenzen BME280 5..300 s, MPU9250 2..60 s: Abstand %.0f..%.0f s bzw. %.0f..%.0f s, "
+           "min > max abgelehnt -> %s\n",
+           boundedDay.group[SAMPLE_GROUP_BME].minGapMs / 1000.0, boundedDay.group[SAMPLE_GROUP_BME].maxGapMs / 1000.0,
+           boundedDay.group[SAMPLE_GROUP_MPU].minGapMs / 1000.0, boundedDay.group[SAMPLE_GROUP_MPU].maxGapMs / 1000.0,
+           boundsOk ? "OK" : "FEHLER");
+    ok = ok && boundsOk;
+
+    // ===== Station ohne MPU9250 =====
+    SampleScheduler bmeOnly;
+    bmeOnly.requestConfig(defaults);
+    bmeOnly.begin(1 << SAMPLE_GROUP_BME);
+    DayResult bmeOnlyDay = simulateDay(bmeOnly);
+    bool bmeOnlyOk = bmeOnlyDay.group[SAMPLE_GROUP_MPU].reads == 0 &&
+                     bmeOnlyDay.group[SAMPLE_GROUP_BME].reads * 20 >= day.group[SAMPLE_GROUP_BME].reads * 19 &&
+                     bmeOnlyDay.group[SAMPLE_GROUP_BME].reads * 20 <= day.group[SAMPLE_GROUP_BME].reads * 21;
+    printf("  Ohne MPU9250: %lu BME280-Messungen, %lu MPU9250-Termine -> %s\n",
+           (unsigned long)bmeOnlyDay.group[SAMPLE_GROUP_BME].reads,
+           (unsigned long)bmeOnlyDay.group[SAMPLE_GROUP_MPU].reads, bmeOnlyOk ? "OK" : "FEHLER");
+    ok = ok && bmeOnlyOk;
+
+    // ===== Abgeschaltet: fester Takt wie bisher =====
+    SampleScheduler fixed;
+    SamplingConfig off = fixed.getRequestedConfig();
+    off.enabled = false;
+    fixed.requestConfig(off);
+    DayResult fixedDay = simulateDay(fixed);
+    bool fixedOk = true;
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        const GroupResult& r = fixedDay.group[g];
+        fixedOk = fixedOk && r.reads == fixedReads && r.minGapMs == SENSOR_READ_INTERVAL_MS &&
+                  r.maxGapMs == SENSOR_READ_INTERVAL_MS;
+    }
+    printf("  Abgeschaltet: beide Sensoren fest alle %lu ms -> %s\n", (unsigned long)SENSOR_READ_INTERVAL_MS,
+           fixedOk ? "OK" : "FEHLER");
+    ok = ok && fixedOk;
+
+    printf("  Speicher: %zu Bytes\n\n", sizeof(SampleScheduler));
+    return ok;
+}
@@ -0,0 +1,197 @@
+// ===== Benchmark: SAS-Token =====
+// Known-Answer-Tests für HMAC-SHA256 (RFC 4231) und für komplette
+// SAS-Tokens (Referenz: Python hmac/base64/urllib.parse.quote), darunter
+// ein Key mit Null-Bytes und ein 64-Byte-Key. Danach Token-Cache gegen
+// generate(), Erneuerungszeitpunkt und CPU-Zeit/Heap pro Schritt.
+
+#include "bench.h"
+#include "sas.h"
+
+namespace {
+
+struct HmacVector {
+    const char* keyHex;
+    size_t keyRepeat;       // keyHex wird so oft wiederholt
+    const char* data;
+    size_t dataRepeat;      // data (1 Zeichen als Hex) so oft wiederholt; 0 = Text
+    const char* macHex;
+};
+
+// RFC 4231, Testfälle 1, 2, 3, 4 und 6 (Key länger als ein Block)
+const HmacVector HMAC_VECTORS[] = {
+    { "0b", 20, "Hi There", 0,
+      "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7" },
+    { "4a656665", 1, "what do ya want for nothing?", 0,
+      "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843" },
+    { "aa", 20, "dd", 50,
+      "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe" },
+    { "0102030405060708090a0b0c0d0e0f10111213141516171819", 1, "cd", 50,
+      "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b" },
+    { "aa", 131, "Test Using Larger Than Block-Size Key - Hash Key First", 0,
+      "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54" },
+};
+
+struct SasVector {
+    const char* name;
+    const char* hostname;
+    const char* deviceId;
+    const char* key;
+    unsigned long expiry;
+    const char* token;
+};
+
+const SasVector SAS_VECTORS[] = {
+    { "32-Byte-Key", "example-hub.azure-devices.net", "bench-device",
+      "AQIDBAUGBwgJCgsMDQ4PEBESExQVFhcYGRobHB0eHyA=", 1767312000UL,
+      "SharedAccessSignature sr=example-hub.azure-devices.net/devices/bench-device"
+      "&sig=ES07417NSIahKZkZtLUUfw%2FMfdwdZ%2BZAntLV7TolAUw%3D&se=1767312000" },
+    { "Key mit Null-Bytes", "myhub.azure-devices.net", "sensor-01",
+      "WgATAAB/AAcOFRwjKjE4P0ZNVFtiaXB3foWMk5qhqK8=", 1700000000UL,
+      "SharedAccessSignature sr=myhub.azure-devices.net/devices/sensor-01"
+      "&sig=PzNZSALnE0XyFKdt4d%2BCqxG8ukwDHHTXOWiZbDkzokI%3D&se=1700000000" },
+    { "64-Byte-Key", "iotHubIvanFoka.azure-devices.net", "iotWeatherstationesp32",
+      "BSRDYoGgv979HDtaeZi31vUUM1JxkK/O7QwrSmmIp8blBCNCYYCfvt38GzpZeJe21fQTMlFwj67N7AsqSWiHpg==", 2000000000UL,
+      "SharedAccessSignature sr=iotHubIvanFoka.azure-devices.net/devices/iotWeatherstationesp32"
+      "&sig=FXdrO4NTp%2B8Yb3R3oHZb5sJecfG7q0ajeQ3HqjzHVK4%3D&se=2000000000" },
+};
+
+size_t fromHex(const char* hex, uint8_t* output) {
+    size_t length = strlen(hex) / 2;
+    for (size_t i = 0; i < length; i++) {
+        unsigned value;
+        sscanf(hex + 2 * i, "%2x", &value);
+        output[i] = (uint8_t)value;
+    }
+    return length;
+}
+
+bool checkHmacVector(const HmacVector& vector) {
+    uint8_t unit[64], key[256], data[128], expected[32], mac[32];
+    size_t unitLength = fromHex(vector.keyHex, unit);
+    size_t keyLength = 0;
+    for (size_t r = 0; r < vector.keyRepeat; r++) {
+        memcpy(key + keyLength, unit, unitLength);
+        keyLength += unitLength;
+    }
+
+    size_t dataLength;
+    if (vector.dataRepeat > 0) {
+        uint8_t byte;
+        fromHex(vector.data, &byte);
+        memset(data, byte, vector.dataRepeat);
+        dataLength = vector.dataRepeat;
+    } else {
+        dataLength = strlen(vector.data);
+        memcpy(data, vector.data, dataLength);
+    }
+    fromHex(vector.macHex, expected);
+
+    mbedtls_sha256_context inner, outer;
+    mbedtls_sha256_init(&inner);
+    mbedtls_sha256_init(&outer);
+    SASToken::prepareHmac(key, keyLength, &inner, &outer);
+    SASToken::finishHmac(&inner, &outer, data, dataLength, mac);
+    return memcmp(mac, expected, sizeof(mac)) == 0;
+}
+
+template <typename F>
+double microsPerCall(int rounds, F call) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        call(i);
+    }
+    return elapsedMicros(start) / rounds;
+}
+
+}  // namespace
+
+bool runSasBenchmark() {
+    printf("=== Benchmark: SAS-Token ===\n");
+    SASToken generator;
+    char token[SASToken::MAX_TOKEN_SIZE];
+
+    // ===== Known-Answer-Tests =====
+    size_t hmacPassed = 0;
+    for (const HmacVector& vector : HMAC_VECTORS) {
+        hmacPassed += checkHmacVector(vector) ? 1 : 0;
+    }
+    size_t hmacCount = sizeof(HMAC_VECTORS) / sizeof(HMAC_VECTORS[0]);
+    printf("  HMAC-SHA256 RFC 4231:  %u/%u -> %s\n", (unsigned)hmacPassed, (unsigned)hmacCount,
+           hmacPassed == hmacCount ? "OK" : "FEHLER");
+
+    bool sasOk = true;
+    for (const SasVector& vector : SAS_VECTORS) {
+        size_t length = generator.generate(vector.hostname, vector.deviceId, vector.key, vector.expiry,
+                                           token, sizeof(token));
+        bool match = length == strlen(vector.token) && strcmp(token, vector.token) == 0;
+        printf("  SAS-Token %-20s %s\n", vector.name, match ? "OK" : "FEHLER");
+        if (!match) {
+            printf("    erwartet %s\n    erhalten %s\n", vector.token, token);
+        }
+        sasOk = sasOk && match;
+    }
+
+    // Fehlerfälle: ungültiges Base64, zu kleiner Ausgabepuffer
+    char small[64];
+    const SasVector& first = SAS_VECTORS[0];
+    bool errorsOk = generator.generate(first.hostname, first.deviceId, "kein*base64", first.expiry,
+                                       token, sizeof(token)) == 0 &&
+                    generator.generate(first.hostname, first.deviceId, first.key, first.expiry,
+                                       small, sizeof(small)) == 0;
+    printf("  Ungültiger Key / Puffer zu klein:   %s\n", errorsOk ? "OK" : "FEHLER");
+
+    // ===== Cache =====
+    const unsigned long epoch = 1767225600UL;
+    SasTokenCache cache;
+    bool begun = cache.begin(first.hostname, first.deviceId, first.key, SAS_TOKEN_LIFETIME_S);
+    const char* cached = begun ? cache.get(epoch) : nullptr;
+    generator.generate(first.hostname, first.deviceId, first.key, epoch + SAS_TOKEN_LIFETIME_S,
+                       token, sizeof(token));
+    bool sameToken = cached && strcmp(token, cached) == 0;
+    printf("  Cache == generate():               %s\n", sameToken ? "OK" : "FEHLER");
+
+    // Erneuerung zwischen RENEW_FRACTION und halber Restlaufzeit danach; vorher Cache-Treffer
+    unsigned long renewAfter = cache.getRenewAt() - epoch;
+    unsigned long earliest = (unsigned long)(SAS_TOKEN_LIFETIME_S * SAS_TOKEN_RENEW_FRACTION);
+    unsigned long latest = earliest + (SAS_TOKEN_LIFETIME_S - earliest) / 2;
+    bool hit = cache.get(epoch + earliest - 1) && cache.getRenewalCount() == 1;
+    unsigned long renewEpoch = cache.getRenewAt();
+    bool renewed = cache.get(renewEpoch) && cache.getRenewalCount() == 2 &&
+                   cache.getExpiry() == renewEpoch + SAS_TOKEN_LIFETIME_S;
+    bool scheduleOk = renewAfter >= earliest && renewAfter <= latest && hit && renewed;
+    printf("  Erneuerung nach %lu s (erlaubt %lu..%lu), Cache-Treffer davor -> %s\n",
+           renewAfter, earliest, latest, scheduleOk ? "OK" : "FEHLER");
+
+    // ===== CPU-Zeit und Heap pro Schritt =====
+    const int rounds = 5000;
+    uint8_t key[SASToken::MAX_DECODED_KEY_SIZE];
+    uint8_t mac[32];
+    mbedtls_sha256_context inner, outer;
+    mbedtls_sha256_init(&inner);
+    mbedtls_sha256_init(&outer);
+    size_t keyLength = SASToken::decodeKey(first.key, key, sizeof(key));
+    const char* toSign = "example-hub.azure-devices.net/devices/bench-device\n1767312000";
+
+    uint64_t allocationsBefore = heapAllocationCount();
+    double decodeUs = microsPerCall(rounds, [&](int) { SASToken::decodeKey(first.key, key, sizeof(key)); });
+    double prepareUs = microsPerCall(rounds, [&](int) { SASToken::prepareHmac(key, keyLength, &inner, &outer); });
+    double finishUs = microsPerCall(rounds, [&](int) {
+        SASToken::finishHmac(&inner, &outer, (const uint8_t*)toSign, strlen(toSign), mac);
+    });
+    double formatUs = microsPerCall(rounds, [&](int i) {
+        SASToken::formatToken("example-hub.azure-devices.net/devices/bench-device", mac, epoch + i,
+                              token, sizeof(token));
+    });
+    double generateUs = microsPerCall(rounds, [&](int i) {
+        generator.generate(first.hostname, first.deviceId, first.key, epoch + i, token, sizeof(token));
+    });
+    double renewUs = microsPerCall(rounds, [&](int i) { cache.renew(epoch + i); });
+    uint64_t allocations = heapAllocationCount() - allocationsBefore;
+
+    printf("  CPU [µs]: Base64 %.2f | HMAC vorbereiten %.2f | HMAC %.2f | Format %.2f\n",
+           decodeUs, prepareUs, finishUs, formatUs);
+    printf("            generate() %.2f | Cache renew() %.2f | Heap-Allokationen: %llu -> %s\n\n",
+           generateUs, renewUs, (unsigned long long)allocations, allocations == 0 ? "OK" : "FEHLER");
+
+    return hmacPassed == hmacCount && sasOk && errorsOk && sameToken && scheduleOk && allocations == 0;
+}
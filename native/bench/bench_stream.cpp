@@ -0,0 +1,102 @@
+// ===== Benchmark: MPU9250 FIFO-Streaming =====
+// Treibt MPU9250Stream gegen das FIFO-Modell (sim_mpu9250) mit simulierter
+// Uhr: Weckintervall = Blockdauer wie mit Data-Ready-Interrupt. Prüft, dass
+// alle Werte lückenlos und ohne Überlauf ankommen, und weist Buslast und
+// CPU-Zeit pro Auslesevorgang aus.
+
+#include "bench.h"
+#include "mpu_stream.h"
+#include "sensors.h"
+
+namespace {
+
+struct StreamCheck {
+    uint32_t samples = 0;
+    uint32_t blocks = 0;
+    int64_t lastFirstMicros = 0;
+    bool monotonic = true;
+    double sumZ = 0.0;
+};
+
+void collectBlock(const MotionBlock& block, void* context) {
+    StreamCheck* check = (StreamCheck*)context;
+    if (check->blocks > 0 && block.firstSampleMicros <= check->lastFirstMicros) {
+        check->monotonic = false;
+    }
+    check->lastFirstMicros = block.firstSampleMicros;
+    for (size_t i = 0; i < block.count; i++) {
+        check->sumZ += block.samples[i][2];
+    }
+    check->samples += block.count;
+    check->blocks++;
+}
+
+bool runStream(uint16_t rateHz, bool withGyro, uint16_t blockSize, unsigned long seconds) {
+    MPU9250Stream stream(&i2cBus, Mpu9250Driver::ADDRESSES[0]);
+    StreamCheck check;
+    stream.onBlock(collectBlock, &check);
+    if (!stream.begin(rateHz, withGyro, blockSize)) {
+        return false;
+    }
+
+    // Blockdauer in µs = Abstand zwischen zwei Weck-Interrupts
+    uint64_t wakeMicros = 1000000ULL * blockSize / stream.getRateHz();
+    uint64_t endMicros = NativeClock::nowMicros() + seconds * 1000000ULL;
+    Stats cpu;
+    Stats transactions;
+
+    while (NativeClock::nowMicros() < endMicros) {
+        NativeClock::advanceMicros(wakeMicros);
+        uint64_t before = Wire.getTransactionCount();
+        auto start = std::chrono::steady_clock::now();
+        stream.service();
+        cpu.add(elapsedMicros(start));
+        transactions.add((double)(Wire.getTransactionCount() - before));
+    }
+    stream.stop();
+
+    uint32_t expected = (uint32_t)(seconds * stream.getRateHz());
+    double meanG = check.samples ? check.sumZ / check.samples / MPU9250Stream::ACCEL_LSB_PER_G : 0.0;
+    bool complete = stream.getSampleCount() + blockSize >= expected && stream.getOverflowCount() == 0;
+    bool ok = complete && check.monotonic && check.samples == check.blocks * blockSize &&
+              fabs(meanG - 1.0) < 0.01;
+
+    printf("  %4u Hz %-10s %3u/Block: %6lu von %6lu Werten, %lu Überläufe, "
+           "%.2f I2C/Wert, Z=%.3f g -> %s\n",
+           stream.getRateHz(), withGyro ? "Accel+Gyro" : "Accel", blockSize,
+           (unsigned long)stream.getSampleCount(), (unsigned long)expected,
+           (unsigned long)stream.getOverflowCount(),
+           transactions.mean() * transactions.samples.size() / (check.samples ? check.samples : 1),
+           meanG, ok ? "OK" : "FEHLER");
+    cpu.print("CPU pro Weckvorgang");
+    return ok;
+}
+
+// Ausleser zu spät: Überlauf muss erkannt und der FIFO neu gestartet werden
+bool runOverflow() {
+    MPU9250Stream stream(&i2cBus, Mpu9250Driver::ADDRESSES[0]);
+    if (!stream.begin(1000, true, 32)) {
+        return false;
+    }
+    NativeClock::advanceMicros(100000);   // 100 Werte, FIFO fasst 42
+    stream.service();
+    NativeClock::advanceMicros(32000);
+    size_t after = stream.service();
+    stream.stop();
+
+    bool ok = stream.getOverflowCount() == 1 && after == 32;
+    printf("  Überlauf nach 100 ms Stillstand: %lu erkannt, danach %u Werte -> %s\n\n",
+           (unsigned long)stream.getOverflowCount(), (unsigned)after, ok ? "OK" : "FEHLER");
+    return ok;
+}
+
+}  // namespace
+
+bool runStreamBenchmark() {
+    printf("=== Benchmark: MPU9250 FIFO-Streaming ===\n");
+    bool ok = runStream(1000, true, 32, 10);
+    ok = runStream(4000, false, 64, 10) && ok;
+    ok = runStream(200, true, 16, 10) && ok;
+    ok = runOverflow() && ok;
+    return ok;
+}
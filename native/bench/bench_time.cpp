@@ -0,0 +1,175 @@
+// ===== Benchmark: Zeitdienst (SNTP) =====
+// Gegen den simulierten NTP-Server (AsyncUDP-Mock): erste Synchronisation,
+// Langzeitlauf mit driftendem Quarz und Laufzeit-Jitter (Fehler gegen die
+// wahre Zeit, Monotonie, geschätzte Frequenz), Eingleiten kleiner und
+// Springen großer Abweichungen, Verhalten bei Paketverlust und
+// Kiss-o'-Death sowie die Dauer jedes poll()-Aufrufs.
+
+#include <WiFi.h>
+#include <AsyncUDP.h>
+#include "bench.h"
+#include "config.h"
+#include "time_service.h"
+
+namespace {
+
+const unsigned long POLL_MS = 50;   // Takt des Netzwerk-Tasks
+
+struct RunResult {
+    double maxErrorUs;        // |Uhr - wahre Zeit| ab settleMs
+    double maxCallMs;         // Längster poll()-Aufruf (simulierte Zeit)
+    bool monotonic;
+};
+
+int64_t clockError(const TimeService& clock) {
+    return (int64_t)clock.nowEpochMicros() - NativeNtpServer::trueEpochMicros();
+}
+
+// poll() im festen Takt; Fehler erst nach settleMs werten
+RunResult run(TimeService& clock, unsigned long durationMs, unsigned long settleMs) {
+    RunResult r = { 0.0, 0.0, true };
+    unsigned long start = millis();
+    uint64_t previous = clock.nowEpochMicros();
+    while (millis() - start < durationMs) {
+        uint64_t callStart = NativeClock::nowMicros();
+        clock.poll(millis());
+        double callMs = (NativeClock::nowMicros() - callStart) / 1000.0;
+        if (callMs > r.maxCallMs) r.maxCallMs = callMs;
+
+        uint64_t now = clock.nowEpochMicros();
+        if (now < previous) r.monotonic = false;
+        previous = now;
+        if (millis() - start >= settleMs) {
+            double error = (double)clockError(clock);
+            if (error < 0) error = -error;
+            if (error > r.maxErrorUs) r.maxErrorUs = error;
+        }
+        delay(POLL_MS);
+    }
+    return r;
+}
+
+bool connect() {
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    unsigned long start = millis();
+    while (WiFi.status() != WL_CONNECTED && millis() - start < 10000) delay(10);
+    return WiFi.status() == WL_CONNECTED;
+}
+
+}  // namespace
+
+bool runTimeBenchmark() {
+    printf("=== Benchmark: Zeitdienst (SNTP) ===\n");
+    bool ok = true;
+
+    if (!connect()) {
+        printf("  WLAN nicht verbunden -> FEHLER\n\n");
+        return false;
+    }
+
+    // ===== Erste Synchronisation: Sprung auf die wahre Zeit =====
+    NativeNtpServer::reset();
+    NativeNtpServer::setClockOffsetMicros(1234567);
+    {
+        TimeService clock;
+        bool synced = clock.syncBlocking(NTP_SYNC_TIMEOUT_MS);
+        int64_t error = clockError(clock);
+        bool firstOk = synced && clock.getStepCount() == 1 && error > -1000 && error < 1000;
+        printf("  Erste Synchronisation: Fehler %+lld µs, Laufzeit %lu µs -> %s\n", (long long)error,
+               (unsigned long)clock.getDelayMicros(), firstOk ? "OK" : "FEHLER");
+        ok = ok && firstOk;
+    }
+
+    // ===== Quarz 40 ppm zu schnell, asymmetrischer Jitter, 30 min =====
+    NativeNtpServer::reset();
+    NativeNtpServer::setDriftPpm(40.0);
+    NativeNtpServer::setJitterMicros(1000);
+    {
+        TimeService clock;
+        clock.syncBlocking(NTP_SYNC_TIMEOUT_MS);
+        RunResult r = run(clock, 30UL * 60 * 1000, 10UL * 60 * 1000);
+        float ppm = clock.getFrequencyPpm();
+        bool driftOk = r.monotonic && r.maxErrorUs < 1000.0 && clock.getStepCount() == 1 &&
+                       ppm > -44.0f && ppm < -36.0f && r.maxCallMs < 1.0;
+        printf("  40 ppm Drift, 30 min: max. Fehler %.0f µs, Frequenz %+.1f ppm, %lu Sprung, %s -> %s\n",
+               r.maxErrorUs, ppm, (unsigned long)clock.getStepCount(),
+               r.monotonic ? "monoton" : "NICHT monoton", driftOk ? "OK" : "FEHLER");
+        ok = ok && driftOk;
+        clock.printStats();   // Nur mit --verbose sichtbar
+
+        // Die geschätzte Schranke muss den tatsächlichen Fehler einschließen
+        uint32_t bound = clock.getErrorBoundMicros();
+        double actual = (double)clockError(clock);
+        if (actual < 0) actual = -actual;
+        bool boundOk = actual <= bound;
+        printf("  Fehlerschranke %lu µs >= tatsächlicher Fehler %.0f µs -> %s\n",
+               (unsigned long)bound, actual, boundOk ? "OK" : "FEHLER");
+        ok = ok && boundOk;
+    }
+
+    // ===== 50 ms Abweichung: eingleiten, kein Sprung =====
+    NativeNtpServer::reset();
+    {
+        TimeService clock;
+        clock.syncBlocking(NTP_SYNC_TIMEOUT_MS);
+        NativeNtpServer::setClockOffsetMicros(50000 - clockError(clock));
+        clock.requestSync();
+        RunResult r = run(clock, 3UL * 60 * 1000, 2UL * 60 * 1000);
+        bool slewOk = clock.getStepCount() == 1 && r.monotonic && r.maxErrorUs < 1000.0;
+        printf("  +50 ms: eingeglitten, max. Fehler %.0f µs nach 2 min, %s -> %s\n", r.maxErrorUs,
+               r.monotonic ? "monoton" : "NICHT monoton", slewOk ? "OK" : "FEHLER");
+        ok = ok && slewOk;
+    }
+
+    // ===== 2 s Abweichung: Sprung =====
+    NativeNtpServer::reset();
+    {
+        TimeService clock;
+        clock.syncBlocking(NTP_SYNC_TIMEOUT_MS);
+        NativeNtpServer::setClockOffsetMicros(-2000000);
+        clock.requestSync();
+        RunResult r = run(clock, 10000, 5000);
+        bool stepOk = clock.getStepCount() == 2 && r.maxErrorUs < 1000.0;
+        printf("  -2 s: Sprung, Fehler danach %.0f µs -> %s\n", r.maxErrorUs, stepOk ? "OK" : "FEHLER");
+        ok = ok && stepOk;
+    }
+
+    // ===== Paketverlust, Server weg, Kiss-o'-Death =====
+    NativeNtpServer::reset();
+    NativeNtpServer::setLossEvery(2);
+    {
+        TimeService clock;
+        RunResult lossy = run(clock, 5UL * 60 * 1000, 60000);
+        bool lossOk = clock.getTimeoutCount() > 0 && clock.getSyncCount() > 0 &&
+                      lossy.maxErrorUs < 1000.0 && lossy.maxCallMs < 1.0;
+        printf("  Jede 2. Anfrage verloren: %lu Abgleiche, %lu Timeouts, längster Aufruf %.1f ms -> %s\n",
+               (unsigned long)clock.getSyncCount(), (unsigned long)clock.getTimeoutCount(),
+               lossy.maxCallMs, lossOk ? "OK" : "FEHLER");
+        ok = ok && lossOk;
+
+        NativeNtpServer::setLossEvery(0);
+        NativeNtpServer::setAvailable(false);
+        uint32_t syncs = clock.getSyncCount();
+        clock.requestSync();
+        RunResult offline = run(clock, 30000, 0);
+        bool offlineOk = clock.getSyncCount() == syncs && clock.isSynchronized() &&
+                         offline.maxCallMs < 1.0 && offline.maxErrorUs < 1000.0;
+        printf("  Server nicht erreichbar: Uhr läuft weiter (Fehler %.0f µs), längster Aufruf %.1f ms -> %s\n",
+               offline.maxErrorUs, offline.maxCallMs, offlineOk ? "OK" : "FEHLER");
+        ok = ok && offlineOk;
+
+        NativeNtpServer::setAvailable(true);
+        NativeNtpServer::setStratum(0);
+        uint32_t rejected = clock.getRejectedCount();
+        clock.requestSync();
+        run(clock, 5000, 0);
+        bool kodOk = clock.getSyncCount() == syncs && clock.getRejectedCount() > rejected;
+        printf("  Kiss-o'-Death (Stratum 0) verworfen -> %s\n", kodOk ? "OK" : "FEHLER");
+        ok = ok && kodOk;
+    }
+
+    NativeNtpServer::reset();
+    WiFi.disconnect();
+    printf("\n");
+    return ok;
+}
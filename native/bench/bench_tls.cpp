@@ -0,0 +1,136 @@
+// ===== Benchmark: TLS-Session-Wiederaufnahme =====
+// Verbindet den TlsClient gegen den simulierten Server der mbedTLS-Attrappe
+// (Kosten je Handshake-Schritt siehe native/mock/mbedtls/ssl.cpp) und
+// vergleicht Dauer und Heap-Spitze von vollständigem und fortgesetztem
+// Handshake. Prüft außerdem die Wiederaufnahme nach "Deep Sleep" (neue
+// Instanz, RTC-Cache bleibt), Hostwechsel, Server-Neustart, abgelaufene
+// Tickets und den Verzicht auf Wiederaufnahme.
+
+#include "bench.h"
+#include "config.h"
+#include "tls_client.h"
+
+namespace {
+
+const char* TEST_CA =
+    "-----BEGIN CERTIFICATE-----\n"
+    "MIIBbenchbenchbench\n"
+    "-----END CERTIFICATE-----\n";
+
+struct Attempt {
+    bool connected;
+    bool resumed;
+    uint32_t ms;
+    uint32_t heap;
+};
+
+Attempt connectOnce(TlsClient& client, const char* host) {
+    Attempt a;
+    a.connected = client.connect(host, 8883) == 1;
+    a.resumed = client.wasResumed();
+    const TlsHandshakeStats& stats = a.resumed ? client.getResumedStats() : client.getFullStats();
+    a.ms = stats.lastMs;
+    a.heap = stats.lastPeakHeapBytes;
+    client.stop();
+    return a;
+}
+
+bool check(const char* name, const Attempt& a, bool expectResumed) {
+    bool ok = a.connected && a.resumed == expectResumed;
+    printf("  %-34s %-12s %4lu ms, Heap-Spitze %6lu Bytes -> %s\n", name,
+           a.resumed ? "fortgesetzt" : "vollständig", (unsigned long)a.ms, (unsigned long)a.heap,
+           ok ? "OK" : "FEHLER");
+    return ok;
+}
+
+}  // namespace
+
+bool runTlsBenchmark() {
+    printf("=== Benchmark: TLS-Session-Wiederaufnahme ===\n");
+    bool ok = true;
+    const char* host = "bench-hub.azure-devices.net";
+    uint32_t freeHeapBefore = ESP.getFreeHeap();
+
+    TlsClient::clearSessionCache();
+    NativeTlsServer::reset();
+
+    // ===== Vollständig vs. fortgesetzt =====
+    Attempt full;
+    Attempt resumed;
+    {
+        TlsClient client;
+        client.setCACert(TEST_CA);
+        full = connectOnce(client, host);
+        resumed = connectOnce(client, host);
+        ok = check("Erste Verbindung", full, false) && ok;
+        ok = check("Reconnect", resumed, true) && ok;
+        ok = ok && client.getSessionsStored() == 2 && client.getResumeRejectedCount() == 0;
+    }
+
+    // ===== Nach Deep Sleep: neue Instanz, Session aus dem RTC-Cache =====
+    {
+        TlsClient client;
+        client.setCACert(TEST_CA);
+        delay(60000);
+        ok = check("Neue Instanz (nach Deep Sleep)", connectOnce(client, host), true) && ok;
+
+        // Anderer Host: Session passt nicht, danach für den neuen Host gespeichert
+        ok = check("Anderer Host", connectOnce(client, "other-hub.example.net"), false) && ok;
+        ok = check("Anderer Host, Reconnect", connectOnce(client, "other-hub.example.net"), true) && ok;
+        ok = check("Erster Host (Cache überschrieben)", connectOnce(client, host), false) && ok;
+
+        // Server-Neustart: Ticket abgelehnt, vollständiger Handshake, neues Ticket
+        NativeTlsServer::reset();
+        uint32_t rejected = client.getResumeRejectedCount();
+        ok = check("Nach Server-Neustart", connectOnce(client, host), false) && ok;
+        ok = ok && client.getResumeRejectedCount() == rejected + 1;
+        ok = check("Danach", connectOnce(client, host), true) && ok;
+
+        // Abgelaufenes Ticket
+        NativeTlsServer::setTicketLifetimeSeconds(300);
+        delay(301000);
+        ok = check("Ticket abgelaufen (> 5 min)", connectOnce(client, host), false) && ok;
+        NativeTlsServer::setTicketLifetimeSeconds(7200);
+
+        // Server ohne Session-Cache: immer vollständig, keine Fehler
+        NativeTlsServer::setResumption(false);
+        ok = check("Server ohne Wiederaufnahme", connectOnce(client, host), false) && ok;
+        ok = check("Server ohne Wiederaufnahme, erneut", connectOnce(client, host), false) && ok;
+        NativeTlsServer::setResumption(true);
+
+        // Wiederaufnahme im Client abgeschaltet
+        connectOnce(client, host);
+        client.setSessionResumption(false);
+        ok = check("Client ohne Wiederaufnahme", connectOnce(client, host), false) && ok;
+    }
+
+    // ===== Fehlerfälle =====
+    {
+        TlsClient client;
+        bool noCa = client.connect(host, 8883) == 0 && client.getLastError() != 0;
+        client.setCACert("kein Zertifikat");
+        bool badCa = client.connect(host, 8883) == 0 && client.getLastError() != 0;
+        printf("  Ohne/ungültige Root-CA abgelehnt -> %s\n", noCa && badCa ? "OK" : "FEHLER");
+        ok = ok && noCa && badCa;
+    }
+
+    // Session-Größe gegen den RTC-Cache (Attrappe inkl. Server-Zertifikat;
+    // auf dem ESP32 zeigt TlsClient::printStats() die echte Größe)
+    bool sizeOk = NativeTlsServer::getSavedSessionSize() <= TLS_SESSION_CACHE_SIZE;
+    bool heapOk = ESP.getFreeHeap() == freeHeapBefore;   // Alle Puffer freigegeben
+    printf("  Session %zu von %d Bytes RTC-Cache, Heap nach stop() zurück -> %s\n",
+           NativeTlsServer::getSavedSessionSize(), TLS_SESSION_CACHE_SIZE,
+           sizeOk && heapOk ? "OK" : "FEHLER");
+    ok = ok && sizeOk && heapOk;
+
+    // ===== Ersparnis =====
+    bool savingOk = resumed.ms * 3 < full.ms && resumed.heap < full.heap;
+    double savedMj = POWER_SUPPLY_VOLTAGE * POWER_RADIO_CURRENT_MA * (full.ms - resumed.ms) / 1000.0;
+    printf("  Ersparnis je Reconnect: %lu ms (%.0f %%), %lu Bytes Heap, ~%.1f mJ -> %s\n",
+           (unsigned long)(full.ms - resumed.ms), 100.0 * (full.ms - resumed.ms) / full.ms,
+           (unsigned long)(full.heap - resumed.heap), savedMj, savingOk ? "OK" : "FEHLER");
+    ok = ok && savingOk;
+
+    printf("\n");
+    return ok;
+}
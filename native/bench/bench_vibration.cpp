@@ -0,0 +1,133 @@
+// ===== Benchmark: Schwingungsanalyse =====
+// Prüft die FFT gegen eine direkte DFT und die Kennwerte gegen ein
+// synthetisches Signal mit bekannter Lösung (Sinus auf Z, kleiner Sinus
+// auf X), misst die Rechenzeit pro Fenster und vergleicht die Datenmenge
+// von Rohdaten und Kennwertberichten.
+
+#include "bench.h"
+#include "fft.h"
+#include "telemetry_codec.h"
+#include "vibration.h"
+
+namespace {
+
+// Größter Fehler der FFT gegenüber der direkten DFT, relativ zum Maximum
+double checkFft() {
+    const size_t n = 256;
+    static RadixTwoFft<n> fft;
+    float re[n], im[n];
+    double refRe[n], refIm[n];
+
+    for (size_t i = 0; i < n; i++) {
+        re[i] = (float)sin(0.3 * i) + 0.25f * (float)((i * 7919) % 13) / 13.0f;
+        im[i] = 0.0f;
+    }
+    double maxMagnitude = 0.0;
+    for (size_t k = 0; k < n; k++) {
+        refRe[k] = refIm[k] = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double angle = -2.0 * M_PI * k * i / n;
+            refRe[k] += re[i] * cos(angle);
+            refIm[k] += re[i] * sin(angle);
+        }
+        maxMagnitude = std::max(maxMagnitude, hypot(refRe[k], refIm[k]));
+    }
+
+    fft.transform(re, im);
+    double worst = 0.0;
+    for (size_t k = 0; k < n; k++) {
+        worst = std::max(worst, hypot(re[k] - refRe[k], im[k] - refIm[k]));
+    }
+    return worst / maxMagnitude;
+}
+
+struct ReportCapture {
+    VibrationFeatures last;
+    uint32_t reports = 0;
+};
+
+void captureReport(const VibrationFeatures& features, void* context) {
+    ReportCapture* capture = (ReportCapture*)context;
+    capture->last = features;
+    capture->reports++;
+}
+
+bool near(double value, double expected, double tolerance) {
+    return fabs(value - expected) <= tolerance;
+}
+
+}  // namespace
+
+bool runVibrationBenchmark() {
+    printf("=== Benchmark: Schwingungsanalyse ===\n");
+
+    double fftError = checkFft();
+    bool fftOk = fftError < 1e-5;
+    printf("  FFT gegen DFT (N=256):  rel. Fehler %.1e -> %s\n", fftError, fftOk ? "OK" : "FEHLER");
+
+    // 1 kHz Accel+Gyro: Z = 1 g + 0,2 g @ 120 Hz, X = 0,02 g @ 35 Hz
+    const uint16_t rateHz = 1000;
+    const float lsb = MPU9250Stream::ACCEL_LSB_PER_G;
+    static VibrationAnalyzer analyzer;
+    ReportCapture capture;
+    analyzer.begin(4);
+    analyzer.onReport(captureReport, &capture);
+
+    static MotionBlock block;
+    block.rateHz = rateHz;
+    block.channels = 6;
+    block.count = 32;
+
+    Stats windowMicros;
+    uint32_t sample = 0;
+    uint32_t windowsBefore = analyzer.getWindowCount();
+    while (capture.reports < 3) {
+        for (size_t i = 0; i < block.count; i++, sample++) {
+            double t = (double)sample / rateHz;
+            block.samples[i][0] = (int16_t)lround(0.02 * sin(2 * M_PI * 35 * t) * lsb);
+            block.samples[i][1] = 0;
+            block.samples[i][2] = (int16_t)lround((1.0 + 0.2 * sin(2 * M_PI * 120 * t)) * lsb);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        analyzer.addBlock(block);
+        double us = elapsedMicros(start);
+        if (analyzer.getWindowCount() != windowsBefore) {
+            windowsBefore = analyzer.getWindowCount();
+            windowMicros.add(us);
+        }
+    }
+
+    const AxisFeatures& z = capture.last.axes[2];
+    const AxisFeatures& x = capture.last.axes[0];
+    double bandTotal = 0.0;
+    for (size_t b = 0; b < VibrationAnalyzer::BAND_COUNT; b++) {
+        bandTotal += z.bandEnergy[b];
+    }
+    // 120 Hz liegt bei 8 Bändern à 62,5 Hz in Band 1, 35 Hz in Band 0
+    bool featuresOk = near(z.rms, 0.2 / sqrt(2.0), 0.002) && near(z.peakToPeak, 0.4, 0.002) &&
+                      near(z.crest, sqrt(2.0), 0.02) && z.bandEnergy[1] > 0.98 * bandTotal &&
+                      near(bandTotal, z.rms * z.rms, 0.03 * z.rms * z.rms) &&
+                      near(x.rms, 0.02 / sqrt(2.0), 0.001) && x.bandEnergy[0] > 0.95 * x.rms * x.rms &&
+                      capture.last.windows == 4;
+
+    printf("  Z: RMS %.4f g (soll %.4f), p2p %.4f g, Scheitel %.3f, Band 1: %.1f %% der Energie\n",
+           z.rms, 0.2 / sqrt(2.0), z.peakToPeak, z.crest, 100.0 * z.bandEnergy[1] / bandTotal);
+    printf("  X: RMS %.4f g (soll %.4f), Band 0: %.1f %%; Summe Bänder/RMS² Z = %.3f -> %s\n",
+           x.rms, 0.02 / sqrt(2.0), 100.0 * x.bandEnergy[0] / (x.rms * x.rms),
+           bandTotal / (z.rms * z.rms), featuresOk ? "OK" : "FEHLER");
+    windowMicros.print("CPU pro Fenster [µs]");
+
+    // Datenmenge: Rohdaten (12 Bytes pro Wert) gegen einen Bericht je 20 Fenster
+    char json[TelemetryCodec::VIBRATION_JSON_SIZE];
+    size_t reportBytes = TelemetryCodec::encodeVibrationJson(capture.last, 1767225600UL, json, sizeof(json));
+    double reportSeconds = (double)VIBRATION_WINDOWS_PER_REPORT * VibrationAnalyzer::WINDOW_SIZE / rateHz;
+    double rawPerHour = 12.0 * rateHz * 3600.0;
+    double reportsPerHour = reportBytes * 3600.0 / reportSeconds;
+    bool jsonOk = reportBytes > 0;
+    printf("  Bericht: %u Bytes alle %.1f s -> %.1f KB/h statt %.1f MB/h Rohdaten -> %s\n\n",
+           (unsigned)reportBytes, reportSeconds, reportsPerHour / 1024.0,
+           rawPerHour / (1024.0 * 1024.0), jsonOk ? "OK" : "FEHLER");
+
+    return fftOk && featuresOk && jsonOk;
+}
@@ -0,0 +1,153 @@
+// ===== Benchmark: WLAN-Schnellverbindung =====
+// Misst über die WiFi-Attrappe (Zeitbedarf für Kanalsuche, Assoziation und
+// DHCP siehe native/mock/WiFi.h) die Dauer bis zur IP-Adresse beim
+// Kaltstart (Scan aller Kanäle) und nach "Deep Sleep" (neue Instanz,
+// RTC-Cache bleibt), die
+// periodische DHCP-Erneuerung, den Rückfall bei umgezogenem AP und den
+// Reconnect im laufenden Betrieb. Rechnet die Ersparnis in Funkenergie je
+// Aufwachen um.
+
+#include <WiFi.h>
+#include "bench.h"
+#include "config.h"
+#include "wifi_setup.h"
+
+namespace {
+
+struct Wake {
+    bool connected;
+    bool fast;         // Mit Kanal/BSSID aus dem Cache
+    uint32_t ms;       // Bis zur IP-Adresse (ohne den SNTP-Abgleich danach)
+};
+
+uint32_t connectMs(const WifiManager& wifi) {
+    return wifi.getFastConnectStats().getMax() + wifi.getFullConnectStats().getMax();
+}
+
+// Ein Aufwachen: neue Instanz wie nach Deep Sleep, blockierender Aufbau
+Wake wakeAndConnect() {
+    Wake w;
+    WifiManager wifi;
+    w.connected = wifi.begin();
+    w.ms = connectMs(wifi);
+    w.fast = wifi.getFastConnectStats().getTotal() == 1;
+    wifi.disconnect();
+    return w;
+}
+
+bool check(const char* name, const Wake& w, bool expectFast, uint32_t maxMs) {
+    bool ok = w.connected && w.fast == expectFast && w.ms <= maxMs;
+    printf("  %-34s %-8s %5lu ms -> %s\n", name, w.fast ? "schnell" : "normal",
+           (unsigned long)w.ms, ok ? "OK" : "FEHLER");
+    return ok;
+}
+
+}  // namespace
+
+bool runWifiBenchmark() {
+    printf("=== Benchmark: WLAN-Schnellverbindung ===\n");
+    bool ok = true;
+
+    // Erwartete Dauer laut Attrappe (+ Abfragetakt von connect()); AP 0 aus bench_main.cpp
+    const uint32_t scanMs = WIFI_SCAN_MS_PER_CHANNEL * WiFiClass::CHANNEL_COUNT;
+    const uint32_t fastMs = WiFiClass::SCAN_PER_CHANNEL_MS + WiFiClass::ASSOCIATION_MS;
+    const uint32_t fullMs = scanMs + fastMs + WiFiClass::DHCP_MS;
+    const uint32_t slackMs = 20;
+
+    // ===== Kaltstart vs. Aufwachen aus Deep Sleep =====
+    WifiManager::clearConnectionCache();
+    Wake cold = wakeAndConnect();
+    Wake warm = wakeAndConnect();
+    ok = check("Kaltstart (Scan + DHCP)", cold, false, fullMs + slackMs) && ok;
+    ok = check("Nach Deep Sleep (Cache)", warm, true, fastMs + slackMs) && ok;
+
+    // ===== IP-Adresse nach WIFI_IP_CACHE_MAX_REUSE Verbindungen neu per DHCP =====
+    uint32_t dhcpRefreshes = 0;
+    bool allFast = true;
+    for (int i = 0; i < WIFI_IP_CACHE_MAX_REUSE + 1; i++) {
+        Wake w = wakeAndConnect();
+        allFast = allFast && w.connected && w.fast;
+        if (w.ms > fastMs + slackMs) dhcpRefreshes++;
+    }
+    bool refreshOk = allFast && dhcpRefreshes == 1;
+    printf("  %d Aufwachvorgänge: alle mit Cache, %lu davon mit DHCP -> %s\n",
+           WIFI_IP_CACHE_MAX_REUSE + 1, (unsigned long)dhcpRefreshes, refreshOk ? "OK" : "FEHLER");
+    ok = ok && refreshOk;
+
+    // ===== AP auf anderem Kanal: Schnellverbindung scheitert, Rückfall =====
+    WiFi.setApChannel(0, 11);
+    {
+        WifiManager wifi;
+        bool connected = wifi.begin();
+        uint32_t ms = connectMs(wifi);
+        uint32_t expectedMs = WiFiClass::SCAN_PER_CHANNEL_MS +   // Vergeblich auf Kanal 6
+                              fullMs;
+        bool fallbackOk = connected && wifi.getFastFallbackCount() == 1 &&
+                          wifi.getFullConnectStats().getTotal() == 1 && ms <= expectedMs + slackMs;
+        printf("  AP auf Kanal 11 umgezogen: Rückfall, verbunden nach %lu ms -> %s\n",
+               (unsigned long)ms, fallbackOk ? "OK" : "FEHLER");
+        ok = ok && fallbackOk;
+        wifi.disconnect();
+    }
+    ok = check("Danach (neuer Kanal im Cache)", wakeAndConnect(), true, fastMs + slackMs) && ok;
+    WiFi.setApChannel(0, 6);
+    WifiManager::clearConnectionCache();
+
+    // ===== Langsamer DHCP-Server: Versuch ohne Cache hat WIFI_TIMEOUT_MS =====
+    {
+        const uint32_t slowDhcpMs = WIFI_FAST_CONNECT_TIMEOUT_MS + 2000;
+        WiFi.setDhcpMs(slowDhcpMs);
+        uint32_t beginsBefore = WiFi.getBeginCount();
+        Wake w = wakeAndConnect();
+        uint32_t begins = WiFi.getBeginCount() - beginsBefore;
+        WiFi.setDhcpMs(WiFiClass::DHCP_MS);
+        bool slowOk = w.connected && !w.fast && begins == 1 &&
+                      w.ms <= fullMs - WiFiClass::DHCP_MS + slowDhcpMs + slackMs;
+        printf("  DHCP %lu ms (über der Frist der Schnellverbindung): %lu ms, %lu Versuch -> %s\n",
+               (unsigned long)slowDhcpMs, (unsigned long)w.ms, (unsigned long)begins, slowOk ? "OK" : "FEHLER");
+        ok = ok && slowOk;
+        WifiManager::clearConnectionCache();
+    }
+
+    // ===== Reconnect im laufenden Betrieb =====
+    {
+        WifiManager wifi;
+        wifi.begin();
+        WiFi.setLinkAvailable(false);
+        wifi.handleReconnect();
+        delay(2000);
+        WiFi.setLinkAvailable(true);
+
+        uint32_t fastBefore = WiFi.getFastBeginCount();
+        unsigned long start = millis();
+        uint64_t longestCallUs = 0;
+        while (wifi.getLinkState() != WIFI_LINK_UP && millis() - start < 60000) {
+            uint64_t callStart = NativeClock::nowMicros();
+            wifi.handleReconnect();
+            uint64_t callUs = NativeClock::nowMicros() - callStart;
+            if (callUs > longestCallUs) longestCallUs = callUs;
+            delay(10);
+        }
+        bool reconnectOk = wifi.getLinkState() == WIFI_LINK_UP && WiFi.getFastBeginCount() > fastBefore &&
+                           wifi.getFastConnectStats().getTotal() == 1 && longestCallUs < 1000;
+        printf("  Reconnect nach Ausfall: %lu ms mit Cache, längster Aufruf %.1f ms -> %s\n",
+               (unsigned long)wifi.getFastConnectStats().getMax(), longestCallUs / 1000.0,
+               reconnectOk ? "OK" : "FEHLER");
+        ok = ok && reconnectOk;
+        wifi.printConnectStats();   // Nur mit --verbose sichtbar
+        wifi.disconnect();
+    }
+
+    // ===== Funkenergie je Aufwachen =====
+    double fullMj = POWER_SUPPLY_VOLTAGE * POWER_RADIO_CURRENT_MA * cold.ms / 1000.0;
+    double fastMj = POWER_SUPPLY_VOLTAGE * POWER_RADIO_CURRENT_MA * warm.ms / 1000.0;
+    bool savingOk = warm.ms * 4 < cold.ms;
+    printf("  WLAN-Aufbau je Aufwachen: %.0f mJ -> %.0f mJ (-%.0f %%) -> %s\n",
+           fullMj, fastMj, 100.0 * (fullMj - fastMj) / fullMj, savingOk ? "OK" : "FEHLER");
+    ok = ok && savingOk;
+
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    printf("\n");
+    return ok;
+}
@@ -0,0 +1,91 @@
+#include "Adafruit_BME280.h"
+#include "sim_signal.h"
+
+Adafruit_BME280::Adafruit_BME280() : wire(&Wire), address(0x77), mode(MODE_SLEEP), measurementMicros(8000) {
+}
+
+bool Adafruit_BME280::begin(uint8_t addr, TwoWire* theWire) {
+    wire = theWire;
+    address = addr;
+
+    // Chip-ID (0xD0) wie im Original prüfen
+    wire->beginTransmission(address);
+    wire->write(0xD0);
+    if (wire->endTransmission() != 0) {
+        return false;
+    }
+    wire->requestFrom(address, (uint8_t)1);
+    wire->read();
+
+    setSampling();
+    return true;
+}
+
+void Adafruit_BME280::setSampling(sensor_mode m, sensor_sampling tempSampling,
+                                  sensor_sampling pressSampling, sensor_sampling humSampling,
+                                  sensor_filter filter, standby_duration duration) {
+    mode = m;
+
+    // Datenblatt 9.1: t = 1 + 2·T + (2·P + 0,5) + (2·H + 0,5) ms (typisch)
+    auto factor = [](sensor_sampling s) { return s == SAMPLING_NONE ? 0u : 1u << (s - 1); };
+    measurementMicros = 1000 + 2000 * factor(tempSampling);
+    if (pressSampling != SAMPLING_NONE) measurementMicros += 2000 * factor(pressSampling) + 500;
+    if (humSampling != SAMPLING_NONE) measurementMicros += 2000 * factor(humSampling) + 500;
+
+    // ctrl_hum, config, ctrl_meas
+    wire->beginTransmission(address);
+    wire->write(0xF2);
+    wire->write((uint8_t)humSampling);
+    wire->endTransmission();
+
+    wire->beginTransmission(address);
+    wire->write(0xF5);
+    wire->write((uint8_t)((duration << 5) | (filter << 2)));
+    wire->endTransmission();
+
+    wire->beginTransmission(address);
+    wire->write(0xF4);
+    wire->write((uint8_t)((tempSampling << 5) | (pressSampling << 2) | mode));
+    wire->endTransmission();
+}
+
+bool Adafruit_BME280::takeForcedMeasurement() {
+    if (mode != MODE_FORCED) {
+        return true;
+    }
+    wire->beginTransmission(address);
+    wire->write(0xF4);
+    wire->write((uint8_t)mode);
+    wire->endTransmission();
+
+    // Messdauer abhängig vom Oversampling in simulierter Zeit
+    NativeClock::advanceMicros(measurementMicros);
+    return true;
+}
+
+void Adafruit_BME280::burstRead(uint8_t reg, uint8_t length) {
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->endTransmission();
+    wire->requestFrom(address, length);
+    while (wire->available()) {
+        wire->read();
+    }
+}
+
+float Adafruit_BME280::readTemperature() {
+    burstRead(0xFA, 3);
+    return SimSignal::bme280Temperature() + SimSignal::noise(0.05f);
+}
+
+float Adafruit_BME280::readPressure() {
+    readTemperature();  // t_fine (wie im Original)
+    burstRead(0xF7, 3);
+    return SimSignal::bme280Pressure() + SimSignal::noise(3.0f);
+}
+
+float Adafruit_BME280::readHumidity() {
+    readTemperature();  // t_fine (wie im Original)
+    burstRead(0xFD, 2);
+    return SimSignal::bme280Humidity() + SimSignal::noise(0.2f);
+}
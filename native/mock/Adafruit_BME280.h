@@ -0,0 +1,71 @@
+#ifndef NATIVE_ADAFRUIT_BME280_H
+#define NATIVE_ADAFRUIT_BME280_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// ===== BME280-Attrappe =====
+// Gleiche Schnittstelle wie die Adafruit-Bibliothek. Jede read*()-Methode
+// erzeugt dieselben I2C-Transaktionen wie das Original (Temperatur wird
+// für Feuchte und Druck intern erneut gelesen), liefert aber simulierte Werte.
+class Adafruit_BME280 {
+public:
+    enum sensor_sampling {
+        SAMPLING_NONE = 0b000,
+        SAMPLING_X1 = 0b001,
+        SAMPLING_X2 = 0b010,
+        SAMPLING_X4 = 0b011,
+        SAMPLING_X8 = 0b100,
+        SAMPLING_X16 = 0b101
+    };
+
+    enum sensor_mode {
+        MODE_SLEEP = 0b00,
+        MODE_FORCED = 0b01,
+        MODE_NORMAL = 0b11
+    };
+
+    enum sensor_filter {
+        FILTER_OFF = 0b000,
+        FILTER_X2 = 0b001,
+        FILTER_X4 = 0b010,
+        FILTER_X8 = 0b011,
+        FILTER_X16 = 0b100
+    };
+
+    enum standby_duration {
+        STANDBY_MS_0_5 = 0b000,
+        STANDBY_MS_10 = 0b110,
+        STANDBY_MS_20 = 0b111,
+        STANDBY_MS_62_5 = 0b001,
+        STANDBY_MS_125 = 0b010,
+        STANDBY_MS_250 = 0b011,
+        STANDBY_MS_500 = 0b100,
+        STANDBY_MS_1000 = 0b101
+    };
+
+    Adafruit_BME280();
+
+    bool begin(uint8_t addr = 0x77, TwoWire* theWire = &Wire);
+    void setSampling(sensor_mode mode = MODE_NORMAL,
+                     sensor_sampling tempSampling = SAMPLING_X16,
+                     sensor_sampling pressSampling = SAMPLING_X16,
+                     sensor_sampling humSampling = SAMPLING_X16,
+                     sensor_filter filter = FILTER_OFF,
+                     standby_duration duration = STANDBY_MS_0_5);
+    bool takeForcedMeasurement();
+
+    float readTemperature();
+    float readPressure();
+    float readHumidity();
+
+private:
+    TwoWire* wire;
+    uint8_t address;
+    sensor_mode mode;
+    uint32_t measurementMicros;   // Typische Messdauer laut Datenblatt (Forced Mode)
+
+    void burstRead(uint8_t reg, uint8_t length);
+};
+
+#endif
@@ -0,0 +1,203 @@
+#include "Arduino.h"
+#include "IPAddress.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ===== Simulierte Uhr =====
+static uint64_t simMicros = 0;
+
+struct ScheduledEvent {
+    uint64_t atMicros;
+    NativeClock::Callback callback;
+    void* context;
+};
+static const size_t MAX_EVENTS = 8;
+static ScheduledEvent events[MAX_EVENTS];
+
+// Uhr bis target vorstellen; fällige Ereignisse in zeitlicher Reihenfolge
+static void advanceTo(uint64_t target) {
+    for (;;) {
+        ScheduledEvent* next = nullptr;
+        for (size_t i = 0; i < MAX_EVENTS; i++) {
+            if (events[i].callback && events[i].atMicros <= target &&
+                (!next || events[i].atMicros < next->atMicros)) {
+                next = &events[i];
+            }
+        }
+        if (!next) {
+            break;
+        }
+        if (next->atMicros > simMicros) {
+            simMicros = next->atMicros;
+        }
+        ScheduledEvent event = *next;
+        next->callback = nullptr;
+        event.callback(event.context);
+    }
+    simMicros = target;
+}
+
+void NativeClock::setMicros(uint64_t us) {
+    simMicros = us;
+}
+
+void NativeClock::advanceMicros(uint64_t us) {
+    advanceTo(simMicros + us);
+}
+
+uint64_t NativeClock::nowMicros() {
+    return simMicros;
+}
+
+bool NativeClock::schedule(uint64_t atMicros, Callback callback, void* context) {
+    for (size_t i = 0; i < MAX_EVENTS; i++) {
+        if (!events[i].callback) {
+            events[i].atMicros = atMicros;
+            events[i].callback = callback;
+            events[i].context = context;
+            return true;
+        }
+    }
+    return false;
+}
+
+void NativeClock::cancel(void* context) {
+    for (size_t i = 0; i < MAX_EVENTS; i++) {
+        if (events[i].context == context) {
+            events[i].callback = nullptr;
+        }
+    }
+}
+
+unsigned long millis() {
+    return (unsigned long)(simMicros / 1000ULL);
+}
+
+unsigned long micros() {
+    return (unsigned long)simMicros;
+}
+
+void delay(unsigned long ms) {
+    advanceTo(simMicros + (uint64_t)ms * 1000ULL);
+}
+
+void delayMicroseconds(unsigned int us) {
+    advanceTo(simMicros + us);
+}
+
+// ===== GPIO =====
+// Pins werden nur gespeichert, damit digitalRead() konsistent antwortet
+static uint8_t pinLevels[64];
+static NativePinModel* pinModel = nullptr;
+
+void nativeAttachPinModel(NativePinModel* model) {
+    pinModel = model;
+}
+
+// Eingang mit Pull-up liest ohne treibendes Gerät high
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (mode == INPUT_PULLUP && pin < sizeof(pinLevels)) {
+        pinLevels[pin] = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < sizeof(pinLevels)) {
+        pinLevels[pin] = val;
+    }
+    if (pinModel) {
+        pinModel->onPinWrite(pin, val);
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    int level;
+    if (pinModel && pinModel->readPin(pin, level)) {
+        return level;
+    }
+    return pin < sizeof(pinLevels) ? pinLevels[pin] : LOW;
+}
+
+// ===== Zufallszahlen =====
+// Eigener LCG, damit Läufe auf jedem Host reproduzierbar sind
+static uint32_t randomState = 0x12345678;
+
+void randomSeed(unsigned long seed) {
+    randomState = (uint32_t)seed ? (uint32_t)seed : 1;
+}
+
+long random(long max) {
+    if (max <= 0) {
+        return 0;
+    }
+    randomState = randomState * 1664525UL + 1013904223UL;
+    return (long)((randomState >> 8) % (uint32_t)max);
+}
+
+long random(long min, long max) {
+    if (max <= min) {
+        return min;
+    }
+    return min + random(max - min);
+}
+
+// ===== HardwareSerial =====
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    bytesWritten += size;
+    if (capture) {
+        capture->append((const char*)buffer, size);
+    }
+    if (!muted) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+size_t HardwareSerial::print(long value, int base) {
+    if (value < 0 && base == DEC) {
+        size_t n = print('-');
+        return n + print((unsigned long)(-value), base);
+    }
+    return print((unsigned long)value, base);
+}
+
+size_t HardwareSerial::print(unsigned long value, int base) {
+    char tmp[24];
+    snprintf(tmp, sizeof(tmp), base == HEX ? "%lX" : "%lu", value);
+    return print(tmp);
+}
+
+size_t HardwareSerial::print(double value, int digits) {
+    char tmp[48];
+    snprintf(tmp, sizeof(tmp), "%.*f", digits, value);
+    return print(tmp);
+}
+
+size_t HardwareSerial::print(const IPAddress& ip) {
+    return print(ip.toString());
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+    char stackBuffer[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+
+    if (len < 0) {
+        return 0;
+    }
+    if ((size_t)len < sizeof(stackBuffer)) {
+        return write((const uint8_t*)stackBuffer, len);
+    }
+
+    // Lange Ausgaben wie im Original über einen temporären Heap-Puffer
+    char* heapBuffer = new char[len + 1];
+    va_start(args, format);
+    vsnprintf(heapBuffer, len + 1, format, args);
+    va_end(args);
+    size_t written = write((const uint8_t*)heapBuffer, len);
+    delete[] heapBuffer;
+    return written;
+}
@@ -0,0 +1,154 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// ===== Arduino-Ersatz für den Host-Build (env:native) =====
+// Stellt nur die Teile der Arduino-API bereit, die von src/ benutzt werden.
+// Die Zeit läuft über eine simulierte Uhr: delay() wartet nicht,
+// sondern schiebt millis() weiter. So kann der Benchmark loop() im
+// Zeitraffer treiben.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+
+#include "WString.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x12
+
+#define DEC 10
+#define HEX 16
+
+// ===== Simulierte Uhr =====
+// schedule() simuliert Ereignisse aus anderen Tasks (z.B. eintreffende
+// UDP-Pakete): Der Rückruf läuft, sobald delay() bzw. advanceMicros() die
+// Uhr über atMicros schieben, und sieht dabei genau diese Uhrzeit.
+namespace NativeClock {
+    typedef void (*Callback)(void* context);
+
+    void setMicros(uint64_t us);
+    void advanceMicros(uint64_t us);
+    uint64_t nowMicros();
+    bool schedule(uint64_t atMicros, Callback callback, void* context);
+    void cancel(void* context);   // Alle Ereignisse mit diesem context
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// ===== Leitungsmodell für Pins =====
+// Optional (z.B. I2C-Bus mit festgehaltener SDA-Leitung); ohne Modell
+// liefert digitalRead() den zuletzt geschriebenen Pegel
+class NativePinModel {
+public:
+    virtual ~NativePinModel() {}
+    virtual void onPinWrite(uint8_t pin, uint8_t val) { (void)pin; (void)val; }
+    // true = level wurde vom Modell geliefert
+    virtual bool readPin(uint8_t pin, int& level) { (void)pin; (void)level; return false; }
+};
+
+void nativeAttachPinModel(NativePinModel* model);   // nullptr = entfernen
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class IPAddress;
+
+// ===== Serielle Schnittstelle =====
+// Zählt alle geschriebenen Bytes, damit der Benchmark die UART-Last
+// pro Zyklus ausweisen kann. Mit setMuted(true) geht nichts auf stdout.
+class HardwareSerial {
+private:
+    bool muted;
+    uint64_t bytesWritten;
+    std::string* capture;
+
+public:
+    HardwareSerial() : muted(false), bytesWritten(0), capture(nullptr) {}
+
+    void begin(unsigned long baud) { (void)baud; }
+    operator bool() const { return true; }
+
+    size_t write(const uint8_t* buffer, size_t size);
+    size_t write(uint8_t c) { return write(&c, 1); }
+
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t print(const IPAddress& ip);
+
+    size_t println() { return print("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    // Nur im Host-Build vorhanden
+    void setMuted(bool value) { muted = value; }
+    // Alle geschriebenen Bytes zusätzlich anhängen (nullptr = aus)
+    void setCapture(std::string* target) { capture = target; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+};
+
+extern HardwareSerial Serial;
+
+// ===== ESP-Systemfunktionen =====
+class EspClass {
+private:
+    int32_t simulatedHeapUse;
+    int32_t peakHeapUse;
+
+public:
+    EspClass() : simulatedHeapUse(0), peakHeapUse(0) {}
+
+    uint32_t getFreeHeap() { return 280000 - simulatedHeapUse; }
+    uint32_t getMinFreeHeap() { return 280000 - peakHeapUse; }
+    uint32_t getMaxAllocHeap() { return getFreeHeap() < 110000 ? getFreeHeap() : 110000; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    unsigned long long getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }  // uint64_t auf dem ESP32
+    void restart() { exit(0); }
+
+    // Nur im Host-Build vorhanden: große Allokationen der Attrappen
+    // (z.B. TLS-Puffer) im freien Heap sichtbar machen
+    void simulateHeapUse(int32_t deltaBytes) {
+        simulatedHeapUse += deltaBytes;
+        if (simulatedHeapUse > peakHeapUse) peakHeapUse = simulatedHeapUse;
+    }
+};
+
+extern EspClass ESP;
+
+// Arduino-Sketch Einstiegspunkte (in src/main.cpp definiert)
+void setup();
+void loop();
+
+#endif
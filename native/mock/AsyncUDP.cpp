@@ -0,0 +1,165 @@
+#include "AsyncUDP.h"
+#include "WiFi.h"
+
+// ===== Simulierter NTP-Server =====
+namespace {
+
+const uint64_t NTP_UNIX_OFFSET = 2208988800ULL;   // 1900 -> 1970
+const uint32_t SERVER_PROCESSING_US = 50;
+
+bool serverAvailable = true;
+uint64_t anchorSim = 0;                // Simulierte Zeit des Bezugspunkts
+int64_t anchorTrue = (int64_t)NATIVE_EPOCH_BASE * 1000000LL;
+double driftPpm = 0.0;
+uint32_t uplinkUs = 20000;
+uint32_t downlinkUs = 20000;
+uint32_t jitterUs = 0;
+uint32_t lossEvery = 0;
+uint8_t serverStratum = 2;
+uint32_t requestCount = 0;
+uint32_t jitterState = 0x2468ACE1;     // Eigener Generator, stört random() nicht
+
+uint32_t nextJitter() {
+    if (jitterUs == 0) {
+        return 0;
+    }
+    jitterState = jitterState * 1664525UL + 1013904223UL;
+    return (jitterState >> 8) % (jitterUs + 1);
+}
+
+int64_t trueAt(uint64_t simMicros) {
+    int64_t elapsed = (int64_t)(simMicros - anchorSim);
+    return anchorTrue + elapsed - (int64_t)(elapsed * driftPpm / 1e6);
+}
+
+void putTimestamp(uint8_t* p, int64_t epochMicros) {
+    uint64_t seconds = (uint64_t)(epochMicros / 1000000LL) + NTP_UNIX_OFFSET;
+    uint64_t fraction = ((uint64_t)(epochMicros % 1000000LL) << 32) / 1000000ULL;
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(seconds >> (24 - 8 * i));
+        p[4 + i] = (uint8_t)(fraction >> (24 - 8 * i));
+    }
+}
+
+}  // namespace
+
+void NativeNtpServer::reset() {
+    serverAvailable = true;
+    anchorSim = NativeClock::nowMicros();
+    anchorTrue = (int64_t)NATIVE_EPOCH_BASE * 1000000LL + (int64_t)anchorSim;
+    driftPpm = 0.0;
+    uplinkUs = downlinkUs = 20000;
+    jitterUs = 0;
+    lossEvery = 0;
+    serverStratum = 2;
+    requestCount = 0;
+}
+
+void NativeNtpServer::setAvailable(bool available) {
+    serverAvailable = available;
+}
+
+void NativeNtpServer::setClockOffsetMicros(int64_t offsetUs) {
+    anchorSim = NativeClock::nowMicros();
+    anchorTrue = (int64_t)NATIVE_EPOCH_BASE * 1000000LL + (int64_t)anchorSim + offsetUs;
+}
+
+void NativeNtpServer::setDriftPpm(double ppm) {
+    uint64_t now = NativeClock::nowMicros();
+    anchorTrue = trueAt(now);
+    anchorSim = now;
+    driftPpm = ppm;
+}
+
+void NativeNtpServer::setPathDelayMs(uint32_t uplinkMs, uint32_t downlinkMs) {
+    uplinkUs = uplinkMs * 1000;
+    downlinkUs = downlinkMs * 1000;
+}
+
+void NativeNtpServer::setJitterMicros(uint32_t us) {
+    jitterUs = us;
+}
+
+void NativeNtpServer::setLossEvery(uint32_t n) {
+    lossEvery = n;
+}
+
+void NativeNtpServer::setStratum(uint8_t stratum) {
+    serverStratum = stratum;
+}
+
+int64_t NativeNtpServer::trueEpochMicros() {
+    return trueAt(NativeClock::nowMicros());
+}
+
+uint32_t NativeNtpServer::getRequestCount() {
+    return requestCount;
+}
+
+// ===== AsyncUDP =====
+
+AsyncUDP::AsyncUDP() : listening(false), handlerArg(nullptr), responsePending(false) {
+}
+
+void AsyncUDP::onPacket(AuPacketHandlerFunctionWithArg cb, void* arg) {
+    handler = cb;
+    handlerArg = arg;
+}
+
+void AsyncUDP::onPacket(AuPacketHandlerFunction cb) {
+    handler = [cb](void*, AsyncUDPPacket& packet) { cb(packet); };
+    handlerArg = nullptr;
+}
+
+bool AsyncUDP::listen(uint16_t port) {
+    (void)port;
+    listening = true;
+    return true;
+}
+
+void AsyncUDP::close() {
+    listening = false;
+}
+
+// Anfrage "senden": der Server beantwortet gültige NTP-Anfragen (Mode 3);
+// die Antwort trifft nach Hin- und Rückweg im Empfangs-Rückruf ein
+size_t AsyncUDP::writeTo(const uint8_t* data, size_t len, const IPAddress addr, uint16_t port) {
+    (void)addr;
+    if (!listening || WiFi.getConnectedAp() < 0) {
+        return 0;
+    }
+    if (port != 123 || len != PACKET_SIZE || (data[0] & 0x07) != 3 || responsePending) {
+        return len;   // Verschickt, aber niemand antwortet
+    }
+    requestCount++;
+    if (!serverAvailable || (lossEvery > 0 && requestCount % lossEvery == 0)) {
+        return len;
+    }
+
+    uint64_t arrive = NativeClock::nowMicros() + uplinkUs + nextJitter();
+    uint64_t depart = arrive + SERVER_PROCESSING_US;
+
+    memset(response, 0, sizeof(response));
+    response[0] = (0 << 6) | (4 << 3) | 4;   // LI 0, Version 4, Server
+    response[1] = serverStratum;
+    response[2] = data[2];                   // Poll
+    response[3] = 0xEC;                      // Präzision ~2^-20 s
+    memcpy(response + 24, data + 40, 8);     // Originate = Transmit der Anfrage
+    putTimestamp(response + 16, trueAt(arrive));   // Reference
+    putTimestamp(response + 32, trueAt(arrive));   // Receive
+    putTimestamp(response + 40, trueAt(depart));   // Transmit
+
+    responsePending = NativeClock::schedule(depart + downlinkUs + nextJitter(), deliver, this);
+    return len;
+}
+
+void AsyncUDP::deliver(void* context) {
+    AsyncUDP* udp = (AsyncUDP*)context;
+    udp->responsePending = false;
+    // Unterwegs verloren, wenn die Verbindung inzwischen weg ist
+    if (!udp->listening || !udp->handler || WiFi.getConnectedAp() < 0) {
+        return;
+    }
+    AsyncUDPPacket packet(udp->response, PACKET_SIZE, IPAddress(192, 0, 2, 123), 123);
+    udp->handler(udp->handlerArg, packet);
+}
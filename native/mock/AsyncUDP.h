@@ -0,0 +1,79 @@
+#ifndef NATIVE_ASYNCUDP_H
+#define NATIVE_ASYNCUDP_H
+
+#include <Arduino.h>
+#include <functional>
+#include "IPAddress.h"
+
+// Startzeitpunkt der simulierten Uhr (Unix-Zeit)
+#define NATIVE_EPOCH_BASE 1767225600UL  // 2026-01-01 00:00:00 UTC
+
+class AsyncUDPPacket {
+private:
+    uint8_t* payload;
+    size_t size;
+    IPAddress remote;
+    uint16_t port;
+
+public:
+    AsyncUDPPacket(uint8_t* data, size_t length, IPAddress remoteIp, uint16_t remotePort)
+        : payload(data), size(length), remote(remoteIp), port(remotePort) {}
+
+    uint8_t* data() { return payload; }
+    size_t length() { return size; }
+    IPAddress remoteIP() { return remote; }
+    uint16_t remotePort() { return port; }
+};
+
+typedef std::function<void(AsyncUDPPacket& packet)> AuPacketHandlerFunction;
+typedef std::function<void(void* arg, AsyncUDPPacket& packet)> AuPacketHandlerFunctionWithArg;
+
+// ===== UDP mit Empfangs-Rückruf ohne Netzwerk =====
+// Wie im Arduino-ESP32-Core läuft onPacket() in einem eigenen Task, sobald
+// ein Paket eintrifft – hier über NativeClock::schedule() zur simulierten
+// Ankunftszeit. Pakete an Port 123 beantwortet der simulierte NTP-Server
+// (NativeNtpServer), alles andere wird verworfen.
+class AsyncUDP {
+private:
+    static const size_t PACKET_SIZE = 48;
+
+    bool listening;
+    AuPacketHandlerFunctionWithArg handler;
+    void* handlerArg;
+
+    uint8_t response[PACKET_SIZE];
+    bool responsePending;      // Höchstens eine Antwort unterwegs
+
+    static void deliver(void* context);
+
+public:
+    AsyncUDP();
+    ~AsyncUDP() { NativeClock::cancel(this); }
+
+    void onPacket(AuPacketHandlerFunctionWithArg cb, void* arg = nullptr);
+    void onPacket(AuPacketHandlerFunction cb);
+    bool listen(uint16_t port);
+    size_t writeTo(const uint8_t* data, size_t len, const IPAddress addr, uint16_t port);
+    void close();
+    bool connected() const { return listening; }
+};
+
+// ===== Simulierter NTP-Server =====
+// Die "wahre" UTC-Zeit weicht von NATIVE_EPOCH_BASE + simulierter Uhr um
+// einen einstellbaren Versatz ab; setDriftPpm() lässt die Geräteuhr (die
+// simulierte Uhr) zusätzlich schneller laufen als die wahre Zeit. Hin- und
+// Rückweg haben eigene Laufzeiten plus Zufallsanteil.
+namespace NativeNtpServer {
+    void reset();
+    void setAvailable(bool available);
+    void setClockOffsetMicros(int64_t offsetUs);      // Wahre Zeit minus Geräteuhr
+    void setDriftPpm(double ppm);                     // Geräteuhr geht vor (> 0)
+    void setPathDelayMs(uint32_t uplinkMs, uint32_t downlinkMs);
+    void setJitterMicros(uint32_t jitterUs);          // Je Richtung 0..jitterUs zusätzlich
+    void setLossEvery(uint32_t n);                    // Jede n-te Anfrage geht verloren (0 = keine)
+    void setStratum(uint8_t stratum);                 // 0 = Kiss-o'-Death
+    int64_t trueEpochMicros();                        // Referenz für die Prüfung
+    uint32_t getRequestCount();
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "LittleFS.h"
+#include <dirent.h>
+#include <sys/stat.h>
+
+LittleFSFS LittleFS;
+
+namespace fs {
+
+File FS::open(const char* path, const char* mode, const bool create) {
+    (void)create;
+    if (!mounted) {
+        return File();
+    }
+    // "b" für Binärmodus, damit der Inhalt auf jedem Host identisch bleibt
+    std::string hostMode = std::string(mode) + "b";
+    return File(fopen(hostPath(path).c_str(), hostMode.c_str()));
+}
+
+bool FS::exists(const char* path) {
+    struct stat info;
+    return mounted && stat(hostPath(path).c_str(), &info) == 0;
+}
+
+bool FS::remove(const char* path) {
+    return mounted && ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    return mounted && ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
+
+}  // namespace fs
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel) {
+    (void)formatOnFail;
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+
+    const char* configured = getenv("NATIVE_FS_ROOT");
+    root = configured ? configured : "/tmp/esp32_fs";
+    ::mkdir(root.c_str(), 0755);
+
+    struct stat info;
+    mounted = stat(root.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    return mounted;
+}
+
+bool LittleFSFS::format() {
+    if (!mounted) {
+        return false;
+    }
+    DIR* dir = opendir(root.c_str());
+    if (dir == nullptr) {
+        return false;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            ::remove((root + "/" + entry->d_name).c_str());
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t used = 0;
+    DIR* dir = mounted ? opendir(root.c_str()) : nullptr;
+    if (dir == nullptr) {
+        return 0;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        struct stat info;
+        if (entry->d_name[0] != '.' && stat((root + "/" + entry->d_name).c_str(), &info) == 0) {
+            used += (size_t)info.st_size;
+        }
+    }
+    closedir(dir);
+    return used;
+}
@@ -0,0 +1,85 @@
+#ifndef NATIVE_FS_H
+#define NATIVE_FS_H
+
+#include <Arduino.h>
+#include <memory>
+#include <string>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+// ===== Dateisystem-Attrappe =====
+// Bildet fs::FS / fs::File des ESP32-Cores auf stdio in einem Host-
+// Verzeichnis ab (Standard: /tmp/esp32_fs, änderbar über NATIVE_FS_ROOT).
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+// Wie im Original wird die Datei geschlossen, sobald die letzte Kopie
+// des File-Objekts zerstört wird
+class File {
+private:
+    std::shared_ptr<FILE> handle;
+
+    FILE* raw() const { return handle.get(); }
+
+public:
+    File() {}
+    explicit File(FILE* f) { if (f) handle.reset(f, fclose); }
+
+    operator bool() const { return handle != nullptr; }
+
+    size_t write(const uint8_t* buf, size_t size) { return raw() ? fwrite(buf, 1, size, raw()) : 0; }
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t read(uint8_t* buf, size_t size) { return raw() ? fread(buf, 1, size, raw()) : 0; }
+    int read() { uint8_t c; return read(&c, 1) == 1 ? c : -1; }
+    int available() { return raw() ? (int)(size() - position()) : 0; }
+    void flush() { if (raw()) fflush(raw()); }
+
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+        int whence = mode == SeekSet ? SEEK_SET : (mode == SeekCur ? SEEK_CUR : SEEK_END);
+        return raw() && fseek(raw(), (long)pos, whence) == 0;
+    }
+    size_t position() const { return raw() ? (size_t)ftell(raw()) : 0; }
+    size_t size() const {
+        if (!raw()) return 0;
+        long current = ftell(raw());
+        fseek(raw(), 0, SEEK_END);
+        long end = ftell(raw());
+        fseek(raw(), current, SEEK_SET);
+        return (size_t)end;
+    }
+    void close() { handle.reset(); }
+};
+
+class FS {
+protected:
+    std::string root;
+    bool mounted;
+
+    std::string hostPath(const char* path) const { return root + path; }
+
+public:
+    FS() : mounted(false) {}
+
+    File open(const char* path, const char* mode = FILE_READ, const bool create = false);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool mkdir(const char* path);
+};
+
+}  // namespace fs
+
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef NATIVE_IPADDRESS_H
+#define NATIVE_IPADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress {
+private:
+    uint8_t octets[4];
+
+public:
+    IPAddress() : octets{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+    IPAddress(uint32_t address) {
+        octets[0] = address & 0xFF;
+        octets[1] = (address >> 8) & 0xFF;
+        octets[2] = (address >> 16) & 0xFF;
+        octets[3] = (address >> 24) & 0xFF;
+    }
+
+    operator uint32_t() const {
+        return (uint32_t)octets[0] | ((uint32_t)octets[1] << 8) |
+               ((uint32_t)octets[2] << 16) | ((uint32_t)octets[3] << 24);
+    }
+    uint8_t operator[](int index) const { return octets[index & 3]; }
+
+    String toString() const {
+        char tmp[16];
+        snprintf(tmp, sizeof(tmp), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(tmp);
+    }
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+
+#include "FS.h"
+
+class LittleFSFS : public fs::FS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    bool format();
+    void end() { mounted = false; }
+    size_t totalBytes() { return 1536 * 1024; }
+    size_t usedBytes();
+};
+
+extern LittleFSFS LittleFS;
+
+#endif
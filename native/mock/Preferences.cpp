@@ -0,0 +1,106 @@
+#include "Preferences.h"
+
+typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+
+static std::map<std::string, Namespace>& storage() {
+    static std::map<std::string, Namespace> partitions;
+    return partitions;
+}
+
+static uint32_t writeCount = 0;
+
+bool Preferences::begin(const char* name, bool ro, const char* partitionLabel) {
+    (void)partitionLabel;
+    if (!name || strlen(name) > 15) {   // NVS: max. 15 Zeichen
+        return false;
+    }
+    ns = name;
+    readOnly = ro;
+    opened = true;
+    return true;
+}
+
+bool Preferences::put(const char* key, const void* value, size_t len) {
+    if (!opened || readOnly || !key || strlen(key) > 15) {
+        return false;
+    }
+    const uint8_t* bytes = (const uint8_t*)value;
+    storage()[ns][key] = std::vector<uint8_t>(bytes, bytes + len);
+    writeCount++;
+    return true;
+}
+
+const std::vector<uint8_t>* Preferences::find(const char* key) const {
+    if (!opened || !key) {
+        return nullptr;
+    }
+    auto space = storage().find(ns);
+    if (space == storage().end()) {
+        return nullptr;
+    }
+    auto entry = space->second.find(key);
+    return entry == space->second.end() ? nullptr : &entry->second;
+}
+
+bool Preferences::clear() {
+    if (!opened || readOnly) {
+        return false;
+    }
+    storage().erase(ns);
+    writeCount++;
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!opened || readOnly || !find(key)) {
+        return false;
+    }
+    storage()[ns].erase(key);
+    writeCount++;
+    return true;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    size_t len = value ? strlen(value) : 0;
+    return put(key, value ? value : "", len + 1) ? len : 0;
+}
+
+uint8_t Preferences::getUChar(const char* key, uint8_t defaultValue) {
+    const std::vector<uint8_t>* entry = find(key);
+    return entry && entry->size() == 1 ? (*entry)[0] : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+    const std::vector<uint8_t>* entry = find(key);
+    uint32_t value = defaultValue;
+    if (entry && entry->size() == 4) {
+        memcpy(&value, entry->data(), 4);
+    }
+    return value;
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLen) {
+    const std::vector<uint8_t>* entry = find(key);
+    if (!entry || !value || entry->size() > maxLen) {
+        return 0;
+    }
+    memcpy(value, entry->data(), entry->size());
+    return entry->size();   // Wie nvs_get_str() inkl. Nullterminator
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    const std::vector<uint8_t>* entry = find(key);
+    if (!entry || !buf || entry->size() > maxLen) {
+        return 0;
+    }
+    memcpy(buf, entry->data(), entry->size());
+    return entry->size();
+}
+
+void Preferences::eraseAll() {
+    storage().clear();
+}
+
+uint32_t Preferences::getWriteCount() {
+    return writeCount;
+}
@@ -0,0 +1,46 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// ===== NVS-Attrappe =====
+// Schlüssel/Wert-Speicher je Namensraum wie Preferences des ESP32-Cores.
+// Die Daten liegen prozessweit im RAM und überstehen damit neue Instanzen
+// (wie NVS einen Neustart). Schreibzugriffe werden gezählt.
+class Preferences {
+private:
+    std::string ns;
+    bool opened;
+    bool readOnly;
+
+    bool put(const char* key, const void* value, size_t len);
+    const std::vector<uint8_t>* find(const char* key) const;
+
+public:
+    Preferences() : opened(false), readOnly(false) {}
+
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+    void end() { opened = false; }
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key) { return find(key) != nullptr; }
+
+    size_t putUChar(const char* key, uint8_t value) { return put(key, &value, 1) ? 1 : 0; }
+    size_t putUInt(const char* key, uint32_t value) { return put(key, &value, 4) ? 4 : 0; }
+    size_t putString(const char* key, const char* value);
+    size_t putBytes(const char* key, const void* value, size_t len) { return put(key, value, len) ? len : 0; }
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    size_t getString(const char* key, char* value, size_t maxLen);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+    // Nur im Host-Build vorhanden
+    static void eraseAll();
+    static uint32_t getWriteCount();
+};
+
+#endif
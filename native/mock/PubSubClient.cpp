@@ -0,0 +1,171 @@
+#include "PubSubClient.h"
+#include <WiFi.h>
+
+uint64_t PubSubClient::publishCount = 0;
+uint64_t PubSubClient::payloadBytes = 0;
+std::function<void(const char*, const uint8_t*, unsigned int)> PubSubClient::publishObserver;
+
+static const char TWIN_REPORTED_PREFIX[] = "$iothub/twin/PATCH/properties/reported/?$rid=";
+
+PubSubClient::PubSubClient(Client& c) : client(&c), buffer(nullptr), bufferSize(0),
+                                        currentState(MQTT_DISCONNECTED), callback(nullptr),
+                                        twinVersion(1) {
+    setBufferSize(MQTT_MAX_PACKET_SIZE);
+}
+
+PubSubClient::~PubSubClient() {
+    free(buffer);
+}
+
+PubSubClient& PubSubClient::setServer(const char* domain, uint16_t port) {
+    (void)domain;
+    (void)port;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
+    this->callback = callback;
+    return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) {
+    if (size == 0) {
+        return false;
+    }
+    uint8_t* resized = (uint8_t*)realloc(buffer, size);
+    if (resized == nullptr) {
+        return false;
+    }
+    buffer = resized;
+    bufferSize = size;
+    return true;
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+    (void)id;
+    (void)user;
+    (void)pass;
+
+    if (WiFi.status() != WL_CONNECTED) {
+        currentState = MQTT_CONNECT_FAILED;
+        return false;
+    }
+    client->connect("broker", 8883);
+    currentState = MQTT_CONNECTED;
+    return true;
+}
+
+void PubSubClient::disconnect() {
+    twinResponse.clear();
+    client->stop();
+    currentState = MQTT_DISCONNECTED;
+}
+
+bool PubSubClient::connected() {
+    if (currentState == MQTT_CONNECTED && WiFi.status() != WL_CONNECTED) {
+        client->stop();
+        currentState = MQTT_CONNECTION_LOST;
+    }
+    return currentState == MQTT_CONNECTED;
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, false);
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength) {
+    return publish(topic, payload, plength, false);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int plength, bool retained) {
+    if (!connected()) {
+        return false;
+    }
+
+    size_t topicLength = strnlen(topic, bufferSize);
+    if (bufferSize < MQTT_MAX_HEADER_SIZE + 2 + topicLength + plength) {
+        return false;  // Gleiches Verhalten wie das Original: zu groß für den Puffer
+    }
+
+    // Variabler Header + Payload hinter dem reservierten Fixed Header
+    size_t length = MQTT_MAX_HEADER_SIZE;
+    buffer[length++] = (uint8_t)(topicLength >> 8);
+    buffer[length++] = (uint8_t)(topicLength & 0xFF);
+    memcpy(buffer + length, topic, topicLength);
+    length += topicLength;
+    memcpy(buffer + length, payload, plength);
+    length += plength;
+
+    // Fixed Header: Typ + Restlänge (variable Länge, 1-4 Bytes)
+    uint8_t header[MQTT_MAX_HEADER_SIZE];
+    size_t headerLength = 1;
+    header[0] = 0x30 | (retained ? 0x01 : 0x00);
+    size_t remaining = length - MQTT_MAX_HEADER_SIZE;
+    do {
+        uint8_t digit = remaining % 128;
+        remaining /= 128;
+        if (remaining > 0) {
+            digit |= 0x80;
+        }
+        header[headerLength++] = digit;
+    } while (remaining > 0);
+
+    size_t start = MQTT_MAX_HEADER_SIZE - headerLength;
+    memcpy(buffer + start, header, headerLength);
+
+    size_t written = client->write(buffer + start, length - start);
+    if (written != length - start) {
+        return false;
+    }
+
+    publishCount++;
+    payloadBytes += plength;
+    if (strncmp(topic, TWIN_REPORTED_PREFIX, sizeof(TWIN_REPORTED_PREFIX) - 1) == 0) {
+        twinResponse = std::string("$iothub/twin/res/204/?$rid=") + (topic + sizeof(TWIN_REPORTED_PREFIX) - 1) +
+                       "&$version=" + std::to_string(++twinVersion);
+    }
+    if (publishObserver) {
+        publishObserver(topic, payload, plength);
+    }
+    return true;
+}
+
+bool PubSubClient::subscribe(const char* topic, uint8_t qos) {
+    (void)topic;
+    (void)qos;
+    return connected();
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+    (void)topic;
+    return connected();
+}
+
+bool PubSubClient::loop() {
+    if (!connected()) {
+        return false;
+    }
+    // Wie das Original: eingehende Pakete lesen. Der simulierte Broker
+    // schickt nur PUBACKs, die PubSubClient ohnehin verwirft.
+    while (client->available() > 0 && client->read() >= 0) {
+    }
+    if (!twinResponse.empty() && callback) {
+        std::string topic = twinResponse;
+        twinResponse.clear();
+        callback((char*)topic.c_str(), buffer, 0);
+    }
+    return true;
+}
+
+void PubSubClient::injectMessage(const char* topic, const uint8_t* payload, unsigned int length) {
+    if (!callback || length >= bufferSize) {
+        return;
+    }
+    // Wie im Original liegt die Payload im internen Puffer
+    memcpy(buffer, payload, length);
+    callback((char*)topic, buffer, length);
+}
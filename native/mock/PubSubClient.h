@@ -0,0 +1,76 @@
+#ifndef NATIVE_PUBSUBCLIENT_H
+#define NATIVE_PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <functional>
+#include <string>
+#include "Client.h"
+
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_MAX_HEADER_SIZE 5
+
+#define MQTT_CONNECTION_TIMEOUT     -4
+#define MQTT_CONNECTION_LOST        -3
+#define MQTT_CONNECT_FAILED         -2
+#define MQTT_DISCONNECTED           -1
+#define MQTT_CONNECTED               0
+#define MQTT_CONNECT_UNAVAILABLE     3
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+// ===== PubSubClient-Attrappe =====
+// Kodiert PUBLISH-Pakete wie das Original (QoS 0, gleiche Puffergrenzen)
+// und schreibt sie in den Client. Der Broker antwortet sofort; ein Ausfall
+// wird über den WLAN-Status der WiFi-Attrappe simuliert. Updates der
+// Reported Properties beantwortet er wie IoT Hub (Status 204, im nächsten loop()).
+// loop() liest den Client leer wie das Original (PUBACKs für MqttQos1Publisher).
+class PubSubClient {
+private:
+    Client* client;
+    uint8_t* buffer;
+    uint16_t bufferSize;
+    int currentState;
+    MQTT_CALLBACK_SIGNATURE;
+    std::string twinResponse;    // Wartende Antwort auf ein Twin-Update
+    uint32_t twinVersion;
+
+    static uint64_t publishCount;
+    static uint64_t payloadBytes;
+    static std::function<void(const char*, const uint8_t*, unsigned int)> publishObserver;
+
+public:
+    explicit PubSubClient(Client& client);
+    ~PubSubClient();
+
+    PubSubClient& setServer(const char* domain, uint16_t port);
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+    PubSubClient& setKeepAlive(uint16_t keepAlive) { (void)keepAlive; return *this; }
+    PubSubClient& setSocketTimeout(uint16_t timeout) { (void)timeout; return *this; }
+    bool setBufferSize(uint16_t size);
+    uint16_t getBufferSize() const { return bufferSize; }
+
+    bool connect(const char* id, const char* user, const char* pass);
+    void disconnect();
+    bool connected();
+    int state() const { return currentState; }
+
+    bool publish(const char* topic, const char* payload);
+    bool publish(const char* topic, const char* payload, bool retained);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int plength);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int plength, bool retained);
+
+    bool subscribe(const char* topic, uint8_t qos = 0);
+    bool unsubscribe(const char* topic);
+    bool loop();
+
+    // Nur im Host-Build vorhanden
+    void injectMessage(const char* topic, const uint8_t* payload, unsigned int length);
+    static uint64_t getPublishCount() { return publishCount; }
+    static uint64_t getPayloadBytes() { return payloadBytes; }
+    // Sieht jede erfolgreich gesendete Nachricht (nullptr = aus)
+    static void setPublishObserver(std::function<void(const char*, const uint8_t*, unsigned int)> observer) {
+        publishObserver = observer;
+    }
+};
+
+#endif
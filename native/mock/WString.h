@@ -0,0 +1,93 @@
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+
+// ===== Arduino String für den Host-Build =====
+// Schmale Hülle um std::string mit den von src/ und ArduinoJson
+// verwendeten Methoden. Heap-Verhalten entspricht dem Original
+// (jede Verkettung allokiert), damit der Benchmark realistisch bleibt.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+class String {
+protected:
+    std::string buffer;
+
+public:
+    String() {}
+    String(const char* s) : buffer(s ? s : "") {}
+    String(const std::string& s) : buffer(s) {}
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(int value) : buffer(std::to_string(value)) {}
+    explicit String(unsigned int value) : buffer(std::to_string(value)) {}
+    explicit String(long value) : buffer(std::to_string(value)) {}
+    explicit String(unsigned long value) : buffer(std::to_string(value)) {}
+    explicit String(float value, unsigned int decimals = 2) { fromDouble(value, decimals); }
+    explicit String(double value, unsigned int decimals = 2) { fromDouble(value, decimals); }
+
+    String& operator=(const char* s) { buffer = s ? s : ""; return *this; }
+
+    const char* c_str() const { return buffer.c_str(); }
+    unsigned int length() const { return (unsigned int)buffer.length(); }
+    bool isEmpty() const { return buffer.empty(); }
+    char charAt(unsigned int index) const { return index < buffer.size() ? buffer[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    bool reserve(unsigned int size) { buffer.reserve(size); return true; }
+    bool concat(const String& s) { buffer += s.buffer; return true; }
+    bool concat(const char* s) { if (s) buffer += s; return true; }
+    bool concat(const char* s, unsigned int len) { if (s) buffer.append(s, len); return true; }
+    bool concat(char c) { buffer += c; return true; }
+
+    String& operator+=(const String& s) { concat(s); return *this; }
+    String& operator+=(const char* s) { concat(s); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    int indexOf(const char* s) const {
+        size_t pos = buffer.find(s);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    int indexOf(char c) const {
+        size_t pos = buffer.find(c);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    long toInt() const { return strtol(buffer.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(buffer.c_str(), nullptr); }
+
+    bool operator==(const String& other) const { return buffer == other.buffer; }
+    bool operator==(const char* s) const { return s && buffer == s; }
+    bool operator!=(const String& other) const { return buffer != other.buffer; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+
+private:
+    void fromDouble(double value, unsigned int decimals) {
+        char tmp[48];
+        snprintf(tmp, sizeof(tmp), "%.*f", (int)decimals, value);
+        buffer = tmp;
+    }
+};
+
+// Wie im Arduino-Core: Ergebnis einer Verkettung
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& s) : String(s) {}
+    StringSumHelper(const char* s) : String(s) {}
+};
+
+inline StringSumHelper operator+(const String& lhs, const String& rhs) {
+    StringSumHelper result(lhs); result.concat(rhs); return result;
+}
+inline StringSumHelper operator+(const String& lhs, const char* rhs) {
+    StringSumHelper result(lhs); result.concat(rhs); return result;
+}
+inline StringSumHelper operator+(const char* lhs, const String& rhs) {
+    StringSumHelper result(lhs); result.concat(rhs); return result;
+}
+inline StringSumHelper operator+(const String& lhs, char rhs) {
+    StringSumHelper result(lhs); result.concat(rhs); return result;
+}
+
+#endif
@@ -0,0 +1,305 @@
+#include "WiFi.h"
+
+WiFiClass WiFi;
+
+WiFiClass::WiFiClass()
+    : accessPointCount(0), linkAvailable(true), currentStatus(WL_DISCONNECTED),
+      staticIp(false), staticAddress(0), dhcpMs(DHCP_MS),
+      pending(false), associated(false), targetAp(-1), failReason(0),
+      associatedAtMicros(0), gotIpAtMicros(0), failAtMicros(0),
+      beginCount(0), fastBeginCount(0),
+      scanRunning(false), scanChannel(0), scanDoneAtMicros(0), scanResultCount(WIFI_SCAN_FAILED),
+      scanCount(0), handlerCount(0) {
+}
+
+bool WiFiClass::config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    (void)gateway; (void)subnet; (void)dns1; (void)dns2;
+    // 0.0.0.0 schaltet wie im Original DHCP wieder ein
+    staticAddress = (uint32_t)local;
+    staticIp = staticAddress != 0;
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel,
+                             const uint8_t* bssid, bool connect) {
+    (void)connect;
+    beginCount++;
+    uint64_t now = NativeClock::nowMicros();
+    uint8_t requestedChannel = channel > 0 ? (uint8_t)channel : 0;
+    if (requestedChannel != 0 && bssid != nullptr) {
+        fastBeginCount++;
+    }
+
+    pending = true;
+    associated = false;
+    currentStatus = WL_DISCONNECTED;
+    targetAp = -1;
+
+    // Kanal vorgegeben: nur dieser; sonst der Reihe nach bis zum ersten passenden AP
+    uint8_t firstChannel = requestedChannel ? requestedChannel : 1;
+    uint8_t lastChannel = requestedChannel ? requestedChannel : CHANNEL_COUNT;
+    uint32_t scanMs = 0;
+    for (uint8_t ch = firstChannel; ch <= lastChannel && targetAp < 0; ch++) {
+        scanMs += SCAN_PER_CHANNEL_MS;
+        for (size_t i = 0; i < accessPointCount; i++) {
+            const AccessPoint& ap = accessPoints[i];
+            if (ap.channel == ch && reachable(i) && ssid && strcmp(ap.ssid, ssid) == 0 &&
+                (bssid == nullptr || memcmp(bssid, ap.bssid, 6) == 0)) {
+                targetAp = (int)i;
+                break;
+            }
+        }
+    }
+
+    if (targetAp < 0) {
+        failReason = WIFI_REASON_NO_AP_FOUND;
+        failAtMicros = now + (uint64_t)scanMs * 1000ULL;
+        associatedAtMicros = gotIpAtMicros = UINT64_MAX;
+    } else if (strcmp(accessPoints[targetAp].password, passphrase ? passphrase : "") != 0) {
+        failReason = WIFI_REASON_AUTH_FAIL;
+        failAtMicros = now + (uint64_t)(scanMs + ASSOCIATION_MS) * 1000ULL;
+        associatedAtMicros = gotIpAtMicros = UINT64_MAX;
+    } else {
+        failAtMicros = UINT64_MAX;
+        associatedAtMicros = now + (uint64_t)(scanMs + ASSOCIATION_MS) * 1000ULL;
+        gotIpAtMicros = associatedAtMicros + (staticIp ? 0 : (uint64_t)dhcpMs * 1000ULL);
+    }
+    return currentStatus;
+}
+
+bool WiFiClass::disconnect(bool wifioff, bool eraseap) {
+    (void)wifioff; (void)eraseap;
+    if (pending || currentStatus == WL_CONNECTED) {
+        dropLink(WIFI_REASON_ASSOC_LEAVE);
+    }
+    currentStatus = WL_DISCONNECTED;
+    return true;
+}
+
+void WiFiClass::dropLink(uint8_t reason) {
+    pending = false;
+    associated = false;
+    currentStatus = reason == WIFI_REASON_ASSOC_LEAVE ? WL_DISCONNECTED : WL_CONNECTION_LOST;
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+    info.wifi_sta_disconnected.reason = reason;
+    dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+}
+
+// Fällige Ereignisse des laufenden Verbindungsaufbaus zustellen
+void WiFiClass::advance() {
+    if (!pending) {
+        return;
+    }
+    uint64_t now = NativeClock::nowMicros();
+    arduino_event_info_t info;
+    memset(&info, 0, sizeof(info));
+
+    if (now >= failAtMicros) {
+        pending = false;
+        currentStatus = failReason == WIFI_REASON_AUTH_FAIL ? WL_CONNECT_FAILED : WL_NO_SSID_AVAIL;
+        info.wifi_sta_disconnected.reason = failReason;
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+        return;
+    }
+    if (!associated && now >= associatedAtMicros) {
+        associated = true;
+        memcpy(info.wifi_sta_connected.bssid, accessPoints[targetAp].bssid, 6);
+        info.wifi_sta_connected.channel = accessPoints[targetAp].channel;
+        info.wifi_sta_connected.authmode = WIFI_AUTH_WPA2_PSK;
+        dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED, info);
+        memset(&info, 0, sizeof(info));
+    }
+    if (associated && now >= gotIpAtMicros) {
+        pending = false;
+        currentStatus = WL_CONNECTED;
+        info.got_ip.ip_info.ip.addr = (uint32_t)localIP();
+        info.got_ip.ip_info.netmask.addr = (uint32_t)subnetMask();
+        info.got_ip.ip_info.gw.addr = (uint32_t)gatewayIP();
+        dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP, info);
+    }
+}
+
+wl_status_t WiFiClass::status() {
+    advance();
+    return currentStatus;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb cbEvent, arduino_event_id_t event) {
+    if (handlerCount >= MAX_HANDLERS) {
+        return 0;
+    }
+    handlers[handlerCount] = cbEvent;
+    handlerFilter[handlerCount] = event;
+    return ++handlerCount;
+}
+
+void WiFiClass::dispatch(arduino_event_id_t event, const arduino_event_info_t& info) {
+    for (size_t i = 0; i < handlerCount; i++) {
+        if (handlerFilter[i] == ARDUINO_EVENT_MAX || handlerFilter[i] == event) {
+            handlers[i](event, info);
+        }
+    }
+}
+
+// ===== Angaben zur bestehenden Verbindung =====
+
+String WiFiClass::SSID() {
+    return getConnectedAp() >= 0 ? String(accessPoints[targetAp].ssid) : String();
+}
+
+String WiFiClass::BSSIDstr() {
+    uint8_t* bssid = BSSID();
+    if (!bssid) {
+        return String();
+    }
+    char tmp[18];
+    snprintf(tmp, sizeof(tmp), "%02X:%02X:%02X:%02X:%02X:%02X",
+             bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+    return String(tmp);
+}
+
+uint8_t* WiFiClass::BSSID() {
+    return getConnectedAp() >= 0 ? accessPoints[targetAp].bssid : nullptr;
+}
+
+int32_t WiFiClass::channel() {
+    return getConnectedAp() >= 0 ? accessPoints[targetAp].channel : 0;
+}
+
+int8_t WiFiClass::RSSI() {
+    return getConnectedAp() >= 0 ? accessPoints[targetAp].rssi : 0;
+}
+
+// DNS über den Router; ohne Verbindung schlägt die Auflösung fehl
+int WiFiClass::hostByName(const char* host, IPAddress& result) {
+    if (getConnectedAp() < 0 || host == nullptr || *host == '\0') {
+        return 0;
+    }
+    result = IPAddress(192, 0, 2, 123);
+    return 1;
+}
+
+// ===== Scan =====
+// Dauer: max_ms_per_chan je Kanal (bzw. nur der angegebene Kanal)
+int16_t WiFiClass::scanNetworks(bool async, bool show_hidden, bool passive,
+                                uint32_t max_ms_per_chan, uint8_t channel) {
+    (void)show_hidden; (void)passive;
+    if (scanRunning) {
+        return WIFI_SCAN_RUNNING;
+    }
+    scanCount++;
+    uint32_t durationMs = max_ms_per_chan * (channel ? 1 : CHANNEL_COUNT);
+    scanRunning = true;
+    scanChannel = channel;
+    scanResultCount = WIFI_SCAN_RUNNING;
+    scanDoneAtMicros = NativeClock::nowMicros() + (uint64_t)durationMs * 1000ULL;
+    if (async) {
+        return WIFI_SCAN_RUNNING;
+    }
+    delay(durationMs);
+    return scanComplete();
+}
+
+void WiFiClass::finishScan() {
+    scanRunning = false;
+    scanResultCount = 0;
+    for (size_t i = 0; i < accessPointCount; i++) {
+        if (reachable(i) && (scanChannel == 0 || accessPoints[i].channel == scanChannel)) {
+            scanResults[scanResultCount++] = accessPoints[i];
+        }
+    }
+    // Wie esp_wifi_scan_get_ap_records(): nach Signalstärke sortiert
+    for (int16_t i = 1; i < scanResultCount; i++) {
+        for (int16_t j = i; j > 0 && scanResults[j].rssi > scanResults[j - 1].rssi; j--) {
+            AccessPoint tmp = scanResults[j];
+            scanResults[j] = scanResults[j - 1];
+            scanResults[j - 1] = tmp;
+        }
+    }
+}
+
+int16_t WiFiClass::scanComplete() {
+    if (scanRunning && NativeClock::nowMicros() >= scanDoneAtMicros) {
+        finishScan();
+    }
+    return scanRunning ? WIFI_SCAN_RUNNING : scanResultCount;
+}
+
+void WiFiClass::scanDelete() {
+    if (!scanRunning) {
+        scanResultCount = WIFI_SCAN_FAILED;
+    }
+}
+
+String WiFiClass::SSID(uint8_t index) {
+    return index < scanResultCount ? String(scanResults[index].ssid) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t index) {
+    return index < scanResultCount ? scanResults[index].rssi : 0;
+}
+
+uint8_t* WiFiClass::BSSID(uint8_t index) {
+    return index < scanResultCount ? scanResults[index].bssid : nullptr;
+}
+
+int32_t WiFiClass::channel(uint8_t index) {
+    return index < scanResultCount ? scanResults[index].channel : 0;
+}
+
+// ===== Simulierte Access Points =====
+
+int WiFiClass::addAccessPoint(const char* ssid, const char* password, uint8_t channel, int8_t rssi) {
+    if (accessPointCount >= MAX_ACCESS_POINTS) {
+        return -1;
+    }
+    AccessPoint& ap = accessPoints[accessPointCount];
+    memset(&ap, 0, sizeof(ap));
+    strncpy(ap.ssid, ssid, sizeof(ap.ssid) - 1);
+    strncpy(ap.password, password ? password : "", sizeof(ap.password) - 1);
+    const uint8_t base[6] = { 0x10, 0x20, 0x30, 0x40, 0x50, 0x60 };
+    memcpy(ap.bssid, base, 6);
+    ap.bssid[5] += (uint8_t)accessPointCount;
+    ap.channel = channel;
+    ap.rssi = rssi;
+    ap.available = true;
+    return (int)accessPointCount++;
+}
+
+void WiFiClass::clearAccessPoints() {
+    if (pending || currentStatus == WL_CONNECTED) {
+        dropLink(WIFI_REASON_BEACON_TIMEOUT);
+    }
+    accessPointCount = 0;
+    targetAp = -1;
+}
+
+void WiFiClass::setApRssi(int index, int8_t rssi) {
+    if (index >= 0 && (size_t)index < accessPointCount) {
+        accessPoints[index].rssi = rssi;
+    }
+}
+
+void WiFiClass::setApChannel(int index, uint8_t channel) {
+    if (index >= 0 && (size_t)index < accessPointCount) {
+        accessPoints[index].channel = channel;
+    }
+}
+
+void WiFiClass::setApAvailable(int index, bool available) {
+    if (index < 0 || (size_t)index >= accessPointCount) {
+        return;
+    }
+    accessPoints[index].available = available;
+    if (!available && index == targetAp && (pending || currentStatus == WL_CONNECTED)) {
+        dropLink(WIFI_REASON_BEACON_TIMEOUT);
+    }
+}
+
+void WiFiClass::setLinkAvailable(bool available) {
+    linkAvailable = available;
+    if (!available && (pending || currentStatus == WL_CONNECTED)) {
+        dropLink(WIFI_REASON_BEACON_TIMEOUT);
+    }
+}
@@ -0,0 +1,205 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "WiFiUdp.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK
+} wifi_auth_mode_t;
+
+// ===== WLAN-Ereignisse wie im Arduino-ESP32-Core 2.x =====
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 8,
+    ARDUINO_EVENT_MAX = 42
+} arduino_event_id_t;
+
+// Auswahl der Trennungsgründe (esp_wifi_types.h)
+#define WIFI_REASON_ASSOC_LEAVE 8
+#define WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT 15
+#define WIFI_REASON_BEACON_TIMEOUT 200
+#define WIFI_REASON_NO_AP_FOUND 201
+#define WIFI_REASON_AUTH_FAIL 202
+
+typedef struct { uint32_t addr; } esp_ip4_addr_t;
+
+typedef union {
+    struct {
+        uint8_t ssid[33];
+        uint8_t ssid_len;
+        uint8_t bssid[6];
+        uint8_t channel;
+        wifi_auth_mode_t authmode;
+        uint16_t aid;
+    } wifi_sta_connected;
+    struct {
+        uint8_t ssid[33];
+        uint8_t ssid_len;
+        uint8_t bssid[6];
+        uint8_t reason;
+    } wifi_sta_disconnected;
+    struct {
+        int if_index;
+        void* esp_netif;
+        struct {
+            esp_ip4_addr_t ip;
+            esp_ip4_addr_t netmask;
+            esp_ip4_addr_t gw;
+        } ip_info;
+        bool ip_changed;
+    } got_ip;
+} arduino_event_info_t;
+
+typedef void (*WiFiEventFuncCb)(arduino_event_id_t event, arduino_event_info_t info);
+typedef size_t wifi_event_id_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+// ===== WLAN-Stack ohne Funk =====
+// Simuliert mehrere Access Points (addAccessPoint(), BSSID ...:60+Index).
+// Der Verbindungsaufbau dauert simulierte Zeit: Ohne Kanal sucht begin()
+// die Kanäle der Reihe nach ab und nimmt wie der ESP32 (WIFI_FAST_SCAN) den
+// ersten passenden AP, nicht den stärksten. Mit channel/BSSID wird nur
+// dieser Kanal abgefragt. Danach folgen Authentifizierung/Assoziation und
+// DHCP (entfällt mit statischer IP über config()). Die Ereignisse werden
+// beim nächsten Aufruf von status() zugestellt, sobald ihr Zeitpunkt
+// erreicht ist. setLinkAvailable(false) bzw. setApAvailable() simulieren
+// Ausfälle, setApRssi() eine Bewegung des Geräts.
+class WiFiClass {
+private:
+    static const size_t MAX_HANDLERS = 4;
+    static const size_t MAX_ACCESS_POINTS = 8;
+
+    struct AccessPoint {
+        char ssid[33];
+        char password[65];
+        uint8_t bssid[6];
+        uint8_t channel;
+        int8_t rssi;
+        bool available;
+    };
+
+    AccessPoint accessPoints[MAX_ACCESS_POINTS];
+    size_t accessPointCount;
+    bool linkAvailable;
+    wl_status_t currentStatus;
+    bool staticIp;
+    uint32_t staticAddress;
+    uint32_t dhcpMs;
+
+    bool pending;              // begin() läuft
+    bool associated;
+    int targetAp;              // AP des laufenden Versuchs bzw. der Verbindung
+    uint8_t failReason;
+    uint64_t associatedAtMicros;
+    uint64_t gotIpAtMicros;
+    uint64_t failAtMicros;     // Kein AP gefunden / Passwort falsch
+    uint32_t beginCount;
+    uint32_t fastBeginCount;
+
+    // Scan (Ergebnis als Momentaufnahme bei Abschluss)
+    bool scanRunning;
+    uint8_t scanChannel;       // 0 = alle
+    uint64_t scanDoneAtMicros;
+    AccessPoint scanResults[MAX_ACCESS_POINTS];
+    int16_t scanResultCount;
+    uint32_t scanCount;
+
+    WiFiEventFuncCb handlers[MAX_HANDLERS];
+    arduino_event_id_t handlerFilter[MAX_HANDLERS];
+    size_t handlerCount;
+
+    void dispatch(arduino_event_id_t event, const arduino_event_info_t& info);
+    void dropLink(uint8_t reason);
+    void advance();
+    void finishScan();
+    bool reachable(size_t index) const { return linkAvailable && accessPoints[index].available; }
+
+public:
+    // Zeitbedarf (Richtwerte ESP32, aktiver Scan)
+    static const uint32_t SCAN_PER_CHANNEL_MS = 120;
+    static const uint32_t CHANNEL_COUNT = 13;
+    static const uint32_t ASSOCIATION_MS = 150;   // Auth, Assoziation, 4-Way-Handshake
+    static const uint32_t DHCP_MS = 900;          // DISCOVER/OFFER/REQUEST/ACK
+
+    WiFiClass();
+
+    bool mode(wifi_mode_t m) { (void)m; return true; }
+    bool setAutoReconnect(bool enable) { (void)enable; return true; }
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = (uint32_t)0, IPAddress dns2 = (uint32_t)0);
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr,
+                      int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true);
+    bool disconnect(bool wifioff = false, bool eraseap = false);
+    wl_status_t status();
+
+    wifi_event_id_t onEvent(WiFiEventFuncCb cbEvent, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+
+    IPAddress localIP() { return IPAddress(192, 168, 0, 42); }
+    IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+    IPAddress gatewayIP() { return IPAddress(192, 168, 0, 1); }
+    IPAddress dnsIP(uint8_t index = 0) { (void)index; return IPAddress(192, 168, 0, 1); }
+    String macAddress() { return String("A1:B2:C3:D4:E5:F6"); }
+    int hostByName(const char* host, IPAddress& result);   // 1 = aufgelöst
+    String SSID();
+    String BSSIDstr();
+    uint8_t* BSSID();
+    int32_t channel();
+    int8_t RSSI();
+
+    int16_t scanNetworks(bool async = false, bool show_hidden = false, bool passive = false,
+                         uint32_t max_ms_per_chan = 300, uint8_t channel = 0);
+    int16_t scanComplete();
+    void scanDelete();
+    String SSID(uint8_t index);
+    int32_t RSSI(uint8_t index);
+    uint8_t* BSSID(uint8_t index);
+    int32_t channel(uint8_t index);
+    wifi_auth_mode_t encryptionType(uint8_t index) { (void)index; return WIFI_AUTH_WPA2_PSK; }
+
+    // Nur im Host-Build vorhanden
+    int addAccessPoint(const char* ssid, const char* password, uint8_t channel, int8_t rssi);
+    void clearAccessPoints();
+    void setApRssi(int index, int8_t rssi);
+    void setApChannel(int index, uint8_t channel);   // AP umgezogen
+    void setApAvailable(int index, bool available);
+    void setLinkAvailable(bool available);           // Alle APs
+    void setDhcpMs(uint32_t ms) { dhcpMs = ms; }      // Langsamer DHCP-Server
+    int getConnectedAp() const { return currentStatus == WL_CONNECTED ? targetAp : -1; }
+    uint32_t getBeginCount() const { return beginCount; }
+    uint32_t getFastBeginCount() const { return fastBeginCount; }   // Mit Kanal/BSSID
+    uint32_t getScanCount() const { return scanCount; }
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef NATIVE_WIFICLIENT_H
+#define NATIVE_WIFICLIENT_H
+
+#include "Client.h"
+
+// TCP-Verbindung ohne echten Socket: Schreiben wird gezählt,
+// Lesen liefert nie Daten. Reicht für PubSubClient-Ersatz und Benchmark.
+class WiFiClient : public Client {
+protected:
+    bool open;
+    uint64_t bytesSent;
+
+public:
+    WiFiClient() : open(false), bytesSent(0) {}
+
+    int connect(IPAddress ip, uint16_t port) override { (void)ip; (void)port; open = true; return 1; }
+    int connect(const char* host, uint16_t port) override { (void)host; (void)port; open = true; return 1; }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override { (void)buf; bytesSent += size; return size; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int read(uint8_t* buf, size_t size) override { (void)buf; (void)size; return -1; }
+    int peek() override { return -1; }
+    void flush() override {}
+    void stop() override { open = false; }
+    uint8_t connected() override { return open; }
+    operator bool() override { return open; }
+
+    uint64_t getBytesSent() const { return bytesSent; }
+};
+
+#endif
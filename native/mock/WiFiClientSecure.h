@@ -0,0 +1,24 @@
+#ifndef NATIVE_WIFICLIENTSECURE_H
+#define NATIVE_WIFICLIENTSECURE_H
+
+#include "WiFiClient.h"
+
+// TLS-Client: Zertifikate werden nur gespeichert, es findet kein Handshake statt
+class WiFiClientSecure : public WiFiClient {
+protected:
+    const char* caCert;
+    const char* clientCert;
+    const char* clientKey;
+    bool insecure;
+
+public:
+    WiFiClientSecure() : caCert(nullptr), clientCert(nullptr), clientKey(nullptr), insecure(false) {}
+
+    void setCACert(const char* rootCA) { caCert = rootCA; }
+    void setCertificate(const char* cert) { clientCert = cert; }
+    void setPrivateKey(const char* key) { clientKey = key; }
+    void setInsecure() { insecure = true; }
+    void setHandshakeTimeout(unsigned long seconds) { (void)seconds; }
+};
+
+#endif
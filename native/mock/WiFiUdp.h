@@ -0,0 +1,24 @@
+#ifndef NATIVE_WIFIUDP_H
+#define NATIVE_WIFIUDP_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+// UDP-Socket ohne Netzwerk (nur für die Schnittstelle; SNTP läuft über AsyncUDP)
+class UDP {
+public:
+    virtual ~UDP() {}
+};
+
+class WiFiUDP : public UDP {
+public:
+    uint8_t begin(uint16_t port) { (void)port; return 1; }
+    void stop() {}
+    int beginPacket(const char* host, uint16_t port) { (void)host; (void)port; return 1; }
+    int endPacket() { return 1; }
+    size_t write(const uint8_t* buf, size_t size) { (void)buf; return size; }
+    int parsePacket() { return 0; }
+    int read(uint8_t* buf, size_t size) { (void)buf; (void)size; return 0; }
+};
+
+#endif
@@ -0,0 +1,169 @@
+#include "Wire.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire() : txAddress(0), txLength(0), rxLength(0), rxIndex(0),
+                     frequency(100000), transactions(0), sdaPin(-1), sclPin(-1), begun(false),
+                     busTiming(false), timingRemainder(0), stuckClocks(0), sclLow(false) {
+    memset(devices, 0, sizeof(devices));
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t freq) {
+    sdaPin = sda;
+    sclPin = scl;
+    begun = true;
+    // Wie der ESP32-Treiber: interne Pull-ups an beiden Leitungen
+    if (sda >= 0) pinMode(sda, INPUT_PULLUP);
+    if (scl >= 0) pinMode(scl, INPUT_PULLUP);
+    if (freq != 0) {
+        frequency = freq;
+    }
+    return true;
+}
+
+// Adresse bzw. Daten je 9 Takte (inkl. ACK), Start und Stop je ein Takt
+void TwoWire::spendBusTime(size_t bytes) {
+    if (!busTiming) {
+        return;
+    }
+    timingRemainder += (bytes * 9 + 2) * 1000000ULL;
+    uint64_t us = timingRemainder / frequency;
+    timingRemainder -= us * frequency;
+    NativeClock::advanceMicros(us);
+}
+
+void TwoWire::holdSda(uint16_t clocks) {
+    stuckClocks = clocks;
+    sclLow = false;
+    nativeAttachPinModel(clocks > 0 ? this : nullptr);
+}
+
+// SCL-Takte per GPIO zählen nur, solange der I2C-Treiber die Pins nicht hat
+void TwoWire::onPinWrite(uint8_t pin, uint8_t val) {
+    if (stuckClocks == 0 || begun || (int)pin != sclPin) {
+        return;
+    }
+    if (val == LOW) {
+        sclLow = true;
+    } else if (sclLow) {
+        sclLow = false;
+        if (--stuckClocks == 0) {
+            nativeAttachPinModel(nullptr);
+        }
+    }
+}
+
+bool TwoWire::readPin(uint8_t pin, int& level) {
+    if (stuckClocks == 0 || (int)pin != sdaPin) {
+        return false;
+    }
+    level = LOW;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    txAddress = address & 0x7F;
+    txLength = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    transactions++;
+
+    Device& dev = devices[txAddress];
+    dev.transactions++;
+    dev.bytes += 1 + txLength;
+    if (stuckClocks > 0) {
+        return 5;  // Timeout: Start-Bedingung nicht möglich
+    }
+    spendBusTime(1 + txLength);
+    if (!dev.present) {
+        return 2;  // NACK auf Adresse (wie Arduino-Core)
+    }
+
+    if (txLength > 0) {
+        dev.pointer = txBuffer[0];
+        for (size_t i = 1; i < txLength; i++) {
+            uint8_t reg = dev.pointer++;
+            dev.registers[reg] = txBuffer[i];
+            if (dev.model) {
+                dev.model->onWrite(reg, txBuffer[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (txLength >= sizeof(txBuffer)) {
+        return 0;
+    }
+    txBuffer[txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t length) {
+    size_t written = 0;
+    while (written < length && write(data[written])) {
+        written++;
+    }
+    return written;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+    (void)sendStop;
+    transactions++;
+
+    rxLength = 0;
+    rxIndex = 0;
+
+    Device& dev = devices[address & 0x7F];
+    dev.transactions++;
+    dev.bytes++;
+    if (stuckClocks > 0) {
+        return 0;
+    }
+    if (!dev.present) {
+        spendBusTime(1);
+        return 0;
+    }
+
+    if (quantity > sizeof(rxBuffer)) {
+        quantity = sizeof(rxBuffer);
+    }
+    dev.bytes += quantity;
+    spendBusTime(1 + quantity);
+    for (uint8_t i = 0; i < quantity; i++) {
+        uint8_t reg = dev.pointer;
+        uint8_t value = dev.registers[reg];
+        if (dev.model) {
+            dev.model->onRead(reg, value);
+            if (dev.model->isStreamRegister(reg)) {
+                dev.pointer--;
+            }
+        }
+        rxBuffer[rxLength++] = value;
+        dev.pointer++;
+    }
+    return quantity;
+}
+
+void TwoWire::attachDevice(uint8_t address) {
+    devices[address & 0x7F].present = true;
+}
+
+void TwoWire::detachDevice(uint8_t address) {
+    devices[address & 0x7F].present = false;
+}
+
+void TwoWire::attachModel(uint8_t address, I2CDeviceModel* model) {
+    devices[address & 0x7F].model = model;
+}
+
+void TwoWire::setRegister(uint8_t address, uint8_t reg, uint8_t value) {
+    devices[address & 0x7F].registers[reg] = value;
+}
+
+uint8_t TwoWire::getRegister(uint8_t address, uint8_t reg) const {
+    return devices[address & 0x7F].registers[reg];
+}
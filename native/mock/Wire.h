@@ -0,0 +1,97 @@
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+
+#include <Arduino.h>
+
+#define NATIVE_I2C_BUFFER_LENGTH 128
+
+// ===== Verhaltensmodell für Register mit Seiteneffekten =====
+// Optional pro Gerät (z.B. FIFO des MPU9250). Ohne Modell verhält sich
+// ein Gerät wie eine reine Registerdatei.
+class I2CDeviceModel {
+public:
+    virtual ~I2CDeviceModel() {}
+    // Nach dem Schreiben eines Registers
+    virtual void onWrite(uint8_t reg, uint8_t value) { (void)reg; (void)value; }
+    // true = value wurde vom Modell geliefert
+    virtual bool onRead(uint8_t reg, uint8_t& value) { (void)reg; (void)value; return false; }
+    // true = Registerzeiger bleibt beim Lesen stehen (FIFO-Datenregister)
+    virtual bool isStreamRegister(uint8_t reg) { (void)reg; return false; }
+};
+
+// ===== I2C-Bus für den Host-Build =====
+// Jedes Gerät wird als 256-Byte Registerdatei modelliert:
+// das erste geschriebene Byte setzt den Registerzeiger, weitere Bytes
+// werden ab dort geschrieben, requestFrom() liest mit Auto-Inkrement.
+// Transaktionen werden gezählt, damit Benchmarks die Buslast ausweisen.
+// Optional kostet der Bus simulierte Zeit (9 Takte je Byte plus Start/
+// Stop), und ein Slave kann SDA festhalten, bis genug SCL-Takte per
+// digitalWrite() kommen (Bus-Recovery).
+class TwoWire : public NativePinModel {
+private:
+    struct Device {
+        bool present;
+        uint8_t pointer;
+        uint8_t registers[256];
+        I2CDeviceModel* model;
+        uint64_t transactions;
+        uint64_t bytes;           // Adresse + Daten, für die Busdauer
+    };
+
+    Device devices[128];
+    uint8_t txAddress;
+    uint8_t txBuffer[NATIVE_I2C_BUFFER_LENGTH];
+    size_t txLength;
+    uint8_t rxBuffer[NATIVE_I2C_BUFFER_LENGTH];
+    size_t rxLength;
+    size_t rxIndex;
+    uint32_t frequency;
+    uint64_t transactions;
+    int sdaPin;
+    int sclPin;
+    bool begun;
+    bool busTiming;
+    uint64_t timingRemainder;     // Bits · 10^6, noch nicht als µs vergangen
+    uint16_t stuckClocks;         // SDA low, bis so viele SCL-Takte kamen
+    bool sclLow;
+
+    void spendBusTime(size_t bytes);
+
+public:
+    TwoWire();
+
+    bool begin(int sda = -1, int scl = -1, uint32_t freq = 0);
+    bool end() { begun = false; return true; }
+    bool setClock(uint32_t freq) { frequency = freq; return true; }
+    uint32_t getClock() const { return frequency; }
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t length);
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+    int available() { return (int)(rxLength - rxIndex); }
+    int read() { return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1; }
+
+    // Nur im Host-Build vorhanden
+    void attachDevice(uint8_t address);
+    void detachDevice(uint8_t address);
+    void attachModel(uint8_t address, I2CDeviceModel* model);
+    void setRegister(uint8_t address, uint8_t reg, uint8_t value);
+    uint8_t getRegister(uint8_t address, uint8_t reg) const;
+    uint64_t getTransactionCount() const { return transactions; }
+    uint64_t getTransactionCount(uint8_t address) const { return devices[address & 0x7F].transactions; }
+    uint64_t getByteCount(uint8_t address) const { return devices[address & 0x7F].bytes; }
+    void setBusTiming(bool enabled) { busTiming = enabled; }
+    // Slave hält SDA low (z.B. Reset mitten in einem Lesezugriff); 0 = freigeben
+    void holdSda(uint16_t clocks);
+    bool isSdaHeld() const { return stuckClocks > 0; }
+
+    void onPinWrite(uint8_t pin, uint8_t val) override;
+    bool readPin(uint8_t pin, int& level) override;
+};
+
+extern TwoWire Wire;
+
+#endif
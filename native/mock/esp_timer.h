@@ -0,0 +1,11 @@
+#ifndef NATIVE_ESP_TIMER_H
+#define NATIVE_ESP_TIMER_H
+
+#include <Arduino.h>
+
+// Monotone 64-Bit-Zeit in µs seit dem Start, hier aus der simulierten Uhr
+inline int64_t esp_timer_get_time() {
+    return (int64_t)NativeClock::nowMicros();
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef NATIVE_MBEDTLS_BASE64_H
+#define NATIVE_MBEDTLS_BASE64_H
+
+#include <stddef.h>
+
+#define MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL  -0x002A
+#define MBEDTLS_ERR_BASE64_INVALID_CHARACTER -0x002C
+
+// Gleiche Semantik wie mbedTLS: mit dst == NULL wird nur die
+// benötigte Länge in *olen gemeldet (Rückgabe BUFFER_TOO_SMALL).
+int mbedtls_base64_encode(unsigned char* dst, size_t dlen, size_t* olen,
+                          const unsigned char* src, size_t slen);
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen,
+                          const unsigned char* src, size_t slen);
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef NATIVE_MBEDTLS_ERROR_H
+#define NATIVE_MBEDTLS_ERROR_H
+
+#include <stddef.h>
+
+// Nur der Fehlercode als Text, ohne die Meldungstabelle von mbedTLS
+void mbedtls_strerror(int errnum, char* buffer, size_t buflen);
+
+#endif
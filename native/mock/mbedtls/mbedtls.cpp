@@ -0,0 +1,282 @@
+// ===== mbedTLS-Ersatz für den Host-Build =====
+// Eigenständige Implementierung von Base64, SHA-256 und HMAC-SHA256
+// (FIPS 180-4, RFC 2104, RFC 4648). Keine Abhängigkeit zu einer
+// installierten mbedTLS-Bibliothek auf dem CI-Host.
+
+#include "base64.h"
+#include "md.h"
+#include "sha256.h"
+#include <string.h>
+
+// ===== Base64 =====
+static const char BASE64_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int mbedtls_base64_encode(unsigned char* dst, size_t dlen, size_t* olen,
+                          const unsigned char* src, size_t slen) {
+    size_t needed = 4 * ((slen + 2) / 3);
+    *olen = needed + 1;  // mbedTLS zählt den Null-Terminator mit
+    if (dst == NULL || dlen < needed + 1) {
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+
+    size_t out = 0;
+    for (size_t i = 0; i < slen; i += 3) {
+        uint32_t block = (uint32_t)src[i] << 16;
+        if (i + 1 < slen) block |= (uint32_t)src[i + 1] << 8;
+        if (i + 2 < slen) block |= src[i + 2];
+
+        dst[out++] = BASE64_ALPHABET[(block >> 18) & 0x3F];
+        dst[out++] = BASE64_ALPHABET[(block >> 12) & 0x3F];
+        dst[out++] = (i + 1 < slen) ? BASE64_ALPHABET[(block >> 6) & 0x3F] : '=';
+        dst[out++] = (i + 2 < slen) ? BASE64_ALPHABET[block & 0x3F] : '=';
+    }
+    dst[out] = 0;
+    *olen = out;
+    return 0;
+}
+
+static int base64Value(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen,
+                          const unsigned char* src, size_t slen) {
+    size_t padding = 0;
+    size_t symbols = 0;
+    for (size_t i = 0; i < slen; i++) {
+        if (src[i] == '=') {
+            padding++;
+        } else if (base64Value(src[i]) < 0 || padding > 0) {
+            return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+        }
+        symbols++;
+    }
+    if (symbols % 4 != 0 || padding > 2) {
+        return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    }
+
+    size_t needed = (symbols / 4) * 3 - padding;
+    *olen = needed;
+    if (dst == NULL || dlen < needed) {
+        return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+    }
+
+    size_t out = 0;
+    uint32_t block = 0;
+    int count = 0;
+    for (size_t i = 0; i < slen; i++) {
+        if (src[i] == '=') {
+            break;
+        }
+        block = (block << 6) | (uint32_t)base64Value(src[i]);
+        if (++count == 4) {
+            dst[out++] = (block >> 16) & 0xFF;
+            dst[out++] = (block >> 8) & 0xFF;
+            dst[out++] = block & 0xFF;
+            block = 0;
+            count = 0;
+        }
+    }
+    if (count == 3) {
+        block <<= 6;
+        dst[out++] = (block >> 16) & 0xFF;
+        dst[out++] = (block >> 8) & 0xFF;
+    } else if (count == 2) {
+        block <<= 12;
+        dst[out++] = (block >> 16) & 0xFF;
+    }
+    *olen = out;
+    return 0;
+}
+
+// ===== SHA-256 =====
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static void sha256Process(mbedtls_sha256_context* ctx, const unsigned char data[64]) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)data[4 * i] << 24) | ((uint32_t)data[4 * i + 1] << 16) |
+               ((uint32_t)data[4 * i + 2] << 8) | data[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = ctx->state[0], b = ctx->state[1], c = ctx->state[2], d = ctx->state[3];
+    uint32_t e = ctx->state[4], f = ctx->state[5], g = ctx->state[6], h = ctx->state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + K[i] + w[i];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    ctx->state[0] += a; ctx->state[1] += b; ctx->state[2] += c; ctx->state[3] += d;
+    ctx->state[4] += e; ctx->state[5] += f; ctx->state[6] += g; ctx->state[7] += h;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx) {
+    if (ctx != NULL) {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context* dst, const mbedtls_sha256_context* src) {
+    *dst = *src;
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224) {
+    static const uint32_t IV[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    ctx->total[0] = ctx->total[1] = 0;
+    memcpy(ctx->state, IV, sizeof(IV));
+    ctx->is224 = is224;
+    return is224 ? -1 : 0;  // SHA-224 wird hier nicht benötigt
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t ilen) {
+    size_t fill = ctx->total[0] & 0x3F;
+    ctx->total[0] += (uint32_t)ilen;
+    if (ctx->total[0] < (uint32_t)ilen) {
+        ctx->total[1]++;
+    }
+
+    if (fill && ilen >= 64 - fill) {
+        memcpy(ctx->buffer + fill, input, 64 - fill);
+        sha256Process(ctx, ctx->buffer);
+        input += 64 - fill;
+        ilen -= 64 - fill;
+        fill = 0;
+    }
+    while (ilen >= 64) {
+        sha256Process(ctx, input);
+        input += 64;
+        ilen -= 64;
+    }
+    if (ilen > 0) {
+        memcpy(ctx->buffer + fill, input, ilen);
+    }
+    return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char output[32]) {
+    uint32_t high = (ctx->total[0] >> 29) | (ctx->total[1] << 3);
+    uint32_t low = ctx->total[0] << 3;
+
+    unsigned char lengthBytes[8];
+    for (int i = 0; i < 4; i++) {
+        lengthBytes[i] = (unsigned char)(high >> (24 - 8 * i));
+        lengthBytes[4 + i] = (unsigned char)(low >> (24 - 8 * i));
+    }
+
+    static const unsigned char PADDING[64] = { 0x80 };
+    size_t last = ctx->total[0] & 0x3F;
+    size_t padn = (last < 56) ? (56 - last) : (120 - last);
+    mbedtls_sha256_update(ctx, PADDING, padn);
+    mbedtls_sha256_update(ctx, lengthBytes, 8);
+
+    for (int i = 0; i < 8; i++) {
+        output[4 * i] = (unsigned char)(ctx->state[i] >> 24);
+        output[4 * i + 1] = (unsigned char)(ctx->state[i] >> 16);
+        output[4 * i + 2] = (unsigned char)(ctx->state[i] >> 8);
+        output[4 * i + 3] = (unsigned char)(ctx->state[i]);
+    }
+    return 0;
+}
+
+// ===== HMAC-SHA256 über die md-Schnittstelle =====
+static const mbedtls_md_info_t SHA256_INFO = { MBEDTLS_MD_SHA256, 32 };
+
+const mbedtls_md_info_t* mbedtls_md_info_from_type(mbedtls_md_type_t md_type) {
+    return md_type == MBEDTLS_MD_SHA256 ? &SHA256_INFO : NULL;
+}
+
+void mbedtls_md_init(mbedtls_md_context_t* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_md_free(mbedtls_md_context_t* ctx) {
+    if (ctx != NULL) {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
+
+int mbedtls_md_setup(mbedtls_md_context_t* ctx, const mbedtls_md_info_t* md_info, int hmac) {
+    if (md_info == NULL) {
+        return -1;
+    }
+    ctx->md_info = md_info;
+    ctx->hmac = hmac;
+    return 0;
+}
+
+int mbedtls_md_hmac_starts(mbedtls_md_context_t* ctx, const unsigned char* key, size_t keylen) {
+    unsigned char keyBlock[64];
+    memset(keyBlock, 0, sizeof(keyBlock));
+
+    if (keylen > 64) {
+        mbedtls_sha256_context tmp;
+        mbedtls_sha256_init(&tmp);
+        mbedtls_sha256_starts(&tmp, 0);
+        mbedtls_sha256_update(&tmp, key, keylen);
+        mbedtls_sha256_finish(&tmp, keyBlock);
+    } else if (keylen > 0) {
+        memcpy(keyBlock, key, keylen);
+    }
+
+    unsigned char ipad[64];
+    unsigned char opad[64];
+    for (int i = 0; i < 64; i++) {
+        ipad[i] = keyBlock[i] ^ 0x36;
+        opad[i] = keyBlock[i] ^ 0x5C;
+    }
+
+    mbedtls_sha256_starts(&ctx->inner, 0);
+    mbedtls_sha256_update(&ctx->inner, ipad, 64);
+    mbedtls_sha256_starts(&ctx->outer, 0);
+    mbedtls_sha256_update(&ctx->outer, opad, 64);
+    return 0;
+}
+
+int mbedtls_md_hmac_update(mbedtls_md_context_t* ctx, const unsigned char* input, size_t ilen) {
+    return mbedtls_sha256_update(&ctx->inner, input, ilen);
+}
+
+int mbedtls_md_hmac_finish(mbedtls_md_context_t* ctx, unsigned char* output) {
+    unsigned char innerHash[32];
+    mbedtls_sha256_finish(&ctx->inner, innerHash);
+    mbedtls_sha256_update(&ctx->outer, innerHash, sizeof(innerHash));
+    return mbedtls_sha256_finish(&ctx->outer, output);
+}
@@ -0,0 +1,33 @@
+#ifndef NATIVE_MBEDTLS_MD_H
+#define NATIVE_MBEDTLS_MD_H
+
+#include <stddef.h>
+#include "sha256.h"
+
+// Nur SHA-256 (HMAC) wird unterstützt – mehr braucht SASToken nicht
+typedef enum {
+    MBEDTLS_MD_NONE = 0,
+    MBEDTLS_MD_SHA256 = 6
+} mbedtls_md_type_t;
+
+typedef struct mbedtls_md_info_t {
+    mbedtls_md_type_t type;
+    unsigned char size;
+} mbedtls_md_info_t;
+
+typedef struct mbedtls_md_context_t {
+    const mbedtls_md_info_t* md_info;
+    mbedtls_sha256_context inner;
+    mbedtls_sha256_context outer;
+    int hmac;
+} mbedtls_md_context_t;
+
+const mbedtls_md_info_t* mbedtls_md_info_from_type(mbedtls_md_type_t md_type);
+void mbedtls_md_init(mbedtls_md_context_t* ctx);
+void mbedtls_md_free(mbedtls_md_context_t* ctx);
+int mbedtls_md_setup(mbedtls_md_context_t* ctx, const mbedtls_md_info_t* md_info, int hmac);
+int mbedtls_md_hmac_starts(mbedtls_md_context_t* ctx, const unsigned char* key, size_t keylen);
+int mbedtls_md_hmac_update(mbedtls_md_context_t* ctx, const unsigned char* input, size_t ilen);
+int mbedtls_md_hmac_finish(mbedtls_md_context_t* ctx, unsigned char* output);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef NATIVE_MBEDTLS_NET_SOCKETS_H
+#define NATIVE_MBEDTLS_NET_SOCKETS_H
+
+// Nur die Fehlercodes; die Verbindung läuft über WiFiClient
+#define MBEDTLS_ERR_NET_CONNECT_FAILED -0x0044
+#define MBEDTLS_ERR_NET_RECV_FAILED    -0x004C
+#define MBEDTLS_ERR_NET_SEND_FAILED    -0x004E
+#define MBEDTLS_ERR_NET_CONN_RESET     -0x0050
+
+#endif
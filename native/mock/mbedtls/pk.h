@@ -0,0 +1,18 @@
+#ifndef NATIVE_MBEDTLS_PK_H
+#define NATIVE_MBEDTLS_PK_H
+
+#include <stddef.h>
+
+#define MBEDTLS_ERR_PK_KEY_INVALID_FORMAT -0x3D00
+
+typedef struct mbedtls_pk_context {
+    int loaded;
+} mbedtls_pk_context;
+
+void mbedtls_pk_init(mbedtls_pk_context* ctx);
+void mbedtls_pk_free(mbedtls_pk_context* ctx);
+// Signatur von mbedTLS 2.x (ohne RNG-Parameter)
+int mbedtls_pk_parse_key(mbedtls_pk_context* ctx, const unsigned char* key, size_t keylen,
+                         const unsigned char* pwd, size_t pwdlen);
+
+#endif
@@ -0,0 +1,522 @@
+// ===== TLS-Attrappe: Handshake-Zustandsautomat mit simuliertem Server =====
+// Kosten je Schritt als Richtwerte für ESP32 @ 240 MHz, mbedTLS 2.28 mit
+// Hardware-RSA/SHA und Software-ECC (P-256), Server-Kette mit 2048-Bit-RSA.
+// Heap: IDF-Standardpuffer (16 KB Eingang, 4 KB Ausgang) plus geparste
+// Zertifikatskette und ECDHE-Kontext während des vollständigen Handshakes.
+
+#include <Arduino.h>
+#include <deque>
+#include <string>
+#include "ctr_drbg.h"
+#include "entropy.h"
+#include "error.h"
+#include "pk.h"
+#include "ssl.h"
+#include "x509_crt.h"
+
+namespace {
+
+const uint32_t IO_BUFFER_BYTES = 16384 + 4096 + 2 * 333;   // Records + Header/MAC-Reserve
+const uint32_t CERT_CHAIN_BYTES = 9200;    // Geparste Server-Kette (Blatt mit vielen SANs)
+const uint32_t PEER_CERT_BYTES = 2300;     // Bleibt in der Session (KEEP_PEER_CERTIFICATE)
+const uint32_t ECDHE_BYTES = 3100;         // ECP-Gruppe, Schlüsselpaar, Zwischenwerte
+
+const uint32_t CERT_VERIFY_US = 95000;     // Kette parsen + RSA-Signaturen prüfen
+const uint32_t SKE_VERIFY_US = 12000;      // Signatur der ServerKeyExchange
+const uint32_t ECDHE_US = 150000;          // Schlüsselpaar + gemeinsames Geheimnis
+const uint32_t CLIENT_SIGN_US = 40000;     // Nur mit Client-Zertifikat (X.509)
+const uint32_t PRF_US = 2000;              // Schlüsselableitung, Finished-Prüfung
+
+const uint32_t SESSION_MAGIC = 0x53455353;            // "SESS"
+const size_t SESSION_SAVE_BYTES = 64 + PEER_CERT_BYTES;  // Inkl. Server-Zertifikat (DER)
+
+// Simulierter Server
+uint32_t serverGeneration = 1;
+uint32_t lastTicketId = 0;
+bool resumptionEnabled = true;
+uint64_t ticketLifetimeMicros = 7200ULL * 1000000ULL;   // 2 h
+uint32_t roundTripMs = 40;
+uint32_t fullHandshakes = 0;
+uint32_t resumedHandshakes = 0;
+
+// MQTT-Broker hinter dem Server: bestätigt QoS-1-PUBLISH nach einer
+// Round-Trip mit PUBACK. Erwartet ein Paket je Schreibaufruf (wie
+// PubSubClient-Attrappe und MqttQos1Publisher schreiben).
+struct BrokerReply {
+    uint64_t dueMicros;
+    unsigned char bytes[4];
+};
+std::deque<BrokerReply> brokerReplies;
+std::string brokerInbound;        // Fällige Bytes, bereit für mbedtls_ssl_read()
+uint32_t pubackLossEvery = 0;
+uint32_t qos1Received = 0;
+uint32_t qos1Duplicates = 0;
+uint64_t qos1PayloadBytes = 0;
+
+void holdHeap(uint32_t& field, uint32_t bytes) {
+    ESP.simulateHeapUse((int32_t)bytes - (int32_t)field);
+    field = bytes;
+}
+
+void sendFlight(mbedtls_ssl_context* ssl, size_t bytes) {
+    static const unsigned char filler[512] = { 0 };
+    while (bytes > 0 && ssl->f_send) {
+        size_t chunk = bytes < sizeof(filler) ? bytes : sizeof(filler);
+        ssl->f_send(ssl->p_bio, filler, chunk);
+        bytes -= chunk;
+    }
+}
+
+void waitRoundTrip() {
+    NativeClock::advanceMicros((uint64_t)roundTripMs * 1000ULL);
+}
+
+void brokerReceive(const unsigned char* buf, size_t len) {
+    if (len < 2 || (buf[0] & 0xF6) != 0x32) {
+        return;   // Nur PUBLISH mit QoS 1
+    }
+    size_t pos = 1;
+    size_t remaining = 0;
+    for (int shift = 0; pos < len && shift <= 21; shift += 7) {
+        remaining |= (size_t)(buf[pos] & 0x7F) << shift;
+        if (!(buf[pos++] & 0x80)) break;
+    }
+    if (pos + remaining != len || remaining < 4) {
+        return;
+    }
+    size_t topicLength = ((size_t)buf[pos] << 8) | buf[pos + 1];
+    size_t idAt = pos + 2 + topicLength;
+    if (idAt + 2 > len) {
+        return;
+    }
+    qos1Received++;
+    qos1PayloadBytes += len - idAt - 2;
+    if (buf[0] & 0x08) {
+        qos1Duplicates++;
+    }
+    if (pubackLossEvery > 0 && qos1Received % pubackLossEvery == 0) {
+        return;   // PUBLISH oder PUBACK verloren
+    }
+    BrokerReply reply = { NativeClock::nowMicros() + (uint64_t)roundTripMs * 1000ULL,
+                          { 0x40, 0x02, buf[idAt], buf[idAt + 1] } };
+    brokerReplies.push_back(reply);
+}
+
+void brokerDeliver() {
+    while (!brokerReplies.empty() && brokerReplies.front().dueMicros <= NativeClock::nowMicros()) {
+        brokerInbound.append((const char*)brokerReplies.front().bytes, sizeof(brokerReplies.front().bytes));
+        brokerReplies.pop_front();
+    }
+}
+
+bool ticketAccepted(const mbedtls_ssl_session& offered) {
+    return resumptionEnabled && offered.ticket_id != 0 &&
+           offered.server_generation == serverGeneration &&
+           offered.ticket_id <= lastTicketId &&
+           NativeClock::nowMicros() - offered.issued_micros < ticketLifetimeMicros;
+}
+
+void putU32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24); p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);  p[3] = (unsigned char)v;
+}
+
+uint32_t getU32(const unsigned char* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+}  // namespace
+
+// ===== Fehlertexte, Zufall, Zertifikate =====
+void mbedtls_strerror(int errnum, char* buffer, size_t buflen) {
+    snprintf(buffer, buflen, "mbedTLS -0x%04X", (unsigned)(errnum < 0 ? -errnum : errnum));
+}
+
+void mbedtls_entropy_init(mbedtls_entropy_context* ctx) { ctx->initialized = 1; }
+void mbedtls_entropy_free(mbedtls_entropy_context* ctx) { ctx->initialized = 0; }
+
+int mbedtls_entropy_func(void* data, unsigned char* output, size_t len) {
+    (void)data;
+    for (size_t i = 0; i < len; i++) output[i] = (unsigned char)random(256);
+    return 0;
+}
+
+void mbedtls_ctr_drbg_init(mbedtls_ctr_drbg_context* ctx) { ctx->seeded = 0; }
+void mbedtls_ctr_drbg_free(mbedtls_ctr_drbg_context* ctx) { ctx->seeded = 0; }
+
+int mbedtls_ctr_drbg_seed(mbedtls_ctr_drbg_context* ctx,
+                          int (*f_entropy)(void*, unsigned char*, size_t), void* p_entropy,
+                          const unsigned char* custom, size_t len) {
+    (void)custom;
+    (void)len;
+    unsigned char seed[32];
+    int ret = f_entropy(p_entropy, seed, sizeof(seed));
+    ctx->seeded = ret == 0;
+    return ret;
+}
+
+int mbedtls_ctr_drbg_random(void* p_rng, unsigned char* output, size_t output_len) {
+    mbedtls_ctr_drbg_context* ctx = (mbedtls_ctr_drbg_context*)p_rng;
+    if (!ctx || !ctx->seeded) return -0x0034;   // MBEDTLS_ERR_CTR_DRBG_ENTROPY_SOURCE_FAILED
+    return mbedtls_entropy_func(nullptr, output, output_len);
+}
+
+void mbedtls_x509_crt_init(mbedtls_x509_crt* crt) { memset(crt, 0, sizeof(*crt)); }
+void mbedtls_x509_crt_free(mbedtls_x509_crt* crt) { memset(crt, 0, sizeof(*crt)); }
+
+int mbedtls_x509_crt_parse(mbedtls_x509_crt* chain, const unsigned char* buf, size_t buflen) {
+    if (!buf || buflen == 0 || !strstr((const char*)buf, "-----BEGIN CERTIFICATE-----")) {
+        return MBEDTLS_ERR_X509_INVALID_FORMAT;
+    }
+    chain->version = 3;
+    chain->raw_len = buflen;
+    return 0;
+}
+
+void mbedtls_pk_init(mbedtls_pk_context* ctx) { ctx->loaded = 0; }
+void mbedtls_pk_free(mbedtls_pk_context* ctx) { ctx->loaded = 0; }
+
+int mbedtls_pk_parse_key(mbedtls_pk_context* ctx, const unsigned char* key, size_t keylen,
+                         const unsigned char* pwd, size_t pwdlen) {
+    (void)pwd;
+    (void)pwdlen;
+    if (!key || keylen == 0 || !strstr((const char*)key, "-----BEGIN")) {
+        return MBEDTLS_ERR_PK_KEY_INVALID_FORMAT;
+    }
+    ctx->loaded = 1;
+    return 0;
+}
+
+// ===== Konfiguration =====
+void mbedtls_ssl_config_init(mbedtls_ssl_config* conf) { memset(conf, 0, sizeof(*conf)); }
+void mbedtls_ssl_config_free(mbedtls_ssl_config* conf) { memset(conf, 0, sizeof(*conf)); }
+
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config* conf, int endpoint, int transport, int preset) {
+    (void)transport;
+    (void)preset;
+    conf->endpoint = endpoint;
+    conf->authmode = MBEDTLS_SSL_VERIFY_REQUIRED;
+    conf->session_tickets = MBEDTLS_SSL_SESSION_TICKETS_ENABLED;
+    return 0;
+}
+
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config* conf, int authmode) { conf->authmode = authmode; }
+
+void mbedtls_ssl_conf_ca_chain(mbedtls_ssl_config* conf, mbedtls_x509_crt* ca_chain, void* ca_crl) {
+    (void)ca_crl;
+    conf->ca_chain = ca_chain;
+}
+
+int mbedtls_ssl_conf_own_cert(mbedtls_ssl_config* conf, mbedtls_x509_crt* own_cert, mbedtls_pk_context* pk_key) {
+    if (!own_cert || own_cert->version == 0 || !pk_key || !pk_key->loaded) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+    conf->own_cert = own_cert;
+    return 0;
+}
+
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config* conf, int (*f_rng)(void*, unsigned char*, size_t), void* p_rng) {
+    conf->f_rng = f_rng;
+    conf->p_rng = p_rng;
+}
+
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config* conf, int use_tickets) {
+    conf->session_tickets = use_tickets;
+}
+
+// ===== Sessions =====
+void mbedtls_ssl_session_init(mbedtls_ssl_session* session) { memset(session, 0, sizeof(*session)); }
+void mbedtls_ssl_session_free(mbedtls_ssl_session* session) { memset(session, 0, sizeof(*session)); }
+
+int mbedtls_ssl_get_session(const mbedtls_ssl_context* ssl, mbedtls_ssl_session* dst) {
+    if (ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER || ssl->session.ticket_id == 0) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+    *dst = ssl->session;
+    return 0;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context* ssl, const mbedtls_ssl_session* session) {
+    if (!ssl->conf || ssl->state != MBEDTLS_SSL_HELLO_REQUEST) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+    ssl->session_negotiate = *session;
+    return 0;
+}
+
+int mbedtls_ssl_session_save(const mbedtls_ssl_session* session, unsigned char* buf, size_t buf_len, size_t* olen) {
+    *olen = SESSION_SAVE_BYTES;
+    if (!buf || buf_len < SESSION_SAVE_BYTES) {
+        return MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL;
+    }
+    memset(buf, 0xA5, SESSION_SAVE_BYTES);   // Platzhalter für Master Secret und Zertifikat
+    putU32(buf, SESSION_MAGIC);
+    putU32(buf + 4, session->ticket_id);
+    putU32(buf + 8, session->server_generation);
+    putU32(buf + 12, (uint32_t)(session->issued_micros >> 32));
+    putU32(buf + 16, (uint32_t)session->issued_micros);
+    return 0;
+}
+
+int mbedtls_ssl_session_load(mbedtls_ssl_session* session, const unsigned char* buf, size_t len) {
+    if (len != SESSION_SAVE_BYTES || getU32(buf) != SESSION_MAGIC) {
+        return MBEDTLS_ERR_SSL_VERSION_MISMATCH;
+    }
+    session->ticket_id = getU32(buf + 4);
+    session->server_generation = getU32(buf + 8);
+    session->issued_micros = ((uint64_t)getU32(buf + 12) << 32) | getU32(buf + 16);
+    return 0;
+}
+
+// ===== Verbindung =====
+void mbedtls_ssl_init(mbedtls_ssl_context* ssl) { memset(ssl, 0, sizeof(*ssl)); }
+
+void mbedtls_ssl_free(mbedtls_ssl_context* ssl) {
+    ESP.simulateHeapUse(-(int32_t)(ssl->heap_buffers + ssl->heap_handshake + ssl->heap_peer_cert));
+    memset(ssl, 0, sizeof(*ssl));
+}
+
+int mbedtls_ssl_setup(mbedtls_ssl_context* ssl, const mbedtls_ssl_config* conf) {
+    ssl->conf = conf;
+    ssl->state = MBEDTLS_SSL_HELLO_REQUEST;
+    brokerReplies.clear();   // Neue Verbindung: Antworten der alten sind verloren
+    brokerInbound.clear();
+    holdHeap(ssl->heap_buffers, IO_BUFFER_BYTES);
+    return 0;
+}
+
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context* ssl, const char* hostname) {
+    (void)ssl;
+    return hostname && strlen(hostname) <= 255 ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+}
+
+void mbedtls_ssl_set_bio(mbedtls_ssl_context* ssl, void* p_bio, mbedtls_ssl_send_t* f_send,
+                         mbedtls_ssl_recv_t* f_recv, mbedtls_ssl_recv_timeout_t* f_recv_timeout) {
+    (void)f_recv_timeout;
+    ssl->p_bio = p_bio;
+    ssl->f_send = f_send;
+    ssl->f_recv = f_recv;
+}
+
+// Ein Schritt wie in ssl_cli.c; state ist jeweils der nächste Schritt
+int mbedtls_ssl_handshake_step(mbedtls_ssl_context* ssl) {
+    if (!ssl->conf || !ssl->f_send) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+
+    switch (ssl->state) {
+        case MBEDTLS_SSL_HELLO_REQUEST:
+            ssl->state = MBEDTLS_SSL_CLIENT_HELLO;
+            break;
+
+        case MBEDTLS_SSL_CLIENT_HELLO:
+            sendFlight(ssl, 220 + (ssl->session_negotiate.ticket_id ? 192 : 0));
+            ssl->state = MBEDTLS_SSL_SERVER_HELLO;
+            break;
+
+        case MBEDTLS_SSL_SERVER_HELLO:
+            waitRoundTrip();
+            ssl->resume = ticketAccepted(ssl->session_negotiate);
+            if (ssl->resume) {
+                ssl->session = ssl->session_negotiate;
+                ssl->state = MBEDTLS_SSL_SERVER_CHANGE_CIPHER_SPEC;
+            } else {
+                ssl->state = MBEDTLS_SSL_SERVER_CERTIFICATE;
+            }
+            break;
+
+        case MBEDTLS_SSL_SERVER_CERTIFICATE:
+            holdHeap(ssl->heap_handshake, CERT_CHAIN_BYTES);
+            NativeClock::advanceMicros(CERT_VERIFY_US);
+            if (ssl->conf->authmode == MBEDTLS_SSL_VERIFY_REQUIRED &&
+                (!ssl->conf->ca_chain || ssl->conf->ca_chain->version == 0)) {
+                return MBEDTLS_ERR_X509_CERT_VERIFY_FAILED;
+            }
+            holdHeap(ssl->heap_peer_cert, PEER_CERT_BYTES);
+            ssl->state = MBEDTLS_SSL_SERVER_KEY_EXCHANGE;
+            break;
+
+        case MBEDTLS_SSL_SERVER_KEY_EXCHANGE:
+            NativeClock::advanceMicros(SKE_VERIFY_US);
+            ssl->state = MBEDTLS_SSL_CERTIFICATE_REQUEST;
+            break;
+
+        case MBEDTLS_SSL_CERTIFICATE_REQUEST:
+            ssl->state = MBEDTLS_SSL_SERVER_HELLO_DONE;
+            break;
+
+        case MBEDTLS_SSL_SERVER_HELLO_DONE:
+            ssl->state = MBEDTLS_SSL_CLIENT_CERTIFICATE;
+            break;
+
+        case MBEDTLS_SSL_CLIENT_CERTIFICATE:
+            if (ssl->conf->own_cert) sendFlight(ssl, 1200);
+            ssl->state = MBEDTLS_SSL_CLIENT_KEY_EXCHANGE;
+            break;
+
+        case MBEDTLS_SSL_CLIENT_KEY_EXCHANGE:
+            holdHeap(ssl->heap_handshake, CERT_CHAIN_BYTES + ECDHE_BYTES);
+            NativeClock::advanceMicros(ECDHE_US);
+            sendFlight(ssl, 75);
+            ssl->state = MBEDTLS_SSL_CERTIFICATE_VERIFY;
+            break;
+
+        case MBEDTLS_SSL_CERTIFICATE_VERIFY:
+            if (ssl->conf->own_cert) {
+                NativeClock::advanceMicros(CLIENT_SIGN_US);
+                sendFlight(ssl, 264);
+            }
+            ssl->state = MBEDTLS_SSL_CLIENT_CHANGE_CIPHER_SPEC;
+            break;
+
+        case MBEDTLS_SSL_CLIENT_CHANGE_CIPHER_SPEC:
+            NativeClock::advanceMicros(PRF_US);
+            sendFlight(ssl, 6);
+            ssl->state = MBEDTLS_SSL_CLIENT_FINISHED;
+            break;
+
+        case MBEDTLS_SSL_CLIENT_FINISHED:
+            sendFlight(ssl, 45);
+            if (ssl->resume) {
+                ssl->state = MBEDTLS_SSL_FLUSH_BUFFERS;
+            } else if (ssl->conf->session_tickets && resumptionEnabled) {
+                ssl->state = MBEDTLS_SSL_SERVER_NEW_SESSION_TICKET;
+            } else {
+                ssl->state = MBEDTLS_SSL_SERVER_CHANGE_CIPHER_SPEC;
+            }
+            break;
+
+        case MBEDTLS_SSL_SERVER_NEW_SESSION_TICKET:
+            waitRoundTrip();   // Antwort auf den zweiten Client-Flight
+            ssl->session.ticket_id = ++lastTicketId;
+            ssl->session.server_generation = serverGeneration;
+            ssl->session.issued_micros = NativeClock::nowMicros();
+            ssl->state = MBEDTLS_SSL_SERVER_CHANGE_CIPHER_SPEC;
+            break;
+
+        case MBEDTLS_SSL_SERVER_CHANGE_CIPHER_SPEC:
+            if (!ssl->resume && ssl->session.ticket_id == 0) {
+                waitRoundTrip();   // Ohne Ticket-Nachricht hier auf den Server warten
+            }
+            ssl->state = MBEDTLS_SSL_SERVER_FINISHED;
+            break;
+
+        case MBEDTLS_SSL_SERVER_FINISHED:
+            NativeClock::advanceMicros(PRF_US);
+            ssl->state = ssl->resume ? MBEDTLS_SSL_CLIENT_CHANGE_CIPHER_SPEC : MBEDTLS_SSL_FLUSH_BUFFERS;
+            break;
+
+        case MBEDTLS_SSL_FLUSH_BUFFERS:
+            ssl->state = MBEDTLS_SSL_HANDSHAKE_WRAPUP;
+            break;
+
+        case MBEDTLS_SSL_HANDSHAKE_WRAPUP:
+            holdHeap(ssl->heap_handshake, 0);   // Handshake-Parameter freigeben
+            if (ssl->resume) {
+                resumedHandshakes++;
+            } else {
+                fullHandshakes++;
+            }
+            ssl->state = MBEDTLS_SSL_HANDSHAKE_OVER;
+            break;
+
+        default:
+            return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+    return 0;
+}
+
+int mbedtls_ssl_handshake(mbedtls_ssl_context* ssl) {
+    while (ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        int ret = mbedtls_ssl_handshake_step(ssl);
+        if (ret != 0) return ret;
+    }
+    return 0;
+}
+
+// Der simulierte Server sendet keine Anwendungsdaten
+int mbedtls_ssl_read(mbedtls_ssl_context* ssl, unsigned char* buf, size_t len) {
+    if (ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+    brokerDeliver();
+    if (brokerInbound.empty() || len == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    size_t n = len < brokerInbound.size() ? len : brokerInbound.size();
+    memcpy(buf, brokerInbound.data(), n);
+    brokerInbound.erase(0, n);
+    return (int)n;
+}
+
+int mbedtls_ssl_write(mbedtls_ssl_context* ssl, const unsigned char* buf, size_t len) {
+    if (ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    }
+    brokerReceive(buf, len);
+    return ssl->f_send(ssl->p_bio, buf, len);
+}
+
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context* ssl) {
+    if (ssl->state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        return 0;
+    }
+    brokerDeliver();
+    return brokerInbound.size();
+}
+
+int mbedtls_ssl_close_notify(mbedtls_ssl_context* ssl) {
+    if (ssl->state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+        sendFlight(ssl, 31);
+    }
+    return 0;
+}
+
+// ===== Steuerung des simulierten Servers =====
+namespace NativeTlsServer {
+
+void reset() {
+    serverGeneration++;
+}
+
+void setResumption(bool enabled) {
+    resumptionEnabled = enabled;
+}
+
+void setTicketLifetimeSeconds(uint32_t seconds) {
+    ticketLifetimeMicros = (uint64_t)seconds * 1000000ULL;
+}
+
+void setRoundTripMs(uint32_t ms) {
+    roundTripMs = ms;
+}
+
+uint32_t getFullHandshakes() {
+    return fullHandshakes;
+}
+
+uint32_t getResumedHandshakes() {
+    return resumedHandshakes;
+}
+
+size_t getSavedSessionSize() {
+    return SESSION_SAVE_BYTES;
+}
+
+void setPubackLossEvery(uint32_t n) {
+    pubackLossEvery = n;
+}
+
+uint32_t getQos1Received() {
+    return qos1Received;
+}
+
+uint32_t getQos1Duplicates() {
+    return qos1Duplicates;
+}
+
+uint64_t getQos1PayloadBytes() {
+    return qos1PayloadBytes;
+}
+
+}  // namespace NativeTlsServer
@@ -0,0 +1,135 @@
+#ifndef NATIVE_MBEDTLS_SSL_H
+#define NATIVE_MBEDTLS_SSL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "x509_crt.h"
+#include "pk.h"
+
+// ===== TLS-Attrappe (mbedTLS 2.28 API) =====
+// Bildet den Client-Zustandsautomaten von mbedtls_ssl_handshake_step()
+// mit einem simulierten Server nach: vollständiger Handshake mit
+// Zertifikatsprüfung und ECDHE bzw. abgekürzter Handshake, wenn eine
+// gültige Session (Ticket) angeboten wird. Rechenzeit und Round-Trips
+// laufen über die simulierte Uhr, Puffer und Zertifikate über den
+// simulierten Heap der ESP-Attrappe. Es wird nichts verschlüsselt.
+
+#define MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE -0x7080
+#define MBEDTLS_ERR_SSL_BAD_INPUT_DATA      -0x7100
+#define MBEDTLS_ERR_SSL_CONN_EOF            -0x7280
+#define MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY   -0x7880
+#define MBEDTLS_ERR_SSL_ALLOC_FAILED        -0x7F00
+#define MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL    -0x6A00
+#define MBEDTLS_ERR_SSL_WANT_READ           -0x6900
+#define MBEDTLS_ERR_SSL_WANT_WRITE          -0x6880
+#define MBEDTLS_ERR_SSL_VERSION_MISMATCH    -0x6E80
+
+#define MBEDTLS_SSL_IS_CLIENT 0
+#define MBEDTLS_SSL_TRANSPORT_STREAM 0
+#define MBEDTLS_SSL_PRESET_DEFAULT 0
+#define MBEDTLS_SSL_VERIFY_NONE 0
+#define MBEDTLS_SSL_VERIFY_REQUIRED 2
+#define MBEDTLS_SSL_SESSION_TICKETS_DISABLED 0
+#define MBEDTLS_SSL_SESSION_TICKETS_ENABLED 1
+
+typedef enum {
+    MBEDTLS_SSL_HELLO_REQUEST,
+    MBEDTLS_SSL_CLIENT_HELLO,
+    MBEDTLS_SSL_SERVER_HELLO,
+    MBEDTLS_SSL_SERVER_CERTIFICATE,
+    MBEDTLS_SSL_SERVER_KEY_EXCHANGE,
+    MBEDTLS_SSL_CERTIFICATE_REQUEST,
+    MBEDTLS_SSL_SERVER_HELLO_DONE,
+    MBEDTLS_SSL_CLIENT_CERTIFICATE,
+    MBEDTLS_SSL_CLIENT_KEY_EXCHANGE,
+    MBEDTLS_SSL_CERTIFICATE_VERIFY,
+    MBEDTLS_SSL_CLIENT_CHANGE_CIPHER_SPEC,
+    MBEDTLS_SSL_CLIENT_FINISHED,
+    MBEDTLS_SSL_SERVER_CHANGE_CIPHER_SPEC,
+    MBEDTLS_SSL_SERVER_FINISHED,
+    MBEDTLS_SSL_FLUSH_BUFFERS,
+    MBEDTLS_SSL_HANDSHAKE_WRAPUP,
+    MBEDTLS_SSL_HANDSHAKE_OVER,
+    MBEDTLS_SSL_SERVER_NEW_SESSION_TICKET
+} mbedtls_ssl_states;
+
+typedef int mbedtls_ssl_send_t(void* ctx, const unsigned char* buf, size_t len);
+typedef int mbedtls_ssl_recv_t(void* ctx, unsigned char* buf, size_t len);
+typedef int mbedtls_ssl_recv_timeout_t(void* ctx, unsigned char* buf, size_t len, uint32_t timeout);
+
+typedef struct mbedtls_ssl_session {
+    uint32_t ticket_id;          // 0 = keine Session
+    uint32_t server_generation;  // Server-Neustart macht Tickets ungültig
+    uint64_t issued_micros;
+} mbedtls_ssl_session;
+
+typedef struct mbedtls_ssl_config {
+    int endpoint;
+    int authmode;
+    int session_tickets;
+    const mbedtls_x509_crt* ca_chain;
+    const mbedtls_x509_crt* own_cert;
+    int (*f_rng)(void*, unsigned char*, size_t);
+    void* p_rng;
+} mbedtls_ssl_config;
+
+typedef struct mbedtls_ssl_context {
+    const mbedtls_ssl_config* conf;
+    int state;                   // Nächster Handshake-Schritt (wie mbedTLS 2.x)
+    int resume;
+    mbedtls_ssl_session session_negotiate;
+    mbedtls_ssl_session session;
+    mbedtls_ssl_send_t* f_send;
+    mbedtls_ssl_recv_t* f_recv;
+    void* p_bio;
+    uint32_t heap_buffers;       // Simulierte Allokationen (Bytes)
+    uint32_t heap_handshake;
+    uint32_t heap_peer_cert;
+} mbedtls_ssl_context;
+
+void mbedtls_ssl_init(mbedtls_ssl_context* ssl);
+void mbedtls_ssl_free(mbedtls_ssl_context* ssl);
+int mbedtls_ssl_setup(mbedtls_ssl_context* ssl, const mbedtls_ssl_config* conf);
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context* ssl, const char* hostname);
+void mbedtls_ssl_set_bio(mbedtls_ssl_context* ssl, void* p_bio, mbedtls_ssl_send_t* f_send,
+                         mbedtls_ssl_recv_t* f_recv, mbedtls_ssl_recv_timeout_t* f_recv_timeout);
+int mbedtls_ssl_handshake_step(mbedtls_ssl_context* ssl);
+int mbedtls_ssl_handshake(mbedtls_ssl_context* ssl);
+int mbedtls_ssl_read(mbedtls_ssl_context* ssl, unsigned char* buf, size_t len);
+int mbedtls_ssl_write(mbedtls_ssl_context* ssl, const unsigned char* buf, size_t len);
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context* ssl);
+int mbedtls_ssl_close_notify(mbedtls_ssl_context* ssl);
+
+void mbedtls_ssl_config_init(mbedtls_ssl_config* conf);
+void mbedtls_ssl_config_free(mbedtls_ssl_config* conf);
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config* conf, int endpoint, int transport, int preset);
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config* conf, int authmode);
+void mbedtls_ssl_conf_ca_chain(mbedtls_ssl_config* conf, mbedtls_x509_crt* ca_chain, void* ca_crl);
+int mbedtls_ssl_conf_own_cert(mbedtls_ssl_config* conf, mbedtls_x509_crt* own_cert, mbedtls_pk_context* pk_key);
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config* conf, int (*f_rng)(void*, unsigned char*, size_t), void* p_rng);
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config* conf, int use_tickets);
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session* session);
+void mbedtls_ssl_session_free(mbedtls_ssl_session* session);
+int mbedtls_ssl_get_session(const mbedtls_ssl_context* ssl, mbedtls_ssl_session* dst);
+int mbedtls_ssl_set_session(mbedtls_ssl_context* ssl, const mbedtls_ssl_session* session);
+int mbedtls_ssl_session_save(const mbedtls_ssl_session* session, unsigned char* buf, size_t buf_len, size_t* olen);
+int mbedtls_ssl_session_load(mbedtls_ssl_session* session, const unsigned char* buf, size_t len);
+
+// ===== Simulierter Server (nur im Host-Build) =====
+namespace NativeTlsServer {
+    void reset();                            // Neustart: alle Tickets ungültig
+    void setResumption(bool enabled);        // Server ohne Session-Cache simulieren
+    void setTicketLifetimeSeconds(uint32_t seconds);
+    void setRoundTripMs(uint32_t ms);
+    uint32_t getFullHandshakes();
+    uint32_t getResumedHandshakes();
+    size_t getSavedSessionSize();            // Größe von mbedtls_ssl_session_save()
+    // MQTT-Broker: PUBACK auf QoS-1-PUBLISH nach einer Round-Trip
+    void setPubackLossEvery(uint32_t n);     // Jedes n-te PUBLISH unbestätigt (0 = keins)
+    uint32_t getQos1Received();              // Inkl. Wiederholungen
+    uint32_t getQos1Duplicates();            // Mit DUP-Flag
+    uint64_t getQos1PayloadBytes();
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef NATIVE_MBEDTLS_X509_CRT_H
+#define NATIVE_MBEDTLS_X509_CRT_H
+
+#include <stddef.h>
+
+#define MBEDTLS_ERR_X509_INVALID_FORMAT     -0x2180
+#define MBEDTLS_ERR_X509_CERT_VERIFY_FAILED -0x2700
+
+// Zertifikate werden nur auf das PEM-Format geprüft, nicht dekodiert
+typedef struct mbedtls_x509_crt {
+    int version;                // 0 = leer
+    size_t raw_len;
+} mbedtls_x509_crt;
+
+void mbedtls_x509_crt_init(mbedtls_x509_crt* crt);
+void mbedtls_x509_crt_free(mbedtls_x509_crt* crt);
+int mbedtls_x509_crt_parse(mbedtls_x509_crt* chain, const unsigned char* buf, size_t buflen);
+
+#endif
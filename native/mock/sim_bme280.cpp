@@ -0,0 +1,133 @@
+#include "sim_bme280.h"
+#include "sim_signal.h"
+
+const SimBme280::Coefficients SimBme280::COEFFICIENTS = {
+    27504, 26435, -1000,
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+    75, 362, 0, 313, 50, 30
+};
+
+SimBme280::SimBme280(TwoWire& wire, uint8_t address)
+    : wire(&wire), address(address), recorded(false), noiseState(1) {
+    memset(frame, 0, sizeof(frame));
+    wire.attachModel(address, this);
+    wire.setRegister(address, 0xD0, 0x60);   // Chip-ID
+
+    // 0x88..0xA1 und 0xE1..0xE7, Little Endian (Datenblatt Tabelle 16)
+    const Coefficients& c = COEFFICIENTS;
+    const int words[] = { c.T1, c.T2, c.T3, c.P1, c.P2, c.P3, c.P4, c.P5, c.P6, c.P7, c.P8, c.P9 };
+    for (size_t i = 0; i < 12; i++) {
+        wire.setRegister(address, 0x88 + 2 * i, (uint8_t)(words[i] & 0xFF));
+        wire.setRegister(address, 0x89 + 2 * i, (uint8_t)((words[i] >> 8) & 0xFF));
+    }
+    wire.setRegister(address, 0xA1, (uint8_t)c.H1);
+    wire.setRegister(address, 0xE1, (uint8_t)(c.H2 & 0xFF));
+    wire.setRegister(address, 0xE2, (uint8_t)((c.H2 >> 8) & 0xFF));
+    wire.setRegister(address, 0xE3, (uint8_t)c.H3);
+    wire.setRegister(address, 0xE4, (uint8_t)((c.H4 >> 4) & 0xFF));
+    wire.setRegister(address, 0xE5, (uint8_t)((c.H4 & 0x0F) | ((c.H5 & 0x0F) << 4)));
+    wire.setRegister(address, 0xE6, (uint8_t)((c.H5 >> 4) & 0xFF));
+    wire.setRegister(address, 0xE7, (uint8_t)c.H6);
+}
+
+void SimBme280::setRecordedFrame(const uint8_t* data) {
+    recorded = data != nullptr;
+    if (recorded) {
+        memcpy(frame, data, sizeof(frame));
+    }
+}
+
+// ===== Datenblatt 8.1 =====
+
+double SimBme280::temperature(int32_t adcT, const Coefficients& c, double& tFine) {
+    double var1 = (adcT / 16384.0 - c.T1 / 1024.0) * c.T2;
+    double var2 = (adcT / 131072.0 - c.T1 / 8192.0) * (adcT / 131072.0 - c.T1 / 8192.0) * c.T3;
+    tFine = var1 + var2;
+    return tFine / 5120.0;
+}
+
+double SimBme280::pressure(int32_t adcP, double tFine, const Coefficients& c) {
+    double var1 = tFine / 2.0 - 64000.0;
+    double var2 = var1 * var1 * c.P6 / 32768.0;
+    var2 = var2 + var1 * c.P5 * 2.0;
+    var2 = var2 / 4.0 + c.P4 * 65536.0;
+    var1 = (c.P3 * var1 * var1 / 524288.0 + c.P2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * c.P1;
+    if (var1 == 0.0) {
+        return 0.0;
+    }
+    double p = 1048576.0 - adcP;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = c.P9 * p * p / 2147483648.0;
+    var2 = p * c.P8 / 32768.0;
+    return p + (var1 + var2 + c.P7) / 16.0;
+}
+
+double SimBme280::humidity(int32_t adcH, double tFine, const Coefficients& c) {
+    double h = tFine - 76800.0;
+    h = (adcH - (c.H4 * 64.0 + c.H5 / 16384.0 * h)) *
+        (c.H2 / 65536.0 * (1.0 + c.H6 / 67108864.0 * h * (1.0 + c.H3 / 67108864.0 * h)));
+    h = h * (1.0 - c.H1 * h / 524288.0);
+    return h < 0.0 ? 0.0 : (h > 100.0 ? 100.0 : h);
+}
+
+float SimBme280::noise(float amplitude) {
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return amplitude * ((float)(noiseState >> 8) / 8388608.0f - 1.0f);
+}
+
+// ===== Rohwerte aus den simulierten Messwerten =====
+// Alle drei Kompensationen sind monoton im Rohwert: Bisektion
+void SimBme280::simulateFrame() {
+    const Coefficients& c = COEFFICIENTS;
+    double targetT = SimSignal::bme280Temperature() + noise(0.05f);
+    double targetP = SimSignal::bme280Pressure() + noise(3.0f);
+    double targetH = SimSignal::bme280Humidity() + noise(0.2f);
+    double tFine;
+
+    int32_t low = 0, high = 0xFFFFF;
+    while (low < high) {
+        int32_t mid = (low + high) / 2;
+        if (temperature(mid, c, tFine) < targetT) low = mid + 1; else high = mid;
+    }
+    int32_t adcT = low;
+    temperature(adcT, c, tFine);
+
+    low = 0;
+    high = 0xFFFFF;
+    while (low < high) {   // Druck fällt mit steigendem Rohwert
+        int32_t mid = (low + high) / 2;
+        if (pressure(mid, tFine, c) > targetP) low = mid + 1; else high = mid;
+    }
+    int32_t adcP = low;
+
+    low = 0;
+    high = 0xFFFF;
+    while (low < high) {
+        int32_t mid = (low + high) / 2;
+        if (humidity(mid, tFine, c) < targetH) low = mid + 1; else high = mid;
+    }
+    int32_t adcH = low;
+
+    frame[0] = (uint8_t)(adcP >> 12);
+    frame[1] = (uint8_t)(adcP >> 4);
+    frame[2] = (uint8_t)((adcP & 0x0F) << 4);
+    frame[3] = (uint8_t)(adcT >> 12);
+    frame[4] = (uint8_t)(adcT >> 4);
+    frame[5] = (uint8_t)((adcT & 0x0F) << 4);
+    frame[6] = (uint8_t)(adcH >> 8);
+    frame[7] = (uint8_t)adcH;
+}
+
+// Der Sensor hält die Datenregister während eines Burst-Reads fest; ein
+// neuer Frame entsteht hier mit jedem Lesezugriff, der bei 0xF7 beginnt
+bool SimBme280::onRead(uint8_t reg, uint8_t& value) {
+    if (reg < 0xF7 || reg > 0xFE) {
+        return false;
+    }
+    if (reg == 0xF7 && !recorded) {
+        simulateFrame();
+    }
+    value = frame[reg - 0xF7];
+    return true;
+}
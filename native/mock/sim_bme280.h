@@ -0,0 +1,50 @@
+#ifndef NATIVE_SIM_BME280_H
+#define NATIVE_SIM_BME280_H
+
+#include <Wire.h>
+
+// ===== BME280-Registermodell =====
+// Stellt Chip-ID und Kalibrierdaten bereit (Temperatur und Druck aus dem
+// Rechenbeispiel im Datenblatt, Feuchte typische Werte) und liefert beim
+// Lesen ab 0xF7 einen Messdaten-Frame, dessen Rohwerte nach der
+// Kompensation die simulierten Messwerte ergeben. Die Rohwerte werden mit
+// der Gleitkomma-Kompensation aus dem Datenblatt (8.1) zurückgerechnet –
+// unabhängig von der Ganzzahl-Kompensation im Treiber.
+//
+// Die Adafruit-Attrappe liefert ihre Werte weiterhin direkt; das Modell
+// betrifft nur Zugriffe auf die Register.
+class SimBme280 : public I2CDeviceModel {
+public:
+    struct Coefficients {
+        int T1, T2, T3;
+        int P1, P2, P3, P4, P5, P6, P7, P8, P9;
+        int H1, H2, H3, H4, H5, H6;
+    };
+
+    static const Coefficients COEFFICIENTS;
+
+    // Referenz nach Datenblatt 8.1 (double)
+    static double temperature(int32_t adcT, const Coefficients& c, double& tFine);
+    static double pressure(int32_t adcP, double tFine, const Coefficients& c);
+    static double humidity(int32_t adcH, double tFine, const Coefficients& c);
+
+private:
+    TwoWire* wire;
+    uint8_t address;
+    uint8_t frame[8];
+    bool recorded;             // Fester Frame statt Simulation
+    uint32_t noiseState;       // Eigenes Rauschen, random() der übrigen Attrappen bleibt unberührt
+
+    float noise(float amplitude);
+    void simulateFrame();
+
+public:
+    SimBme280(TwoWire& wire, uint8_t address);
+
+    // Aufgezeichneten Frame (0xF7..0xFE) liefern; nullptr = wieder simulieren
+    void setRecordedFrame(const uint8_t* data);
+
+    bool onRead(uint8_t reg, uint8_t& value) override;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "sim_mpu9250.h"
+#include "sim_signal.h"
+
+static const uint16_t FIFO_SIZE = 512;
+
+SimMpu9250::SimMpu9250(TwoWire& wire, uint8_t address)
+    : wire(&wire), address(address), startMicros(0), framesRead(0), frameIndex(0),
+      latchedCount(0), vibrationHz(120.0f), vibrationG(0.2f) {
+    wire.attachModel(address, this);
+    wire.setRegister(address, 0x75, 0x71);   // WHO_AM_I
+    memset(dataRegisters, 0, sizeof(dataRegisters));
+}
+
+void SimMpu9250::setVibration(float frequencyHz, float amplitudeG) {
+    vibrationHz = frequencyHz;
+    vibrationG = amplitudeG;
+}
+
+uint32_t SimMpu9250::rateHz() const {
+    if (wire->getRegister(address, 0x1D) & 0x08) {
+        return 4000;  // ACCEL_FCHOICE_B: Accel ohne DLPF
+    }
+    return 1000 / (1 + wire->getRegister(address, 0x19));
+}
+
+uint8_t SimMpu9250::frameSize() const {
+    uint8_t fifoEn = wire->getRegister(address, 0x23);
+    return ((fifoEn & 0x08) ? 6 : 0) + ((fifoEn & 0x70) ? 6 : 0);
+}
+
+uint64_t SimMpu9250::framesProduced() const {
+    if (!(wire->getRegister(address, 0x6A) & 0x40) || frameSize() == 0) {
+        return 0;
+    }
+    return (NativeClock::nowMicros() - startMicros) * rateHz() / 1000000ULL;
+}
+
+static void putRaw(uint8_t* out, float value, float scale) {
+    long raw = lroundf(value * scale);
+    if (raw > 32767) raw = 32767;
+    if (raw < -32768) raw = -32768;
+    out[0] = (uint8_t)((uint16_t)raw >> 8);
+    out[1] = (uint8_t)(raw & 0xFF);
+}
+
+// Beschleunigung (g) und Drehrate (°/s) zum Zeitpunkt t (Sekunden)
+void SimMpu9250::signal(double t, float* values) const {
+    float vibration = vibrationG * (float)sin(2.0 * M_PI * vibrationHz * t);
+    values[0] = 0.02f * (float)sin(2.0 * M_PI * 35.0 * t) + SimSignal::noise(0.005f);
+    values[1] = SimSignal::noise(0.005f);
+    values[2] = 1.0f + vibration + SimSignal::noise(0.005f);
+    values[3] = SimSignal::noise(0.3f);
+    values[4] = SimSignal::noise(0.3f);
+    values[5] = SimSignal::noise(0.3f);
+}
+
+// Frame mit Index index (seit Reset) erzeugen, Big Endian, ±16 g / ±2000 °/s
+void SimMpu9250::fillFrame(uint64_t index) {
+    double t = (double)startMicros / 1e6 + (double)index / rateHz();
+    float values[6];
+    signal(t, values);
+
+    uint8_t fifoEn = wire->getRegister(address, 0x23);
+    uint8_t offset = 0;
+    for (int c = 0; c < 6; c++) {
+        bool enabled = c < 3 ? (fifoEn & 0x08) : (fifoEn & 0x70);
+        if (!enabled) continue;
+        putRaw(frame + offset, values[c], c < 3 ? 2048.0f : 16.4f);
+        offset += 2;
+    }
+}
+
+// Momentaufnahme der Datenregister; Messbereich aus FS_SEL (Bits 4:3)
+void SimMpu9250::latchDataRegisters() {
+    static const float ACCEL_LSB[4] = { 16384.0f, 8192.0f, 4096.0f, 2048.0f };
+    static const float GYRO_LSB[4] = { 131.0f, 65.5f, 32.8f, 16.4f };
+    float accelScale = ACCEL_LSB[(wire->getRegister(address, 0x1C) >> 3) & 3];
+    float gyroScale = GYRO_LSB[(wire->getRegister(address, 0x1B) >> 3) & 3];
+
+    float values[6];
+    signal(NativeClock::nowMicros() / 1e6, values);
+    for (int c = 0; c < 3; c++) {
+        putRaw(dataRegisters + c * 2, values[c], accelScale);
+        putRaw(dataRegisters + 8 + c * 2, values[3 + c], gyroScale);
+    }
+    putRaw(dataRegisters + 6, 25.0f - 21.0f, 333.87f);   // 25 °C (Offset 21 °C)
+}
+
+void SimMpu9250::onWrite(uint8_t reg, uint8_t value) {
+    if (reg == 0x6A && (value & 0x04)) {
+        // FIFO_RST: Bit setzt sich selbst zurück
+        wire->setRegister(address, 0x6A, value & ~0x04);
+        startMicros = NativeClock::nowMicros();
+        framesRead = 0;
+        frameIndex = 0;
+    }
+}
+
+bool SimMpu9250::onRead(uint8_t reg, uint8_t& value) {
+    if (reg >= 0x3B && reg <= 0x48) {
+        if (reg == 0x3B || reg == 0x43) {
+            latchDataRegisters();
+        }
+        value = dataRegisters[reg - 0x3B];
+        return true;
+    }
+    uint8_t size = frameSize();
+    if (reg == 0x72) {
+        uint64_t pending = size ? framesProduced() - framesRead : 0;
+        uint64_t bytes = pending * size - frameIndex;
+        latchedCount = bytes > FIFO_SIZE ? FIFO_SIZE : (uint16_t)bytes;
+        value = latchedCount >> 8;
+        return true;
+    }
+    if (reg == 0x73) {
+        value = latchedCount & 0xFF;
+        return true;
+    }
+    if (reg == 0x74) {
+        if (size == 0 || framesRead >= framesProduced()) {
+            value = 0;  // Leerer FIFO liefert das letzte Byte erneut
+            return true;
+        }
+        if (frameIndex == 0) {
+            fillFrame(framesRead);
+        }
+        value = frame[frameIndex++];
+        if (frameIndex == size) {
+            frameIndex = 0;
+            framesRead++;
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,47 @@
+#ifndef NATIVE_SIM_MPU9250_H
+#define NATIVE_SIM_MPU9250_H
+
+#include <Wire.h>
+
+// ===== MPU9250-FIFO-Modell =====
+// Füllt den FIFO abhängig von der simulierten Zeit mit der über
+// SMPLRT_DIV / ACCEL_CONFIG2 eingestellten Rate. FIFO_EN bestimmt den
+// Frame-Aufbau, FIFO_RST in USER_CTRL leert ihn, nach 512 Bytes läuft er
+// über (FIFO_COUNT bleibt dann auf 512). Das Signal ist 1 g auf Z plus
+// einstellbare Schwingung, damit Streaming und DSP realistische Daten sehen.
+// Die Datenregister ACCEL/TEMP/GYRO (0x3B..0x48) liefern denselben Verlauf
+// zum Lesezeitpunkt, im Messbereich aus ACCEL_CONFIG/GYRO_CONFIG; ein
+// Burst ab 0x3B bzw. 0x43 liest eine zusammengehörige Messung.
+class SimMpu9250 : public I2CDeviceModel {
+private:
+    TwoWire* wire;
+    uint8_t address;
+
+    uint64_t startMicros;      // Zeitpunkt des letzten FIFO-Resets
+    uint64_t framesRead;       // Seit dem Reset ausgelesene Frames
+    uint8_t frame[12];
+    uint8_t frameIndex;        // Nächstes Byte im aktuellen Frame
+    uint8_t dataRegisters[14]; // 0x3B..0x48 beim Start des Bursts
+    uint16_t latchedCount;     // FIFO_COUNT beim Lesen von FIFO_COUNTH
+
+    float vibrationHz;
+    float vibrationG;
+
+    uint32_t rateHz() const;
+    uint8_t frameSize() const;
+    uint64_t framesProduced() const;
+    void signal(double t, float* values) const;
+    void fillFrame(uint64_t index);
+    void latchDataRegisters();
+
+public:
+    SimMpu9250(TwoWire& wire, uint8_t address);
+
+    void setVibration(float frequencyHz, float amplitudeG);
+
+    void onWrite(uint8_t reg, uint8_t value) override;
+    bool onRead(uint8_t reg, uint8_t& value) override;
+    bool isStreamRegister(uint8_t reg) override { return reg == 0x74; }
+};
+
+#endif
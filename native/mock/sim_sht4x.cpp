@@ -0,0 +1,51 @@
+#include "sim_sht4x.h"
+#include "sim_signal.h"
+
+SimSht4x::SimSht4x(TwoWire& wire, uint8_t address)
+    : frameIndex(0), corruptCrc(false), lastTemperature(NAN), lastHumidity(NAN) {
+    memset(frame, 0, sizeof(frame));
+    wire.attachModel(address, this);
+}
+
+uint8_t SimSht4x::crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+void SimSht4x::fillWords(uint16_t first, uint16_t second) {
+    frame[0] = (uint8_t)(first >> 8);
+    frame[1] = (uint8_t)first;
+    frame[2] = crc8(frame, 2) ^ (corruptCrc ? 0x5A : 0x00);
+    frame[3] = (uint8_t)(second >> 8);
+    frame[4] = (uint8_t)second;
+    frame[5] = crc8(frame + 3, 2);
+}
+
+bool SimSht4x::onRead(uint8_t reg, uint8_t& value) {
+    if (!isStreamRegister(reg)) {
+        return false;
+    }
+    if (frameIndex == 0) {
+        if (reg == CMD_READ_SERIAL) {
+            fillWords((uint16_t)(SERIAL_NUMBER >> 16), (uint16_t)SERIAL_NUMBER);
+        } else {
+            // Datenblatt 4.6 umgekehrt, auf ganze Rohwerte gerundet
+            float t = SimSignal::bme280Temperature() + TEMPERATURE_OFFSET;
+            float h = SimSignal::bme280Humidity() + HUMIDITY_OFFSET;
+            uint16_t rawT = (uint16_t)lroundf((t + 45.0f) * 65535.0f / 175.0f);
+            uint16_t rawH = (uint16_t)lroundf((h + 6.0f) * 65535.0f / 125.0f);
+            lastTemperature = -45.0f + 175.0f * rawT / 65535.0f;
+            lastHumidity = -6.0f + 125.0f * rawH / 65535.0f;
+            fillWords(rawT, rawH);
+        }
+    }
+    value = frame[frameIndex];
+    frameIndex = (frameIndex + 1) % sizeof(frame);
+    return true;
+}
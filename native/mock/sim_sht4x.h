@@ -0,0 +1,43 @@
+#ifndef NATIVE_SIM_SHT4X_H
+#define NATIVE_SIM_SHT4X_H
+
+#include <Wire.h>
+
+// ===== SHT4x-Modell =====
+// Der SHT4x hat keine Register: ein Befehlsbyte, danach liest der Master
+// 6 Bytes (zwei Wörter mit CRC-8). Im Registermodell des Busses setzt das
+// Befehlsbyte den Registerzeiger; beide Lesebefehle sind Stream-Register,
+// das Modell liefert die Bytes der Antwort der Reihe nach und erzeugt mit
+// jedem neuen Frame einen Messwert (BME280-Signal plus fester Versatz).
+class SimSht4x : public I2CDeviceModel {
+public:
+    static const uint8_t CMD_MEASURE_HIGH = 0xFD;
+    static const uint8_t CMD_READ_SERIAL = 0x89;
+    static const uint32_t SERIAL_NUMBER = 0x1234ABCD;
+    static constexpr float TEMPERATURE_OFFSET = 0.4f;     // °C über dem BME280
+    static constexpr float HUMIDITY_OFFSET = -1.5f;       // %
+
+private:
+    uint8_t frame[6];
+    uint8_t frameIndex;
+    bool corruptCrc;
+    float lastTemperature;
+    float lastHumidity;
+
+    static uint8_t crc8(const uint8_t* data, size_t length);
+    void fillWords(uint16_t first, uint16_t second);
+
+public:
+    SimSht4x(TwoWire& wire, uint8_t address);
+
+    // Nächste Antworten mit falscher CRC (Störung auf dem Bus)
+    void setCorruptCrc(bool corrupt) { corruptCrc = corrupt; }
+    // Werte des zuletzt gelieferten Messframes
+    float getLastTemperature() const { return lastTemperature; }
+    float getLastHumidity() const { return lastHumidity; }
+
+    bool onRead(uint8_t reg, uint8_t& value) override;
+    bool isStreamRegister(uint8_t reg) override { return reg == CMD_MEASURE_HIGH || reg == CMD_READ_SERIAL; }
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef NATIVE_SIM_SIGNAL_H
+#define NATIVE_SIM_SIGNAL_H
+
+#include <Arduino.h>
+
+// ===== Simulierte Messsignale =====
+// Langsame Sinusverläufe plus reproduzierbares Rauschen, abgeleitet
+// von der simulierten Uhr. Gemeinsam genutzt von den Sensor-Attrappen.
+namespace SimSignal {
+    // Gleichverteiltes Rauschen im Bereich [-amplitude, +amplitude]
+    inline float noise(float amplitude) {
+        return amplitude * ((float)random(20001) / 10000.0f - 1.0f);
+    }
+
+    // Sinus mit Periode periodSeconds über die simulierte Zeit
+    inline float wave(float amplitude, float periodSeconds) {
+        double t = (double)NativeClock::nowMicros() / 1e6;
+        return amplitude * (float)sin(2.0 * M_PI * t / periodSeconds);
+    }
+
+    // BME280 ohne Rauschen: Temperatur [°C], Luftdruck [Pa], Feuchte [%]
+    inline float bme280Temperature() { return 21.5f + wave(2.0f, 3600.0f); }
+    inline float bme280Pressure() { return 101325.0f + wave(150.0f, 7200.0f); }
+    inline float bme280Humidity() { return 45.0f + wave(5.0f, 5400.0f); }
+}
+
+#endif
@@ -0,0 +1,44 @@
+// ===== log_decode: binären Log-Mitschnitt in Text umwandeln =====
+// Liest den Mitschnitt der seriellen Schnittstelle von stdin (oder laufend
+// aus einem Gerät) und schreibt den Text auf stdout. Das Wörterbuch kommt
+// aus den Quelltexten, mit denen die Firmware gebaut wurde:
+//
+//   g++ -std=gnu++17 -O2 -DNATIVE_BUILD -Inative/mock -Isrc -Inative/tools
+//       native/tools/log_decode.cpp native/tools/log_decoder.cpp
+//       src/logger.cpp native/mock/Arduino.cpp -o log_decode
+//   ./log_decode src/ < mitschnitt.bin
+//   stty -F /dev/ttyUSB0 115200 raw && ./log_decode src/ < /dev/ttyUSB0
+
+#include <stdio.h>
+#include "log_decoder.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Aufruf: %s <Quellverzeichnis|Datei>... < Mitschnitt\n", argv[0]);
+        return 2;
+    }
+
+    LogDecoder decoder;
+    for (int i = 1; i < argc; i++) {
+        decoder.addDirectory(argv[i]);
+    }
+    fprintf(stderr, "%zu Log-Aufrufe im Wörterbuch, %lu Kollision(en)\n", decoder.getDictionarySize(),
+            (unsigned long)decoder.getCollisionCount());
+    if (decoder.getDictionarySize() == 0) {
+        return 1;
+    }
+
+    uint8_t buffer[256];
+    std::string text;
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), stdin)) > 0) {
+        text.clear();
+        decoder.feed(buffer, n, text);
+        fwrite(text.data(), 1, text.size(), stdout);
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%lu Rahmen, %lu unbekannt, %lu fehlerhaft\n", (unsigned long)decoder.getFrameCount(),
+            (unsigned long)decoder.getUnknownCount(), (unsigned long)decoder.getErrorCount());
+    return 0;
+}
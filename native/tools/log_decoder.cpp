@@ -0,0 +1,301 @@
+#include "log_decoder.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "logger.h"
+
+LogDecoder::LogDecoder()
+    : collisions(0), frames(0), unknownFrames(0), errorFrames(0), lastTimestamp(0), inFrame(false) {}
+
+// ===== Wörterbuch aus den Quelltexten =====
+
+static void skipSpace(const std::string& text, size_t& pos) {
+    while (pos < text.size() && isspace((unsigned char)text[pos])) pos++;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Ein oder mehrere aufeinanderfolgende String-Literale ("a" "b"), Escapes wie
+// der Compiler; false wenn an pos kein Literal steht (z.B. nullptr, Variable)
+static bool parseLiteral(const std::string& text, size_t& pos, std::string& value) {
+    skipSpace(text, pos);
+    if (pos >= text.size() || text[pos] != '"') {
+        return false;
+    }
+    value.clear();
+    while (pos < text.size() && text[pos] == '"') {
+        pos++;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c != '\\') {
+                value += c;
+                continue;
+            }
+            if (pos >= text.size()) return false;
+            c = text[pos++];
+            switch (c) {
+                case 'n': value += '\n'; break;
+                case 't': value += '\t'; break;
+                case 'r': value += '\r'; break;
+                case 'a': value += '\a'; break;
+                case 'b': value += '\b'; break;
+                case 'f': value += '\f'; break;
+                case 'v': value += '\v'; break;
+                case 'x': {
+                    int code = 0;
+                    while (pos < text.size() && hexValue(text[pos]) >= 0) {
+                        code = code * 16 + hexValue(text[pos++]);
+                    }
+                    value += (char)code;
+                    break;
+                }
+                default:
+                    if (c >= '0' && c <= '7') {
+                        int code = c - '0';
+                        for (int i = 0; i < 2 && pos < text.size() && text[pos] >= '0' && text[pos] <= '7'; i++) {
+                            code = code * 8 + (text[pos++] - '0');
+                        }
+                        value += (char)code;
+                    } else {
+                        value += c;   // \" \\ \' \?
+                    }
+                    break;
+            }
+        }
+        if (pos >= text.size()) return false;
+        pos++;
+        skipSpace(text, pos);
+    }
+    return true;
+}
+
+size_t LogDecoder::addSource(const std::string& text) {
+    size_t found = 0;
+    size_t pos = 0;
+    while ((pos = text.find("LOG_", pos)) != std::string::npos) {
+        // Nur ganze Bezeichner: LOG_I, LOG_PRINT_I, nicht z.B. MY_LOG_I
+        bool standalone = pos == 0 || !(isalnum((unsigned char)text[pos - 1]) || text[pos - 1] == '_');
+        pos += 4;
+        bool hasTag = text.compare(pos, 6, "PRINT_") != 0;
+        size_t levelAt = hasTag ? pos : pos + 6;
+        if (!standalone || levelAt + 1 >= text.size() || text[levelAt] == '\0' ||
+            !strchr("EWIDV", text[levelAt])) {
+            continue;
+        }
+        size_t p = levelAt + 1;
+        skipSpace(text, p);
+        if (p >= text.size() || text[p] != '(') {
+            continue;
+        }
+        p++;
+
+        Entry entry;
+        entry.hasTag = hasTag;
+        if (hasTag) {
+            if (!parseLiteral(text, p, entry.tag) || p >= text.size() || text[p] != ',') {
+                continue;
+            }
+            p++;
+        }
+        if (!parseLiteral(text, p, entry.format)) {
+            continue;
+        }
+        uint32_t token = logToken(hasTag ? entry.tag.c_str() : nullptr, entry.format.c_str());
+        auto existing = dictionary.find(token);
+        if (existing == dictionary.end()) {
+            dictionary[token] = entry;
+        } else if (existing->second.tag != entry.tag || existing->second.format != entry.format ||
+                   existing->second.hasTag != entry.hasTag) {
+            collisions++;
+        }
+        found++;
+        pos = p;
+    }
+    return found;
+}
+
+size_t LogDecoder::addFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    return addSource(content.str());
+}
+
+size_t LogDecoder::addDirectory(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (fs::is_regular_file(path, error)) {
+        return addFile(path);
+    }
+    size_t found = 0;
+    for (fs::recursive_directory_iterator it(path, error), end; !error && it != end; it.increment(error)) {
+        std::string extension = it->path().extension().string();
+        if (it->is_regular_file() && (extension == ".cpp" || extension == ".h")) {
+            found += addFile(it->path().string());
+        }
+    }
+    return found;
+}
+
+// ===== Rahmen dekodieren =====
+
+static bool getVarint(const std::vector<uint8_t>& data, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= data.size()) return false;
+        uint8_t byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool LogDecoder::decodeFrame(const std::vector<uint8_t>& encoded, std::string& output) {
+    // COBS rückgängig machen
+    std::vector<uint8_t> payload;
+    for (size_t pos = 0; pos < encoded.size();) {
+        uint8_t code = encoded[pos++];
+        if (code == 0 || pos + code - 1 > encoded.size()) return false;
+        payload.insert(payload.end(), encoded.begin() + pos, encoded.begin() + pos + code - 1);
+        pos += code - 1;
+        if (code < 0xFF && pos < encoded.size()) payload.push_back(0);
+    }
+
+    if (payload.size() < 6) return false;
+    size_t pos = 0;
+    uint32_t token = 0;
+    for (int i = 0; i < 4; i++) token |= (uint32_t)payload[pos++] << (8 * i);
+    uint8_t header = payload[pos++];
+    uint64_t timestamp;
+    if (!getVarint(payload, pos, timestamp)) return false;
+
+    if (header & LOG_FRAME_RELATIVE) {
+        // Bis zum ersten Rahmen mit absoluter Zeit ab 0 gezählt
+        timestamp = lastTimestamp + (int32_t)((uint32_t)(timestamp >> 1) ^ -(uint32_t)(timestamp & 1));
+    }
+
+    LogRecord record;
+    record.token = token;
+    record.timestamp = (uint32_t)timestamp;
+    record.level = (header & ~LOG_FRAME_RELATIVE) >> 4;
+    record.argCount = 0;
+    record.stringBytes = 0;
+    uint8_t argCount = header & 0x0F;
+    if (record.level > LOG_VERBOSE || argCount > LOG_MAX_ARGS) return false;
+
+    size_t typesAt = pos;
+    pos += (argCount + 1) / 2;
+    if (pos > payload.size()) return false;
+    for (uint8_t i = 0; i < argCount; i++) {
+        uint8_t wire = (payload[typesAt + i / 2] >> (4 * (i % 2))) & 0x0F;
+        uint64_t value;
+        switch (wire) {
+            case LOG_WIRE_INT:
+                if (!getVarint(payload, pos, value)) return false;
+                record.addSigned((int64_t)(value >> 1) ^ -(int64_t)(value & 1));
+                break;
+            case LOG_WIRE_UINT:
+                if (!getVarint(payload, pos, value)) return false;
+                record.addUnsigned(value);
+                break;
+            case LOG_WIRE_FLOAT: {
+                float single;
+                if (pos + sizeof(single) > payload.size()) return false;
+                memcpy(&single, &payload[pos], sizeof(single));
+                pos += sizeof(single);
+                record.addDouble(single);
+                break;
+            }
+            case LOG_WIRE_DOUBLE: {
+                double number;
+                if (pos + sizeof(number) > payload.size()) return false;
+                memcpy(&number, &payload[pos], sizeof(number));
+                pos += sizeof(number);
+                record.addDouble(number);
+                break;
+            }
+            case LOG_WIRE_STRING: {
+                if (pos >= payload.size()) return false;
+                size_t length = payload[pos++];
+                if (pos + length > payload.size()) return false;
+                std::string text((const char*)&payload[pos], length);
+                pos += length;
+                record.addString(text.c_str());
+                break;
+            }
+            case LOG_WIRE_POINTER:
+                if (!getVarint(payload, pos, value)) return false;
+                record.addPointer((const void*)(uintptr_t)value);
+                break;
+            default:
+                return false;
+        }
+    }
+    if (pos != payload.size()) return false;
+
+    lastTimestamp = record.timestamp;
+    frames++;
+    auto entry = dictionary.find(token);
+    if (entry == dictionary.end()) {
+        // Quelltext passt nicht zur Firmware: Rohdaten zeigen
+        unknownFrames++;
+        char line[64];
+        snprintf(line, sizeof(line), "[? %08lx] [%10lu] %u Argument(e)\n", (unsigned long)token,
+                 (unsigned long)record.timestamp, (unsigned)argCount);
+        output += line;
+        return true;
+    }
+    record.tag = entry->second.hasTag ? entry->second.tag.c_str() : nullptr;
+    record.format = entry->second.format.c_str();
+    char line[LOG_LINE_SIZE];
+    output.append(line, Logger::formatText(record, line, sizeof(line)));
+    return true;
+}
+
+// Eine Null außerhalb eines Rahmens beginnt einen, innerhalb beendet sie
+// ihn. Ein leerer Rahmen (zwei Nullen hintereinander) ist der Beginn des
+// nächsten; lässt sich ein Rahmen nicht dekodieren, war es Text zwischen zwei
+// Rahmen, und die Null beginnt den nächsten.
+void LogDecoder::feed(const uint8_t* data, size_t size, std::string& output) {
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = data[i];
+        if (!inFrame) {
+            if (byte == LOG_FRAME_DELIMITER) {
+                inFrame = true;
+                frame.clear();
+            } else {
+                output += (char)byte;
+            }
+            continue;
+        }
+        if (byte != LOG_FRAME_DELIMITER) {
+            frame.push_back(byte);
+            if (frame.size() > 2 * LOG_LINE_SIZE) {
+                // Kein Rahmen ist so lang: war Text
+                output.append(frame.begin(), frame.end());
+                frame.clear();
+                inFrame = false;
+                errorFrames++;
+            }
+            continue;
+        }
+        if (frame.empty()) {
+            continue;
+        }
+        if (decodeFrame(frame, output)) {
+            inFrame = false;
+        } else {
+            errorFrames++;
+            output.append(frame.begin(), frame.end());
+        }
+        frame.clear();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef LOG_DECODER_H
+#define LOG_DECODER_H
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ===== Decoder für das binäre Log-Format (nur Host) =====
+// Baut aus den Quelltexten ein Wörterbuch Token -> (Tag, Format), indem es
+// alle LOG_x(...)- und LOG_PRINT_x(...)-Aufrufe mit String-Literalen
+// sucht; das Token wird wie in logger.h berechnet. feed() nimmt den
+// Mitschnitt der seriellen Schnittstelle in beliebigen Stücken, gibt Text
+// außerhalb der Rahmen unverändert weiter und ersetzt jeden Rahmen durch die
+// Zeile, die Logger::formatText() im Textmodus geschrieben hätte.
+class LogDecoder {
+private:
+    struct Entry {
+        std::string tag;
+        std::string format;
+        bool hasTag;
+    };
+
+    std::unordered_map<uint32_t, Entry> dictionary;
+    uint32_t collisions;
+    uint32_t frames;
+    uint32_t unknownFrames;
+    uint32_t errorFrames;
+    uint32_t lastTimestamp;    // Bezug für Rahmen mit relativer Zeit
+
+    bool inFrame;
+    std::vector<uint8_t> frame;
+
+    bool decodeFrame(const std::vector<uint8_t>& encoded, std::string& output);
+
+public:
+    LogDecoder();
+
+    // Rückgabe: Anzahl gefundener Aufrufstellen
+    size_t addSource(const std::string& text);
+    size_t addFile(const std::string& path);
+    size_t addDirectory(const std::string& path);   // rekursiv, *.cpp und *.h
+
+    void feed(const uint8_t* data, size_t size, std::string& output);
+    void feed(const std::string& data, std::string& output) {
+        feed((const uint8_t*)data.data(), data.size(), output);
+    }
+
+    size_t getDictionarySize() const { return dictionary.size(); }
+    uint32_t getCollisionCount() const { return collisions; }
+    uint32_t getFrameCount() const { return frames; }
+    uint32_t getUnknownCount() const { return unknownFrames; }
+    uint32_t getErrorCount() const { return errorFrames; }
+};
+
+#endif
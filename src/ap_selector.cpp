@@ -0,0 +1,168 @@
+#include "ap_selector.h"
+#include <WiFi.h>
+#include "rtc_cache.h"
+
+static const uint32_t RTC_MAGIC = 0x41505331;   // "APS1"
+
+// Erfahrung mit einer BSSID (gesättigte Zähler)
+struct ApHistory {
+    uint8_t bssid[6];
+    uint8_t successes;
+    uint8_t failures;    // Seit der letzten erfolgreichen Verbindung
+};
+
+// ===== Zustand im RTC Slow Memory =====
+struct ApSelectorRtc {
+    uint8_t candidateCount;
+    uint8_t nextHistorySlot;     // Ersetzt reihum, wenn die Tabelle voll ist
+    ApCandidate candidates[ApSelector::MAX_CANDIDATES];
+    ApHistory history[ApSelector::HISTORY_SIZE];
+};
+
+RTC_CACHE_ATTR static RtcCache<ApSelectorRtc, RTC_MAGIC> rtc;
+
+static const uint8_t NO_BSSID[6] = { 0, 0, 0, 0, 0, 0 };
+
+static ApHistory* findHistory(const uint8_t* bssid) {
+    for (size_t i = 0; i < ApSelector::HISTORY_SIZE; i++) {
+        if (memcmp(rtc->history[i].bssid, NO_BSSID, 6) != 0 && memcmp(rtc->history[i].bssid, bssid, 6) == 0) {
+            return &rtc->history[i];
+        }
+    }
+    return nullptr;
+}
+
+static ApHistory* historyFor(const uint8_t* bssid) {
+    ApHistory* entry = findHistory(bssid);
+    if (entry == nullptr) {
+        entry = &rtc->history[rtc->nextHistorySlot];
+        rtc->nextHistorySlot = (rtc->nextHistorySlot + 1) % ApSelector::HISTORY_SIZE;
+        memset(entry, 0, sizeof(*entry));
+        memcpy(entry->bssid, bssid, 6);
+    }
+    return entry;
+}
+
+ApSelector::ApSelector() : scanning(false), scanCount(0) {
+    rtc.restore();
+}
+
+bool ApSelector::startScan() {
+    if (scanning) {
+        return true;
+    }
+    WiFi.scanDelete();
+    int16_t result = WiFi.scanNetworks(true, false, false, WIFI_SCAN_MS_PER_CHANNEL);
+    scanning = result == WIFI_SCAN_RUNNING || result >= 0;
+    if (scanning) {
+        scanCount++;
+    }
+    return scanning;
+}
+
+int ApSelector::pollScan(const WifiCredentials& credentials) {
+    if (!scanning) {
+        return (int)rtc->candidateCount;
+    }
+    int16_t found = WiFi.scanComplete();
+    if (found == WIFI_SCAN_RUNNING) {
+        return -1;
+    }
+    scanning = false;
+    
+    // Nur bekannte Netze übernehmen (früher: SSID-Filter im wifi_scanner)
+    rtc->candidateCount = 0;
+    for (int16_t i = 0; i < found && rtc->candidateCount < MAX_CANDIDATES; i++) {
+        int credential = credentials.find(WiFi.SSID(i).c_str());
+        if (credential < 0) {
+            continue;
+        }
+        ApCandidate& c = rtc->candidates[rtc->candidateCount++];
+        memcpy(c.bssid, WiFi.BSSID(i), 6);
+        c.channel = (uint8_t)WiFi.channel(i);
+        c.rssi = (int8_t)WiFi.RSSI(i);
+        c.ssidHash = credentials.get(credential).ssidHash;
+    }
+    WiFi.scanDelete();
+    rank();
+    return (int)rtc->candidateCount;
+}
+
+// Signalstärke + Bonus je erfolgreicher Verbindung - Abzug je Fehlschlag
+int16_t ApSelector::score(const uint8_t* bssid, int8_t rssi) const {
+    const ApHistory* entry = findHistory(bssid);
+    int16_t value = rssi;
+    if (entry != nullptr) {
+        value += WIFI_SCORE_SUCCESS_DB * (entry->successes < 5 ? entry->successes : 5);
+        value -= WIFI_SCORE_FAILURE_DB * (entry->failures < 5 ? entry->failures : 5);
+    }
+    return value;
+}
+
+void ApSelector::rank() {
+    for (size_t i = 0; i < rtc->candidateCount; i++) {
+        rtc->candidates[i].score = score(rtc->candidates[i].bssid, rtc->candidates[i].rssi);
+    }
+    // Einfügesortierung, höchstens MAX_CANDIDATES Einträge
+    for (size_t i = 1; i < rtc->candidateCount; i++) {
+        ApCandidate current = rtc->candidates[i];
+        size_t j = i;
+        while (j > 0 && rtc->candidates[j - 1].score < current.score) {
+            rtc->candidates[j] = rtc->candidates[j - 1];
+            j--;
+        }
+        rtc->candidates[j] = current;
+    }
+}
+
+size_t ApSelector::candidateCount() const {
+    return rtc->candidateCount;
+}
+
+const ApCandidate& ApSelector::candidate(size_t index) const {
+    return rtc->candidates[index < rtc->candidateCount ? index : 0];
+}
+
+void ApSelector::clearCandidates() {
+    rtc->candidateCount = 0;
+}
+
+void ApSelector::recordSuccess(const uint8_t* bssid, int8_t rssi) {
+    ApHistory* entry = historyFor(bssid);
+    if (entry->successes < 255) {
+        entry->successes++;
+    }
+    entry->failures = 0;
+    
+    for (size_t i = 0; i < rtc->candidateCount; i++) {
+        if (memcmp(rtc->candidates[i].bssid, bssid, 6) == 0) {
+            rtc->candidates[i].rssi = rssi;
+        }
+    }
+    rank();
+}
+
+void ApSelector::recordFailure(const uint8_t* bssid) {
+    ApHistory* entry = historyFor(bssid);
+    if (entry->failures < 255) {
+        entry->failures++;
+    }
+    // Keine neue Rangfolge hier: der laufende Aufbau geht die Liste noch durch
+}
+
+void ApSelector::clearState() {
+    memset(&rtc, 0, sizeof(rtc));
+    rtc.restore();
+}
+
+void ApSelector::printCandidates(const WifiCredentials& credentials) const {
+    Serial.printf("📡 %u Kandidat(en):\n", (unsigned)rtc->candidateCount);
+    for (size_t i = 0; i < rtc->candidateCount; i++) {
+        const ApCandidate& c = rtc->candidates[i];
+        int credential = credentials.findByHash(c.ssidHash);
+        Serial.printf("  %u. %-20s %02X:%02X:%02X:%02X:%02X:%02X  Kanal %2u  %4d dBm  Wertung %4d\n",
+                      (unsigned)(i + 1), credential >= 0 ? credentials.get(credential).ssid : "?",
+                      c.bssid[0], c.bssid[1], c.bssid[2], c.bssid[3], c.bssid[4], c.bssid[5],
+                      c.channel, c.rssi, c.score);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef AP_SELECTOR_H
+#define AP_SELECTOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "wifi_credentials.h"
+
+// Ein Access Point eines bekannten Netzes aus dem letzten Scan
+struct ApCandidate {
+    uint8_t bssid[6];
+    uint8_t channel;
+    int8_t rssi;          // Beim Scan gemessen
+    uint32_t ssidHash;    // Verweis auf WifiCredentials
+    int16_t score;
+};
+
+// ===== Auswahl des Access Points =====
+// Scannt asynchron (aus dem früheren wifi_scanner-Sketch hervorgegangen),
+// behält nur APs der bekannten Netze und sortiert sie nach Signalstärke plus
+// Erfahrung: Jede erfolgreiche Verbindung zu einer BSSID bringt einen
+// Bonus, jeder Fehlschlag einen Abzug. Kandidaten und Erfahrung liegen im
+// RTC-Speicher; ein Reconnect probiert die Kandidaten der Reihe nach mit
+// bekanntem Kanal und BSSID, ohne erneut alle Kanäle abzusuchen.
+class ApSelector {
+private:
+    bool scanning;
+    uint32_t scanCount;
+    
+public:
+    static const size_t MAX_CANDIDATES = 6;
+    static const size_t HISTORY_SIZE = 12;
+    
+    ApSelector();
+    
+    bool startScan();                                  // Asynchron
+    // -1 solange der Scan läuft, sonst Anzahl Kandidaten (danach sortiert)
+    int pollScan(const WifiCredentials& credentials);
+    bool isScanning() const { return scanning; }
+    
+    size_t candidateCount() const;
+    const ApCandidate& candidate(size_t index) const;
+    void clearCandidates();
+    void rank();                                       // Nach Signal + Erfahrung sortieren
+    
+    void recordSuccess(const uint8_t* bssid, int8_t rssi);
+    void recordFailure(const uint8_t* bssid);
+    int16_t score(const uint8_t* bssid, int8_t rssi) const;
+    
+    uint32_t getScanCount() const { return scanCount; }
+    void printCandidates(const WifiCredentials& credentials) const;
+    
+    static void clearState();   // Kandidaten und Erfahrung verwerfen (wie Kaltstart)
+};
+
+#endif
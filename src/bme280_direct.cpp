@@ -0,0 +1,115 @@
+#include "bme280_direct.h"
+
+static const int32_t ADC_SKIPPED_20BIT = 0x80000;
+static const int32_t ADC_SKIPPED_16BIT = 0x8000;
+
+BME280Direct::BME280Direct() : bus(nullptr), address(0), ready(false) {
+    memset(&calibration, 0, sizeof(calibration));
+}
+
+bool BME280Direct::begin(I2CEngine& engine, uint8_t i2cAddress) {
+    bus = &engine;
+    address = i2cAddress;
+    ready = false;
+
+    uint8_t tp[CALIB_TP_SIZE];
+    uint8_t h[CALIB_H_SIZE];
+    if (!bus->readRegisters(address, REG_CALIB_TP, tp, sizeof(tp)) ||
+        !bus->readRegisters(address, REG_CALIB_H, h, sizeof(h))) {
+        return false;
+    }
+    parseCalibration(tp, h, calibration);
+
+    // T1 und P1 sind bei jedem Sensor deutlich größer als 0
+    ready = calibration.T1 != 0 && calibration.P1 != 0;
+    return ready;
+}
+
+bool BME280Direct::read(BME280Reading& reading, bool& humidityValid) {
+    uint8_t frame[FRAME_SIZE];
+    if (!ready || !bus->readRegisters(address, REG_DATA, frame, sizeof(frame))) {
+        return false;
+    }
+
+    BME280RawFrame raw = parseFrame(frame);
+    if (raw.adcT == ADC_SKIPPED_20BIT) {
+        return false;   // Ohne Temperatur kein t_fine
+    }
+
+    int32_t tFine;
+    reading.temperature = compensateTemperature(raw.adcT, calibration, tFine);
+    reading.pressure = raw.adcP == ADC_SKIPPED_20BIT ? 0 : compensatePressure(raw.adcP, tFine, calibration);
+    humidityValid = raw.adcH != ADC_SKIPPED_16BIT;
+    reading.humidity = humidityValid ? compensateHumidity(raw.adcH, tFine, calibration) : 0;
+    return reading.pressure != 0;
+}
+
+// ===== Registerlayout (Datenblatt Tabelle 16, Little Endian) =====
+void BME280Direct::parseCalibration(const uint8_t tp[CALIB_TP_SIZE], const uint8_t h[CALIB_H_SIZE],
+                                    BME280Calibration& calib) {
+    calib.T1 = (uint16_t)(tp[1] << 8 | tp[0]);
+    calib.T2 = (int16_t)(tp[3] << 8 | tp[2]);
+    calib.T3 = (int16_t)(tp[5] << 8 | tp[4]);
+    calib.P1 = (uint16_t)(tp[7] << 8 | tp[6]);
+    int16_t* pressure[] = { &calib.P2, &calib.P3, &calib.P4, &calib.P5, &calib.P6, &calib.P7, &calib.P8, &calib.P9 };
+    for (size_t i = 0; i < 8; i++) {
+        *pressure[i] = (int16_t)(tp[9 + 2 * i] << 8 | tp[8 + 2 * i]);
+    }
+    calib.H1 = tp[25];   // 0xA1 (0xA0 ist nicht belegt)
+
+    calib.H2 = (int16_t)(h[1] << 8 | h[0]);
+    calib.H3 = h[2];
+    // H4 = 0xE4[7:0] / 0xE5[3:0], H5 = 0xE6[7:0] / 0xE5[7:4], je 12 Bit mit Vorzeichen
+    calib.H4 = (int16_t)((int8_t)h[3] * 16 | (h[4] & 0x0F));
+    calib.H5 = (int16_t)((int8_t)h[5] * 16 | (h[4] >> 4));
+    calib.H6 = (int8_t)h[6];
+}
+
+BME280RawFrame BME280Direct::parseFrame(const uint8_t frame[FRAME_SIZE]) {
+    BME280RawFrame raw;
+    raw.adcP = (int32_t)frame[0] << 12 | (int32_t)frame[1] << 4 | frame[2] >> 4;
+    raw.adcT = (int32_t)frame[3] << 12 | (int32_t)frame[4] << 4 | frame[5] >> 4;
+    raw.adcH = (int32_t)frame[6] << 8 | frame[7];
+    return raw;
+}
+
+// ===== Kompensation nach Datenblatt 4.2.3 =====
+// Gleiche Rechenschritte wie die Bosch-Referenz; Linksschiebungen von
+// Werten, die negativ sein können, als Multiplikation (in C++ sonst undefiniert)
+
+int32_t BME280Direct::compensateTemperature(int32_t adcT, const BME280Calibration& calib, int32_t& tFine) {
+    int32_t var1 = (((adcT >> 3) - ((int32_t)calib.T1 << 1)) * (int32_t)calib.T2) >> 11;
+    int32_t delta = (adcT >> 4) - (int32_t)calib.T1;
+    int32_t var2 = (((delta * delta) >> 12) * (int32_t)calib.T3) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t BME280Direct::compensatePressure(int32_t adcP, int32_t tFine, const BME280Calibration& calib) {
+    int64_t var1 = (int64_t)tFine - 128000;
+    int64_t var2 = var1 * var1 * calib.P6;
+    var2 += var1 * calib.P5 * (1LL << 17);
+    var2 += (int64_t)calib.P4 * (1LL << 35);
+    var1 = ((var1 * var1 * calib.P3) >> 8) + var1 * calib.P2 * (1LL << 12);
+    var1 = (((1LL << 47) + var1) * calib.P1) >> 33;
+    if (var1 == 0) {
+        return 0;   // Division durch 0 vermeiden (leere Kalibrierung)
+    }
+    int64_t p = 1048576 - adcP;
+    p = ((p * (1LL << 31)) - var2) * 3125 / var1;
+    var1 = ((int64_t)calib.P9 * (p >> 13) * (p >> 13)) >> 25;
+    var2 = ((int64_t)calib.P8 * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (int64_t)calib.P7 * 16;
+    return (uint32_t)p;
+}
+
+uint32_t BME280Direct::compensateHumidity(int32_t adcH, int32_t tFine, const BME280Calibration& calib) {
+    int32_t x = tFine - 76800;
+    x = ((((adcH << 14) - (int32_t)calib.H4 * (1 << 20) - (int32_t)calib.H5 * x) + 16384) >> 15) *
+        (((((((x * (int32_t)calib.H6) >> 10) * (((x * (int32_t)calib.H3) >> 11) + 32768)) >> 10) + 2097152) *
+          (int32_t)calib.H2 + 8192) >> 14);
+    x -= ((((x >> 15) * (x >> 15)) >> 7) * (int32_t)calib.H1) >> 4;
+    x = x < 0 ? 0 : x;
+    x = x > 419430400 ? 419430400 : x;   // 100 %
+    return (uint32_t)(x >> 12);
+}
@@ -0,0 +1,84 @@
+#ifndef BME280_DIRECT_H
+#define BME280_DIRECT_H
+
+#include <Arduino.h>
+#include "i2c_engine.h"
+
+// Kalibrierdaten aus dem NVM des Sensors (Datenblatt 4.2.2)
+struct BME280Calibration {
+    uint16_t T1;
+    int16_t T2, T3;
+    uint16_t P1;
+    int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+    uint8_t H1;
+    int16_t H2;
+    uint8_t H3;
+    int16_t H4, H5;   // 12 Bit, in 0xE4..0xE6 verschachtelt
+    int8_t H6;
+};
+
+// Rohwerte eines Messdaten-Frames (0xF7..0xFE)
+struct BME280RawFrame {
+    int32_t adcP;     // 20 Bit, 0x80000 = Messung abgeschaltet
+    int32_t adcT;     // 20 Bit
+    int32_t adcH;     // 16 Bit, 0x8000 = Messung abgeschaltet
+};
+
+// Kompensierte Werte in Festkomma (Ausgabeformat der Bosch-Referenz)
+struct BME280Reading {
+    int32_t temperature;   // 0,01 °C
+    uint32_t pressure;     // Pa · 256 (Q24.8)
+    uint32_t humidity;     // %RH · 1024 (Q22.10)
+};
+
+// ===== BME280 direkt über die Register =====
+// Die Adafruit-Bibliothek liest Temperatur, Druck und Feuchte einzeln und
+// Druck und Feuchte lesen die Temperatur intern noch einmal (t_fine):
+// 5 Burst-Reads bzw. 10 I2C-Transaktionen pro Messwert. Hier genügt ein
+// Burst-Read über alle Messdatenregister 0xF7..0xFE (der Sensor hält sie
+// während des Burst-Reads konsistent, Datenblatt 4) und die Ganzzahl-
+// Kompensation aus dem Datenblatt (4.2.3: 32 Bit für Temperatur und
+// Feuchte, 64 Bit für den Druck) läuft einmal.
+//
+// Konfiguration (Modus, Oversampling) bleibt bei der Bibliothek; begin()
+// liest nur die Kalibrierdaten. Alle Zugriffe gehen über die I2C-Engine.
+class BME280Direct {
+public:
+    static const uint8_t REG_CALIB_TP = 0x88;      // 0x88..0xA1, 26 Bytes (T, P, H1)
+    static const uint8_t REG_CALIB_H = 0xE1;       // 0xE1..0xE7, 7 Bytes (H2..H6)
+    static const uint8_t REG_DATA = 0xF7;          // press, temp, hum: 8 Bytes
+    static const size_t CALIB_TP_SIZE = 26;
+    static const size_t CALIB_H_SIZE = 7;
+    static const size_t FRAME_SIZE = 8;
+
+private:
+    I2CEngine* bus;
+    uint8_t address;
+    BME280Calibration calibration;
+    bool ready;
+
+public:
+    BME280Direct();
+
+    // Kalibrierdaten lesen (zwei Burst-Reads); false ohne Antwort oder bei
+    // offensichtlich leerem NVM
+    bool begin(I2CEngine& engine, uint8_t i2cAddress);
+    bool isReady() const { return ready; }
+
+    // Ein Burst-Read 0xF7..0xFE plus Kompensation; false bei Busfehler oder
+    // abgeschalteter Temperatur-/Druckmessung. Ist die Feuchte abgeschaltet,
+    // bleibt humidity 0 und humidityValid false.
+    bool read(BME280Reading& reading, bool& humidityValid);
+
+    const BME280Calibration& getCalibration() const { return calibration; }
+
+    // ===== Bosch-Kompensation (auch für Host-Tests) =====
+    static void parseCalibration(const uint8_t tp[CALIB_TP_SIZE], const uint8_t h[CALIB_H_SIZE],
+                                 BME280Calibration& calib);
+    static BME280RawFrame parseFrame(const uint8_t frame[FRAME_SIZE]);
+    static int32_t compensateTemperature(int32_t adcT, const BME280Calibration& calib, int32_t& tFine);
+    static uint32_t compensatePressure(int32_t adcP, int32_t tFine, const BME280Calibration& calib);
+    static uint32_t compensateHumidity(int32_t adcH, int32_t tFine, const BME280Calibration& calib);
+};
+
+#endif
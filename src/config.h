@@ -6,14 +6,45 @@
 #define WIFI_PASSWORD "46813374"
 #define WIFI_TIMEOUT_MS 20000
 
+// Schnellverbindung: BSSID, Kanal und IP der letzten Verbindung aus dem
+// RTC-Speicher verwenden (keine Kanalsuche, kein DHCP)
+#define WIFI_FAST_RECONNECT 1
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 3000   // Danach normaler Aufbau mit Suche
+#define WIFI_IP_CACHE_MAX_REUSE 20          // Danach IP wieder per DHCP beziehen
+
+// Mehrere Netze/APs: Zugangsdaten im NVS (WIFI_SSID/WIFI_PASSWORD nur als
+// Startwert, weitere per C2D {"wifi":{"add":{...}}}), Auswahl nach
+// Signalstärke und bisherigem Verbindungserfolg (siehe ap_selector.h)
+#define WIFI_MAX_CREDENTIALS 8
+#define WIFI_SCAN_MS_PER_CHANNEL 120        // Aktiver Scan, 13 Kanäle ~1,6 s
+#define WIFI_SCORE_SUCCESS_DB 2             // Bonus je erfolgreicher Verbindung (max. 5)
+#define WIFI_SCORE_FAILURE_DB 10            // Abzug je Fehlschlag seit dem letzten Erfolg (max. 5)
+
+// Roaming: Unter der Schwelle wird im Hintergrund gescannt und gewechselt,
+// wenn ein anderer AP um die Hysterese stärker ist
+#define WIFI_ROAMING 1
+#define WIFI_ROAM_RSSI_THRESHOLD -75        // dBm
+#define WIFI_ROAM_HYSTERESIS_DB 8
+#define WIFI_ROAM_CHECK_INTERVAL_MS 5000
+#define WIFI_ROAM_COOLDOWN_MS 60000         // Mindestabstand zwischen zwei Roaming-Scans
+
 // ========== persönlicher Hotspot Konfiguration ==========
 //#define WIFI_SSID "iPhone"
 //#define WIFI_PASSWORD "egdM-frqL-6yyL-Xqww"
 
 // ========== NTP Konfiguration ==========
+// Eigener SNTP-Client mit Nachführung der Geräteuhr (siehe time_service.h).
+// Zeitstempel sind UTC; NTP_OFFSET_SECONDS gilt nur für die Anzeige.
 #define NTP_SERVER "pool.ntp.org"
 #define NTP_OFFSET_SECONDS 3600
 #define NTP_UPDATE_INTERVAL_MS 60000
+#define NTP_RETRY_INTERVAL_MS 2000    // Ohne Antwort bzw. nach Reconnect, ein Versuch je Intervall
+#define NTP_RESPONSE_TIMEOUT_MS 1000  // Danach gilt die Anfrage als verloren
+#define NTP_SYNC_TIMEOUT_MS 3000      // Max. Wartezeit auf die erste Synchronisation (setup)
+#define NTP_MAX_DELAY_MS 250          // Antworten mit längerer Laufzeit verwerfen
+#define NTP_STEP_THRESHOLD_MS 128     // Größere Abweichung: Sprung statt Eingleiten
+#define NTP_SLEW_MAX_PPM 500          // Max. Gleitrate (0,5 ms je Sekunde)
+#define NTP_MAX_FREQ_PPM 500          // Grenze der Frequenzkorrektur des Quarzes
 
 // ========== Azure IoT Hub ==========
 #define IOT_HUB_HOSTNAME "iotHubIvanFoka.azure-devices.net"
@@ -28,26 +59,188 @@
 #define DEVICE_ID "iotWeatherstationesp32"
 #define DEVICE_KEY "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA="
 
+// SAS-Token: Laufzeit und Erneuerung (siehe SasTokenCache in sas.h)
+#define SAS_TOKEN_LIFETIME_S 86400        // 24 Stunden
+#define SAS_TOKEN_RENEW_FRACTION 0.8f     // Nach 80 % (+ Zufallsversatz) neu verbinden
+
+// TLS-Session-Wiederaufnahme (siehe TlsClient in tls_client.h): Reconnects
+// und Uplinks nach Deep Sleep sparen Zertifikatsprüfung und ECDHE
+#define TLS_SESSION_RESUMPTION 1
+#define TLS_SESSION_CACHE_SIZE 3072       // RTC-Speicher; Session inkl. Server-Zertifikat
+#define TLS_HANDSHAKE_TIMEOUT_MS 15000
+
 // X.509 Authentifizierung (Schicht 3: X.509)
 //#define DEVICE_ID "iotWeatherstationesp32-x509"
 
 // MQTT Topics
 #define MQTT_TELEMETRY_TOPIC "devices/" DEVICE_ID "/messages/events/"
 #define MQTT_C2D_TOPIC "devices/" DEVICE_ID "/messages/devicebound/#"
+// Binärformat: Content-Type und Schema-Version als Message-Properties
+#define MQTT_TELEMETRY_BINARY_TOPIC MQTT_TELEMETRY_TOPIC "$.ct=application%2Foctet-stream&schema=telemetry-bin-v1"
+// Schwingungskennwerte: eigene Property für das Routing im IoT Hub
+#define MQTT_VIBRATION_TOPIC MQTT_TELEMETRY_TOPIC "$.ct=application%2Fjson&$.ce=utf-8&type=vibration"
+#define MQTT_POWER_TOPIC MQTT_TELEMETRY_TOPIC "$.ct=application%2Fjson&$.ce=utf-8&type=power"
+// Device Twin: Laufzeit-Kennzahlen als Reported Properties ($rid wird angehängt)
+#define MQTT_TWIN_REPORTED_TOPIC "$iothub/twin/PATCH/properties/reported/?$rid="
+#define MQTT_TWIN_RESPONSE_TOPIC "$iothub/twin/res/#"
 
 // ========== MQTT QoS Konfiguration ========== ✅ NEU!
-#define MQTT_QOS_LEVEL 1              // 0=keine Bestätigung, 1=PUBACK, 2=PUBCOMP
+#define MQTT_QOS_LEVEL 1              // 0=keine Bestätigung, 1=PUBACK (IoT Hub kennt kein QoS 2)
+// QoS 1 für Telemetrie: mehrere Nachrichten gleichzeitig unbestätigt
+// unterwegs, Wiederholung mit DUP-Flag (siehe mqtt_qos1.h)
+#define MQTT_INFLIGHT_WINDOW 8        // Max. unbestätigte Nachrichten
+#define MQTT_INFLIGHT_BUFFER_SIZE 4096  // Bytes für deren Pakete (Wiederholung), mind. ein größtes Paket
+#define MQTT_PUBACK_TIMEOUT_MS 5000   // Ohne PUBACK erneut senden
 //#define MQTT_PORT 8883                // Azure IoT Hub MQTT Port (TLS)
 //#define RECONNECT_INTERVAL 5000       // Reconnect alle 5 Sekunden
 
+// ========== Reconnect (exponentielles Backoff) ==========
+// Erster Versuch nach Verbindungsverlust sofort, danach 2 s, 4 s, 8 s ...
+// bis zum Maximum, jeweils mit Zufallsanteil (siehe reconnect_scheduler.h)
+#define RECONNECT_BASE_DELAY_MS 2000
+#define WIFI_RECONNECT_MAX_DELAY_MS 60000     // 1 Minute
+#define MQTT_RECONNECT_MAX_DELAY_MS 120000    // 2 Minuten (bisheriges festes Intervall)
+
 // ========== Sensor Konfiguration ==========
 //#define SENSOR_READ_INTERVAL_MS 30000 // für X.509 Authentifizierung alle 30 Sekunden (wegen höherem Overhead)
 
-#define SENSOR_READ_INTERVAL_MS 5000 // für SAS Authentifizierung alle 5 Sekunden
+#define SENSOR_READ_INTERVAL_MS 5000 // für SAS Authentifizierung alle 5 Sekunden (fester Takt ohne adaptive Abtastung)
+#define BME280_DIRECT_READ 1         // 1 = ein Burst-Read 0xF7..0xFE mit Ganzzahl-Kompensation
+                                     //     statt drei Bibliotheksaufrufen (siehe bme280_direct.h)
+
+// ========== Adaptive Abtastung ==========
+// BME280 und MPU9250 mit eigenem Takt: in Ruhe der langsame Grundtakt,
+// bei schneller Änderung (Wetterumschwung) bzw. Schwingung (Maschine läuft)
+// der schnelle Takt bis ADAPTIVE_HOLD_S nach der letzten Aktivität
+// (siehe sample_scheduler.h). Zur Laufzeit per C2D {"sampling":{...}} änderbar.
+#define ADAPTIVE_SAMPLING_ENABLED 1          // 0 = beide fest alle SENSOR_READ_INTERVAL_MS
+#define BME_INTERVAL_MIN_MS 1000
+#define BME_INTERVAL_MAX_MS 60000            // Wetter ändert sich in Ruhe langsam
+#define MPU_INTERVAL_MIN_MS 1000
+#define MPU_INTERVAL_MAX_MS 30000
+#define ADAPTIVE_HOLD_S 120                  // Schnell bleiben nach der letzten Aktivität
+#define ADAPTIVE_BME_TAU_S 60                // Glättung für Mittelwert, Streuung, Steigung
+#define ADAPTIVE_MPU_TAU_S 10
+// Schwellen je Kanal (Änderungsrate des geglätteten Werts bzw. Streuung)
+#define ADAPTIVE_RATE_TEMPERATURE 0.5f       // °C/min
+#define ADAPTIVE_RATE_HUMIDITY 3.0f          // %/min
+#define ADAPTIVE_RATE_PRESSURE 0.1f          // hPa/min (6 hPa/h: Böen-/Gewitterfront)
+#define ADAPTIVE_STDDEV_ACCEL 0.05f          // g (Schwingung)
+#define ADAPTIVE_STDDEV_GYRO 5.0f            // °/s
+
+// ========== Telemetrie-Batching ==========
+// Mehrere Messwerte werden als JSON-Array in einer MQTT-Nachricht gesendet
+// (1 = jede Messung einzeln wie bisher)
+#define TELEMETRY_BATCH_SIZE 1           // Messwerte pro Nachricht (z.B. 10)
+#define TELEMETRY_BATCH_MAX_AGE_MS 60000 // Spätestens nach 60 Sekunden senden
+
+// ========== Telemetrie-Kodierung ==========
+#define TELEMETRY_ENCODING_JSON 0    // Lesbares JSON (Standard)
+#define TELEMETRY_ENCODING_BINARY 1  // Festkomma-Binärformat, ca. 7x kleiner (siehe telemetry_codec.h)
+#define TELEMETRY_ENCODING TELEMETRY_ENCODING_JSON
+
+// ========== Report-by-Exception (Totband-Filter) ==========
+// Messwerte nur senden, wenn sich ein Kanal um mehr als sein Totband
+// geändert hat oder der Heartbeat abgelaufen ist (siehe telemetry_filter.h).
+// Zur Laufzeit per C2D {"filter":{...}} änderbar.
+#define TELEMETRY_FILTER_ENABLED 1
+#define TELEMETRY_FILTER_HEARTBEAT_S 300     // Spätestens alle 5 Minuten ein Messwert
+#define TELEMETRY_DEADBAND_TEMPERATURE 0.1f  // °C
+#define TELEMETRY_DEADBAND_HUMIDITY 1.0f     // %
+#define TELEMETRY_DEADBAND_PRESSURE 0.2f     // hPa
+#define TELEMETRY_DEADBAND_ACCEL 0.05f       // g
+#define TELEMETRY_DEADBAND_GYRO 2.0f         // °/s
+
+// ========== Offline-Speicher (Store-and-Forward) ==========
+// Messwerte werden bei MQTT-Ausfall in LittleFS gesichert und später nachgesendet
+#define OFFLINE_STORE_CAPACITY 4096         // Datensätze à 28 Bytes (~112 KB Flash)
+#define OFFLINE_BACKFILL_INTERVAL_MS 1000   // Max. eine Nachsende-Nachricht pro Sekunde
+
+// ========== MPU9250 FIFO-Streaming (Schwingungsüberwachung) ==========
+// Zusätzlich zum 5-s-Messwert wird der MPU9250 mit hoher Rate über seinen
+// FIFO ausgelesen (Blöcke roher int16-Werte, siehe mpu_stream.h)
+#define MPU_STREAM_ENABLED 0            // 1 = Streaming aktiv
+#define MPU_STREAM_RATE_HZ 1000         // Max. 1000 mit Gyro, 4000 nur Accel
+#define MPU_STREAM_WITH_GYRO 1          // 0 = nur Beschleunigung
+#define MPU_STREAM_BLOCK_SIZE 32        // Werte pro Block (max. 64, FIFO fasst 42 bei Accel+Gyro)
+#define MPU_INT_PIN 19                  // INT des MPU9250; -1 = ohne Interrupt (Polling)
+#define MPU_STREAM_TASK_PRIORITY 4      // Über dem Sensor-Task, FIFO darf nicht überlaufen
+
+// ========== Schwingungsanalyse ==========
+// Kennwerte aus dem FIFO-Stream statt Rohdaten senden (nur mit MPU_STREAM_ENABLED)
+#define VIBRATION_WINDOW_SIZE 512         // Zweierpotenz; 512 @ 1 kHz = 0,5 s, ~2 Hz Auflösung
+#define VIBRATION_BAND_COUNT 8            // Gleich breite Bänder von 0 bis zur halben Abtastrate
+#define VIBRATION_WINDOWS_PER_REPORT 20   // 20 Fenster à 0,5 s = ein Bericht alle ~10 s
+
+// ========== FreeRTOS-Tasks ==========
+// Sensor-Task und Netzwerk-Task laufen auf getrennten Kernen, damit
+// WLAN-/MQTT-Verbindungsaufbau (bis zu 20 s blockierend) die Abtastung
+// nicht verzögert. WiFi-Stack und lwIP laufen auf Kern 0.
+#define SENSOR_TASK_CORE 1
+#define SENSOR_TASK_PRIORITY 3
+#define SENSOR_TASK_STACK_SIZE 4096
+#define NETWORK_TASK_CORE 0
+#define NETWORK_TASK_PRIORITY 1
+#define NETWORK_TASK_STACK_SIZE 8192      // TLS-Handshake braucht Stack
+#define SAMPLE_QUEUE_SIZE 32              // Zweierpotenz; Puffer für Netzwerk-Stalls
+
+// ========== I2C-Bus ==========
+// Alle Registerzugriffe der eigenen Treiber (BME280-Burst, MPU9250-FIFO,
+// Scan) laufen als Transaktionen über eine Warteschlange; ein eigener
+// Task führt sie aus (siehe i2c_engine.h)
+#define I2C_QUEUE_SIZE 16                 // Zweierpotenz; wartende Transaktionen aller Treiber
+#define I2C_TASK_CORE 1                   // Beim Sensor- und FIFO-Task
+#define I2C_TASK_PRIORITY 5               // Über allen Auftraggebern, der Bus bleibt ausgelastet
+#define I2C_TASK_STACK_SIZE 3072          // Rückrufe laufen hier (Scan gibt über Serial aus)
+
+// ========== Sensortreiber ==========
+// Treiber stehen in der Liste in sensor_drivers.h und werden anhand des
+// I2C-Scans gefunden. Kanäle ohne festes Feld in SensorData (z.B. SHT4x)
+// gehen als Zusatzwerte mit (JSON; nicht im Offline-Speicher/Binärformat)
+#define SENSOR_EXTRA_RECORDS 4            // Zusatzkanäle je Messwert
+
+// ========== Stromsparbetrieb (Batterie) ==========
+// Aufwachen, BME280 im Forced Mode messen, Wert im RTC-Speicher ablegen,
+// Deep Sleep. WLAN nur alle LOW_POWER_SAMPLES_PER_UPLINK Messungen.
+// Ersetzt die FreeRTOS-Tasks und das MPU9250-Streaming (siehe power_manager.h)
+#define LOW_POWER_MODE 0                  // 1 = Batteriebetrieb mit Deep Sleep
+#define LOW_POWER_INTERVAL_S 60           // Messintervall (bestimmt auch das Oversampling)
+#define LOW_POWER_SAMPLES_PER_UPLINK 10   // Messwerte pro WLAN-Verbindung (TELEMETRY_BATCH_SIZE
+                                          // gleich groß wählen = eine Nachricht pro Uplink)
+
+// Stromaufnahme für die Energiebilanz (ESP32-WROOM, typisch; für die
+// eigene Platine nachmessen)
+#define POWER_SUPPLY_VOLTAGE 3.3f
+#define POWER_CPU_CURRENT_MA 40.0f        // CPU aktiv, Funk aus
+#define POWER_RADIO_CURRENT_MA 120.0f     // WLAN verbunden/sendend (Mittelwert)
+#define POWER_SLEEP_CURRENT_MA 0.15f      // Deep Sleep inkl. Spannungsregler und Sensoren
+#define POWER_BOOT_OVERHEAD_MS 200        // Bootloader nach dem Aufwachen (vor setup())
+
+// ========== Laufzeit-Kennzahlen ==========
+// Schleifendauer, Auslesen je Sensor, Kodieren, Senden, Heap, Reconnects;
+// als Reported Properties im Device Twin (siehe metrics.h)
+#define METRICS_ENABLED 1
+#define METRICS_REPORT_INTERVAL_MS 300000   // 5 Minuten; Dauern gelten je Intervall
+
 // ========== LED Pin ==========
 #define LED_PIN 23
 
+// ========== Logging ==========
+// LOG_x-Meldungen gehen in einen Ringpuffer; ein eigener Task niedriger
+// Priorität formatiert und schreibt sie (siehe logger.h)
+#define LOG_QUEUE_SIZE 64                 // Zweierpotenz; ~120 Bytes je Meldung
+#define LOG_TASK_CORE 0
+#define LOG_TASK_PRIORITY 0               // Unter dem Netzwerk-Task, nur neben dem Idle-Task
+#define LOG_TASK_STACK_SIZE 3072          // snprintf mit Gleitkomma braucht Stack
+#define LOG_DRAIN_INTERVAL_MS 20
+#define LOG_SERIAL_BYTES_PER_S 5760       // Halbe UART-Kapazität bei 115200 Baud
+// 1 = nur Token + Rohwerte ausgeben (Format-Strings nicht im Flash);
+// Klartext auf dem Host mit native/tools/log_decode
+#define LOG_BINARY 0
+
 // ========== Debug Level ==========
+// 0 = Fehler, 1 = Warnungen, 2 = Info, 3 = Debug, 4 = Verbose;
+// LOG_x-Aufrufe oberhalb werden nicht übersetzt
 #define DEBUG_LEVEL 3
 
 #endif
\ No newline at end of file
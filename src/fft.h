@@ -0,0 +1,70 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <Arduino.h>
+
+// ===== Radix-2 FFT mit vorberechneten Tabellen =====
+// In-place, Decimation-in-Time. Twiddle-Faktoren und Bit-Umkehr-Tabelle
+// werden einmal im Konstruktor berechnet; transform() allokiert nichts
+// und ruft keine Winkelfunktionen auf. Float statt Festkomma, da der
+// ESP32 eine Single-Precision-FPU hat.
+template <size_t N>
+class RadixTwoFft {
+private:
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "N muss eine Zweierpotenz sein");
+
+    float cosTable[N / 2];
+    float sinTable[N / 2];
+    uint16_t bitReverse[N];
+
+public:
+    RadixTwoFft() {
+        for (size_t k = 0; k < N / 2; k++) {
+            double angle = -2.0 * M_PI * k / N;
+            cosTable[k] = (float)cos(angle);
+            sinTable[k] = (float)sin(angle);
+        }
+
+        size_t bits = 0;
+        while ((1u << bits) < N) bits++;
+        for (size_t i = 0; i < N; i++) {
+            size_t reversed = 0;
+            for (size_t b = 0; b < bits; b++) {
+                if (i & (1u << b)) reversed |= 1u << (bits - 1 - b);
+            }
+            bitReverse[i] = (uint16_t)reversed;
+        }
+    }
+
+    // Komplexe Vorwärts-Transformation von re/im (je N Werte)
+    void transform(float* re, float* im) const {
+        for (size_t i = 0; i < N; i++) {
+            size_t j = bitReverse[i];
+            if (j > i) {
+                float t = re[i]; re[i] = re[j]; re[j] = t;
+                t = im[i]; im[i] = im[j]; im[j] = t;
+            }
+        }
+
+        for (size_t size = 2; size <= N; size <<= 1) {
+            size_t half = size / 2;
+            size_t step = N / size;
+            for (size_t start = 0; start < N; start += size) {
+                for (size_t k = 0; k < half; k++) {
+                    float wr = cosTable[k * step];
+                    float wi = sinTable[k * step];
+                    size_t a = start + k;
+                    size_t b = a + half;
+                    float tr = re[b] * wr - im[b] * wi;
+                    float ti = re[b] * wi + im[b] * wr;
+                    re[b] = re[a] - tr;
+                    im[b] = im[a] - ti;
+                    re[a] += tr;
+                    im[a] += ti;
+                }
+            }
+        }
+    }
+};
+
+#endif
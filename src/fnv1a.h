@@ -0,0 +1,23 @@
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <stdint.h>
+
+// ===== FNV-1a (32 Bit) =====
+// Kurzer, nicht kryptographischer Hash für Hostnamen, SSIDs und Log-Tokens.
+// constexpr, damit die Log-Makros ihre Tokens zur Übersetzungszeit
+// berechnen; zur Laufzeit aufgerufen ist es eine einfache Schleife
+// (Endrekursion).
+static constexpr uint32_t FNV1A_OFFSET = 2166136261u;
+static constexpr uint32_t FNV1A_PRIME = 16777619u;
+
+constexpr uint32_t fnv1aByte(uint32_t hash, uint8_t byte) {
+    return (hash ^ byte) * FNV1A_PRIME;
+}
+
+// Setzt mit hash einen bereits begonnenen Hash fort
+constexpr uint32_t fnv1a(const char* text, uint32_t hash = FNV1A_OFFSET) {
+    return *text ? fnv1a(text + 1, fnv1aByte(hash, (uint8_t)*text)) : hash;
+}
+
+#endif
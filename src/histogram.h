@@ -0,0 +1,189 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <Arduino.h>
+
+// ===== Histogramm mit logarithmischen Klassen =====
+// Für Dauern wie den WLAN-Verbindungsaufbau: Klasse i reicht bis
+// firstBound·2^i, die letzte Klasse nimmt alles darüber auf. Feste Größe,
+// keine Allokation, add() ohne Division.
+template <size_t BUCKETS>
+class Histogram {
+private:
+    static_assert(BUCKETS >= 2, "Mindestens zwei Klassen");
+
+    uint32_t firstBound;
+    uint32_t counts[BUCKETS];
+    uint32_t total;
+    uint64_t sum;
+    uint32_t minValue;
+    uint32_t maxValue;
+
+public:
+    explicit Histogram(uint32_t firstBound) : firstBound(firstBound ? firstBound : 1) {
+        reset();
+    }
+
+    void reset() {
+        memset(counts, 0, sizeof(counts));
+        total = 0;
+        sum = 0;
+        minValue = UINT32_MAX;
+        maxValue = 0;
+    }
+
+    void add(uint32_t value) {
+        size_t i = 0;
+        uint64_t bound = firstBound;
+        while (i < BUCKETS - 1 && value > bound) {
+            bound <<= 1;
+            i++;
+        }
+        counts[i]++;
+        total++;
+        sum += value;
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+    }
+
+    // Obergrenze der Klasse i (inklusive); UINT32_MAX für die letzte
+    uint32_t upperBound(size_t i) const {
+        if (i >= BUCKETS - 1) return UINT32_MAX;
+        uint64_t bound = (uint64_t)firstBound << i;
+        return bound > UINT32_MAX ? UINT32_MAX : (uint32_t)bound;
+    }
+
+    // Obergrenze der Klasse, in die das p-Quantil fällt (0..100), höchstens max
+    uint32_t percentile(float p) const {
+        if (total == 0) return 0;
+        uint32_t rank = (uint32_t)(p / 100.0f * total + 0.5f);
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint32_t bound = upperBound(i);
+                return bound < maxValue ? bound : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    size_t bucketCount() const { return BUCKETS; }
+    uint32_t getCount(size_t i) const { return i < BUCKETS ? counts[i] : 0; }
+    uint32_t getTotal() const { return total; }
+    uint32_t getMean() const { return total ? (uint32_t)(sum / total) : 0; }
+    uint32_t getMin() const { return total ? minValue : 0; }
+    uint32_t getMax() const { return maxValue; }
+
+    void print(const char* name, const char* unit) const {
+        Serial.printf("  %s: n=%lu, Ø %lu %s, min. %lu, max. %lu\n", name,
+                      (unsigned long)total, (unsigned long)getMean(), unit,
+                      (unsigned long)getMin(), (unsigned long)maxValue);
+        for (size_t i = 0; i < BUCKETS; i++) {
+            if (counts[i] == 0) continue;
+            if (i < BUCKETS - 1) {
+                Serial.printf("    <= %6lu %s: %lu\n", (unsigned long)upperBound(i), unit, (unsigned long)counts[i]);
+            } else {
+                Serial.printf("     > %6lu %s: %lu\n", (unsigned long)upperBound(i - 1), unit, (unsigned long)counts[i]);
+            }
+        }
+    }
+};
+
+// ===== Histogramm mit halblogarithmischen Klassen (HDR) =====
+// Für Laufzeit-Kennzahlen (Schleifendauer, I2C, Senden): jede Zweierpotenz
+// ist in 2^SUB_BITS gleich breite Klassen geteilt, der relative Fehler
+// eines Quantils liegt damit unter 2^-SUB_BITS (SUB_BITS = 3: 12,5 %) – bei
+// 1 µs wie bei 10 s. Werte ab 2^MAX_BITS landen in der letzten Klasse,
+// max bleibt exakt. add() ist ein clz und eine Verschiebung.
+template <uint8_t SUB_BITS, uint8_t MAX_BITS>
+class HdrHistogram {
+private:
+    static_assert(SUB_BITS >= 1 && MAX_BITS > SUB_BITS && MAX_BITS <= 32, "Ungültige Klassenteilung");
+
+    static const uint32_t SUB_COUNT = 1UL << SUB_BITS;
+    static const size_t BUCKETS = (size_t)(MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    uint32_t counts[BUCKETS];
+    uint32_t total;
+    uint64_t sum;
+    uint32_t minValue;
+    uint32_t maxValue;
+
+    static size_t indexOf(uint32_t value) {
+        if (value < SUB_COUNT) {
+            return value;
+        }
+        uint8_t exponent = 31 - __builtin_clz(value);
+        if (exponent >= MAX_BITS) {
+            return BUCKETS - 1;
+        }
+        uint8_t shift = exponent - SUB_BITS;
+        return (size_t)(shift + 1) * SUB_COUNT + ((value >> shift) - SUB_COUNT);
+    }
+
+public:
+    HdrHistogram() {
+        reset();
+    }
+
+    void reset() {
+        memset(counts, 0, sizeof(counts));
+        total = 0;
+        sum = 0;
+        minValue = UINT32_MAX;
+        maxValue = 0;
+    }
+
+    void add(uint32_t value) {
+        counts[indexOf(value)]++;
+        total++;
+        sum += value;
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+    }
+
+    // Größter Wert der Klasse i
+    static uint32_t upperBound(size_t i) {
+        if (i < SUB_COUNT) return (uint32_t)i;
+        if (i >= BUCKETS - 1) return UINT32_MAX;
+        uint8_t shift = (uint8_t)(i / SUB_COUNT - 1);
+        uint64_t lower = (uint64_t)(SUB_COUNT + i % SUB_COUNT) << shift;
+        return (uint32_t)(lower + (1ULL << shift) - 1);
+    }
+
+    // Obergrenze der Klasse, in die das p-Quantil fällt (0..100), höchstens max
+    uint32_t percentile(float p) const {
+        if (total == 0) return 0;
+        uint32_t rank = (uint32_t)(p / 100.0f * total + 0.5f);
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint32_t bound = upperBound(i);
+                return bound < maxValue ? bound : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    static size_t bucketCount() { return BUCKETS; }
+    uint32_t getTotal() const { return total; }
+    uint32_t getMean() const { return total ? (uint32_t)(sum / total) : 0; }
+    uint32_t getMin() const { return total ? minValue : 0; }
+    uint32_t getMax() const { return maxValue; }
+
+    void print(const char* name, const char* unit) const {
+        Serial.printf("  %s: n=%lu, Ø %lu %s, p50 %lu, p90 %lu, p99 %lu, max. %lu\n", name,
+                      (unsigned long)total, (unsigned long)getMean(), unit,
+                      (unsigned long)percentile(50), (unsigned long)percentile(90),
+                      (unsigned long)percentile(99), (unsigned long)maxValue);
+    }
+};
+
+// µs bis 16,7 s bzw. ms bis 4,6 h; 704 Bytes
+typedef HdrHistogram<3, 24> LatencyHistogram;
+
+#endif
@@ -0,0 +1,303 @@
+#include "i2c_engine.h"
+
+I2CEngine i2cBus(Wire);
+
+static const uint8_t RECOVERY_CLOCKS = 9;          // Längstes angefangenes Byte plus ACK
+static const unsigned int RECOVERY_HALF_PERIOD_US = 5;   // 100 kHz
+
+#ifndef NATIVE_BUILD
+// Wartender Aufrufer von transfer()
+struct TransferWaiter {
+    I2CTransaction* transaction;
+    SemaphoreHandle_t done;
+};
+#endif
+
+// ===== Transaktionen beschreiben =====
+
+I2CTransaction I2CTransaction::read(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t length,
+                                    I2CCallback callback, void* context) {
+    I2CTransaction transaction = probe(address, callback, context);
+    transaction.writeLength = 1;
+    transaction.writeData[0] = reg;
+    transaction.readLength = length;
+    transaction.readBuffer = buffer;
+    return transaction;
+}
+
+I2CTransaction I2CTransaction::write(uint8_t address, uint8_t reg, uint8_t value,
+                                     I2CCallback callback, void* context) {
+    I2CTransaction transaction = probe(address, callback, context);
+    transaction.writeLength = 2;
+    transaction.writeData[0] = reg;
+    transaction.writeData[1] = value;
+    return transaction;
+}
+
+I2CTransaction I2CTransaction::probe(uint8_t address, I2CCallback callback, void* context) {
+    I2CTransaction transaction;
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.address = address;
+    transaction.callback = callback;
+    transaction.context = context;
+    transaction.status = I2C_PENDING;
+    return transaction;
+}
+
+I2CTransaction I2CTransaction::command(uint8_t address, uint8_t code, I2CCallback callback, void* context) {
+    I2CTransaction transaction = probe(address, callback, context);
+    transaction.writeLength = 1;
+    transaction.writeData[0] = code;
+    return transaction;
+}
+
+I2CTransaction I2CTransaction::receive(uint8_t address, uint8_t* buffer, uint8_t length,
+                                       I2CCallback callback, void* context) {
+    I2CTransaction transaction = probe(address, callback, context);
+    transaction.readLength = length;
+    transaction.readBuffer = buffer;
+    return transaction;
+}
+
+// ===== Engine =====
+
+I2CEngine::I2CEngine(TwoWire& bus)
+    : wire(&bus), sdaPin(-1), sclPin(-1), frequency(100000), completedCount(0), errorCount(0),
+      recoveryCount(0), failedRecoveryCount(0), resetRequested(false) {
+#ifndef NATIVE_BUILD
+    taskHandle = nullptr;
+    directMutex = xSemaphoreCreateMutexStatic(&directMutexBuffer);
+#endif
+}
+
+// Ohne Tasks (Host-Build) gibt es niemanden, gegen den gesperrt werden muss
+void I2CEngine::lockDirect() {
+#ifndef NATIVE_BUILD
+    xSemaphoreTake(directMutex, portMAX_DELAY);
+#endif
+}
+
+void I2CEngine::unlockDirect() {
+#ifndef NATIVE_BUILD
+    xSemaphoreGive(directMutex);
+#endif
+}
+
+bool I2CEngine::begin(int sda, int scl, uint32_t clockHz) {
+    sdaPin = sda;
+    sclPin = scl;
+    frequency = clockHz;
+    bool ok = wire->begin(sda, scl, clockHz);
+    wire->setClock(clockHz);
+    return ok;
+}
+
+bool I2CEngine::submit(const I2CTransaction& transaction) {
+    bool queued = queue.emplace([&](I2CTransaction& slot) {
+        slot = transaction;
+        slot.status = I2C_PENDING;
+        slot.submitMicros = micros();
+    });
+#ifndef NATIVE_BUILD
+    if (queued && taskHandle) {
+        xTaskNotifyGive(taskHandle);
+    }
+#endif
+    return queued;
+}
+
+size_t I2CEngine::process(size_t maxTransactions) {
+    size_t done = 0;
+    I2CTransaction transaction;
+    while (done < maxTransactions && queue.pop(transaction)) {
+        execute(transaction);
+        done++;
+    }
+    return done;
+}
+
+I2CStatus I2CEngine::transfer(I2CTransaction& transaction) {
+    transaction.callback = nullptr;
+#ifndef NATIVE_BUILD
+    if (taskHandle && xTaskGetCurrentTaskHandle() != taskHandle) {
+        // Rückruf im I2C-Task kopiert das Ergebnis und weckt den Aufrufer.
+        // Ohne Zeitgrenze: Wire bricht selbst nach Timeout ab, der Rückruf
+        // kommt immer (und Puffer und Semaphor liegen auf diesem Stack)
+        StaticSemaphore_t semaphoreBuffer;
+        TransferWaiter waiter = { &transaction, xSemaphoreCreateBinaryStatic(&semaphoreBuffer) };
+        I2CTransaction queued = transaction;
+        queued.callback = wakeCaller;
+        queued.context = &waiter;
+        if (!submit(queued)) {
+            transaction.status = I2C_QUEUE_FULL;
+            return transaction.status;
+        }
+        xSemaphoreTake(waiter.done, portMAX_DELAY);
+        return transaction.status;
+    }
+#endif
+    // Ohne Task: zuerst, was schon wartet, damit die Reihenfolge stimmt
+    while (process() > 0) {
+    }
+    transaction.submitMicros = micros();
+    execute(transaction);
+    return transaction.status;
+}
+
+bool I2CEngine::readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t length) {
+    I2CTransaction transaction = I2CTransaction::read(address, reg, buffer, length);
+    return transfer(transaction) == I2C_OK;
+}
+
+bool I2CEngine::writeRegister(uint8_t address, uint8_t reg, uint8_t value) {
+    I2CTransaction transaction = I2CTransaction::write(address, reg, value);
+    return transfer(transaction) == I2C_OK;
+}
+
+bool I2CEngine::sendCommand(uint8_t address, uint8_t code) {
+    I2CTransaction transaction = I2CTransaction::command(address, code);
+    return transfer(transaction) == I2C_OK;
+}
+
+bool I2CEngine::receive(uint8_t address, uint8_t* buffer, uint8_t length) {
+    I2CTransaction transaction = I2CTransaction::receive(address, buffer, length);
+    return transfer(transaction) == I2C_OK;
+}
+
+// ===== Ausführung =====
+
+I2CStatus I2CEngine::perform(I2CTransaction& transaction) {
+    // Reines Lesen ohne Registeradresse geht direkt mit requestFrom()
+    if (transaction.writeLength > 0 || transaction.readLength == 0) {
+        wire->beginTransmission(transaction.address);
+        wire->write(transaction.writeData, transaction.writeLength);
+        uint8_t result = wire->endTransmission(transaction.readLength == 0);
+        if (result != 0) {
+            return (I2CStatus)result;
+        }
+    }
+    if (transaction.readLength == 0) {
+        return I2C_OK;
+    }
+    uint8_t received = wire->requestFrom(transaction.address, transaction.readLength);
+    for (uint8_t i = 0; i < received; i++) {
+        transaction.readBuffer[i] = (uint8_t)wire->read();
+    }
+    return received == transaction.readLength ? I2C_OK : I2C_SHORT_READ;
+}
+
+// Timeout/Busfehler immer; sonst nur, wenn SDA tatsächlich low hängt
+// (beim Lesen mit Repeated Start meldet Wire den Fehler erst in requestFrom())
+bool I2CEngine::needsRecovery(I2CStatus status) {
+    if (status == I2C_OK || status == I2C_NACK_ADDRESS || sdaPin < 0 || sclPin < 0) {
+        return false;
+    }
+    return status == I2C_BUS_ERROR || status == I2C_TIMEOUT || digitalRead(sdaPin) == LOW;
+}
+
+void I2CEngine::execute(I2CTransaction& transaction) {
+    if (resetRequested.load(std::memory_order_relaxed)) {
+        latencyUs.reset();
+        busUs.reset();
+        resetRequested.store(false, std::memory_order_relaxed);
+    }
+
+    uint32_t start = micros();
+    transaction.waitMicros = start - transaction.submitMicros;
+    transaction.attempts = 1;
+    transaction.status = perform(transaction);
+    if (needsRecovery(transaction.status) && recoverBus()) {
+        transaction.attempts = 2;
+        transaction.status = perform(transaction);
+    }
+    uint32_t end = micros();
+    transaction.busMicros = end - start;
+
+    latencyUs.add(end - transaction.submitMicros);
+    busUs.add(transaction.busMicros);
+    completedCount++;
+    if (transaction.status != I2C_OK && transaction.status != I2C_NACK_ADDRESS) {
+        errorCount++;
+    }
+
+    if (transaction.callback) {
+        transaction.callback(transaction, transaction.context);
+    }
+}
+
+// ===== Bus-Recovery (I2C-Spezifikation 3.1.16) =====
+// Der Slave wartet auf Takte für sein angefangenes Byte; nach höchstens
+// neun Takten sieht er ein NACK und gibt SDA frei
+bool I2CEngine::recoverBus() {
+    if (sdaPin < 0 || sclPin < 0) {
+        return false;
+    }
+
+    // Für die ganze Recovery: keine Bibliothek mitten in einer Transaktion
+    DirectAccess exclusive(*this);
+    wire->end();
+    pinMode(sdaPin, INPUT_PULLUP);
+    pinMode(sclPin, OUTPUT_OPEN_DRAIN);
+    digitalWrite(sclPin, HIGH);
+    for (uint8_t i = 0; i < RECOVERY_CLOCKS && digitalRead(sdaPin) == LOW; i++) {
+        digitalWrite(sclPin, LOW);
+        delayMicroseconds(RECOVERY_HALF_PERIOD_US);
+        digitalWrite(sclPin, HIGH);
+        delayMicroseconds(RECOVERY_HALF_PERIOD_US);
+    }
+
+    bool released = digitalRead(sdaPin) == HIGH;
+    if (released) {
+        // Stop-Bedingung: SDA steigt, während SCL high ist
+        digitalWrite(sclPin, LOW);
+        pinMode(sdaPin, OUTPUT_OPEN_DRAIN);
+        digitalWrite(sdaPin, LOW);
+        delayMicroseconds(RECOVERY_HALF_PERIOD_US);
+        digitalWrite(sclPin, HIGH);
+        delayMicroseconds(RECOVERY_HALF_PERIOD_US);
+        digitalWrite(sdaPin, HIGH);
+        delayMicroseconds(RECOVERY_HALF_PERIOD_US);
+        recoveryCount++;
+    } else {
+        failedRecoveryCount++;
+    }
+
+    wire->begin(sdaPin, sclPin, frequency);
+    wire->setClock(frequency);
+    return released;
+}
+
+#ifndef NATIVE_BUILD
+void I2CEngine::wakeCaller(const I2CTransaction& transaction, void* context) {
+    TransferWaiter* waiter = (TransferWaiter*)context;
+    I2CTransaction* caller = waiter->transaction;
+    caller->status = transaction.status;
+    caller->attempts = transaction.attempts;
+    caller->submitMicros = transaction.submitMicros;
+    caller->waitMicros = transaction.waitMicros;
+    caller->busMicros = transaction.busMicros;
+    xSemaphoreGive(waiter->done);
+}
+
+// ===== I2C-Task =====
+// Schläft, bis submit() ihn weckt; arbeitet dann alles Wartende ab
+void I2CEngine::taskEntry(void* parameter) {
+    I2CEngine* self = (I2CEngine*)parameter;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (self->process() > 0) {
+        }
+    }
+}
+
+bool I2CEngine::startTask(UBaseType_t priority, BaseType_t core) {
+    if (taskHandle) {
+        return false;
+    }
+    // Was vor dem Start abgelegt wurde, noch hier ausführen
+    while (process() > 0) {
+    }
+    return xTaskCreatePinnedToCore(taskEntry, "i2c", I2C_TASK_STACK_SIZE, this,
+                                   priority, &taskHandle, core) == pdPASS;
+}
+#endif
@@ -0,0 +1,182 @@
+#ifndef I2C_ENGINE_H
+#define I2C_ENGINE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+#include "config.h"
+#include "histogram.h"
+#include "mpsc_queue.h"
+
+// Ergebnis einer Transaktion; 0..5 wie TwoWire::endTransmission()
+enum I2CStatus : uint8_t {
+    I2C_OK = 0,
+    I2C_DATA_TOO_LONG = 1,
+    I2C_NACK_ADDRESS = 2,
+    I2C_NACK_DATA = 3,
+    I2C_BUS_ERROR = 4,
+    I2C_TIMEOUT = 5,
+    I2C_SHORT_READ = 6,       // Weniger Bytes als angefordert
+    I2C_QUEUE_FULL = 7,       // Nicht angenommen
+    I2C_PENDING = 0xFF
+};
+
+struct I2CTransaction;
+typedef void (*I2CCallback)(const I2CTransaction& transaction, void* context);
+
+// ===== Beschreibung einer Transaktion =====
+// Erst schreiben (Registeradresse, ggf. Daten), dann mit Repeated Start
+// lesen; eines von beiden darf fehlen, ohne beides ist es ein Adresstest.
+// Der Lesepuffer gehört dem Auftraggeber und muss bis zum Rückruf gültig
+// bleiben. Die Zeiten trägt die Engine ein.
+struct I2CTransaction {
+    static const size_t MAX_WRITE = 8;
+
+    uint8_t address;
+    uint8_t writeLength;
+    uint8_t writeData[MAX_WRITE];
+    uint8_t readLength;
+    uint8_t* readBuffer;
+    I2CCallback callback;       // Läuft im I2C-Task, darf nicht blockieren
+    void* context;
+
+    I2CStatus status;
+    uint8_t attempts;           // 2 = nach Bus-Recovery wiederholt
+    uint32_t submitMicros;
+    uint32_t waitMicros;        // In der Warteschlange
+    uint32_t busMicros;         // Ausführung inkl. Recovery
+
+    static I2CTransaction read(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t length,
+                               I2CCallback callback = nullptr, void* context = nullptr);
+    static I2CTransaction write(uint8_t address, uint8_t reg, uint8_t value,
+                                I2CCallback callback = nullptr, void* context = nullptr);
+    static I2CTransaction probe(uint8_t address, I2CCallback callback = nullptr, void* context = nullptr);
+    // Befehlsbasierte Sensoren (SHT4x, SCD4x): Befehl ohne Daten bzw. Lesen
+    // ohne Registeradresse, das Ergebnis kommt erst nach der Messzeit
+    static I2CTransaction command(uint8_t address, uint8_t code,
+                                  I2CCallback callback = nullptr, void* context = nullptr);
+    static I2CTransaction receive(uint8_t address, uint8_t* buffer, uint8_t length,
+                                  I2CCallback callback = nullptr, void* context = nullptr);
+};
+
+// ===== I2C-Transaktionen über eine Warteschlange =====
+// Treiber legen Transaktionen mit submit() ab und kehren sofort zurück;
+// ein eigener Task höchster Sensor-Priorität führt sie nacheinander aus
+// und ruft den Rückruf auf. transfer() wartet auf das Ergebnis, der
+// Aufrufer schläft dabei auf einem Semaphor, statt den Bus selbst zu
+// bedienen. So teilen sich BME280, MPU9250-FIFO und Scan den Bus in fester
+// Reihenfolge.
+//
+// Arduino-ESP32 2.x baut auf ESP-IDF 4.4, dort gibt es die asynchrone
+// i2c_master-API (IDF 5.2) noch nicht. Der Task nutzt daher Wire, dessen
+// Treiber auf den Interrupt der Hardware wartet.
+//
+// Hält ein Slave SDA fest (Reset mitten in einem Lesezugriff), scheitert
+// jede Transaktion mit Timeout. Dann gibt die Engine den Bus frei: bis zu
+// neun Takte auf SCL per GPIO, bis der Slave sein Byte beendet hat, danach
+// eine Stop-Bedingung und Wire neu starten; die Transaktion wird einmal
+// wiederholt.
+//
+// Invariante für Wire-Zugriffe an der Engine vorbei (nur noch die
+// Adafruit-Bibliothek des BME280): Sie laufen unter DirectAccess. Wire
+// sperrt nur je Transaktion, recoverBus() schaltet Wire aber ab und
+// bedient die Pins selbst; es nimmt dafür dieselbe Sperre, unabhängig von
+// Priorität und Kern der beteiligten Tasks. Unter DirectAccess keine
+// Aufrufe der Engine: transfer() wartet sonst womöglich auf den I2C-Task,
+// der für eine Recovery auf die Sperre wartet.
+//
+// Ohne Task (Host-Build, Stromsparbetrieb) führt process() bzw. transfer()
+// die Warteschlange im aufrufenden Task aus.
+class I2CEngine {
+private:
+    TwoWire* wire;
+    int sdaPin;
+    int sclPin;
+    uint32_t frequency;
+    MpscQueue<I2CTransaction, I2C_QUEUE_SIZE> queue;
+
+    // Nur vom ausführenden Task geschrieben
+    LatencyHistogram latencyUs;     // submit() bis Rückruf
+    LatencyHistogram busUs;         // Ausführung auf dem Bus
+    uint32_t completedCount;
+    uint32_t errorCount;
+    uint32_t recoveryCount;
+    uint32_t failedRecoveryCount;
+    std::atomic<bool> resetRequested;
+
+#ifndef NATIVE_BUILD
+    SemaphoreHandle_t directMutex;   // Direkte Wire-Zugriffe gegen recoverBus()
+    StaticSemaphore_t directMutexBuffer;
+#endif
+
+    I2CStatus perform(I2CTransaction& transaction);
+    void execute(I2CTransaction& transaction);
+    bool needsRecovery(I2CStatus status);
+
+#ifndef NATIVE_BUILD
+    TaskHandle_t taskHandle;
+    static void taskEntry(void* parameter);
+    static void wakeCaller(const I2CTransaction& transaction, void* context);
+#endif
+
+public:
+    explicit I2CEngine(TwoWire& bus);
+
+    bool begin(int sda, int scl, uint32_t clockHz);
+
+    // Von jedem Task; false wenn die Warteschlange voll ist (gezählt)
+    bool submit(const I2CTransaction& transaction);
+    // Wartende Transaktionen ausführen (I2C-Task bzw. ohne Task der Aufrufer);
+    // Rückgabe: Anzahl ausgeführter Transaktionen
+    size_t process(size_t maxTransactions = I2C_QUEUE_SIZE);
+    // Ausführen und auf das Ergebnis warten; der Rückruf wird nicht benutzt
+    I2CStatus transfer(I2CTransaction& transaction);
+
+    bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, uint8_t length);
+    bool writeRegister(uint8_t address, uint8_t reg, uint8_t value);
+    bool sendCommand(uint8_t address, uint8_t code);
+    bool receive(uint8_t address, uint8_t* buffer, uint8_t length);
+
+    // SDA freitakten und Wire neu starten; true wenn SDA danach high ist.
+    // Wartet, bis kein DirectAccess mehr besteht
+    bool recoverBus();
+
+    // ===== Direkter Zugriff auf Wire (Bibliotheken) =====
+    void lockDirect();
+    void unlockDirect();
+
+    class DirectAccess {
+    private:
+        I2CEngine& engine;
+        DirectAccess(const DirectAccess&);
+        DirectAccess& operator=(const DirectAccess&);
+
+    public:
+        explicit DirectAccess(I2CEngine& bus) : engine(bus) { engine.lockDirect(); }
+        ~DirectAccess() { engine.unlockDirect(); }
+    };
+
+#ifndef NATIVE_BUILD
+    bool startTask(UBaseType_t priority, BaseType_t core);
+    bool isTaskRunning() const { return taskHandle != nullptr; }
+#else
+    bool isTaskRunning() const { return false; }
+#endif
+
+    // Momentaufnahme aus dem ausführenden Task (ohne Sperre, ein gerade
+    // eingetragener Wert kann fehlen); resetStats() wirkt dort vor dem
+    // nächsten Eintrag
+    const LatencyHistogram& getLatencyStats() const { return latencyUs; }
+    const LatencyHistogram& getBusStats() const { return busUs; }
+    void resetStats() { resetRequested.store(true, std::memory_order_relaxed); }
+    uint32_t getCompletedCount() const { return completedCount; }
+    uint32_t getErrorCount() const { return errorCount; }
+    uint32_t getRecoveryCount() const { return recoveryCount; }
+    uint32_t getFailedRecoveryCount() const { return failedRecoveryCount; }
+    uint32_t getDroppedCount() const { return queue.getDroppedCount(); }
+};
+
+// Gemeinsamer Bus der Sensoren (über Wire)
+extern I2CEngine i2cBus;
+
+#endif
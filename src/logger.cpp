@@ -1,7 +1,168 @@
 #include "logger.h"
-#include <stdarg.h>
 
-LogLevel Logger::currentLevel = LOG_INFO;
+MpscQueue<LogRecord, LOG_QUEUE_SIZE> Logger::queue;
+volatile LogLevel Logger::currentLevel = LOG_INFO;
+const size_t Logger::LINE_SIZE;
+const uint32_t Logger::MAX_BURST_BYTES;
+char Logger::line[LINE_SIZE];
+size_t Logger::lineLength = 0;
+uint32_t Logger::bytesBudget = 0;
+unsigned long Logger::lastRefillMs = 0;
+uint32_t Logger::reportedDrops = 0;
+uint32_t Logger::writtenCount = 0;
+uint64_t Logger::bytesWritten = 0;
+bool Logger::binaryOutput = LOG_BINARY;
+uint32_t Logger::framesWritten = 0;
+uint32_t Logger::lastFrameMs = 0;
+uint32_t Logger::lastAbsoluteMs = 0;
+
+// ===== Argumente erfassen (aufrufender Task) =====
+
+void LogRecord::addSigned(int64_t value) {
+    if (argCount >= LOG_MAX_ARGS) return;
+    types[argCount] = ARG_INT;
+    args[argCount++].i = value;
+}
+
+void LogRecord::addUnsigned(uint64_t value) {
+    if (argCount >= LOG_MAX_ARGS) return;
+    types[argCount] = ARG_UINT;
+    args[argCount++].u = value;
+}
+
+void LogRecord::addDouble(double value) {
+    if (argCount >= LOG_MAX_ARGS) return;
+    types[argCount] = ARG_DOUBLE;
+    args[argCount++].d = value;
+}
+
+// Kopie in den Puffer der Meldung; was nicht passt, wird abgeschnitten
+void LogRecord::addString(const char* value) {
+    if (argCount >= LOG_MAX_ARGS) return;
+    types[argCount] = ARG_STRING;
+    size_t room = LOG_STRING_BYTES - stringBytes;
+    if (room == 0) {
+        // Puffer voll: auf die letzte Endnull zeigen, leere Zeichenkette
+        args[argCount++].u = stringBytes - 1;
+        return;
+    }
+    args[argCount++].u = stringBytes;
+    size_t length = value ? strnlen(value, room - 1) : 0;
+    memcpy(strings + stringBytes, value ? value : "", length);
+    strings[stringBytes + length] = '\0';
+    stringBytes += length + 1;
+}
+
+void LogRecord::addPointer(const void* value) {
+    if (argCount >= LOG_MAX_ARGS) return;
+    types[argCount] = ARG_POINTER;
+    args[argCount++].p = value;
+}
+
+// ===== Formatieren (Log-Task) =====
+// Das Format wird Spezifikation für Spezifikation abgearbeitet; Längenangaben
+// (l, ll, h, z ...) ergeben sich aus dem gespeicherten Typ und werden durch
+// "ll" bzw. nichts ersetzt. Stern-Breiten werden nicht unterstützt.
+
+static size_t appendText(char* output, size_t outputSize, size_t length, const char* text, size_t count) {
+    if (length < outputSize) {
+        size_t room = outputSize - length - 1;
+        memcpy(output + length, text, count < room ? count : room);
+        output[length + (count < room ? count : room)] = '\0';
+    }
+    return length + count;
+}
+
+int LogRecord::formatMessage(char* output, size_t outputSize) const {
+    size_t length = 0;
+    uint8_t argIndex = 0;
+    const char* p = format;
+    if (outputSize > 0) {
+        output[0] = '\0';
+    }
+
+    while (*p) {
+        if (*p != '%' || p[1] == '%') {
+            const char* next = *p == '%' ? p + 1 : p;
+            size_t count = *p == '%' ? 1 : strcspn(p, "%");
+            length = appendText(output, outputSize, length, next, count);
+            p += *p == '%' ? 2 : count;
+            continue;
+        }
+
+        // %[Flags][Breite][.Genauigkeit][Länge]Umwandlung
+        const char* start = p++;
+        char spec[24];
+        size_t n = 0;
+        spec[n++] = '%';
+        while (*p && strchr("-+ #0123456789.", *p) && n < sizeof(spec) - 4) {
+            spec[n++] = *p++;
+        }
+        while (*p && strchr("hlLqjzt", *p)) {
+            p++;
+        }
+        char conversion = *p;
+        if (!conversion) {
+            break;
+        }
+        p++;
+        if (argIndex >= argCount) {
+            length = appendText(output, outputSize, length, start, p - start);
+            continue;
+        }
+
+        const Value& value = args[argIndex];
+        uint8_t type = types[argIndex++];
+        char* dest = length < outputSize ? output + length : nullptr;
+        size_t room = length < outputSize ? outputSize - length : 0;
+        int written = 0;
+
+        switch (conversion) {
+            case 'd': case 'i': {
+                spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = 'd'; spec[n] = '\0';
+                long long v = type == ARG_UINT ? (long long)value.u :
+                              type == ARG_DOUBLE ? (long long)value.d : (long long)value.i;
+                written = snprintf(dest, room, spec, v);
+                break;
+            }
+            case 'u': case 'x': case 'X': case 'o': {
+                spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conversion; spec[n] = '\0';
+                unsigned long long v = type == ARG_INT ? (unsigned long long)value.i :
+                                       type == ARG_DOUBLE ? (unsigned long long)value.d : value.u;
+                written = snprintf(dest, room, spec, v);
+                break;
+            }
+            case 'c':
+                spec[n++] = 'c'; spec[n] = '\0';
+                written = snprintf(dest, room, spec, (int)value.i);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                spec[n++] = conversion; spec[n] = '\0';
+                double v = type == ARG_DOUBLE ? value.d :
+                           type == ARG_UINT ? (double)value.u : (double)value.i;
+                written = snprintf(dest, room, spec, v);
+                break;
+            }
+            case 's':
+                spec[n++] = 's'; spec[n] = '\0';
+                written = snprintf(dest, room, spec, type == ARG_STRING ? strings + value.u : "?");
+                break;
+            case 'p':
+                spec[n++] = 'p'; spec[n] = '\0';
+                written = snprintf(dest, room, spec, value.p);
+                break;
+            default:
+                // Unbekannte Umwandlung: unverändert ausgeben
+                written = 0;
+                length = appendText(output, outputSize, length, start, p - start);
+                break;
+        }
+        if (written > 0) {
+            length += written;
+        }
+    }
+    return (int)length;
+}
 
 // ANSI Farbcodes für bessere Lesbarkeit
 const char* Logger::getColor(LogLevel level) {
@@ -27,112 +188,237 @@ const char* Logger::getLevelString(LogLevel level) {
 }
 
 void Logger::init(LogLevel level) {
-    Serial.begin(115200);
-    while(!Serial && millis() < 3000); // Warte max 3s auf Serial
     currentLevel = level;
-    
-    printSeparator();
-    Serial.println("\033[1;34m╔═══════════════════════════════════════╗");
-    Serial.println("║   ESP32 IoT Wetterstation v1.0       ║");
-    Serial.println("╚═══════════════════════════════════════╝\033[0m");
-    printSeparator();
+    lastRefillMs = millis();
+    bytesBudget = MAX_BURST_BYTES;
 }
 
 void Logger::setLevel(LogLevel level) {
     currentLevel = level;
 }
 
-void Logger::error(const char* tag, const char* format, ...) {
-    if (currentLevel < LOG_ERROR) return;
-    
-    char buffer[256];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    
-    Serial.printf("%s[%s] [%10lu] [%s] %s\033[0m\n", 
-                  getColor(LOG_ERROR),
-                  getLevelString(LOG_ERROR),
-                  millis(),
-                  tag,
-                  buffer);
-}
-
-void Logger::warn(const char* tag, const char* format, ...) {
-    if (currentLevel < LOG_WARN) return;
-    
-    char buffer[256];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    
-    Serial.printf("%s[%s] [%10lu] [%s] %s\033[0m\n", 
-                  getColor(LOG_WARN),
-                  getLevelString(LOG_WARN),
-                  millis(),
-                  tag,
-                  buffer);
-}
-
-void Logger::info(const char* tag, const char* format, ...) {
-    if (currentLevel < LOG_INFO) return;
-    
-    char buffer[256];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    
-    Serial.printf("%s[%s] [%10lu] [%s] %s\033[0m\n", 
-                  getColor(LOG_INFO),
-                  getLevelString(LOG_INFO),
-                  millis(),
-                  tag,
-                  buffer);
-}
-
-void Logger::debug(const char* tag, const char* format, ...) {
-    if (currentLevel < LOG_DEBUG) return;
-    
-    char buffer[256];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    
-    Serial.printf("%s[%s] [%10lu] [%s] %s\033[0m\n", 
-                  getColor(LOG_DEBUG),
-                  getLevelString(LOG_DEBUG),
-                  millis(),
-                  tag,
-                  buffer);
-}
-
-void Logger::verbose(const char* tag, const char* format, ...) {
-    if (currentLevel < LOG_VERBOSE) return;
-    
-    char buffer[256];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    
-    Serial.printf("%s[%s] [%10lu] [%s] %s\033[0m\n", 
-                  getColor(LOG_VERBOSE),
-                  getLevelString(LOG_VERBOSE),
-                  millis(),
-                  tag,
-                  buffer);
-}
-
 void Logger::printSeparator() {
-    Serial.println("═══════════════════════════════════════════════════════");
+    LOG_PRINT_I("═══════════════════════════════════════════════════════");
 }
 
 void Logger::printHeader(const char* text) {
     printSeparator();
-    Serial.printf("  %s\n", text);
+    LOG_PRINT_I("  %s", text);
     printSeparator();
-}
\ No newline at end of file
+}
+
+// ===== Ausgabe (Log-Task) =====
+
+// Zeile mit Präfix wie bisher: Farbe, Level, Zeitpunkt des Aufrufs, Tag
+size_t Logger::formatText(const LogRecord& record, char* output, size_t outputSize) {
+    static const char RESET[] = "\033[0m\n";
+    if (outputSize < 64) {
+        return 0;
+    }
+    size_t prefix = 0;
+    LogLevel level = (LogLevel)record.level;
+    if (record.tag) {
+        prefix = snprintf(output, outputSize, "%s[%s] [%10lu] [%s] ", getColor(level),
+                          getLevelString(level), (unsigned long)record.timestamp, record.tag);
+        if (prefix >= outputSize / 2) prefix = outputSize / 2;
+    }
+    // Platz für Farbende und Zeilenumbruch freihalten
+    size_t room = outputSize - prefix - sizeof(RESET);
+    int written = record.formatMessage(output + prefix, room);
+    size_t length = prefix + (written < 0 ? 0 : (size_t)written < room ? (size_t)written : room - 1);
+    if (record.tag) {
+        memcpy(output + length, RESET, sizeof(RESET));
+        length += sizeof(RESET) - 1;
+    } else {
+        output[length++] = '\n';
+        output[length] = '\0';
+    }
+    return length;
+}
+
+// ===== Binärer Rahmen =====
+
+static size_t putVarint(uint8_t* p, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        p[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    p[n++] = (uint8_t)value;
+    return n;
+}
+
+size_t Logger::encodeFrame(const LogRecord& record, uint8_t* output, size_t outputSize,
+                           const uint32_t* previousMs) {
+    // Nutzdaten: höchstens 4 + 1 + 5 + 4 + 8 * 10 + LOG_STRING_BYTES + 8 Bytes
+    uint8_t payload[4 + 1 + 5 + LOG_MAX_ARGS / 2 + LOG_MAX_ARGS * 10 + LOG_STRING_BYTES + LOG_MAX_ARGS];
+    size_t n = 0;
+    for (int i = 0; i < 4; i++) {
+        payload[n++] = (uint8_t)(record.token >> (8 * i));
+    }
+    if (previousMs) {
+        // Abstand zum vorigen Rahmen, meist ein Byte (ZigZag: Aufrufer können
+        // sich zwischen millis() und Warteschlange überholen)
+        int32_t delta = (int32_t)(record.timestamp - *previousMs);
+        payload[n++] = (uint8_t)(LOG_FRAME_RELATIVE | record.level << 4 | record.argCount);
+        n += putVarint(payload + n, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+    } else {
+        payload[n++] = (uint8_t)(record.level << 4 | record.argCount);
+        n += putVarint(payload + n, record.timestamp);
+    }
+
+    size_t typesAt = n;
+    n += (record.argCount + 1) / 2;
+    memset(payload + typesAt, 0, n - typesAt);
+    for (uint8_t i = 0; i < record.argCount; i++) {
+        const LogRecord::Value& value = record.args[i];
+        uint8_t wire;
+        switch (record.types[i]) {
+            case LogRecord::ARG_INT:
+                wire = LOG_WIRE_INT;
+                n += putVarint(payload + n, ((uint64_t)value.i << 1) ^ (uint64_t)(value.i >> 63));
+                break;
+            case LogRecord::ARG_UINT:
+                wire = LOG_WIRE_UINT;
+                n += putVarint(payload + n, value.u);
+                break;
+            case LogRecord::ARG_DOUBLE: {
+                // float reicht für Messwerte; nur wenn verlustfrei
+                float single = (float)value.d;
+                if ((double)single == value.d) {
+                    wire = LOG_WIRE_FLOAT;
+                    memcpy(payload + n, &single, sizeof(single));
+                    n += sizeof(single);
+                } else {
+                    wire = LOG_WIRE_DOUBLE;
+                    memcpy(payload + n, &value.d, sizeof(value.d));
+                    n += sizeof(value.d);
+                }
+                break;
+            }
+            case LogRecord::ARG_STRING: {
+                wire = LOG_WIRE_STRING;
+                const char* text = record.strings + value.u;
+                size_t length = value.u < LOG_STRING_BYTES ? strlen(text) : 0;
+                payload[n++] = (uint8_t)length;
+                memcpy(payload + n, text, length);
+                n += length;
+                break;
+            }
+            default:
+                wire = LOG_WIRE_POINTER;
+                n += putVarint(payload + n, (uint64_t)(uintptr_t)value.p);
+                break;
+        }
+        payload[typesAt + i / 2] |= wire << (4 * (i % 2));
+    }
+
+    // COBS: jede Null durch den Abstand zur nächsten ersetzen
+    if (outputSize < n + n / 254 + 3) {
+        return 0;
+    }
+    size_t out = 0;
+    output[out++] = LOG_FRAME_DELIMITER;
+    size_t codeAt = out++;
+    uint8_t code = 1;
+    for (size_t i = 0; i < n; i++) {
+        if (payload[i] == 0) {
+            output[codeAt] = code;
+            codeAt = out++;
+            code = 1;
+        } else {
+            output[out++] = payload[i];
+            if (++code == 0xFF) {
+                output[codeAt] = code;
+                codeAt = out++;
+                code = 1;
+            }
+        }
+    }
+    output[codeAt] = code;
+    output[out++] = LOG_FRAME_DELIMITER;
+    return out;
+}
+
+void Logger::prepareLine(const LogRecord& record) {
+    if (binaryOutput || !record.format) {
+        // Absolute Zeit spätestens jede Sekunde, damit ein später gestarteter
+        // Decoder schnell die richtige Uhrzeit hat
+        bool relative = framesWritten > 0 && record.timestamp - lastAbsoluteMs < LOG_FRAME_ABSOLUTE_MS;
+        lineLength = encodeFrame(record, (uint8_t*)line, sizeof(line), relative ? &lastFrameMs : nullptr);
+        if (!relative) {
+            lastAbsoluteMs = record.timestamp;
+        }
+        lastFrameMs = record.timestamp;
+        framesWritten++;
+    } else {
+        lineLength = formatText(record, line, sizeof(line));
+    }
+}
+
+// Budget wächst mit LOG_SERIAL_BYTES_PER_S, gedeckelt auf MAX_BURST_BYTES
+void Logger::refillBudget(unsigned long now) {
+    uint32_t added = (uint32_t)((uint64_t)(now - lastRefillMs) * LOG_SERIAL_BYTES_PER_S / 1000);
+    if (added == 0) {
+        return;
+    }
+    lastRefillMs = now;
+    bytesBudget = bytesBudget + added > MAX_BURST_BYTES ? MAX_BURST_BYTES : bytesBudget + added;
+}
+
+bool Logger::process(size_t maxRecords) {
+    refillBudget(millis());
+    size_t handled = 0;
+    for (;;) {
+        if (lineLength == 0) {
+            // Verworfene Meldungen einmal melden, bevor es weitergeht
+            uint32_t drops = queue.getDroppedCount();
+            if (drops != reportedDrops) {
+                lineLength = snprintf(line, sizeof(line), "⚠️  %lu Log-Meldung(en) verworfen (Puffer voll)\n",
+                                      (unsigned long)(drops - reportedDrops));
+                reportedDrops = drops;
+            } else {
+                LogRecord record;
+                if (handled >= maxRecords || !queue.pop(record)) {
+                    break;
+                }
+                prepareLine(record);
+                handled++;
+                if (lineLength == 0) {
+                    continue;
+                }
+            }
+        }
+        // Nur ganze Zeilen, damit direkte Serial-Ausgaben nicht mitten hinein geraten
+        if (lineLength > bytesBudget) {
+            return true;
+        }
+        Serial.write((const uint8_t*)line, lineLength);
+        bytesBudget -= lineLength;
+        bytesWritten += lineLength;
+        lineLength = 0;
+        writtenCount++;
+    }
+    return lineLength > 0 || queue.size() > 0;
+}
+
+void Logger::flush(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (process() && millis() - start < timeoutMs) {
+        delay(10);
+    }
+}
+
+#ifndef NATIVE_BUILD
+void Logger::taskEntry(void* parameter) {
+    for (;;) {
+        process();
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL_MS));
+    }
+}
+
+bool Logger::startTask(UBaseType_t priority, BaseType_t core) {
+    return xTaskCreatePinnedToCore(taskEntry, "log", LOG_TASK_STACK_SIZE, nullptr,
+                                   priority, nullptr, core) == pdPASS;
+}
+#endif
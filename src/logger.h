@@ -2,6 +2,10 @@
 #define LOGGER_H
 
 #include <Arduino.h>
+#include <type_traits>
+#include "config.h"
+#include "mpsc_queue.h"
+#include "fnv1a.h"
 
 // Log Levels
 enum LogLevel {
@@ -12,31 +16,238 @@ enum LogLevel {
     LOG_VERBOSE = 4
 };
 
+#define LOG_MAX_ARGS 8        // Argumente je Meldung, weitere werden ignoriert
+#define LOG_STRING_BYTES 32   // Platz für kopierte Zeichenketten je Meldung
+#define LOG_LINE_SIZE 320     // Längste Zeile bzw. längster Rahmen
+
+// ===== Token einer Aufrufstelle =====
+// FNV-1a über Tag, Trennzeichen 0x1F und Format; wird in den Makros zur
+// Übersetzungszeit berechnet. Der Decoder auf dem Host (native/tools)
+// berechnet dieselben Werte aus den Quelltexten.
+constexpr uint32_t logToken(const char* tag, const char* format) {
+    return fnv1a(format, fnv1aByte(fnv1a(tag ? tag : ""), 0x1F));
+}
+
+// ===== Unformatierte Meldung =====
+// Format und Tag müssen String-Literale sein (es wird nur der Zeiger
+// gespeichert); Zeichenketten-Argumente werden kopiert, da sie meist auf
+// dem Stack liegen. Formatiert wird erst beim Ausgeben.
+struct LogRecord {
+    enum ArgType : uint8_t { ARG_INT, ARG_UINT, ARG_DOUBLE, ARG_STRING, ARG_POINTER };
+
+    union Value {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const void* p;
+    };
+
+    const char* tag;               // nullptr = Zeile ohne Präfix (z.B. Tabellen)
+    const char* format;            // Beide nullptr mit LOG_BINARY
+    uint32_t token;                // logToken(tag, format)
+    uint32_t timestamp;            // millis() beim Aufruf
+    uint8_t level;
+    uint8_t argCount;
+    uint8_t stringBytes;
+    uint8_t types[LOG_MAX_ARGS];
+    Value args[LOG_MAX_ARGS];      // ARG_STRING: Position in strings
+    char strings[LOG_STRING_BYTES];
+
+    void addSigned(int64_t value);
+    void addUnsigned(uint64_t value);
+    void addDouble(double value);
+    void addString(const char* value);
+    void addPointer(const void* value);
+
+    // Nach Typ des Arguments (wie die Promotion bei printf)
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    add(T value) {
+        if (std::is_signed<T>::value || std::is_enum<T>::value) {
+            addSigned((int64_t)value);
+        } else {
+            addUnsigned((uint64_t)value);
+        }
+    }
+    void add(double value) { addDouble(value); }
+    void add(const char* value) { addString(value); }
+    void add(char* value) { addString(value); }
+    template <typename T>
+    void add(const T* value) { addPointer(value); }
+
+    // Text der Meldung ohne Präfix; Rückgabe wie snprintf
+    int formatMessage(char* output, size_t outputSize) const;
+};
+
+// ===== Binäres Format =====
+// Rahmen: 0x00, COBS(Nutzdaten), 0x00 – die Nutzdaten enthalten danach
+// keine Null mehr, Text auf derselben Leitung bleibt lesbar und der
+// Decoder findet nach Störungen wieder in den Takt. Nutzdaten:
+//   Token (4 Bytes LE), Level << 4 | Anzahl Argumente, millis() (Varint;
+//   mit LOG_FRAME_RELATIVE im Kopfbyte Abstand zum vorigen Rahmen, ZigZag),
+//   Typen (4 Bit je Argument), Werte: ganze Zahlen als Varint (vorzeichen-
+//   behaftet mit ZigZag), Gleitkomma als float wenn verlustfrei, sonst
+//   double, Zeichenketten mit Längenbyte
+enum LogWireType : uint8_t {
+    LOG_WIRE_INT = 0,
+    LOG_WIRE_UINT = 1,
+    LOG_WIRE_FLOAT = 2,
+    LOG_WIRE_STRING = 3,
+    LOG_WIRE_POINTER = 4,
+    LOG_WIRE_DOUBLE = 5
+};
+
+#define LOG_FRAME_DELIMITER 0x00
+#define LOG_FRAME_RELATIVE 0x80        // Bit im Kopfbyte: Zeit relativ
+#define LOG_FRAME_ABSOLUTE_MS 1000     // Spätestens so oft absolute Zeit
+
+// ===== Logger mit Ringpuffer =====
+// Die Aufrufer legen nur eine LogRecord (Zeiger + Rohwerte) in eine
+// lock-freie Warteschlange und kehren sofort zurück – kein vsnprintf,
+// kein Warten auf den UART. Ein eigener Task niedrigster Priorität
+// formatiert und schreibt die Meldungen, höchstens LOG_SERIAL_BYTES_PER_S
+// (der Rest der UART-Bandbreite bleibt für direkte Serial-Ausgaben). Ist
+// der Puffer voll, wird die Meldung verworfen und gezählt.
+//
+// Meldungen über DEBUG_LEVEL werden gar nicht erst übersetzt (Makros
+// unten, Auswahl per Template); darunter filtert setLevel() zur Laufzeit.
+// Mit LOG_BINARY gehen statt Text nur Token und Rohwerte hinaus, die
+// Format-Strings landen nicht im Flash.
 class Logger {
 private:
-    static LogLevel currentLevel;
+    static MpscQueue<LogRecord, LOG_QUEUE_SIZE> queue;
+    static volatile LogLevel currentLevel;
+
+    static const size_t LINE_SIZE = LOG_LINE_SIZE;
+    // Budget für höchstens 250 ms am Stück, mindestens eine Zeile
+    static const uint32_t MAX_BURST_BYTES =
+        LOG_SERIAL_BYTES_PER_S / 4 > LINE_SIZE ? LOG_SERIAL_BYTES_PER_S / 4 : LINE_SIZE;
+
+    // Nur vom ausgebenden Task benutzt
+    static char line[LINE_SIZE];
+    static size_t lineLength;           // 0 = keine Zeile wartet auf Budget
+    static uint32_t bytesBudget;
+    static unsigned long lastRefillMs;
+    static uint32_t reportedDrops;
+    static uint32_t writtenCount;
+    static uint64_t bytesWritten;
+    static bool binaryOutput;
+    static uint32_t framesWritten;
+    static uint32_t lastFrameMs;        // Zeitstempel des vorigen Rahmens
+    static uint32_t lastAbsoluteMs;     // ... des letzten mit absoluter Zeit
+
     static const char* getLevelString(LogLevel level);
     static const char* getColor(LogLevel level);
-    
+
+    static bool enabled(LogLevel level) { return level <= currentLevel; }
+    static void capture(LogRecord&) {}
+    template <typename T, typename... Args>
+    static void capture(LogRecord& record, const T& first, const Args&... rest) {
+        record.add(first);
+        capture(record, rest...);
+    }
+
+    // Level über DEBUG_LEVEL: leerer Rumpf, es bleibt nichts übrig
+    template <typename... Args>
+    static void write(std::false_type, LogLevel, uint32_t, const char*, const char*, const Args&...) {}
+    template <typename... Args>
+    static void write(std::true_type, LogLevel level, uint32_t token, const char* tag,
+                      const char* format, const Args&... args) {
+        if (!enabled(level)) return;
+        queue.emplace([&](LogRecord& record) {
+            record.tag = tag;
+            record.format = format;
+            record.token = token;
+            record.timestamp = millis();
+            record.level = level;
+            record.argCount = 0;
+            record.stringBytes = 0;
+            capture(record, args...);
+        });
+    }
+
+    static void prepareLine(const LogRecord& record);
+    static void refillBudget(unsigned long now);
+
+#ifndef NATIVE_BUILD
+    static void taskEntry(void* parameter);
+#endif
+
 public:
     static void init(LogLevel level = LOG_INFO);
     static void setLevel(LogLevel level);
-    
-    static void error(const char* tag, const char* format, ...);
-    static void warn(const char* tag, const char* format, ...);
-    static void info(const char* tag, const char* format, ...);
-    static void debug(const char* tag, const char* format, ...);
-    static void verbose(const char* tag, const char* format, ...);
-    
+    static LogLevel getLevel() { return currentLevel; }
+
+    // Zur Übersetzungszeit: Level überhaupt vorhanden?
+    static constexpr bool isCompiledIn(LogLevel level) { return level <= DEBUG_LEVEL; }
+
+    // Aufruf über die Makros (Token wird dort berechnet)
+    template <LogLevel LEVEL, typename... Args>
+    static void log(uint32_t token, const char* tag, const char* format, const Args&... args) {
+        write(std::integral_constant<bool, (LEVEL <= DEBUG_LEVEL)>(), LEVEL, token, tag, format, args...);
+    }
+
     static void printSeparator();
     static void printHeader(const char* text);
+
+    // Ausgabe: höchstens maxRecords Meldungen und nur im Rahmen des
+    // Byte-Budgets; true wenn noch Meldungen warten. Läuft auf dem ESP32 im
+    // Log-Task, im Host-Build aus loop().
+    static bool process(size_t maxRecords = LOG_QUEUE_SIZE);
+    // Wartet, bis alles ausgegeben ist (vor Deep Sleep/Neustart)
+    static void flush(uint32_t timeoutMs = 1000);
+#ifndef NATIVE_BUILD
+    static bool startTask(UBaseType_t priority, BaseType_t core);
+#endif
+
+    // Ausgabe als Text oder binär; mit LOG_BINARY immer binär
+    static void setBinaryOutput(bool enabled) { binaryOutput = enabled || LOG_BINARY; }
+    static bool isBinaryOutput() { return binaryOutput; }
+    // Zeile mit Präfix wie in der Textausgabe bzw. binärer Rahmen;
+    // Rückgabe: Länge (höchstens outputSize - 1)
+    static size_t formatText(const LogRecord& record, char* output, size_t outputSize);
+    // previousMs: Zeit relativ dazu übertragen, nullptr = absolut
+    static size_t encodeFrame(const LogRecord& record, uint8_t* output, size_t outputSize,
+                              const uint32_t* previousMs = nullptr);
+
+    static uint32_t getDroppedCount() { return queue.getDroppedCount(); }
+    static uint32_t getWrittenCount() { return writtenCount; }
+    static uint64_t getBytesWritten() { return bytesWritten; }
+    static size_t getPendingCount() { return queue.size(); }
 };
 
-// Makros für einfache Nutzung
-#define LOG_E(tag, format, ...) Logger::error(tag, format, ##__VA_ARGS__)
-#define LOG_W(tag, format, ...) Logger::warn(tag, format, ##__VA_ARGS__)
-#define LOG_I(tag, format, ...) Logger::info(tag, format, ##__VA_ARGS__)
-#define LOG_D(tag, format, ...) Logger::debug(tag, format, ##__VA_ARGS__)
-#define LOG_V(tag, format, ...) Logger::verbose(tag, format, ##__VA_ARGS__)
+// Nur als Format-Prüfung durch den Compiler, wird nie aufgerufen
+inline void logCheckFormat(const char* format, ...) __attribute__((format(printf, 1, 2)));
+inline void logCheckFormat(const char*, ...) {}
+
+#if LOG_BINARY
+#define LOG_TEXT(literal) nullptr
+#else
+#define LOG_TEXT(literal) literal
+#endif
+#define LOG_TOKEN(tag, format) std::integral_constant<uint32_t, logToken(tag, format)>::value
+
+// Tag und Format müssen String-Literale sein (Token zur Übersetzungszeit)
+#define LOG_AT(level, tag, format, ...) \
+    do { \
+        if (Logger::isCompiledIn(level)) { \
+            if (false) logCheckFormat(format, ##__VA_ARGS__); \
+            Logger::log<level>(LOG_TOKEN(tag, format), LOG_TEXT(tag), LOG_TEXT(format), ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+// Makros für einfache Nutzung; LOG_PRINT_x ohne Präfix (Tabellen, JSON).
+// Oberhalb von DEBUG_LEVEL werden die Argumente noch geprüft, aber weder
+// ausgewertet noch übersetzt.
+#define LOG_E(tag, format, ...) LOG_AT(LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define LOG_W(tag, format, ...) LOG_AT(LOG_WARN, tag, format, ##__VA_ARGS__)
+#define LOG_I(tag, format, ...) LOG_AT(LOG_INFO, tag, format, ##__VA_ARGS__)
+#define LOG_D(tag, format, ...) LOG_AT(LOG_DEBUG, tag, format, ##__VA_ARGS__)
+#define LOG_V(tag, format, ...) LOG_AT(LOG_VERBOSE, tag, format, ##__VA_ARGS__)
+#define LOG_PRINT_E(format, ...) LOG_AT(LOG_ERROR, nullptr, format, ##__VA_ARGS__)
+#define LOG_PRINT_W(format, ...) LOG_AT(LOG_WARN, nullptr, format, ##__VA_ARGS__)
+#define LOG_PRINT_I(format, ...) LOG_AT(LOG_INFO, nullptr, format, ##__VA_ARGS__)
+#define LOG_PRINT_D(format, ...) LOG_AT(LOG_DEBUG, nullptr, format, ##__VA_ARGS__)
+#define LOG_PRINT_V(format, ...) LOG_AT(LOG_VERBOSE, nullptr, format, ##__VA_ARGS__)
 
-#endif
\ No newline at end of file
+#endif
@@ -2,28 +2,111 @@
 #include <WiFi.h>
 #include "config.h"
 #include "sensors.h"
+#include "i2c_engine.h"
 #include "wifi_setup.h"
 #include "mqtt.h"
+#include "telemetry_batch.h"
+#include "telemetry_filter.h"
+#include "offline_store.h"
+#include "spsc_queue.h"
+#include "mpu_stream.h"
+#include "vibration.h"
+#include "power_manager.h"
+#include "logger.h"
+#include "metrics.h"
+#include "sample_scheduler.h"
 #include "sas.h"  //SAS Authentifizierung (Schicht 3: SAS)
 
 // ===== Globale Objekte =====
 // Diese Objekte werden im gesamten Programm verwendet
-Sensors sensors;           // Verwaltet BME280 und MPU9250 Sensoren
-WifiManager wifiManager;   // Verwaltet WLAN-Verbindung und NTP-Zeit
+Sensors sensors;           // Sensortreiber (BME280, MPU9250, weitere aus sensor_drivers.h)
+WifiManager wifiManager;   // Verwaltet WLAN-Verbindung und Uhrzeit (SNTP)
 MQTTClient mqttClient;     // Verwaltet MQTT-Kommunikation mit Azure IoT Hub
-SensorData data;           // Struktur zum Speichern der Sensordaten
+TelemetryBatch telemetryBatch;  // Sammelt Messwerte für gemeinsames Senden
+TelemetryBatch backfillBatch;   // Nachzusendende Messwerte aus dem Offline-Speicher
+TelemetryFilter telemetryFilter;  // Unterdrückt Messwerte ohne nennenswerte Änderung
+OfflineStore offlineStore;      // Sichert Messwerte während MQTT-Ausfällen im Flash
+MPU9250Stream mpuStream;        // Hochratige Beschleunigungsdaten über den MPU9250-FIFO
+#if MPU_STREAM_ENABLED
+VibrationAnalyzer vibration;    // Schwingungskennwerte aus dem FIFO-Stream (FFT-Puffer, ca. 9 KB)
+#endif
+PowerManager powerManager;      // Deep Sleep und Energiebilanz (LOW_POWER_MODE)
+Metrics metrics;                // Laufzeit-Kennzahlen für den Device Twin (Netzwerk-Task)
+SampleScheduler sampleScheduler;  // Eigener Takt für BME280 und MPU9250 (Sensor-Task)
+SensorData latestSample;        // Letzte Werte beider Sensoren (nur Sensor-Task)
+
+// Messwerte vom Sensor-Task (Kern 1) zum Netzwerk-Task (Kern 0)
+SpscQueue<SensorData, SAMPLE_QUEUE_SIZE> sampleQueue;
+#if MPU_STREAM_ENABLED
+// Schwingungsberichte vom FIFO-Task zum Netzwerk-Task
+SpscQueue<VibrationFeatures, 4> vibrationQueue;
+#endif
+volatile uint32_t sensorErrors = 0;     // Nur vom Sensor-Task geschrieben
 
 // ===== Timing-Variablen =====
 // Speichern Zeitpunkte für periodische Aufgaben
-unsigned long lastSensorRead = 0;   // Letzter Zeitpunkt der Sensordatenerfassung
-unsigned long lastTimeUpdate = 0;   // Letzter Zeitpunkt der NTP-Zeitaktualisierung
+unsigned long lastBackfill = 0;     // Letzter Zeitpunkt des Nachsendens aus dem Offline-Speicher
+
+// Nachgesendeter Batch ohne PUBACK: der Offline-Speicher wird erst mit der
+// Bestätigung quittiert, bis dahin wird nichts weiter geladen
+bool backfillInFlight = false;
+uint32_t backfillTag = 0;
+
+#ifndef NATIVE_BUILD
+void sensorTask(void* parameter);
+void networkTask(void* parameter);
+#endif
+void lowPowerCycle();
+
+#if MPU_STREAM_ENABLED
+// Bericht der Schwingungsanalyse an den Netzwerk-Task übergeben; die
+// UTC-Zeit wird hier (FIFO-Task) aus dem Zeitpunkt des letzten Werts bestimmt
+void queueVibrationReport(const VibrationFeatures& features, void* context) {
+    (void)context;
+    VibrationFeatures stamped = features;
+    stamped.endEpochMicros = wifiManager.getTimeService().toEpochMicros(features.endMicros);
+    vibrationQueue.push(stamped);
+}
+#endif
+
+// PUBACK einer Nachricht mit Kennung (Netzwerk-Task, aus mqttClient.loop();
+// bei QoS 0 direkt aus publishBatch())
+void onTelemetryDelivered(uint32_t tag, void* context) {
+    (void)context;
+    if (backfillInFlight && tag == backfillTag) {
+        offlineStore.acknowledge();
+        backfillInFlight = false;
+    }
+}
+
+// Mit loadPending() geladenen Rückstand senden; quittiert wird in
+// onTelemetryDelivered(), nach einem Abbruch wiederholt ihn qos1
+bool publishBackfill() {
+    if (++backfillTag == MQTTClient::NO_DELIVERY_TAG) {
+        backfillTag = 0;
+    }
+    backfillInFlight = true;   // Vor dem Senden: bei QoS 0 kommt die Zustellung sofort
+    if (!mqttClient.publishBatch(backfillBatch, backfillTag)) {
+        backfillInFlight = false;
+        return false;
+    }
+    return true;
+}
 
 // ===== Setup-Funktion =====
 // Wird einmalig beim Start des ESP32 ausgeführt
 void setup() {
     // Serielle Kommunikation initialisieren (115200 Baud)
     Serial.begin(115200);
+    
+#if LOW_POWER_MODE
+    // setup() läuft nach jedem Aufwachen: kein Banner, keine Wartezeiten
+    lowPowerCycle();
+    return;
+#endif
+    
     delay(2000);  // Warten damit Serial Monitor bereit ist
+    Logger::init((LogLevel)DEBUG_LEVEL);
     
             
 
@@ -55,6 +138,12 @@ void setup() {
     Serial.printf("  Chip ID: %llX\n", ESP.getEfuseMac());        // Eindeutige Chip-ID
     Serial.println();
     
+#ifndef NATIVE_BUILD
+    // ===== I2C-Task starten =====
+    // Vor den Sensoren: Scan und Registerzugriffe laufen schon über ihn
+    i2cBus.startTask(I2C_TASK_PRIORITY, I2C_TASK_CORE);
+#endif
+    
     // ===== Sensoren initialisieren =====
     if (!sensors.begin()) {
         // Fehler bei Sensor-Initialisierung (z.B. Sensor nicht angeschlossen)
@@ -62,6 +151,48 @@ void setup() {
         Serial.println("   Programm läuft trotzdem weiter (nur WLAN-Test)");
         // Programm wird nicht beendet, damit WLAN-Funktionalität getestet werden kann
     }
+    // Messwerte erhalten beim Auslesen die UTC-Zeit des Zeitdienstes
+    sensors.setClock(&wifiManager.getTimeService());
+    // Gruppen ohne gefundenen Sensor gar nicht erst planen (sonst Lesefehler je Takt)
+    uint8_t present = sensors.getRegistry().presentGroups();
+    sampleScheduler.begin((present & SENSOR_GROUP_ENVIRONMENT ? 1 << SAMPLE_GROUP_BME : 0) |
+                          (present & SENSOR_GROUP_MOTION ? 1 << SAMPLE_GROUP_MPU : 0));
+    
+    // ===== Offline-Speicher initialisieren =====
+    // Ohne Flash-Speicher gehen Messwerte bei MQTT-Ausfall verloren
+    if (!offlineStore.begin()) {
+        Serial.println("⚠️  Offline-Speicher nicht verfügbar");
+    }
+    
+    // ===== MPU9250 FIFO-Streaming starten =====
+#if MPU_STREAM_ENABLED
+    // Blöcke gehen direkt in die Schwingungsanalyse (läuft im FIFO-Task)
+    vibration.begin(VIBRATION_WINDOWS_PER_REPORT);
+    vibration.onReport(queueVibrationReport);
+    mpuStream.onBlock(VibrationAnalyzer::blockHandler, &vibration);
+    mpuStream.setAddress(sensors.getRegistry().getAddress<Mpu9250Driver>());
+    if (sensors.isMPU9250Ready() &&
+        mpuStream.begin(MPU_STREAM_RATE_HZ, MPU_STREAM_WITH_GYRO, MPU_STREAM_BLOCK_SIZE)) {
+#ifndef NATIVE_BUILD
+        mpuStream.startTask(MPU_INT_PIN, MPU_STREAM_TASK_PRIORITY, SENSOR_TASK_CORE);
+#endif
+    }
+#endif
+    
+#ifndef NATIVE_BUILD
+    // ===== Sensor-Task starten =====
+    // Schon vor dem WLAN-Aufbau, damit auch beim Start keine Messwerte fehlen
+    xTaskCreatePinnedToCore(sensorTask, "sensor", SENSOR_TASK_STACK_SIZE, nullptr,
+                            SENSOR_TASK_PRIORITY, nullptr, SENSOR_TASK_CORE);
+#endif
+    
+    metrics.begin(millis());
+    
+    // ===== C2D-Befehle registrieren =====
+    mqttClient.onCommand(TelemetryFilter::commandHandler, &telemetryFilter);
+    mqttClient.onCommand(SampleScheduler::commandHandler, &sampleScheduler);
+    mqttClient.onCommand(WifiManager::commandHandler, &wifiManager);
+    mqttClient.onDelivered(onTelemetryDelivered);
     
     // ===== WLAN initialisieren =====
     if (!wifiManager.begin()) {
@@ -105,19 +236,219 @@ void setup() {
     Serial.println("================\n");
         
     Serial.println("\n✅ Setup abgeschlossen!");
-    Serial.println("   Starte Hauptschleife...\n");
+    Serial.println("   Starte Netzwerk-Task...\n");
     
     delay(2000);  // Kurze Pause vor Start der Loop
+
+#ifndef NATIVE_BUILD
+    // Ab hier gehen Messwert-Ausgaben über den Log-Task
+    Logger::startTask(LOG_TASK_PRIORITY, LOG_TASK_CORE);
+    xTaskCreatePinnedToCore(networkTask, "network", NETWORK_TASK_STACK_SIZE, nullptr,
+                            NETWORK_TASK_PRIORITY, nullptr, NETWORK_TASK_CORE);
+#endif
 }
 
-// ===== Loop-Funktion =====
-// Wird kontinuierlich wiederholt nach Setup
-void loop() {
+// ===== Messzyklus (Sensor-Task) =====
+// Liest die fälligen Sensoren und legt den Messwert in die Warteschlange;
+// nicht gelesene Sensoren gehen mit ihrem letzten Wert mit.
+// Keine Serial-Ausgabe (nur Logger) und kein Netzwerkzugriff, damit der Takt stabil bleibt.
+void sampleSensors() {
+    unsigned long scheduledMs = 0;
+    uint8_t groups = sampleScheduler.due(millis(), scheduledMs);
+    if (groups == 0) {
+        return;
+    }
+    
+    // Status-LED einschalten während Datenerfassung
+    digitalWrite(LED_PIN, HIGH);
+    
+    bool ok = sensors.readSelected(latestSample, groups & (1 << SAMPLE_GROUP_BME),
+                                   groups & (1 << SAMPLE_GROUP_MPU));
+    latestSample.scheduledMillis = scheduledMs;
+    sampleScheduler.observe(latestSample, groups, latestSample.timestamp);
+    if (ok) {
+        // Bei voller Warteschlange wird der Messwert verworfen und gezählt
+        sampleQueue.push(latestSample);
+    } else {
+        sensorErrors++;
+        LOG_W("Sensor", "⚠️  Fehler beim Auslesen der Sensoren");
+    }
+    
+    // Status-LED wieder ausschalten
+    digitalWrite(LED_PIN, LOW);
+}
+
+// ===== Konsolen-Ausgabe eines Messwerts (Netzwerk-Task) =====
+// Geht über den Logger: hier werden nur Meldungen in den Ringpuffer gelegt,
+// die ~2 KB Text schreibt der Log-Task im Hintergrund auf den UART
+void printSample(const SensorData& data, unsigned long epoch, long jitterMs, bool publish) {
+    // ===== Formatierte Konsolen-Ausgabe =====
+    // Kopfzeile mit System-Status
+    LOG_PRINT_I("╔════════════════════════════════════════════════════════╗");
+    LOG_PRINT_I("║ Zeit: %-15s | Uptime: %10lu ms      ║",
+                wifiManager.getFormattedTime().c_str(),  // Aktuelle Uhrzeit
+                data.timestamp);                         // Laufzeit bei der Messung
+    LOG_PRINT_I("║ Epoch: %-12lu | Heap: %10d bytes    ║",
+                epoch,                                   // Unix-Timestamp der Messung
+                ESP.getFreeHeap());                      // Freier RAM-Speicher
+    LOG_PRINT_I("║ WLAN: %-10s | RSSI: %4d dBm                ║",
+                wifiManager.isConnected() ? "Verbunden" : "Getrennt",
+                WiFi.RSSI());                            // WLAN-Signalstärke
+    LOG_PRINT_I("║ MQTT: %-10s | Azure IoT Hub                ║",
+                mqttClient.isConnected() ? "Verbunden" : "Getrennt");
+    LOG_PRINT_I("║ Takt: %+6ld ms Jitter | Queue: %2u, %4lu verw.   ║",
+                jitterMs,                                // Abweichung vom geplanten Messzeitpunkt
+                (unsigned)sampleQueue.size(),            // Wartende Messwerte
+                (unsigned long)sampleQueue.getDroppedCount());
+    LOG_PRINT_I("║ Filter: %-9s | %6lu gesendet, %6lu unterdr. ║",
+                !telemetryFilter.isEnabled() ? "aus" : publish ? "senden" : "unterdr.",
+                (unsigned long)telemetryFilter.getPassedCount(),
+                (unsigned long)telemetryFilter.getSuppressedCount());
+    LOG_PRINT_I("║ Ausfälle: WLAN %3lu, MQTT %3lu | Versuche: %5lu         ║",
+                (unsigned long)wifiManager.getReconnectStats().getOutageCount(),
+                (unsigned long)mqttClient.getReconnectStats().getOutageCount(),
+                (unsigned long)(wifiManager.getReconnectStats().getAttemptCount() +
+                                mqttClient.getReconnectStats().getAttemptCount()));
+    if (mpuStream.isRunning()) {
+        LOG_PRINT_I("║ FIFO: %4u Hz | %9lu Werte | %4lu Überläufe    ║",
+                    mpuStream.getRateHz(),
+                    (unsigned long)mpuStream.getSampleCount(),
+                    (unsigned long)mpuStream.getOverflowCount());
+    }
+    LOG_PRINT_I("╠════════════════════════════════════════════════════════╣");
+    
+    // ===== BME280 Umwelt-Sensor Daten =====
+    if (data.bme280Valid) {
+        // Sensor hat gültige Daten geliefert
+        LOG_PRINT_I("║ BME280 - Umwelt-Sensor                                 ║");
+        LOG_PRINT_I("╟────────────────────────────────────────────────────────╢");
+        LOG_PRINT_I("║   🌡️  Temperatur:   %6.2f °C                        ║", data.temperature);
+        LOG_PRINT_I("║   💧 Luftfeuchte:  %6.2f %%                         ║", data.humidity);
+        LOG_PRINT_I("║   📊 Luftdruck:    %7.2f hPa                        ║", data.pressure);
+    } else {
+        // Sensor nicht verfügbar oder Lesefehler
+        LOG_PRINT_I("║ BME280 - ❌ NICHT VERFÜGBAR                            ║");
+    }
+    
+    LOG_PRINT_I("╠════════════════════════════════════════════════════════╣");
+    
+    // ===== MPU9250 Bewegungs-Sensor Daten =====
+    if (data.mpu9250Valid) {
+        // Sensor hat gültige Daten geliefert
+        LOG_PRINT_I("║ MPU9250 - Bewegungs-Sensor                             ║");
+        LOG_PRINT_I("╟────────────────────────────────────────────────────────╢");
+        
+        // Beschleunigungsdaten (in g - Erdbeschleunigung)
+        LOG_PRINT_I("║ Beschleunigung (g):                                    ║");
+        LOG_PRINT_I("║   X: %+7.3f  |  Y: %+7.3f  |  Z: %+7.3f     ║",
+                    data.accelX, data.accelY, data.accelZ);
+        LOG_PRINT_I("╟────────────────────────────────────────────────────────╢");
+        
+        // Gyroskop-Daten (in Grad pro Sekunde)
+        LOG_PRINT_I("║ Gyroskop (°/s):                                        ║");
+        LOG_PRINT_I("║   X: %+8.2f | Y: %+8.2f | Z: %+8.2f    ║",
+                    data.gyroX, data.gyroY, data.gyroZ);
+    } else {
+        // Sensor nicht verfügbar oder Lesefehler
+        LOG_PRINT_I("║ MPU9250 - ❌ NICHT VERFÜGBAR                           ║");
+    }
+    
+    // ===== Weitere Sensoren (Zusatzkanäle der Treiber) =====
+    if (data.extraCount > 0) {
+        LOG_PRINT_I("╠════════════════════════════════════════════════════════╣");
+        for (uint8_t i = 0; i < data.extraCount; i++) {
+            const SensorChannelInfo& info = SensorDriverRegistry::channel(data.extra[i].channel);
+            LOG_PRINT_I("║   %-16s %10.2f %-4s                      ║",
+                        info.name, data.extra[i].value, info.unit);
+        }
+    }
+    
+    LOG_PRINT_I("╚════════════════════════════════════════════════════════╝");
+    
+    // ===== JSON-Vorschau =====
+    // Zeigt wie die Daten als JSON an Azure IoT Hub gesendet werden;
+    // Schlüssel und Nachkommastellen aus der Kanal-Tabelle der Treiber
+    LOG_PRINT_D("\nJSON Format (für Azure IoT Hub):");
+    LOG_PRINT_D("{");
+    LOG_PRINT_D("  \"timestamp\": %lu,", epoch);
+    if (data.epochMicros != 0) {
+        LOG_PRINT_D("  \"timestampUs\": %llu,", (unsigned long long)data.epochMicros);
+    }
+    uint8_t last = 0;
+    for (uint8_t c = 0; c < SensorDriverRegistry::CHANNEL_COUNT; c++) {
+        if (SensorDriverRegistry::channel(c).field || data.findExtra(c)) {
+            last = c;
+        }
+    }
+    for (uint8_t c = 0; c <= last; c++) {
+        const SensorChannelInfo& info = SensorDriverRegistry::channel(c);
+        const SensorRecord* extra = info.field ? nullptr : data.findExtra(c);
+        if (!info.field && !extra) {
+            continue;
+        }
+        float value = info.field ? data.*info.field : extra->value;
+        const char* separator = c < last ? "," : "";
+        if (info.decimals > 2) {
+            LOG_PRINT_D("  \"%s\": %.3f%s", info.name, value, separator);
+        } else {
+            LOG_PRINT_D("  \"%s\": %.2f%s", info.name, value, separator);
+        }
+    }
+    LOG_PRINT_D("}\n");
+}
+
+// ===== Laufzeit-Kennzahlen (Netzwerk-Task) =====
+// Eigene Histogramme aus Metrics, dazu die Zähler der übrigen Komponenten
+void reportMetrics(unsigned long now) {
+    MetricsReport report;
+    metrics.collect(report, now);
+    report.serializeUs = Metrics::summarize(mqttClient.getSerializeStats());
+    report.publishUs = Metrics::summarize(mqttClient.getPublishStats());
+    report.pubackUs = Metrics::summarize(mqttClient.getQos1Stats().getAckStats());
+    mqttClient.resetLatencyStats();
+    report.i2cUs = Metrics::summarize(i2cBus.getLatencyStats());
+    i2cBus.resetStats();
+    
+    const ReconnectScheduler& wifiStats = wifiManager.getReconnectStats();
+    const ReconnectScheduler& mqttStats = mqttClient.getReconnectStats();
+    const TlsClient& tls = mqttClient.getTlsStats();
+    const TimeService& clock = wifiManager.getTimeService();
+    report.rssi = WiFi.RSSI();
+    report.wifiOutages = wifiStats.getOutageCount();
+    report.wifiAttempts = wifiStats.getAttemptCount();
+    report.roams = wifiManager.getRoamCount();
+    report.mqttOutages = mqttStats.getOutageCount();
+    report.mqttAttempts = mqttStats.getAttemptCount();
+    report.publishFailures = mqttClient.getPublishFailureCount();
+    report.retransmits = mqttClient.getQos1Stats().getRetransmitCount();
+    report.inFlightMax = mqttClient.getQos1Stats().getMaxInFlight();
+    report.tlsFull = tls.getFullStats().count;
+    report.tlsResumed = tls.getResumedStats().count;
+    report.tlsMaxMs = tls.getFullStats().maxMs > tls.getResumedStats().maxMs ?
+                      tls.getFullStats().maxMs : tls.getResumedStats().maxMs;
+    report.timeSyncs = clock.getSyncCount();
+    report.timeTimeouts = clock.getTimeoutCount();
+    report.sensorErrors = sensorErrors;
+    report.samplesDropped = sampleQueue.getDroppedCount();
+    report.i2cErrors = i2cBus.getErrorCount();
+    report.i2cRecoveries = i2cBus.getRecoveryCount();
+    report.logDropped = Logger::getDroppedCount();
+    
+    mqttClient.publishMetrics(report);
+}
+
+// ===== Netzwerk-Zyklus (Netzwerk-Task) =====
+// WLAN/MQTT/NTP pflegen, Messwerte aus der Warteschlange übernehmen und senden.
+// WLAN-Reconnect blockiert nicht mehr, der MQTT-Verbindungsaufbau (TLS) schon –
+// die Abtastung läuft davon unabhängig weiter.
+void networkCycle() {
     // Aktuelle Zeit in Millisekunden seit Programmstart
     unsigned long currentMillis = millis();
+    unsigned long cycleStart = micros();
     
     // ===== WLAN-Überwachung =====
-    // Prüft WLAN-Verbindung und stellt sie bei Bedarf wieder her
+    // Prüft WLAN-Verbindung und stellt sie bei Bedarf wieder her (Backoff),
+    // bei bestehender Verbindung auch der SNTP-Abgleich (nicht blockierend)
     wifiManager.handleReconnect();
     
     // ===== MQTT-Verarbeitung =====
@@ -131,112 +462,255 @@ void loop() {
     // Benötigt aktuelle Zeit für neues SAS-Token
     mqttClient.handleReconnect(wifiManager.getEpochTime());
     
-    // ===== NTP-Zeit aktualisieren =====
-    // Alle 10 Sekunden (10000 ms) die Zeit vom NTP-Server aktualisieren
-    if (currentMillis - lastTimeUpdate >= 10000) {
-        lastTimeUpdate = currentMillis;
-        wifiManager.updateTime();
-    }
-    
-    // ===== Sensordaten auslesen und senden =====
-    // Wird alle SENSOR_READ_INTERVAL_MS ausgeführt (z.B. alle 5 Sekunden)
-    if (currentMillis - lastSensorRead >= SENSOR_READ_INTERVAL_MS) {
-        lastSensorRead = currentMillis;
+    // ===== Messwerte aus dem Sensor-Task übernehmen =====
+    SensorData data;
+    while (sampleQueue.pop(data)) {
+        // Zeitstempel vom Auslesen; war die Uhr da noch nicht gestellt,
+        // auf den Messzeitpunkt zurückrechnen (Wert kann in der
+        // Warteschlange gewartet haben, während das Netzwerk blockiert war)
+        unsigned long epoch = (unsigned long)(data.epochMicros / 1000000ULL);
+        if (data.epochMicros == 0) {
+            epoch = wifiManager.getEpochTime();
+            unsigned long ageSeconds = (millis() - data.timestamp) / 1000;
+            if (epoch > ageSeconds) {
+                epoch -= ageSeconds;
+            }
+        }
         
-        // Status-LED einschalten während Datenerfassung
-        digitalWrite(LED_PIN, HIGH);
+        long jitterMs = (long)(data.timestamp - data.scheduledMillis);
+        metrics.recordSample(data);
         
-        // Sensoren auslesen
-        if (sensors.readAll(data)) {
-            // Datenerfassung erfolgreich
-            
-            // ===== Formatierte Konsolen-Ausgabe =====
-            // Kopfzeile mit System-Status
-            Serial.println("╔════════════════════════════════════════════════════════╗");
-            Serial.printf ("║ Zeit: %-15s | Uptime: %10lu ms      ║\n", 
-                          wifiManager.getFormattedTime().c_str(),  // Aktuelle Uhrzeit
-                          currentMillis);                          // Laufzeit seit Start
-            Serial.printf ("║ Epoch: %-12lu | Heap: %10d bytes    ║\n",
-                          wifiManager.getEpochTime(),              // Unix-Timestamp
-                          ESP.getFreeHeap());                      // Freier RAM-Speicher
-            Serial.printf ("║ WLAN: %-10s | RSSI: %4d dBm                ║\n",
-                          wifiManager.isConnected() ? "Verbunden" : "Getrennt",
-                          WiFi.RSSI());                            // WLAN-Signalstärke
-            Serial.printf ("║ MQTT: %-10s | Azure IoT Hub                ║\n",
-                          mqttClient.isConnected() ? "Verbunden" : "Getrennt");
-            Serial.println("╠════════════════════════════════════════════════════════╣");
-            
-            // ===== BME280 Umwelt-Sensor Daten =====
-            if (data.bme280Valid) {
-                // Sensor hat gültige Daten geliefert
-                Serial.println("║ BME280 - Umwelt-Sensor                                 ║");
-                Serial.println("╟────────────────────────────────────────────────────────╢");
-                Serial.printf ("║   🌡️  Temperatur:   %6.2f °C                        ║\n", data.temperature);
-                Serial.printf ("║   💧 Luftfeuchte:  %6.2f %%                         ║\n", data.humidity);
-                Serial.printf ("║   📊 Luftdruck:    %7.2f hPa                        ║\n", data.pressure);
-            } else {
-                // Sensor nicht verfügbar oder Lesefehler
-                Serial.println("║ BME280 - ❌ NICHT VERFÜGBAR                            ║");
-            }
-            
-            Serial.println("╠════════════════════════════════════════════════════════╣");
-            
-            // ===== MPU9250 Bewegungs-Sensor Daten =====
-            if (data.mpu9250Valid) {
-                // Sensor hat gültige Daten geliefert
-                Serial.println("║ MPU9250 - Bewegungs-Sensor                             ║");
-                Serial.println("╟────────────────────────────────────────────────────────╢");
-                
-                // Beschleunigungsdaten (in g - Erdbeschleunigung)
-                Serial.println("║ Beschleunigung (g):                                    ║");
-                Serial.printf ("║   X: %+7.3f  |  Y: %+7.3f  |  Z: %+7.3f     ║\n", 
-                               data.accelX, data.accelY, data.accelZ);
-                Serial.println("╟────────────────────────────────────────────────────────╢");
-                
-                // Gyroskop-Daten (in Grad pro Sekunde)
-                Serial.println("║ Gyroskop (°/s):                                        ║");
-                Serial.printf ("║   X: %+8.2f | Y: %+8.2f | Z: %+8.2f    ║\n", 
-                               data.gyroX, data.gyroY, data.gyroZ);
-            } else {
-                // Sensor nicht verfügbar oder Lesefehler
-                Serial.println("║ MPU9250 - ❌ NICHT VERFÜGBAR                           ║");
-            }
-            
-            Serial.println("╚════════════════════════════════════════════════════════╝");
-            
-            // ===== JSON-Vorschau =====
-            // Zeigt wie die Daten als JSON an Azure IoT Hub gesendet werden
-            Serial.println("\nJSON Format (für Azure IoT Hub):");
-            Serial.println("{");
-            Serial.printf("  \"timestamp\": %lu,\n", wifiManager.getEpochTime());
-            Serial.printf("  \"temperature\": %.2f,\n", data.temperature);
-            Serial.printf("  \"humidity\": %.2f,\n", data.humidity);
-            Serial.printf("  \"pressure\": %.2f,\n", data.pressure);
-            Serial.printf("  \"accelX\": %.3f,\n", data.accelX);
-            Serial.printf("  \"accelY\": %.3f,\n", data.accelY);
-            Serial.printf("  \"accelZ\": %.3f,\n", data.accelZ);
-            Serial.printf("  \"gyroX\": %.2f,\n", data.gyroX);
-            Serial.printf("  \"gyroY\": %.2f,\n", data.gyroY);
-            Serial.printf("  \"gyroZ\": %.2f\n", data.gyroZ);
-            Serial.println("}\n");
-            
-            // ===== Daten an Azure IoT Hub senden =====
-            // Nur wenn MQTT-Verbindung aktiv ist
-            if (mqttClient.isConnected()) {
-                // Sendet komplette Sensordaten als JSON-Telemetrie
-                mqttClient.publishTelemetry(data, wifiManager.getEpochTime());
+        // ===== Report-by-Exception =====
+        // Unveränderte Messwerte werden nur angezeigt, nicht gesendet
+        bool publish = telemetryFilter.shouldPublish(data);
+        printSample(data, epoch, jitterMs, publish);
+        
+        // ===== Messwert für Azure IoT Hub vormerken =====
+        // Gesendet wird gesammelt (siehe TELEMETRY_BATCH_SIZE)
+        if (publish) {
+            telemetryBatch.add(data, epoch);
+        }
+    }
+    
+#if MPU_STREAM_ENABLED
+    // ===== Schwingungskennwerte senden =====
+    // Nur online; die Berichte sind Momentaufnahmen und werden nicht nachgesendet
+    VibrationFeatures features;
+    while (vibrationQueue.pop(features)) {
+        unsigned long epoch = (unsigned long)(features.endEpochMicros / 1000000ULL);
+        if (features.endEpochMicros == 0) {
+            epoch = wifiManager.getEpochTime();
+            unsigned long ageSeconds = (millis() - features.endMillis) / 1000;
+            if (epoch > ageSeconds) {
+                epoch -= ageSeconds;
             }
-            
+        }
+        mqttClient.publishVibration(features, epoch);
+    }
+#endif
+    
+    // ===== Gesammelte Daten an Azure IoT Hub senden =====
+    // Wenn Batch voll oder ältester Messwert zu alt ist
+    currentMillis = millis();
+    bool flushed = false;
+    if (telemetryBatch.shouldFlush(currentMillis)) {
+        if (mqttClient.isConnected() && mqttClient.publishBatch(telemetryBatch)) {
+            telemetryBatch.clear();
+            flushed = true;
+        } else if (offlineStore.push(telemetryBatch)) {
+            // Keine Verbindung: im Flash sichern statt zu verwerfen
+            LOG_I("Offline", "💾 %u Messwert(e) offline gespeichert (%lu ausstehend)",
+                  (unsigned)telemetryBatch.size(), (unsigned long)offlineStore.pending());
+            telemetryBatch.clear();
+        }
+    }
+    
+    // ===== Offline gespeicherte Daten nachsenden =====
+    // Gedrosselt und nie im selben Durchlauf wie aktuelle Messwerte,
+    // damit die Live-Telemetrie Vorrang behält
+    // (höchstens ein Batch unbestätigt unterwegs)
+    if (!flushed && !backfillInFlight && offlineStore.pending() > 0 && mqttClient.isConnected() &&
+        currentMillis - lastBackfill >= OFFLINE_BACKFILL_INTERVAL_MS) {
+        lastBackfill = currentMillis;
+        
+        // Beschädigte Datensätze (0 geladen) werden direkt quittiert
+        if (offlineStore.loadPending(backfillBatch) == 0) {
+            offlineStore.acknowledge();
         } else {
-            // Fehler beim Auslesen der Sensoren
-            Serial.println("⚠️  Fehler beim Auslesen der Sensoren");
+            publishBackfill();
+        }
+    }
+    
+#if METRICS_ENABLED
+    // ===== Laufzeit-Kennzahlen an den Device Twin =====
+    if (metrics.reportDue(currentMillis) && mqttClient.isConnected()) {
+        reportMetrics(currentMillis);
+    }
+#endif
+    metrics.recordLoop(micros() - cycleStart);
+}
+
+// ===== Stromsparbetrieb: Verbindung aufbauen =====
+// WLAN, NTP (Uhr im RTC-Speicher nachstellen) und MQTT
+bool lowPowerConnect() {
+    powerManager.setPhase(POWER_RADIO);
+    if (!wifiManager.begin()) {
+        return false;
+    }
+    
+    unsigned long epoch = wifiManager.getEpochTime();
+    if (epoch > 0) {
+        powerManager.syncEpoch(epoch);
+    }
+    mqttClient.onDelivered(onTelemetryDelivered);
+    return mqttClient.begin(powerManager.getEpochTime());
+}
+
+// ===== Stromsparbetrieb: gesammelte Messwerte senden =====
+// Ohne Verbindung wandern die Messwerte aus dem RTC-Speicher in den
+// Offline-Speicher und werden beim nächsten erfolgreichen Uplink nachgesendet
+void lowPowerUplink(bool connected) {
+    if (!offlineStore.begin()) {
+        Serial.println("⚠️  Offline-Speicher nicht verfügbar");
+    }
+    
+    // Ein Batch nach dem anderen, jeweils bis zum PUBACK: was nicht bestätigt
+    // ist, geht in den Offline-Speicher, bevor die RTC-Werte verworfen werden
+    // (QoS-1-Fenster und Verbindung sind mit dem Deep Sleep weg)
+    bool delivered = connected;
+    for (size_t offset = 0; offset < powerManager.sampleCount(); ) {
+        size_t loaded = powerManager.loadSamples(telemetryBatch, offset);
+        delivered = delivered && mqttClient.publishBatch(telemetryBatch) &&
+                    mqttClient.waitForAcks(MQTT_PUBACK_TIMEOUT_MS);
+        if (!delivered) {
+            offlineStore.push(telemetryBatch);
         }
+        offset += loaded;
+    }
+    powerManager.clearSamples();
+    telemetryBatch.clear();
+    
+    if (!connected) {
+        Serial.printf("💾 Offline, %lu Messwert(e) ausstehend\n", (unsigned long)offlineStore.pending());
+        return;
+    }
+    if (!delivered) {
+        Serial.printf("⚠️  Ohne PUBACK, %lu Messwert(e) ausstehend\n", (unsigned long)offlineStore.pending());
+        mqttClient.disconnect();
+        wifiManager.disconnect();
+        return;
+    }
+    
+    // Rückstand begrenzt nachsenden, damit ein Uplink nicht beliebig lange
+    // dauert. Ein Batch nach dem anderen: der Offline-Speicher quittiert nur
+    // den zuletzt geladenen Bereich, und zwar erst mit dem PUBACK
+    backfillInFlight = false;   // Pakete eines früheren Uplinks sind mit dem Deep Sleep verloren
+    for (int i = 0; i < 4 && offlineStore.pending() > 0; i++) {
+        if (offlineStore.loadPending(backfillBatch) == 0) {
+            offlineStore.acknowledge();
+            continue;
+        }
+        if (!publishBackfill() || !mqttClient.waitForAcks(MQTT_PUBACK_TIMEOUT_MS) || backfillInFlight) {
+            break;
+        }
+    }
+    
+    PowerReport report = powerManager.getReport();
+    if (report.samples > 0 && mqttClient.publishPowerReport(report, powerManager.getEpochTime())) {
+        powerManager.markReported();
+    }
+    
+    // QoS 1: erst trennen, wenn der Hub alles bestätigt hat
+    if (!mqttClient.waitForAcks(MQTT_PUBACK_TIMEOUT_MS)) {
+        Serial.printf("⚠️  %u Nachricht(en) ohne PUBACK\n", (unsigned)mqttClient.getQos1Stats().getInFlightCount());
+    }
+    mqttClient.disconnect();
+    wifiManager.disconnect();
+}
+
+// ===== Stromsparbetrieb: ein Wachzyklus =====
+// Messen, im RTC-Speicher ablegen, ggf. senden, schlafen. Auf dem ESP32
+// endet der Zyklus im Deep Sleep und beginnt nach dem Aufwachen mit setup().
+void lowPowerCycle() {
+    powerManager.begin();
+    sensors.beginLowPower(LOW_POWER_INTERVAL_S * 1000UL);
+    
+    SensorData data;
+    if (!sensors.readForced(data)) {
+        Serial.println("⚠️  Fehler beim Auslesen der Sensoren");
+    }
+    
+    // Ohne gültige Uhrzeit (Kaltstart) zuerst synchronisieren
+    bool connected = false;
+    bool attempted = false;
+    if (powerManager.getEpochTime() == 0) {
+        connected = lowPowerConnect();
+        attempted = true;
+    }
+    
+    if (data.bme280Valid) {
+        unsigned long epoch = powerManager.getEpochTime();
+        unsigned long ageSeconds = (millis() - data.timestamp) / 1000;
+        powerManager.storeSample(data, epoch > ageSeconds ? epoch - ageSeconds : epoch);
+        Serial.printf("🌡️  %.2f °C | %.2f %% | %.2f hPa (%u/%u)\n",
+                      data.temperature, data.humidity, data.pressure,
+                      (unsigned)powerManager.sampleCount(), (unsigned)LOW_POWER_SAMPLES_PER_UPLINK);
+    }
+    
+    if (powerManager.uplinkDue() || attempted) {
+        if (!attempted) {
+            connected = lowPowerConnect();
+        }
+        lowPowerUplink(connected);
+        powerManager.setPhase(POWER_CPU);
+    }
+    
+    powerManager.sleepUntilNext(LOW_POWER_INTERVAL_S * 1000UL);
+}
+
+#ifndef NATIVE_BUILD
+// ===== Sensor-Task =====
+// Schläft bis zum nächsten Termin der adaptiven Abtastung; die Termine
+// sind absolut (ab dem geplanten Zeitpunkt), daher kein Drift. Neue
+// Grenzen per C2D greifen spätestens beim nächsten Aufwachen.
+void sensorTask(void* parameter) {
+    for (;;) {
+        sampleSensors();
+        vTaskDelay(pdMS_TO_TICKS(sampleScheduler.msUntilDue(millis())));
+    }
+}
+
+// ===== Netzwerk-Task =====
+void networkTask(void* parameter) {
+    for (;;) {
+        networkCycle();
         
-        // Status-LED wieder ausschalten
-        digitalWrite(LED_PIN, LOW);
+        // ===== Kleine Pause =====
+        // Verhindert zu hohe CPU-Last und ermöglicht WiFi-Stack-Verarbeitung
+        delay(10);
     }
+}
+#endif
+
+// ===== Loop-Funktion =====
+// Auf dem ESP32 läuft die Arbeit in sensorTask/networkTask; der
+// Arduino-Loop-Task wird nicht mehr gebraucht und beendet sich.
+// Im Host-Build (ohne FreeRTOS) werden beide Zyklen nacheinander ausgeführt.
+void loop() {
+#if LOW_POWER_MODE
+    // Nur im Host-Build erreichbar: ein Aufruf = ein Wachzyklus
+    lowPowerCycle();
+    return;
+#endif
     
-    // ===== Kleine Pause =====
-    // Verhindert zu hohe CPU-Last und ermöglicht WiFi-Stack-Verarbeitung
+#ifdef NATIVE_BUILD
+    mpuStream.service();
+    sampleSensors();
+    i2cBus.process();
+    networkCycle();
+    Logger::process();
     delay(10);
-}
\ No newline at end of file
+#else
+    vTaskDelete(NULL);
+#endif
+}
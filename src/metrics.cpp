@@ -0,0 +1,54 @@
+#include "metrics.h"
+
+Metrics::Metrics() : minLargestFreeBlock(UINT32_MAX), intervalStartMs(0) {}
+
+void Metrics::begin(unsigned long now) {
+    loopUs.reset();
+    bmeReadUs.reset();
+    mpuReadUs.reset();
+    minLargestFreeBlock = UINT32_MAX;
+    intervalStartMs = now;
+}
+
+void Metrics::recordSample(const SensorData& data) {
+    if (data.bme280Fresh && data.bme280Valid) {
+        bmeReadUs.add(data.bmeReadMicros);
+    }
+    if (data.mpu9250Fresh && data.mpu9250Valid) {
+        mpuReadUs.add(data.mpuReadMicros);
+    }
+    sampleHeap();
+}
+
+// Größter freier Block: wie weit der Heap zerstückelt ist (ein TLS-Handshake
+// braucht ~40 KB am Stück, auch wenn insgesamt genug frei ist)
+void Metrics::sampleHeap() {
+    uint32_t largest = ESP.getMaxAllocHeap();
+    if (largest < minLargestFreeBlock) {
+        minLargestFreeBlock = largest;
+    }
+}
+
+void Metrics::collect(MetricsReport& report, unsigned long now) {
+    sampleHeap();
+    report.uptimeS = now / 1000;
+    report.intervalS = (now - intervalStartMs) / 1000;
+    report.loopUs = summarize(loopUs);
+    report.bmeReadUs = summarize(bmeReadUs);
+    report.mpuReadUs = summarize(mpuReadUs);
+    report.freeHeap = ESP.getFreeHeap();
+    report.minFreeHeap = ESP.getMinFreeHeap();
+    report.largestFreeBlock = ESP.getMaxAllocHeap();
+    report.minLargestFreeBlock = minLargestFreeBlock;
+    begin(now);
+}
+
+LatencySummary Metrics::summarize(const LatencyHistogram& histogram) {
+    LatencySummary summary;
+    summary.count = histogram.getTotal();
+    summary.p50 = histogram.percentile(50);
+    summary.p90 = histogram.percentile(90);
+    summary.p99 = histogram.percentile(99);
+    summary.max = histogram.getMax();
+    return summary;
+}
@@ -0,0 +1,96 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "histogram.h"
+#include "sensors.h"
+
+// Kurzfassung eines Histogramms für den Bericht
+struct LatencySummary {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    uint32_t max;
+};
+
+// ===== Bericht der Laufzeit-Kennzahlen =====
+// Dauern gelten für das Berichtsintervall, Zähler seit dem Start
+struct MetricsReport {
+    uint32_t uptimeS;
+    uint32_t intervalS;
+
+    LatencySummary loopUs;          // Netzwerk-Zyklus
+    LatencySummary bmeReadUs;       // Auslesen BME280 (I2C + Kompensation)
+    LatencySummary mpuReadUs;       // Auslesen MPU9250
+    LatencySummary serializeUs;     // Telemetrie kodieren
+    LatencySummary publishUs;       // publish() bis zur Übergabe an TLS
+    LatencySummary pubackUs;        // QoS 1: publish() bis PUBACK
+    LatencySummary i2cUs;           // I2C-Transaktion: Übergabe bis Rückruf
+
+    uint32_t freeHeap;
+    uint32_t minFreeHeap;           // Tiefststand seit dem Start
+    uint32_t largestFreeBlock;
+    uint32_t minLargestFreeBlock;   // Tiefststand im Intervall (Fragmentierung)
+
+    int32_t rssi;
+    uint32_t wifiOutages;
+    uint32_t wifiAttempts;
+    uint32_t roams;
+    uint32_t mqttOutages;
+    uint32_t mqttAttempts;
+    uint32_t publishFailures;
+    uint32_t retransmits;           // QoS 1 mit DUP wiederholt
+    uint32_t inFlightMax;           // Höchststand unbestätigter Nachrichten
+    uint32_t tlsFull;
+    uint32_t tlsResumed;
+    uint32_t tlsMaxMs;
+    uint32_t timeSyncs;
+    uint32_t timeTimeouts;
+    uint32_t i2cErrors;
+    uint32_t i2cRecoveries;         // SDA freigetaktet
+
+    uint32_t sensorErrors;
+    uint32_t samplesDropped;
+    uint32_t logDropped;
+};
+
+// ===== Laufzeit-Kennzahlen =====
+// Sammelt im Netzwerk-Task die Dauer jedes Zyklus und das Auslesen der
+// Sensoren (Dauer kommt mit dem Messwert aus dem Sensor-Task, daher kein
+// gemeinsamer Zugriff zwischen Tasks) sowie den Heap-Tiefststand. Andere
+// Komponenten führen ihre eigenen Zähler (Reconnects, TLS, Senden); main.cpp
+// fügt sie im Bericht zusammen. Ein add() kostet ein clz und ein Inkrement,
+// der Heap wird nur je Messwert abgefragt.
+class Metrics {
+private:
+    LatencyHistogram loopUs;
+    LatencyHistogram bmeReadUs;
+    LatencyHistogram mpuReadUs;
+    uint32_t minLargestFreeBlock;
+    unsigned long intervalStartMs;
+
+public:
+    Metrics();
+
+    void begin(unsigned long now);
+
+    void recordLoop(uint32_t micros) { loopUs.add(micros); }
+    void recordSample(const SensorData& data);   // Dauer je Sensor + Heap
+    void sampleHeap();
+
+    bool reportDue(unsigned long now) const { return now - intervalStartMs >= METRICS_REPORT_INTERVAL_MS; }
+
+    // Eigene Werte eintragen und ein neues Intervall beginnen; die übrigen
+    // Felder von report bleiben unverändert
+    void collect(MetricsReport& report, unsigned long now);
+
+    static LatencySummary summarize(const LatencyHistogram& histogram);
+
+    const LatencyHistogram& getLoopStats() const { return loopUs; }
+    const LatencyHistogram& getBmeReadStats() const { return bmeReadUs; }
+    const LatencyHistogram& getMpuReadStats() const { return mpuReadUs; }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ===== Lock-freie Warteschlange (mehrere Produzenten, ein Konsument) =====
+// Wie SpscQueue, aber push() ist von beliebig vielen Tasks auf beiden
+// Kernen gleichzeitig erlaubt (z.B. Logger). Jeder Platz trägt eine
+// Sequenznummer (begrenzte Warteschlange nach D. Vyukov): ein Produzent
+// reserviert den Platz per compare_exchange auf tail, füllt ihn und gibt
+// ihn über die Sequenznummer frei. Der Konsument sieht einen Eintrag erst,
+// wenn er vollständig ist; ein langsamer Produzent hält nur die Einträge
+// hinter seinem eigenen auf, nie die anderen Produzenten.
+//
+// CAPACITY muss eine Zweierpotenz sein. Ist die Warteschlange voll,
+// verwirft push() den neuen Eintrag und zählt ihn.
+template <typename T, size_t CAPACITY>
+class MpscQueue {
+private:
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "CAPACITY muss eine Zweierpotenz sein");
+
+    struct Slot {
+        std::atomic<uint32_t> sequence;   // == Index: frei, == Index + 1: belegt
+        T item;
+    };
+
+    Slot slots[CAPACITY];
+    std::atomic<uint32_t> tail;       // Nächster Schreibindex (alle Produzenten)
+    std::atomic<uint32_t> dropped;    // Verworfene Einträge (alle Produzenten)
+    uint32_t head;                    // Nächster Leseindex (nur Konsument)
+
+    // Platz reservieren; nullptr wenn voll
+    Slot* claim(uint32_t& position) {
+        uint32_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & (CAPACITY - 1)];
+            int32_t diff = (int32_t)(slot.sequence.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    position = pos;
+                    return &slot;
+                }
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    MpscQueue() : tail(0), dropped(0), head(0) {
+        for (uint32_t i = 0; i < CAPACITY; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Von jedem Task aufrufbar, blockiert nie
+    bool push(const T& item) {
+        uint32_t pos;
+        Slot* slot = claim(pos);
+        if (!slot) {
+            return false;
+        }
+        slot->item = item;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Wie push(), aber der Eintrag wird direkt im Platz gefüllt (spart die
+    // Kopie eines großen T); fill(T&) darf nicht blockieren
+    template <typename Fill>
+    bool emplace(Fill fill) {
+        uint32_t pos;
+        Slot* slot = claim(pos);
+        if (!slot) {
+            return false;
+        }
+        fill(slot->item);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Nur vom Konsumenten aufrufen
+    bool pop(T& item) {
+        Slot& slot = slots[head & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        item = slot.item;
+        slot.sequence.store(head + CAPACITY, std::memory_order_release);
+        head++;
+        return true;
+    }
+
+    // Nur vom Konsumenten; Näherungswert, da Produzenten gleichzeitig reservieren
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head;
+    }
+
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+};
+
+#endif
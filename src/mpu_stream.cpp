@@ -0,0 +1,239 @@
+#include <esp_timer.h>
+#include "mpu_stream.h"
+
+// ===== MPU9250 Register =====
+static const uint8_t REG_SMPLRT_DIV = 0x19;
+static const uint8_t REG_CONFIG = 0x1A;
+static const uint8_t REG_GYRO_CONFIG = 0x1B;
+static const uint8_t REG_ACCEL_CONFIG = 0x1C;
+static const uint8_t REG_ACCEL_CONFIG2 = 0x1D;
+static const uint8_t REG_FIFO_EN = 0x23;
+static const uint8_t REG_INT_PIN_CFG = 0x37;
+static const uint8_t REG_INT_ENABLE = 0x38;
+static const uint8_t REG_USER_CTRL = 0x6A;
+static const uint8_t REG_PWR_MGMT_1 = 0x6B;
+static const uint8_t REG_FIFO_COUNTH = 0x72;
+static const uint8_t REG_FIFO_R_W = 0x74;
+
+static const uint8_t FIFO_EN_ACCEL = 0x08;
+static const uint8_t FIFO_EN_GYRO = 0x70;        // XG, YG, ZG
+static const uint8_t USER_CTRL_FIFO_EN = 0x40;
+static const uint8_t USER_CTRL_FIFO_RST = 0x04;
+static const uint8_t INT_PIN_CFG_BYPASS = 0x02;  // Magnetometer bleibt erreichbar
+static const uint8_t INT_ENABLE_RAW_RDY = 0x01;
+
+static const uint16_t FIFO_SIZE = 512;
+static const size_t MAX_BURST_BYTES = 120;       // Wire-Puffer des ESP32: 128 Bytes
+
+// Konstruktor: Sensor wird erst mit begin() konfiguriert
+MPU9250Stream::MPU9250Stream(I2CEngine* bus, uint8_t address)
+    : bus(bus), address(address), rateHz(0), channels(0), frameSize(0), blockSize(0),
+      running(false), handler(nullptr), handlerContext(nullptr),
+      blockCount(0), sampleCount(0), overflowCount(0), errorCount(0) {
+    block.count = 0;
+#ifndef NATIVE_BUILD
+    taskHandle = nullptr;
+    pendingSamples = 0;
+#endif
+}
+
+bool MPU9250Stream::writeRegister(uint8_t reg, uint8_t value) {
+    return bus->writeRegister(address, reg, value);
+}
+
+bool MPU9250Stream::readRegisters(uint8_t reg, uint8_t* buffer, size_t length) {
+    return bus->readRegisters(address, reg, buffer, (uint8_t)length);
+}
+
+// FIFO leeren und Block verwerfen (Zeitbezug geht verloren)
+void MPU9250Stream::resetFifo() {
+    writeRegister(REG_USER_CTRL, USER_CTRL_FIFO_RST);
+    writeRegister(REG_USER_CTRL, USER_CTRL_FIFO_EN);
+    block.count = 0;
+}
+
+// ===== Initialisierung =====
+bool MPU9250Stream::begin(uint16_t requestedRateHz, bool withGyro, uint16_t samplesPerBlock) {
+    Serial.print("MPU9250 FIFO-Streaming initialisieren... ");
+
+    if (requestedRateHz == 0 || samplesPerBlock == 0 || samplesPerBlock > MotionBlock::MAX_SAMPLES) {
+        Serial.println("FEHLER (Parameter)!");
+        return false;
+    }
+
+    // Über 1 kHz nur Accel mit 4 kHz (Gyro-FIFO ist auf 1 kHz begrenzt)
+    bool fastAccel = requestedRateHz > 1000 && !withGyro;
+    uint8_t divider = 0;
+    if (fastAccel) {
+        rateHz = ACCEL_RATE_FAST_HZ;
+    } else {
+        uint16_t rate = requestedRateHz > 1000 ? 1000 : requestedRateHz;
+        divider = (uint8_t)(1000 / rate - 1);
+        rateHz = 1000 / (divider + 1);
+    }
+
+    // Tiefpass unterhalb der halben Abtastrate (Anti-Aliasing)
+    uint8_t dlpf;
+    if (rateHz >= 500) dlpf = 1;        // 184 Hz
+    else if (rateHz >= 200) dlpf = 2;   // 92 Hz
+    else if (rateHz >= 100) dlpf = 3;   // 41 Hz
+    else dlpf = 4;                      // 20 Hz
+
+    channels = withGyro ? 6 : 3;
+    frameSize = channels * 2;
+    blockSize = samplesPerBlock;
+
+    bool ok = writeRegister(REG_PWR_MGMT_1, 0x01)              // PLL als Takt
+           && writeRegister(REG_USER_CTRL, 0x00)               // FIFO aus
+           && writeRegister(REG_FIFO_EN, 0x00)
+           && writeRegister(REG_SMPLRT_DIV, divider)
+           && writeRegister(REG_CONFIG, dlpf)                  // FIFO_MODE=0, Gyro-DLPF
+           && writeRegister(REG_GYRO_CONFIG, 0x18)             // ±2000 °/s
+           && writeRegister(REG_ACCEL_CONFIG, 0x18)            // ±16 g
+           && writeRegister(REG_ACCEL_CONFIG2, fastAccel ? 0x08 : dlpf)
+           && writeRegister(REG_INT_PIN_CFG, INT_PIN_CFG_BYPASS)
+           && writeRegister(REG_INT_ENABLE, INT_ENABLE_RAW_RDY)
+           && writeRegister(REG_FIFO_EN, FIFO_EN_ACCEL | (withGyro ? FIFO_EN_GYRO : 0));
+
+    if (!ok) {
+        Serial.println("FEHLER (I2C)!");
+        running = false;
+        return false;
+    }
+
+    resetFifo();
+    running = true;
+    Serial.printf("OK (%u Hz, %s, %u Werte/Block)\n", rateHz,
+                  withGyro ? "Accel+Gyro" : "Accel", blockSize);
+    return true;
+}
+
+void MPU9250Stream::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    writeRegister(REG_FIFO_EN, 0x00);
+    writeRegister(REG_USER_CTRL, 0x00);
+    writeRegister(REG_INT_ENABLE, 0x00);
+}
+
+void MPU9250Stream::onBlock(BlockHandler callback, void* context) {
+    handler = callback;
+    handlerContext = context;
+}
+
+// ===== FIFO auslesen =====
+size_t MPU9250Stream::service() {
+    if (!running) {
+        return 0;
+    }
+
+    uint8_t countBytes[2];
+    if (!readRegisters(REG_FIFO_COUNTH, countBytes, 2)) {
+        errorCount++;
+        return 0;
+    }
+    int64_t nowMicros = esp_timer_get_time();   // 64 Bit, läuft nicht nach 71 min über
+    uint16_t available = ((countBytes[0] & 0x1F) << 8) | countBytes[1];
+
+    // Voller FIFO = Werte verloren; kein ganzzahliges Vielfaches = Versatz
+    if (available + frameSize > FIFO_SIZE || available % frameSize != 0) {
+        overflowCount++;
+        resetFifo();
+        return 0;
+    }
+
+    size_t frames = available / frameSize;
+    uint32_t periodMicros = 1000000UL / rateHz;
+    size_t framesPerBurst = MAX_BURST_BYTES / frameSize;
+    uint8_t burst[MAX_BURST_BYTES];
+
+    for (size_t done = 0; done < frames; ) {
+        size_t chunk = frames - done < framesPerBurst ? frames - done : framesPerBurst;
+        if (!readRegisters(REG_FIFO_R_W, burst, chunk * frameSize)) {
+            // Teilweise gelesener FIFO ist nicht mehr ausgerichtet
+            errorCount++;
+            resetFifo();
+            return done;
+        }
+
+        for (size_t i = 0; i < chunk; i++) {
+            if (block.count == 0) {
+                // Letzter Wert im FIFO entspricht etwa dem Lesezeitpunkt
+                block.firstSampleMicros = nowMicros - (int64_t)(frames - 1 - (done + i)) * periodMicros;
+                block.rateHz = rateHz;
+                block.channels = channels;
+            }
+
+            const uint8_t* frame = burst + i * frameSize;
+            int16_t* sample = block.samples[block.count];
+            for (uint8_t c = 0; c < channels; c++) {
+                sample[c] = (int16_t)((frame[2 * c] << 8) | frame[2 * c + 1]);  // Big Endian
+            }
+
+            if (++block.count == blockSize) {
+                blockCount++;
+                if (handler) {
+                    handler(block, handlerContext);
+                }
+                block.count = 0;
+            }
+        }
+        done += chunk;
+    }
+
+    sampleCount += frames;
+    return frames;
+}
+
+#ifndef NATIVE_BUILD
+MPU9250Stream* MPU9250Stream::instance = nullptr;
+
+// ===== Data-Ready-ISR =====
+// Nur zählen; geweckt wird erst nach einem vollen Block
+void IRAM_ATTR MPU9250Stream::onDataReady() {
+    MPU9250Stream* self = instance;
+    if (!self || !self->taskHandle) {
+        return;
+    }
+    if (++self->pendingSamples >= self->blockSize) {
+        self->pendingSamples = 0;
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(self->taskHandle, &woken);
+        if (woken) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+// ===== Auslese-Task =====
+// Wartet auf den Interrupt; bleibt er aus (INT-Pin nicht verbunden),
+// wird nach der doppelten Blockdauer trotzdem gelesen
+void MPU9250Stream::taskEntry(void* parameter) {
+    MPU9250Stream* self = (MPU9250Stream*)parameter;
+    TickType_t timeout = pdMS_TO_TICKS(2000UL * self->blockSize / self->rateHz) + 1;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, timeout);
+        self->service();
+    }
+}
+
+bool MPU9250Stream::startTask(int interruptPin, UBaseType_t priority, BaseType_t core) {
+    if (!running || taskHandle) {
+        return false;
+    }
+
+    instance = this;
+    if (xTaskCreatePinnedToCore(taskEntry, "mpu_fifo", 4096, this, priority, &taskHandle, core) != pdPASS) {
+        taskHandle = nullptr;
+        return false;
+    }
+
+    if (interruptPin >= 0) {
+        pinMode(interruptPin, INPUT);
+        attachInterrupt(digitalPinToInterrupt(interruptPin), onDataReady, RISING);
+    }
+    return true;
+}
+#endif
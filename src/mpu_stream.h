@@ -0,0 +1,99 @@
+#ifndef MPU_STREAM_H
+#define MPU_STREAM_H
+
+#include <Arduino.h>
+#include "i2c_engine.h"
+
+// ===== Block roher MPU9250-Messwerte =====
+// Werte in Sensor-Einheiten (LSB), Reihenfolge ax, ay, az, gx, gy, gz.
+// Bei reinem Accel-Betrieb (channels == 3) sind gx..gz nicht belegt.
+struct MotionBlock {
+    static const size_t MAX_SAMPLES = 64;
+
+    int64_t firstSampleMicros;    // esp_timer_get_time() des ersten Werts (aus FIFO-Füllstand geschätzt)
+    uint16_t rateHz;              // Abtastrate des Sensors
+    uint16_t count;               // Anzahl gültiger Werte
+    uint8_t channels;             // 3 = nur Accel, 6 = Accel + Gyro
+    int16_t samples[MAX_SAMPLES][6];
+};
+
+// ===== MPU9250 FIFO-Streaming =====
+// Der Sensor tastet mit fester Rate (Sample-Rate-Divider bzw. 4 kHz Accel)
+// in seinen 512-Byte-FIFO ab. Ausgelesen wird blockweise per I2C-Burst:
+// Der MPU9250 kennt keinen FIFO-Füllstands-Interrupt, daher zählt die ISR
+// die Data-Ready-Pulse am INT-Pin und weckt den Task erst nach einem ganzen
+// Block. Dazwischen ist die CPU frei.
+//
+// Ohne angeschlossenen INT-Pin wird der FIFO nach Zeitablauf abgefragt.
+// Die Bursts gehen über die I2C-Engine und wechseln sich dort mit den
+// übrigen Sensorzugriffen ab; der Task schläft, solange der Bus arbeitet.
+class MPU9250Stream {
+public:
+    typedef void (*BlockHandler)(const MotionBlock& block, void* context);
+
+    static const uint16_t ACCEL_RATE_FAST_HZ = 4000;   // Accel ohne DLPF
+    static constexpr float ACCEL_LSB_PER_G = 2048.0f;  // ±16 g
+    static constexpr float GYRO_LSB_PER_DPS = 16.4f;   // ±2000 °/s
+
+private:
+    I2CEngine* bus;
+    uint8_t address;
+
+    uint16_t rateHz;
+    uint8_t channels;
+    uint8_t frameSize;        // Bytes pro Messwert im FIFO
+    uint16_t blockSize;       // Messwerte pro Block
+    bool running;
+
+    BlockHandler handler;
+    void* handlerContext;
+    MotionBlock block;
+
+    uint32_t blockCount;
+    uint32_t sampleCount;
+    uint32_t overflowCount;
+    uint32_t errorCount;
+
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegisters(uint8_t reg, uint8_t* buffer, size_t length);
+    void resetFifo();
+
+#ifndef NATIVE_BUILD
+    TaskHandle_t taskHandle;
+    volatile uint16_t pendingSamples;   // Data-Ready-Pulse seit dem letzten Wecken
+
+    static MPU9250Stream* instance;
+    static void IRAM_ATTR onDataReady();
+    static void taskEntry(void* parameter);
+#endif
+
+public:
+    MPU9250Stream(I2CEngine* bus = &i2cBus, uint8_t address = 0x68);
+
+    // Konfiguriert Abtastrate, Tiefpass und FIFO. Raten über 1 kHz sind nur
+    // ohne Gyroskop möglich (Accel 4 kHz); sonst 1000 / (1 + Divider) Hz.
+    bool begin(uint16_t requestedRateHz, bool withGyro, uint16_t samplesPerBlock);
+    void stop();
+
+    void onBlock(BlockHandler callback, void* context = nullptr);
+    // Vor begin(): Adresse aus der Sensorerkennung (0x68 oder 0x69)
+    void setAddress(uint8_t i2cAddress) { address = i2cAddress; }
+
+    // Liest alle vollständigen Messwerte aus dem FIFO und liefert volle
+    // Blöcke an den Handler. Rückgabe: Anzahl gelesener Messwerte.
+    size_t service();
+
+#ifndef NATIVE_BUILD
+    // Startet den Auslese-Task und aktiviert den Interrupt (pin < 0: nur Polling)
+    bool startTask(int interruptPin, UBaseType_t priority, BaseType_t core);
+#endif
+
+    bool isRunning() const { return running; }
+    uint16_t getRateHz() const { return rateHz; }
+    uint32_t getBlockCount() const { return blockCount; }
+    uint32_t getSampleCount() const { return sampleCount; }
+    uint32_t getOverflowCount() const { return overflowCount; }
+    uint32_t getErrorCount() const { return errorCount; }
+};
+
+#endif
@@ -1,10 +1,19 @@
 #include "mqtt.h"
 #include "config.h"
+#include <WiFi.h>
 #include <ArduinoJson.h>
 
 // Statische Instanz für Callback-Funktion
 MQTTClient* MQTTClient::instance = nullptr;
 
+// Topics und Benutzername stehen zur Compile-Zeit fest (keine String-Verkettung)
+static constexpr char TELEMETRY_TOPIC[] = MQTT_TELEMETRY_TOPIC;
+static constexpr char C2D_TOPIC[] = MQTT_C2D_TOPIC;
+static constexpr char TWIN_REPORTED_TOPIC[] = MQTT_TWIN_REPORTED_TOPIC;
+static constexpr char TWIN_RESPONSE_TOPIC[] = MQTT_TWIN_RESPONSE_TOPIC;
+static constexpr char TWIN_RESPONSE_PREFIX[] = "$iothub/twin/res/";
+static constexpr char MQTT_USERNAME[] = IOT_HUB_HOSTNAME "/" DEVICE_ID "/?api-version=2021-04-12";
+
 
 
  
@@ -96,8 +105,11 @@ const char* DEVICE_KEY_X509 = \
 
 
 
-MQTTClient::MQTTClient() : mqttClient(wifiClient), connected(false), 
-                           sasTokenExpiry(0), lastReconnectAttempt(0) {
+MQTTClient::MQTTClient() : qos1(wifiClient, qos1Buffer, sizeof(qos1Buffer)), mqttClient(qos1),
+                           reconnect(RECONNECT_BASE_DELAY_MS, MQTT_RECONNECT_MAX_DELAY_MS),
+                           connected(false), publishFailures(0), twinRequestId(0),
+                           twinAccepted(0), twinRejected(0), commandHandlerCount(0),
+                           deliveryCallback(nullptr), deliveryContext(nullptr) {
     instance = this;
 }
 
@@ -115,13 +127,23 @@ bool MQTTClient::begin(unsigned long currentEpoch) {
     
     mqttClient.setServer(IOT_HUB_HOSTNAME, MQTT_PORT);
     mqttClient.setCallback(messageCallback);
-    mqttClient.setBufferSize(512);
+    mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
     
     Serial.printf("IoT Hub: %s\n", IOT_HUB_HOSTNAME);
     Serial.printf("Device ID: %s\n", DEVICE_ID);
-    Serial.printf("MQTT QoS Level: %d\n", MQTT_QOS_LEVEL); // ✅ NEU: QoS anzeigen
+    Serial.printf("MQTT QoS Level: %d (Fenster %d Nachrichten)\n", MQTT_QOS_LEVEL, MQTT_INFLIGHT_WINDOW);
     
-    return connect(currentEpoch);
+    // Device Key einmal dekodieren, HMAC-Zustand vorberechnen
+    if (!tokenCache.begin(IOT_HUB_HOSTNAME, DEVICE_ID, DEVICE_KEY)) {
+        Serial.println("❌ Ungültiger Device Key (Base64)!");
+        return false;
+    }
+    
+    if (connect(currentEpoch)) {
+        return true;
+    }
+    reconnect.markFailure(millis());  // handleReconnect() versucht es mit Backoff weiter
+    return false;
 }
 
 
@@ -132,31 +154,42 @@ bool MQTTClient::connect(unsigned long currentEpoch) {
         return false;
     }
     
-    Serial.print("Generiere SAS-Token... ");
-    currentSasToken = sasToken.generateDefault(IOT_HUB_HOSTNAME, DEVICE_ID, DEVICE_KEY, currentEpoch);
-    sasTokenExpiry = currentEpoch + 86400;
-    Serial.println("OK");
-    
-    String mqttUsername = String(IOT_HUB_HOSTNAME) + "/" + String(DEVICE_ID) + 
-                         "/?api-version=2021-04-12";
+    // Gecachtes Token wiederverwenden, solange es nicht erneuert werden muss
+    uint32_t renewals = tokenCache.getRenewalCount();
+    const char* password = tokenCache.get(currentEpoch);
+    if (!password) {
+        Serial.println("❌ SAS-Token konnte nicht erzeugt werden!");
+        return false;
+    }
+    Serial.printf("SAS-Token %s (gültig bis %lu)\n",
+                  tokenCache.getRenewalCount() != renewals ? "erzeugt" : "aus Cache",
+                  tokenCache.getExpiry());
     
     Serial.print("Verbinde mit Azure IoT Hub... ");
     
     bool result = mqttClient.connect(DEVICE_ID, 
-                                     mqttUsername.c_str(), 
-                                     currentSasToken.c_str());
+                                     MQTT_USERNAME, 
+                                     password);
     
     if (result) {
         Serial.println("✅ Verbunden!");
         connected = true;
         
-        String c2dTopic = String("devices/") + DEVICE_ID + "/messages/devicebound/#";
-        mqttClient.subscribe(c2dTopic.c_str());
-        Serial.printf("Abonniert: %s\n", c2dTopic.c_str());
+        const TlsHandshakeStats& tls = wifiClient.wasResumed() ? wifiClient.getResumedStats()
+                                                               : wifiClient.getFullStats();
+        Serial.printf("TLS-Handshake %s: %lu ms, Heap-Spitze %lu Bytes\n",
+                      wifiClient.wasResumed() ? "fortgesetzt" : "vollständig",
+                      (unsigned long)tls.lastMs, (unsigned long)tls.lastPeakHeapBytes);
+        
+        mqttClient.subscribe(C2D_TOPIC);
+        Serial.printf("Abonniert: %s\n", C2D_TOPIC);
+        // Antworten auf Reported-Properties-Updates (Status 204)
+        mqttClient.subscribe(TWIN_RESPONSE_TOPIC);
         
         return true;
     } else {
-        Serial.printf("❌ Fehler! State: %d\n", mqttClient.state());
+        Serial.printf("❌ Fehler! State: %d (TLS: -0x%04X)\n", mqttClient.state(),
+                      (unsigned)-wifiClient.getLastError());
         connected = false;
         return false;
     }
@@ -236,38 +269,163 @@ bool MQTTClient::publishTelemetry(const SensorData& data, unsigned long currentE
         return false;
     }
     
-    StaticJsonDocument<256> doc;
+    unsigned long start = micros();
+#if TELEMETRY_ENCODING == TELEMETRY_ENCODING_BINARY
+    uint8_t binaryBuffer[TelemetryCodec::BINARY_HEADER_SIZE + TelemetryCodec::BINARY_SAMPLE_SIZE];
+    size_t length = TelemetryCodec::encodeBinary(data, currentEpoch, binaryBuffer, sizeof(binaryBuffer));
+    serializeUs.add(micros() - start);
+    return length > 0 && publishBinary(binaryBuffer, length);
+#else
+    char jsonBuffer[TelemetryCodec::JSON_SAMPLE_SIZE];
+    size_t length = TelemetryCodec::encodeJson(data, currentEpoch, jsonBuffer, sizeof(jsonBuffer));
+    serializeUs.add(micros() - start);
+    if (length == 0) {
+        return false;
+    }
     
-    doc["timestamp"] = currentEpoch;
-    doc["temperature"] = data.temperature;
-    doc["humidity"] = data.humidity;
-    doc["pressure"] = data.pressure;
-    doc["accelX"] = data.accelX;
-    doc["accelY"] = data.accelY;
-    doc["accelZ"] = data.accelZ;
-    doc["gyroX"] = data.gyroX;
-    doc["gyroY"] = data.gyroY;
-    doc["gyroZ"] = data.gyroZ;
+    return publishJSON(jsonBuffer);
+#endif
+}
+
+// ===== Batch in einer Nachricht senden =====
+// JSON-Array bzw. Binärformat mit Anzahl im Header (siehe telemetry_codec.h)
+bool MQTTClient::publishBatch(const TelemetryBatch& batch, uint32_t deliveryTag) {
+    if (!isConnected() || batch.isEmpty()) {
+        return false;
+    }
     
-    char jsonBuffer[256];
-    serializeJson(doc, jsonBuffer);
+    unsigned long start = micros();
+#if TELEMETRY_ENCODING == TELEMETRY_ENCODING_BINARY
+    size_t length = TelemetryCodec::encodeBinaryBatch(batch, (uint8_t*)payloadBuffer, sizeof(payloadBuffer));
+#else
+    size_t length = TelemetryCodec::encodeJsonBatch(batch, payloadBuffer, sizeof(payloadBuffer));
+#endif
+    serializeUs.add(micros() - start);
+    if (length == 0) {
+        Serial.println("❌ Batch passt nicht in den Puffer!");
+        return false;
+    }
     
-    return publishJSON(jsonBuffer);
+    if (batch.size() > 1) {
+        Serial.printf("📦 Batch mit %u Messwerten (%u Bytes)\n", (unsigned)batch.size(), (unsigned)length);
+    }
+    
+#if TELEMETRY_ENCODING == TELEMETRY_ENCODING_BINARY
+    return publishBinary((const uint8_t*)payloadBuffer, length, deliveryTag);
+#else
+    return publishJSON(payloadBuffer, deliveryTag);
+#endif
 }
 
 // ========== ✅ MODIFIZIERTE FUNKTION ========== 
-bool MQTTClient::publishJSON(const char* json) {
+bool MQTTClient::publishJSON(const char* json, uint32_t deliveryTag) {
+    if (!isConnected()) {
+        return false;
+    }
+    
+    bool result = timedPublish(TELEMETRY_TOPIC, (const uint8_t*)json, strlen(json), MQTT_QOS_LEVEL, deliveryTag);
+    
+    if (result) {
+        Serial.printf("📤 Telemetrie gesendet (QoS %d, %u unbestätigt)\n", MQTT_QOS_LEVEL,
+                      (unsigned)qos1.getInFlightCount());
+    } else {
+        Serial.println("❌ Fehler beim Senden!");
+    }
+    
+    return result;
+}
+
+// ===== Binäre Telemetrie senden =====
+// Content-Type und Schema als Message-Properties im Topic, damit das
+// Backend die Nachricht dem richtigen Decoder zuordnen kann
+bool MQTTClient::publishBinary(const uint8_t* payload, size_t length, uint32_t deliveryTag) {
+    if (!isConnected()) {
+        return false;
+    }
+    
+    bool result = timedPublish(MQTT_TELEMETRY_BINARY_TOPIC, payload, length, MQTT_QOS_LEVEL, deliveryTag);
+    
+    if (result) {
+        Serial.printf("📤 Telemetrie gesendet (binär, %u Bytes)\n", (unsigned)length);
+    } else {
+        Serial.println("❌ Fehler beim Senden!");
+    }
+    
+    return result;
+}
+
+// ===== Schwingungskennwerte senden =====
+// Eigenes Topic (type=vibration), damit der IoT Hub die Berichte getrennt
+// von der Telemetrie routen kann
+bool MQTTClient::publishVibration(const VibrationFeatures& features, unsigned long epoch) {
+    if (!isConnected()) {
+        return false;
+    }
+    
+    size_t length = TelemetryCodec::encodeVibrationJson(features, epoch, payloadBuffer, sizeof(payloadBuffer));
+    if (length == 0) {
+        Serial.println("❌ Schwingungsbericht passt nicht in den Puffer!");
+        return false;
+    }
+    
+    bool result = timedPublish(MQTT_VIBRATION_TOPIC, (const uint8_t*)payloadBuffer, length, MQTT_QOS_LEVEL);
+    
+    if (result) {
+        Serial.printf("📤 Schwingungskennwerte gesendet (%u Fenster, %u Bytes)\n",
+                      features.windows, (unsigned)length);
+    } else {
+        Serial.println("❌ Fehler beim Senden!");
+    }
+    
+    return result;
+}
+
+bool MQTTClient::publishPowerReport(const PowerReport& report, unsigned long epoch) {
     if (!isConnected()) {
         return false;
     }
     
-    String topic = String("devices/") + DEVICE_ID + "/messages/events/";
+    size_t length = TelemetryCodec::encodePowerJson(report, epoch, payloadBuffer, sizeof(payloadBuffer));
+    if (length == 0) {
+        Serial.println("❌ Energiebericht passt nicht in den Puffer!");
+        return false;
+    }
+    
+    bool result = timedPublish(MQTT_POWER_TOPIC, (const uint8_t*)payloadBuffer, length, MQTT_QOS_LEVEL);
+    
+    if (result) {
+        Serial.printf("📤 Energiebilanz gesendet (%.2f mJ/Messwert, %.3f mA)\n",
+                      report.energyPerSampleMj, report.averageCurrentMa);
+    } else {
+        Serial.println("❌ Fehler beim Senden!");
+    }
+    
+    return result;
+}
+
+// ===== Laufzeit-Kennzahlen senden =====
+// Als Reported Properties in den Device Twin: der letzte Stand jedes Geräts
+// ist im IoT Hub abfragbar (Twin-Abfragen), ohne die Telemetrie-Route zu
+// belasten. IoT Hub bestätigt mit Status 204 auf $iothub/twin/res/.
+bool MQTTClient::publishMetrics(const MetricsReport& report) {
+    if (!isConnected()) {
+        return false;
+    }
+    
+    size_t length = TelemetryCodec::encodeMetricsJson(report, payloadBuffer, sizeof(payloadBuffer));
+    if (length == 0) {
+        Serial.println("❌ Kennzahlenbericht passt nicht in den Puffer!");
+        return false;
+    }
     
-    // QoS 1 mit PUBACK-Bestätigung
-    bool result = mqttClient.publish(topic.c_str(), json, MQTT_QOS_LEVEL);
+    char topic[sizeof(TWIN_REPORTED_TOPIC) + 10];
+    snprintf(topic, sizeof(topic), "%s%lu", TWIN_REPORTED_TOPIC, (unsigned long)++twinRequestId);
+    // QoS 0: die Antwort auf $iothub/twin/res/ bestätigt bereits
+    bool result = timedPublish(topic, (const uint8_t*)payloadBuffer, length, 0);
     
     if (result) {
-        Serial.println("📤 Telemetrie gesendet (QoS 1 - mit PUBACK!)");
+        Serial.printf("📤 Kennzahlen an Device Twin gesendet (%u Bytes, rid %lu)\n",
+                      (unsigned)length, (unsigned long)twinRequestId);
     } else {
         Serial.println("❌ Fehler beim Senden!");
     }
@@ -275,27 +433,126 @@ bool MQTTClient::publishJSON(const char* json) {
     return result;
 }
 
+void MQTTClient::resetLatencyStats() {
+    serializeUs.reset();
+    publishUs.reset();
+    qos1.resetAckStats();
+}
+
+// Dauer bis publish() zurückkehrt (Paket an TLS übergeben) und Fehlschläge;
+// die Zeit bis zum PUBACK erfasst qos1. Fehlschlag bei QoS 1 heißt auch:
+// Fenster voll, der Aufrufer behandelt die Nachricht dann wie offline.
+// Zu große Pakete schließen die Puffergrößen in mqtt.h aus; falls doch,
+// wird das hier gemeldet statt still als volles Fenster gezählt.
+bool MQTTClient::timedPublish(const char* topic, const uint8_t* payload, size_t length, uint8_t qos,
+                              uint32_t deliveryTag) {
+    unsigned long start = micros();
+    bool result;
+    if (qos > 0) {
+        MqttQos1Publisher::PublishResult sent = qos1.publish(topic, payload, length, deliveryTag);
+        if (sent == MqttQos1Publisher::QOS1_TOO_LARGE) {
+            Serial.printf("❌ Nachricht zu groß für den QoS-1-Puffer (%u von %u Bytes)\n",
+                          (unsigned)length, (unsigned)qos1.getBufferSize());
+        }
+        result = sent == MqttQos1Publisher::QOS1_SENT;
+    } else {
+        result = mqttClient.publish(topic, payload, length, false);
+    }
+    publishUs.add(micros() - start);
+    if (!result) {
+        publishFailures++;
+    } else if (qos == 0 && deliveryTag != NO_DELIVERY_TAG && deliveryCallback) {
+        // Ohne PUBACK gilt die Nachricht mit dem Senden als zugestellt
+        deliveryCallback(deliveryTag, deliveryContext);
+    }
+    return result;
+}
+
+bool MQTTClient::onCommand(CommandHandler handler, void* context) {
+    if (commandHandlerCount >= MAX_COMMAND_HANDLERS) {
+        return false;
+    }
+    commandHandlers[commandHandlerCount] = handler;
+    commandContexts[commandHandlerCount] = context;
+    commandHandlerCount++;
+    return true;
+}
+
+void MQTTClient::onDelivered(DeliveryCallback callback, void* context) {
+    deliveryCallback = callback;
+    deliveryContext = context;
+    qos1.setAckCallback(callback, context);
+}
+
 void MQTTClient::loop() {
-    mqttClient.loop();
+    // PubSubClient liest die eingehenden Pakete, qos1 sieht dabei die PUBACKs
+    if (mqttClient.loop()) {
+        qos1.poll(millis());
+    }
 }
 
+bool MQTTClient::waitForAcks(unsigned long timeoutMs) {
+    unsigned long start = millis();
+    loop();
+    while (!qos1.idle() && isConnected() && millis() - start < timeoutMs) {
+        delay(10);
+        loop();
+    }
+    return qos1.idle();
+}
+
+// ===== Token vor Ablauf erneuern =====
+// IoT Hub trennt die Verbindung, sobald das Token abläuft; ein neues
+// Passwort geht bei MQTT nur über eine neue Verbindung. Daher wird nach
+// SAS_TOKEN_RENEW_FRACTION der Laufzeit kontrolliert neu verbunden.
+void MQTTClient::handleTokenRenewal(unsigned long currentEpoch) {
+    if (currentEpoch == 0 || !tokenCache.needsRenewal(currentEpoch)) {
+        return;
+    }
+    
+    Serial.printf("🔑 SAS-Token läuft um %lu ab - erneuere und verbinde neu\n", tokenCache.getExpiry());
+    if (!tokenCache.renew(currentEpoch)) {
+        Serial.println("❌ SAS-Token konnte nicht erzeugt werden!");
+        return;
+    }
+    
+    mqttClient.disconnect();
+    if (connect(currentEpoch)) {
+        Serial.println("✅ Mit neuem SAS-Token verbunden");
+    } else {
+        // Reguläre Reconnect-Logik übernimmt (mit Backoff)
+        reconnect.markFailure(millis());
+    }
+}
+
+// Nicht blockierend bis auf den Verbindungsaufbau selbst (TLS-Handshake).
+// Ohne WLAN wird kein Versuch verbraucht, damit nach dessen Rückkehr
+// sofort verbunden wird.
 void MQTTClient::handleReconnect(unsigned long currentEpoch) {
+    unsigned long now = millis();
+    
     if (isConnected()) {
+        handleTokenRenewal(currentEpoch);
         return;
     }
     
-    unsigned long now = millis();
+    reconnect.markDisconnected(now);  // Nur beim ersten Aufruf nach dem Verlust wirksam
+    if (WiFi.status() != WL_CONNECTED || !reconnect.isDue(now)) {
+        return;
+    }
     
-    if (now - lastReconnectAttempt >= RECONNECT_INTERVAL) {
-        lastReconnectAttempt = now; // Timestamp VOR dem Versuch setzen
-        
-        Serial.println("⚠️  MQTT Verbindung verloren - Reconnect...");
-        
-        if (connect(currentEpoch)) {
-            Serial.println("✅ MQTT Reconnect erfolgreich!");
-        } else {
-            Serial.println("❌ MQTT Reconnect fehlgeschlagen");
-        }
+    Serial.printf("⚠️  MQTT Verbindung verloren - Reconnect (Versuch %lu)...\n",
+                  (unsigned long)reconnect.getConsecutiveFailures() + 1);
+    reconnect.markAttempt();
+    
+    if (connect(currentEpoch)) {
+        Serial.printf("✅ MQTT Reconnect erfolgreich! (nach %lu ms)\n",
+                      reconnect.getOutageDurationMs(millis()));
+        reconnect.markConnected(millis());
+    } else {
+        reconnect.markFailure(millis());
+        Serial.printf("❌ MQTT Reconnect fehlgeschlagen, nächster Versuch in %lu ms\n",
+                      (unsigned long)reconnect.getLastDelayMs());
     }
 }
 
@@ -305,7 +562,23 @@ void MQTTClient::messageCallback(char* topic, byte* payload, unsigned int length
     }
 }
 
+// Topic: $iothub/twin/res/{status}/?$rid={rid}[&$version={version}]
+void MQTTClient::handleTwinResponse(const char* topic) {
+    int status = atoi(topic + sizeof(TWIN_RESPONSE_PREFIX) - 1);
+    if (status >= 200 && status < 300) {
+        twinAccepted++;
+    } else {
+        twinRejected++;
+        Serial.printf("⚠️  Device Twin lehnt Update ab: Status %d (%s)\n", status, topic);
+    }
+}
+
 void MQTTClient::handleIncomingMessage(char* topic, byte* payload, unsigned int length) {
+    if (strncmp(topic, TWIN_RESPONSE_PREFIX, sizeof(TWIN_RESPONSE_PREFIX) - 1) == 0) {
+        handleTwinResponse(topic);
+        return;
+    }
+    
     Serial.println("\n╔═══════════════════════════════════════╗");
     Serial.println("║ 📥 CLOUD-TO-DEVICE MESSAGE           ║");
     Serial.println("╚═══════════════════════════════════════╝");
@@ -318,7 +591,7 @@ void MQTTClient::handleIncomingMessage(char* topic, byte* payload, unsigned int
     }
     Serial.println("\n");
     
-    StaticJsonDocument<128> doc;
+    StaticJsonDocument<512> doc;  // Reicht für eine Filter-Konfiguration aller Kanäle
     DeserializationError error = deserializeJson(doc, payload, length);
     
     if (error) {
@@ -328,6 +601,14 @@ void MQTTClient::handleIncomingMessage(char* topic, byte* payload, unsigned int
     
     Serial.println("✅ JSON erfolgreich geparst");
     
+    // Registrierte Handler zuerst (jeder prüft seinen eigenen Schlüssel)
+    bool handled = false;
+    for (size_t i = 0; i < commandHandlerCount; i++) {
+        if (commandHandlers[i](doc.as<JsonVariantConst>(), commandContexts[i])) {
+            handled = true;
+        }
+    }
+    
     if (doc.containsKey("led")) {
         String ledState = doc["led"].as<String>();
         Serial.printf("LED Command: %s\n", ledState.c_str());
@@ -340,8 +621,8 @@ void MQTTClient::handleIncomingMessage(char* topic, byte* payload, unsigned int
             digitalWrite(LED_PIN, LOW);
             Serial.println("⚫⚫⚫ LED AUSGESCHALTET ⚫⚫⚫");
         }
-    } else {
-        Serial.println("⚠️  Kein 'led' Key in JSON gefunden");
+    } else if (!handled) {
+        Serial.println("⚠️  Kein bekannter Befehl in JSON gefunden");
     }
     
     Serial.println("═══════════════════════════════════════\n");
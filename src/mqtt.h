@@ -2,34 +2,86 @@
 #define MQTT_H
 
 #include <Arduino.h>
-#include <WiFiClientSecure.h>
 #include <PubSubClient.h>
+#include <ArduinoJson.h>
 #include "sensors.h"
+#include "telemetry_batch.h"
+#include "telemetry_codec.h"
 #include "sas.h"    //SAS Authentifizierung (Schicht 3: SAS)
+#include "reconnect_scheduler.h"
+#include "tls_client.h"
+#include "mqtt_qos1.h"
+#include "histogram.h"
+#include "metrics.h"
 
 class MQTTClient {
+public:
+    // Handler für C2D-Befehle; erhält das geparste JSON-Objekt und meldet,
+    // ob es einen passenden Schlüssel gefunden hat
+    typedef bool (*CommandHandler)(JsonVariantConst command, void* context);
+    // Zustellung einer Nachricht mit Kennung: bei QoS 1 mit dem PUBACK,
+    // bei QoS 0 direkt nach dem Senden
+    typedef MqttQos1Publisher::AckCallback DeliveryCallback;
+    static const uint32_t NO_DELIVERY_TAG = MqttQos1Publisher::NO_TAG;
+
 private:
-    WiFiClientSecure wifiClient;
+    TlsClient wifiClient;      // TLS mit Session-Wiederaufnahme
+    MqttQos1Publisher qos1;    // QoS 1 für Telemetrie, liegt zwischen PubSubClient und TLS
     PubSubClient mqttClient;
-    SASToken sasToken;  // SAS Authentifizierung
+    SasTokenCache tokenCache;  // SAS Authentifizierung (Key einmal dekodiert, Token gecacht)
     
-    String currentSasToken;
-    unsigned long sasTokenExpiry;
-    unsigned long lastReconnectAttempt;
+    ReconnectScheduler reconnect;  // Backoff mit Zufallsanteil (siehe config.h)
     
-
-    const unsigned long RECONNECT_INTERVAL = 120000; // 2 Minuten  
-
-    //const unsigned long RECONNECT_INTERVAL = 5000;  // 5 Sekunden  für SAS 
     const int MQTT_PORT = 8883;  // Azure IoT Hub MQTT Port (TLS)
+
+    // Payload-Puffer: max. 256 Bytes JSON pro Messwert, Array-Klammern und Kommas
+    // (das Binärformat ist immer kleiner), bzw. ein Schwingungs- oder Kennzahlenbericht
+    static const size_t BATCH_PAYLOAD_SIZE = TelemetryBatch::CAPACITY * TelemetryCodec::JSON_SAMPLE_SIZE;
+    static const size_t REPORT_PAYLOAD_SIZE = (TelemetryCodec::METRICS_JSON_SIZE > TelemetryCodec::VIBRATION_JSON_SIZE) ?
+                                              TelemetryCodec::METRICS_JSON_SIZE : TelemetryCodec::VIBRATION_JSON_SIZE;
+    static const size_t PAYLOAD_BUFFER_SIZE = (BATCH_PAYLOAD_SIZE > REPORT_PAYLOAD_SIZE) ?
+                                              BATCH_PAYLOAD_SIZE : REPORT_PAYLOAD_SIZE;
+    // MQTT-Puffer muss Topic + Header + größte Nachricht aufnehmen
+    static const size_t MQTT_HEADER_RESERVE = 160;
+    static const uint16_t MQTT_BUFFER_SIZE = (PAYLOAD_BUFFER_SIZE + MQTT_HEADER_RESERVE > 512) ?
+                                             PAYLOAD_BUFFER_SIZE + MQTT_HEADER_RESERVE : 512;
+    // QoS-1-Wiederholungspuffer: mindestens ein größtes Paket, sonst bliebe
+    // z.B. ein Batch dauerhaft im Offline-Speicher hängen
+    static const size_t QOS1_BUFFER_SIZE = (MQTT_INFLIGHT_BUFFER_SIZE > MQTT_BUFFER_SIZE) ?
+                                           MQTT_INFLIGHT_BUFFER_SIZE : MQTT_BUFFER_SIZE;
+    char payloadBuffer[PAYLOAD_BUFFER_SIZE];
+    uint8_t qos1Buffer[QOS1_BUFFER_SIZE];
+    static_assert(PAYLOAD_BUFFER_SIZE + MQTT_HEADER_RESERVE <= 65535, "MQTT-Puffer und QoS-1-Offsets sind 16 Bit");
+    static_assert(sizeof(MQTT_VIBRATION_TOPIC) + 8 <= MQTT_HEADER_RESERVE &&
+                  sizeof(MQTT_TELEMETRY_BINARY_TOPIC) + 8 <= MQTT_HEADER_RESERVE &&
+                  sizeof(MQTT_POWER_TOPIC) + 8 <= MQTT_HEADER_RESERVE, "Topic + Fixed Header + Packet Identifier");
     
     bool connected;
     
+    // Laufzeit-Kennzahlen (nur Netzwerk-Task)
+    LatencyHistogram serializeUs;
+    LatencyHistogram publishUs;
+    uint32_t publishFailures;
+    uint32_t twinRequestId;      // $rid der Reported-Properties-Updates
+    uint32_t twinAccepted;
+    uint32_t twinRejected;
+    
+    static const size_t MAX_COMMAND_HANDLERS = 4;
+    CommandHandler commandHandlers[MAX_COMMAND_HANDLERS];
+    void* commandContexts[MAX_COMMAND_HANDLERS];
+    size_t commandHandlerCount;
+    DeliveryCallback deliveryCallback;
+    void* deliveryContext;
+    
     // Callback für eingehende Messages
     static void messageCallback(char* topic, byte* payload, unsigned int length);
     static MQTTClient* instance;  // Für Callback
     
     void handleIncomingMessage(char* topic, byte* payload, unsigned int length);
+    void handleTwinResponse(const char* topic);
+    bool timedPublish(const char* topic, const uint8_t* payload, size_t length, uint8_t qos,
+                      uint32_t deliveryTag = NO_DELIVERY_TAG);
+    void handleTokenRenewal(unsigned long currentEpoch);
     
 public:
     MQTTClient();
@@ -40,10 +92,35 @@ public:
     void disconnect();
     
     bool publishTelemetry(const SensorData& data, unsigned long currentEpoch);
-    bool publishJSON(const char* json);
+    // Alle Messwerte in einer Nachricht; mit deliveryTag meldet sich der
+    // DeliveryCallback, sobald der Hub die Nachricht bestätigt hat
+    bool publishBatch(const TelemetryBatch& batch, uint32_t deliveryTag = NO_DELIVERY_TAG);
+    bool publishJSON(const char* json, uint32_t deliveryTag = NO_DELIVERY_TAG);
+    bool publishBinary(const uint8_t* payload, size_t length, uint32_t deliveryTag = NO_DELIVERY_TAG);
+    bool publishVibration(const VibrationFeatures& features, unsigned long epoch);  // Schwingungskennwerte
+    bool publishPowerReport(const PowerReport& report, unsigned long epoch);        // Energiebilanz
+    bool publishMetrics(const MetricsReport& report);   // Device Twin (Reported Properties)
+    
+    // Weitere C2D-Befehle neben "led" (z.B. Filter-Konfiguration)
+    bool onCommand(CommandHandler handler, void* context = nullptr);
+    void onDelivered(DeliveryCallback callback, void* context = nullptr);
     
     void loop();  // Muss in main loop() aufgerufen werden
-    void handleReconnect(unsigned long currentEpoch);
+    // Vor dem Trennen: loop() bis alle QoS-1-Nachrichten bestätigt sind
+    bool waitForAcks(unsigned long timeoutMs);
+    void handleReconnect(unsigned long currentEpoch);  // Inkl. Token-Erneuerung
+    unsigned long getTokenExpiry() const { return tokenCache.getExpiry(); }
+    const ReconnectScheduler& getReconnectStats() const { return reconnect; }
+    const TlsClient& getTlsStats() const { return wifiClient; }
+    const MqttQos1Publisher& getQos1Stats() const { return qos1; }
+    
+    // Dauer des Kodierens, von publish() und bis PUBACK; resetLatencyStats() nach jedem Bericht
+    const LatencyHistogram& getSerializeStats() const { return serializeUs; }
+    const LatencyHistogram& getPublishStats() const { return publishUs; }
+    void resetLatencyStats();
+    uint32_t getPublishFailureCount() const { return publishFailures; }
+    uint32_t getTwinAcceptedCount() const { return twinAccepted; }
+    uint32_t getTwinRejectedCount() const { return twinRejected; }
 };
 
 #endif
\ No newline at end of file
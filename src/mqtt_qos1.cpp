@@ -0,0 +1,251 @@
+#include "mqtt_qos1.h"
+
+static_assert(MQTT_INFLIGHT_WINDOW > 0 && MQTT_INFLIGHT_WINDOW <= 255, "Fenster 1..255");
+
+static const uint8_t MQTT_PUBLISH_QOS1 = 0x32;
+static const uint8_t MQTT_FLAG_DUP = 0x08;
+static const uint8_t MQTT_TYPE_PUBACK = 4;
+
+// Offsets im Ringpuffer sind 16 Bit
+MqttQos1Publisher::MqttQos1Publisher(Client& transport, uint8_t* buffer, size_t bufferSize)
+    : transport(transport), buffer(buffer), bufferSize(bufferSize > 65535 ? 65535 : (uint16_t)bufferSize),
+      head(0), count(0), unacked(0), window(MQTT_INFLIGHT_WINDOW),
+      writeOffset(0), nextPacketId(0), resendPending(false), ackCallback(nullptr), ackContext(nullptr),
+      parseState(PARSE_HEADER),
+      packetType(0), remaining(0), lengthShift(0), bodyCount(0), publishedCount(0),
+      ackedCount(0), retransmitCount(0), windowFullCount(0), tooLargeCount(0), unknownAckCount(0),
+      maxInFlight(0) {}
+
+void MqttQos1Publisher::setWindow(uint8_t size) {
+    window = size < 1 ? 1 : (size > MQTT_INFLIGHT_WINDOW ? MQTT_INFLIGHT_WINDOW : size);
+}
+
+// ===== Senden =====
+
+MqttQos1Publisher::PublishResult MqttQos1Publisher::publish(const char* topic, const uint8_t* payload,
+                                                            size_t length, uint32_t tag) {
+    if (!transport.connected()) {
+        return QOS1_NOT_CONNECTED;
+    }
+
+    size_t topicLength = strlen(topic);
+    size_t remainingLength = 2 + topicLength + 2 + length;   // Topic, Packet Identifier, Payload
+    size_t headerLength = 1 + (remainingLength < 128 ? 1 : remainingLength < 16384 ? 2 : 3);
+    size_t packetLength = headerLength + remainingLength;
+
+    // Passt auch in den leeren Puffer nicht: kein Fall für "später nochmal"
+    if (packetLength > bufferSize) {
+        tooLargeCount++;
+        return QOS1_TOO_LARGE;
+    }
+
+    uint16_t offset;
+    if (unacked >= window || count >= MQTT_INFLIGHT_WINDOW || !allocate((uint16_t)packetLength, offset)) {
+        windowFullCount++;
+        return QOS1_WINDOW_FULL;
+    }
+
+    // Paket direkt im Ringpuffer aufbauen
+    uint16_t packetId = takePacketId();
+    uint8_t* p = buffer + offset;
+    *p++ = MQTT_PUBLISH_QOS1;
+    size_t value = remainingLength;
+    do {
+        uint8_t digit = value % 128;
+        value /= 128;
+        *p++ = value > 0 ? (digit | 0x80) : digit;
+    } while (value > 0);
+    *p++ = (uint8_t)(topicLength >> 8);
+    *p++ = (uint8_t)topicLength;
+    memcpy(p, topic, topicLength);
+    p += topicLength;
+    *p++ = (uint8_t)(packetId >> 8);
+    *p++ = (uint8_t)packetId;
+    memcpy(p, payload, length);
+
+    InFlight& slot = slots[(head + count) % MQTT_INFLIGHT_WINDOW];
+    slot.packetId = packetId;
+    slot.offset = offset;
+    slot.length = (uint16_t)packetLength;
+    slot.tag = tag;
+    slot.acked = false;
+    slot.firstSentMicros = micros();
+    slot.sendCount = 0;
+    writeOffset = offset + packetLength;
+    count++;
+    unacked++;
+    publishedCount++;
+    if (unacked > maxInFlight) {
+        maxInFlight = unacked;
+    }
+
+    // Schlägt das Schreiben fehl, ist die Verbindung weg; die Nachricht
+    // bleibt im Fenster und wird nach dem Reconnect wiederholt
+    send(slot, millis());
+    return QOS1_SENT;
+}
+
+bool MqttQos1Publisher::send(InFlight& slot, unsigned long now) {
+    if (slot.sendCount > 0) {
+        buffer[slot.offset] |= MQTT_FLAG_DUP;
+    }
+    slot.lastSentMs = now;
+    if (slot.sendCount < 255) {
+        slot.sendCount++;
+    }
+    return transport.write(buffer + slot.offset, slot.length) == slot.length;
+}
+
+void MqttQos1Publisher::poll(unsigned long now) {
+    if (unacked == 0 || !transport.connected()) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        InFlight& slot = slots[(head + i) % MQTT_INFLIGHT_WINDOW];
+        if (slot.acked || (!resendPending && now - slot.lastSentMs < MQTT_PUBACK_TIMEOUT_MS)) {
+            continue;
+        }
+        retransmitCount++;
+        if (!send(slot, now)) {
+            return;   // Verbindung weg, nach dem Reconnect weiter
+        }
+    }
+    resendPending = false;
+}
+
+// Platz für length Bytes hinter dem jüngsten Paket, sonst am Pufferanfang
+// vor dem ältesten (Pakete liegen nie über das Pufferende hinweg)
+bool MqttQos1Publisher::allocate(uint16_t length, uint16_t& offset) const {
+    if (count == 0) {
+        offset = 0;
+        return length <= bufferSize;
+    }
+    uint16_t oldest = slots[head].offset;
+    if (writeOffset > oldest) {
+        if (writeOffset + length <= bufferSize) {
+            offset = writeOffset;
+            return true;
+        }
+        offset = 0;
+        return length <= oldest;
+    }
+    offset = writeOffset;
+    return writeOffset + length <= oldest;
+}
+
+uint16_t MqttQos1Publisher::takePacketId() {
+    for (;;) {
+        if (++nextPacketId == 0) {
+            nextPacketId = 1;   // 0 ist kein gültiger Packet Identifier
+        }
+        bool inUse = false;
+        for (uint8_t i = 0; i < count; i++) {
+            if (slots[(head + i) % MQTT_INFLIGHT_WINDOW].packetId == nextPacketId) {
+                inUse = true;
+                break;
+            }
+        }
+        if (!inUse) {
+            return nextPacketId;
+        }
+    }
+}
+
+// ===== Empfang: PUBACKs im durchgereichten Datenstrom =====
+
+void MqttQos1Publisher::track(uint8_t byte) {
+    switch (parseState) {
+        case PARSE_HEADER:
+            packetType = byte >> 4;
+            remaining = 0;
+            lengthShift = 0;
+            bodyCount = 0;
+            parseState = PARSE_LENGTH;
+            break;
+        case PARSE_LENGTH:
+            remaining |= (uint32_t)(byte & 0x7F) << lengthShift;
+            lengthShift += 7;
+            if (byte & 0x80) {
+                if (lengthShift > 21) {
+                    parseState = PARSE_HEADER;   // Ungültig, neu aufsetzen
+                }
+            } else {
+                parseState = remaining > 0 ? PARSE_BODY : PARSE_HEADER;
+            }
+            break;
+        case PARSE_BODY:
+            if (bodyCount < sizeof(bodyBytes)) {
+                bodyBytes[bodyCount++] = byte;
+            }
+            if (--remaining == 0) {
+                if (packetType == MQTT_TYPE_PUBACK && bodyCount == 2) {
+                    handlePuback(((uint16_t)bodyBytes[0] << 8) | bodyBytes[1]);
+                }
+                parseState = PARSE_HEADER;
+            }
+            break;
+    }
+}
+
+void MqttQos1Publisher::handlePuback(uint16_t packetId) {
+    for (uint8_t i = 0; i < count; i++) {
+        InFlight& slot = slots[(head + i) % MQTT_INFLIGHT_WINDOW];
+        if (slot.packetId == packetId && !slot.acked) {
+            slot.acked = true;
+            unacked--;
+            ackedCount++;
+            ackUs.add(micros() - slot.firstSentMicros);
+            uint32_t tag = slot.tag;
+            release();
+            if (tag != NO_TAG && ackCallback) {
+                ackCallback(tag, ackContext);
+            }
+            return;
+        }
+    }
+    unknownAckCount++;
+}
+
+// Bestätigte Einträge am Anfang freigeben; spätere warten, bis die
+// älteren bestätigt sind (Ringpuffer wird nur vorne frei)
+void MqttQos1Publisher::release() {
+    while (count > 0 && slots[head].acked) {
+        head = (head + 1) % MQTT_INFLIGHT_WINDOW;
+        count--;
+    }
+    if (count == 0) {
+        head = 0;
+        writeOffset = 0;
+    }
+}
+
+// ===== Client =====
+
+int MqttQos1Publisher::connect(IPAddress ip, uint16_t port) {
+    parseState = PARSE_HEADER;
+    resendPending = unacked > 0;
+    return transport.connect(ip, port);
+}
+
+int MqttQos1Publisher::connect(const char* host, uint16_t port) {
+    parseState = PARSE_HEADER;
+    resendPending = unacked > 0;
+    return transport.connect(host, port);
+}
+
+int MqttQos1Publisher::read() {
+    int c = transport.read();
+    if (c >= 0) {
+        track((uint8_t)c);
+    }
+    return c;
+}
+
+int MqttQos1Publisher::read(uint8_t* buf, size_t size) {
+    int n = transport.read(buf, size);
+    for (int i = 0; i < n; i++) {
+        track(buf[i]);
+    }
+    return n;
+}
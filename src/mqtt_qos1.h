@@ -0,0 +1,142 @@
+#ifndef MQTT_QOS1_H
+#define MQTT_QOS1_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include "config.h"
+#include "histogram.h"
+
+// ===== QoS-1-Sendefenster neben PubSubClient =====
+// PubSubClient sendet nur QoS 0 und verwirft eingehende PUBACKs. Dieses
+// Objekt sitzt als Client zwischen PubSubClient und der TLS-Verbindung:
+// Lesen und Schreiben werden durchgereicht, dabei verfolgt es die
+// Paketgrenzen des eingehenden Datenstroms und wertet PUBACKs aus.
+// Eigene PUBLISH-Pakete (QoS 1, Packet Identifier) schreibt es direkt in
+// dieselbe Verbindung – ohne Puffer in PubSubClient und ohne auf die
+// Bestätigung zu warten.
+//
+// Bis zu MQTT_INFLIGHT_WINDOW Nachrichten sind gleichzeitig unbestätigt;
+// ihre Pakete liegen in einem Ringpuffer fester Größe (kein Heap), damit
+// sie nach MQTT_PUBACK_TIMEOUT_MS bzw. nach einem Reconnect mit DUP-Flag
+// wiederholt werden können. Den Puffer stellt der Besitzer, so groß wie
+// mindestens sein größtes Paket (MQTTClient: MQTT_BUFFER_SIZE). Ist das
+// Fenster voll, liefert publish() QOS1_WINDOW_FULL und der Aufrufer
+// behandelt die Nachricht wie offline; ein Paket, das nie in den Puffer
+// passt, ist dagegen ein Fehler (QOS1_TOO_LARGE).
+//
+// Alle Aufrufe aus demselben Task wie PubSubClient (Netzwerk-Task), damit
+// sich Pakete im Datenstrom nicht überschneiden.
+class MqttQos1Publisher : public Client {
+public:
+    enum PublishResult : uint8_t {
+        QOS1_SENT,                // Im Fenster, wird bis zum PUBACK wiederholt
+        QOS1_NOT_CONNECTED,
+        QOS1_WINDOW_FULL,         // Später erneut versuchen
+        QOS1_TOO_LARGE            // Paket größer als der Puffer, nie sendbar
+    };
+
+    // Aufruf beim PUBACK einer Nachricht mit Kennung (publish(..., tag))
+    typedef void (*AckCallback)(uint32_t tag, void* context);
+    static const uint32_t NO_TAG = 0xFFFFFFFF;
+
+private:
+    struct InFlight {
+        uint16_t packetId;
+        uint16_t offset;          // Paket im Ringpuffer
+        uint16_t length;
+        uint32_t tag;             // NO_TAG = ohne Rückmeldung
+        bool acked;               // Bestätigt, wartet nur noch auf Freigabe
+        uint32_t firstSentMicros;
+        unsigned long lastSentMs;
+        uint8_t sendCount;
+    };
+
+    // Eingehende Pakete: Fixed Header, Restlänge, Rest
+    enum ParseState : uint8_t {
+        PARSE_HEADER,
+        PARSE_LENGTH,
+        PARSE_BODY
+    };
+
+    Client& transport;
+    InFlight slots[MQTT_INFLIGHT_WINDOW];
+    uint8_t* buffer;
+    uint16_t bufferSize;
+    uint8_t head;                 // Ältester Eintrag (FIFO in Sendereihenfolge)
+    uint8_t count;                // Belegte Einträge inkl. bestätigter
+    uint8_t unacked;
+    uint8_t window;               // Aktuelle Fenstergröße (<= MQTT_INFLIGHT_WINDOW)
+    uint16_t writeOffset;
+    uint16_t nextPacketId;
+    bool resendPending;           // Nach Reconnect alles wiederholen
+    AckCallback ackCallback;
+    void* ackContext;
+
+    ParseState parseState;
+    uint8_t packetType;
+    uint32_t remaining;
+    uint8_t lengthShift;
+    uint8_t bodyBytes[2];
+    uint8_t bodyCount;
+
+    // Statistik (seit dem Start)
+    LatencyHistogram ackUs;       // publish() bis PUBACK, je Nachricht
+    uint32_t publishedCount;
+    uint32_t ackedCount;
+    uint32_t retransmitCount;
+    uint32_t windowFullCount;
+    uint32_t tooLargeCount;
+    uint32_t unknownAckCount;     // PUBACK ohne offene Nachricht (z.B. zu einer Wiederholung)
+    uint8_t maxInFlight;
+
+    void track(uint8_t byte);
+    void handlePuback(uint16_t packetId);
+    bool allocate(uint16_t length, uint16_t& offset) const;
+    bool send(InFlight& slot, unsigned long now);
+    void release();
+    uint16_t takePacketId();
+
+public:
+    // buffer: Paketpuffer für Wiederholungen, höchstens 65535 Bytes
+    MqttQos1Publisher(Client& transport, uint8_t* buffer, size_t bufferSize);
+
+    // QoS-1-PUBLISH; mit tag meldet der AckCallback den PUBACK (z.B. um
+    // nachgesendete Daten erst dann im Offline-Speicher zu quittieren)
+    PublishResult publish(const char* topic, const uint8_t* payload, size_t length, uint32_t tag = NO_TAG);
+    void setAckCallback(AckCallback callback, void* context) { ackCallback = callback; ackContext = context; }
+
+    // Abgelaufene Nachrichten wiederholen; nur bei bestehender MQTT-Sitzung
+    // aufrufen (nach CONNACK), sonst landen Pakete vor dem CONNECT
+    void poll(unsigned long now);
+
+    void setWindow(uint8_t size);   // 1 = Stop-and-Wait
+    bool idle() const { return unacked == 0; }
+
+    // Client
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t c) override { return transport.write(c); }
+    size_t write(const uint8_t* buf, size_t size) override { return transport.write(buf, size); }
+    int available() override { return transport.available(); }
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int peek() override { return transport.peek(); }
+    void flush() override { transport.flush(); }
+    void stop() override { transport.stop(); }
+    uint8_t connected() override { return transport.connected(); }
+    operator bool() override { return transport.connected(); }
+
+    const LatencyHistogram& getAckStats() const { return ackUs; }
+    void resetAckStats() { ackUs.reset(); }
+    uint8_t getInFlightCount() const { return unacked; }
+    uint8_t getMaxInFlight() const { return maxInFlight; }
+    uint32_t getPublishedCount() const { return publishedCount; }
+    uint32_t getAckedCount() const { return ackedCount; }
+    uint32_t getRetransmitCount() const { return retransmitCount; }
+    uint32_t getWindowFullCount() const { return windowFullCount; }
+    uint32_t getTooLargeCount() const { return tooLargeCount; }
+    size_t getBufferSize() const { return bufferSize; }
+    uint32_t getUnknownAckCount() const { return unknownAckCount; }
+};
+
+#endif
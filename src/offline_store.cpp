@@ -0,0 +1,238 @@
+#include "offline_store.h"
+#include <LittleFS.h>
+
+// Dateinamen auf LittleFS
+static const char* DATA_FILE = "/telemetry.bin";     // Ringpuffer mit Datensätzen
+static const char* POINTER_FILE = "/telemetry.rd";   // Lesezeiger (uint32_t)
+
+static const uint32_t EMPTY_SEQUENCE = 0xFFFFFFFF;   // Gelöschter Flash liest 0xFF
+
+// ===== CRC-8 (Polynom 0x07) =====
+// Erkennt halb geschriebene Datensätze nach einem Reset
+static uint8_t crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Konstruktor: Speicher erst nach begin() nutzbar
+OfflineStore::OfflineStore() : ready(false), writeSequence(0), readSequence(0),
+                               persistedSequence(0), pendingSpan(0), droppedCount(0) {
+}
+
+// ===== Initialisierung =====
+// Mountet LittleFS (formatiert beim ersten Start) und stellt die Zeiger wieder her
+bool OfflineStore::begin() {
+    Serial.print("Offline-Speicher initialisieren... ");
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("FEHLER (LittleFS)!");
+        ready = false;
+        return false;
+    }
+
+    // Datei mit fester Größe anlegen, falls nicht vorhanden oder Kapazität geändert
+    File file = LittleFS.open(DATA_FILE, "r");
+    bool valid = file && file.size() == CAPACITY * sizeof(StoredRecord);
+    if (file) {
+        file.close();
+    }
+    if (!valid && !createDataFile()) {
+        Serial.println("FEHLER (Datei)!");
+        ready = false;
+        return false;
+    }
+
+    recoverPointers();
+    ready = true;
+
+    Serial.printf("OK (%lu Datensätze ausstehend, Kapazität %lu)\n",
+                  (unsigned long)pending(), (unsigned long)CAPACITY);
+    return true;
+}
+
+// Legt die Ringpuffer-Datei an und füllt sie mit leeren Datensätzen
+bool OfflineStore::createDataFile() {
+    LittleFS.remove(POINTER_FILE);
+
+    File file = LittleFS.open(DATA_FILE, "w");
+    if (!file) {
+        return false;
+    }
+
+    uint8_t empty[sizeof(StoredRecord) * 16];
+    memset(empty, 0xFF, sizeof(empty));
+
+    for (uint32_t written = 0; written < CAPACITY; written += 16) {
+        uint32_t chunk = (CAPACITY - written < 16) ? CAPACITY - written : 16;
+        if (file.write(empty, chunk * sizeof(StoredRecord)) != chunk * sizeof(StoredRecord)) {
+            file.close();
+            return false;
+        }
+    }
+    file.close();
+    return true;
+}
+
+// ===== Zeiger nach Neustart wiederherstellen =====
+// Schreibzeiger = höchste gültige Sequenznummer + 1,
+// Lesezeiger aus POINTER_FILE (begrenzt auf den gültigen Bereich)
+void OfflineStore::recoverPointers() {
+    bool found = false;
+    uint32_t newest = 0;
+    uint32_t oldest = 0;
+
+    File file = LittleFS.open(DATA_FILE, "r");
+    StoredRecord record;
+    while (file && file.read((uint8_t*)&record, sizeof(record)) == sizeof(record)) {
+        if (record.sequence == EMPTY_SEQUENCE ||
+            record.checksum != crc8((const uint8_t*)&record, sizeof(record) - 1)) {
+            continue;
+        }
+        if (!found || record.sequence > newest) newest = record.sequence;
+        if (!found || record.sequence < oldest) oldest = record.sequence;
+        found = true;
+    }
+    if (file) {
+        file.close();
+    }
+
+    writeSequence = found ? newest + 1 : 0;
+    readSequence = found ? oldest : 0;
+
+    File pointer = LittleFS.open(POINTER_FILE, "r");
+    uint32_t stored;
+    if (pointer && pointer.read((uint8_t*)&stored, sizeof(stored)) == sizeof(stored)) {
+        if (stored > readSequence && stored <= writeSequence) {
+            readSequence = stored;
+        }
+    }
+    if (pointer) {
+        pointer.close();
+    }
+
+    persistedSequence = readSequence;
+    pendingSpan = 0;
+}
+
+// Lesezeiger dauerhaft speichern
+void OfflineStore::persistReadPointer() {
+    File pointer = LittleFS.open(POINTER_FILE, "w");
+    if (pointer) {
+        pointer.write((const uint8_t*)&readSequence, sizeof(readSequence));
+        pointer.close();
+        persistedSequence = readSequence;
+    }
+}
+
+// ===== Messwerte ablegen =====
+// Alle Datensätze eines Batches werden mit einem Dateizugriff geschrieben
+bool OfflineStore::push(const TelemetryBatch& batch) {
+    if (!ready || batch.isEmpty()) {
+        return false;
+    }
+
+    File file = LittleFS.open(DATA_FILE, "r+");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < batch.size() && ok; i++) {
+        const TelemetrySample& sample = batch.at(i);
+        StoredRecord record;
+        encode(sample.data, sample.epoch, writeSequence, record);
+
+        file.seek((writeSequence % CAPACITY) * sizeof(StoredRecord), SeekSet);
+        ok = file.write((const uint8_t*)&record, sizeof(record)) == sizeof(record);
+        if (ok) {
+            writeSequence++;
+        }
+    }
+    file.close();
+
+    // Ring voll: älteste, noch nicht gesendete Datensätze wurden überschrieben.
+    // Der gespeicherte Lesezeiger liegt jetzt vor dem ältesten Datensatz und
+    // wird beim Start ohnehin begrenzt; das Intervall zählt ab hier neu
+    if (writeSequence - readSequence > CAPACITY) {
+        droppedCount += writeSequence - readSequence - CAPACITY;
+        readSequence = writeSequence - CAPACITY;
+        persistedSequence = readSequence;
+        pendingSpan = 0;
+    }
+
+    return ok;
+}
+
+// ===== Ausstehende Datensätze laden =====
+// Beschädigte Datensätze werden übersprungen, zählen aber zum Bereich,
+// der mit acknowledge() bestätigt wird
+size_t OfflineStore::loadPending(TelemetryBatch& batch) {
+    batch.clear();
+    pendingSpan = 0;
+
+    if (!ready || pending() == 0) {
+        return 0;
+    }
+
+    File file = LittleFS.open(DATA_FILE, "r");
+    if (!file) {
+        return 0;
+    }
+
+    uint32_t sequence = readSequence;
+    while (sequence != writeSequence && !batch.isFull()) {
+        StoredRecord record;
+        file.seek((sequence % CAPACITY) * sizeof(StoredRecord), SeekSet);
+        if (file.read((uint8_t*)&record, sizeof(record)) != sizeof(record)) {
+            break;
+        }
+
+        SensorData data;
+        unsigned long epoch;
+        if (record.sequence == sequence && decode(record, data, epoch)) {
+            batch.add(data, epoch);
+        }
+        sequence++;
+    }
+    file.close();
+
+    pendingSpan = sequence - readSequence;
+    return batch.size();
+}
+
+// ===== Gesendete Datensätze bestätigen =====
+void OfflineStore::acknowledge() {
+    if (pendingSpan == 0) {
+        return;
+    }
+    readSequence += pendingSpan;
+    pendingSpan = 0;
+
+    // Lesezeiger nur gelegentlich und bei leerem Speicher schreiben
+    if (pending() == 0 || readSequence - persistedSequence >= READ_POINTER_PERSIST_INTERVAL) {
+        persistReadPointer();
+    }
+}
+
+// ===== SensorData -> Datensatz =====
+void OfflineStore::encode(const SensorData& data, unsigned long epoch, uint32_t sequence, StoredRecord& record) {
+    record.sequence = sequence;
+    TelemetryCodec::pack(data, epoch, record.sample);
+    record.checksum = crc8((const uint8_t*)&record, sizeof(record) - 1);
+}
+
+// ===== Datensatz -> SensorData =====
+// Gibt false zurück wenn die Prüfsumme nicht stimmt
+bool OfflineStore::decode(const StoredRecord& record, SensorData& data, unsigned long& epoch) {
+    if (record.checksum != crc8((const uint8_t*)&record, sizeof(record) - 1)) {
+        return false;
+    }
+    TelemetryCodec::unpack(record.sample, data, epoch);
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef OFFLINE_STORE_H
+#define OFFLINE_STORE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sensors.h"
+#include "telemetry_batch.h"
+#include "telemetry_codec.h"
+
+// ===== Datensatz im Flash (28 Bytes, Festkomma) =====
+// Feste Größe, damit jeder Datensatz einen festen Platz im Ringpuffer hat
+struct __attribute__((packed)) StoredRecord {
+    uint32_t sequence;     // Fortlaufende Nummer (Platz = sequence % Kapazität)
+    PackedSample sample;   // Messwert in Festkomma (siehe telemetry_codec.h)
+    uint8_t checksum;      // CRC-8 über alle vorherigen Bytes
+};
+
+// ===== Offline-Speicher für Telemetrie (Store-and-Forward) =====
+// Append-only Ringpuffer in einer vorab angelegten Datei auf LittleFS.
+// Während MQTT-Ausfällen werden Messwerte hier abgelegt und nach dem
+// Reconnect gedrosselt nachgesendet. Beim Start wird der Schreibzeiger
+// aus den Sequenznummern rekonstruiert, der Lesezeiger liegt in einer
+// eigenen kleinen Datei und wird nur alle READ_POINTER_PERSIST_INTERVAL
+// Datensätze geschrieben (schont den Flash, Duplikate sind möglich).
+class OfflineStore {
+private:
+    static const uint32_t CAPACITY = OFFLINE_STORE_CAPACITY;
+    static const uint32_t READ_POINTER_PERSIST_INTERVAL = 32;
+
+    bool ready;
+    uint32_t writeSequence;      // Nächste zu schreibende Sequenznummer
+    uint32_t readSequence;       // Nächste nachzusendende Sequenznummer
+    uint32_t persistedSequence;  // Zuletzt gespeicherter Lesezeiger
+    uint32_t pendingSpan;        // Von loadPending() gelesene Sequenznummern
+    unsigned long droppedCount;  // Überschriebene, nie gesendete Datensätze
+
+    bool createDataFile();
+    void recoverPointers();
+    void persistReadPointer();
+
+public:
+    OfflineStore();
+
+    bool begin();
+    bool isReady() const { return ready; }
+
+    // Messwerte ablegen (ein Dateizugriff pro Batch)
+    bool push(const TelemetryBatch& batch);
+
+    // Lädt die ältesten ausstehenden Datensätze in batch (max. batch-Kapazität)
+    size_t loadPending(TelemetryBatch& batch);
+    // Bestätigt die zuletzt mit loadPending() geladenen Datensätze als zugestellt
+    // (nach dem PUBACK; bis dahin kein weiteres loadPending())
+    void acknowledge();
+
+    uint32_t pending() const { return writeSequence - readSequence; }
+    unsigned long getDroppedCount() const { return droppedCount; }
+
+    // Umrechnung SensorData <-> Datensatz mit Prüfsumme
+    static void encode(const SensorData& data, unsigned long epoch, uint32_t sequence, StoredRecord& record);
+    static bool decode(const StoredRecord& record, SensorData& data, unsigned long& epoch);
+};
+
+#endif
@@ -0,0 +1,184 @@
+#include "power_manager.h"
+#include "telemetry_codec.h"
+#include "rtc_cache.h"
+
+#ifndef NATIVE_BUILD
+#include <esp_sleep.h>
+#endif
+
+static const uint32_t RTC_MAGIC = 0x50574D31;   // "PWM1"
+
+// ===== Zustand im RTC Slow Memory =====
+struct PowerRtcState {
+    uint32_t wakeCount;
+    uint32_t epochAtSync;           // NTP-Zeit bei der letzten Synchronisation
+    uint64_t microsSinceSync;       // Wach- und Schlafzeit seit der Synchronisation
+    float lastCycleEnergyMj;        // Energie des letzten Zyklus (wach + Schlaf)
+    float energySinceReportMj;
+    uint64_t microsSinceReport;
+    uint64_t awakeMicrosSinceReport;
+    uint32_t samplesSinceReport;
+    uint16_t sampleCount;
+    PackedSample samples[LOW_POWER_SAMPLES_PER_UPLINK];
+};
+
+RTC_CACHE_ATTR static RtcCache<PowerRtcState, RTC_MAGIC> rtc;
+
+// Energie in mJ für eine Dauer in µs bei gegebenem Strom
+static float energyMj(uint64_t durationMicros, float currentMa) {
+    return POWER_SUPPLY_VOLTAGE * currentMa * (float)durationMicros / 1e6f;
+}
+
+PowerManager::PowerManager()
+    : phase(POWER_CPU), phaseStartMicros(0), cycleStartMicros(0), cycleEnergyMj(0.0f), cycleSamples(0), syncMicros(0) {
+}
+
+// ===== Wachzyklus beginnen =====
+bool PowerManager::begin() {
+    bool resumed = rtc.valid();
+#ifndef NATIVE_BUILD
+    resumed = resumed && esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+#endif
+
+    if (!resumed) {
+        rtc.reset();
+    }
+    rtc->wakeCount++;
+
+    // Auf dem ESP32 zählt micros() ab dem Aufwachen; der Bootloader läuft
+    // davor und wird pauschal angerechnet
+    phase = POWER_CPU;
+#ifndef NATIVE_BUILD
+    cycleStartMicros = 0;
+#else
+    cycleStartMicros = micros();
+#endif
+    phaseStartMicros = syncMicros = cycleStartMicros;
+    cycleEnergyMj = energyMj(POWER_BOOT_OVERHEAD_MS * 1000UL, POWER_CPU_CURRENT_MA);
+    cycleSamples = 0;
+    rtc->microsSinceSync += POWER_BOOT_OVERHEAD_MS * 1000UL;
+    return resumed;
+}
+
+void PowerManager::accumulatePhase() {
+    uint32_t now = micros();
+    uint32_t duration = now - phaseStartMicros;
+    cycleEnergyMj += energyMj(duration, phase == POWER_RADIO ? POWER_RADIO_CURRENT_MA : POWER_CPU_CURRENT_MA);
+    phaseStartMicros = now;
+}
+
+void PowerManager::setPhase(PowerPhase newPhase) {
+    accumulatePhase();
+    phase = newPhase;
+}
+
+// ===== Uhrzeit =====
+unsigned long PowerManager::getEpochTime() const {
+    if (rtc->epochAtSync == 0) {
+        return 0;
+    }
+    uint64_t elapsed = rtc->microsSinceSync + (uint32_t)(micros() - syncMicros);
+    return rtc->epochAtSync + (unsigned long)(elapsed / 1000000ULL);
+}
+
+void PowerManager::syncEpoch(unsigned long epoch) {
+    rtc->epochAtSync = epoch;
+    rtc->microsSinceSync = 0;
+    syncMicros = micros();
+}
+
+// ===== Messwerte =====
+bool PowerManager::storeSample(const SensorData& data, unsigned long epoch) {
+    cycleSamples++;
+    if (rtc->sampleCount >= LOW_POWER_SAMPLES_PER_UPLINK) {
+        return false;
+    }
+    TelemetryCodec::pack(data, epoch, rtc->samples[rtc->sampleCount++]);
+    return true;
+}
+
+size_t PowerManager::sampleCount() const {
+    return rtc->sampleCount;
+}
+
+bool PowerManager::uplinkDue() const {
+    return rtc->sampleCount >= LOW_POWER_SAMPLES_PER_UPLINK;
+}
+
+size_t PowerManager::loadSamples(TelemetryBatch& batch, size_t offset) const {
+    batch.clear();
+    for (size_t i = offset; i < rtc->sampleCount && !batch.isFull(); i++) {
+        SensorData data;
+        unsigned long epoch;
+        TelemetryCodec::unpack(rtc->samples[i], data, epoch);
+        batch.add(data, epoch);
+    }
+    return batch.size();
+}
+
+void PowerManager::clearSamples() {
+    rtc->sampleCount = 0;
+}
+
+// ===== Energiebilanz =====
+// Der Bericht umfasst nur abgeschlossene Wachzyklen samt Schlafphase. Der
+// laufende Zyklus (mit dem Uplink) zählt erst zum nächsten Bericht, so
+// enthält jeder Berichtszeitraum im Dauerbetrieb genau einen Uplink.
+PowerReport PowerManager::getReport() const {
+    PowerReport report;
+    report.wakeCount = rtc->wakeCount;
+    report.samples = rtc->samplesSinceReport;
+    report.energyPerSampleMj = report.samples ? rtc->energySinceReportMj / report.samples : 0.0f;
+    report.averageCurrentMa = rtc->microsSinceReport
+        ? rtc->energySinceReportMj / POWER_SUPPLY_VOLTAGE / ((float)rtc->microsSinceReport / 1e6f)
+        : 0.0f;
+    report.awakeMsPerSample = report.samples
+        ? (uint32_t)(rtc->awakeMicrosSinceReport / 1000ULL / report.samples)
+        : 0;
+    return report;
+}
+
+void PowerManager::markReported() {
+    rtc->energySinceReportMj = 0.0f;
+    rtc->microsSinceReport = 0;
+    rtc->awakeMicrosSinceReport = 0;
+    rtc->samplesSinceReport = 0;
+}
+
+float PowerManager::getLastCycleEnergyMj() const {
+    return rtc->lastCycleEnergyMj;
+}
+
+uint32_t PowerManager::getWakeCount() const {
+    return rtc->wakeCount;
+}
+
+// ===== Deep Sleep =====
+void PowerManager::sleepUntilNext(uint32_t intervalMs) {
+    accumulatePhase();
+
+    // Wachzeit inkl. Bootloader; die Schlafdauer gleicht sie auf das Intervall aus
+    uint32_t awakeMicros = micros() - cycleStartMicros + POWER_BOOT_OVERHEAD_MS * 1000UL;
+    uint32_t awakeMs = awakeMicros / 1000;
+    uint32_t sleepMs = intervalMs > awakeMs + 100 ? intervalMs - awakeMs : 100;
+    uint64_t cycleMicros = awakeMicros + (uint64_t)sleepMs * 1000ULL;
+
+    float sleepEnergyMj = energyMj((uint64_t)sleepMs * 1000ULL, POWER_SLEEP_CURRENT_MA);
+    rtc->lastCycleEnergyMj = cycleEnergyMj + sleepEnergyMj;
+    rtc->energySinceReportMj += rtc->lastCycleEnergyMj;
+    rtc->microsSinceSync += (uint32_t)(micros() - syncMicros) + (uint64_t)sleepMs * 1000ULL;
+    rtc->microsSinceReport += cycleMicros;
+    rtc->awakeMicrosSinceReport += awakeMicros;
+    rtc->samplesSinceReport += cycleSamples;
+
+    Serial.printf("🌙 Deep Sleep für %lu ms (wach %lu ms, %.2f mJ)\n",
+                  (unsigned long)sleepMs, (unsigned long)awakeMs, cycleEnergyMj);
+
+#ifndef NATIVE_BUILD
+    Serial.flush();
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000ULL);
+    esp_deep_sleep_start();
+#else
+    delay(sleepMs + POWER_BOOT_OVERHEAD_MS);   // Simulierte Uhr inkl. Bootzeit
+#endif
+}
@@ -0,0 +1,74 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sensors.h"
+#include "telemetry_batch.h"
+
+// Betriebsphasen für die Energiebilanz
+enum PowerPhase {
+    POWER_CPU,      // CPU aktiv, Funk aus
+    POWER_RADIO     // WLAN-Verbindung, TLS, Senden
+};
+
+// ===== Energiebilanz für den Bericht an den IoT Hub =====
+struct PowerReport {
+    uint32_t wakeCount;             // Aufwachvorgänge seit Kaltstart
+    uint32_t samples;               // Messwerte seit dem letzten Bericht
+    float energyPerSampleMj;        // Mittlere Energie pro Messwert inkl. Schlaf und Uplink
+    float averageCurrentMa;         // Mittlerer Strom über den Berichtszeitraum
+    uint32_t awakeMsPerSample;      // Mittlere Wachzeit pro Messwert
+};
+
+// ===== Stromsparbetrieb mit Deep Sleep =====
+// Hält den Zustand über den Deep Sleep im RTC-Speicher: gesammelte
+// Messwerte (als PackedSample), geschätzte Uhrzeit seit der letzten
+// NTP-Synchronisation und die Energiebilanz. Die Energie wird aus den
+// gemessenen Zeiten pro Phase und den Stromwerten aus config.h berechnet.
+//
+// Die Uhrzeit läuft im Deep Sleep über den RTC-Oszillator weiter
+// (Abweichung einige %), daher wird bei jedem Uplink neu synchronisiert.
+class PowerManager {
+private:
+    PowerPhase phase;
+    uint32_t phaseStartMicros;
+    uint32_t cycleStartMicros;
+    float cycleEnergyMj;            // Energie des laufenden Wachzyklus
+    uint32_t cycleSamples;          // Messwerte im laufenden Wachzyklus
+    uint32_t syncMicros;            // Bezugspunkt von microsSinceSync in diesem Zyklus
+
+    void accumulatePhase();
+
+public:
+    PowerManager();
+
+    // Zu Beginn jedes Wachzyklus; true = Zustand aus dem Deep Sleep übernommen
+    bool begin();
+    void setPhase(PowerPhase newPhase);
+
+    // Geschätzte Unix-Zeit (0 = noch nie synchronisiert)
+    unsigned long getEpochTime() const;
+    void syncEpoch(unsigned long epoch);
+
+    // Messwerte im RTC-Speicher
+    bool storeSample(const SensorData& data, unsigned long epoch);
+    size_t sampleCount() const;
+    bool uplinkDue() const;
+    // Lädt bis zu TelemetryBatch::CAPACITY Messwerte ab offset; Rückgabe Anzahl
+    size_t loadSamples(TelemetryBatch& batch, size_t offset) const;
+    void clearSamples();
+
+    // Energiebilanz der abgeschlossenen Zyklen seit dem letzten Bericht
+    PowerReport getReport() const;
+    void markReported();
+    float getLastCycleEnergyMj() const;
+    uint32_t getWakeCount() const;
+
+    // Schließt die Bilanz ab und schläft bis zum nächsten Messzeitpunkt.
+    // ESP32: kehrt nicht zurück (Neustart nach dem Aufwachen).
+    // Host-Build: stellt die simulierte Uhr vor und kehrt zurück.
+    void sleepUntilNext(uint32_t intervalMs);
+};
+
+#endif
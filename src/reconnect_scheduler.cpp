@@ -0,0 +1,76 @@
+#include "reconnect_scheduler.h"
+
+ReconnectScheduler::ReconnectScheduler(uint32_t baseDelayMs, uint32_t maxDelayMs)
+    : baseDelayMs(baseDelayMs), maxDelayMs(maxDelayMs < baseDelayMs ? baseDelayMs : maxDelayMs) {
+    reset();
+}
+
+void ReconnectScheduler::reset() {
+    outage = false;
+    outageStartMs = 0;
+    nextAttemptMs = 0;
+    consecutiveFailures = 0;
+    lastDelayMs = 0;
+    outageCount = 0;
+    attemptCount = 0;
+    failureCount = 0;
+    longestOutageMs = 0;
+    totalOutageMs = 0;
+}
+
+void ReconnectScheduler::markDisconnected(unsigned long nowMs) {
+    if (outage) {
+        return;
+    }
+    outage = true;
+    outageStartMs = nowMs;
+    nextAttemptMs = nowMs;  // Erster Versuch ohne Wartezeit
+    consecutiveFailures = 0;
+    lastDelayMs = 0;
+    outageCount++;
+}
+
+bool ReconnectScheduler::isDue(unsigned long nowMs) const {
+    // Vorzeichenbehafteter Vergleich übersteht den millis()-Überlauf
+    return outage && (long)(nowMs - nextAttemptMs) >= 0;
+}
+
+void ReconnectScheduler::markAttempt() {
+    attemptCount++;
+}
+
+uint32_t ReconnectScheduler::backoffCeilingMs(uint32_t failures) const {
+    if (failures == 0) {
+        return 0;
+    }
+    uint32_t delayMs = baseDelayMs;
+    for (uint32_t i = 1; i < failures && delayMs < maxDelayMs; i++) {
+        delayMs = delayMs > maxDelayMs / 2 ? maxDelayMs : delayMs * 2;
+    }
+    return delayMs < maxDelayMs ? delayMs : maxDelayMs;
+}
+
+void ReconnectScheduler::markFailure(unsigned long nowMs) {
+    markDisconnected(nowMs);
+    consecutiveFailures++;
+    failureCount++;
+
+    // Equal Jitter: [ceiling/2, ceiling]
+    uint32_t ceiling = backoffCeilingMs(consecutiveFailures);
+    uint32_t half = ceiling / 2;
+    lastDelayMs = ceiling - half + (uint32_t)random((long)half + 1);
+    nextAttemptMs = nowMs + lastDelayMs;
+}
+
+void ReconnectScheduler::markConnected(unsigned long nowMs) {
+    if (outage) {
+        unsigned long duration = nowMs - outageStartMs;
+        totalOutageMs += duration;
+        if (duration > longestOutageMs) {
+            longestOutageMs = duration;
+        }
+    }
+    outage = false;
+    consecutiveFailures = 0;
+    lastDelayMs = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef RECONNECT_SCHEDULER_H
+#define RECONNECT_SCHEDULER_H
+
+#include <Arduino.h>
+
+// ===== Reconnect-Planung mit exponentiellem Backoff =====
+// Gemeinsam für WLAN und MQTT. Der erste Versuch nach einem
+// Verbindungsverlust erfolgt sofort (kurze Aussetzer kosten so keine
+// Daten), danach verdoppelt sich die Wartezeit bis maxDelayMs.
+// Der Zufallsanteil ("Equal Jitter": halbe Wartezeit fest, halbe zufällig)
+// verhindert, dass nach einem Hub-Ausfall alle Geräte im Gleichtakt
+// neu verbinden.
+//
+// Blockiert nie: Der Aufrufer fragt mit isDue() ab, ob ein Versuch
+// fällig ist, und meldet das Ergebnis mit markConnected()/markFailure().
+class ReconnectScheduler {
+private:
+    uint32_t baseDelayMs;
+    uint32_t maxDelayMs;
+
+    bool outage;                   // Verbindung aktuell unterbrochen
+    unsigned long outageStartMs;
+    unsigned long nextAttemptMs;
+    uint32_t consecutiveFailures;  // Seit Beginn des Ausfalls
+    uint32_t lastDelayMs;
+
+    // Statistik (seit dem Start)
+    uint32_t outageCount;
+    uint32_t attemptCount;
+    uint32_t failureCount;
+    unsigned long longestOutageMs;
+    unsigned long totalOutageMs;
+
+public:
+    ReconnectScheduler(uint32_t baseDelayMs, uint32_t maxDelayMs);
+
+    void markDisconnected(unsigned long nowMs);  // Ausfall erkannt, nächster Versuch sofort
+    bool isDue(unsigned long nowMs) const;
+    void markAttempt();
+    void markFailure(unsigned long nowMs);       // Nächsten Versuch mit Backoff planen
+    void markConnected(unsigned long nowMs);     // Ausfall beendet
+    void reset();
+
+    // Wartezeit vor dem n-ten Wiederholungsversuch ohne Zufallsanteil
+    uint32_t backoffCeilingMs(uint32_t failures) const;
+
+    bool inOutage() const { return outage; }
+    unsigned long getOutageDurationMs(unsigned long nowMs) const { return outage ? nowMs - outageStartMs : 0; }
+    unsigned long getNextAttemptMs() const { return nextAttemptMs; }
+    uint32_t getConsecutiveFailures() const { return consecutiveFailures; }
+    uint32_t getLastDelayMs() const { return lastDelayMs; }
+    uint32_t getOutageCount() const { return outageCount; }
+    uint32_t getAttemptCount() const { return attemptCount; }
+    uint32_t getFailureCount() const { return failureCount; }
+    unsigned long getLongestOutageMs() const { return longestOutageMs; }
+    unsigned long getTotalOutageMs() const { return totalOutageMs; }
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef RTC_CACHE_H
+#define RTC_CACHE_H
+
+#include <Arduino.h>
+#include <string.h>
+
+// ===== Zustand im RTC Slow Memory =====
+// Übersteht Deep Sleep, nach Kaltstart/Reset ungültig: gilt nur, solange
+// das Magic stimmt. Ohne Konstruktor, damit die Variable mit RTC_CACHE_ATTR
+// im RTC-Speicher liegen kann; Zugriff auf die Felder über ->.
+//
+//   RTC_CACHE_ATTR static RtcCache<MeinZustand, 0x41424331> rtc;   // "ABC1"
+template <typename State, uint32_t MAGIC>
+struct RtcCache {
+    uint32_t magic;
+    State state;
+
+    bool valid() const { return magic == MAGIC; }
+
+    // Felder sind vollständig geschrieben
+    void commit() { magic = MAGIC; }
+
+    void invalidate() { magic = 0; }
+
+    // Leeren und als gültig markieren
+    void reset() {
+        memset(&state, 0, sizeof(state));
+        magic = MAGIC;
+    }
+
+    // Nach Kaltstart/Reset leeren; true, wenn der Inhalt übernommen wurde
+    bool restore() {
+        if (valid()) {
+            return true;
+        }
+        reset();
+        return false;
+    }
+
+    State* operator->() { return &state; }
+    const State* operator->() const { return &state; }
+};
+
+#ifndef NATIVE_BUILD
+#define RTC_CACHE_ATTR RTC_DATA_ATTR
+#else
+#define RTC_CACHE_ATTR                  // Host-Build: bleibt einfach im RAM
+#endif
+
+#endif
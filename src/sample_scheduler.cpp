@@ -0,0 +1,324 @@
+#include "sample_scheduler.h"
+#include <limits.h>
+
+const char* const SampleScheduler::GROUP_NAMES[SAMPLE_GROUP_COUNT] = { "bme", "mpu" };
+
+// Unterhalb dieses Anteils der Schwelle gilt eine Gruppe als ruhig
+static const float EXIT_RATIO = 0.5f;
+
+static bool isBme280Channel(size_t channel) {
+    return channel <= CHANNEL_PRESSURE;
+}
+
+static uint32_t clampInterval(uint32_t intervalMs, const GroupScheduleConfig& groupConfig) {
+    return intervalMs < groupConfig.minIntervalMs ? groupConfig.minIntervalMs
+         : intervalMs > groupConfig.maxIntervalMs ? groupConfig.maxIntervalMs : intervalMs;
+}
+
+static uint32_t secondsToMs(float seconds) {
+    return seconds > 0.0f ? (uint32_t)(seconds * 1000.0f + 0.5f) : 0;
+}
+
+// Konstruktor: Voreinstellungen aus config.h
+SampleScheduler::SampleScheduler() {
+    config.enabled = ADAPTIVE_SAMPLING_ENABLED;
+    config.groups[SAMPLE_GROUP_BME] = { BME_INTERVAL_MIN_MS, BME_INTERVAL_MAX_MS,
+                                        ADAPTIVE_HOLD_S * 1000UL, (float)ADAPTIVE_BME_TAU_S };
+    config.groups[SAMPLE_GROUP_MPU] = { MPU_INTERVAL_MIN_MS, MPU_INTERVAL_MAX_MS,
+                                        ADAPTIVE_HOLD_S * 1000UL, (float)ADAPTIVE_MPU_TAU_S };
+    config.channels[CHANNEL_TEMPERATURE] = { ADAPTIVE_RATE_TEMPERATURE, 0.0f };
+    config.channels[CHANNEL_HUMIDITY] = { ADAPTIVE_RATE_HUMIDITY, 0.0f };
+    config.channels[CHANNEL_PRESSURE] = { ADAPTIVE_RATE_PRESSURE, 0.0f };
+    for (size_t c = CHANNEL_ACCEL_X; c <= CHANNEL_ACCEL_Z; c++) {
+        config.channels[c] = { 0.0f, ADAPTIVE_STDDEV_ACCEL };
+    }
+    for (size_t c = CHANNEL_GYRO_X; c <= CHANNEL_GYRO_Z; c++) {
+        config.channels[c] = { 0.0f, ADAPTIVE_STDDEV_GYRO };
+    }
+    requested = config;
+    scheduledGroups = (1 << SAMPLE_GROUP_COUNT) - 1;
+
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        GroupState& state = groups[g];
+        state.intervalMs = config.enabled ? config.groups[g].maxIntervalMs : SENSOR_READ_INTERVAL_MS;
+        state.nextDueMs = 0;   // Erste Messung sofort
+        state.lastReadMs = 0;
+        state.lastActiveMs = 0;
+        state.activity = 0.0f;
+        state.active = false;
+        state.primed = false;
+        state.readCount = 0;
+        state.activationCount = 0;
+    }
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        channels[c] = { 0.0f, 0.0f, 0.0f, false };
+    }
+}
+
+void SampleScheduler::begin(uint8_t groupMask) {
+    groupMask &= (1 << SAMPLE_GROUP_COUNT) - 1;
+    scheduledGroups = groupMask ? groupMask : (1 << SAMPLE_GROUP_COUNT) - 1;
+}
+
+// ===== Sensor-Task =====
+
+uint8_t SampleScheduler::due(unsigned long now, unsigned long& scheduledMs) {
+    applyPending();
+
+    uint8_t mask = 0;
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        unsigned long dueMs = groups[g].nextDueMs;
+        if (!(scheduledGroups & (1 << g)) || (long)(now - dueMs) < 0) {
+            continue;
+        }
+        if (mask == 0 || (long)(dueMs - scheduledMs) < 0) {
+            scheduledMs = dueMs;
+        }
+        mask |= 1 << g;
+    }
+    return mask;
+}
+
+unsigned long SampleScheduler::msUntilDue(unsigned long now) const {
+    long wait = LONG_MAX;
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        if (!(scheduledGroups & (1 << g))) {
+            continue;
+        }
+        long remaining = (long)(groups[g].nextDueMs - now);
+        if (remaining < wait) {
+            wait = remaining;
+        }
+    }
+    return wait > 0 ? (unsigned long)wait : 0;
+}
+
+void SampleScheduler::observe(const SensorData& data, uint8_t groupMask, unsigned long now) {
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        if (groupMask & (1 << g)) {
+            observeGroup((SampleGroup)g, data, now);
+        }
+    }
+}
+
+void SampleScheduler::observeGroup(SampleGroup group, const SensorData& data, unsigned long now) {
+    GroupState& state = groups[group];
+    const GroupScheduleConfig& groupConfig = config.groups[group];
+    float dtS = state.primed ? (now - state.lastReadMs) / 1000.0f : 0.0f;
+    state.lastReadMs = now;
+    state.primed = true;
+    state.readCount++;
+
+    if (!config.enabled) {
+        state.intervalMs = SENSOR_READ_INTERVAL_MS;
+        state.active = false;
+    } else {
+        // Aktivität: größtes Verhältnis zur Schwelle über die Kanäle der Gruppe
+        bool valid = group == SAMPLE_GROUP_BME ? data.bme280Valid : data.mpu9250Valid;
+        float activity = 0.0f;
+        for (size_t c = 0; c < CHANNEL_COUNT && valid; c++) {
+            if (isBme280Channel(c) == (group == SAMPLE_GROUP_BME)) {
+                float ratio = updateChannel(c, data.*TelemetryFilter::CHANNEL_FIELDS[c], dtS, groupConfig.tauS);
+                if (ratio > activity) {
+                    activity = ratio;
+                }
+            }
+        }
+        state.activity = activity;
+
+        if (activity >= 1.0f || (state.active && activity >= EXIT_RATIO)) {
+            if (!state.active) {
+                state.active = true;
+                state.activationCount++;
+            }
+            state.lastActiveMs = now;
+            state.intervalMs = groupConfig.minIntervalMs;
+        } else if (!state.active || now - state.lastActiveMs >= groupConfig.holdMs) {
+            // Ruhig: schrittweise zurück zum Grundtakt
+            state.active = false;
+            state.intervalMs = state.intervalMs > groupConfig.maxIntervalMs / 2
+                             ? groupConfig.maxIntervalMs : state.intervalMs * 2;
+        }
+        state.intervalMs = clampInterval(state.intervalMs, groupConfig);
+    }
+
+    // Nächster Termin ab dem geplanten, nicht ab dem tatsächlichen Zeitpunkt
+    // (kein Drift); liegt er schon zurück, ab jetzt neu aufsetzen
+    unsigned long next = state.nextDueMs + state.intervalMs;
+    if ((long)(next - now) <= 0) {
+        next = now + state.intervalMs;
+    }
+    state.nextDueMs = next;
+}
+
+// Gleitender Mittelwert, Streuung und Steigung eines Kanals; Gewicht nach
+// der verstrichenen Zeit. Rückgabe: Verhältnis zur Schwelle (>= 1 = aktiv)
+float SampleScheduler::updateChannel(size_t channel, float value, float dtS, float tauS) {
+    ChannelState& state = channels[channel];
+    if (isnan(value)) {
+        return 0.0f;
+    }
+    if (!state.primed) {
+        state = { value, 0.0f, 0.0f, true };
+        return 0.0f;
+    }
+
+    if (dtS > 0.0f) {
+        float alpha = 1.0f - expf(-dtS / tauS);
+        float deviation = value - state.mean;
+        float previous = state.mean;
+        state.mean += alpha * deviation;
+        // Quadrierte Abweichung vom bisherigen Mittelwert: bei seltener
+        // Messung (alpha nahe 1) zählt schon der erste abweichende Wert
+        state.variance += alpha * (deviation * deviation - state.variance);
+        state.slope += alpha * ((state.mean - previous) / dtS - state.slope);
+    }
+
+    const ChannelActivityConfig& threshold = config.channels[channel];
+    float ratio = 0.0f;
+    if (threshold.ratePerMin > 0.0f) {
+        ratio = fabsf(state.slope) * 60.0f / threshold.ratePerMin;
+    }
+    if (threshold.stddev > 0.0f) {
+        float stddevRatio = sqrtf(state.variance) / threshold.stddev;
+        if (stddevRatio > ratio) {
+            ratio = stddevRatio;
+        }
+    }
+    return ratio;
+}
+
+// Neue Grenzen aus dem Netzwerk-Task; das laufende Intervall wird
+// eingegrenzt und der nächste Termin ggf. vorgezogen
+void SampleScheduler::applyPending() {
+    SamplingConfig updated;
+    bool changed = false;
+    while (pending.pop(updated)) {
+        config = updated;
+        changed = true;
+    }
+    if (!changed) {
+        return;
+    }
+
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        GroupState& state = groups[g];
+        const GroupScheduleConfig& groupConfig = config.groups[g];
+        if (config.enabled) {
+            state.intervalMs = clampInterval(state.intervalMs, groupConfig);
+        } else {
+            state.intervalMs = SENSOR_READ_INTERVAL_MS;
+            state.active = false;
+        }
+        unsigned long next = state.lastReadMs + state.intervalMs;
+        if (state.primed && (long)(next - state.nextDueMs) < 0) {
+            state.nextDueMs = next;
+        }
+    }
+}
+
+// ===== Netzwerk-Task =====
+
+bool SampleScheduler::validate(const SamplingConfig& candidate) {
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        const GroupScheduleConfig& groupConfig = candidate.groups[g];
+        if (groupConfig.minIntervalMs == 0 || groupConfig.minIntervalMs > groupConfig.maxIntervalMs ||
+            !(groupConfig.tauS > 0.0f)) {
+            return false;
+        }
+    }
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        if (!(candidate.channels[c].ratePerMin >= 0.0f) || !(candidate.channels[c].stddev >= 0.0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SampleScheduler::requestConfig(const SamplingConfig& updated) {
+    if (!validate(updated) || !pending.push(updated)) {
+        return false;
+    }
+    requested = updated;
+    return true;
+}
+
+// Zeiten in Sekunden, Raten je Minute. Eine ungültige Nachricht wird ganz
+// verworfen, damit min/max nie aus zwei verschiedenen Nachrichten stammen
+bool SampleScheduler::applyConfig(JsonVariantConst samplingConfig) {
+    SamplingConfig updated = requested;
+
+    if (samplingConfig.containsKey("enabled")) {
+        updated.enabled = samplingConfig["enabled"].as<bool>();
+    }
+
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        JsonVariantConst groupConfig = samplingConfig[GROUP_NAMES[g]];
+        if (groupConfig.isNull()) {
+            continue;
+        }
+        GroupScheduleConfig& target = updated.groups[g];
+        if (groupConfig.containsKey("min")) {
+            target.minIntervalMs = secondsToMs(groupConfig["min"].as<float>());
+        }
+        if (groupConfig.containsKey("max")) {
+            target.maxIntervalMs = secondsToMs(groupConfig["max"].as<float>());
+        }
+        if (groupConfig.containsKey("hold")) {
+            target.holdMs = secondsToMs(groupConfig["hold"].as<float>());
+        }
+        if (groupConfig.containsKey("tau")) {
+            target.tauS = groupConfig["tau"].as<float>();
+        }
+    }
+
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        JsonVariantConst channelConfig = samplingConfig[TelemetryFilter::CHANNEL_NAMES[c]];
+        if (channelConfig.isNull()) {
+            continue;
+        }
+        if (channelConfig.containsKey("rate")) {
+            updated.channels[c].ratePerMin = channelConfig["rate"].as<float>();
+        }
+        if (channelConfig.containsKey("std")) {
+            updated.channels[c].stddev = channelConfig["std"].as<float>();
+        }
+    }
+
+    if (!validate(updated)) {
+        Serial.println("❌ Abtastung: ungültige Grenzen (min > 0, min <= max, Schwellen >= 0)");
+        return false;
+    }
+    if (!requestConfig(updated)) {
+        Serial.println("❌ Abtastung: vorherige Änderung noch nicht übernommen");
+        return false;
+    }
+    return true;
+}
+
+bool SampleScheduler::commandHandler(JsonVariantConst command, void* context) {
+    if (!command.containsKey("sampling")) {
+        return false;
+    }
+    SampleScheduler* scheduler = (SampleScheduler*)context;
+    if (scheduler->applyConfig(command["sampling"])) {
+        Serial.println("✅ Abtast-Konfiguration übernommen");
+    }
+    scheduler->printConfig();
+    return true;
+}
+
+void SampleScheduler::printConfig() const {
+    Serial.printf("Adaptive Abtastung: %s\n", requested.enabled ? "aktiv" : "aus (fester Takt)");
+    for (size_t g = 0; g < SAMPLE_GROUP_COUNT; g++) {
+        const GroupScheduleConfig& groupConfig = requested.groups[g];
+        Serial.printf("  %-4s %6.1f .. %6.1f s  Halten %4lu s  Tau %5.1f s  aktuell %6.1f s%s\n",
+                      GROUP_NAMES[g], groupConfig.minIntervalMs / 1000.0f, groupConfig.maxIntervalMs / 1000.0f,
+                      (unsigned long)(groupConfig.holdMs / 1000), groupConfig.tauS,
+                      groups[g].intervalMs / 1000.0f, groups[g].active ? " (schnell)" : "");
+    }
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        Serial.printf("  %-12s Rate %8.3f /min  Streuung %8.3f\n", TelemetryFilter::CHANNEL_NAMES[c],
+                      requested.channels[c].ratePerMin, requested.channels[c].stddev);
+    }
+}
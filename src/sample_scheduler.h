@@ -0,0 +1,125 @@
+#ifndef SAMPLE_SCHEDULER_H
+#define SAMPLE_SCHEDULER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "sensors.h"
+#include "spsc_queue.h"
+#include "telemetry_filter.h"
+
+// Sensoren mit eigenem Takt
+enum SampleGroup {
+    SAMPLE_GROUP_BME,
+    SAMPLE_GROUP_MPU,
+    SAMPLE_GROUP_COUNT
+};
+
+// Takt einer Gruppe
+struct GroupScheduleConfig {
+    uint32_t minIntervalMs;   // Schneller Takt bei Aktivität
+    uint32_t maxIntervalMs;   // Grundtakt in Ruhe
+    uint32_t holdMs;          // So lange schnell nach der letzten Aktivität
+    float tauS;               // Zeitkonstante für Mittelwert, Streuung und Steigung
+};
+
+// Aktivitätsschwellen eines Kanals (0 = Kriterium aus)
+struct ChannelActivityConfig {
+    float ratePerMin;         // Änderung des geglätteten Werts [Einheit/min]
+    float stddev;             // Kurzzeit-Streuung [Einheit]
+};
+
+struct SamplingConfig {
+    bool enabled;             // false: beide Gruppen fest alle SENSOR_READ_INTERVAL_MS
+    GroupScheduleConfig groups[SAMPLE_GROUP_COUNT];
+    ChannelActivityConfig channels[CHANNEL_COUNT];
+};
+
+// ===== Adaptive Abtastung =====
+// Jede Gruppe (BME280, MPU9250) hat einen eigenen nächsten Messzeitpunkt.
+// Nach jeder Messung werden je Kanal gleitender Mittelwert, Streuung und
+// Steigung des Mittelwerts nachgeführt (exponentiell, Gewicht nach der
+// verstrichenen Zeit, daher unabhängig vom gerade gültigen Takt). Die
+// Aktivität einer Gruppe ist das größte Verhältnis Messgröße/Schwelle
+// ihrer Kanäle:
+//   >= 1    schneller Takt (minIntervalMs), Haltezeit beginnt neu
+//   >= 0,5  bleibt schnell (Hysterese), Haltezeit beginnt neu
+//   sonst   nach Ablauf der Haltezeit Intervall je Messung verdoppeln
+//           bis zum Grundtakt (maxIntervalMs)
+//
+// Zustand und Takt gehören dem Sensor-Task. Neue Grenzen kommen per C2D
+// im Netzwerk-Task an und gehen über eine Warteschlange an den Sensor-Task
+// (greifen spätestens beim nächsten geplanten Messzeitpunkt), z.B.
+//   {"sampling":{"bme":{"min":2,"max":120,"hold":300},
+//                "pressure":{"rate":0.05},"accelZ":{"std":0.02}}}
+class SampleScheduler {
+private:
+    struct ChannelState {
+        float mean;
+        float variance;
+        float slope;              // Steigung des Mittelwerts [Einheit/s]
+        bool primed;
+    };
+
+    struct GroupState {
+        uint32_t intervalMs;
+        unsigned long nextDueMs;
+        unsigned long lastReadMs;
+        unsigned long lastActiveMs;
+        float activity;
+        bool active;
+        bool primed;
+        uint32_t readCount;
+        uint32_t activationCount;   // Wechsel in den schnellen Takt
+    };
+
+    SamplingConfig config;          // Sensor-Task
+    SamplingConfig requested;       // Netzwerk-Task (C2D), Stand der letzten Anforderung
+    SpscQueue<SamplingConfig, 2> pending;
+    uint8_t scheduledGroups;        // Bitmaske (1 << SampleGroup) der geplanten Gruppen
+    GroupState groups[SAMPLE_GROUP_COUNT];
+    ChannelState channels[CHANNEL_COUNT];
+
+    void applyPending();
+    void observeGroup(SampleGroup group, const SensorData& data, unsigned long now);
+    float updateChannel(size_t channel, float value, float dtS, float tauS);
+    static bool validate(const SamplingConfig& candidate);
+
+public:
+    static const char* const GROUP_NAMES[SAMPLE_GROUP_COUNT];
+
+    SampleScheduler();  // Voreinstellungen aus config.h
+
+    // Nur Gruppen mit gefundenem Sensor planen (1 << SampleGroup); vor dem
+    // Start des Sensor-Tasks. Ohne jeden Sensor bleiben alle geplant, damit
+    // die Lesefehler sichtbar bleiben
+    void begin(uint8_t groupMask);
+
+    // ===== Sensor-Task =====
+    // Fällige Gruppen als Bitmaske (1 << SampleGroup), 0 = keine;
+    // scheduledMs = geplanter Zeitpunkt der frühesten fälligen Gruppe
+    uint8_t due(unsigned long now, unsigned long& scheduledMs);
+    // Nach dem Auslesen der fälligen Gruppen: Aktivität und nächsten Termin bestimmen
+    void observe(const SensorData& data, uint8_t groupMask, unsigned long now);
+    unsigned long msUntilDue(unsigned long now) const;
+
+    // ===== Netzwerk-Task =====
+    // false bei ungültigen Grenzen (min > max, 0, negative Schwellen)
+    bool requestConfig(const SamplingConfig& updated);
+    const SamplingConfig& getRequestedConfig() const { return requested; }
+    // Übernimmt das "sampling"-Objekt einer C2D-Nachricht; false bei Fehlern
+    bool applyConfig(JsonVariantConst samplingConfig);
+    void printConfig() const;
+
+    // Für MQTTClient::onCommand (context = SampleScheduler*)
+    static bool commandHandler(JsonVariantConst command, void* context);
+
+    // Statistik (vom Sensor-Task geschrieben, Lesen von überall)
+    uint32_t getIntervalMs(SampleGroup group) const { return groups[group].intervalMs; }
+    bool isActive(SampleGroup group) const { return groups[group].active; }
+    float getActivity(SampleGroup group) const { return groups[group].activity; }
+    uint32_t getReadCount(SampleGroup group) const { return groups[group].readCount; }
+    uint32_t getActivationCount(SampleGroup group) const { return groups[group].activationCount; }
+};
+
+#endif
@@ -1,190 +1,263 @@
 #include "sas.h"
 #include "mbedtls/base64.h"  // mbedTLS Bibliothek für Base64 En-/Dekodierung
-#include "mbedtls/md.h"       // mbedTLS Bibliothek für HMAC-SHA256
-#include <WiFi.h>
-#include "wifi_setup.h"
 
 // Konstruktor: Keine Initialisierung erforderlich
 SASToken::SASToken() {
 }
 
 // ===== URL Encoding =====
-// Konvertiert Sonderzeichen in URL-sichere Format (%XX)
-// Notwendig für korrekte SAS-Token Formatierung
-String SASToken::urlEncode(const String& str) {
-    String encoded = "";
-    char c;
-    char code0, code1;  // Hexadezimale Zeichen für kodierung
-    
-    // Jedes Zeichen durchgehen
-    for (int i = 0; i < str.length(); i++) {
-        c = str.charAt(i);
-        
+// Konvertiert Sonderzeichen in URL-sicheres Format (%XX)
+// Notwendig für korrekte SAS-Token Formatierung (Base64 enthält +, / und =)
+size_t SASToken::urlEncode(const char* input, size_t length, char* output, size_t outputSize) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    size_t pos = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)input[i];
+        // Platz für bis zu 3 Zeichen plus Null-Terminator
+        if (pos + 4 > outputSize) {
+            return 0;
+        }
+
         if (c == ' ') {
-            // Leerzeichen wird zu '+' (URL-Standard)
-            encoded += '+';
+            output[pos++] = '+';
         } else if (isalnum(c)) {
-            // Buchstaben und Zahlen bleiben unverändert
-            encoded += c;
+            output[pos++] = (char)c;
         } else {
-            // Sonderzeichen werden in Hexadezimal kodiert (%XX)
-            
-            // Untere 4 Bits (Low Nibble)
-            code1 = (c & 0xf) + '0';
-            if ((c & 0xf) > 9) {
-                code1 = (c & 0xf) - 10 + 'A';  // A-F für 10-15
-            }
-            
-            // Obere 4 Bits (High Nibble)
-            c = (c >> 4) & 0xf;
-            code0 = c + '0';
-            if (c > 9) {
-                code0 = c - 10 + 'A';  // A-F für 10-15
-            }
-            
-            // %XX Format zusammenbauen
-            encoded += '%';
-            encoded += code0;
-            encoded += code1;
+            output[pos++] = '%';
+            output[pos++] = HEX_DIGITS[c >> 4];
+            output[pos++] = HEX_DIGITS[c & 0xF];
         }
     }
-    return encoded;
+
+    if (pos >= outputSize) {
+        return 0;
+    }
+    output[pos] = '\0';
+    return pos;
 }
 
-// ===== Base64 Dekodierung =====
-// Dekodiert Base64-kodierten Device Key zurück in Binärformat
-// Azure IoT Hub Device Keys sind Base64-kodiert gespeichert
-String SASToken::base64Decode(const String& input) {
-    size_t outputLen;
-    
-    // ===== Schritt 1: Benötigte Ausgabegröße berechnen =====
-    // Nullpointer-Aufruf um nur Größe zu ermitteln
-    mbedtls_base64_decode(NULL, 0, &outputLen, 
-                         (const unsigned char*)input.c_str(), 
-                         input.length());
-    
-    // Speicher für dekodierte Daten allokieren (+1 für Null-Terminator)
-    unsigned char* output = new unsigned char[outputLen + 1];
-    
-    // ===== Schritt 2: Tatsächliche Dekodierung durchführen =====
-    int ret = mbedtls_base64_decode(output, outputLen, &outputLen,
-                                    (const unsigned char*)input.c_str(),
-                                    input.length());
-    
-    // Fehlerbehandlung
-    if (ret != 0) {
-        delete[] output;
-        return "";  // Leerer String bei Fehler
-    }
-    
-    // Null-Terminator hinzufügen
-    output[outputLen] = '\0';
-    
-    // In String konvertieren und Speicher freigeben
-    String result = String((char*)output);
-    delete[] output;
-    
-    return result;
+// ===== Base64 Dekodierung des Device Keys =====
+// Azure IoT Hub Device Keys sind Base64-kodierte Binärdaten (meist 32 Bytes).
+// Ergebnis bleibt binär mit Länge – ein Null-Byte im Key ist kein Ende.
+size_t SASToken::decodeKey(const char* deviceKey, uint8_t* key, size_t keySize) {
+    size_t keyLength = 0;
+    int ret = mbedtls_base64_decode(key, keySize, &keyLength,
+                                    (const unsigned char*)deviceKey, strlen(deviceKey));
+    return ret == 0 ? keyLength : 0;
+}
+
+// ===== HMAC-SHA256 vorbereiten (RFC 2104) =====
+// Keys länger als ein Block werden zuerst gehasht, kürzere mit Nullen aufgefüllt
+void SASToken::prepareHmac(const uint8_t* key, size_t keyLength,
+                           mbedtls_sha256_context* inner, mbedtls_sha256_context* outer) {
+    uint8_t block[HMAC_BLOCK_SIZE] = {0};
+    if (keyLength > HMAC_BLOCK_SIZE) {
+        mbedtls_sha256_context ctx;
+        mbedtls_sha256_init(&ctx);
+        mbedtls_sha256_starts_ret(&ctx, 0);
+        mbedtls_sha256_update_ret(&ctx, key, keyLength);
+        mbedtls_sha256_finish_ret(&ctx, block);
+        mbedtls_sha256_free(&ctx);
+    } else {
+        memcpy(block, key, keyLength);
+    }
+
+    uint8_t pad[HMAC_BLOCK_SIZE];
+    for (size_t i = 0; i < HMAC_BLOCK_SIZE; i++) pad[i] = block[i] ^ 0x36;
+    mbedtls_sha256_starts_ret(inner, 0);
+    mbedtls_sha256_update_ret(inner, pad, sizeof(pad));
+
+    for (size_t i = 0; i < HMAC_BLOCK_SIZE; i++) pad[i] = block[i] ^ 0x5c;
+    mbedtls_sha256_starts_ret(outer, 0);
+    mbedtls_sha256_update_ret(outer, pad, sizeof(pad));
+
+    // Schlüsselmaterial nicht auf dem Stack liegen lassen
+    memset(block, 0, sizeof(block));
+    memset(pad, 0, sizeof(pad));
 }
 
 // ===== HMAC-SHA256 Signatur =====
-// Erstellt kryptographische Signatur mit HMAC-SHA256 Algorithmus
-// Diese Signatur beweist gegenüber Azure IoT Hub, dass wir den Device Key kennen
-String SASToken::hmacSha256(const String& key, const String& data) {
-    mbedtls_md_context_t ctx;
-    mbedtls_md_type_t md_type = MBEDTLS_MD_SHA256;  // SHA256 Hash-Algorithmus
-    const size_t messageLength = data.length();
-    const size_t keyLength = key.length();
-    
-    unsigned char hmacResult[32];  // SHA256 erzeugt immer 32 Bytes (256 Bits)
-    
-    // ===== HMAC Berechnung =====
-    mbedtls_md_init(&ctx);  // Kontext initialisieren
-    
-    // Setup mit SHA256 und HMAC-Modus (1 = HMAC aktiviert)
-    mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(md_type), 1);
-    
-    // HMAC starten mit Schlüssel
-    mbedtls_md_hmac_starts(&ctx, (const unsigned char*)key.c_str(), keyLength);
-    
-    // Daten verarbeiten (kann mehrfach aufgerufen werden für große Daten)
-    mbedtls_md_hmac_update(&ctx, (const unsigned char*)data.c_str(), messageLength);
-    
-    // HMAC abschließen und Resultat in hmacResult speichern
-    mbedtls_md_hmac_finish(&ctx, hmacResult);
-    
-    // Kontext freigeben
-    mbedtls_md_free(&ctx);
-    
-    // ===== Base64 Encoding des HMAC-Results =====
-    // Azure IoT Hub erwartet die Signatur Base64-kodiert
-    
-    // Schritt 1: Benötigte Größe berechnen
-    size_t outputLen;
-    mbedtls_base64_encode(NULL, 0, &outputLen, hmacResult, 32);
-    
-    // Schritt 2: Speicher allokieren und kodieren
-    unsigned char* encoded = new unsigned char[outputLen + 1];
-    mbedtls_base64_encode(encoded, outputLen, &outputLen, hmacResult, 32);
-    encoded[outputLen] = '\0';
-    
-    // In String konvertieren und Speicher freigeben
-    String result = String((char*)encoded);
-    delete[] encoded;
-    
-    return result;
+// H(K XOR opad || H(K XOR ipad || data)) ab den vorbereiteten Zuständen
+void SASToken::finishHmac(const mbedtls_sha256_context* inner, const mbedtls_sha256_context* outer,
+                          const uint8_t* data, size_t length, uint8_t mac[32]) {
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+
+    uint8_t innerHash[32];
+    mbedtls_sha256_clone(&ctx, inner);
+    mbedtls_sha256_update_ret(&ctx, data, length);
+    mbedtls_sha256_finish_ret(&ctx, innerHash);
+
+    mbedtls_sha256_clone(&ctx, outer);
+    mbedtls_sha256_update_ret(&ctx, innerHash, sizeof(innerHash));
+    mbedtls_sha256_finish_ret(&ctx, mac);
+
+    mbedtls_sha256_free(&ctx);
+}
+
+// resource = hostname/devices/deviceId
+size_t SASToken::formatResource(const char* hostname, const char* deviceId, char* output, size_t outputSize) {
+    int written = snprintf(output, outputSize, "%s/devices/%s", hostname, deviceId);
+    return (written < 0 || (size_t)written >= outputSize) ? 0 : (size_t)written;
+}
+
+// ===== Token zusammensetzen =====
+// Azure IoT Hub erwartet dieses spezifische Format:
+// SharedAccessSignature sr={resource}&sig={signature}&se={expiry}
+// - sr = Shared Resource (welches Device)
+// - sig = Signature (Beweis dass wir den Key kennen), Base64 + URL-kodiert
+// - se = Expiry (Unix-Timestamp wann Token ungültig wird)
+size_t SASToken::formatToken(const char* resourceUri, const uint8_t mac[32], unsigned long expiry,
+                             char* output, size_t outputSize) {
+    unsigned char signature[48];
+    size_t signatureLength = 0;
+    if (mbedtls_base64_encode(signature, sizeof(signature), &signatureLength, mac, 32) != 0) {
+        return 0;
+    }
+
+    int head = snprintf(output, outputSize, "SharedAccessSignature sr=%s&sig=", resourceUri);
+    if (head < 0 || (size_t)head >= outputSize) {
+        return 0;
+    }
+    size_t pos = head;
+
+    size_t encoded = urlEncode((const char*)signature, signatureLength, output + pos, outputSize - pos);
+    if (encoded == 0) {
+        return 0;
+    }
+    pos += encoded;
+
+    int tail = snprintf(output + pos, outputSize - pos, "&se=%lu", expiry);
+    if (tail < 0 || pos + tail >= outputSize) {
+        return 0;
+    }
+    return pos + tail;
 }
 
 // ===== SAS-Token Generierung =====
 // Generiert ein vollständiges Shared Access Signature Token für Azure IoT Hub
-// Format: SharedAccessSignature sr={resource}&sig={signature}&se={expiry}
-String SASToken::generate(const char* hostname, 
-                         const char* deviceId, 
-                         const char* deviceKey,
-                         unsigned long expiryInSeconds) {
-    
+size_t SASToken::generate(const char* hostname,
+                          const char* deviceId,
+                          const char* deviceKey,
+                          unsigned long expiryInSeconds,
+                          char* output, size_t outputSize) {
     // ===== Schritt 1: String to Sign erstellen =====
     // Format: {resource}\n{expiry}
-    // resource = hostname/devices/deviceId
-    String resourceUri = String(hostname) + "/devices/" + String(deviceId);
-    String stringToSign = resourceUri + "\n" + String(expiryInSeconds);
-    
+    char resourceUri[MAX_RESOURCE_SIZE];
+    if (formatResource(hostname, deviceId, resourceUri, sizeof(resourceUri)) == 0) {
+        return 0;
+    }
+    char stringToSign[MAX_RESOURCE_SIZE + 12];
+    int length = snprintf(stringToSign, sizeof(stringToSign), "%s\n%lu", resourceUri, expiryInSeconds);
+    if (length < 0 || (size_t)length >= sizeof(stringToSign)) {
+        return 0;
+    }
+
     // ===== Schritt 2: Device Key dekodieren =====
-    // Der Device Key aus Azure IoT Hub ist Base64-kodiert
-    String decodedKey = base64Decode(String(deviceKey));
-    
+    uint8_t key[MAX_DECODED_KEY_SIZE];
+    size_t keyLength = decodeKey(deviceKey, key, sizeof(key));
+    if (keyLength == 0) {
+        return 0;
+    }
+
     // ===== Schritt 3: Signatur erstellen =====
-    // HMAC-SHA256 des "String to Sign" mit dekodiertem Key
-    String signature = hmacSha256(decodedKey, stringToSign);
-    
-    // ===== Schritt 4: Signatur URL-kodieren =====
-    // Signatur enthält Base64-Zeichen (+, /, =) die URL-kodiert werden müssen
-    String encodedSignature = urlEncode(signature);
-    
-    // ===== Schritt 5: SAS Token zusammenbauen =====
-    // Azure IoT Hub erwartet dieses spezifische Format:
-    // SharedAccessSignature sr={resource}&sig={signature}&se={expiry}
-    // - sr = Shared Resource (welches Device)
-    // - sig = Signature (Beweis dass wir den Key kennen)
-    // - se = Expiry (Unix-Timestamp wann Token ungültig wird)
-    String sasToken = "SharedAccessSignature sr=" + resourceUri + 
-                     "&sig=" + encodedSignature + 
-                     "&se=" + String(expiryInSeconds);
-    
-    return sasToken;
+    mbedtls_sha256_context inner, outer;
+    mbedtls_sha256_init(&inner);
+    mbedtls_sha256_init(&outer);
+    prepareHmac(key, keyLength, &inner, &outer);
+    memset(key, 0, sizeof(key));
+
+    uint8_t mac[32];
+    finishHmac(&inner, &outer, (const uint8_t*)stringToSign, length, mac);
+    mbedtls_sha256_free(&inner);
+    mbedtls_sha256_free(&outer);
+
+    // ===== Schritt 4: Token zusammenbauen =====
+    return formatToken(resourceUri, mac, expiryInSeconds, output, outputSize);
 }
 
 // ===== SAS-Token mit Standardgültigkeit =====
-// Convenience-Funktion: Generiert Token mit 24 Stunden Gültigkeit
-// Dies ist die am häufigsten verwendete Funktion
-String SASToken::generateDefault(const char* hostname, 
-                                const char* deviceId, 
-                                const char* deviceKey,
-                                unsigned long currentEpoch) {
-    
-    // Ablaufzeit = Aktuelle Zeit + 86400 Sekunden (24 Stunden)
-    unsigned long expiry = currentEpoch + 86400;
-    
-    // Token mit berechneter Ablaufzeit generieren
-    return generate(hostname, deviceId, deviceKey, expiry);
-}
\ No newline at end of file
+// Ablaufzeit = Aktuelle Zeit + SAS_TOKEN_LIFETIME_S (Standard 24 Stunden)
+size_t SASToken::generateDefault(const char* hostname,
+                                 const char* deviceId,
+                                 const char* deviceKey,
+                                 unsigned long currentEpoch,
+                                 char* output, size_t outputSize) {
+    return generate(hostname, deviceId, deviceKey, currentEpoch + SAS_TOKEN_LIFETIME_S, output, outputSize);
+}
+
+
+// ===== SAS-Token-Cache =====
+
+SasTokenCache::SasTokenCache() : ready(false), lifetimeS(0), expiry(0), renewAt(0), renewalCount(0) {
+    resourceUri[0] = '\0';
+    token[0] = '\0';
+    mbedtls_sha256_init(&innerState);
+    mbedtls_sha256_init(&outerState);
+}
+
+// Key dekodieren und HMAC-Zustände vorberechnen
+bool SasTokenCache::begin(const char* hostname, const char* deviceId, const char* deviceKey,
+                          uint32_t lifetimeSeconds) {
+    ready = false;
+    expiry = 0;
+    renewAt = 0;
+    token[0] = '\0';
+    lifetimeS = lifetimeSeconds;
+
+    if (SASToken::formatResource(hostname, deviceId, resourceUri, sizeof(resourceUri)) == 0) {
+        return false;
+    }
+
+    uint8_t key[SASToken::MAX_DECODED_KEY_SIZE];
+    size_t keyLength = SASToken::decodeKey(deviceKey, key, sizeof(key));
+    if (keyLength == 0) {
+        return false;
+    }
+    SASToken::prepareHmac(key, keyLength, &innerState, &outerState);
+    memset(key, 0, sizeof(key));
+
+    ready = true;
+    return true;
+}
+
+bool SasTokenCache::needsRenewal(unsigned long currentEpoch) const {
+    return token[0] == '\0' || currentEpoch >= renewAt;
+}
+
+// ===== Neues Token erzeugen =====
+bool SasTokenCache::renew(unsigned long currentEpoch) {
+    if (!ready || currentEpoch == 0) {
+        return false;
+    }
+
+    unsigned long newExpiry = currentEpoch + lifetimeS;
+    char stringToSign[SASToken::MAX_RESOURCE_SIZE + 12];
+    int length = snprintf(stringToSign, sizeof(stringToSign), "%s\n%lu", resourceUri, newExpiry);
+    if (length < 0 || (size_t)length >= sizeof(stringToSign)) {
+        return false;
+    }
+
+    uint8_t mac[32];
+    SASToken::finishHmac(&innerState, &outerState, (const uint8_t*)stringToSign, length, mac);
+    if (SASToken::formatToken(resourceUri, mac, newExpiry, token, sizeof(token)) == 0) {
+        token[0] = '\0';
+        return false;
+    }
+
+    // Erneuern zwischen RENEW_FRACTION und der Hälfte der Restlaufzeit danach
+    uint32_t renewAfter = (uint32_t)(lifetimeS * SAS_TOKEN_RENEW_FRACTION);
+    uint32_t jitter = (lifetimeS - renewAfter) / 2;
+    expiry = newExpiry;
+    renewAt = currentEpoch + renewAfter + (jitter > 0 ? random(jitter) : 0);
+    renewalCount++;
+    return true;
+}
+
+const char* SasTokenCache::get(unsigned long currentEpoch) {
+    if (needsRenewal(currentEpoch) && !renew(currentEpoch)) {
+        return nullptr;
+    }
+    return token;
+}
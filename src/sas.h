@@ -2,27 +2,96 @@
 #define SAS_H
 
 #include <Arduino.h>
+#include "config.h"
+#include "mbedtls/sha256.h"
 
+// ===== SAS-Token für Azure IoT Hub =====
+// Format: SharedAccessSignature sr={resource}&sig={signature}&se={expiry}
+// mit signature = URL(Base64(HMAC-SHA256(Base64Decode(key), "{resource}\n{expiry}"))).
+//
+// Alle Funktionen schreiben in vom Aufrufer bereitgestellte Puffer und
+// allokieren keinen Heap (auch nicht über mbedtls_md_setup). Der Key wird
+// als Binärdaten mit Länge behandelt und darf Null-Bytes enthalten.
 class SASToken {
-private:
-    String urlEncode(const String& str);
-    String base64Decode(const String& input);
-    String hmacSha256(const String& key, const String& data);
-    
 public:
+    static const size_t HMAC_BLOCK_SIZE = 64;      // SHA-256-Blockgröße
+    static const size_t MAX_DECODED_KEY_SIZE = 128;
+    static const size_t MAX_RESOURCE_SIZE = 160;
+    static const size_t MAX_TOKEN_SIZE = 320;      // Inkl. Null-Terminator
+
     SASToken();
-    
-    // Generiert SAS-Token für Azure IoT Hub
-    String generate(const char* hostname, 
-                   const char* deviceId, 
-                   const char* deviceKey, 
-                   unsigned long expiryInSeconds);
-    
-    // Generiert Token mit Standardablauf (24 Stunden)
-    String generateDefault(const char* hostname, 
-                          const char* deviceId, 
-                          const char* deviceKey,
-                          unsigned long currentEpoch);
+
+    // Token mit gegebener Ablaufzeit; Rückgabe Länge ohne '\0', 0 bei Fehler
+    // (ungültiger Key oder Puffer zu klein)
+    size_t generate(const char* hostname,
+                    const char* deviceId,
+                    const char* deviceKey,
+                    unsigned long expiryInSeconds,
+                    char* output, size_t outputSize);
+
+    // Token mit Standardablauf (SAS_TOKEN_LIFETIME_S ab currentEpoch)
+    size_t generateDefault(const char* hostname,
+                           const char* deviceId,
+                           const char* deviceKey,
+                           unsigned long currentEpoch,
+                           char* output, size_t outputSize);
+
+    // ===== Bausteine (auch für SasTokenCache) =====
+    // Base64-Key dekodieren; Rückgabe Länge in Bytes, 0 bei Fehler
+    static size_t decodeKey(const char* deviceKey, uint8_t* key, size_t keySize);
+    // SHA-256-Zustände nach (Key XOR ipad) und (Key XOR opad), RFC 2104
+    static void prepareHmac(const uint8_t* key, size_t keyLength,
+                            mbedtls_sha256_context* inner, mbedtls_sha256_context* outer);
+    // HMAC aus den vorbereiteten Zuständen (die selbst unverändert bleiben)
+    static void finishHmac(const mbedtls_sha256_context* inner, const mbedtls_sha256_context* outer,
+                           const uint8_t* data, size_t length, uint8_t mac[32]);
+    // Leerzeichen -> '+', Buchstaben/Ziffern unverändert, sonst %XX
+    static size_t urlEncode(const char* input, size_t length, char* output, size_t outputSize);
+    // Setzt das Token aus Ressource, MAC und Ablaufzeit zusammen
+    static size_t formatToken(const char* resourceUri, const uint8_t mac[32], unsigned long expiry,
+                              char* output, size_t outputSize);
+    static size_t formatResource(const char* hostname, const char* deviceId, char* output, size_t outputSize);
+};
+
+// ===== SAS-Token-Cache mit vorberechnetem HMAC-Zustand =====
+// Der Device Key wird nur einmal dekodiert. Für HMAC-SHA256 werden die
+// SHA-256-Zustände nach (Key XOR ipad) und (Key XOR opad) einmal berechnet
+// und pro Signatur nur kopiert; ein neues Token kostet damit zwei kurze
+// SHA-256-Läufe und keinen Heap.
+//
+// Das Token wird nach SAS_TOKEN_RENEW_FRACTION seiner Laufzeit erneuert
+// (plus zufälliger Versatz, damit nicht alle Geräte gleichzeitig
+// reconnecten). Der Aufrufer baut dann kontrolliert eine neue Verbindung
+// auf, bevor IoT Hub die Sitzung beim Ablauf trennt.
+class SasTokenCache {
+private:
+    mbedtls_sha256_context innerState;   // Nach Verarbeitung von Key XOR 0x36
+    mbedtls_sha256_context outerState;   // Nach Verarbeitung von Key XOR 0x5c
+    char resourceUri[SASToken::MAX_RESOURCE_SIZE];
+    char token[SASToken::MAX_TOKEN_SIZE];
+    bool ready;
+
+    uint32_t lifetimeS;
+    unsigned long expiry;       // Ablauf des aktuellen Tokens (Epoch)
+    unsigned long renewAt;      // Ab hier erneuern (Epoch)
+    uint32_t renewalCount;
+
+public:
+    SasTokenCache();
+
+    // Dekodiert den Key und berechnet die HMAC-Zustände; false bei ungültigem Key
+    bool begin(const char* hostname, const char* deviceId, const char* deviceKey,
+               uint32_t lifetimeSeconds = SAS_TOKEN_LIFETIME_S);
+
+    // Liefert ein gültiges Token; erneuert es bei Bedarf (nullptr ohne begin()
+    // oder ohne gültige Zeit)
+    const char* get(unsigned long currentEpoch);
+    bool renew(unsigned long currentEpoch);
+    bool needsRenewal(unsigned long currentEpoch) const;
+
+    unsigned long getExpiry() const { return expiry; }
+    unsigned long getRenewAt() const { return renewAt; }
+    uint32_t getRenewalCount() const { return renewalCount; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,263 @@
+#include "sensor_drivers.h"
+#include "config.h"
+#include "sensors.h"
+
+// ===== BME280 =====
+
+const char Bme280Driver::NAME[] = "BME280";
+const uint8_t Bme280Driver::ADDRESSES[] = { 0x76, 0x77 };   // je nach Modul (SDO)
+const SensorChannelInfo Bme280Driver::CHANNELS[] = {
+    { "temperature", QUANTITY_TEMPERATURE, "°C", 2, &SensorData::temperature },
+    { "humidity", QUANTITY_HUMIDITY, "%", 2, &SensorData::humidity },
+    { "pressure", QUANTITY_PRESSURE, "hPa", 2, &SensorData::pressure }
+};
+
+static const uint8_t BME280_REG_CHIP_ID = 0xD0;
+static const uint8_t BME280_CHIP_ID = 0x60;
+
+Bme280Driver::Bme280Driver() : bus(nullptr), forcedMode(false), forcedIntervalMs(0) {
+}
+
+bool Bme280Driver::probe(I2CEngine& bus, uint8_t address) {
+    uint8_t chipId = 0;
+    return bus.readRegisters(address, BME280_REG_CHIP_ID, &chipId, 1) && chipId == BME280_CHIP_ID;
+}
+
+bool Bme280Driver::begin(I2CEngine& engine, uint8_t address) {
+    bus = &engine;
+    {
+        I2CEngine::DirectAccess library(engine);
+        if (!bme.begin(address, &Wire)) {
+            return false;
+        }
+    }
+    beginDirectRead(engine, address);
+
+    I2CEngine::DirectAccess library(engine);
+    if (!forcedMode) {
+        bme.setSampling(
+            Adafruit_BME280::MODE_NORMAL,      // Kontinuierlicher Messmodus
+            Adafruit_BME280::SAMPLING_X2,      // Temperatur: 2x Oversampling
+            Adafruit_BME280::SAMPLING_X16,     // Luftdruck: 16x Oversampling (höchste Genauigkeit)
+            Adafruit_BME280::SAMPLING_X1,      // Luftfeuchtigkeit: 1x Oversampling
+            Adafruit_BME280::FILTER_X16,       // IIR-Filter (glättet Werte)
+            Adafruit_BME280::STANDBY_MS_500    // 500ms Pause zwischen Messungen
+        );
+        return true;
+    }
+
+    // Forced Mode: Oversampling nach Datenblatt Kap. 3.5 abhängig vom
+    // Messintervall; je länger das Intervall, desto weniger lohnt sich
+    // Rauschunterdrückung gegenüber der längeren Messdauer
+    if (forcedIntervalMs >= 60000) {
+        // Wetterstation: 1x/1x/1x ohne Filter, ca. 8 ms Messdauer
+        bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                        Adafruit_BME280::SAMPLING_X1,
+                        Adafruit_BME280::SAMPLING_X1,
+                        Adafruit_BME280::SAMPLING_X1,
+                        Adafruit_BME280::FILTER_OFF);
+    } else if (forcedIntervalMs >= 10000) {
+        // Mittleres Intervall: Luftdruck 4x, ca. 14 ms
+        bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                        Adafruit_BME280::SAMPLING_X1,
+                        Adafruit_BME280::SAMPLING_X4,
+                        Adafruit_BME280::SAMPLING_X1,
+                        Adafruit_BME280::FILTER_OFF);
+    } else {
+        // Kurzes Intervall: Genauigkeit wie im Normalbetrieb, ca. 40 ms
+        bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                        Adafruit_BME280::SAMPLING_X2,
+                        Adafruit_BME280::SAMPLING_X16,
+                        Adafruit_BME280::SAMPLING_X1,
+                        Adafruit_BME280::FILTER_OFF);
+    }
+    return true;
+}
+
+// Kalibrierdaten einmal lesen; ohne sie bleibt es bei der Bibliothek
+void Bme280Driver::beginDirectRead(I2CEngine& engine, uint8_t address) {
+#if BME280_DIRECT_READ
+    if (!direct.begin(engine, address)) {
+        Serial.println("  ⚠️  BME280-Kalibrierdaten nicht lesbar, Einzelabfrage über die Bibliothek");
+    }
+#else
+    (void)engine;
+    (void)address;
+#endif
+}
+
+bool Bme280Driver::takeForcedMeasurement() {
+    I2CEngine::DirectAccess library(*bus);
+    return bme.takeForcedMeasurement();
+}
+
+bool Bme280Driver::read(float* values) {
+    if (direct.isReady()) {
+        // Ein Burst-Read, Kompensation in Festkomma (siehe bme280_direct.h)
+        BME280Reading reading;
+        bool humidityValid;
+        if (!direct.read(reading, humidityValid)) {
+            return false;
+        }
+        values[0] = reading.temperature / 100.0F;                   // 0,01 °C → °C
+        values[1] = humidityValid ? reading.humidity / 1024.0F : NAN; // Q22.10 → %
+        values[2] = reading.pressure / 25600.0F;                     // Pa · 256 → hPa
+    } else {
+        I2CEngine::DirectAccess library(*bus);
+        values[0] = bme.readTemperature();    // Temperatur in °C
+        values[1] = bme.readHumidity();       // Relative Luftfeuchtigkeit in %
+        values[2] = bme.readPressure() / 100.0F; // Luftdruck in hPa (Pascal → Hektopascal)
+    }
+    return !isnan(values[0]) && !isnan(values[1]) && !isnan(values[2]);
+}
+
+// ===== MPU9250 =====
+
+const char Mpu9250Driver::NAME[] = "MPU9250";
+const uint8_t Mpu9250Driver::ADDRESSES[] = { 0x68, 0x69 };   // AD0 low / high
+const SensorChannelInfo Mpu9250Driver::CHANNELS[] = {
+    { "accelX", QUANTITY_ACCELERATION, "g", 4, &SensorData::accelX },
+    { "accelY", QUANTITY_ACCELERATION, "g", 4, &SensorData::accelY },
+    { "accelZ", QUANTITY_ACCELERATION, "g", 4, &SensorData::accelZ },
+    { "gyroX", QUANTITY_ANGULAR_RATE, "°/s", 2, &SensorData::gyroX },
+    { "gyroY", QUANTITY_ANGULAR_RATE, "°/s", 2, &SensorData::gyroY },
+    { "gyroZ", QUANTITY_ANGULAR_RATE, "°/s", 2, &SensorData::gyroZ }
+};
+
+static const uint8_t MPU9250_REG_GYRO_CONFIG = 0x1B;
+static const uint8_t MPU9250_REG_ACCEL_CONFIG = 0x1C;
+static const uint8_t MPU9250_REG_ACCEL_XOUT_H = 0x3B;   // ACCEL, TEMP, GYRO: 14 Bytes
+static const uint8_t MPU9250_REG_PWR_MGMT_1 = 0x6B;
+static const uint8_t MPU9250_REG_WHO_AM_I = 0x75;
+
+static const float MPU9250_ACCEL_LSB_PER_G = 2048.0f;     // ±16 g
+static const float MPU9250_GYRO_LSB_PER_DPS = 16.4f;      // ±2000 °/s
+
+Mpu9250Driver::Mpu9250Driver() : bus(nullptr), address(0) {
+}
+
+// MPU9250 (0x71), MPU9255 (0x73), MPU6500 ohne Magnetometer (0x70)
+bool Mpu9250Driver::probe(I2CEngine& bus, uint8_t address) {
+    uint8_t id = 0;
+    if (!bus.readRegisters(address, MPU9250_REG_WHO_AM_I, &id, 1)) {
+        return false;
+    }
+    return id == 0x71 || id == 0x73 || id == 0x70;
+}
+
+bool Mpu9250Driver::begin(I2CEngine& engine, uint8_t i2cAddress) {
+    bus = &engine;
+    address = i2cAddress;
+
+    // Aufwecken (PLL als Takt), dann Messbereiche
+    if (!bus->writeRegister(address, MPU9250_REG_PWR_MGMT_1, 0x01) ||
+        !bus->writeRegister(address, MPU9250_REG_ACCEL_CONFIG, 0x18) ||
+        !bus->writeRegister(address, MPU9250_REG_GYRO_CONFIG, 0x18)) {
+        return false;
+    }
+
+    delay(100);  // Kurze Pause für Sensor-Stabilisierung
+
+    // ===== Test-Lesung durchführen =====
+    // Prüft ob Sensor tatsächlich antwortet und gültige Daten liefert
+    float values[CHANNEL_COUNT];
+    if (!read(values)) {
+        Serial.print("(keine Daten) ");
+        return false;
+    }
+    return true;
+}
+
+bool Mpu9250Driver::read(float* values) {
+    uint8_t raw[14];
+    if (!bus->readRegisters(address, MPU9250_REG_ACCEL_XOUT_H, raw, sizeof(raw))) {
+        return false;
+    }
+
+    // Big Endian; Bytes 6/7 sind die Chiptemperatur
+    for (int i = 0; i < 3; i++) {
+        int16_t accel = (int16_t)((raw[i * 2] << 8) | raw[i * 2 + 1]);
+        int16_t gyro = (int16_t)((raw[8 + i * 2] << 8) | raw[8 + i * 2 + 1]);
+        values[i] = accel / MPU9250_ACCEL_LSB_PER_G;       // g
+        values[3 + i] = gyro / MPU9250_GYRO_LSB_PER_DPS;   // °/s
+    }
+    return true;
+}
+
+bool Mpu9250Driver::sleep(I2CEngine& bus, uint8_t address) {
+    return bus.writeRegister(address, MPU9250_REG_PWR_MGMT_1, 0x40);
+}
+
+// ===== SHT4x =====
+
+const char Sht4xDriver::NAME[] = "SHT4x";
+const uint8_t Sht4xDriver::ADDRESSES[] = { 0x44, 0x45 };   // SHT40-AD1B / -BD1B
+const SensorChannelInfo Sht4xDriver::CHANNELS[] = {
+    { "shtTemperature", QUANTITY_TEMPERATURE, "°C", 2, nullptr },
+    { "shtHumidity", QUANTITY_HUMIDITY, "%", 2, nullptr }
+};
+
+// Polynom 0x31, Startwert 0xFF (Datenblatt 4.4)
+uint8_t Sht4xDriver::crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+Sht4xDriver::Sht4xDriver() : bus(nullptr), address(0), measureStartMicros(0), measuring(false) {
+}
+
+// Seriennummer lesen: zwei Wörter mit gültiger CRC
+bool Sht4xDriver::probe(I2CEngine& engine, uint8_t i2cAddress) {
+    uint8_t serial[6];
+    if (!engine.sendCommand(i2cAddress, CMD_READ_SERIAL)) {
+        return false;
+    }
+    delay(1);
+    return engine.receive(i2cAddress, serial, sizeof(serial)) &&
+           crc8(serial, 2) == serial[2] && crc8(serial + 3, 2) == serial[5];
+}
+
+bool Sht4xDriver::begin(I2CEngine& engine, uint8_t i2cAddress) {
+    bus = &engine;
+    address = i2cAddress;
+    return startMeasurement();
+}
+
+bool Sht4xDriver::startMeasurement() {
+    measuring = bus->sendCommand(address, CMD_MEASURE_HIGH);
+    measureStartMicros = micros();
+    return measuring;
+}
+
+bool Sht4xDriver::read(float* values) {
+    if (!measuring && !startMeasurement()) {
+        return false;
+    }
+    // Nur wenn seit dem Start weniger als die Messzeit vergangen ist
+    uint32_t elapsed = micros() - measureStartMicros;
+    if (elapsed < MEASURE_MICROS) {
+        delayMicroseconds(MEASURE_MICROS - elapsed);
+    }
+
+    uint8_t frame[6];
+    bool ok = bus->receive(address, frame, sizeof(frame)) &&
+              crc8(frame, 2) == frame[2] && crc8(frame + 3, 2) == frame[5];
+    startMeasurement();
+    if (!ok) {
+        return false;
+    }
+
+    // Datenblatt 4.6: T = -45 + 175 · S/65535, RH = -6 + 125 · S/65535
+    uint16_t rawT = (uint16_t)((frame[0] << 8) | frame[1]);
+    uint16_t rawH = (uint16_t)((frame[3] << 8) | frame[4]);
+    float humidity = -6.0f + 125.0f * rawH / 65535.0f;
+    values[0] = -45.0f + 175.0f * rawT / 65535.0f;
+    values[1] = humidity < 0.0f ? 0.0f : (humidity > 100.0f ? 100.0f : humidity);
+    return true;
+}
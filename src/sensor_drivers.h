@@ -0,0 +1,116 @@
+#ifndef SENSOR_DRIVERS_H
+#define SENSOR_DRIVERS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_BME280.h>
+#include "bme280_direct.h"
+#include "sensor_registry.h"
+
+// ===== BME280 (Temperatur, Feuchte, Luftdruck) =====
+// Konfiguration über die Adafruit-Bibliothek, Messwerte per Burst-Read
+// (bme280_direct.h). Normalbetrieb misst kontinuierlich; mit
+// setForcedMode() vor begin() nur auf Anforderung (Stromsparbetrieb).
+// Die Bibliothek benutzt Wire direkt, daher jeder Aufruf unter
+// I2CEngine::DirectAccess (siehe i2c_engine.h).
+class Bme280Driver {
+public:
+    static const char NAME[];
+    static const uint8_t ADDRESSES[];
+    static const size_t ADDRESS_COUNT = 2;
+    static const uint8_t GROUP = SENSOR_GROUP_ENVIRONMENT;
+    static const uint8_t CHANNEL_COUNT = 3;
+    static const SensorChannelInfo CHANNELS[];
+
+private:
+    Adafruit_BME280 bme;
+    BME280Direct direct;
+    I2CEngine* bus;
+    bool forcedMode;
+    uint32_t forcedIntervalMs;
+
+    void beginDirectRead(I2CEngine& engine, uint8_t address);
+
+public:
+    Bme280Driver();
+
+    void setForcedMode(uint32_t intervalMs) { forcedMode = true; forcedIntervalMs = intervalMs; }
+    bool probe(I2CEngine& bus, uint8_t address);
+    bool begin(I2CEngine& bus, uint8_t address);
+    bool read(float* values);
+    // Forced Mode: eine Messung starten und abwarten
+    bool takeForcedMeasurement();
+};
+
+// ===== MPU9250 (Beschleunigung, Drehrate) =====
+// Direkt über die Register wie das FIFO-Streaming (mpu_stream.h), gleicher
+// Messbereich (±16 g, ±2000 °/s): ein Burst-Read über ACCEL, TEMP und GYRO
+// (14 Bytes) je Messung, alles über die I2C-Engine. AD0 low (0x68) oder
+// high (0x69).
+class Mpu9250Driver {
+public:
+    static const char NAME[];
+    static const uint8_t ADDRESSES[];
+    static const size_t ADDRESS_COUNT = 2;
+    static const uint8_t GROUP = SENSOR_GROUP_MOTION;
+    static const uint8_t CHANNEL_COUNT = 6;
+    static const SensorChannelInfo CHANNELS[];
+
+private:
+    I2CEngine* bus;
+    uint8_t address;
+
+public:
+    Mpu9250Driver();
+
+    bool probe(I2CEngine& bus, uint8_t address);
+    bool begin(I2CEngine& bus, uint8_t address);
+    bool read(float* values);
+    // SLEEP-Bit in PWR_MGMT_1 (ca. 8 µA statt 3,7 mA)
+    static bool sleep(I2CEngine& bus, uint8_t address);
+};
+
+// ===== SHT4x (Temperatur, Feuchte) =====
+// Befehlsbasiert: eine Messung (hohe Genauigkeit) dauert bis zu 8,3 ms.
+// read() holt das Ergebnis der Messung, die der vorige Aufruf gestartet
+// hat, und startet gleich die nächste; das Warten entfällt damit, sobald
+// der Abstand zwischen zwei Messungen größer als die Messzeit ist.
+// Beide Werte sind mit CRC-8 gesichert.
+class Sht4xDriver {
+public:
+    static const char NAME[];
+    static const uint8_t ADDRESSES[];
+    static const size_t ADDRESS_COUNT = 2;
+    static const uint8_t GROUP = SENSOR_GROUP_ENVIRONMENT;
+    static const uint8_t CHANNEL_COUNT = 2;
+    static const SensorChannelInfo CHANNELS[];
+
+    static const uint8_t CMD_MEASURE_HIGH = 0xFD;
+    static const uint8_t CMD_READ_SERIAL = 0x89;
+    static const uint32_t MEASURE_MICROS = 8300;
+
+    static uint8_t crc8(const uint8_t* data, size_t length);
+
+private:
+    I2CEngine* bus;
+    uint8_t address;
+    uint32_t measureStartMicros;
+    bool measuring;
+
+    bool startMeasurement();
+
+public:
+    Sht4xDriver();
+
+    bool probe(I2CEngine& bus, uint8_t address);
+    bool begin(I2CEngine& bus, uint8_t address);
+    bool read(float* values);
+};
+
+// ===== Eingebaute Sensoren =====
+// Neue Sensoren: Treiberklasse anlegen und hier anhängen. Kanal-IDs folgen
+// der Reihenfolge; BME280 und MPU9250 bleiben vorn, ihre Kanäle entsprechen
+// TelemetryChannel (telemetry_filter.h).
+typedef SensorRegistry<Bme280Driver, Mpu9250Driver, Sht4xDriver> SensorDriverRegistry;
+
+#endif
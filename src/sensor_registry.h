@@ -0,0 +1,290 @@
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include "i2c_engine.h"
+
+struct SensorData;
+
+// Physikalische Größe eines Kanals
+enum SensorQuantity : uint8_t {
+    QUANTITY_TEMPERATURE,     // °C
+    QUANTITY_HUMIDITY,        // %
+    QUANTITY_PRESSURE,        // hPa
+    QUANTITY_ACCELERATION,    // g
+    QUANTITY_ANGULAR_RATE,    // °/s
+    QUANTITY_CO2              // ppm
+};
+
+// Abtastgruppen (Bitmaske, gleiche Bits wie 1 << SampleGroup)
+static const uint8_t SENSOR_GROUP_ENVIRONMENT = 0x01;
+static const uint8_t SENSOR_GROUP_MOTION = 0x02;
+
+// ===== Ein Messwert mit Kennung (12 Bytes) =====
+struct SensorRecord {
+    uint8_t channel;          // Kanal-ID der Registry
+    SensorQuantity type;
+    float value;              // NaN = Lesefehler
+    uint32_t timestamp;       // millis() beim Auslesen
+};
+
+// ===== Beschreibung eines Kanals =====
+// Vom Treiber als statische Tabelle; der Name ist der JSON-Schlüssel
+// (höchstens SENSOR_NAME_MAX Zeichen). Die Kanäle von BME280 und MPU9250
+// haben ein festes Feld in SensorData, alle übrigen nullptr.
+struct SensorChannelInfo {
+    static const size_t SENSOR_NAME_MAX = 32;
+
+    const char* name;
+    SensorQuantity type;
+    const char* unit;
+    uint8_t decimals;          // Nachkommastellen in JSON
+    float SensorData::* field;
+};
+
+// ===== Gefundene I2C-Adressen (Ergebnis des Scans) =====
+struct I2CAddressSet {
+    uint32_t bits[4];
+
+    void clear() { memset(bits, 0, sizeof(bits)); }
+    void add(uint8_t address) { bits[(address >> 5) & 3] |= 1UL << (address & 31); }
+    bool contains(uint8_t address) const { return (bits[(address >> 5) & 3] >> (address & 31)) & 1; }
+};
+
+// ===== Zustand eines Treibers in der Registry =====
+template <typename Driver>
+struct SensorDriverSlot {
+    Driver driver;
+    uint8_t address;           // 0 = nicht gefunden
+    bool lastReadOk;
+    uint32_t readMicros;       // Dauer des letzten Auslesens
+
+    SensorDriverSlot() : address(0), lastReadOk(false), readMicros(0) {}
+};
+
+// Kanal-ID des ersten Kanals von Target = Summe der Kanäle davor
+template <typename Target, typename... List>
+struct SensorChannelOffset;
+
+template <typename Target, typename... Rest>
+struct SensorChannelOffset<Target, Target, Rest...> {
+    static const uint8_t value = 0;
+};
+
+template <typename Target, typename First, typename... Rest>
+struct SensorChannelOffset<Target, First, Rest...> {
+    static const uint8_t value = First::CHANNEL_COUNT + SensorChannelOffset<Target, Rest...>::value;
+};
+
+template <typename... List>
+struct SensorChannelTotal {
+    static const uint8_t value = 0;
+};
+
+template <typename First, typename... Rest>
+struct SensorChannelTotal<First, Rest...> {
+    static const uint8_t value = First::CHANNEL_COUNT + SensorChannelTotal<Rest...>::value;
+};
+
+// ===== Registry der Sensortreiber =====
+// Die Treiber sind eine feste Typliste (sensor_drivers.h), kein Array von
+// Basisklassen-Zeigern: read() ruft jeden Treiber direkt auf, der Compiler
+// kann inlinen, es gibt keine vtable. Ein Treiber ist eine Klasse mit
+//
+//   static const char NAME[];                 // Für die Ausgabe
+//   static const uint8_t ADDRESSES[];         // Mögliche I2C-Adressen
+//   static const size_t ADDRESS_COUNT;
+//   static const uint8_t GROUP;               // SENSOR_GROUP_*
+//   static const uint8_t CHANNEL_COUNT;
+//   static const SensorChannelInfo CHANNELS[];
+//   bool probe(I2CEngine& bus, uint8_t address);  // Chip-ID, ohne Seiteneffekt
+//   bool begin(I2CEngine& bus, uint8_t address);  // Konfigurieren
+//   bool read(float* values);                     // CHANNEL_COUNT Werte
+//
+// Kanal-IDs ergeben sich aus der Reihenfolge der Liste und stehen damit
+// für eine Firmware fest, auch wenn ein Sensor fehlt. discover() prüft nur
+// Adressen, die der Scan gefunden hat; eine Adresse gehört dem ersten
+// Treiber, dessen probe() passt.
+template <typename... Drivers>
+class SensorRegistry : private SensorDriverSlot<Drivers>... {
+public:
+    static const uint8_t CHANNEL_COUNT = SensorChannelTotal<Drivers...>::value;
+    static const size_t DRIVER_COUNT = sizeof...(Drivers);
+
+    template <typename Driver>
+    static uint8_t firstChannel() { return SensorChannelOffset<Driver, Drivers...>::value; }
+
+    // Kanal nach ID (0 .. CHANNEL_COUNT-1)
+    static const SensorChannelInfo& channel(uint8_t id) { return *channelTable().entries[id]; }
+
+    // Name des Treibers für eine Adresse (nur für die Scan-Ausgabe), sonst nullptr
+    static const char* driverName(uint8_t address) {
+        const char* name = nullptr;
+        int expand[] = { 0, (matchAddress<Drivers>(address, name), 0)... };
+        (void)expand;
+        return name;
+    }
+
+    template <typename Driver>
+    Driver& get() { return static_cast<SensorDriverSlot<Driver>&>(*this).driver; }
+
+    template <typename Driver>
+    bool isPresent() const { return static_cast<const SensorDriverSlot<Driver>&>(*this).address != 0; }
+
+    // Gruppen mit mindestens einem gefundenen Treiber (SENSOR_GROUP_*)
+    uint8_t presentGroups() const {
+        uint8_t groups = 0;
+        int expand[] = { 0, (groups |= isPresent<Drivers>() ? Drivers::GROUP : 0, 0)... };
+        (void)expand;
+        return groups;
+    }
+
+    template <typename Driver>
+    uint8_t getAddress() const { return static_cast<const SensorDriverSlot<Driver>&>(*this).address; }
+
+    template <typename Driver>
+    bool lastReadOk() const { return static_cast<const SensorDriverSlot<Driver>&>(*this).lastReadOk; }
+
+    template <typename Driver>
+    uint32_t getReadMicros() const { return static_cast<const SensorDriverSlot<Driver>&>(*this).readMicros; }
+
+    // Alle Treiber anhand der Scan-Ergebnisse starten; Anzahl gefundener Treiber
+    size_t discover(I2CEngine& bus, const I2CAddressSet& found) {
+        I2CAddressSet claimed;
+        claimed.clear();
+        size_t count = 0;
+        int expand[] = { 0, (count += beginDriver<Drivers>(bus, &found, claimed) ? 1 : 0, 0)... };
+        (void)expand;
+        return count;
+    }
+
+    // Einen Treiber ohne Scan starten (Aufwachen aus dem Deep Sleep):
+    // begin() auf allen Adressen des Treibers, probe() entfällt
+    template <typename Driver>
+    bool beginWithoutScan(I2CEngine& bus) {
+        I2CAddressSet claimed;
+        claimed.clear();
+        return beginDriver<Driver>(bus, nullptr, claimed);
+    }
+
+    // ===== Heißer Pfad =====
+    // Liest alle gefundenen Treiber der Gruppen und übergibt je Kanal einen
+    // Eintrag an sink (Funktor mit operator()(const SensorRecord&)), bei
+    // Lesefehler mit NaN. Rückgabe: Anzahl Treiber mit gültigen Werten.
+    template <typename Sink>
+    size_t read(uint8_t groups, Sink sink) {
+        size_t okCount = 0;
+        int expand[] = { 0, (okCount += readDriver<Drivers>(groups, sink) ? 1 : 0, 0)... };
+        (void)expand;
+        return okCount;
+    }
+
+    // Nur einen Treiber lesen (Forced Mode, Tests)
+    template <typename Driver, typename Sink>
+    bool readOne(Sink sink) {
+        return readDriver<Driver>(Driver::GROUP, sink);
+    }
+
+    // Gefundene Treiber mit Adresse ausgeben
+    void printDrivers() const {
+        int expand[] = { 0, (printDriver<Drivers>(), 0)... };
+        (void)expand;
+    }
+
+private:
+    template <typename Driver>
+    void printDriver() const {
+        if (isPresent<Driver>()) {
+            Serial.printf("   - %s: ✅ (0x%02X)\n", Driver::NAME, getAddress<Driver>());
+        }
+    }
+
+    struct ChannelTable {
+        const SensorChannelInfo* entries[CHANNEL_COUNT > 0 ? CHANNEL_COUNT : 1];
+    };
+
+    static const ChannelTable& channelTable() {
+        static const ChannelTable table = buildChannelTable();
+        return table;
+    }
+
+    static ChannelTable buildChannelTable() {
+        ChannelTable table;
+        size_t next = 0;
+        int expand[] = { 0, (appendChannels<Drivers>(table, next), 0)... };
+        (void)expand;
+        return table;
+    }
+
+    template <typename Driver>
+    static void appendChannels(ChannelTable& table, size_t& next) {
+        static_assert(!std::is_polymorphic<Driver>::value, "Sensortreiber ohne virtuelle Methoden");
+        for (size_t i = 0; i < Driver::CHANNEL_COUNT; i++) {
+            table.entries[next++] = &Driver::CHANNELS[i];
+        }
+    }
+
+    template <typename Driver>
+    static void matchAddress(uint8_t address, const char*& name) {
+        for (size_t i = 0; name == nullptr && i < Driver::ADDRESS_COUNT; i++) {
+            if (Driver::ADDRESSES[i] == address) {
+                name = Driver::NAME;
+            }
+        }
+    }
+
+    template <typename Driver>
+    bool beginDriver(I2CEngine& bus, const I2CAddressSet* found, I2CAddressSet& claimed) {
+        SensorDriverSlot<Driver>& slot = *this;
+        slot.address = 0;
+        for (size_t i = 0; i < Driver::ADDRESS_COUNT; i++) {
+            uint8_t address = Driver::ADDRESSES[i];
+            if (found && (!found->contains(address) || claimed.contains(address) ||
+                          !slot.driver.probe(bus, address))) {
+                continue;
+            }
+            if (found) {
+                Serial.printf("%s initialisieren... ", Driver::NAME);
+            }
+            if (slot.driver.begin(bus, address)) {
+                if (found) {
+                    Serial.printf("OK (Adresse 0x%02X)\n", address);
+                }
+                slot.address = address;
+                claimed.add(address);
+                return true;
+            }
+            if (found) {
+                Serial.println("FEHLER!");
+            }
+        }
+        return false;
+    }
+
+    template <typename Driver, typename Sink>
+    bool readDriver(uint8_t groups, Sink& sink) {
+        SensorDriverSlot<Driver>& slot = *this;
+        if ((groups & Driver::GROUP) == 0 || slot.address == 0) {
+            return false;
+        }
+
+        float values[Driver::CHANNEL_COUNT];
+        uint32_t start = micros();
+        slot.lastReadOk = slot.driver.read(values);
+        uint32_t end = micros();
+        slot.readMicros = end - start;
+
+        SensorRecord record;
+        record.timestamp = millis();
+        for (size_t i = 0; i < Driver::CHANNEL_COUNT; i++) {
+            record.channel = firstChannel<Driver>() + i;
+            record.type = Driver::CHANNELS[i].type;
+            record.value = slot.lastReadOk ? values[i] : NAN;
+            sink(record);
+        }
+        return slot.lastReadOk;
+    }
+};
+
+#endif
@@ -1,270 +1,244 @@
 #include "sensors.h"
+#include "config.h"
+#include "time_service.h"
+
+// ===== Zusatzkanäle =====
+const SensorRecord* SensorData::findExtra(uint8_t channel) const {
+    for (uint8_t i = 0; i < extraCount; i++) {
+        if (extra[i].channel == channel) {
+            return &extra[i];
+        }
+    }
+    return nullptr;
+}
+
+void SensorData::storeExtra(const SensorRecord& record) {
+    for (uint8_t i = 0; i < extraCount; i++) {
+        if (extra[i].channel == record.channel) {
+            extra[i] = record;
+            return;
+        }
+    }
+    if (extraCount < SENSOR_EXTRA_RECORDS) {
+        extra[extraCount++] = record;
+    }
+}
 
 // ===== Konstruktor =====
-// Initialisiert Flags für Sensor-Status mit false (Sensoren noch nicht bereit)
-Sensors::Sensors() : bme280Initialized(false), mpu9250Initialized(false) {
+// Noch kein Treiber gefunden, Scan noch nicht gelaufen
+Sensors::Sensors() : clock(nullptr), scanDevices(0), scanComplete(false) {
+    scanFound.clear();
 }
 
 // ===== Hauptinitialisierung aller Sensoren =====
-// Startet I2C-Bus, scannt nach Geräten und initialisiert BME280 und MPU9250
+// Startet I2C-Bus, scannt nach Geräten und startet für jede gefundene
+// Adresse den passenden Treiber (Liste in sensor_drivers.h)
 bool Sensors::begin() {
     Serial.println("\n=== Sensor Initialisierung ===");
     
     // ===== I2C Bus initialisieren =====
     // SDA = GPIO21, SCL = GPIO22 (Standard ESP32 Pins)
-    Wire.begin(I2C_SDA, I2C_SCL);
-    
     // I2C Taktfrequenz auf 400 kHz setzen (Fast Mode)
     // Standard wäre 100 kHz, 400 kHz ist schneller und wird von beiden Sensoren unterstützt
-    Wire.setClock(400000);
+    // Die Engine kennt die Pins für eine Bus-Recovery
+    i2cBus.begin(I2C_SDA, I2C_SCL, 400000);
     delay(100);  // Kurze Pause damit I2C-Bus stabil ist
     
     // ===== I2C Bus nach angeschlossenen Geräten durchsuchen =====
+    // Läuft über die I2C-Engine; die Treibersuche braucht das Ergebnis
     scanI2C();
+    waitForScan();
     
-    // ========== BME280 Umweltsensor initialisieren ==========
-    Serial.print("BME280 initialisieren... ");
-    
-    // BME280 kann auf Adresse 0x76 oder 0x77 sein (je nach Modul)
-    // Versuche beide Adressen
-    if (bme.begin(0x76, &Wire)) {
-        Serial.println("OK (Adresse 0x76)");
-        bme280Initialized = true;
-    } else if (bme.begin(0x77, &Wire)) {
-        Serial.println("OK (Adresse 0x77)");
-        bme280Initialized = true;
-    } else {
-        // Sensor nicht gefunden auf beiden Adressen
-        Serial.println("FEHLER!");
-        bme280Initialized = false;
-    }
-    
-    // BME280 konfigurieren falls erfolgreich initialisiert
-    if (bme280Initialized) {
-        bme.setSampling(
-            Adafruit_BME280::MODE_NORMAL,      // Kontinuierlicher Messmodus
-            Adafruit_BME280::SAMPLING_X2,      // Temperatur: 2x Oversampling
-            Adafruit_BME280::SAMPLING_X16,     // Luftdruck: 16x Oversampling (höchste Genauigkeit)
-            Adafruit_BME280::SAMPLING_X1,      // Luftfeuchtigkeit: 1x Oversampling
-            Adafruit_BME280::FILTER_X16,       // IIR-Filter (glättet Werte)
-            Adafruit_BME280::STANDBY_MS_500    // 500ms Pause zwischen Messungen
-        );
-        Serial.println("  -> BME280 konfiguriert");
-    }
-    
-    // ========== MPU9250 Bewegungssensor initialisieren ==========
-    Serial.print("MPU9250 initialisieren... ");
-    
-    // Wire-Objekt explizit setzen (wichtig für Bibliothek)
-    mpu.setWire(&Wire);
-    
-    // WICHTIG: Diese Reihenfolge ist kritisch!
-    // Erst Accelerometer, dann Gyroskop initialisieren
-    mpu.beginAccel();  // 3-Achsen Beschleunigungssensor
-    mpu.beginGyro();   // 3-Achsen Gyroskop (Rotationssensor)
-    
-    delay(100);  // Kurze Pause für Sensor-Stabilisierung
-    
-    // ===== Test-Lesung durchführen =====
-    // Prüft ob Sensor tatsächlich antwortet und gültige Daten liefert
-    mpu.accelUpdate();              // Beschleunigungsdaten aktualisieren
-    float testValue = mpu.accelX(); // X-Achse auslesen
-    
-    // Prüfen ob Sensor gültige Werte liefert (nicht NaN = Not a Number)
-    if (!isnan(testValue)) {
-        Serial.println("OK");
-        mpu9250Initialized = true;
-        Serial.println("  -> MPU9250 konfiguriert");
-        
-        // Optional: Magnetometer initialisieren (9-Achsen IMU)
-        // Wird in diesem Projekt nicht verwendet, aber verfügbar
-        mpu.beginMag();
-        
-    } else {
-        // Sensor antwortet nicht korrekt
-        Serial.println("FEHLER!");
-        Serial.println("  -> MPU9250 antwortet nicht (NaN)");
-        mpu9250Initialized = false;
-    }
+    // ===== Treiber starten =====
+    // Nur Adressen aus dem Scan; probe() prüft die Chip-ID, bevor begin()
+    // den Sensor konfiguriert
+    size_t found = registry.discover(i2cBus, scanFound);
     
     Serial.println("==============================\n");
     
-    // Initialisierung gilt als erfolgreich wenn mindestens ein Sensor funktioniert
-    bool success = (bme280Initialized || mpu9250Initialized);
-    
     // ===== Status-Zusammenfassung ausgeben =====
-    if (success) {
+    // Initialisierung gilt als erfolgreich wenn mindestens ein Sensor funktioniert
+    if (found > 0) {
         Serial.println("✅ Sensoren bereit:");
-        if (bme280Initialized) Serial.println("   - BME280: ✅");
-        if (mpu9250Initialized) Serial.println("   - MPU9250: ✅");
+        registry.printDrivers();
     } else {
         Serial.println("❌ FEHLER: Keine Sensoren verfügbar!");
     }
     
-    return success;
+    return found > 0;
+}
+
+// ===== Initialisierung für den Stromsparbetrieb =====
+// Läuft nach jedem Aufwachen aus dem Deep Sleep, daher ohne I2C-Scan und
+// ohne Wartezeiten. Der BME280 misst nur auf Anforderung (Forced Mode) und
+// schläft sonst (0,1 µA); Oversampling abhängig vom Messintervall (siehe
+// Bme280Driver::begin).
+bool Sensors::beginLowPower(uint32_t intervalMs) {
+    i2cBus.begin(I2C_SDA, I2C_SCL, 400000);
+
+    registry.get<Bme280Driver>().setForcedMode(intervalMs);
+    bool bmeReady = registry.beginWithoutScan<Bme280Driver>(i2cBus);
+
+    // MPU9250 wird nicht gebraucht; ohne Scan ist die Adresse unbekannt,
+    // daher an beide (die freie antwortet mit NACK)
+    for (size_t i = 0; i < Mpu9250Driver::ADDRESS_COUNT; i++) {
+        Mpu9250Driver::sleep(i2cBus, Mpu9250Driver::ADDRESSES[i]);
+    }
+
+    if (!bmeReady) {
+        Serial.println("❌ BME280 nicht gefunden!");
+    }
+    return bmeReady;
+}
+
+// ===== Einzelmessung im Forced Mode =====
+// Startet eine Messung, wartet bis sie fertig ist und liest das Ergebnis;
+// danach kehrt der BME280 selbstständig in den Schlafmodus zurück
+bool Sensors::readForced(SensorData &data) {
+    data.timestamp = millis();
+    data.epochMicros = clock ? clock->nowEpochMicros() : 0;
+    data.accelX = data.accelY = data.accelZ = NAN;
+    data.gyroX = data.gyroY = data.gyroZ = NAN;
+    data.mpu9250Valid = false;
+    data.bme280Fresh = true;
+    data.mpu9250Fresh = false;
+    data.mpuReadMicros = 0;
+    data.scheduledMillis = data.timestamp;
+    data.extraCount = 0;
+
+    unsigned long start = micros();
+    if (!isBME280Ready() || !registry.get<Bme280Driver>().takeForcedMeasurement()) {
+        data.bme280Valid = false;
+        data.bmeReadMicros = micros() - start;
+        return false;
+    }
+    bool ok = readBME280(data);
+    data.bmeReadMicros = micros() - start;
+    return ok;
 }
 
 // ===== I2C Bus Scanner =====
 // Durchsucht alle möglichen I2C-Adressen (1-126) nach angeschlossenen Geräten
 // Nützlich für Debugging und Fehlersuche bei Verkabelungsproblemen
+// Die Adresstests laufen als Kette über die I2C-Engine: jeder Rückruf legt
+// den nächsten ab, es belegt also nur einer die Warteschlange. Die Ausgabe
+// kommt aus dem I2C-Task.
 void Sensors::scanI2C() {
     Serial.println("\n--- I2C Bus Scan ---");
-    byte error, address;
-    int devices = 0;  // Zähler für gefundene Geräte
-    
-    // Alle gültigen I2C-Adressen durchgehen (0x01 bis 0x7F)
-    for(address = 1; address < 127; address++) {
-        // Verbindungsversuch zur Adresse
-        Wire.beginTransmission(address);
-        error = Wire.endTransmission();
+    scanFound.clear();
+    scanDevices = 0;
+    scanComplete = false;
+    if (!i2cBus.submit(I2CTransaction::probe(1, onScanProbe, this))) {
+        Serial.println("  ⚠️  I2C-Warteschlange voll, kein Scan");
+        scanComplete = true;
+    }
+}
+
+// Mit I2C-Task schläft der Aufrufer, ohne Task arbeitet er die Kette selbst ab
+void Sensors::waitForScan() {
+    while (!scanComplete) {
+        if (i2cBus.isTaskRunning()) {
+            delay(1);
+        } else if (i2cBus.process() == 0) {
+            break;
+        }
+    }
+}
+
+void Sensors::onScanProbe(const I2CTransaction& probe, void* context) {
+    Sensors* self = (Sensors*)context;
+    uint8_t address = probe.address;
+    
+    // I2C_OK bedeutet: Gerät hat geantwortet
+    if (probe.status == I2C_OK) {
+        Serial.print("  Gerät gefunden bei 0x");
+        if (address < 16) Serial.print("0");  // Führende Null für Formatierung
+        Serial.print(address, HEX);
         
-        // error == 0 bedeutet: Gerät hat geantwortet
-        if (error == 0) {
-            Serial.print("  Gerät gefunden bei 0x");
-            if (address < 16) Serial.print("0");  // Führende Null für Formatierung
-            Serial.print(address, HEX);
-            
-            // Bekannte Sensor-Adressen identifizieren
-            if (address == 0x76 || address == 0x77) {
-                Serial.print(" (BME280)");  // Umweltsensor
-            } else if (address == 0x68 || address == 0x69) {
-                Serial.print(" (MPU9250)");  // Bewegungssensor
-            }
-            Serial.println();
-            devices++;
+        // Bekannte Sensor-Adressen identifizieren (Treiber mit dieser Adresse)
+        const char* driver = SensorDriverRegistry::driverName(address);
+        if (driver) {
+            Serial.printf(" (%s)", driver);
         }
+        Serial.println();
+        self->scanFound.add(address);
+        self->scanDevices++;
+    }
+    
+    // Nächste Adresse (0x01 bis 0x7E)
+    if (address < 126 && i2cBus.submit(I2CTransaction::probe(address + 1, onScanProbe, self))) {
+        return;
     }
     
     // Zusammenfassung
-    if (devices == 0) {
+    if (self->scanDevices == 0) {
         Serial.println("  ⚠️  KEINE I2C Geräte gefunden!");
         Serial.println("     -> Verkabelung prüfen!");
     } else {
-        Serial.printf("  ✅ Insgesamt %d Gerät(e) gefunden\n", devices);
+        Serial.printf("  ✅ Insgesamt %d Gerät(e) gefunden\n", self->scanDevices);
     }
     Serial.println("--------------------\n");
+    self->scanComplete = true;
+}
+
+// ===== Messwerte übernehmen =====
+// Kanäle von BME280 und MPU9250 haben ein festes Feld, alle übrigen gehen
+// in die Zusatzkanäle
+void Sensors::RecordStore::operator()(const SensorRecord& record) const {
+    const SensorChannelInfo& info = SensorDriverRegistry::channel(record.channel);
+    if (info.field) {
+        data->*info.field = record.value;
+    } else {
+        data->storeExtra(record);
+    }
 }
 
 // ===== BME280 Umweltsensor auslesen =====
 // Liest Temperatur, Luftfeuchtigkeit und Luftdruck
 bool Sensors::readBME280(SensorData &data) {
-    // Prüfen ob Sensor initialisiert wurde
-    if (!bme280Initialized) {
-        data.bme280Valid = false;
-        return false;
-    }
-    
-    // Sensorwerte auslesen
-    data.temperature = bme.readTemperature();    // Temperatur in °C
-    data.humidity = bme.readHumidity();          // Relative Luftfeuchtigkeit in %
-    data.pressure = bme.readPressure() / 100.0F; // Luftdruck in hPa (Pascal → Hektopascal)
-    
-    // Validierung: Prüfen ob alle Werte gültig sind (nicht NaN)
-    if (isnan(data.temperature) || isnan(data.humidity) || isnan(data.pressure)) {
-        data.bme280Valid = false;
-        return false;
-    }
-    
-    // Daten sind gültig
-    data.bme280Valid = true;
-    return true;
+    data.bme280Valid = registry.readOne<Bme280Driver>(RecordStore(data));
+    return data.bme280Valid;
 }
 
 // ===== MPU9250 Bewegungssensor auslesen =====
 // Liest Beschleunigung (3 Achsen) und Rotation (3 Achsen)
 bool Sensors::readMPU9250(SensorData &data) {
-    // Prüfen ob Sensor initialisiert wurde
-    if (!mpu9250Initialized) {
-        data.mpu9250Valid = false;
-        return false;
-    }
-    
-    // ===== Beschleunigungssensor auslesen =====
-    // Misst lineare Beschleunigung in g (Erdbeschleunigung)
-    mpu.accelUpdate();           // Neue Messwerte vom Sensor holen
-    data.accelX = mpu.accelX();  // X-Achse (vorwärts/rückwärts)
-    data.accelY = mpu.accelY();  // Y-Achse (links/rechts)
-    data.accelZ = mpu.accelZ();  // Z-Achse (oben/unten) - sollte ~1g sein im Ruhezustand
-    
-    // ===== Gyroskop auslesen =====
-    // Misst Rotationsgeschwindigkeit in °/s (Grad pro Sekunde)
-    mpu.gyroUpdate();           // Neue Messwerte vom Sensor holen
-    data.gyroX = mpu.gyroX();   // Rotation um X-Achse (Nicken/Pitch)
-    data.gyroY = mpu.gyroY();   // Rotation um Y-Achse (Rollen/Roll)
-    data.gyroZ = mpu.gyroZ();   // Rotation um Z-Achse (Gieren/Yaw)
-    
-    // Validierung: Mindestens ein Wert pro Sensor-Typ muss gültig sein
-    if (isnan(data.accelX) || isnan(data.gyroX)) {
-        data.mpu9250Valid = false;
-        return false;
-    }
-    
-    // Daten sind gültig
-    data.mpu9250Valid = true;
-    return true;
+    data.mpu9250Valid = registry.readOne<Mpu9250Driver>(RecordStore(data));
+    return data.mpu9250Valid;
 }
 
 // ===== Alle Sensoren auf einmal auslesen =====
-// Zentrale Funktion die beide Sensoren ausliest und Zeitstempel hinzufügt
 bool Sensors::readAll(SensorData &data) {
-    // Zeitstempel setzen (Millisekunden seit Programmstart)
-    data.timestamp = millis();
-    
-    // Beide Sensoren auslesen
-    bool bmeOk = readBME280(data);    // Umweltsensor
-    bool mpuOk = readMPU9250(data);   // Bewegungssensor
-    
-    // Erfolgreich wenn mindestens ein Sensor funktioniert hat
-    return (bmeOk || mpuOk);
+    return readSelected(data, true, true);
 }
 
-// ===== Formatierte Konsolenausgabe der Sensordaten =====
-// Gibt alle Sensordaten in einem schön formatierten Rahmen aus
-void Sensors::printSensorData(const SensorData &data) {
-    // ===== Header mit Zeitstempel =====
-    Serial.println("╔════════════════════════════════════════════════════════╗");
-    Serial.printf ("║ Timestamp: %10lu ms                              ║\n", data.timestamp);
-    Serial.println("╠════════════════════════════════════════════════════════╣");
-    
-    // ===== BME280 Daten =====
-    if (data.bme280Valid) {
-        // Sensor hat gültige Daten geliefert
-        Serial.println("║ BME280 - Umwelt-Sensor                                 ║");
-        Serial.println("╟────────────────────────────────────────────────────────╢");
-        Serial.printf ("║   🌡️  Temperatur:   %6.2f °C                        ║\n", data.temperature);
-        Serial.printf ("║   💧 Luftfeuchte:  %6.2f %%                         ║\n", data.humidity);
-        Serial.printf ("║   📊 Luftdruck:    %7.2f hPa                        ║\n", data.pressure);
-    } else {
-        // Sensor nicht verfügbar oder Lesefehler
-        Serial.println("║ BME280 - ❌ NICHT VERFÜGBAR                            ║");
+// ===== Ausgewählte Sensoren auslesen =====
+// Zentrale Funktion die die Sensoren ausliest und Zeitstempel hinzufügt;
+// die adaptive Abtastung liest Umwelt- und Bewegungssensoren in eigenem Takt
+bool Sensors::readSelected(SensorData &data, bool bme280, bool mpu9250) {
+    // Zeitstempel setzen (Millisekunden seit Programmstart, dazu UTC in µs)
+    data.timestamp = millis();
+    data.scheduledMillis = data.timestamp;
+    data.epochMicros = clock ? clock->nowEpochMicros() : 0;
+    data.bme280Fresh = bme280;
+    data.mpu9250Fresh = mpu9250;
+    
+    // Alle Treiber der Gruppen in einem Durchlauf (ohne virtuelle Aufrufe)
+    uint8_t groups = (bme280 ? SENSOR_GROUP_ENVIRONMENT : 0) | (mpu9250 ? SENSOR_GROUP_MOTION : 0);
+    size_t driversOk = registry.read(groups, RecordStore(data));
+    
+    // Status und Dauer je Sensor für die Kennzahlen
+    bool bmeRead = bme280 && isBME280Ready();
+    bool mpuRead = mpu9250 && isMPU9250Ready();
+    if (bme280) {
+        data.bme280Valid = bmeRead && registry.lastReadOk<Bme280Driver>();
     }
-    
-    Serial.println("╠════════════════════════════════════════════════════════╣");
-    
-    // ===== MPU9250 Daten =====
-    if (data.mpu9250Valid) {
-        // Sensor hat gültige Daten geliefert
-        Serial.println("║ MPU9250 - Bewegungs-Sensor                             ║");
-        Serial.println("╟────────────────────────────────────────────────────────╢");
-        
-        // Beschleunigungsdaten (in g)
-        // Bei horizontaler Ausrichtung: Z sollte ~1g sein (Erdanziehung)
-        Serial.println("║ Beschleunigung (g):                                    ║");
-        Serial.printf ("║   X: %+7.3f  |  Y: %+7.3f  |  Z: %+7.3f     ║\n", 
-                       data.accelX, data.accelY, data.accelZ);
-        Serial.println("╟────────────────────────────────────────────────────────╢");
-        
-        // Gyroskop-Daten (in °/s)
-        // Im Ruhezustand sollten alle Werte nahe 0 sein
-        Serial.println("║ Gyroskop (°/s):                                        ║");
-        Serial.printf ("║   X: %+8.2f | Y: %+8.2f | Z: %+8.2f    ║\n", 
-                       data.gyroX, data.gyroY, data.gyroZ);
-    } else {
-        // Sensor nicht verfügbar oder Lesefehler
-        Serial.println("║ MPU9250 - ❌ NICHT VERFÜGBAR                           ║");
+    if (mpu9250) {
+        data.mpu9250Valid = mpuRead && registry.lastReadOk<Mpu9250Driver>();
     }
+    data.bmeReadMicros = bmeRead ? registry.getReadMicros<Bme280Driver>() : 0;
+    data.mpuReadMicros = mpuRead ? registry.getReadMicros<Mpu9250Driver>() : 0;
     
-    // ===== Footer =====
-    Serial.println("╚════════════════════════════════════════════════════════╝");
-    Serial.println();
-}
\ No newline at end of file
+    // Erfolgreich wenn mindestens ein Sensor funktioniert hat
+    return driversOk > 0;
+}
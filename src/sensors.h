@@ -3,16 +3,17 @@
 
 #include <Arduino.h>
 #include <Wire.h>
-#include <Adafruit_BME280.h>
-#include <MPU9250_asukiaaa.h>  // KORRIGIERT: asukiaaa statt Bolder Flight
+#include "config.h"
+#include "sensor_drivers.h"
 
 // I2C Pins für ESP32
 #define I2C_SDA 21
 #define I2C_SCL 22
 
-// Sensor Adressen (umbenannt um Konflikt mit Bibliothek zu vermeiden)
+// Sensor Adresse (umbenannt um Konflikt mit Bibliothek zu vermeiden)
 #define BME280_I2C_ADDR 0x76  // oder 0x77
-#define MPU9250_I2C_ADDR 0x68
+
+class TimeService;
 
 // Sensor Daten Struktur
 struct SensorData {
@@ -32,30 +33,69 @@ struct SensorData {
     // Status
     bool bme280Valid;
     bool mpu9250Valid;
+    bool bme280Fresh;         // In diesem Durchlauf gelesen (sonst letzter Wert)
+    bool mpu9250Fresh;
     unsigned long timestamp;  // millis()
+    uint64_t epochMicros;     // UTC beim Auslesen [µs], 0 = Uhr noch nicht gestellt
+    
+    // Dauer des Auslesens je Sensor [µs] (Laufzeit-Kennzahlen, nicht gesendet)
+    uint32_t bmeReadMicros;
+    uint32_t mpuReadMicros;
+    unsigned long scheduledMillis;  // Geplanter Messzeitpunkt (Jitter)
+    
+    // Kanäle ohne festes Feld (weitere Sensoren aus sensor_drivers.h),
+    // je Kanal der letzte Wert
+    SensorRecord extra[SENSOR_EXTRA_RECORDS];
+    uint8_t extraCount = 0;
+    
+    // Letzter Wert des Kanals, nullptr wenn er (noch) keinen hat
+    const SensorRecord* findExtra(uint8_t channel) const;
+    // Wert übernehmen; ist kein Platz mehr frei, entfällt der Kanal
+    void storeExtra(const SensorRecord& record);
 };
 
 class Sensors {
 private:
-    Adafruit_BME280 bme;
-    MPU9250_asukiaaa mpu;  // asukiaaa Bibliothek
+    SensorDriverRegistry registry;
     
-    bool bme280Initialized;
-    bool mpu9250Initialized;
+    const TimeService* clock;   // Für epochMicros (optional)
+    I2CAddressSet scanFound;        // Vom I2C-Task geschrieben
+    volatile uint8_t scanDevices;
+    volatile bool scanComplete;
     
     void scanI2C();
+    void waitForScan();
+    static void onScanProbe(const I2CTransaction& probe, void* context);
+    // Messwerte in die Felder bzw. Zusatzkanäle übernehmen
+    struct RecordStore {
+        SensorData* data;
+        explicit RecordStore(SensorData& target) : data(&target) {}
+        void operator()(const SensorRecord& record) const;
+    };
     
 public:
     Sensors();
     
+    // Scan, danach Treiber für die gefundenen Adressen starten
     bool begin();
+    // Zeitstempel der Messwerte; Lesen ist aus dem Sensor-Task erlaubt
+    void setClock(const TimeService* timeService) { clock = timeService; }
+    // Stromsparbetrieb: BME280 im Forced Mode, MPU9250 im Schlafmodus
+    bool beginLowPower(uint32_t intervalMs);
+    bool readForced(SensorData &data);
     bool readBME280(SensorData &data);
     bool readMPU9250(SensorData &data);
     bool readAll(SensorData &data);
+    // Nur die angegebenen Gruppen (BME280 und weitere Umweltsensoren bzw.
+    // MPU9250); die übrigen Felder behalten ihren Wert
+    bool readSelected(SensorData &data, bool bme280, bool mpu9250);
     
-    void printSensorData(const SensorData &data);
-    bool isBME280Ready() { return bme280Initialized; }
-    bool isMPU9250Ready() { return mpu9250Initialized; }
+    bool isBME280Ready() const { return registry.isPresent<Bme280Driver>(); }
+    bool isMPU9250Ready() const { return registry.isPresent<Mpu9250Driver>(); }
+    const SensorDriverRegistry& getRegistry() const { return registry; }
+    // Ergebnis des I2C-Scans aus begin()
+    bool isScanComplete() const { return scanComplete; }
+    uint8_t getScanDeviceCount() const { return scanDevices; }
 };
 
 #endif
\ No newline at end of file
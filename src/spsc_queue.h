@@ -0,0 +1,59 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ===== Lock-freie Warteschlange (ein Produzent, ein Konsument) =====
+// Verbindet den Sensor-Task (push) mit dem Netzwerk-Task (pop), ohne
+// Mutex und ohne dass der Sensor-Task jemals blockiert. Jeder Index wird
+// nur von genau einer Seite geschrieben; acquire/release sorgt dafür,
+// dass der Konsument den Eintrag erst sieht, wenn er vollständig ist.
+//
+// CAPACITY muss eine Zweierpotenz sein. Ist die Warteschlange voll,
+// verwirft push() den neuen Eintrag und zählt ihn.
+template <typename T, size_t CAPACITY>
+class SpscQueue {
+private:
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "CAPACITY muss eine Zweierpotenz sein");
+
+    T items[CAPACITY];
+    std::atomic<uint32_t> head;     // Nächster Leseindex (nur Konsument schreibt)
+    std::atomic<uint32_t> tail;     // Nächster Schreibindex (nur Produzent schreibt)
+    std::atomic<uint32_t> dropped;  // Verworfene Einträge (nur Produzent schreibt)
+
+public:
+    SpscQueue() : head(0), tail(0), dropped(0) {}
+
+    // Nur vom Produzenten aufrufen
+    bool push(const T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= CAPACITY) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        items[t & (CAPACITY - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Nur vom Konsumenten aufrufen
+    bool pop(T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[h & (CAPACITY - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "telemetry_batch.h"
+
+// Konstruktor: Leerer Puffer
+TelemetryBatch::TelemetryBatch() : head(0), count(0), firstSampleMs(0), droppedCount(0) {
+}
+
+// ===== Messwert hinzufügen =====
+// Bei vollem Puffer wird der älteste Wert überschrieben (z.B. während
+// einer längeren MQTT-Unterbrechung)
+void TelemetryBatch::add(const SensorData& data, unsigned long epoch) {
+    if (count == CAPACITY) {
+        head = (head + 1) % CAPACITY;
+        count--;
+        droppedCount++;
+        firstSampleMs = at(0).data.timestamp;
+    }
+
+    if (count == 0) {
+        firstSampleMs = data.timestamp;
+    }
+
+    TelemetrySample& slot = samples[(head + count) % CAPACITY];
+    slot.data = data;
+    slot.epoch = epoch;
+    count++;
+}
+
+// Alle Messwerte verwerfen (nach erfolgreichem Senden)
+void TelemetryBatch::clear() {
+    head = 0;
+    count = 0;
+}
+
+// ===== Sendeentscheidung =====
+// Gesendet wird wenn die Batch-Größe erreicht ist oder der älteste Wert
+// älter als TELEMETRY_BATCH_MAX_AGE_MS ist
+bool TelemetryBatch::shouldFlush(unsigned long nowMs) const {
+    if (count == 0) {
+        return false;
+    }
+    if (count >= CAPACITY) {
+        return true;
+    }
+    return (nowMs - firstSampleMs) >= TELEMETRY_BATCH_MAX_AGE_MS;
+}
+
+const TelemetrySample& TelemetryBatch::at(size_t index) const {
+    return samples[(head + index) % CAPACITY];
+}
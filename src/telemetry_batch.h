@@ -0,0 +1,46 @@
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sensors.h"
+
+// Ein Messwert mit dem Zeitstempel, zu dem er erfasst wurde
+struct TelemetrySample {
+    SensorData data;
+    unsigned long epoch;  // Unix-Zeit der Messung
+};
+
+// ===== Ringpuffer für Telemetrie-Batching =====
+// Sammelt bis zu TELEMETRY_BATCH_SIZE Messwerte, die gemeinsam in einer
+// MQTT-Nachricht gesendet werden. Ist der Puffer voll und kann nicht
+// gesendet werden, wird der älteste Messwert überschrieben.
+class TelemetryBatch {
+public:
+    static const size_t CAPACITY = (TELEMETRY_BATCH_SIZE > 0) ? TELEMETRY_BATCH_SIZE : 1;
+
+private:
+    TelemetrySample samples[CAPACITY];
+    size_t head;                  // Index des ältesten Messwerts
+    size_t count;                 // Anzahl gespeicherter Messwerte
+    unsigned long firstSampleMs;  // millis() des ältesten Messwerts
+    unsigned long droppedCount;   // Überschriebene Messwerte
+
+public:
+    TelemetryBatch();
+
+    void add(const SensorData& data, unsigned long epoch);
+    void clear();
+
+    // true wenn der Batch voll ist oder der älteste Wert zu alt wird
+    bool shouldFlush(unsigned long nowMs) const;
+
+    // Index 0 = ältester Messwert
+    const TelemetrySample& at(size_t index) const;
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    bool isFull() const { return count == CAPACITY; }
+    unsigned long getDroppedCount() const { return droppedCount; }
+};
+
+#endif
@@ -0,0 +1,595 @@
+#include "telemetry_codec.h"
+
+// Rundet auf Festkomma und begrenzt auf den Wertebereich
+static int32_t toFixed(float value, float scale, int32_t minValue, int32_t maxValue) {
+    if (isnan(value)) {
+        return 0;
+    }
+    float scaled = value * scale;
+    int32_t rounded = (int32_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+    if (rounded < minValue) return minValue;
+    if (rounded > maxValue) return maxValue;
+    return rounded;
+}
+
+// ===== SensorData -> Festkomma =====
+void TelemetryCodec::pack(const SensorData& data, unsigned long epoch, PackedSample& packed) {
+    packed.epoch = (uint32_t)epoch;
+    packed.flags = (data.bme280Valid ? 0x01 : 0x00) | (data.mpu9250Valid ? 0x02 : 0x00);
+
+    packed.temperature = (int16_t)toFixed(data.temperature, 100.0f, INT16_MIN, INT16_MAX);
+    packed.humidity = (uint16_t)toFixed(data.humidity, 100.0f, 0, UINT16_MAX);
+    packed.pressure = (uint16_t)toFixed(data.pressure, 10.0f, 0, UINT16_MAX);
+
+    packed.accel[0] = (int16_t)toFixed(data.accelX, 1000.0f, INT16_MIN, INT16_MAX);
+    packed.accel[1] = (int16_t)toFixed(data.accelY, 1000.0f, INT16_MIN, INT16_MAX);
+    packed.accel[2] = (int16_t)toFixed(data.accelZ, 1000.0f, INT16_MIN, INT16_MAX);
+    packed.gyro[0] = (int16_t)toFixed(data.gyroX, 10.0f, INT16_MIN, INT16_MAX);
+    packed.gyro[1] = (int16_t)toFixed(data.gyroY, 10.0f, INT16_MIN, INT16_MAX);
+    packed.gyro[2] = (int16_t)toFixed(data.gyroZ, 10.0f, INT16_MIN, INT16_MAX);
+}
+
+// ===== Festkomma -> SensorData =====
+void TelemetryCodec::unpack(const PackedSample& packed, SensorData& data, unsigned long& epoch) {
+    epoch = packed.epoch;
+    data.timestamp = 0;  // millis() der Messung wird nicht übertragen
+    data.epochMicros = 0;  // Nur Sekunden (epoch)
+    data.bmeReadMicros = 0;
+    data.mpuReadMicros = 0;
+    data.bme280Valid = (packed.flags & 0x01) != 0;
+    data.mpu9250Valid = (packed.flags & 0x02) != 0;
+    data.bme280Fresh = data.bme280Valid;
+    data.mpu9250Fresh = data.mpu9250Valid;
+    data.scheduledMillis = 0;
+    data.extraCount = 0;   // Zusatzkanäle werden nicht gespeichert
+
+    data.temperature = packed.temperature / 100.0f;
+    data.humidity = packed.humidity / 100.0f;
+    data.pressure = packed.pressure / 10.0f;
+
+    data.accelX = packed.accel[0] / 1000.0f;
+    data.accelY = packed.accel[1] / 1000.0f;
+    data.accelZ = packed.accel[2] / 1000.0f;
+    data.gyroX = packed.gyro[0] / 10.0f;
+    data.gyroY = packed.gyro[1] / 10.0f;
+    data.gyroZ = packed.gyro[2] / 10.0f;
+}
+
+// ===== JSON ohne Heap =====
+// Feldnamen stehen als fertige Fragmente im Flash (Messwerte: Kanal-Tabelle
+// der Treiber); Zahlen werden direkt in den Ausgabepuffer formatiert (kein
+// JsonDocument, kein String, kein printf).
+
+static constexpr char KEY_TIMESTAMP[] = "{\"timestamp\":";
+static constexpr char KEY_TIMESTAMP_US[] = ",\"timestampUs\":";
+
+static const uint32_t POW10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+static const float MAX_FIXED_VALUE = 1e7f;  // max. 7 Vorkommastellen
+
+// Schreibt in einen festen Puffer; bei Überlauf wird nur noch ok = false gesetzt
+class JsonWriter {
+private:
+    char* p;
+    char* end;   // letzte Position bleibt für '\0' reserviert
+
+public:
+    bool ok;
+
+    JsonWriter(char* output, size_t outputSize)
+        : p(output), end(output + outputSize - 1), ok(outputSize > 0) {}
+
+    size_t finish(char* output) {
+        if (!ok) {
+            return 0;
+        }
+        *p = '\0';
+        return p - output;
+    }
+
+    template <size_t N>
+    void literal(const char (&text)[N]) {
+        raw(text, N - 1);
+    }
+
+    void raw(const char* text, size_t length) {
+        if (!ok || (size_t)(end - p) < length) {
+            ok = false;
+            return;
+        }
+        memcpy(p, text, length);
+        p += length;
+    }
+
+    // ,"name": (Schlüssel aus einer Tabelle statt als Literal)
+    void key(const char* name) {
+        raw(",\"", 2);
+        raw(name, strlen(name));
+        raw("\":", 2);
+    }
+
+    void uint(uint64_t value) {
+        char digits[20];
+        size_t count = 0;
+        do {
+            digits[count++] = '0' + (value % 10);
+            value /= 10;
+        } while (value > 0);
+
+        if (!ok || (size_t)(end - p) < count) {
+            ok = false;
+            return;
+        }
+        while (count > 0) {
+            *p++ = digits[--count];
+        }
+    }
+
+    void integer(int64_t value) {
+        if (value < 0) {
+            raw("-", 1);
+            uint((uint64_t)-value);
+        } else {
+            uint((uint64_t)value);
+        }
+    }
+
+    // Festkomma-Ausgabe mit gerundeten Nachkommastellen; Nullen am Ende
+    // entfallen (23.50 -> 23.5, 1.00 -> 1). NaN/Inf und unplausible Beträge
+    // werden zu null, damit ein Objekt immer in JSON_SAMPLE_SIZE passt.
+    void fixed(float value, uint8_t decimals) {
+        if (isnan(value) || isinf(value) || fabsf(value) >= MAX_FIXED_VALUE) {
+            literal("null");
+            return;
+        }
+
+        double scaled = (double)value * POW10[decimals];
+        bool negative = scaled < 0;
+        uint64_t units = (uint64_t)((negative ? -scaled : scaled) + 0.5);
+        uint64_t integer = units / POW10[decimals];
+        uint32_t fraction = (uint32_t)(units % POW10[decimals]);
+
+        if (negative && units != 0) {
+            raw("-", 1);
+        }
+        uint(integer);
+
+        while (decimals > 0 && fraction % 10 == 0) {
+            fraction /= 10;
+            decimals--;
+        }
+        if (decimals > 0) {
+            char digits[8];
+            digits[0] = '.';
+            for (uint8_t i = decimals; i > 0; i--) {
+                digits[i] = '0' + (fraction % 10);
+                fraction /= 10;
+            }
+            raw(digits, decimals + 1);
+        }
+    }
+};
+
+// ===== JSON: einzelner Messwert =====
+// Gibt die Länge zurück (0 wenn der Puffer nicht ausreicht). "timestampUs"
+// (UTC in µs beim Auslesen) nur, wenn die Uhr zu dem Zeitpunkt gestellt war;
+// aus dem Offline-Speicher nachgesendete Werte haben nur Sekunden.
+// Die Messwerte kommen generisch aus der Kanal-Tabelle der Sensortreiber:
+// Kanäle mit festem Feld immer (Lesefehler als null), Zusatzkanäle nur,
+// wenn der Sensor einen Wert geliefert hat.
+size_t TelemetryCodec::encodeJson(const SensorData& data, unsigned long epoch, char* output, size_t outputSize) {
+    JsonWriter json(output, outputSize);
+
+    json.literal(KEY_TIMESTAMP);
+    json.uint(epoch);
+    if (data.epochMicros != 0) {
+        json.literal(KEY_TIMESTAMP_US);
+        json.uint(data.epochMicros);
+    }
+    for (uint8_t c = 0; c < SensorDriverRegistry::CHANNEL_COUNT; c++) {
+        const SensorChannelInfo& info = SensorDriverRegistry::channel(c);
+        float value;
+        if (info.field) {
+            value = data.*info.field;
+        } else {
+            const SensorRecord* record = data.findExtra(c);
+            if (!record) {
+                continue;
+            }
+            value = record->value;
+        }
+        json.key(info.name);
+        json.fixed(value, info.decimals);
+    }
+    json.literal("}");
+
+    return json.finish(output);
+}
+
+// ===== JSON: Schwingungskennwerte =====
+// {"timestamp":..,["timestampUs":..,]"type":"vibration","rateHz":..,"window":..,"windows":..,
+//  "bandWidthHz":..,"x":{"rms":..,"p2p":..,"crest":..,"bandRms":[..]},"y":{..},"z":{..}}
+// Bandenergien werden als Band-RMS (Wurzel der Energie, in g) übertragen,
+// damit die Festkomma-Ausgabe über den ganzen Messbereich genau bleibt.
+static constexpr char KEY_VIBRATION[] = ",\"type\":\"vibration\",\"rateHz\":";
+static constexpr char KEY_WINDOW[] = ",\"window\":";
+static constexpr char KEY_WINDOWS[] = ",\"windows\":";
+static constexpr char KEY_BAND_WIDTH[] = ",\"bandWidthHz\":";
+static constexpr char KEY_RMS[] = ":{\"rms\":";
+static constexpr char KEY_P2P[] = ",\"p2p\":";
+static constexpr char KEY_CREST[] = ",\"crest\":";
+static constexpr char KEY_BAND_RMS[] = ",\"bandRms\":[";
+static constexpr char AXIS_KEYS[3][5] = { ",\"x\"", ",\"y\"", ",\"z\"" };
+
+static const uint8_t DECIMALS_VIBRATION = 4;
+
+size_t TelemetryCodec::encodeVibrationJson(const VibrationFeatures& features, unsigned long epoch,
+                                           char* output, size_t outputSize) {
+    JsonWriter json(output, outputSize);
+
+    json.literal(KEY_TIMESTAMP);
+    json.uint(epoch);
+    if (features.endEpochMicros != 0) {
+        json.literal(KEY_TIMESTAMP_US);
+        json.uint(features.endEpochMicros);
+    }
+    json.literal(KEY_VIBRATION);
+    json.uint(features.rateHz);
+    json.literal(KEY_WINDOW);
+    json.uint(features.windowSize);
+    json.literal(KEY_WINDOWS);
+    json.uint(features.windows);
+    json.literal(KEY_BAND_WIDTH);
+    json.fixed(features.rateHz / 2.0f / VibrationAnalyzer::BAND_COUNT, 2);
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        const AxisFeatures& values = features.axes[axis];
+        json.literal(AXIS_KEYS[axis]);
+        json.literal(KEY_RMS);
+        json.fixed(values.rms, DECIMALS_VIBRATION);
+        json.literal(KEY_P2P);
+        json.fixed(values.peakToPeak, DECIMALS_VIBRATION);
+        json.literal(KEY_CREST);
+        json.fixed(values.crest, 2);
+        json.literal(KEY_BAND_RMS);
+        for (size_t b = 0; b < VibrationAnalyzer::BAND_COUNT; b++) {
+            if (b > 0) {
+                json.literal(",");
+            }
+            json.fixed(sqrtf(values.bandEnergy[b]), DECIMALS_VIBRATION);
+        }
+        json.literal("]}");
+    }
+    json.literal("}");
+
+    return json.finish(output);
+}
+
+// ===== JSON: Energiebilanz (Stromsparbetrieb) =====
+// Format: {"timestamp":..,"type":"power","wakeups":..,"samples":..,
+//          "energyPerSampleMj":..,"avgCurrentMa":..,"awakeMsPerSample":..}
+static constexpr char KEY_POWER[] = ",\"type\":\"power\",\"wakeups\":";
+static constexpr char KEY_SAMPLES[] = ",\"samples\":";
+static constexpr char KEY_ENERGY_PER_SAMPLE[] = ",\"energyPerSampleMj\":";
+static constexpr char KEY_AVG_CURRENT[] = ",\"avgCurrentMa\":";
+static constexpr char KEY_AWAKE_PER_SAMPLE[] = ",\"awakeMsPerSample\":";
+
+size_t TelemetryCodec::encodePowerJson(const PowerReport& report, unsigned long epoch,
+                                       char* output, size_t outputSize) {
+    JsonWriter json(output, outputSize);
+
+    json.literal(KEY_TIMESTAMP);
+    json.uint(epoch);
+    json.literal(KEY_POWER);
+    json.uint(report.wakeCount);
+    json.literal(KEY_SAMPLES);
+    json.uint(report.samples);
+    json.literal(KEY_ENERGY_PER_SAMPLE);
+    json.fixed(report.energyPerSampleMj, 2);
+    json.literal(KEY_AVG_CURRENT);
+    json.fixed(report.averageCurrentMa, 3);
+    json.literal(KEY_AWAKE_PER_SAMPLE);
+    json.uint(report.awakeMsPerSample);
+    json.literal("}");
+
+    return json.finish(output);
+}
+
+// ===== JSON: Laufzeit-Kennzahlen (Device Twin, Reported Properties) =====
+// Format: {"metrics":{"uptimeS":..,"intervalS":..,"loopUs":{"n":..,"p50":..,
+//          "p90":..,"p99":..,"max":..},...,"heap":{...},"wifi":{...},...}}
+// Ein Objekt je Bereich, damit der Twin-Patch nur geänderte Teile ersetzt.
+static constexpr char KEY_METRICS[] = "{\"metrics\":{\"uptimeS\":";
+static constexpr char KEY_INTERVAL_S[] = ",\"intervalS\":";
+static constexpr char KEY_LOOP_US[] = ",\"loopUs\":";
+static constexpr char KEY_BME_READ_US[] = ",\"bmeReadUs\":";
+static constexpr char KEY_MPU_READ_US[] = ",\"mpuReadUs\":";
+static constexpr char KEY_SERIALIZE_US[] = ",\"serializeUs\":";
+static constexpr char KEY_PUBLISH_US[] = ",\"publishUs\":";
+static constexpr char KEY_PUBACK_US[] = ",\"pubackUs\":";
+static constexpr char KEY_I2C_US[] = ",\"i2cUs\":";
+static constexpr char KEY_N[] = "{\"n\":";
+static constexpr char KEY_P50[] = ",\"p50\":";
+static constexpr char KEY_P90[] = ",\"p90\":";
+static constexpr char KEY_P99[] = ",\"p99\":";
+static constexpr char KEY_MAX[] = ",\"max\":";
+static constexpr char KEY_HEAP[] = ",\"heap\":{\"free\":";
+static constexpr char KEY_MIN_FREE[] = ",\"minFree\":";
+static constexpr char KEY_LARGEST[] = ",\"largestBlock\":";
+static constexpr char KEY_MIN_LARGEST[] = ",\"minLargestBlock\":";
+static constexpr char KEY_WIFI[] = "},\"wifi\":{\"rssi\":";
+static constexpr char KEY_OUTAGES[] = ",\"outages\":";
+static constexpr char KEY_ATTEMPTS[] = ",\"attempts\":";
+static constexpr char KEY_ROAMS[] = ",\"roams\":";
+static constexpr char KEY_MQTT[] = "},\"mqtt\":{\"outages\":";
+static constexpr char KEY_PUBLISH_FAILURES[] = ",\"publishFailures\":";
+static constexpr char KEY_RETRANSMITS[] = ",\"retransmits\":";
+static constexpr char KEY_IN_FLIGHT_MAX[] = ",\"inFlightMax\":";
+static constexpr char KEY_TLS[] = "},\"tls\":{\"full\":";
+static constexpr char KEY_RESUMED[] = ",\"resumed\":";
+static constexpr char KEY_MAX_MS[] = ",\"maxMs\":";
+static constexpr char KEY_TIME[] = "},\"time\":{\"syncs\":";
+static constexpr char KEY_TIMEOUTS[] = ",\"timeouts\":";
+static constexpr char KEY_I2C[] = "},\"i2c\":{\"errors\":";
+static constexpr char KEY_RECOVERIES[] = ",\"recoveries\":";
+static constexpr char KEY_DROPS[] = "},\"drops\":{\"sensorErrors\":";
+static constexpr char KEY_SAMPLES_DROPPED[] = ",\"samples\":";
+static constexpr char KEY_LOG_DROPPED[] = ",\"log\":";
+
+static void writeSummary(JsonWriter& json, const LatencySummary& summary) {
+    json.literal(KEY_N);
+    json.uint(summary.count);
+    json.literal(KEY_P50);
+    json.uint(summary.p50);
+    json.literal(KEY_P90);
+    json.uint(summary.p90);
+    json.literal(KEY_P99);
+    json.uint(summary.p99);
+    json.literal(KEY_MAX);
+    json.uint(summary.max);
+    json.literal("}");
+}
+
+size_t TelemetryCodec::encodeMetricsJson(const MetricsReport& report, char* output, size_t outputSize) {
+    JsonWriter json(output, outputSize);
+
+    json.literal(KEY_METRICS);
+    json.uint(report.uptimeS);
+    json.literal(KEY_INTERVAL_S);
+    json.uint(report.intervalS);
+    json.literal(KEY_LOOP_US);
+    writeSummary(json, report.loopUs);
+    json.literal(KEY_BME_READ_US);
+    writeSummary(json, report.bmeReadUs);
+    json.literal(KEY_MPU_READ_US);
+    writeSummary(json, report.mpuReadUs);
+    json.literal(KEY_SERIALIZE_US);
+    writeSummary(json, report.serializeUs);
+    json.literal(KEY_PUBLISH_US);
+    writeSummary(json, report.publishUs);
+    json.literal(KEY_PUBACK_US);
+    writeSummary(json, report.pubackUs);
+    json.literal(KEY_I2C_US);
+    writeSummary(json, report.i2cUs);
+
+    json.literal(KEY_HEAP);
+    json.uint(report.freeHeap);
+    json.literal(KEY_MIN_FREE);
+    json.uint(report.minFreeHeap);
+    json.literal(KEY_LARGEST);
+    json.uint(report.largestFreeBlock);
+    json.literal(KEY_MIN_LARGEST);
+    json.uint(report.minLargestFreeBlock);
+
+    json.literal(KEY_WIFI);
+    json.integer(report.rssi);
+    json.literal(KEY_OUTAGES);
+    json.uint(report.wifiOutages);
+    json.literal(KEY_ATTEMPTS);
+    json.uint(report.wifiAttempts);
+    json.literal(KEY_ROAMS);
+    json.uint(report.roams);
+
+    json.literal(KEY_MQTT);
+    json.uint(report.mqttOutages);
+    json.literal(KEY_ATTEMPTS);
+    json.uint(report.mqttAttempts);
+    json.literal(KEY_PUBLISH_FAILURES);
+    json.uint(report.publishFailures);
+    json.literal(KEY_RETRANSMITS);
+    json.uint(report.retransmits);
+    json.literal(KEY_IN_FLIGHT_MAX);
+    json.uint(report.inFlightMax);
+
+    json.literal(KEY_TLS);
+    json.uint(report.tlsFull);
+    json.literal(KEY_RESUMED);
+    json.uint(report.tlsResumed);
+    json.literal(KEY_MAX_MS);
+    json.uint(report.tlsMaxMs);
+
+    json.literal(KEY_TIME);
+    json.uint(report.timeSyncs);
+    json.literal(KEY_TIMEOUTS);
+    json.uint(report.timeTimeouts);
+
+    json.literal(KEY_I2C);
+    json.uint(report.i2cErrors);
+    json.literal(KEY_RECOVERIES);
+    json.uint(report.i2cRecoveries);
+
+    json.literal(KEY_DROPS);
+    json.uint(report.sensorErrors);
+    json.literal(KEY_SAMPLES_DROPPED);
+    json.uint(report.samplesDropped);
+    json.literal(KEY_LOG_DROPPED);
+    json.uint(report.logDropped);
+    json.literal("}}}");
+
+    return json.finish(output);
+}
+
+// Zusammenhängendes Array mit derselben Schnittstelle wie TelemetryBatch
+struct SampleArray {
+    const TelemetrySample* samples;
+    const TelemetrySample& at(size_t index) const { return samples[index]; }
+};
+
+// ===== JSON: Batch als Array =====
+// Format: [{...}, {...}, ...] – Azure Stream Analytics behandelt jedes
+// Array-Element als eigenes Ereignis. Ein einzelner Messwert wird als
+// Objekt ohne Array kodiert (gleiches Format wie ohne Batching).
+size_t TelemetryCodec::encodeJsonBatch(const TelemetryBatch& batch, char* output, size_t outputSize) {
+    return jsonArray(batch, batch.size(), output, outputSize);
+}
+
+size_t TelemetryCodec::encodeJsonBatch(const TelemetrySample* samples, size_t count, char* output, size_t outputSize) {
+    return jsonArray(SampleArray{ samples }, count, output, outputSize);
+}
+
+template <typename Samples>
+size_t TelemetryCodec::jsonArray(const Samples& samples, size_t count, char* output, size_t outputSize) {
+    if (count == 0 || outputSize < 3) {
+        return 0;
+    }
+
+    if (count == 1) {
+        const TelemetrySample& sample = samples.at(0);
+        return encodeJson(sample.data, sample.epoch, output, outputSize);
+    }
+
+    size_t length = 0;
+    output[length++] = '[';
+
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            output[length++] = ',';
+        }
+
+        // Platz für ']' freihalten; der Null-Terminator des Objekts wird
+        // danach von ']' überschrieben und folgt dahinter
+        const TelemetrySample& sample = samples.at(i);
+        if (outputSize - length < 3) {
+            return 0;
+        }
+        size_t written = encodeJson(sample.data, sample.epoch, output + length, outputSize - length - 1);
+        if (written == 0) {
+            return 0;
+        }
+        length += written;
+    }
+
+    output[length++] = ']';
+    output[length] = '\0';
+    return length;
+}
+
+// ===== Binär: Little-Endian Serialisierung =====
+// Feldweise geschrieben, damit das Format unabhängig vom Compiler-Layout ist
+static uint8_t* putU16(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+    return p + 2;
+}
+
+static uint8_t* putU32(uint8_t* p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = value >> 24;
+    return p + 4;
+}
+
+static const uint8_t* getU16(const uint8_t* p, uint16_t& value) {
+    value = (uint16_t)(p[0] | (p[1] << 8));
+    return p + 2;
+}
+
+static const uint8_t* getU32(const uint8_t* p, uint32_t& value) {
+    value = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    return p + 4;
+}
+
+void TelemetryCodec::writeSample(const PackedSample& packed, uint8_t* output) {
+    uint8_t* p = putU32(output, packed.epoch);
+    p = putU16(p, (uint16_t)packed.temperature);
+    p = putU16(p, packed.humidity);
+    p = putU16(p, packed.pressure);
+    for (int axis = 0; axis < 3; axis++) p = putU16(p, (uint16_t)packed.accel[axis]);
+    for (int axis = 0; axis < 3; axis++) p = putU16(p, (uint16_t)packed.gyro[axis]);
+    *p = packed.flags;
+}
+
+void TelemetryCodec::readSample(const uint8_t* input, PackedSample& packed) {
+    uint16_t raw;
+    uint32_t epoch;
+    const uint8_t* p = getU32(input, epoch);
+    packed.epoch = epoch;
+    p = getU16(p, raw); packed.temperature = (int16_t)raw;
+    p = getU16(p, raw); packed.humidity = raw;
+    p = getU16(p, raw); packed.pressure = raw;
+    for (int axis = 0; axis < 3; axis++) { p = getU16(p, raw); packed.accel[axis] = (int16_t)raw; }
+    for (int axis = 0; axis < 3; axis++) { p = getU16(p, raw); packed.gyro[axis] = (int16_t)raw; }
+    packed.flags = *p;
+}
+
+// ===== Binär: einzelner Messwert =====
+size_t TelemetryCodec::encodeBinary(const SensorData& data, unsigned long epoch, uint8_t* output, size_t outputSize) {
+    if (outputSize < BINARY_HEADER_SIZE + BINARY_SAMPLE_SIZE) {
+        return 0;
+    }
+    output[0] = BINARY_SCHEMA_VERSION;
+    output[1] = 1;
+
+    PackedSample packed;
+    pack(data, epoch, packed);
+    writeSample(packed, output + BINARY_HEADER_SIZE);
+    return BINARY_HEADER_SIZE + BINARY_SAMPLE_SIZE;
+}
+
+// ===== Binär: Batch =====
+size_t TelemetryCodec::encodeBinaryBatch(const TelemetryBatch& batch, uint8_t* output, size_t outputSize) {
+    return binaryArray(batch, batch.size(), output, outputSize);
+}
+
+size_t TelemetryCodec::encodeBinaryBatch(const TelemetrySample* samples, size_t count, uint8_t* output,
+                                         size_t outputSize) {
+    return binaryArray(SampleArray{ samples }, count, output, outputSize);
+}
+
+template <typename Samples>
+size_t TelemetryCodec::binaryArray(const Samples& samples, size_t count, uint8_t* output, size_t outputSize) {
+    size_t length = BINARY_HEADER_SIZE + count * BINARY_SAMPLE_SIZE;
+    if (count == 0 || count > 255 || outputSize < length) {
+        return 0;
+    }
+
+    output[0] = BINARY_SCHEMA_VERSION;
+    output[1] = (uint8_t)count;
+
+    for (size_t i = 0; i < count; i++) {
+        const TelemetrySample& sample = samples.at(i);
+        PackedSample packed;
+        pack(sample.data, sample.epoch, packed);
+        writeSample(packed, output + BINARY_HEADER_SIZE + i * BINARY_SAMPLE_SIZE);
+    }
+    return length;
+}
+
+// ===== Binär: Dekodierung (Host-Seite) =====
+size_t TelemetryCodec::decodeBinary(const uint8_t* input, size_t length, TelemetrySample* samples, size_t maxSamples) {
+    if (length < BINARY_HEADER_SIZE || input[0] != BINARY_SCHEMA_VERSION) {
+        return 0;
+    }
+
+    size_t count = input[1];
+    if (length != BINARY_HEADER_SIZE + count * BINARY_SAMPLE_SIZE || count > maxSamples) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        PackedSample packed;
+        readSample(input + BINARY_HEADER_SIZE + i * BINARY_SAMPLE_SIZE, packed);
+        unpack(packed, samples[i].data, samples[i].epoch);
+    }
+    return count;
+}
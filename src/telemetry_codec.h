@@ -0,0 +1,83 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <Arduino.h>
+#include "sensors.h"
+#include "telemetry_batch.h"
+#include "vibration.h"
+#include "power_manager.h"
+#include "metrics.h"
+
+// ===== Messwert in Festkomma (23 Bytes) =====
+// Gemeinsame Darstellung für den Offline-Speicher und das Binärformat
+struct __attribute__((packed)) PackedSample {
+    uint32_t epoch;        // Unix-Zeit der Messung
+    int16_t temperature;   // 0.01 °C
+    uint16_t humidity;     // 0.01 %
+    uint16_t pressure;     // 0.1 hPa
+    int16_t accel[3];      // 0.001 g
+    int16_t gyro[3];       // 0.1 °/s
+    uint8_t flags;         // Bit 0: BME280 gültig, Bit 1: MPU9250 gültig
+};
+
+// ===== Telemetrie-Kodierung =====
+// JSON (lesbar, Standard) oder kompaktes Binärformat:
+//
+//   Byte 0      Schema-Version (BINARY_SCHEMA_VERSION)
+//   Byte 1      Anzahl Messwerte N
+//   Byte 2...   N x 23 Bytes PackedSample, Little Endian
+//
+// Das Binärformat ist ca. 7x kleiner als JSON. Dekodierung auf dem Host
+// mit decodeBinary() oder tools/decode_telemetry.py. Es enthält nur die
+// Kanäle von BME280 und MPU9250; Zusatzkanäle weiterer Sensoren
+// (sensor_drivers.h) gehen nur mit JSON.
+//
+// Beide Kodierungen schreiben direkt in den übergebenen Puffer und
+// allokieren keinen Heap (wichtig für wochenlange Laufzeit ohne Reset).
+class TelemetryCodec {
+public:
+    static const uint8_t BINARY_SCHEMA_VERSION = 1;
+    static const size_t BINARY_HEADER_SIZE = 2;
+    static const size_t BINARY_SAMPLE_SIZE = sizeof(PackedSample);
+    // Obergrenze pro JSON-Objekt inkl. '\0': feste Kanäle plus je Zusatzkanal
+    // Schlüssel (SENSOR_NAME_MAX) und Zahl
+    static const size_t JSON_SAMPLE_SIZE = 288 + SENSOR_EXTRA_RECORDS * (SensorChannelInfo::SENSOR_NAME_MAX + 18);
+    static const size_t VIBRATION_JSON_SIZE = 192 + 3 * (80 + VIBRATION_BAND_COUNT * 14);  // Obergrenze
+    static const size_t POWER_JSON_SIZE = 192;  // Obergrenze
+    static const size_t METRICS_JSON_SIZE = 1536;  // Obergrenze (alle Zahlen 10-stellig: ~1300 Bytes)
+
+    // Festkomma-Umrechnung
+    static void pack(const SensorData& data, unsigned long epoch, PackedSample& packed);
+    static void unpack(const PackedSample& packed, SensorData& data, unsigned long& epoch);
+
+    // JSON: einzelnes Objekt bzw. Array; Rückgabe 0 wenn der Puffer nicht reicht
+    static size_t encodeJson(const SensorData& data, unsigned long epoch, char* output, size_t outputSize);
+    static size_t encodeJsonBatch(const TelemetryBatch& batch, char* output, size_t outputSize);
+    static size_t encodeJsonBatch(const TelemetrySample* samples, size_t count, char* output, size_t outputSize);
+    static size_t encodeVibrationJson(const VibrationFeatures& features, unsigned long epoch,
+                                      char* output, size_t outputSize);
+    static size_t encodePowerJson(const PowerReport& report, unsigned long epoch,
+                                  char* output, size_t outputSize);
+    static size_t encodeMetricsJson(const MetricsReport& report, char* output, size_t outputSize);
+
+    // Binär: Rückgabe 0 wenn der Puffer nicht reicht
+    static size_t encodeBinary(const SensorData& data, unsigned long epoch, uint8_t* output, size_t outputSize);
+    static size_t encodeBinaryBatch(const TelemetryBatch& batch, uint8_t* output, size_t outputSize);
+    static size_t encodeBinaryBatch(const TelemetrySample* samples, size_t count, uint8_t* output, size_t outputSize);
+
+    // Host-seitiger Decoder: Anzahl dekodierter Messwerte (0 bei Formatfehler)
+    static size_t decodeBinary(const uint8_t* input, size_t length, TelemetrySample* samples, size_t maxSamples);
+
+private:
+    // Gemeinsamer Kern der Batch-Varianten; Samples liefert at(i)
+    // (TelemetryBatch als Ring oder ein zusammenhängendes Array)
+    template <typename Samples>
+    static size_t jsonArray(const Samples& samples, size_t count, char* output, size_t outputSize);
+    template <typename Samples>
+    static size_t binaryArray(const Samples& samples, size_t count, uint8_t* output, size_t outputSize);
+
+    static void writeSample(const PackedSample& packed, uint8_t* output);
+    static void readSample(const uint8_t* input, PackedSample& packed);
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include "telemetry_filter.h"
+
+const char* const TelemetryFilter::CHANNEL_NAMES[CHANNEL_COUNT] = {
+    "temperature", "humidity", "pressure",
+    "accelX", "accelY", "accelZ",
+    "gyroX", "gyroY", "gyroZ"
+};
+
+float SensorData::* const TelemetryFilter::CHANNEL_FIELDS[CHANNEL_COUNT] = {
+    &SensorData::temperature, &SensorData::humidity, &SensorData::pressure,
+    &SensorData::accelX, &SensorData::accelY, &SensorData::accelZ,
+    &SensorData::gyroX, &SensorData::gyroY, &SensorData::gyroZ
+};
+
+static bool isBme280Channel(size_t channel) {
+    return channel <= CHANNEL_PRESSURE;
+}
+
+// Konstruktor: Voreinstellungen aus config.h
+TelemetryFilter::TelemetryFilter()
+    : lastBme280Valid(false), lastMpu9250Valid(false), hasLast(false),
+      enabled(TELEMETRY_FILTER_ENABLED), passedCount(0), suppressedCount(0) {
+    const uint32_t heartbeatMs = TELEMETRY_FILTER_HEARTBEAT_S * 1000UL;
+    config[CHANNEL_TEMPERATURE] = { TELEMETRY_DEADBAND_TEMPERATURE, false, heartbeatMs };
+    config[CHANNEL_HUMIDITY] = { TELEMETRY_DEADBAND_HUMIDITY, false, heartbeatMs };
+    config[CHANNEL_PRESSURE] = { TELEMETRY_DEADBAND_PRESSURE, false, heartbeatMs };
+    for (size_t c = CHANNEL_ACCEL_X; c <= CHANNEL_ACCEL_Z; c++) {
+        config[c] = { TELEMETRY_DEADBAND_ACCEL, false, heartbeatMs };
+    }
+    for (size_t c = CHANNEL_GYRO_X; c <= CHANNEL_GYRO_Z; c++) {
+        config[c] = { TELEMETRY_DEADBAND_GYRO, false, heartbeatMs };
+    }
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        lastSent[c] = NAN;
+        lastSentMillis[c] = 0;
+        triggerCount[c] = 0;
+    }
+}
+
+bool TelemetryFilter::exceedsDeadband(TelemetryChannel channel, float value) const {
+    const ChannelFilterConfig& channelConfig = config[channel];
+    float delta = fabsf(value - lastSent[channel]);
+    float threshold = channelConfig.percent
+                    ? fabsf(lastSent[channel]) * channelConfig.deadband / 100.0f
+                    : channelConfig.deadband;
+    return delta > threshold || (threshold <= 0.0f && delta > 0.0f);
+}
+
+void TelemetryFilter::remember(const SensorData& data) {
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        lastSent[c] = data.*CHANNEL_FIELDS[c];
+        lastSentMillis[c] = data.timestamp;
+    }
+    lastBme280Valid = data.bme280Valid;
+    lastMpu9250Valid = data.mpu9250Valid;
+    hasLast = true;
+}
+
+// ===== Entscheidung pro Messwert =====
+bool TelemetryFilter::shouldPublish(const SensorData& data) {
+    bool publish = !enabled || !hasLast ||
+                   data.bme280Valid != lastBme280Valid ||
+                   data.mpu9250Valid != lastMpu9250Valid;
+
+    for (size_t c = 0; c < CHANNEL_COUNT && !publish; c++) {
+        bool valid = isBme280Channel(c) ? data.bme280Valid : data.mpu9250Valid;
+        if (!valid) {
+            continue;
+        }
+
+        TelemetryChannel channel = (TelemetryChannel)c;
+        if (exceedsDeadband(channel, data.*CHANNEL_FIELDS[c])) {
+            triggerCount[c]++;
+            publish = true;
+        } else if (config[c].heartbeatMs > 0 &&
+                   data.timestamp - lastSentMillis[c] >= config[c].heartbeatMs) {
+            publish = true;
+        }
+    }
+
+    if (publish) {
+        remember(data);
+        passedCount++;
+    } else {
+        suppressedCount++;
+    }
+    return publish;
+}
+
+void TelemetryFilter::reset() {
+    hasLast = false;
+}
+
+void TelemetryFilter::setEnabled(bool enable) {
+    enabled = enable;
+    reset();
+}
+
+void TelemetryFilter::setChannel(TelemetryChannel channel, const ChannelFilterConfig& channelConfig) {
+    config[channel] = channelConfig;
+}
+
+// ===== Konfiguration per C2D =====
+// Unbekannte Kanäle und negative Werte werden abgelehnt; gültige Teile
+// werden trotzdem übernommen
+bool TelemetryFilter::applyConfig(JsonVariantConst filterConfig) {
+    bool ok = true;
+
+    if (filterConfig.containsKey("enabled")) {
+        setEnabled(filterConfig["enabled"].as<bool>());
+    }
+
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        JsonVariantConst channelConfig = filterConfig[CHANNEL_NAMES[c]];
+        if (channelConfig.isNull()) {
+            continue;
+        }
+
+        ChannelFilterConfig updated = config[c];
+        if (channelConfig.containsKey("abs")) {
+            updated.deadband = channelConfig["abs"].as<float>();
+            updated.percent = false;
+        } else if (channelConfig.containsKey("pct")) {
+            updated.deadband = channelConfig["pct"].as<float>();
+            updated.percent = true;
+        }
+        if (channelConfig.containsKey("heartbeat")) {
+            float seconds = channelConfig["heartbeat"].as<float>();
+            updated.heartbeatMs = seconds > 0.0f ? (uint32_t)(seconds * 1000.0f) : 0;
+        }
+
+        if (!(updated.deadband >= 0.0f)) {
+            Serial.printf("❌ Filter: ungültiges Totband für %s\n", CHANNEL_NAMES[c]);
+            ok = false;
+            continue;
+        }
+        config[c] = updated;
+    }
+
+    // Geänderte Schwellen sollen sofort greifen
+    reset();
+    return ok;
+}
+
+bool TelemetryFilter::commandHandler(JsonVariantConst command, void* context) {
+    if (!command.containsKey("filter")) {
+        return false;
+    }
+    TelemetryFilter* filter = (TelemetryFilter*)context;
+    if (filter->applyConfig(command["filter"])) {
+        Serial.println("✅ Filter-Konfiguration übernommen");
+    }
+    filter->printConfig();
+    return true;
+}
+
+void TelemetryFilter::printConfig() const {
+    Serial.printf("Telemetrie-Filter: %s\n", enabled ? "aktiv" : "aus");
+    for (size_t c = 0; c < CHANNEL_COUNT; c++) {
+        Serial.printf("  %-12s Totband %8.3f%s  Heartbeat %5lu s\n",
+                      CHANNEL_NAMES[c], config[c].deadband, config[c].percent ? " %" : "  ",
+                      (unsigned long)(config[c].heartbeatMs / 1000));
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef TELEMETRY_FILTER_H
+#define TELEMETRY_FILTER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "sensors.h"
+
+// Kanäle von SensorData in fester Reihenfolge
+enum TelemetryChannel {
+    CHANNEL_TEMPERATURE,
+    CHANNEL_HUMIDITY,
+    CHANNEL_PRESSURE,
+    CHANNEL_ACCEL_X,
+    CHANNEL_ACCEL_Y,
+    CHANNEL_ACCEL_Z,
+    CHANNEL_GYRO_X,
+    CHANNEL_GYRO_Y,
+    CHANNEL_GYRO_Z,
+    CHANNEL_COUNT
+};
+
+// Totband und Heartbeat eines Kanals
+struct ChannelFilterConfig {
+    float deadband;         // Mindeständerung (0 = jede Änderung senden)
+    bool percent;           // true: deadband in % des zuletzt gesendeten Werts
+    uint32_t heartbeatMs;   // Spätestens nach dieser Zeit senden (0 = nie erzwingen)
+};
+
+// ===== Report-by-Exception =====
+// Sitzt zwischen Sensor-Task und Versand: Ein Messwert wird nur gesendet,
+// wenn sich mindestens ein Kanal um mehr als sein Totband gegenüber dem
+// zuletzt gesendeten Wert geändert hat, ein Kanal seinen Heartbeat
+// erreicht oder sich die Gültigkeit eines Sensors ändert. Gesendet wird
+// immer der vollständige Messwert (gleiches Format wie bisher).
+//
+// Zur Laufzeit per C2D-Nachricht einstellbar, z.B.
+//   {"filter":{"enabled":true,"temperature":{"abs":0.2,"heartbeat":600},
+//              "pressure":{"pct":0.01}}}
+class TelemetryFilter {
+private:
+    ChannelFilterConfig config[CHANNEL_COUNT];
+    float lastSent[CHANNEL_COUNT];
+    unsigned long lastSentMillis[CHANNEL_COUNT];
+    bool lastBme280Valid;
+    bool lastMpu9250Valid;
+    bool hasLast;
+    bool enabled;
+
+    uint32_t passedCount;
+    uint32_t suppressedCount;
+    uint32_t triggerCount[CHANNEL_COUNT];   // Erster Kanal über dem Totband je gesendetem Wert
+
+    bool exceedsDeadband(TelemetryChannel channel, float value) const;
+    void remember(const SensorData& data);
+
+public:
+    static const char* const CHANNEL_NAMES[CHANNEL_COUNT];
+    // Zugriff auf die Kanäle über Member-Zeiger (gleiche Reihenfolge wie TelemetryChannel)
+    static float SensorData::* const CHANNEL_FIELDS[CHANNEL_COUNT];
+
+    TelemetryFilter();  // Voreinstellungen aus config.h
+
+    // true = Messwert senden (der Wert gilt danach als gesendet)
+    bool shouldPublish(const SensorData& data);
+    void reset();       // Nächster Messwert wird in jedem Fall gesendet
+
+    void setEnabled(bool enable);
+    bool isEnabled() const { return enabled; }
+    void setChannel(TelemetryChannel channel, const ChannelFilterConfig& channelConfig);
+    const ChannelFilterConfig& getChannel(TelemetryChannel channel) const { return config[channel]; }
+
+    // Übernimmt das "filter"-Objekt einer C2D-Nachricht; false bei Fehlern
+    bool applyConfig(JsonVariantConst filterConfig);
+    void printConfig() const;
+
+    // Für MQTTClient::onCommand (context = TelemetryFilter*)
+    static bool commandHandler(JsonVariantConst command, void* context);
+
+    uint32_t getPassedCount() const { return passedCount; }
+    uint32_t getSuppressedCount() const { return suppressedCount; }
+    uint32_t getTriggerCount(TelemetryChannel channel) const { return triggerCount[channel]; }
+};
+
+#endif
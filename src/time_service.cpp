@@ -0,0 +1,316 @@
+#include <WiFi.h>
+#include "time_service.h"
+#include "config.h"
+
+static const uint64_t NTP_UNIX_OFFSET = 2208988800ULL;   // 1900 -> 1970 [s]
+static const int64_t DISPERSION_PPM = 15;                // RFC 5905: Zuwachs der Fehlerschranke
+
+// ===== NTP-Zeitstempel (32.32 Festkomma ab 1900) =====
+static void putTimestamp(uint8_t* p, uint64_t epochMicros) {
+    uint64_t seconds = epochMicros / 1000000ULL + NTP_UNIX_OFFSET;
+    uint64_t fraction = ((epochMicros % 1000000ULL) << 32) / 1000000ULL;
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(seconds >> (24 - 8 * i));
+        p[4 + i] = (uint8_t)(fraction >> (24 - 8 * i));
+    }
+}
+
+// Ohne gesetztes Bit 31 liegt der Zeitstempel in der NTP-Ära 1 (ab 2036)
+static int64_t getTimestamp(const uint8_t* p) {
+    uint64_t seconds = ((uint64_t)p[0] << 24) | ((uint64_t)p[1] << 16) | ((uint64_t)p[2] << 8) | p[3];
+    uint64_t fraction = ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) | ((uint64_t)p[6] << 8) | p[7];
+    if ((seconds & 0x80000000ULL) == 0) {
+        seconds += 1ULL << 32;
+    }
+    return (int64_t)((seconds - NTP_UNIX_OFFSET) * 1000000ULL + ((fraction * 1000000ULL) >> 32));
+}
+
+TimeService::TimeService()
+    : sequence(0), udpOpen(false), serverResolved(false), requestPending(false),
+      requestSentMs(0), requestMono(0), responseMono(0), responseReady(0),
+      lastRequestMs(0), pollIntervalMs(0),
+      lastSyncMono(0), lastOffsetUs(0), lastDelayUs(0), lastStratum(0),
+      syncCount(0), stepCount(0), timeoutCount(0), rejectedCount(0), consecutiveTimeouts(0),
+      offsetStats(125), delayStats(2000) {
+    memset(&discipline, 0, sizeof(discipline));
+    memset(requestTransmit, 0, sizeof(requestTransmit));
+    memset(responsePacket, 0, sizeof(responsePacket));
+}
+
+// ===== Sequenzzähler =====
+// Einziger Schreiber ist poll() im Netzwerk-Task; Leser wiederholen, bis sie
+// eine Kopie ohne gleichzeitigen Schreibvorgang erwischt haben
+void TimeService::publish(const Discipline& next) {
+    uint32_t seq = __atomic_load_n(&sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&sequence, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    discipline = next;
+    __atomic_store_n(&sequence, seq + 2, __ATOMIC_RELEASE);
+}
+
+TimeService::Discipline TimeService::snapshot() const {
+    Discipline copy;
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+        copy = discipline;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&sequence, __ATOMIC_RELAXED);
+    } while ((before & 1) || before != after);
+    return copy;
+}
+
+// ===== Abbildung esp_timer -> UTC =====
+// Eingeglitten wird mit höchstens NTP_SLEW_MAX_PPM; zusammen mit der auf
+// NTP_MAX_FREQ_PPM begrenzten Frequenzkorrektur läuft die Uhr immer vorwärts
+int64_t TimeService::slewApplied(int64_t slewUs, int64_t elapsedUs) {
+    if (slewUs == 0 || elapsedUs <= 0) {
+        return 0;
+    }
+    int64_t limit = elapsedUs * NTP_SLEW_MAX_PPM / 1000000LL;
+    if (slewUs > 0) {
+        return slewUs < limit ? slewUs : limit;
+    }
+    return -slewUs < limit ? slewUs : -limit;
+}
+
+int64_t TimeService::epochAt(const Discipline& d, int64_t mono) {
+    int64_t elapsed = mono - d.refMono;
+    return d.refEpoch + elapsed + elapsed * d.freqPpb / 1000000000LL + slewApplied(d.slewUs, elapsed);
+}
+
+uint64_t TimeService::nowEpochMicros() const {
+    return toEpochMicros(monotonicMicros());
+}
+
+uint64_t TimeService::toEpochMicros(int64_t monoMicros) const {
+    Discipline d = snapshot();
+    return d.valid ? (uint64_t)epochAt(d, monoMicros) : 0;
+}
+
+bool TimeService::formatTime(char* output, size_t outputSize, long offsetSeconds) const {
+    uint64_t now = nowEpochMicros();
+    if (now == 0) {
+        snprintf(output, outputSize, "00:00:00.000");
+        return false;
+    }
+    uint64_t local = now + (int64_t)offsetSeconds * 1000000LL;
+    uint32_t secondOfDay = (uint32_t)((local / 1000000ULL) % 86400ULL);
+    snprintf(output, outputSize, "%02lu:%02lu:%02lu.%03lu",
+             (unsigned long)(secondOfDay / 3600), (unsigned long)(secondOfDay / 60 % 60),
+             (unsigned long)(secondOfDay % 60), (unsigned long)(local / 1000ULL % 1000ULL));
+    return true;
+}
+
+uint32_t TimeService::getErrorBoundMicros() const {
+    Discipline d = snapshot();
+    if (!d.valid) {
+        return UINT32_MAX;
+    }
+    int64_t elapsed = monotonicMicros() - d.refMono;
+    int64_t remaining = d.slewUs - slewApplied(d.slewUs, elapsed);
+    uint64_t bound = (uint64_t)(remaining < 0 ? -remaining : remaining) + lastDelayUs / 2 +
+                     (uint64_t)(monotonicMicros() - lastSyncMono) * DISPERSION_PPM / 1000000ULL;
+    return bound > UINT32_MAX ? UINT32_MAX : (uint32_t)bound;
+}
+
+// ===== SNTP-Abfrage =====
+// Ein Schritt je Aufruf, nie warten: offene Anfrage prüfen bzw. bei
+// Fälligkeit eine neue senden. Empfangen wird im Hintergrund (onPacket()).
+bool TimeService::poll(unsigned long now) {
+    if (requestPending) {
+        if (receiveResponse()) {
+            return true;
+        }
+        if (requestPending && now - requestSentMs >= NTP_RESPONSE_TIMEOUT_MS) {
+            requestPending = false;
+            timeoutCount++;
+            pollIntervalMs = NTP_RETRY_INTERVAL_MS;
+            // Hinter dem Pool-Namen stehen wechselnde Server: nach drei
+            // Timeouts beim nächsten Versuch neu auflösen
+            if (++consecutiveTimeouts >= 3) {
+                serverResolved = false;
+                consecutiveTimeouts = 0;
+            }
+        }
+        return false;
+    }
+
+    if (now - lastRequestMs >= pollIntervalMs) {
+        sendRequest(now);
+    }
+    return false;
+}
+
+void TimeService::requestSync() {
+    pollIntervalMs = 0;
+}
+
+bool TimeService::syncBlocking(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    uint32_t before = syncCount;
+    requestSync();
+    while (syncCount == before && millis() - start < timeoutMs) {
+        poll(millis());
+        if (syncCount == before) {
+            delay(10);
+        }
+    }
+    return syncCount != before;
+}
+
+bool TimeService::sendRequest(unsigned long now) {
+    lastRequestMs = now;
+    pollIntervalMs = NTP_RETRY_INTERVAL_MS;   // Bis eine Antwort übernommen wurde
+
+    if (!udpOpen) {
+        udp.onPacket(onPacket, this);
+        udpOpen = udp.listen(LOCAL_PORT);
+        if (!udpOpen) {
+            return false;
+        }
+    }
+    // Namensauflösung blockiert kurz (DNS-Cache des lwIP), daher nur beim
+    // ersten Mal und nach wiederholten Timeouts
+    if (!serverResolved) {
+        serverResolved = WiFi.hostByName(NTP_SERVER, serverIp) == 1;
+        if (!serverResolved) {
+            return false;
+        }
+    }
+
+    // SNTP-Anfrage: LI 0, Version 4, Mode 3 (Client); als Transmit-Zeit
+    // die eigene Uhr, der Server schickt sie als Originate zurück
+    uint8_t packet[PACKET_SIZE];
+    memset(packet, 0, sizeof(packet));
+    packet[0] = (0 << 6) | (4 << 3) | 3;
+    Discipline d = snapshot();
+    requestMono = monotonicMicros();
+    putTimestamp(packet + 40, (uint64_t)(d.valid ? epochAt(d, requestMono) : requestMono));
+    memcpy(requestTransmit, packet + 40, sizeof(requestTransmit));
+
+    // Ältere, noch nicht ausgewertete Antwort verwerfen
+    __atomic_store_n(&responseReady, 0, __ATOMIC_RELEASE);
+    if (udp.writeTo(packet, sizeof(packet), serverIp, NTP_PORT) != sizeof(packet)) {
+        return false;
+    }
+    requestPending = true;
+    requestSentMs = now;
+    return true;
+}
+
+// ===== Empfang (AsyncUDP-Task) =====
+// Nur Zeitstempel nehmen und das Paket übergeben; ausgewertet wird in poll().
+// Solange die vorige Antwort nicht abgeholt ist, wird nichts überschrieben.
+void TimeService::onPacket(void* arg, AsyncUDPPacket& packet) {
+    int64_t t4Mono = monotonicMicros();
+    TimeService* self = (TimeService*)arg;
+    if (packet.length() < PACKET_SIZE || __atomic_load_n(&self->responseReady, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+    memcpy(self->responsePacket, packet.data(), PACKET_SIZE);
+    self->responseMono = t4Mono;
+    __atomic_store_n(&self->responseReady, 1, __ATOMIC_RELEASE);
+}
+
+// Antwort prüfen; verspätete Antworten früherer Anfragen erkennt der
+// Vergleich des Originate-Felds
+bool TimeService::receiveResponse() {
+    if (!__atomic_load_n(&responseReady, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    uint8_t packet[PACKET_SIZE];
+    memcpy(packet, responsePacket, PACKET_SIZE);
+    int64_t t4Mono = responseMono;
+    __atomic_store_n(&responseReady, 0, __ATOMIC_RELEASE);
+
+    if (memcmp(packet + 24, requestTransmit, sizeof(requestTransmit)) != 0) {
+        return false;
+    }
+    requestPending = false;
+
+    uint8_t leap = packet[0] >> 6;
+    uint8_t mode = packet[0] & 0x07;
+    uint8_t stratum = packet[1];
+    // Kiss-o'-Death (Stratum 0) oder Server ohne eigene Synchronisation
+    if (mode != 4 || stratum == 0 || stratum > 15 || leap == 3) {
+        rejectedCount++;
+        return false;
+    }
+
+    Discipline d = snapshot();
+    int64_t t1 = d.valid ? epochAt(d, requestMono) : requestMono;
+    int64_t t4 = d.valid ? epochAt(d, t4Mono) : t4Mono;
+    int64_t t2 = getTimestamp(packet + 32);
+    int64_t t3 = getTimestamp(packet + 40);
+    int64_t offset = ((t2 - t1) + (t3 - t4)) / 2;
+    int64_t delayUs = (t4 - t1) - (t3 - t2);
+    if (delayUs < 0) {
+        delayUs = 0;
+    }
+    // Lange Laufzeit = großer möglicher Fehler (asymmetrische Wege)
+    if (delayUs > (int64_t)NTP_MAX_DELAY_MS * 1000) {
+        rejectedCount++;
+        return false;
+    }
+
+    consecutiveTimeouts = 0;
+    lastStratum = stratum;
+    pollIntervalMs = NTP_UPDATE_INTERVAL_MS;
+    applyMeasurement(offset, (uint32_t)delayUs, t4Mono);
+    return true;
+}
+
+// ===== Nachführung =====
+// Erste Messung und große Abweichungen: Sprung. Sonst neuer Bezugspunkt
+// auf der aktuellen Uhr (stetig) und den Versatz eingleiten. Was seit dem
+// letzten Abgleich über den damals geplanten Rest hinaus auflief, geht
+// anteilig in die Frequenzkorrektur.
+void TimeService::applyMeasurement(int64_t offsetUs, uint32_t delayUs, int64_t mono) {
+    Discipline next = snapshot();
+    int64_t clockNow = next.valid ? epochAt(next, mono) : mono;
+    int64_t magnitude = offsetUs < 0 ? -offsetUs : offsetUs;
+
+    if (!next.valid || magnitude > (int64_t)NTP_STEP_THRESHOLD_MS * 1000) {
+        next.refEpoch = clockNow + offsetUs;
+        next.slewUs = 0;
+        next.valid = true;
+        stepCount++;
+    } else {
+        int64_t interval = mono - lastSyncMono;
+        if (interval >= MIN_FREQUENCY_INTERVAL_US) {
+            int64_t elapsed = mono - next.refMono;
+            int64_t remaining = next.slewUs - slewApplied(next.slewUs, elapsed);
+            int64_t driftPpb = (offsetUs - remaining) * 1000000000LL / interval;
+            int64_t freq = next.freqPpb + driftPpb / FREQUENCY_GAIN;
+            int64_t limit = (int64_t)NTP_MAX_FREQ_PPM * 1000;
+            next.freqPpb = (int32_t)(freq > limit ? limit : freq < -limit ? -limit : freq);
+        }
+        next.refEpoch = clockNow;
+        next.slewUs = offsetUs;
+    }
+    next.refMono = mono;
+    publish(next);
+
+    lastSyncMono = mono;
+    lastOffsetUs = offsetUs;
+    lastDelayUs = delayUs;
+    syncCount++;
+    offsetStats.add(magnitude > UINT32_MAX ? UINT32_MAX : (uint32_t)magnitude);
+    delayStats.add(delayUs);
+}
+
+void TimeService::printStats() const {
+    Serial.println("Zeitdienst (SNTP):");
+    Serial.printf("  %s, %lu Abgleiche, %lu Sprünge, %lu Timeouts, %lu verworfen\n",
+                  isSynchronized() ? "synchronisiert" : "nicht synchronisiert",
+                  (unsigned long)syncCount, (unsigned long)stepCount,
+                  (unsigned long)timeoutCount, (unsigned long)rejectedCount);
+    Serial.printf("  Letzter Versatz %+lld µs, Laufzeit %lu µs, Stratum %u\n",
+                  (long long)lastOffsetUs, (unsigned long)lastDelayUs, (unsigned)lastStratum);
+    Serial.printf("  Frequenzkorrektur %+.3f ppm, Fehlerschranke %lu µs\n",
+                  getFrequencyPpm(), (unsigned long)getErrorBoundMicros());
+    offsetStats.print("|Versatz|", "µs");
+    delayStats.print("Laufzeit", "µs");
+}
@@ -0,0 +1,127 @@
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <Arduino.h>
+#include <AsyncUDP.h>
+#include <esp_timer.h>
+#include "histogram.h"
+
+// ===== Zeitdienst: UTC in µs, per SNTP nachgeführt =====
+// Grundlage ist der monotone 64-Bit-Zähler esp_timer_get_time(). Daraus
+// wird über einen Bezugspunkt, eine Frequenzkorrektur und eine noch
+// einzugleitende Restkorrektur die UTC-Zeit in µs berechnet:
+//
+//   utc(t) = refEpoch + dt + dt·freq + slew(dt),   dt = t - refMono
+//
+// SNTP (RFC 4330) läuft nicht blockierend über poll(): Anfrage senden,
+// Antwort bei einem der folgenden Aufrufe auswerten. Die Empfangszeit t4
+// nimmt der AsyncUDP-Rückruf beim Eintreffen des Pakets, nicht erst poll()
+// – sonst ginge der halbe Abfragetakt des Netzwerk-Tasks in den Versatz
+// ein. Versatz und Laufzeit ergeben sich aus den vier Zeitstempeln.
+// Kleine Abweichungen werden mit höchstens NTP_SLEW_MAX_PPM eingeglitten
+// (die Uhr bleibt monoton), erst ab NTP_STEP_THRESHOLD_MS springt sie. Der
+// Rest, der zwischen zwei Abgleichen auflief, stellt die Frequenz nach.
+//
+// Lesen (nowEpochMicros(), toEpochMicros()) ist von beiden Kernen aus
+// erlaubt (Sequenzzähler); poll() nur aus dem Netzwerk-Task.
+class TimeService {
+public:
+    static const uint16_t LOCAL_PORT = 2390;
+    static const uint16_t NTP_PORT = 123;
+
+private:
+    static const size_t PACKET_SIZE = 48;
+    static const int64_t MIN_FREQUENCY_INTERVAL_US = 30000000LL;  // Kürzere Abstände zu verrauscht
+    static const int32_t FREQUENCY_GAIN = 4;                       // Anteil je Abgleich: 1/4
+
+    // Abbildung esp_timer -> UTC; wird nur als Ganzes ersetzt
+    struct Discipline {
+        int64_t refMono;      // esp_timer-Zeit des Bezugspunkts [µs]
+        int64_t refEpoch;     // UTC am Bezugspunkt [µs]
+        int64_t slewUs;       // Ab refMono einzugleitende Korrektur
+        int32_t freqPpb;      // Frequenzkorrektur [10^-9]
+        bool valid;           // Mindestens einmal synchronisiert
+    };
+
+    Discipline discipline;
+    uint32_t sequence;        // Ungerade während discipline ersetzt wird
+
+    AsyncUDP udp;
+    bool udpOpen;
+    IPAddress serverIp;
+    bool serverResolved;
+
+    bool requestPending;
+    unsigned long requestSentMs;
+    int64_t requestMono;                  // t1 auf dem esp_timer
+    uint8_t requestTransmit[8];           // Kennung der Anfrage (Originate der Antwort)
+
+    // Übergabe vom AsyncUDP-Task: Paket und t4, gültig solange responseReady
+    uint8_t responsePacket[PACKET_SIZE];
+    int64_t responseMono;
+    uint32_t responseReady;
+
+    unsigned long lastRequestMs;
+    uint32_t pollIntervalMs;              // Abstand bis zur nächsten Anfrage
+
+    int64_t lastSyncMono;
+    int64_t lastOffsetUs;
+    uint32_t lastDelayUs;
+    uint8_t lastStratum;
+    uint32_t syncCount;
+    uint32_t stepCount;
+    uint32_t timeoutCount;
+    uint32_t rejectedCount;
+    uint8_t consecutiveTimeouts;
+
+    Histogram<8> offsetStats;             // |Versatz| je Abgleich [µs]
+    Histogram<8> delayStats;              // Laufzeit je Abgleich [µs]
+
+    void publish(const Discipline& next);
+    Discipline snapshot() const;
+    static int64_t epochAt(const Discipline& d, int64_t mono);
+    static int64_t slewApplied(int64_t slewUs, int64_t elapsedUs);
+
+    bool sendRequest(unsigned long now);
+    bool receiveResponse();
+    static void onPacket(void* arg, AsyncUDPPacket& packet);
+    void applyMeasurement(int64_t offsetUs, uint32_t delayUs, int64_t mono);
+
+public:
+    TimeService();
+
+    // Nicht blockierend, im Betrieb regelmäßig aufrufen (nur mit WLAN);
+    // true wenn eine Messung übernommen wurde
+    bool poll(unsigned long now);
+    // Nächste Anfrage sofort (z.B. nach einem Reconnect)
+    void requestSync();
+    // Wartet bis zur nächsten Messung, höchstens timeoutMs (setup(), Stromsparbetrieb)
+    bool syncBlocking(uint32_t timeoutMs);
+
+    static int64_t monotonicMicros() { return esp_timer_get_time(); }
+
+    bool isSynchronized() const { return snapshot().valid; }
+    // UTC in µs seit 1970; 0 solange nie synchronisiert
+    uint64_t nowEpochMicros() const;
+    uint64_t toEpochMicros(int64_t monoMicros) const;
+    unsigned long getEpochTime() const { return (unsigned long)(nowEpochMicros() / 1000000ULL); }
+    // "HH:MM:SS.mmm" mit Zeitzonen-Versatz; false solange nie synchronisiert
+    bool formatTime(char* output, size_t outputSize, long offsetSeconds) const;
+
+    // Letzte Messung und geschätzte Fehlerschranke der Uhr (RFC 5905:
+    // halbe Laufzeit + noch nicht eingeglittener Rest + 15 ppm seit dem Abgleich)
+    int64_t getOffsetMicros() const { return lastOffsetUs; }
+    uint32_t getDelayMicros() const { return lastDelayUs; }
+    uint32_t getErrorBoundMicros() const;
+    float getFrequencyPpm() const { return snapshot().freqPpb / 1000.0f; }
+    uint8_t getStratum() const { return lastStratum; }
+    uint32_t getSyncCount() const { return syncCount; }
+    uint32_t getStepCount() const { return stepCount; }
+    uint32_t getTimeoutCount() const { return timeoutCount; }
+    uint32_t getRejectedCount() const { return rejectedCount; }
+    const Histogram<8>& getOffsetStats() const { return offsetStats; }
+    const Histogram<8>& getDelayStats() const { return delayStats; }
+    void printStats() const;
+};
+
+#endif
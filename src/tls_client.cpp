@@ -0,0 +1,406 @@
+#include "tls_client.h"
+#include "config.h"
+#include "fnv1a.h"
+#include "rtc_cache.h"
+#include <mbedtls/error.h>
+#include <mbedtls/net_sockets.h>
+
+static const uint32_t SESSION_MAGIC = 0x544C5331;   // "TLS1"
+
+// ===== Session-Cache im RTC Slow Memory =====
+// Enthält das Master Secret der letzten Verbindung – nur für Wiederaufnahme
+// beim selben Host (Hash) verwenden.
+struct TlsSession {
+    uint32_t hostHash;
+    uint16_t length;
+    uint8_t data[TLS_SESSION_CACHE_SIZE];
+};
+
+RTC_CACHE_ATTR static RtcCache<TlsSession, SESSION_MAGIC> sessionCache;
+
+TlsClient::TlsClient()
+    : caCert(nullptr), clientCert(nullptr), clientKey(nullptr), configured(false), open(false),
+      peekByte(-1), handshakeTimeoutMs(TLS_HANDSHAKE_TIMEOUT_MS), resumptionEnabled(TLS_SESSION_RESUMPTION),
+      resumeRejected(0), sessionsStored(0), lastResumed(false), lastError(0) {
+    memset(&fullStats, 0, sizeof(fullStats));
+    memset(&resumedStats, 0, sizeof(resumedStats));
+    mbedtls_ssl_init(&ssl);
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_x509_crt_init(&caChain);
+    mbedtls_x509_crt_init(&ownCert);
+    mbedtls_pk_init(&ownKey);
+}
+
+TlsClient::~TlsClient() {
+    stop();
+    mbedtls_pk_free(&ownKey);
+    mbedtls_x509_crt_free(&ownCert);
+    mbedtls_x509_crt_free(&caChain);
+    mbedtls_entropy_free(&entropy);
+    mbedtls_ctr_drbg_free(&drbg);
+    mbedtls_ssl_config_free(&conf);
+}
+
+void TlsClient::setCACert(const char* rootCA) {
+    caCert = rootCA;
+    configured = false;
+}
+
+void TlsClient::setCertificate(const char* cert) {
+    clientCert = cert;
+    configured = false;
+}
+
+void TlsClient::setPrivateKey(const char* key) {
+    clientKey = key;
+    configured = false;
+}
+
+void TlsClient::clearSessionCache() {
+    sessionCache.invalidate();
+    sessionCache->length = 0;
+}
+
+// ===== Konfiguration (einmalig) =====
+// CA-Kette parsen und DRBG seeden kostet bei jedem Verbindungsaufbau
+// Zeit; beides bleibt daher über Reconnects hinweg bestehen
+bool TlsClient::setupConfig() {
+    if (configured) {
+        return true;
+    }
+    if (!caCert) {
+        lastError = MBEDTLS_ERR_X509_CERT_VERIFY_FAILED;   // Ohne Root-CA keine Verbindung
+        return false;
+    }
+
+    mbedtls_pk_free(&ownKey);
+    mbedtls_x509_crt_free(&ownCert);
+    mbedtls_x509_crt_free(&caChain);
+    mbedtls_ssl_config_free(&conf);
+    mbedtls_ctr_drbg_free(&drbg);
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_x509_crt_init(&caChain);
+    mbedtls_x509_crt_init(&ownCert);
+    mbedtls_pk_init(&ownKey);
+
+    static const char PERSONALIZATION[] = "tls_client";
+    int ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy,
+                                    (const unsigned char*)PERSONALIZATION, sizeof(PERSONALIZATION) - 1);
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        // PEM: Länge inkl. Null-Terminator
+        ret = mbedtls_x509_crt_parse(&caChain, (const unsigned char*)caCert, strlen(caCert) + 1);
+    }
+    if (ret == 0 && clientCert && clientKey) {
+        ret = mbedtls_x509_crt_parse(&ownCert, (const unsigned char*)clientCert, strlen(clientCert) + 1);
+        if (ret == 0) {
+            ret = mbedtls_pk_parse_key(&ownKey, (const unsigned char*)clientKey, strlen(clientKey) + 1,
+                                       nullptr, 0);
+        }
+        if (ret == 0) {
+            ret = mbedtls_ssl_conf_own_cert(&conf, &ownCert, &ownKey);
+        }
+    }
+    if (ret != 0) {
+        lastError = ret;
+        return false;
+    }
+
+    mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ca_chain(&conf, &caChain, nullptr);
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+    mbedtls_ssl_conf_session_tickets(&conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+    configured = true;
+    return true;
+}
+
+// ===== Session aus dem RTC-Cache anbieten =====
+bool TlsClient::offerCachedSession(const char* host) {
+    if (!sessionCache.valid() || sessionCache->hostHash != fnv1a(host) ||
+        sessionCache->length == 0 || sessionCache->length > sizeof(sessionCache->data)) {
+        return false;
+    }
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    int ret = mbedtls_ssl_session_load(&session, sessionCache->data, sessionCache->length);
+    if (ret == 0) {
+        ret = mbedtls_ssl_set_session(&ssl, &session);
+    }
+    mbedtls_ssl_session_free(&session);
+
+    if (ret != 0) {
+        // Z.B. andere mbedTLS-Konfiguration nach einem Firmware-Update
+        clearSessionCache();
+        return false;
+    }
+    return true;
+}
+
+// ===== Session nach dem Handshake sichern =====
+// Auch nach einer Wiederaufnahme: der Server kann ein neues Ticket ausgeben
+void TlsClient::storeSession(const char* host) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    size_t length = 0;
+    int ret = mbedtls_ssl_get_session(&ssl, &session);
+    if (ret == 0) {
+        ret = mbedtls_ssl_session_save(&session, sessionCache->data, sizeof(sessionCache->data), &length);
+    }
+    mbedtls_ssl_session_free(&session);
+
+    if (ret != 0) {
+        // MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL: TLS_SESSION_CACHE_SIZE erhöhen (length = benötigt)
+        clearSessionCache();
+        return;
+    }
+    sessionCache->hostHash = fnv1a(host);
+    sessionCache->length = (uint16_t)length;
+    sessionCache.commit();
+    sessionsStored++;
+}
+
+void TlsClient::recordHandshake(bool resumed, uint32_t durationMs, uint32_t peakHeapBytes) {
+    TlsHandshakeStats& stats = resumed ? resumedStats : fullStats;
+    stats.count++;
+    stats.lastMs = durationMs;
+    stats.totalMs += durationMs;
+    if (durationMs > stats.maxMs) {
+        stats.maxMs = durationMs;
+    }
+    stats.lastPeakHeapBytes = peakHeapBytes;
+    if (peakHeapBytes > stats.maxPeakHeapBytes) {
+        stats.maxPeakHeapBytes = peakHeapBytes;
+    }
+    lastResumed = resumed;
+}
+
+// ===== Verbindungsaufbau =====
+int TlsClient::connect(IPAddress ip, uint16_t port) {
+    // Zertifikatsprüfung und SNI brauchen den Hostnamen
+    (void)ip;
+    (void)port;
+    lastError = MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    return 0;
+}
+
+int TlsClient::connect(const char* host, uint16_t port) {
+    stop();
+    lastResumed = false;
+    if (!setupConfig()) {
+        return 0;
+    }
+    if (!tcp.connect(host, port)) {
+        lastError = MBEDTLS_ERR_NET_CONNECT_FAILED;
+        return 0;
+    }
+
+    // Heap-Spitze: freier Heap nach jedem Handshake-Schritt (die großen
+    // Allokationen – Puffer, Zertifikatskette, ECDHE – leben jeweils
+    // mindestens bis zum Ende ihres Schritts)
+    uint32_t heapBefore = ESP.getFreeHeap();
+    uint32_t minHeap = heapBefore;
+    unsigned long start = millis();
+
+    int ret = mbedtls_ssl_setup(&ssl, &conf);
+    if (ret == 0) {
+        ret = mbedtls_ssl_set_hostname(&ssl, host);
+    }
+    if (ret != 0) {
+        lastError = ret;
+        stop();
+        return 0;
+    }
+    mbedtls_ssl_set_bio(&ssl, &tcp, bioSend, bioRecv, nullptr);
+
+    bool offered = resumptionEnabled && offerCachedSession(host);
+    bool keyExchange = false;   // Nur der vollständige Handshake durchläuft den Schlüsselaustausch
+
+    while (ssl.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        ret = mbedtls_ssl_handshake_step(&ssl);
+        uint32_t freeHeap = ESP.getFreeHeap();
+        if (freeHeap < minHeap) {
+            minHeap = freeHeap;
+        }
+        if (ssl.state == MBEDTLS_SSL_CLIENT_KEY_EXCHANGE) {
+            keyExchange = true;
+        }
+        if (ret == 0) {
+            continue;
+        }
+        if ((ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) &&
+            millis() - start < handshakeTimeoutMs) {
+            delay(1);   // Auf Daten vom Server warten
+            continue;
+        }
+
+        lastError = ret;
+        if (offered) {
+            clearSessionCache();   // Angebotene Session nicht noch einmal versuchen
+        }
+        stop();
+        return 0;
+    }
+
+    bool resumed = offered && !keyExchange;
+    if (offered && !resumed) {
+        resumeRejected++;   // Ticket abgelaufen oder Server ohne Session-Cache
+    }
+    open = true;
+    lastError = 0;
+    recordHandshake(resumed, millis() - start, heapBefore - minHeap);
+
+    if (resumptionEnabled) {
+        storeSession(host);
+    }
+    return 1;
+}
+
+void TlsClient::closeSession() {
+    mbedtls_ssl_free(&ssl);   // Gibt die Ein-/Ausgabepuffer frei
+    mbedtls_ssl_init(&ssl);
+}
+
+void TlsClient::stop() {
+    if (open) {
+        mbedtls_ssl_close_notify(&ssl);
+        open = false;
+    }
+    closeSession();
+    tcp.stop();
+    peekByte = -1;
+}
+
+uint8_t TlsClient::connected() {
+    if (!open) {
+        return 0;
+    }
+    return tcp.connected() || available() > 0;
+}
+
+// ===== Datenübertragung =====
+size_t TlsClient::write(const uint8_t* buf, size_t size) {
+    if (!open) {
+        return 0;
+    }
+
+    size_t written = 0;
+    unsigned long start = millis();
+    while (written < size) {
+        int ret = mbedtls_ssl_write(&ssl, buf + written, size - written);
+        if (ret > 0) {
+            written += ret;
+        } else if ((ret == MBEDTLS_ERR_SSL_WANT_WRITE || ret == MBEDTLS_ERR_SSL_WANT_READ) &&
+                   millis() - start < handshakeTimeoutMs) {
+            delay(1);
+        } else {
+            lastError = ret;
+            stop();
+            break;
+        }
+    }
+    return written;
+}
+
+int TlsClient::available() {
+    if (!open) {
+        return 0;
+    }
+
+    // Ankommenden Record entschlüsseln, ohne Daten zu entnehmen
+    if (mbedtls_ssl_get_bytes_avail(&ssl) == 0 && tcp.available() > 0) {
+        int ret = mbedtls_ssl_read(&ssl, nullptr, 0);
+        if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+            lastError = ret;   // Auch MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY
+            stop();
+            return 0;
+        }
+    }
+    return (peekByte >= 0 ? 1 : 0) + (int)mbedtls_ssl_get_bytes_avail(&ssl);
+}
+
+int TlsClient::read(uint8_t* buf, size_t size) {
+    if (!open || size == 0) {
+        return -1;
+    }
+
+    size_t offset = 0;
+    if (peekByte >= 0) {
+        buf[offset++] = (uint8_t)peekByte;
+        peekByte = -1;
+        if (offset == size) {
+            return (int)offset;
+        }
+    }
+
+    int ret = mbedtls_ssl_read(&ssl, buf + offset, size - offset);
+    if (ret > 0) {
+        return (int)offset + ret;
+    }
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+        lastError = ret;   // 0 = Verbindung geschlossen
+        stop();
+    }
+    return offset > 0 ? (int)offset : -1;
+}
+
+int TlsClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int TlsClient::peek() {
+    if (peekByte < 0) {
+        uint8_t c;
+        if (read(&c, 1) == 1) {
+            peekByte = c;
+        }
+    }
+    return peekByte;
+}
+
+// ===== BIO-Callbacks: TLS-Records über die TCP-Verbindung =====
+int TlsClient::bioSend(void* context, const unsigned char* buffer, size_t length) {
+    WiFiClient* tcp = (WiFiClient*)context;
+    if (!tcp->connected()) {
+        return MBEDTLS_ERR_NET_CONN_RESET;
+    }
+    size_t written = tcp->write(buffer, length);
+    return written > 0 ? (int)written : MBEDTLS_ERR_SSL_WANT_WRITE;
+}
+
+int TlsClient::bioRecv(void* context, unsigned char* buffer, size_t length) {
+    WiFiClient* tcp = (WiFiClient*)context;
+    int available = tcp->available();
+    if (available <= 0) {
+        return tcp->connected() ? MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_NET_CONN_RESET;
+    }
+    if ((size_t)available < length) {
+        length = available;
+    }
+    int received = tcp->read(buffer, length);
+    return received > 0 ? received : MBEDTLS_ERR_SSL_WANT_READ;
+}
+
+// ===== Ausgabe der Messwerte =====
+void TlsClient::printStats() const {
+    Serial.println("--- TLS-Handshakes ---");
+    Serial.printf("  Vollständig:  %4lu x, Ø %5lu ms (max. %5lu ms), Heap-Spitze max. %6lu Bytes\n",
+                  (unsigned long)fullStats.count,
+                  (unsigned long)(fullStats.count ? fullStats.totalMs / fullStats.count : 0),
+                  (unsigned long)fullStats.maxMs, (unsigned long)fullStats.maxPeakHeapBytes);
+    Serial.printf("  Fortgesetzt:  %4lu x, Ø %5lu ms (max. %5lu ms), Heap-Spitze max. %6lu Bytes\n",
+                  (unsigned long)resumedStats.count,
+                  (unsigned long)(resumedStats.count ? resumedStats.totalMs / resumedStats.count : 0),
+                  (unsigned long)resumedStats.maxMs, (unsigned long)resumedStats.maxPeakHeapBytes);
+    Serial.printf("  Abgelehnt: %lu, Session-Cache: %u/%u Bytes\n",
+                  (unsigned long)resumeRejected,
+                  sessionCache.valid() ? (unsigned)sessionCache->length : 0u,
+                  (unsigned)sizeof(sessionCache->data));
+}
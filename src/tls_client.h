@@ -0,0 +1,107 @@
+#ifndef TLS_CLIENT_H
+#define TLS_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/x509_crt.h>
+#include <mbedtls/pk.h>
+
+// Messwerte je Handshake-Art (vollständig bzw. fortgesetzt)
+struct TlsHandshakeStats {
+    uint32_t count;
+    uint32_t lastMs;
+    uint32_t totalMs;
+    uint32_t maxMs;
+    uint32_t lastPeakHeapBytes;   // Heap-Verbrauch (Spitze) des letzten Handshakes
+    uint32_t maxPeakHeapBytes;
+};
+
+// ===== TLS-Client mit Session-Wiederaufnahme =====
+// Ersetzt WiFiClientSecure für die MQTT-Verbindung. Nach jedem Handshake
+// wird die Session (Ticket bzw. Session-ID inkl. Master Secret) mit
+// mbedtls_ssl_session_save() im RTC-Speicher abgelegt; der nächste
+// Verbindungsaufbau – auch nach Deep Sleep – bietet sie dem Server an.
+// Nimmt der Server sie an, entfallen Zertifikatsprüfung und ECDHE
+// (abgekürzter Handshake, eine Round-Trip weniger).
+//
+// Der Handshake läuft schrittweise (mbedtls_ssl_handshake_step), damit
+// zwischen den Schritten die Dauer und der freie Heap gemessen werden können.
+// CA-Kette, Konfiguration und Zufallsgenerator werden nur einmal aufgebaut;
+// die Ein-/Ausgabepuffer (ca. 20 KB) nur solange die Verbindung steht.
+class TlsClient : public Client {
+private:
+    WiFiClient tcp;
+    mbedtls_ssl_context ssl;
+    mbedtls_ssl_config conf;
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_entropy_context entropy;
+    mbedtls_x509_crt caChain;
+    mbedtls_x509_crt ownCert;
+    mbedtls_pk_context ownKey;
+
+    const char* caCert;
+    const char* clientCert;
+    const char* clientKey;
+    bool configured;           // conf/drbg/CA aufgebaut
+    bool open;                 // Handshake abgeschlossen, Verbindung steht
+    int peekByte;              // Für peek(); -1 = leer
+    unsigned long handshakeTimeoutMs;
+    bool resumptionEnabled;
+
+    TlsHandshakeStats fullStats;
+    TlsHandshakeStats resumedStats;
+    uint32_t resumeRejected;   // Gespeicherte Session angeboten, Server wollte neu
+    uint32_t sessionsStored;
+    bool lastResumed;
+    int lastError;
+
+    static int bioSend(void* context, const unsigned char* buffer, size_t length);
+    static int bioRecv(void* context, unsigned char* buffer, size_t length);
+
+    bool setupConfig();
+    bool offerCachedSession(const char* host);
+    void storeSession(const char* host);
+    void recordHandshake(bool resumed, uint32_t durationMs, uint32_t peakHeapBytes);
+    void closeSession();
+
+public:
+    TlsClient();
+    ~TlsClient();
+
+    // Wie WiFiClientSecure; Zeiger müssen gültig bleiben
+    void setCACert(const char* rootCA);
+    void setCertificate(const char* cert);
+    void setPrivateKey(const char* key);
+    void setHandshakeTimeout(unsigned long seconds) { handshakeTimeoutMs = seconds * 1000UL; }
+
+    void setSessionResumption(bool enable) { resumptionEnabled = enable; }
+    static void clearSessionCache();   // Z.B. nach Wechsel des Servers
+
+    // Client
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return connected(); }
+
+    // Instrumentierung
+    const TlsHandshakeStats& getFullStats() const { return fullStats; }
+    const TlsHandshakeStats& getResumedStats() const { return resumedStats; }
+    uint32_t getResumeRejectedCount() const { return resumeRejected; }
+    uint32_t getSessionsStored() const { return sessionsStored; }
+    bool wasResumed() const { return lastResumed; }
+    int getLastError() const { return lastError; }
+    void printStats() const;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#include "vibration.h"
+
+// Konstruktor: Hann-Fenster einmalig vorberechnen
+VibrationAnalyzer::VibrationAnalyzer()
+    : hannPower(0.0f), fill(0), rateHz(0), windowsPerReport(1),
+      handler(nullptr), handlerContext(nullptr), windowCount(0), lastAnalysisMicros(0) {
+    for (size_t n = 0; n < WINDOW_SIZE; n++) {
+        hann[n] = 0.5f - 0.5f * (float)cos(2.0 * M_PI * n / WINDOW_SIZE);
+        hannPower += hann[n] * hann[n];
+    }
+    resetReport();
+}
+
+void VibrationAnalyzer::begin(uint16_t reportWindows) {
+    windowsPerReport = reportWindows > 0 ? reportWindows : 1;
+    fill = 0;
+    resetReport();
+}
+
+void VibrationAnalyzer::onReport(ReportHandler callback, void* context) {
+    handler = callback;
+    handlerContext = context;
+}
+
+void VibrationAnalyzer::resetReport() {
+    memset(&report, 0, sizeof(report));
+    report.windowSize = WINDOW_SIZE;
+}
+
+void VibrationAnalyzer::blockHandler(const MotionBlock& block, void* context) {
+    ((VibrationAnalyzer*)context)->addBlock(block);
+}
+
+// ===== Werte aus einem FIFO-Block übernehmen =====
+void VibrationAnalyzer::addBlock(const MotionBlock& block) {
+    // Neue Abtastrate: angefangenes Fenster und Bericht passen nicht mehr
+    if (block.rateHz != rateHz) {
+        rateHz = block.rateHz;
+        fill = 0;
+        resetReport();
+    }
+
+    for (size_t i = 0; i < block.count; i++) {
+        window[0][fill] = block.samples[i][0];
+        window[1][fill] = block.samples[i][1];
+        window[2][fill] = block.samples[i][2];
+
+        if (++fill == WINDOW_SIZE) {
+            report.endMicros = block.firstSampleMicros + (int64_t)i * 1000000 / block.rateHz;
+            analyzeWindow();
+            fill = 0;
+        }
+    }
+}
+
+// ===== Fenster auswerten und ggf. Bericht ausgeben =====
+void VibrationAnalyzer::analyzeWindow() {
+    uint32_t start = micros();
+
+    for (size_t axis = 0; axis < 3; axis++) {
+        AxisFeatures features;
+        analyzeAxis(axis, features);
+
+        // RMS als Summe der Quadrate, Maxima direkt (siehe VibrationFeatures)
+        AxisFeatures& sum = report.axes[axis];
+        sum.rms += features.rms * features.rms;
+        if (features.peakToPeak > sum.peakToPeak) sum.peakToPeak = features.peakToPeak;
+        if (features.crest > sum.crest) sum.crest = features.crest;
+        for (size_t b = 0; b < BAND_COUNT; b++) {
+            sum.bandEnergy[b] += features.bandEnergy[b];
+        }
+    }
+
+    windowCount++;
+    report.windows++;
+    report.rateHz = rateHz;
+    report.endMillis = millis();
+    lastAnalysisMicros = micros() - start;
+
+    if (report.windows >= windowsPerReport) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            AxisFeatures& sum = report.axes[axis];
+            sum.rms = sqrtf(sum.rms / report.windows);
+            for (size_t b = 0; b < BAND_COUNT; b++) {
+                sum.bandEnergy[b] /= report.windows;
+            }
+        }
+        if (handler) {
+            handler(report, handlerContext);
+        }
+        resetReport();
+    }
+}
+
+// ===== Kennwerte einer Achse =====
+void VibrationAnalyzer::analyzeAxis(size_t axis, AxisFeatures& features) {
+    const int16_t* raw = window[axis];
+    const float scale = 1.0f / MPU9250Stream::ACCEL_LSB_PER_G;
+
+    // Gleichanteil (Erdbeschleunigung, Offset) und Extremwerte
+    int32_t sum = 0;
+    int16_t minimum = raw[0];
+    int16_t maximum = raw[0];
+    for (size_t n = 0; n < WINDOW_SIZE; n++) {
+        sum += raw[n];
+        if (raw[n] < minimum) minimum = raw[n];
+        if (raw[n] > maximum) maximum = raw[n];
+    }
+    float mean = (float)sum / WINDOW_SIZE;
+
+    // Zeitbereich: RMS und Spitze ohne Gleichanteil; gleichzeitig FFT-Eingang
+    float sumSquares = 0.0f;
+    float peak = 0.0f;
+    for (size_t n = 0; n < WINDOW_SIZE; n++) {
+        float value = ((float)raw[n] - mean) * scale;
+        sumSquares += value * value;
+        if (fabsf(value) > peak) peak = fabsf(value);
+        re[n] = value * hann[n];
+        im[n] = 0.0f;
+    }
+    features.rms = sqrtf(sumSquares / WINDOW_SIZE);
+    features.peakToPeak = (float)(maximum - minimum) * scale;
+    features.crest = features.rms > 0.0f ? peak / features.rms : 0.0f;
+
+    // Frequenzbereich: einseitiges Leistungsspektrum, so skaliert, dass die
+    // Summe über alle Bänder etwa dem RMS² entspricht (Parseval)
+    fft.transform(re, im);
+
+    const size_t bins = WINDOW_SIZE / 2;
+    const float normalization = 2.0f / (WINDOW_SIZE * hannPower);
+    for (size_t b = 0; b < BAND_COUNT; b++) {
+        features.bandEnergy[b] = 0.0f;
+    }
+    for (size_t k = 1; k < bins; k++) {     // k = 0 ist der Gleichanteil
+        float power = (re[k] * re[k] + im[k] * im[k]) * normalization;
+        features.bandEnergy[k * BAND_COUNT / bins] += power;
+    }
+}
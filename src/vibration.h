@@ -0,0 +1,82 @@
+#ifndef VIBRATION_H
+#define VIBRATION_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "fft.h"
+#include "mpu_stream.h"
+
+// ===== Schwingungskennwerte einer Achse =====
+struct AxisFeatures {
+    float rms;                                  // Effektivwert ohne Gleichanteil [g]
+    float peakToPeak;                           // Spitze-Spitze [g]
+    float crest;                                // Scheitelfaktor |Spitze| / RMS
+    float bandEnergy[VIBRATION_BAND_COUNT];     // Mittlere Leistung pro Band [g²]
+};
+
+// ===== Bericht über mehrere Analysefenster =====
+// RMS und Bandenergien gemittelt (Welch), Spitze-Spitze und Scheitelfaktor
+// als Maximum, damit kurze Stöße nicht herausgemittelt werden
+struct VibrationFeatures {
+    uint32_t endMillis;        // millis() am Ende des letzten Fensters
+    int64_t endMicros;         // esp_timer-Zeit des letzten Fensterwerts (aus dem FIFO)
+    uint64_t endEpochMicros;   // UTC dazu, setzt der Empfänger (0 = Uhr nicht gestellt)
+    uint16_t rateHz;           // Abtastrate
+    uint16_t windowSize;       // Werte pro Fenster
+    uint16_t windows;          // Anzahl gemittelter Fenster
+    AxisFeatures axes[3];      // X, Y, Z der Beschleunigung
+};
+
+// ===== Schwingungsanalyse =====
+// Sammelt die Beschleunigungswerte aus den FIFO-Blöcken in Fenster zu
+// VIBRATION_WINDOW_SIZE Werten, berechnet pro Achse RMS, Spitze-Spitze,
+// Scheitelfaktor und die Energie in VIBRATION_BAND_COUNT gleich breiten
+// Frequenzbändern (Hann-Fenster + Radix-2 FFT). Alle Puffer sind
+// Member-Arrays, zur Laufzeit wird nichts allokiert.
+class VibrationAnalyzer {
+public:
+    typedef void (*ReportHandler)(const VibrationFeatures& features, void* context);
+
+    static const size_t WINDOW_SIZE = VIBRATION_WINDOW_SIZE;
+    static const size_t BAND_COUNT = VIBRATION_BAND_COUNT;
+
+private:
+    RadixTwoFft<WINDOW_SIZE> fft;
+    float hann[WINDOW_SIZE];
+    float hannPower;                    // Summe w², für Parseval-Skalierung
+    float re[WINDOW_SIZE];
+    float im[WINDOW_SIZE];
+
+    int16_t window[3][WINDOW_SIZE];     // Rohwerte des laufenden Fensters
+    size_t fill;
+    uint16_t rateHz;
+
+    VibrationFeatures report;           // Wird über mehrere Fenster aufsummiert
+    uint16_t windowsPerReport;
+
+    ReportHandler handler;
+    void* handlerContext;
+
+    uint32_t windowCount;
+    uint32_t lastAnalysisMicros;        // Rechenzeit des letzten Fensters
+
+    void resetReport();
+    void analyzeWindow();
+    void analyzeAxis(size_t axis, AxisFeatures& features);
+
+public:
+    VibrationAnalyzer();
+
+    void begin(uint16_t reportWindows);
+    void onReport(ReportHandler callback, void* context = nullptr);
+
+    void addBlock(const MotionBlock& block);
+
+    // Passend als MPU9250Stream::BlockHandler (context = VibrationAnalyzer*)
+    static void blockHandler(const MotionBlock& block, void* context);
+
+    uint32_t getWindowCount() const { return windowCount; }
+    uint32_t getLastAnalysisMicros() const { return lastAnalysisMicros; }
+};
+
+#endif
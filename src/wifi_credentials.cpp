@@ -0,0 +1,118 @@
+#include "wifi_credentials.h"
+#include <Preferences.h>
+#include "fnv1a.h"
+
+static const char* NVS_NAMESPACE = "wifi";
+
+WifiCredentials::WifiCredentials() : count(0) {
+    memset(entries, 0, sizeof(entries));
+}
+
+// FNV-1a, reicht zur Unterscheidung der SSIDs
+uint32_t WifiCredentials::hash(const char* ssid) {
+    return fnv1a(ssid);
+}
+
+bool WifiCredentials::begin() {
+    Preferences prefs;
+    count = 0;
+    
+    if (prefs.begin(NVS_NAMESPACE, true)) {
+        uint8_t stored = prefs.getUChar("count", 0);
+        char key[8];
+        for (uint8_t i = 0; i < stored && count < WIFI_MAX_CREDENTIALS; i++) {
+            WifiCredential& entry = entries[count];
+            snprintf(key, sizeof(key), "ssid%u", i);
+            if (prefs.getString(key, entry.ssid, sizeof(entry.ssid)) == 0) {
+                continue;
+            }
+            snprintf(key, sizeof(key), "pass%u", i);
+            if (prefs.getString(key, entry.password, sizeof(entry.password)) == 0) {
+                entry.password[0] = '\0';   // Offenes Netz
+            }
+            entry.ssidHash = hash(entry.ssid);
+            count++;
+        }
+        prefs.end();
+    }
+    
+    if (count == 0) {
+        Serial.println("WLAN-Zugangsdaten: NVS leer, übernehme config.h");
+        return add(WIFI_SSID, WIFI_PASSWORD);
+    }
+    Serial.printf("WLAN-Zugangsdaten: %u Netz(e) aus NVS\n", (unsigned)count);
+    return true;
+}
+
+bool WifiCredentials::save() const {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        return false;
+    }
+    
+    prefs.clear();
+    char key[8];
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        snprintf(key, sizeof(key), "ssid%u", (unsigned)i);
+        ok = prefs.putString(key, entries[i].ssid) > 0 && ok;
+        snprintf(key, sizeof(key), "pass%u", (unsigned)i);
+        prefs.putString(key, entries[i].password);
+    }
+    ok = prefs.putUChar("count", (uint8_t)count) == 1 && ok;
+    prefs.end();
+    return ok;
+}
+
+bool WifiCredentials::add(const char* ssid, const char* password) {
+    if (ssid == nullptr || ssid[0] == '\0' || strlen(ssid) >= sizeof(entries[0].ssid) ||
+        (password != nullptr && strlen(password) >= sizeof(entries[0].password))) {
+        return false;
+    }
+    
+    int index = find(ssid);
+    if (index < 0) {
+        if (count >= WIFI_MAX_CREDENTIALS) {
+            return false;
+        }
+        index = (int)count++;
+    }
+    
+    WifiCredential& entry = entries[index];
+    memset(&entry, 0, sizeof(entry));
+    strcpy(entry.ssid, ssid);
+    strcpy(entry.password, password ? password : "");
+    entry.ssidHash = hash(ssid);
+    return save();
+}
+
+bool WifiCredentials::remove(const char* ssid) {
+    int index = find(ssid);
+    if (index < 0) {
+        return false;
+    }
+    for (size_t i = (size_t)index; i + 1 < count; i++) {
+        entries[i] = entries[i + 1];
+    }
+    count--;
+    memset(&entries[count], 0, sizeof(entries[count]));
+    return save();
+}
+
+int WifiCredentials::find(const char* ssid) const {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(entries[i].ssid, ssid) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+int WifiCredentials::findByHash(uint32_t ssidHash) const {
+    for (size_t i = 0; i < count; i++) {
+        if (entries[i].ssidHash == ssidHash) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,42 @@
+#ifndef WIFI_CREDENTIALS_H
+#define WIFI_CREDENTIALS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+struct WifiCredential {
+    char ssid[33];        // 802.11: max. 32 Zeichen
+    char password[65];    // WPA2-PSK: max. 63 Zeichen bzw. 64 Hex
+    uint32_t ssidHash;    // FNV-1a, Verweis aus dem RTC-Speicher
+};
+
+// ===== WLAN-Zugangsdaten im NVS =====
+// Liste bekannter Netze (Namensraum "wifi"). Beim ersten Start wird sie mit
+// WIFI_SSID/WIFI_PASSWORD aus config.h angelegt, danach per C2D gepflegt:
+//   {"wifi":{"add":{"ssid":"Lager-2","password":"..."}}}
+//   {"wifi":{"remove":"Lager-2"}}
+class WifiCredentials {
+private:
+    WifiCredential entries[WIFI_MAX_CREDENTIALS];
+    size_t count;
+    
+    bool save() const;
+    
+public:
+    WifiCredentials();
+    
+    bool begin();   // Aus dem NVS laden; leer -> Eintrag aus config.h
+    
+    // Vorhandene SSID wird überschrieben; false wenn voll oder ungültig
+    bool add(const char* ssid, const char* password);
+    bool remove(const char* ssid);
+    
+    int find(const char* ssid) const;
+    int findByHash(uint32_t ssidHash) const;
+    size_t size() const { return count; }
+    const WifiCredential& get(size_t index) const { return entries[index]; }
+    
+    static uint32_t hash(const char* ssid);
+};
+
+#endif
@@ -2,15 +2,46 @@
 #include <WiFi.h>
 #include "wifi_setup.h"
 #include "config.h"
+#include "rtc_cache.h"
+
+static const uint32_t CACHE_MAGIC = 0x57494649;   // "WIFI"
+
+// ===== Verbindungsdaten im RTC Slow Memory =====
+// Verweist über den SSID-Hash auf die Zugangsdaten; wird das Netz aus der
+// Liste entfernt, ist der Eintrag wertlos.
+struct WifiRtcCache {
+    uint32_t ssidHash;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t ipReuseCount;   // Verbindungen ohne DHCP seit der letzten Lease
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t netmask;
+    uint32_t dns;
+};
+
+RTC_CACHE_ATTR static RtcCache<WifiRtcCache, CACHE_MAGIC> wifiCache;
+
+WifiManager* WifiManager::eventTarget = nullptr;
 
 // Konstruktor: Initialisiert alle Variablen mit Standardwerten
-WifiManager::WifiManager() : timeClient(nullptr), wifiConnected(false), ntpInitialized(false), lastReconnectAttempt(0) {
+WifiManager::WifiManager() : wifiConnected(false), linkState(WIFI_LINK_DOWN), attemptStartMs(0),
+                             connectStartMs(0), fastAttempt(false), cachedIpAttempt(false),
+                             reconnect(RECONNECT_BASE_DELAY_MS, WIFI_RECONNECT_MAX_DELAY_MS),
+                             nextCandidate(0), scannedThisCycle(false), cycleScanPending(false),
+                             attemptSsidHash(0), lastRoamCheckMs(0), lastRoamScanMs(0),
+                             roamScanPending(false), roamScans(0), roamCount(0),
+                             eventBits(0), disconnectReason(0), eventChannel(0), eventIp(0),
+                             eventGateway(0), eventNetmask(0),
+                             fastConnectMs(125), fullConnectMs(125), fastFallbacks(0) {
+    memset(eventBssid, 0, sizeof(eventBssid));
+    memset(attemptBssid, 0, sizeof(attemptBssid));
 }
 
-// Destruktor: Gibt den Speicher des NTP-Clients frei
+// Destruktor: Ereignis-Handler abmelden
 WifiManager::~WifiManager() {
-    if (timeClient != nullptr) {
-        delete timeClient;
+    if (eventTarget == this) {
+        eventTarget = nullptr;
     }
 }
 
@@ -23,32 +54,252 @@ bool WifiManager::begin() {
     // Automatische Wiederverbindung bei Verbindungsverlust aktivieren
     WiFi.setAutoReconnect(true);
     
+    // Ereignis-Handler nur einmal registrieren (bleibt im WLAN-Stack bestehen)
+    if (eventTarget == nullptr) {
+        WiFi.onEvent(onWifiEvent);
+    }
+    eventTarget = this;
+    
+    // Bekannte Netze aus dem NVS (beim ersten Start aus config.h)
+    credentials.begin();
+    
     // Verbindungsaufbau starten
     return connect();
 }
 
-// Stellt die Verbindung zum WLAN her
-bool WifiManager::connect() {
-    Serial.print("Verbinde mit WLAN: ");
-    Serial.println(WIFI_SSID);
+// ===== WLAN-Ereignisse =====
+// Läuft im Event-Task des WLAN-Stacks: nur Daten übernehmen und Bits setzen,
+// ausgewertet wird in pollAttempt()/handleReconnect()
+void WifiManager::onWifiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    WifiManager* self = eventTarget;
+    if (self == nullptr) {
+        return;
+    }
+    
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            memcpy(self->eventBssid, info.wifi_sta_connected.bssid, sizeof(self->eventBssid));
+            self->eventChannel = info.wifi_sta_connected.channel;
+            __atomic_fetch_or(&self->eventBits, EVENT_CONNECTED, __ATOMIC_RELEASE);
+            break;
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            self->eventIp = info.got_ip.ip_info.ip.addr;
+            self->eventGateway = info.got_ip.ip_info.gw.addr;
+            self->eventNetmask = info.got_ip.ip_info.netmask.addr;
+            __atomic_fetch_or(&self->eventBits, EVENT_GOT_IP, __ATOMIC_RELEASE);
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            self->disconnectReason = info.wifi_sta_disconnected.reason;
+            __atomic_fetch_or(&self->eventBits, EVENT_DISCONNECTED, __ATOMIC_RELEASE);
+            break;
+        default:
+            break;
+    }
+}
+
+uint32_t WifiManager::takeEvents() {
+    return __atomic_exchange_n(&eventBits, 0, __ATOMIC_ACQUIRE);
+}
+
+bool WifiManager::hasCachedConnection() const {
+    return wifiCache.valid() && credentials.findByHash(wifiCache->ssidHash) >= 0;
+}
+
+void WifiManager::clearConnectionCache() {
+    memset(&wifiCache, 0, sizeof(wifiCache));
+    ApSelector::clearState();
+}
+
+// Neuen Verbindungsaufbau beginnen: zuerst der letzte AP aus dem Cache
+// (falls erlaubt), sonst gleich die Kandidaten bzw. ein Scan
+void WifiManager::beginCycle(unsigned long now, bool useCache) {
+    nextCandidate = 0;
+    scannedThisCycle = false;
+    cycleScanPending = false;
+    attemptSsidHash = 0;
+    memset(attemptBssid, 0, sizeof(attemptBssid));
+    selector.rank();   // Fehlschläge des letzten Aufbaus berücksichtigen
+    
+    if (WIFI_FAST_RECONNECT && useCache && hasCachedConnection()) {
+        const WifiCredential& credential = credentials.get(credentials.findByHash(wifiCache->ssidHash));
+        startAttempt(now, credential, wifiCache->bssid, wifiCache->channel, true);
+        return;
+    }
+    if (!advanceCycle(now)) {
+        attemptStartMs = now;
+        linkState = WIFI_LINK_CONNECTING;   // pollAttempt() meldet den Fehlschlag
+    }
+}
+
+// Nächsten Schritt des Aufbaus auslösen: nächster Kandidat, der nicht schon
+// als Cache-Eintrag probiert wurde, sonst einmalig ein Scan. false wenn
+// nichts mehr übrig ist.
+bool WifiManager::advanceCycle(unsigned long now) {
+    while (nextCandidate < selector.candidateCount()) {
+        const ApCandidate& candidate = selector.candidate(nextCandidate++);
+        int credential = credentials.findByHash(candidate.ssidHash);
+        if (credential < 0 || memcmp(candidate.bssid, attemptBssid, 6) == 0) {
+            continue;   // Netz entfernt bzw. eben schon erfolglos versucht
+        }
+        startAttempt(now, credentials.get(credential), candidate.bssid, candidate.channel, false);
+        return true;
+    }
+    
+    if (scannedThisCycle || credentials.size() == 0) {
+        return false;
+    }
+    WiFi.disconnect();
+    takeEvents();
+    scannedThisCycle = true;
+    cycleScanPending = selector.startScan();
+    attemptStartMs = now;
+    linkState = WIFI_LINK_CONNECTING;
+    return cycleScanPending;
+}
+
+// Verbindungsversuch zu einem bestimmten AP auslösen, ohne auf das Ergebnis
+// zu warten. Nur der Kanal des APs wird abgefragt; mit Cache wird zusätzlich
+// die IP statisch gesetzt.
+void WifiManager::startAttempt(unsigned long now, const WifiCredential& credential,
+                               const uint8_t* bssid, uint8_t channel, bool fromCache) {
+    WiFi.disconnect();
+    takeEvents();   // Altlasten (auch das DISCONNECTED von eben) verwerfen
     
-    // Verbindungsversuch mit SSID und Passwort aus config.h
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    fastAttempt = fromCache;
+    cachedIpAttempt = fromCache && wifiCache->ip != 0 && wifiCache->ipReuseCount < WIFI_IP_CACHE_MAX_REUSE;
+    memcpy(attemptBssid, bssid, sizeof(attemptBssid));
+    attemptSsidHash = credential.ssidHash;
     
-    // Zeitstempel für Timeout-Überwachung
-    unsigned long startAttempt = millis();
+    if (cachedIpAttempt) {
+        WiFi.config(IPAddress(wifiCache->ip), IPAddress(wifiCache->gateway),
+                    IPAddress(wifiCache->netmask), IPAddress(wifiCache->dns));
+    } else {
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));   // DHCP
+    }
     
-    // Wartet auf Verbindung bis Timeout erreicht ist
-    while (WiFi.status() != WL_CONNECTED && millis() - startAttempt < WIFI_TIMEOUT_MS) {
-        Serial.print(".");  // Fortschrittsanzeige
-        delay(500);
+    WiFi.begin(credential.ssid, credential.password, channel, bssid);
+    attemptStartMs = now;
+    linkState = WIFI_LINK_CONNECTING;
+}
+
+// Ergebnis des laufenden Schritts auswerten. Scheitert ein AP, folgt sofort
+// der nächste Schritt; erst wenn alle Kandidaten und ein Scan erfolglos
+// waren, zählt das als Fehlschlag für den Backoff. Der Cache bleibt bis zur
+// nächsten erfolgreichen Verbindung erhalten (bei einem Ausfall kommt der AP
+// meist unverändert zurück).
+WifiAttemptResult WifiManager::pollAttempt(unsigned long now) {
+    if (cycleScanPending) {
+        if (selector.pollScan(credentials) < 0 && now - attemptStartMs < WIFI_TIMEOUT_MS) {
+            return WIFI_ATTEMPT_PENDING;
+        }
+        cycleScanPending = false;
+        nextCandidate = 0;
+        memset(attemptBssid, 0, sizeof(attemptBssid));   // Frisch gescannt: auch den letzten AP wieder zulassen
+        Serial.printf("📡 Scan: %u bekannte(r) AP(s)\n", (unsigned)selector.candidateCount());
+        return advanceCycle(now) ? WIFI_ATTEMPT_PENDING : WIFI_ATTEMPT_FAILED;
+    }
+    if (attemptSsidHash == 0) {
+        return advanceCycle(now) ? WIFI_ATTEMPT_PENDING : WIFI_ATTEMPT_FAILED;
+    }
+    
+    wl_status_t status = WiFi.status();
+    uint32_t events = takeEvents();
+    
+    if ((events & EVENT_GOT_IP) || status == WL_CONNECTED) {
+        unsigned long elapsed = now - connectStartMs;
+        if (fastAttempt) {
+            fastConnectMs.add(elapsed);
+        } else {
+            fullConnectMs.add(elapsed);
+        }
+        storeConnection();
+        selector.recordSuccess(attemptBssid, WiFi.RSSI());
+        return WIFI_ATTEMPT_CONNECTED;
+    }
+    
+    // ASSOC_LEAVE stammt vom eigenen WiFi.disconnect() vor dem Versuch
+    bool failed = ((events & EVENT_DISCONNECTED) && disconnectReason != WIFI_REASON_ASSOC_LEAVE) ||
+                  status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL;
+    // Kurze Frist nur für den Versuch mit BSSID/Kanal (und IP) aus dem
+    // Cache; Zuordnung plus DHCP braucht oft länger
+    unsigned long timeoutMs = (fastAttempt || cachedIpAttempt) ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_TIMEOUT_MS;
+    if (!failed && now - attemptStartMs < timeoutMs) {
+        return WIFI_ATTEMPT_PENDING;
+    }
+    
+    selector.recordFailure(attemptBssid);
+    if (fastAttempt) {
+        fastFallbacks++;
+        fastAttempt = false;
+    }
+    Serial.printf("⚠️  AP %02X:%02X:%02X:%02X:%02X:%02X nicht erreichbar (Grund %u)\n",
+                  attemptBssid[0], attemptBssid[1], attemptBssid[2], attemptBssid[3],
+                  attemptBssid[4], attemptBssid[5], failed ? (unsigned)disconnectReason : 0);
+    if (advanceCycle(now)) {
+        return WIFI_ATTEMPT_PENDING;
+    }
+    
+    WiFi.disconnect();
+    takeEvents();
+    return WIFI_ATTEMPT_FAILED;
+}
+
+// BSSID, Kanal und IP der bestehenden Verbindung für den nächsten Aufbau merken
+void WifiManager::storeConnection() {
+    if (!WIFI_FAST_RECONNECT || eventChannel == 0) {
+        return;
+    }
+    
+    if (cachedIpAttempt) {
+        wifiCache->ipReuseCount++;
+        return;   // BSSID/Kanal/IP unverändert
+    }
+    
+    wifiCache->ssidHash = attemptSsidHash;
+    memcpy(wifiCache->bssid, eventBssid, sizeof(wifiCache->bssid));
+    wifiCache->channel = eventChannel;
+    wifiCache->ipReuseCount = 0;
+    wifiCache->ip = eventIp;
+    wifiCache->gateway = eventGateway;
+    wifiCache->netmask = eventNetmask;
+    wifiCache->dns = (uint32_t)WiFi.dnsIP();
+    wifiCache.commit();
+}
+
+// Dauer bis zur IP-Adresse auf der seriellen Konsole ausgeben
+void WifiManager::printConnectStats() const {
+    Serial.println("📶 WLAN-Verbindungsaufbau [ms]:");
+    fastConnectMs.print("Schnell (Cache)", "ms");
+    fullConnectMs.print("Ohne Cache (Kandidat/Scan + DHCP)", "ms");
+    Serial.printf("  Rückfälle auf normalen Aufbau: %lu\n", (unsigned long)fastFallbacks);
+    Serial.printf("  Scans: %lu (davon Roaming %lu), AP-Wechsel: %lu\n",
+                  (unsigned long)selector.getScanCount(), (unsigned long)roamScans,
+                  (unsigned long)roamCount);
+    selector.printCandidates(credentials);
+}
+
+// Stellt die Verbindung zum WLAN her (blockierend, für setup() und den
+// Stromsparbetrieb; im laufenden Betrieb übernimmt handleReconnect())
+bool WifiManager::connect() {
+    Serial.printf("Verbinde mit WLAN (%u bekannte Netze)\n", (unsigned)credentials.size());
+    
+    // Derselbe Zustandsautomat wie in handleReconnect(), nur mit kurzem
+    // Abfragetakt, damit die Verbindung ohne Verzögerung erkannt wird
+    connectStartMs = millis();
+    beginCycle(connectStartMs, true);
+    WifiAttemptResult result = WIFI_ATTEMPT_PENDING;
+    while (result == WIFI_ATTEMPT_PENDING) {
+        delay(10);
+        result = pollAttempt(millis());
     }
-    Serial.println();
     
     // Prüfung ob Verbindung erfolgreich
-    if (WiFi.status() == WL_CONNECTED) {
+    if (result == WIFI_ATTEMPT_CONNECTED) {
         wifiConnected = true;
-        Serial.println("✅ WLAN verbunden!");
+        linkState = WIFI_LINK_UP;
+        reconnect.markConnected(millis());
+        Serial.printf("✅ WLAN verbunden! (%lu ms, %s)\n", millis() - connectStartMs,
+                      fastAttempt ? "Schnellverbindung" : "ohne Cache");
         printNetworkInfo();  // Netzwerkdetails ausgeben
         
         // NTP-Zeitsynchronisation initialisieren
@@ -59,8 +310,10 @@ bool WifiManager::connect() {
         return true;
     } else {
         wifiConnected = false;
+        linkState = WIFI_LINK_DOWN;
+        reconnect.markFailure(millis());  // handleReconnect() versucht es mit Backoff weiter
         Serial.println("❌ WLAN Verbindung fehlgeschlagen!");
-        Serial.println("   Prüfe SSID und Passwort in config.h");
+        Serial.println("   Prüfe die Zugangsdaten (config.h bzw. C2D \"wifi\")");
         return false;
     }
 }
@@ -74,67 +327,46 @@ bool WifiManager::isConnected() {
 void WifiManager::disconnect() {
     WiFi.disconnect();
     wifiConnected = false;
+    linkState = WIFI_LINK_DOWN;  // Gewollt getrennt: kein Ausfall, kein Reconnect
     Serial.println("WLAN getrennt");
 }
 
-// Initialisiert den NTP-Client für Zeitsynchronisation
+// Erste Zeitsynchronisation nach dem Verbindungsaufbau. Wartet höchstens
+// NTP_SYNC_TIMEOUT_MS; ohne Antwort holt handleReconnect() sie nach.
 bool WifiManager::initNTP() {
-    Serial.print("Initialisiere NTP... ");
-    
-    // NTP-Client mit Server, Zeitzone-Offset und Update-Intervall erstellen
-    timeClient = new NTPClient(ntpUDP, NTP_SERVER, NTP_OFFSET_SECONDS, NTP_UPDATE_INTERVAL_MS);
-    timeClient->begin();
-    
-    // Bis zu 5 Versuche für erfolgreiche Zeitsynchronisation
-    int attempts = 0;
-    while (!timeClient->update() && attempts < 5) {
-        Serial.print(".");
-        timeClient->forceUpdate();  // Erzwinge Update-Versuch
-        delay(1000);
-        attempts++;
-    }
-    Serial.println();
-    
-    // Prüfung ob Synchronisation erfolgreich
-    if (attempts < 5) {
-        ntpInitialized = true;
-        Serial.print("Aktuelle Zeit: ");
-        Serial.println(getFormattedTime());
-        Serial.printf("Epoch Time: %lu\n", getEpochTime());
-        return true;
-    } else {
-        ntpInitialized = false;
-        Serial.println("❌ NTP Synchronisation fehlgeschlagen!");
+    Serial.print("Synchronisiere Zeit (SNTP)... ");
+    
+    if (!timeService.syncBlocking(NTP_SYNC_TIMEOUT_MS)) {
+        Serial.println("❌ keine Antwort, wird im Betrieb nachgeholt");
         return false;
     }
+    Serial.printf("Versatz %+lld µs, Laufzeit %lu µs\n",
+                  (long long)timeService.getOffsetMicros(), (unsigned long)timeService.getDelayMicros());
+    Serial.print("Aktuelle Zeit: ");
+    Serial.println(getFormattedTime());
+    Serial.printf("Epoch Time: %lu\n", getEpochTime());
+    return true;
 }
 
-// Aktualisiert die Zeit vom NTP-Server
-void WifiManager::updateTime() {
-    if (ntpInitialized && timeClient != nullptr) {
-        timeClient->update();
-    }
-}
-
-// Gibt die aktuelle Zeit als Unix-Timestamp (Sekunden seit 1.1.1970) zurück
+// Gibt die aktuelle Zeit als Unix-Timestamp (Sekunden seit 1.1.1970, UTC) zurück
 unsigned long WifiManager::getEpochTime() {
-    if (ntpInitialized && timeClient != nullptr) {
-        return timeClient->getEpochTime();
-    }
-    return 0;  // Fallback wenn NTP nicht initialisiert
+    return timeService.getEpochTime();  // 0 solange nie synchronisiert
 }
 
-// Gibt die aktuelle Zeit als formatierten String (HH:MM:SS) zurück
+// Gibt die aktuelle Ortszeit als formatierten String (HH:MM:SS.mmm) zurück
 String WifiManager::getFormattedTime() {
-    if (ntpInitialized && timeClient != nullptr) {
-        return timeClient->getFormattedTime();
-    }
-    return "00:00:00";  // Fallback wenn NTP nicht initialisiert
+    char tmp[16];
+    timeService.formatTime(tmp, sizeof(tmp), NTP_OFFSET_SECONDS);
+    return String(tmp);
 }
 
 // Gibt detaillierte Netzwerkinformationen auf der seriellen Konsole aus
 void WifiManager::printNetworkInfo() {
     Serial.println("\n--- Netzwerk Informationen ---");
+    Serial.print("  SSID:          ");
+    Serial.println(WiFi.SSID());
+    Serial.print("  BSSID/Kanal:   ");
+    Serial.printf("%s / %ld\n", WiFi.BSSIDstr().c_str(), (long)WiFi.channel());
     Serial.print("  IP Adresse:    ");
     Serial.println(WiFi.localIP());           // Zugewiesene IP-Adresse
     Serial.print("  Subnet Mask:   ");
@@ -151,31 +383,179 @@ void WifiManager::printNetworkInfo() {
     Serial.println("-------------------------------\n");
 }
 
-// Überwacht die Verbindung und stellt sie bei Bedarf wieder her
+// Verbindung steht (wieder): Ausfall beenden. Die Uhr lief während des
+// Ausfalls frei weiter; der nächste SNTP-Abgleich geht sofort raus.
+void WifiManager::onLinkUp(unsigned long now) {
+    bool outage = reconnect.inOutage();   // Sonst AP-Wechsel durch Roaming
+    unsigned long outageMs = reconnect.getOutageDurationMs(now);
+    linkState = WIFI_LINK_UP;
+    wifiConnected = true;
+    reconnect.markConnected(now);
+    timeService.requestSync();
+    Serial.printf("✅ WLAN %s (nach %lu ms, Aufbau %lu ms, %s)\n", outage ? "wieder verbunden" : "AP gewechselt",
+                  outageMs, now - connectStartMs, fastAttempt ? "Schnellverbindung" : "ohne Cache");
+}
+
+// Überwacht die Verbindung und stellt sie bei Bedarf wieder her.
+// Zustandsautomat ohne delay(): WiFi.begin() wird nur ausgelöst, das
+// Ergebnis melden die WLAN-Ereignisse bei den folgenden Aufrufen. Wann ein
+// neuer Versuch fällig ist, entscheidet der ReconnectScheduler.
 void WifiManager::handleReconnect() {
-    if (!isConnected()) {
-        unsigned long now = millis();
-        
-        // Reconnect nur alle RECONNECT_INTERVAL Millisekunden versuchen
-        if (now - lastReconnectAttempt >= RECONNECT_INTERVAL) {
-            lastReconnectAttempt = now;
-            
-            Serial.println("⚠️  WLAN Verbindung verloren - Reconnect...");
+    unsigned long now = millis();
+    
+    switch (linkState) {
+        case WIFI_LINK_UP: {
+            wl_status_t status = WiFi.status();
+            uint32_t events = takeEvents();
+            if ((events & EVENT_DISCONNECTED) || status != WL_CONNECTED) {
+                linkState = WIFI_LINK_DOWN;
+                wifiConnected = false;
+                reconnect.markDisconnected(now);  // Erster Versuch sofort
+                Serial.printf("⚠️  WLAN Verbindung verloren (Grund %u)\n",
+                              (events & EVENT_DISCONNECTED) ? (unsigned)disconnectReason : 0);
+            } else {
+                timeService.poll(now);   // SNTP, nicht blockierend
+                if (WIFI_ROAMING) {
+                    checkRoaming(now);
+                }
+            }
+            break;
+        }
             
-            // Bestehende Verbindung sauber trennen
-            WiFi.disconnect();
-            delay(1000);
+        case WIFI_LINK_DOWN:
+            if (WiFi.status() == WL_CONNECTED) {
+                // Auto-Reconnect des WLAN-Stacks war schneller
+                takeEvents();
+                fastAttempt = false;
+                connectStartMs = now;
+                onLinkUp(now);
+            } else if (reconnect.isDue(now)) {
+                Serial.printf("⚠️  WLAN Reconnect (Versuch %lu)...\n",
+                              (unsigned long)reconnect.getConsecutiveFailures() + 1);
+                reconnect.markAttempt();
+                connectStartMs = now;
+                beginCycle(now, true);
+            }
+            break;
             
-            // Neuer Verbindungsversuch
-            if (connect()) {
-                Serial.println("✅ Reconnect erfolgreich!");
-                // NTP nach erfolgreicher Wiederverbindung neu initialisieren
-                if (!ntpInitialized) {
-                    initNTP();
-                }
-            } else {
-                Serial.println("❌ Reconnect fehlgeschlagen, versuche später erneut...");
+        case WIFI_LINK_CONNECTING:
+            switch (pollAttempt(now)) {
+                case WIFI_ATTEMPT_CONNECTED:
+                    onLinkUp(now);
+                    break;
+                case WIFI_ATTEMPT_FAILED:
+                    reconnect.markFailure(now);
+                    linkState = WIFI_LINK_DOWN;
+                    Serial.printf("❌ WLAN Reconnect fehlgeschlagen, nächster Versuch in %lu ms\n",
+                                  (unsigned long)reconnect.getLastDelayMs());
+                    break;
+                case WIFI_ATTEMPT_PENDING:
+                    break;
             }
+            break;
+    }
+}
+
+// ===== Roaming =====
+// Im Takt von WIFI_ROAM_CHECK_INTERVAL_MS die Signalstärke prüfen; ist sie
+// zu schwach, im Hintergrund scannen (die Verbindung bleibt bestehen) und
+// nur wechseln, wenn ein anderer AP um die Hysterese besser bewertet ist.
+void WifiManager::checkRoaming(unsigned long now) {
+    if (roamScanPending) {
+        if (selector.pollScan(credentials) < 0) {
+            return;
+        }
+        roamScanPending = false;
+        
+        const uint8_t* current = WiFi.BSSID();
+        int8_t rssi = WiFi.RSSI();
+        int16_t currentScore = current ? selector.score(current, rssi) : -128;
+        for (size_t i = 0; i < selector.candidateCount(); i++) {
+            const ApCandidate& candidate = selector.candidate(i);
+            if (current && memcmp(candidate.bssid, current, 6) == 0) {
+                continue;
+            }
+            if (candidate.score < currentScore + WIFI_ROAM_HYSTERESIS_DB) {
+                break;   // Sortiert: kein weiterer ist besser
+            }
+            Serial.printf("📶 Roaming: %d dBm -> %02X:%02X:%02X:%02X:%02X:%02X (%d dBm)\n", rssi,
+                          candidate.bssid[0], candidate.bssid[1], candidate.bssid[2],
+                          candidate.bssid[3], candidate.bssid[4], candidate.bssid[5], candidate.rssi);
+            roamCount++;
+            wifiConnected = false;
+            connectStartMs = now;
+            beginCycle(now, false);   // Kandidaten in Rangfolge, der beste zuerst
+            return;
+        }
+        Serial.printf("📶 Kein besserer AP (%d dBm), bleibe verbunden\n", rssi);
+        return;
+    }
+    
+    if (now - lastRoamCheckMs < WIFI_ROAM_CHECK_INTERVAL_MS) {
+        return;
+    }
+    lastRoamCheckMs = now;
+    
+    int8_t rssi = WiFi.RSSI();
+    if (rssi == 0 || rssi >= WIFI_ROAM_RSSI_THRESHOLD) {
+        return;
+    }
+    if (roamScans > 0 && now - lastRoamScanMs < WIFI_ROAM_COOLDOWN_MS) {
+        return;
+    }
+    lastRoamScanMs = now;
+    Serial.printf("📶 Signal schwach (%d dBm), suche besseren AP...\n", rssi);
+    if (selector.startScan()) {
+        roamScanPending = true;
+        roamScans++;
+    }
+}
+
+// ===== Zugangsdaten per C2D =====
+bool WifiManager::applyCommand(JsonVariantConst wifiCommand) {
+    bool ok = true;
+    
+    JsonVariantConst add = wifiCommand["add"];
+    if (!add.isNull()) {
+        const char* ssid = add["ssid"] | "";
+        if (credentials.add(ssid, add["password"] | "")) {
+            Serial.printf("✅ WLAN-Netz gespeichert: %s\n", ssid);
+        } else {
+            Serial.printf("❌ WLAN-Netz nicht gespeichert: %s\n", ssid);
+            ok = false;
+        }
+    }
+    
+    const char* remove = wifiCommand["remove"] | (const char*)nullptr;
+    if (remove != nullptr) {
+        if (credentials.size() > 1 && credentials.remove(remove)) {
+            Serial.printf("✅ WLAN-Netz entfernt: %s\n", remove);
+        } else {
+            Serial.printf("❌ WLAN-Netz nicht entfernt: %s (unbekannt oder letztes)\n", remove);
+            ok = false;
+        }
+    }
+    
+    // Neuer Scan beim nächsten Roaming-Check, unabhängig von der Signalstärke
+    if (wifiCommand["scan"] | false) {
+        selector.clearCandidates();
+        if (linkState == WIFI_LINK_UP && !roamScanPending && selector.startScan()) {
+            roamScanPending = true;
+            roamScans++;
         }
     }
-}
\ No newline at end of file
+    
+    Serial.printf("Bekannte WLAN-Netze (%u):\n", (unsigned)credentials.size());
+    for (size_t i = 0; i < credentials.size(); i++) {
+        Serial.printf("  %s\n", credentials.get(i).ssid);   // Passwörter nie ausgeben
+    }
+    return ok;
+}
+
+bool WifiManager::commandHandler(JsonVariantConst command, void* context) {
+    if (!command.containsKey("wifi")) {
+        return false;
+    }
+    ((WifiManager*)context)->applyCommand(command["wifi"]);
+    return true;
+}
@@ -3,19 +3,92 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WiFiUdp.h>
-#include <NTPClient.h>
+#include <ArduinoJson.h>
+#include "reconnect_scheduler.h"
+#include "histogram.h"
+#include "wifi_credentials.h"
+#include "ap_selector.h"
+#include "time_service.h"
 
+// Zustand der Verbindung aus Sicht von handleReconnect()
+enum WifiLinkState {
+    WIFI_LINK_DOWN,        // Getrennt, wartet auf den nächsten Versuch
+    WIFI_LINK_CONNECTING,  // WiFi.begin() bzw. Scan ausgelöst, Ergebnis steht aus
+    WIFI_LINK_UP
+};
+
+// Ergebnis von pollAttempt()
+enum WifiAttemptResult {
+    WIFI_ATTEMPT_PENDING,
+    WIFI_ATTEMPT_CONNECTED,
+    WIFI_ATTEMPT_FAILED
+};
+
+// ===== WLAN-Verbindung mit Schnellverbindung und Roaming =====
+// Der Verbindungsaufbau ist ein Zustandsautomat, den die WLAN-Ereignisse
+// (CONNECTED, GOT_IP, DISCONNECTED) vorantreiben. Reihenfolge je Aufbau:
+//   1. Letzter AP mit BSSID, Kanal und IP aus dem RTC-Speicher (kein Scan,
+//      kein DHCP; auch nach Deep Sleep)
+//   2. Kandidaten des letzten Scans in der Rangfolge des ApSelector
+//   3. Neuer Scan (einmal je Aufbau), danach wieder 2.
+// Sinkt im Betrieb die Signalstärke unter WIFI_ROAM_RSSI_THRESHOLD, wird im
+// Hintergrund gescannt und zu einem deutlich besseren AP gewechselt.
 class WifiManager {
 private:
-    WiFiUDP ntpUDP;
-    NTPClient* timeClient;
+    // Vom Ereignis-Handler gesetzte Bits (Event-Task), Auswertung im loop()
+    static const uint32_t EVENT_CONNECTED = 1 << 0;
+    static const uint32_t EVENT_GOT_IP = 1 << 1;
+    static const uint32_t EVENT_DISCONNECTED = 1 << 2;
+    
+    static WifiManager* eventTarget;
+    static void onWifiEvent(arduino_event_id_t event, arduino_event_info_t info);
+    
+    TimeService timeService;
     
     bool wifiConnected;
-    bool ntpInitialized;
     
-    unsigned long lastReconnectAttempt;
-    const unsigned long RECONNECT_INTERVAL = 30000;
+    WifiLinkState linkState;
+    unsigned long attemptStartMs;    // Aktueller Versuch (Timeout)
+    unsigned long connectStartMs;    // Erster Versuch inkl. Rückfall (Histogramm)
+    bool fastAttempt;                // Letzter AP aus dem RTC-Speicher
+    bool cachedIpAttempt;            // Mit gespeicherter IP statt DHCP
+    ReconnectScheduler reconnect;
+    
+    WifiCredentials credentials;
+    ApSelector selector;
+    size_t nextCandidate;            // Nächster Kandidat im laufenden Aufbau
+    bool scannedThisCycle;
+    bool cycleScanPending;           // Scan als Teil des Aufbaus läuft
+    uint8_t attemptBssid[6];
+    uint32_t attemptSsidHash;
+    
+    unsigned long lastRoamCheckMs;
+    unsigned long lastRoamScanMs;
+    bool roamScanPending;
+    uint32_t roamScans;
+    uint32_t roamCount;
+    
+    volatile uint32_t eventBits;
+    volatile uint8_t disconnectReason;
+    uint8_t eventBssid[6];
+    uint8_t eventChannel;
+    uint32_t eventIp;
+    uint32_t eventGateway;
+    uint32_t eventNetmask;
+    
+    Histogram<8> fastConnectMs;
+    Histogram<8> fullConnectMs;
+    uint32_t fastFallbacks;
+    
+    uint32_t takeEvents();
+    void beginCycle(unsigned long now, bool useCache);
+    bool advanceCycle(unsigned long now);
+    void startAttempt(unsigned long now, const WifiCredential& credential,
+                      const uint8_t* bssid, uint8_t channel, bool fromCache);
+    WifiAttemptResult pollAttempt(unsigned long now);
+    void checkRoaming(unsigned long now);
+    void onLinkUp(unsigned long now);
+    void storeConnection();
     
 public:
     WifiManager();
@@ -27,12 +100,34 @@ public:
     void disconnect();
     
     bool initNTP();
-    void updateTime();
-    unsigned long getEpochTime();
-    String getFormattedTime();
+    unsigned long getEpochTime();   // UTC, Sekunden
+    String getFormattedTime();      // Ortszeit (NTP_OFFSET_SECONDS) mit ms
+    // Abgleich läuft in handleReconnect(); lesen auch aus anderen Tasks
+    const TimeService& getTimeService() const { return timeService; }
     
     void printNetworkInfo();
-    void handleReconnect();
+    void handleReconnect();  // Nicht blockierend, regelmäßig aufrufen
+    
+    WifiLinkState getLinkState() const { return linkState; }
+    const ReconnectScheduler& getReconnectStats() const { return reconnect; }
+    
+    // Dauer bis zur IP-Adresse [ms], getrennt nach Schnell- und Normalverbindung
+    const Histogram<8>& getFastConnectStats() const { return fastConnectMs; }
+    const Histogram<8>& getFullConnectStats() const { return fullConnectMs; }
+    uint32_t getFastFallbackCount() const { return fastFallbacks; }
+    uint32_t getRoamCount() const { return roamCount; }
+    uint32_t getRoamScanCount() const { return roamScans; }
+    uint32_t getScanCount() const { return selector.getScanCount(); }
+    void printConnectStats() const;
+    
+    WifiCredentials& getCredentials() { return credentials; }
+    bool hasCachedConnection() const;
+    static void clearConnectionCache();   // Letzter AP und Scan-Kandidaten
+    
+    // C2D {"wifi":{"add":{"ssid":...,"password":...},"remove":...,"scan":true}}
+    // für MQTTClient::onCommand (context = WifiManager*)
+    bool applyCommand(JsonVariantConst wifiCommand);
+    static bool commandHandler(JsonVariantConst command, void* context);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Dekodiert binäre Telemetrie der ESP32-Wetterstation (schema=telemetry-bin-v1).
+
+Format (siehe src/telemetry_codec.h):
+    Byte 0      Schema-Version (1)
+    Byte 1      Anzahl Messwerte N
+    Byte 2...   N x 23 Bytes, Little Endian:
+                uint32 epoch, int16 temperature (0.01 °C), uint16 humidity (0.01 %),
+                uint16 pressure (0.1 hPa), int16 accel[3] (0.001 g),
+                int16 gyro[3] (0.1 °/s), uint8 flags (Bit 0 BME280, Bit 1 MPU9250)
+
+Ausgabe: ein JSON-Objekt pro Messwert mit denselben Feldern wie das JSON-Format.
+
+Aufruf:
+    decode_telemetry.py payload.bin
+    decode_telemetry.py --hex 0101...
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+SCHEMA_VERSION = 1
+HEADER = struct.Struct("<BB")
+SAMPLE = struct.Struct("<IhHHhhhhhhB")
+
+
+def decode(payload: bytes) -> list:
+    if len(payload) < HEADER.size:
+        raise ValueError("Payload zu kurz")
+
+    version, count = HEADER.unpack_from(payload, 0)
+    if version != SCHEMA_VERSION:
+        raise ValueError(f"Unbekannte Schema-Version {version}")
+    if len(payload) != HEADER.size + count * SAMPLE.size:
+        raise ValueError(f"Länge {len(payload)} passt nicht zu {count} Messwerten")
+
+    samples = []
+    for i in range(count):
+        (epoch, temperature, humidity, pressure,
+         ax, ay, az, gx, gy, gz, flags) = SAMPLE.unpack_from(payload, HEADER.size + i * SAMPLE.size)
+        sample = {"timestamp": epoch}
+        if flags & 0x01:
+            sample.update(temperature=temperature / 100.0,
+                          humidity=humidity / 100.0,
+                          pressure=pressure / 10.0)
+        if flags & 0x02:
+            sample.update(accelX=ax / 1000.0, accelY=ay / 1000.0, accelZ=az / 1000.0,
+                          gyroX=gx / 10.0, gyroY=gy / 10.0, gyroZ=gz / 10.0)
+        samples.append(sample)
+    return samples
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("file", nargs="?", help="Datei mit der rohen Payload (Standard: stdin)")
+    parser.add_argument("--hex", help="Payload als Hex-String")
+    args = parser.parse_args()
+
+    if args.hex:
+        payload = bytes.fromhex(args.hex)
+    elif args.file:
+        with open(args.file, "rb") as f:
+            payload = f.read()
+    else:
+        payload = sys.stdin.buffer.read()
+
+    for sample in decode(payload):
+        print(json.dumps(sample))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())